@@ -129,3 +129,13 @@
       }
       includedirs { MIXR_IncPath, MIXR_3rdPartyIncPath }
       targetname "ui_glut"
+
+   -- OpenGL EGL (headless) interface library
+   project "ui_egl"
+      location ("../" .. _ACTION .. "/projects/%{prj.name}")
+      files {
+         "../../include/mixr/ui/egl/**.h*",
+         "../../src/ui/egl/**.cpp"
+      }
+      includedirs { MIXR_IncPath, MIXR_3rdPartyIncPath }
+      targetname "ui_egl"
@@ -97,3 +97,6 @@ workspace "mixr"
 
    -- map libraries
    dofile "map.lua"
+
+   -- tests
+   dofile "tests.lua"
@@ -0,0 +1,28 @@
+--
+-- Tests
+--
+
+   -- render test: runs the render harness (egl::RenderHarness) against the
+   -- golden images of test/graphics; building the project runs the test
+   project "test_render"
+      kind "ConsoleApp"
+      location ("../" .. _ACTION .. "/projects/%{prj.name}")
+      targetdir ("../../test/graphics")
+      targetprefix ""
+      debugdir ("../../test/graphics")
+      debugargs { "render.edl" }
+      files {
+         "../../test/graphics/render.cpp",
+         "../../test/graphics/render.edl"
+      }
+      includedirs { MIXR_IncPath, MIXR_3rdPartyIncPath }
+      libdirs { "../../lib/", MIXR_3RD_PARTY_ROOT.."/lib" }
+      dependson { "base", "graphics", "terrain", "ui_egl" }
+      filter "configurations:Release"
+         links { "mixr_ui_egl", "mixr_graphics", "mixr_terrain", "mixr_base" }
+      filter "configurations:Debug"
+         links { "mixr_ui_egl_d", "mixr_graphics_d", "mixr_terrain_d", "mixr_base_d" }
+      filter {}
+      links { "libEGL", "opengl32", "glu32", "Ws2_32", "Winmm" }
+      postbuildcommands { "cd ../../../../test/graphics && %{cfg.buildtarget.name} render.edl" }
+      targetname "render"
@@ -4,6 +4,7 @@
 
 #include "mixr/base/Object.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace mixr {
@@ -35,6 +36,12 @@ class String;
 //     valid until the next read.
 //
 //  4) The file name and path names are limited to 255 characters.
+//
+//  5) Where supported (i.e., not WIN32), open() memory-maps the file, and the
+//     records are copied from the mapped file instead of being read using
+//     seek and read.  getRecordData() returns a pointer to a record within
+//     the mapped file, which is thread-safe, and remains valid until the
+//     file is closed or reopened.
 //------------------------------------------------------------------------------
 class FileReader : public Object
 {
@@ -74,6 +81,15 @@ public:
    // 'Len' can be up to 4 times recordLength().
    const char* getRecord(const int n = -1, const int len = 0);
 
+   // Returns true if the file is memory-mapped
+   bool isMapped() const                  { return (map != nullptr); }
+
+   // Returns a pointer to the 'len' characters starting at record number 'n'
+   // within the mapped file (not null terminated), or zero if the file is
+   // not mapped or the record is beyond the end of the file.  Does not
+   // change the current record number, so it's safe to use from any thread.
+   const char* getRecordData(const int n, const int len = 0) const;
+
    // Decrements the current record by 'n' or 1.
    void backRecord(const int n = 1);
    // Increments the current record by 'n' or 1.
@@ -84,8 +100,14 @@ public:
    const char* getNextRecord();
 
 private:
+   bool mapFile(const std::string& file);
+   void unmapFile();
+
    std::ifstream* dbf{};
 
+   const char* map {};     // memory-mapped file (or zero)
+   std::size_t mapSize {}; // size of the mapped file
+
    int   rnum {1};         // record number
    int   crnum {-1};       // current (in memory) record number
    int   rlen {};          // record length
@@ -56,6 +56,10 @@ public:
    Runway* getRunway(const int n);
    Ils* getIls(const int n);
 
+   // Get the n'th airport found by a find function (thread-safe).
+   // Range: 0 .. results.numberFound()-1
+   Airport* getAirport(const Results& results, const int n) const;
+
    // find all records within the search area with a runway length
    // of at least 'minRwLen' feet.
    int queryByLength(const float minRwLen);
@@ -63,6 +67,12 @@ public:
    int queryByFreq(const float freq);
    int queryByChannel(const int chan);
 
+   // thread-safe versions of the above queries (see Database note #4)
+   int findByLength(Results* const results, const float minRwLen) const;
+   int findByType(Results* const results, const Airport::Type) const;
+   int findByFreq(Results* const results, const float freq) const;
+   int findByChannel(Results* const results, const int chan) const;
+
    int getNumRunwayRecords(const char* key);
    int queryRunwayByNumber(const char* key, const int n);
    int queryRunwayByIdent(const char* id);
@@ -154,14 +164,15 @@ protected:
    enum { AIRPORT_MAX_RECORDS = 40000 };
 
    int queryAirport(const Airport::Type type, const float minRwLen);
+   int findAirport(Results* const results, const Airport::Type type, const float minRwLen) const;
 
-   int chkRwLen(const AirportKey* key, const float minRwLen);
+   int chkRwLen(const AirportKey* key, const float minRwLen) const;
 
-   int chkIlsFreq(const AirportKey* key, const float freq);
-   int chkRwIlsFreq(const RunwayKey* key, const float freq);
+   int chkIlsFreq(const AirportKey* key, const float freq) const;
+   int chkRwIlsFreq(const RunwayKey* key, const float freq) const;
 
-   int chkIlsChan(const AirportKey* key, const int chan);
-   int chkRwIlsChan(const RunwayKey* key, const int chan);
+   int chkIlsChan(const AirportKey* key, const int chan) const;
+   int chkRwIlsChan(const RunwayKey* key, const int chan) const;
 
    void makeSimpleLinkedList();
 
@@ -169,6 +180,11 @@ protected:
 
    static int kl_cmp(const void* p1, const void* p2);
 
+   // range query filters
+   struct AirportFilter;
+   struct FreqFilter;
+   struct ChanFilter;
+
    AirportKey* firstAirport {};  // first airport in linked-list
 
 private:
@@ -178,6 +194,8 @@ private:
    int queryByRangeImpl() final;
    int queryByIdentImpl(const char* id) final;
    int queryByKeyImpl(const char* key) final;
+   int findByIdentImpl(Results* const results, const char* id) const final;
+   int findByKeyImpl(Results* const results, const char* key) const final;
 
    void printLoadedImpl(std::ostream& sout) final;
    void printResultsImpl(std::ostream& sout) final;
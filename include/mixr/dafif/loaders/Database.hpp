@@ -7,6 +7,8 @@
 #include "mixr/dafif/dafifc.hpp"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace mixr {
 namespace base { class FileReader; class String; }
@@ -44,6 +46,24 @@ namespace dafif {
 //               ....                    // access the records
 //               clearDbInUse();         // free the database
 //           }
+//
+//   3) The range queries (e.g., queryByRange()) use a spatial index of the
+//      records, which is a grid of one degree latitude/longitude cells that's
+//      created when the database is loaded.  Only the cells within the max
+//      range (see setArea()) are searched and, with a query limit (see
+//      setQueryLimit()), the search starts near the ref point and grows until
+//      it has found enough records; only the nearest records are then sorted.
+//      The results are the same as sorting all of the records by range, with
+//      records at the same range kept in the order that they were loaded.
+//
+//   4) The find functions (e.g., findByRange()) are the thread-safe versions
+//      of the query functions.  The search area, query limit and the records
+//      found are held by the caller's Results object, and the database is
+//      not changed, so one loaded database can be shared by any number of
+//      threads (e.g., displays and onboard computers) without the in-use
+//      flag.  The records are read from the memory-mapped database file
+//      (see base::FileReader), and copied on demand by Results::getRecord();
+//      if the file couldn't be mapped, these reads are serialized.
 //------------------------------------------------------------------------------
 class Database : public base::Object
 {
@@ -143,7 +163,76 @@ public:
       char icao[ICAO_CODE_LEN+1]{};  // ICAO code
    };
 
+   // Search area and results of a find function (see note #4)
+   class Results {
+   public:
+      Results() = default;
+      Results(const double lat, const double lon, const double mrng = 0, const int mrec = 0);
+
+      // Sets the search area (ref point); results are limited to 'mrng' (nm), if provided
+      void setArea(const double lat, const double lon, const double mrng = 0);
+      double getRefLatitude() const          { return refLat; }
+      double getRefLongitude() const         { return refLon; }
+      double getMaxRange() const             { return mrng; }
+
+      // Sets the limit on the number of records found (zero if no limit)
+      void setQueryLimit(const int mrec = 0) { qlimit = mrec; }
+      int getQueryLimit() const              { return qlimit; }
+
+      // returns the number of records found
+      int numberFound() const                { return static_cast<int>(found.size()); }
+
+      // Returns the key of the n'th record found.  Range: 0 .. numberFound()-1
+      const Key* getKey(const int n) const;
+
+      // Returns the range (nm) from the ref point to the n'th record found
+      double getRange(const int n) const;
+
+      // Returns a copy of the n'th record found (empty if not found)
+      std::string getRecord(const int n, const int size = 0) const;
+
+   private:
+      friend class Database;
+
+      struct Found {
+         const Key* key {};      // Record's key
+         double rng2 {};         // Range squared to ref point (nm**2)
+      };
+
+      double range2(const double lat, const double lon) const;
+
+      const Database* db {};     // Database that found the records
+      std::vector<Found> found;  // Records found
+
+      double refLat {};          // Ref point latitude
+      double refLon {};          // Ref point longitude
+      double coslat {1.0};       // cos(ref point latitude)
+      double mrng {};            // max range (nm)
+      int qlimit {};             // Query limit (zero if no limit)
+   };
+
+   // --
+   // thread-safe find functions (see note #4); return the number of records found
+   // --
+   // find all records within the search area
+   int findByRange(Results* const results) const;
+   // find all records within the search area with identifier 'id'
+   int findByIdent(Results* const results, const char* id) const { return findByIdentImpl(results, id); }
+   // find the record with 'key'
+   int findByKey(Results* const results, const char* key) const  { return findByKeyImpl(results, key);  }
+   // find all records within the search area with ICAO code
+   int findByIcao(Results* const results, const char* code) const;
+
+   // Returns a copy of the key's record (thread-safe)
+   std::string readRecord(const Key* const key, const int size = 0) const;
+
 protected:
+   // Range query filter; accept() returns true if the record is selected
+   struct RangeFilter {
+      virtual ~RangeFilter() = default;
+      virtual bool accept(const Key* const key) const = 0;
+   };
+
    bool openDatabaseFile();
 
    const char* dbGetRecord(const Key* key, const int size = 0);
@@ -154,12 +243,36 @@ protected:
    int mQuery(Key** key, Key** base, std::size_t n,
                int (*cmp)(const void*, const void*));
 
+   // thread-safe versions of sQuery() and mQuery()
+   int sFind(Results* const results, Key** key, Key** base, std::size_t n,
+               int (*cmp)(const void*, const void*)) const;
+
+   int mFind(Results* const results, Key** key, Key** base, std::size_t n,
+               int (*cmp)(const void*, const void*)) const;
+
+   // range find using the spatial index (thread-safe version of rangeQuery())
+   int rangeFind(Results* const results, const RangeFilter* const filter = nullptr) const;
+
+   // finds the set of records that match 'key' around 'keyPtr': [ *first .. *last ]
+   static void expandMatch(Key** key, Key** keyPtr,
+                        int (*cmp)(const void*, const void*),
+                        Key** base, std::size_t n,
+                        Key*** const first, Key*** const last);
+
    void expandResults(Key** key, Key** keyPtr,
                         int (*cmp)(const void*, const void*),
                         Key** base, std::size_t n);
 
    void createIcaoList();
 
+   void createRangeIndex();   // Creates the spatial index of the record list
+
+   // Range query using the spatial index; selects the records within the
+   // search area that are accepted by the filter (or all, if no filter),
+   // and puts the nearest (up to the query limit) in the query list,
+   // sorted by range.  Returns the number of records found.
+   int rangeQuery(const RangeFilter* const filter = nullptr);
+
    int rangeSort();     // Sort results by range; first compute range and then
                         // uses rangeSort2() to sort.
 
@@ -196,13 +309,45 @@ protected:
    bool dbInUse{};     // Database In-Use flag
    bool dbLoaded{};    // Database has been loader
 
+   // Spatial index: positions (in rl) of the records in each lat/lon cell, by cell
+   std::vector<int> cellStart;   // Start of each cell's positions in 'cellRecs' (plus the end)
+   std::vector<int> cellRecs;    // Record positions
+
+   std::vector<std::pair<double, int>> qcand;   // Range query candidates: range**2 and position
+
+   mutable long readSemaphore {};   // Semaphore for readRecord() when the file isn't mapped
+
 private:
+   // spatial index cells
+   static const int CELL_LAT{180};           // Number of latitude cells (one degree)
+   static const int CELL_LON{360};           // Number of longitude cells (one degree)
+
+   // First search radius of a range query with a query limit (nm)
+   static const double FIRST_RADIUS;
+
+   // Searches the spatial index: sets 'cand' to the range**2 and position (in
+   // rl) of the nearest records within the search area that are accepted by
+   // the filter, sorted by range and limited to 'limit' (if not zero)
+   void rangeSearch(const Results& area, const RangeFilter* const filter,
+                     std::vector<std::pair<double, int>>* const cand) const;
+
+   // Collects the candidates within 'radius' (nm; or all, if zero); returns
+   // true if the full index was searched
+   bool rangeCandidates(const Results& area, const double radius, const double mr2,
+                     const RangeFilter* const filter,
+                     std::vector<std::pair<double, int>>* const cand) const;
+
+   static int cellLat(const double lat);
+   static int cellLon(const double lon);
+
    virtual bool loadImpl(const std::string& code = "") = 0;
    virtual int getRecordLengthImpl() = 0;
    virtual int getMaxRecordsImpl() = 0;
    virtual int queryByRangeImpl() = 0;
    virtual int queryByIdentImpl(const char* id) = 0;
    virtual int queryByKeyImpl(const char* key) = 0;
+   virtual int findByIdentImpl(Results* const results, const char* id) const = 0;
+   virtual int findByKeyImpl(Results* const results, const char* key) const = 0;
 
    virtual void printLoadedImpl(std::ostream&);
    virtual void printResultsImpl(std::ostream&);
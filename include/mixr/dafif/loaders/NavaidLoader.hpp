@@ -37,6 +37,9 @@ public:
    // Get the n'th NAVAID found by last query.
    // Range: 0 .. numberFound()-1
    Navaid* getNavaid(const int n);
+   // Get the n'th NAVAID found by a find function (thread-safe).
+   // Range: 0 .. results.numberFound()-1
+   Navaid* getNavaid(const Results& results, const int n) const;
 
    // find 'type' NAVAID records within the search area
    int queryByType(const Navaid::NavaidType type);
@@ -45,6 +48,11 @@ public:
    // find all records within the search area with a given channel number
    int queryByChannel(const long chan, const char band = 'X');
 
+   // thread-safe versions of the above queries (see Database note #4)
+   int findByType(Results* const results, const Navaid::NavaidType type) const;
+   int findByFreq(Results* const results, const float freq) const;
+   int findByChannel(Results* const results, const long chan, const char band = 'X') const;
+
    // prints the records loaded in frequency order
    void printFreqList(std::ostream& sout);
    // prints the records loaded in channel number order
@@ -81,6 +89,9 @@ protected:
    static int fl_cmp(const void* p1, const void* p2);
    static int cl_cmp(const void* p1, const void* p2);
 
+   // range query filter
+   struct TypeFilter;
+
 private:
    bool loadImpl(const std::string& code = "") final;
    int getRecordLengthImpl() final;
@@ -88,6 +99,8 @@ private:
    int queryByRangeImpl() final;
    int queryByIdentImpl(const char* id) final;
    int queryByKeyImpl(const char* key) final;
+   int findByIdentImpl(Results* const results, const char* id) const final;
+   int findByKeyImpl(Results* const results, const char* key) const final;
 
    void printLoadedImpl(std::ostream&) final;
    void printResultsImpl(std::ostream&) final;
@@ -37,6 +37,9 @@ public:
    // Get the n'th waypoint found by last query.
    // Range: 0 .. numberFound()-1
    Waypoint* getWaypoint(const int);
+   // Get the n'th waypoint found by a find function (thread-safe).
+   // Range: 0 .. results.numberFound()-1
+   Waypoint* getWaypoint(const Results& results, const int n) const;
 
 protected:
    enum { WAYPOINT_MAX_RECORDS = 140000 };
@@ -67,6 +70,8 @@ private:
    int queryByRangeImpl() final;
    int queryByIdentImpl(const char* id) final;
    int queryByKeyImpl(const char* key) final;
+   int findByIdentImpl(Results* const results, const char* id) const final;
+   int findByKeyImpl(Results* const results, const char* key) const final;
 
    void printLoadedImpl(std::ostream&) final;
    void printResultsImpl(std::ostream&) final;
@@ -13,6 +13,8 @@ class AbstractFont;
 class Image;
 class Texture;
 class Material;
+class PickIndex;
+class Renderer;
 
 //------------------------------------------------------------------------------
 // Class: Display
@@ -72,6 +74,10 @@ class Material;
 //  orientation       <String>      ! display orientation { normal, cw90, ccw90, inverted } (default: normal)
 //  materials         <Material>    ! List of material objects (default: 0)
 //  antiAliasing      <Boolean>     ! Turn on/off anti-aliasing (default: true)
+//  drawCaching       <Boolean>     ! Draw unchanged static subtrees from recorded draw batches (default: true)
+//  culling           <Boolean>     ! Cull subtrees that are outside of the viewport (default: true)
+//  vertexBuffers     <Boolean>     ! Draw the graphics primitives through streamed vertex buffers (see Renderer)
+//                                  ! (default: false; always true with a core profile context)
 //
 // Exceptions:
 //      ExpInvalidDisplayPtr
@@ -100,6 +106,18 @@ public:
    bool isAntialiasing() const;                 // Is anti-aliasing enabled?
    bool setAntialiasing(const bool on);         // Set anti-aliasing enabled flag
 
+   bool isDrawCaching() const;                  // Are unchanged static subtrees drawn from draw batches? (see Graphic)
+   bool setDrawCaching(const bool on);          // Set draw caching enabled flag
+   bool isCulling() const;                      // Are subtrees outside of the viewport culled? (see Graphic)
+   bool setCulling(const bool on);              // Set culling enabled flag
+   unsigned int getDrawCacheSerial() const;     // Changes when the recorded draw batches are no longer valid (e.g., new color table)
+
+   Renderer* getRenderer();                     // Draws the graphics primitives (see Renderer)
+   bool isVertexBuffers() const;                // Is the renderer drawing through vertex buffers?
+   bool setVertexBuffers(const bool on);        // Set vertex buffers flag (before the first frame)
+
+   PickIndex* getPickIndex();                   // Screen space bounds of the selectable graphics (see PickIndex)
+
    Orientation getDisplayOrientation() const;             // Returns the orientation of the display
    bool isDisplayOrientation(const Orientation o) const;  // Is this our display orientation?
    void setDisplayOrientation(const Orientation o);       // Sets the display orientation
@@ -134,6 +152,9 @@ public:
    const base::Vec4d& getCurrentColor() const;        // Returns the current color RGBA vector
    void setColor(const base::Vec4d& color);           // Sets the current color by an RGBA vector.
    void setColor(const char* cname1);                 // Sets the current color by name (color table)
+   const base::Identifier* getCurrentColorName() const;  // Returns the current color name (empty if set by an RGBA vector)
+   void restoreColor(const base::Vec4d&, const char* const cname);  // Restores the current color and name without a GL call
+                                                      //  -- e.g., after a display list has already set the GL color
 
    base::Color* getColor(const char* const name);     // Returns a color by name from the color table
    base::Color* getColor(const int idx);              // Returns a color by index from the color table
@@ -350,6 +371,12 @@ private:
 
     bool subdisplayFlg {};                          // We're a sub-display
     bool antialias {true};                          // Anti-alias flag  (default on)
+    bool drawCaching {true};                        // Draw caching flag (default on)
+    bool culling {true};                            // Culling flag (default on)
+    unsigned int drawCacheSerial {};                // Draw cache serial number
+    bool vertexBuffers {};                          // Vertex buffers flag (default off)
+    Renderer* renderer {};                          // Primitive renderer (created by getRenderer())
+    PickIndex* pickIndex {};                        // Pick index (created by getPickIndex())
     int mx {}, my {};                               // Mouse x, y
 
     Orientation orientation {Orientation::NORMAL};  // Display orientation
@@ -408,6 +435,9 @@ private:
     bool setSlotMaterials(base::PairStream* const);
     bool setSlotMaterials(Material* const);
     bool setSlotAntialias(const base::Boolean* const);
+    bool setSlotDrawCaching(const base::Boolean* const);
+    bool setSlotCulling(const base::Boolean* const);
+    bool setSlotVertexBuffers(const base::Boolean* const);
 };
 
 inline const char* Display::getName() const                            { return name.c_str(); }
@@ -416,6 +446,9 @@ inline bool Display::isSubdisplay() const                              { return
 inline Display::Orientation Display::getDisplayOrientation() const     { return orientation; }
 inline bool Display::isDisplayOrientation(const Orientation o) const   { return (o == getDisplayOrientation()); }
 inline bool Display::isAntialiasing() const                            { return antialias; }
+inline bool Display::isDrawCaching() const                             { return drawCaching; }
+inline bool Display::isCulling() const                                 { return culling; }
+inline unsigned int Display::getDrawCacheSerial() const                { return drawCacheSerial; }
 inline const base::Vec4d& Display::getClearColor() const               { return clearColor; }
 inline GLclampd Display::getClearDepth() const                         { return clearDepth; }
 inline void Display::setClearDepth(const GLclampd depth)               { clearDepth = depth; }
@@ -425,6 +458,7 @@ inline void Display::setDisplayOrientation(const Orientation o)  { orientation =
 inline GLfloat Display::getLinewidth() const                     { return linewidth; }
 inline GLfloat Display::getStdLineWidth() const                  { return stdLinewidth; }
 inline const base::Vec4d& Display::getCurrentColor() const       { return color; }
+inline const base::Identifier* Display::getCurrentColorName() const  { return colorName; }
 
 inline void Display::getMouse(int* const x, int* const y) const  { *x = mx; *y = my; }
 
@@ -11,8 +11,11 @@
 #include "mixr/base/util/platform_api.hpp"
 #include <GL/gl.h>
 
+#include <string>
+#include <vector>
+
 namespace mixr {
-namespace base { class Boolean; class Color; class Identifier; class Integer; class Number; class Transform; }
+namespace base { class Boolean; class Color; class Identifier; class Integer; class Number; class String; class Transform; }
 namespace graphics {
 class Display;
 class Material;
@@ -20,14 +23,14 @@ class Material;
 //------------------------------------------------------------------------------
 // Display List macros
 //------------------------------------------------------------------------------
-#define BEGIN_DLIST                             \
-   if (isDisplayListEnabled()) {                \
-      setDisplayList( glGenLists(1) );          \
-      glNewList(getDisplayList(),GL_COMPILE);   \
+#define BEGIN_DLIST                                                                \
+   if (isDisplayListEnabled() && !isRecordingDrawBatch() && !isVertexBuffers()) {  \
+      setDisplayList( glGenLists(1) );                                             \
+      glNewList(getDisplayList(),GL_COMPILE);                                      \
    }
 
-#define END_DLIST                               \
-      if (isDisplayListEnabled()) glEndList();
+#define END_DLIST                                                                  \
+      if (isDisplayListEnabled() && !isRecordingDrawBatch() && !isVertexBuffers()) glEndList();
 
 
 //------------------------------------------------------------------------------
@@ -167,6 +170,93 @@ class Material;
 //    setDisableDisplayList(bool flg)
 //      Disables display list if flg is true and returns true.
 //
+////Retained drawing (dirty state, draw batches and culling)
+//    Each graphic tracks what has changed since it was last drawn using the
+//    DIRTY_* flags (transform, color, attributes, visibility, geometry and
+//    components).  The set functions (e.g., setColor(), setVertices(),
+//    lcTranslate()) mark the graphic dirty, and mark all of its (grand)
+//    containers with DIRTY_SUBTREE.  The flags are cleared when the graphic
+//    is drawn.
+//
+//    A graphic with a "static" draw -- one that depends only on the state
+//    that marks it dirty (see isStaticDraw()) -- and with only static
+//    (grand) components is a static subtree.  When drawing its components,
+//    a graphic groups the consecutive components that are static subtrees
+//    into draw batches.  After a batch has been drawn for a few frames
+//    without changes, its GL commands are recorded into a display list,
+//    which is then called in place of drawing its components, until one of
+//    them is dirty again.  The display's current color is 'unknown' while
+//    recording, so the list sets its own colors; a list is recorded again
+//    if the display's line width isn't the one that it was recorded with.
+//
+//    The bounds of each subtree are cached (see getDrawBounds()), and
+//    batches and subtrees that are wholly outside of the viewport are not
+//    drawn (culled).  Batches and culling are enabled by the display (see
+//    Display slots 'drawCaching' and 'culling').
+//
+//    unsigned int getDirtyFlags()
+//    bool isDirty()
+//      Returns the dirty flags, or true if any are set.
+//
+//    setDirty(unsigned int flags)
+//      Marks this graphic dirty (default: DIRTY_ALL).  Subclasses that opt in
+//      to isStaticDraw() must call setDirty() whenever their drawing changes
+//      (e.g., setRadius()).  Note: changing a Color object in place (e.g.,
+//      getColor()->setRed()) isn't seen; use the setColor() functions.
+//
+//    bool isStaticDraw()
+//      Returns true if our draw() depends only on our dirty state (i.e.,
+//      anything that changes it calls setDirty()).  By default, only the
+//      exact class types that are known to be static return true.
+//
+//    bool getDrawBounds(Vec3d* lo, Vec3d* hi)
+//      Gets the bounds of our own drawing (drawFunc()), in our coordinates
+//      (i.e., before our transformation matrix); returns false if unknown.
+//      Only used when isStaticDraw() is true.  Default: our vertices.
+//
+//    bool isRecordingDrawBatch()
+//      True while a draw batch is being recorded (static).
+//
+//    bool isStaticSubtree()
+//      Returns true if we and our (grand) components are a static subtree;
+//      updates our cached subtree state.
+//
+//    clearDirty()
+//      Clears our dirty flags without drawing, so that later changes can be
+//      seen (e.g., by a container that draws a copy of us in our place).
+//      Not for static subtrees, whose changes the draw batches would miss.
+//
+////Vertex buffers (see Renderer)
+//    When the display draws through vertex buffers, the primitives of the
+//    graphics that draw through the display's renderer are batched, and
+//    there are no display lists or draw batches.  Before the drawFunc() of
+//    a graphic that draws directly with OpenGL, and before any OpenGL state
+//    changes (e.g., material, mask or stipple), the batched primitives are
+//    drawn (flushed) to keep the drawing order.
+//
+//    bool isBufferedDraw()
+//      Returns true if our drawFunc() draws only through the display's
+//      renderer (i.e., Renderer's begin(), vertex(), etc.).  By default,
+//      only the exact class types that are known to do so return true.
+//
+//    bool isVertexBuffers()
+//      True if the display is drawing through vertex buffers.
+//
+////Picking (see PickIndex)
+//    While the display is drawn, the window coordinate bounds of each graphic
+//    with a select name -- its subtree's bounds, when they're known, or else
+//    the bounds of each of its (grand) components' drawings -- are added to
+//    the display's pick index, so that the display's pick() only draws the
+//    graphics that are near the pick box in GL_SELECT mode.  Graphics with a
+//    select name are not part of draw batches.
+//
+//    bool getPickBounds(Display* dsp, Vec3d* lo, Vec3d* hi)
+//      Gets the bounds of our own drawing (drawFunc()) for picking, in our
+//      coordinates; returns false if unknown, and then the graphic with the
+//      select name is drawn by every pick().  The bounds must contain all of
+//      the drawing.  Default: getDrawBounds(), if isStaticDraw() is true;
+//      otherwise unknown.
+//
 ////Texture functions
 //    hasTexture()
 //      Returns true if a texture is present.
@@ -240,6 +330,18 @@ public:
    unsigned int getNumberOfTextureCoords() const { return ntc; }           // Number of texture coordinates
    bool setTextureCoord(const base::Vec2d* const v, const unsigned int n); // Sets the list of texture coordinates
 
+   // Dirty state flags (see "Retained drawing" above)
+   enum {
+      DIRTY_TRANSFORM  = 0x01,      // Transformation matrix
+      DIRTY_COLOR      = 0x02,      // Color or material
+      DIRTY_ATTRIBUTES = 0x04,      // Line width, stippling, texture, scissor box, select name, etc.
+      DIRTY_VISIBILITY = 0x08,      // Visibility or flash rate
+      DIRTY_GEOMETRY   = 0x10,      // Vertices, normals, texture coordinates or the subclass' shape
+      DIRTY_COMPONENTS = 0x20,      // List of components, or the selected component
+      DIRTY_SUBTREE    = 0x40,      // One or more of our (grand) components are dirty
+      DIRTY_ALL        = 0x7F
+   };
+
    const base::Vec3d* getNormals() const { return norms; }                 // Normals (at vertices)
    unsigned int getNumberOfNormals() const { return nn; }                  // Number of Normals
    bool setNormals(const base::Vec3d* const v, const unsigned int n);      // Sets the list of normal vectors
@@ -338,6 +440,23 @@ public:
    // Subcomponent graphics
    bool isPostDrawComponents() const                { return postDraw; }
 
+   // Retained drawing
+   unsigned int getDirtyFlags() const               { return dirtyFlags; }
+   bool isDirty() const                             { return (dirtyFlags != 0); }
+   void setDirty(const unsigned int flags = DIRTY_ALL);
+   virtual bool isStaticDraw() const;
+   virtual bool getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const;
+   static bool isRecordingDrawBatch()               { return recording; }
+   bool isStaticSubtree()                           { updateCache(); return staticSubtree; }
+   void clearDirty()                                { dirtyFlags = 0; }
+
+   // Vertex buffers
+   virtual bool isBufferedDraw() const;
+   bool isVertexBuffers();
+
+   // Picking
+   virtual bool getPickBounds(Display* const, base::Vec3d* const lo, base::Vec3d* const hi) const;
+
    virtual bool cursor(int* ln, int* cp) const;
 
    // Select name incrementer (for automatic select name generation)
@@ -378,6 +497,9 @@ public:
    static void lcTexCoord4v(const double* v)    { glTexCoord4dv(v); }
 
 
+   bool select(const base::String* const name) override;
+   bool select(const base::Integer* const num) override;
+
    bool event(const int event, Object* const obj = nullptr) override;
 
 public:
@@ -404,10 +526,43 @@ protected:
    ) override;
 
 private:
+   // Draw batch: consecutive components that are static subtrees
+   struct DrawBatch {
+      unsigned int first {};        // Index of the first component
+      unsigned int count {};        // Number of components
+      unsigned int size {};         // Number of graphics (components and their subtrees)
+      bool boundsKnown {};          // Bounds are known
+      base::Vec3d lo, hi;           // Bounds (our coordinates)
+      GLuint list {};               // Recorded display list (zero if not recorded)
+      unsigned int cleanFrames {};  // Frames drawn without changes
+      unsigned int serial {};       // Display's draw cache serial number
+      base::Vec4d color1;           // Display's color after the batch (NaN if not set by the batch)
+      std::string colorName1;       // Display's color name after the batch
+      GLfloat linewidth0 {};        // Display's line width before the batch
+      GLfloat linewidth1 {};        // Display's line width after the batch
+   };
+
+   static const unsigned int CACHE_FRAMES {2};     // Frames without changes before a batch is recorded
+   static const unsigned int MIN_BATCH_SIZE {4};   // Min number of graphics in a batch
+   static const int CULL_MARGIN {16};              // Culling margin (pixels)
+
    void initData();
    void setupMatrix();
    void setupMaterial();
 
+   void updateChildren();
+   void updateCache();
+   void updateBatches();
+   void clearBatches();
+   void drawComponents(Display* const);
+   void drawBatch(DrawBatch* const, Display* const);
+   static void restoreColor(const DrawBatch&, Display* const, const base::Vec4d&, const std::string&);
+   static void addBounds(base::Vec3d* const lo, base::Vec3d* const hi, const base::Vec3d& lo2, const base::Vec3d& hi2);
+   static bool transformBounds(base::Vec3d* const lo, base::Vec3d* const hi, const double* const mm);
+   static bool isOutsideViewport(Display* const, const base::Vec3d& lo, const base::Vec3d& hi);
+   static bool getClipMatrix(Display* const, double* const clip, GLint* const vp);
+   static void addPickBounds(Display* const, const base::Vec3d& lo, const base::Vec3d& hi);
+
    base::PairStream* transforms {};  // transformations
    base::Matrixd m;                  // transformation matrix
    base::Matrixd m1;                 // saved 'm'
@@ -459,6 +614,17 @@ private:
    base::Vec4d lightPos;                 // light position relative to us (default is leave it where it was)
    bool lightMoved {};                   // our light is moving!
 
+   // Retained drawing
+   unsigned int dirtyFlags {DIRTY_ALL};  // Changes since our last draw
+   std::vector<Graphic*> children;       // Our components (Graphics)
+   std::vector<DrawBatch> batches;       // Draw batches of our components
+   bool cacheValid {};                   // Cached subtree state is valid
+   bool staticSubtree {};                // We and our (grand) components are static
+   unsigned int subtreeSize {1};         // Number of graphics in our subtree
+   bool boundsKnown {};                  // Subtree bounds are known
+   base::Vec3d boundsLo, boundsHi;       // Subtree bounds (our container's coordinates)
+   static bool recording;                // A draw batch is being recorded
+
 private:
    // slot table helper methods
    bool setSlotColor(const base::Color* const);
@@ -501,6 +667,7 @@ inline void Graphic::lcRestoreMatrix()
 {
    m = m1;
    haveMatrix = haveMatrix1;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcRotate(const double a)
@@ -509,6 +676,7 @@ inline void Graphic::lcRotate(const double a)
    rr.makeRotate(a, 0.0f, 0.0f, 1.0f);
    m.preMult(rr);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcRotate(const double x, const double y, const double z, const double a)
@@ -517,6 +685,7 @@ inline void Graphic::lcRotate(const double x, const double y, const double z, co
    rr.makeRotate(a, x, y, z);
    m.preMult(rr);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcScale(const double s)
@@ -525,6 +694,7 @@ inline void Graphic::lcScale(const double s)
    ss.makeScale(s,s,s);
    m.preMult(ss);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcScale(const double sx, const double sy)
@@ -533,6 +703,7 @@ inline void Graphic::lcScale(const double sx, const double sy)
    ss.makeScale(sx,sy,1.0f);
    m.preMult(ss);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcTranslate(const double x, const double y)
@@ -541,6 +712,7 @@ inline void Graphic::lcTranslate(const double x, const double y)
    tt.makeTranslate(x,y,0.0f);
    m.preMult(tt);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 inline void Graphic::lcTranslate(const double x, const double y, const double z)
@@ -549,6 +721,7 @@ inline void Graphic::lcTranslate(const double x, const double y, const double z)
    tt.makeTranslate(x,y,z);
    m.preMult(tt);
    haveMatrix = true;
+   setDirty(DIRTY_TRANSFORM);
 }
 
 }
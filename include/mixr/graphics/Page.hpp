@@ -70,6 +70,7 @@ public:
    virtual bool onKeyHit(const int key);
 
    void draw() override;
+   bool isStaticDraw() const override;
    base::Pair* findBySelectName(const GLuint name) override;
    bool event(const int event, base::Object* const obj = nullptr) override;
 
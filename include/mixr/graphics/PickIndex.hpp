@@ -0,0 +1,148 @@
+#ifndef __mixr_graphics_PickIndex_HPP__
+#define __mixr_graphics_PickIndex_HPP__
+
+#include "mixr/base/osg/Vec3d"
+
+#include "mixr/base/util/platform_api.hpp"
+#include <GL/gl.h>
+
+#include <vector>
+
+namespace mixr {
+namespace graphics {
+class Graphic;
+
+//------------------------------------------------------------------------------
+// Class: PickIndex
+//
+// Description: Screen space bounds of the display's selectable graphics (i.e.,
+//              graphics with a select name; see Graphic::setSelectName()), so
+//              that picking only needs to draw the graphics that are near the
+//              pick box in OpenGL's GL_SELECT mode, instead of the whole display.
+//
+//    The bounds are collected during the display's normal draw (see
+//    Display::drawIt()): Graphic::draw() calls pushName() and popName()
+//    around the drawing of a graphic with a select name, like glPushName()
+//    and glPopName(), and, while isNamed(), adds the bounds of its drawing
+//    (see Graphic::getPickBounds()) with addBounds().  A graphic that adds
+//    the bounds of its whole subtree at once calls pushCovered() and
+//    popCovered() around it, so its components don't.  As with GL_SELECT
+//    hit records, the bounds of a subtree belong to its outermost select
+//    name.  At the end of the frame, endFrame() sorts the entries into a
+//    grid of the viewport's pixels.
+//
+//    Each entry also holds the graphic that started it and the OpenGL
+//    matrices that it was drawn with.  select() redraws, in GL_SELECT mode,
+//    only the graphics of the entries whose bounds are within a pixel of the
+//    pick box, in drawing order, so the select buffer holds the same hit
+//    records as drawing the whole display would, and nothing is drawn when
+//    no entry is near the pick box.
+//
+//    If the bounds of any drawing within a select name are unknown, the
+//    graphic calls setUnbounded(), and its entry is redrawn by every select().
+//
+// Notes:
+//    1) The entries are from the last frame that was drawn; there are none
+//       (and isIndexed() is false) until a frame has been drawn.
+//    2) The matrices are OpenGL's, so the entries can't be redrawn for a
+//       frame that was drawn through the renderer's vertex buffers.
+//------------------------------------------------------------------------------
+class PickIndex
+{
+public:
+   // Selectable graphic (outermost select name)
+   struct Entry {
+      GLuint name {};                  // Select name
+      Graphic* graphic {};             // Graphic to redraw
+      bool pushesName {};              // The graphic's draw() pushes the select name
+      bool bounded {true};             // Bounds are known
+      double x0 {}, y0 {};             // Lower left (window coordinates)
+      double x1 {}, y1 {};             // Upper right (window coordinates)
+      double zmin {}, zmax {};         // Depth range [ 0 .. 1 ]
+      GLdouble modelview[16] {};       // OpenGL matrices of the drawing
+      GLdouble projection[16] {};
+   };
+
+public:
+   PickIndex() = default;
+   PickIndex(const PickIndex&) = delete;
+   PickIndex& operator=(const PickIndex&) = delete;
+   ~PickIndex() = default;
+
+   // Start and end of the display's frame
+   void beginFrame();
+   void endFrame();
+
+   // Collecting (i.e., between beginFrame() and endFrame())?
+   bool isCollecting() const                       { return collecting; }
+
+   // Entries of a frame have been indexed
+   bool isIndexed() const                          { return indexed; }
+
+   // Within a select name, and not covered? (i.e., bounds are to be added)
+   bool isNamed() const                            { return (collecting && depth > 0 && covered == 0); }
+
+   // Select name stack (see glPushName(), glPopName()); for the outermost
+   // name, 'graphic' is redrawn at the current OpenGL matrices by select(),
+   // and 'pushesName' is true when its draw() pushes the name itself
+   void pushName(const GLuint name, Graphic* const graphic, const bool pushesName = true);
+   void popName();
+
+   // Subtree whose bounds have been added (see isNamed())
+   void pushCovered()                              { if (collecting) covered++; }
+   void popCovered()                               { if (collecting && covered > 0) covered--; }
+
+   // Bounds are unknown for some of the current entry's drawing
+   void setUnbounded()                             { if (isNamed()) current.bounded = false; }
+
+   // Adds the bounds, (lo, hi) in object coordinates, to the current entry;
+   // 'clip' is the projection * modelview matrix and 'vp' is the viewport
+   void addBounds(const double* const clip, const GLint* const vp,
+                  const base::Vec3d& lo, const base::Vec3d& hi);
+
+   // Entries that may be hit by a pick box, centered at (x, y) in window
+   // coordinates (indices into getEntries(), in drawing order)
+   const std::vector<unsigned int>& getCandidates(const double x, const double y,
+                                                  const double width, const double height) const;
+
+   // Redraws the candidate entries in GL_SELECT mode, with the pick box
+   // centered at window coordinates (x, y) of the viewport 'vp', into the
+   // select buffer; returns the number of hit records (see glRenderMode())
+   GLint select(const double x, const double y, const double width, const double height,
+                GLint* const vp, GLuint* const sbuff, const GLsizei size) const;
+
+   const std::vector<Entry>& getEntries() const    { return entries; }
+
+private:
+   static const int CELL_SIZE {32};    // Grid cell size (pixels)
+   static const double MARGIN;         // Candidate margin (pixels)
+
+   static int cell(const double v, const int v0, const int n);
+
+   bool collecting {};                 // Collecting entries
+   bool indexed {};                    // Entries of a frame are indexed
+   unsigned int depth {};              // Select name stack depth
+   unsigned int covered {};            // Covered subtree depth
+   bool haveBounds {};                 // Current entry has bounds
+   Entry current;                      // Current entry
+
+   std::vector<Entry> entries;         // Entries of the frame (drawing order)
+   std::vector<unsigned int> unbounded;          // Entries without bounds
+   int vpX0 {}, vpY0 {};               // Union of the entries' viewports
+   int vpX1 {}, vpY1 {};
+
+   // Grid: the entries of cell 'c' are cellItems[ cellStart[c] .. cellStart[c+1] )
+   int gridX0 {}, gridY0 {};           // Lower left of the grid (window coordinates)
+   int gridCols {}, gridRows {};
+   std::vector<unsigned int> cellStart;
+   std::vector<unsigned int> cellItems;
+
+   mutable std::vector<unsigned int> hits;       // getCandidates() work lists
+   mutable std::vector<unsigned int> stamps;
+   mutable unsigned int stamp {};
+};
+
+}
+}
+
+#endif
@@ -91,6 +91,8 @@ public:
    void setLayer(const unsigned int newLayer);
 
    void drawFunc() override;
+   bool isStaticDraw() const override;
+   bool isBufferedDraw() const override;
 
 private:
    base::Vec4d coeff;          // Coefficients of the plane equation
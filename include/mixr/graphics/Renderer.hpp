@@ -0,0 +1,179 @@
+
+#ifndef __mixr_graphics_Renderer_HPP__
+#define __mixr_graphics_Renderer_HPP__
+
+#include "mixr/base/osg/Vec2d"
+#include "mixr/base/osg/Vec3d"
+#include "mixr/base/osg/Vec4d"
+#include "mixr/base/osg/Matrixd"
+
+#include "mixr/base/util/platform_api.hpp"
+#include <GL/gl.h>
+
+#include <vector>
+
+namespace mixr {
+namespace graphics {
+class Display;
+
+//------------------------------------------------------------------------------
+// Class: Renderer
+//
+// Description: Draws the display's graphics primitives, either in immediate
+//              mode (the default) or by batching their vertices into streamed
+//              vertex buffers that are drawn with a small set of shaders.
+//
+//    The primitive functions, begin(), vertex(), texCoord(), color() and end(),
+//    and the matrix functions, pushMatrix(), multMatrix(), translate(), etc.,
+//    follow the OpenGL immediate mode functions, so drawFunc() code can move
+//    to the renderer one class at a time; see Graphic::isBufferedDraw().
+//
+//    Immediate mode:
+//       The functions call the matching OpenGL functions (e.g., glBegin(),
+//       glVertex3d(), glPushMatrix()), so drawing is the same as before, and
+//       display lists can record it.
+//
+//    Vertex buffer mode (see Display slot 'vertexBuffers'):
+//       The matrix stacks are held on the CPU, and the vertices are
+//       transformed by the modelview matrix as they're added, so primitives
+//       drawn with different matrices share a batch.  Line strips and loops
+//       are kept as strips and loops (using primitive restart); the other
+//       polygon types are drawn as triangles.  A batch is drawn (flushed)
+//       when the primitive type, shader program, texture or line width
+//       changes, at the end of the frame, and before any drawing that isn't
+//       through the renderer (e.g., Graphic::draw() flushes before the
+//       drawFunc() of a graphic that isn't a 'buffered draw').
+//
+//       With a compatibility profile context, the matrix functions also set
+//       the OpenGL matrices, so immediate mode code still works in between.
+//       With a core profile context, only the renderer draws.
+//
+//    Shader programs:
+//       SOLID       -- lines, points and fills; the vertex colors
+//       TEXTURED    -- textured fills; GL_DECAL of the texture over the vertex color
+//       TEXT        -- text; the texture's red (or luminance) component is the
+//                      alpha of the vertex color (i.e., glyph coverage)
+//
+//    Vertex buffer mode needs OpenGL 3.2 (GLSL 1.50); otherwise, or if the
+//    shaders can't be built, the renderer stays in immediate mode.
+//
+// Notes:
+//    1) The current color is the display's current color (see
+//       Display::setColor()) at begin(); color() sets a vertex color that's
+//       used until end().
+//    2) The renderer's OpenGL objects belong to the display's context, and
+//       are released with it.
+//------------------------------------------------------------------------------
+class Renderer
+{
+public:
+   enum class Program { SOLID, TEXTURED, TEXT };
+
+public:
+   explicit Renderer(Display* const);
+   Renderer(const Renderer&) = delete;
+   Renderer& operator=(const Renderer&) = delete;
+   ~Renderer() = default;
+
+   bool isBuffered() const                         { return buffered; }     // Vertex buffer mode?
+   bool isCoreProfile() const                      { return coreProfile; }  // Core profile context?
+
+   // Start of a frame, with the display's context current; the first call
+   // sets up the vertex buffer mode, if 'vertexBuffers' is true
+   void beginFrame(const bool vertexBuffers);
+
+   // Draws the batched vertices (vertex buffer mode)
+   void flush();
+
+   // ---
+   // Matrices
+   // ---
+   void ortho(const double left, const double right, const double bottom, const double top,
+              const double zNear, const double zFar);    // Sets the projection, and the modelview to identity
+   void pushMatrix();
+   void popMatrix();
+   void loadIdentity();
+   void multMatrix(const base::Matrixd&);
+   void translate(const double x, const double y, const double z = 0.0);
+   void rotate(const double angle, const double x, const double y, const double z);   // degrees
+   void scale(const double x, const double y, const double z = 1.0);
+
+   const base::Matrixd& getModelview() const       { return modelview.back(); }   // (vertex buffer mode)
+   const base::Matrixd& getProjection() const      { return projection; }         // (vertex buffer mode)
+
+   // ---
+   // Primitives
+   // ---
+   void begin(const GLenum mode);                  // GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_LINE_LOOP,
+                                                   // GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN,
+                                                   // GL_QUADS, GL_QUAD_STRIP or GL_POLYGON
+   void end();
+   void vertex(const double x, const double y, const double z = 0.0);
+   void vertex(const base::Vec2d& v)               { vertex(v.x(), v.y()); }
+   void vertex(const base::Vec3d& v)               { vertex(v.x(), v.y(), v.z()); }
+   void texCoord(const double s, const double t);
+   void texCoord(const base::Vec2d& v)             { texCoord(v.x(), v.y()); }
+   void color(const double r, const double g, const double b, const double a = 1.0);
+   void color(const base::Vec4d& c)                { color(c.x(), c.y(), c.z(), c.w()); }
+
+   // Texture of the following primitives (zero for none) and its program
+   // (TEXTURED or TEXT); in immediate mode, the caller binds its textures
+   void setTexture(const GLuint texture, const Program = Program::TEXTURED);
+   GLuint getTexture() const                       { return texture; }
+   Program getProgram() const                      { return program; }
+
+private:
+   // Batched vertex
+   struct Vertex {
+      GLfloat pos[3];
+      GLfloat tex[2];
+      GLubyte rgba[4];
+   };
+
+   static const unsigned int MAX_VERTICES {65536};    // Max vertices per batch
+   static const GLuint RESTART_INDEX {0xFFFFFFFF};    // Primitive restart index
+
+   bool setup();
+   static GLuint buildProgram(const char* const fs);
+   void addPrimitive();
+
+   Display* display {};                // Our display (not ref()'d; it owns us)
+   bool initialized {};                // beginFrame() has set up the mode
+   bool buffered {};                   // Vertex buffer mode
+   bool coreProfile {};                // Core profile context
+
+   // Matrix stacks (vertex buffer mode)
+   std::vector<base::Matrixd> modelview {base::Matrixd()};
+   base::Matrixd projection;
+   bool projectionChanged[3] {true, true, true};   // Projection uniforms need setting (by Program)
+
+   // Current primitive
+   GLenum mode {GL_POINTS};            // begin() mode
+   bool inPrimitive {};                // Between begin() and end()
+   std::vector<Vertex> prim;           // Vertices of the primitive
+   GLfloat curTex[2] {};               // Current texture coordinates
+   GLubyte curColor[4] {};             // Current color
+
+   // Current batch
+   GLenum batchMode {GL_POINTS};       // Draw mode: GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_LINE_LOOP or GL_TRIANGLES
+   Program batchProgram {Program::SOLID};
+   GLuint batchTexture {};
+   GLfloat batchLinewidth {};
+   std::vector<Vertex> vertices;       // Batched vertices
+   std::vector<GLuint> indices;        // Batched indices
+
+   GLuint texture {};                  // Texture of the following primitives
+   Program program {Program::SOLID};   // Program of the textured primitives
+
+   // OpenGL objects
+   GLuint programs[3] {};              // Shader programs (by Program)
+   GLint mvpLoc[3] {};                 // Projection matrix uniform locations
+   GLuint vao {};                      // Vertex array object
+   GLuint vbo {};                      // Vertex buffer
+   GLuint ibo {};                      // Index buffer
+};
+
+}
+}
+
+#endif
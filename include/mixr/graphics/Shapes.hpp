@@ -26,13 +26,16 @@ public:
     Circle();
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
+    bool getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const override;
 
     // sets radius and returns true if successful.
-    virtual bool setRadius(const double x)   { radius = x; return true; }
+    virtual bool setRadius(const double x)   { radius = x; setDirty(DIRTY_GEOMETRY); return true; }
     // sets filled and returns true if successful.
-    virtual bool setFilled(const bool x)     { filled = x; return true; }
+    virtual bool setFilled(const bool x)     { filled = x; setDirty(DIRTY_GEOMETRY); return true; }
     // sets slices and returns true if successful.
-    virtual bool setSlices(const int x)      { slices = x; return true; }
+    virtual bool setSlices(const int x)      { slices = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     double getRadius()       { return radius; }
     bool isFilled()          { return filled; }
@@ -73,8 +76,11 @@ public:
     OcclusionCircle();
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
+    bool getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const override;
 
-    virtual bool setOuterRadius(const double x)     { outerRadius = x; return true; }
+    virtual bool setOuterRadius(const double x)     { outerRadius = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     double getOuterRadius()                         { return outerRadius; }
 
@@ -115,10 +121,12 @@ public:
     Arc();
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 
-    virtual bool setStartAngle(const double x)  { startAngle = x; return true; }
-    virtual bool setArcLength(const double x)   { arcLength = x; return true; }
-    virtual bool setIsConnected(const bool x)   { connected = x; return true; }
+    virtual bool setStartAngle(const double x)  { startAngle = x; setDirty(DIRTY_GEOMETRY); return true; }
+    virtual bool setArcLength(const double x)   { arcLength = x; setDirty(DIRTY_GEOMETRY); return true; }
+    virtual bool setIsConnected(const bool x)   { connected = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     double getStartAngle()                      { return startAngle; }
     double getArcLength()                       { return arcLength; }
@@ -153,8 +161,11 @@ public:
     OcclusionArc();
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
+    bool getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const override;
 
-    bool setOuterRadius(const double x)  { outerRadius = x; return true; }
+    bool setOuterRadius(const double x)  { outerRadius = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     double getOuterRadius()              { return outerRadius; }
 
@@ -184,6 +195,8 @@ class Point : public Graphic
 public:
     Point();
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 };
 
 
@@ -203,6 +216,8 @@ class LineLoop : public Graphic
 public:
     LineLoop();
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 };
 
 //------------------------------------------------------------------------------
@@ -227,8 +242,10 @@ public:
     Line();
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 
-    bool setSegments(const bool x)       { segment = x; return true; }
+    bool setSegments(const bool x)       { segment = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     bool isSegmented()                   { return segment; }
 
@@ -253,10 +270,12 @@ class Quad : public Graphic
 public:
     Quad();
 
-    bool setStrip(const bool x)     { strip = x; return true; }
+    bool setStrip(const bool x)     { strip = x; setDirty(DIRTY_GEOMETRY); return true; }
     bool isStrip()                  { return strip; }
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 
 protected:
     bool strip {};     // are we a Quad Strip?
@@ -280,11 +299,13 @@ class Triangle : public Quad
 public:
     Triangle();
 
-    bool setFan(const bool x)     { fan = x; return true; }
+    bool setFan(const bool x)     { fan = x; setDirty(DIRTY_GEOMETRY); return true; }
 
     bool isFan()                  { return fan; }
 
     void drawFunc() override;
+    bool isStaticDraw() const override;
+    bool isBufferedDraw() const override;
 
 private:
     bool fan {};       // are we a triangle fan?
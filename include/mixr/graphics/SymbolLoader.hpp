@@ -4,10 +4,15 @@
 
 #include "mixr/graphics/MapPage.hpp"
 
-#include <array>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace mixr {
-namespace base { class Boolean; class Degrees; }
+namespace base { class Boolean; class Degrees; class Integer; }
 namespace graphics {
 class SlSymbol;
 
@@ -32,6 +37,10 @@ class SlSymbol;
 //
 // Notes:
 //    1) All symbol index values are one-based; range: [ 1 ... getMaxSymbols() ]
+//    The symbol table grows as symbols are added, and the lowest unused index
+//    is reused first (the unused indexes are kept in a heap, so adding and
+//    removing a symbol are O(log n)).  The number of active symbols is not
+//    limited, unless the 'maxSymbols' slot is set.
 //
 //    2) The real-time thread, updateTC(), is not passed to our base class
 //    or our component symbols.
@@ -68,29 +77,58 @@ class SlSymbol;
 //    (if so desired), and the symbol loader will draw lines between the symbols (this
 //    is an easy way to draw routes).
 //
+//    8) The symbols' graphical components are added to (and removed from) our
+//    component list by our next updateData() or draw(), so that adding or
+//    removing many symbols doesn't rebuild the list for each one.
+//
+//    9) When the 'instancing' slot is true, a symbol whose graphical component
+//    is unchanged from its template (i.e., nothing has set it dirty since it
+//    was cloned; see Graphic::setDirty()),
+//    and that has no value or heading, is drawn as an instance of a prototype
+//    copy of its template, which is positioned and drawn in its place with
+//    the symbol's select name, if the template is a static subtree (see
+//    Graphic::isStaticSubtree()).  The prototype's cached draw batches, or
+//    batched vertices, are then shared by all of the symbols of its type.
+//    Their own graphical components are kept invisible.  A symbol whose
+//    graphical component changes is drawn by itself from then on.  Instances
+//    are drawn, in the order of their graphical components, before the other
+//    symbols, so overlapping symbols can stack differently than they do
+//    without instancing.  Instancing applies to the symbols that are added
+//    (or whose type is changed) while it's enabled.
+//
+//    10) getSymbol(xPixels, yPixels) searches a grid of the symbols' screen
+//    positions, which is rebuilt when the positions have changed.
+//
 // Factory name: SymbolLoader
 // Slots:
 //     templates         <PairStream>   ! List of templates to use for symbols
 //     showOnlyInRange   <Boolean>      ! only show symbols within range (default: true)
 //     interconnect      <Boolean>      ! interconnect the symbols (default: false)
+//     maxSymbols        <Integer>      ! max number of active symbols (default: 0, no limit)
+//     instancing        <Boolean>      ! draw unchanged symbols as instances of their
+//                                      ! template (see Note 9) (default: false)
 //
 //------------------------------------------------------------------------------
 class SymbolLoader : public MapPage
 {
    DECLARE_SUBCLASS(SymbolLoader, MapPage)
 
-public:
-   static const int MAX_SYMBOLS = 300;
-
 public:
    SymbolLoader();
 
    // Returns the current number of active symbols
    int getNumberOfActiveSymbols() const;
 
-   // Returns the maximum number of active symbols
+   // Returns the current symbol capacity: the max number of active symbols,
+   // or the size of the symbol table, if that's larger (e.g., no limit)
    int getMaxSymbols() const;
 
+   // Returns the size of the symbol table (i.e., the max symbol index)
+   int getSymbolTableSize() const;
+
+   // Sets the maximum number of active symbols (zero for no limit)
+   virtual bool setMaxSymbols(const int max);
+
    // Returns the symbol type code for the symbol at index, 'idx',
    // or zero for no symbol at 'idx'.
    int getSymbolType(const int idx) const;
@@ -168,28 +206,79 @@ public:
    virtual bool setInterconnect(const bool x);
    bool isInterconnected()  { return interconnect; };
 
+   // Instanced drawing (see Note 9)
+   virtual bool setInstancing(const bool x);
+   bool isInstancing() const  { return instancing; }
+
    void draw() override;
    void drawFunc() override;
    void updateTC(const double dt = 0.0) override;
+   void updateData(const double dt = 0.0) override;
 
 protected:
    virtual SlSymbol* symbolFactory();  // Creates symbols objects
 
+   // Gets up to 'max' of the active symbols; returns the number of symbols
    int getSymbols(base::safe_ptr<SlSymbol>* const newSyms, const int max);
 
 private:
+   // How a symbol is drawn (see Note 9)
+   enum class DrawMode : unsigned char {
+      PENDING,       // Not yet drawn; an instance, if it's still unchanged
+      INSTANCE,      // Instance of its template's prototype
+      GRAPHIC        // By its own graphical component
+   };
+
+   // Symbol that's drawn as an instance this frame
+   struct Instance {
+      Graphic* proto{};       // Template prototype (held by 'protos')
+      GLuint selName{};       // Symbol's select name
+      double x{}, y{};        // Position (inches)
+      unsigned long long order{};   // Order of its graphical component
+   };
+
+   static const long long GRID_COLUMN{4294967296LL};   // Grid cell key of column one, row zero
+
    void initData();
+   void updateComponents();
+   Graphic* getPrototype(const int nType);
+   void clearPrototypes();
+   void updateGrid(const double cell);
+   static long long getGridCell(const double v, const double cell);
 
    base::PairStream* templates{};                // holds our pairstream of templates
-   std::array<SlSymbol*, MAX_SYMBOLS> symbols{}; // holds our array of symbols
+   std::vector<SlSymbol*> symbols;               // holds our table of symbols (zero for unused entries)
+   std::vector<DrawMode> drawModes;              // how each symbol is drawn
+   std::vector<unsigned long long> orders;       // order of each symbol's graphical component in our component list
+   unsigned long long numAdded{};                // number of graphical components that have been added
+   std::priority_queue<int, std::vector<int>, std::greater<int>> freeEntries;   // unused table entries (lowest first)
+   int numSymbols{};                             // number of active symbols
+   int maxSymbols{};                             // max number of active symbols (zero for no limit)
+   std::unordered_map<const Graphic*, int> graphicIndex;   // symbol index by graphical component
    bool showInRangeOnly{true};                   // only show the symbols within our range, else draw all the symbols if false
    bool interconnect{};                          // Connect our symbols with a line?
+   bool instancing{};                            // Draw unchanged symbols as instances?
+
+   // Component list changes (see updateComponents())
+   std::vector<base::Pair*> addedPairs;                      // graphical components to add (ref()'d)
+   std::unordered_set<const base::Object*> removedGraphics;  // graphical components to remove
+
+   // Instanced drawing (see Note 9)
+   std::unordered_map<int, Graphic*> protos;     // template prototypes by type code (ref()'d)
+   std::vector<Instance> instances;              // this frame's instances (component order)
+
+   // Grid of the symbols' screen positions (see getSymbol(xPixels, yPixels))
+   std::vector<std::pair<long long, int>> grid;  // (cell key, table entry), sorted
+   double gridCell{};                            // cell size (inches)
+   bool gridValid{};                             // grid matches the symbols' positions
 
 private:
    // slot table helper methods
    bool setSlotTemplates(base::PairStream*);
    bool setSlotShowInRangeOnly(const base::Boolean* const);
    bool setSlotInterconnect(const base::Boolean* const);
+   bool setSlotMaxSymbols(const base::Integer* const);
+   bool setSlotInstancing(const base::Boolean* const);
 };
 
 //------------------------------------------------------------------------------
@@ -273,13 +362,15 @@ private:
    base::Degrees* hdgAng{};   // Value sent to the heading 'hdg' object
 };
 
-inline int SymbolLoader::getMaxSymbols() const { return MAX_SYMBOLS; }
+inline int SymbolLoader::getNumberOfActiveSymbols() const { return numSymbols; }
+inline int SymbolLoader::getMaxSymbols() const { return (maxSymbols > getSymbolTableSize()) ? maxSymbols : getSymbolTableSize(); }
+inline int SymbolLoader::getSymbolTableSize() const { return static_cast<int>(symbols.size()); }
 inline bool SymbolLoader::setInterconnect(const bool flg) { interconnect = flg; return true; }
 
 inline SlSymbol* SymbolLoader::getSymbol(const int idx)
 {
    SlSymbol* p{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) p = symbols[i];
    }
@@ -289,7 +380,7 @@ inline SlSymbol* SymbolLoader::getSymbol(const int idx)
 inline const SlSymbol* SymbolLoader::getSymbol(const int idx) const
 {
    const SlSymbol* p = nullptr;
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i = (idx - 1);
       if (symbols[i] != nullptr) p = symbols[i];
    }
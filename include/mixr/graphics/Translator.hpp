@@ -36,6 +36,7 @@ public:
     bool setZPos(const double);                    // Sets the Z position (world coord)
 
     void draw() override;
+    bool isBufferedDraw() const override;
     bool event(const int event, Object* const obj = nullptr) override;
 
 private:
@@ -131,6 +131,7 @@ public:
    bool cursor(int* ln, int* cp) const override;
 
    void drawFunc() override;
+   bool getPickBounds(Display* const, base::Vec3d* const lo, base::Vec3d* const hi) const override;
    bool event(const int event, Object* const obj = nullptr) override;
 
    void updateData(const double dt = 0.0) override;
@@ -5,9 +5,13 @@
 #include "mixr/base/Object.hpp"
 #include "mixr/map/rpf/map_utils.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace mixr {
 namespace rpf {
 
+class CadrgClut;
 class CadrgFrameEntry;
 
 //------------------------------------------------------------------------------
@@ -22,6 +26,13 @@ class CadrgFrameEntry;
 // decompressSubframe() - Take our frame and decompress the subframe image
 //        virtual int decompressSubframe(const int x, const int y, Subframe& subFrame);
 //
+// decodeSubframe() - Decode the subframe image directly to RGB (3) or RGBA (4)
+// texels, in the same order as CadrgMap::subframeToTexels().  The lookup table
+// is converted to texels once (per color table and number of components), so
+// each 4x4 block of the subframe is four row copies.
+//        virtual int decodeSubframe(const int x, const int y, const CadrgClut& clut,
+//                                   unsigned char* const texels, const int numComponents = 3);
+//
 //------------------------------------------------------------------------------
 class CadrgFrame : public base::Object
 {
@@ -34,14 +45,27 @@ public:
     virtual void load(CadrgFrameEntry* entry);
     // Decompress our subframe
     virtual int decompressSubframe(const int x, const int y, Subframe& subFrame);
+    // Decode our subframe to texels
+    virtual int decodeSubframe(const int x, const int y, const CadrgClut& clut, unsigned char* const texels, const int numComponents = 3);
 
 private:
+    // Our codebook for the color table; the handle keeps it alive while the
+    // caller reads it, even if another thread clears or rebuilds the codebooks
+    std::shared_ptr<const std::vector<unsigned char>> getCodebook(const CadrgClut& clut, const int numComponents);
+    void clearCodebooks();
+
     static const int frameSize = 6144;                 // Total frame size
     CadrgFrameEntry* frameEntry {};                    // Pointer to our frame entry parent
     unsigned char subFrameTable[6][6][frameSize] {};   // Subframe table array
     int nitfHdrLength {};                              // Nitf header length
     int masked[6][6] {};                               // Subframe masked array
     unsigned char lookupTable[4096][4][4] {};          // Lookup table
+
+    // Lookup table converted to texels, [4096][4][4][nc] (rows and columns
+    // swapped), for 3 and 4 components
+    std::shared_ptr<const std::vector<unsigned char>> codebooks[2];
+    const CadrgClut* codebookClut {};                  // Color table of the codebooks
+    long codebookSemaphore {};
 };
 
 }
@@ -9,9 +9,13 @@ namespace mixr {
 namespace base { class Integer; class String; class List; }
 namespace graphics { class Texture; }
 namespace rpf {
+class CadrgClut;
 class CadrgFile;
+class CadrgTocEntry;
+class SubframeLoader;
 class TexturePager;
 class MapDrawer;
+struct Subframe;
 
 // ---------------------------------------------------------------------------------
 // Class: CadrgMap
@@ -44,9 +48,21 @@ class MapDrawer;
 //                  // use it to draw the maps!
 //                  ( MapDrawer )
 //              }
+//              // Optional background loader of the map's subframes
+//              loader: ( SubframeLoader numThreads: 2 )
+//              // Size (MB) of the decoded subframe cache (shared by all maps)
+//              subframeCacheSize: 32
 //            )   // end of CadrgMap
 // ) // end of display
 //
+// With a SubframeLoader (slot 'loader'), the subframes are loaded and decoded
+// by its threads, ahead of need, instead of by the texture pagers during the
+// draw.
+//
+// Decoded subframes are kept in the SubframeCache, which is shared by all of
+// the CadrgMaps; its size is process-wide, so slot 'subframeCacheSize' sets it
+// for every map.
+//
 // Subroutines:
 // getNumberOfCadrgFiles() - Return total number of all files
 //       int CadrgMap::getNumberOfCadrgFiles()
@@ -120,6 +136,14 @@ class MapDrawer;
 // getLevel() - Return our resolution level.
 //      const char* CadrgMap::getLevel()
 //
+// prefetchZoomLevel() - Requests the subframes around the lat/lon of the next
+// map level in the direction of our last zoom (see SubframeLoader).
+//      void CadrgMap::prefetchZoomLevel(const double lat, const double lon)
+//
+// subframeToTexels() - Converts a decompressed subframe to RGB texels using
+// the color lookup table.
+//      static void CadrgMap::subframeToTexels(const Subframe& subframe, const CadrgClut& clut, ColorArray& texels)
+//
 // updateData() - Update map data.
 //      void CadrgMap::updateData(double dt)
 //
@@ -168,6 +192,11 @@ public:
 
     // Get pixels
     virtual void* getPixels(const int row, const int column, TexturePager* tp);
+    static void subframeToTexels(const Subframe&, const CadrgClut&, ColorArray&);
+
+    // Background loader of our subframes (or nullptr)
+    SubframeLoader* getLoader()          { return loader; }
+    virtual void prefetchZoomLevel(const double lat, const double lon);
     int getNumberOfCadrgFiles();
     const char* getLevel();
 
@@ -180,12 +209,16 @@ public:
     int getMaxTableSize()                { return maxTableSize; }
 
     void updateData(const double dt = 0.0) override;
+    void reset() override;
+    bool shutdownNotification() override;
 
     virtual void sortMaps(const int count);             // simple function to sort our maps.
 
 private:
     static const int MAX_FILES {10};            // Holds the maximum number of cadrg files we can hold
 
+    CadrgFile* findFileByLevel(const char*);
+
     std::array<CadrgFile*, MAX_FILES> cadrgFiles {};        // List of cadrg files
     std::array<CadrgFile*, MAX_FILES> mergedCadrgFiles {};  // Merged list of cadrg files from all paths
 
@@ -197,12 +230,16 @@ private:
     ColorArray outTile;                         // Holds the tile color information
     base::String* mapLevel {};                  // Our map "level" we are ("1:500K", etc..)
     bool initLevelLoaded {};                    // Has our initial map level been loaded?
+    SubframeLoader* loader {};                  // Background subframe loader (optional)
+    int zoomDirection {};                       // Last zoom: in (1), out (-1) or none (0)
 
 private:
    // slot table helper methods
    bool setSlotPathnames(const base::PairStream* const);
    bool setSlotMaxTableSize(const base::Integer* const);
    bool setSlotMapLevel(base::String*);
+   bool setSlotLoader(SubframeLoader* const);
+   bool setSlotSubframeCacheSize(const base::Integer* const);
 };
 
 }
@@ -0,0 +1,66 @@
+
+#ifndef __mixr_map_rpf_SubframeCache_HPP__
+#define __mixr_map_rpf_SubframeCache_HPP__
+
+#include <cstddef>
+
+namespace mixr {
+namespace rpf {
+class CadrgFrame;
+class CadrgFrameEntry;
+
+// ------------------------------------------------------------------------------
+// Class: SubframeCache
+//
+// Description: Memory bounded cache of decoded subframes (texels) that's shared
+// by all of the CadrgMaps (and their SubframeLoaders).  The subframes are keyed
+// by their frame file's path name, subframe row and column, and number of
+// components, so maps of the same data share their subframes.  When the cache
+// is over its max size, the least recently used subframes are dropped.
+//
+// get() - Copies a cached subframe's texels; returns false if not cached.
+//      static bool get(CadrgFrameEntry* const entry, const int row, const int col,
+//                      const int numComponents, unsigned char* const texels)
+//
+// decode() - Decodes the subframe using the frame (see CadrgFrame::decodeSubframe())
+// and adds it to the cache.
+//      static bool decode(CadrgFrameEntry* const entry, CadrgFrame* const frame,
+//                         const int row, const int col, const int numComponents,
+//                         unsigned char* const texels)
+//
+// setMaxSize() - Sets the max size of the cache (bytes); zero disables the cache.
+//      static void setMaxSize(const std::size_t bytes)
+//
+// Statistics - getHits(), getMisses(), getNumDecoded() and getDecodeTime()
+// (seconds), for all of the maps.
+//
+// Notes:
+//    1) Thread safe; the subframes are decoded outside of the cache's lock.
+//    2) The default max size is 32MB (about 170 RGB subframes).
+// ------------------------------------------------------------------------------
+class SubframeCache
+{
+public:
+    static const std::size_t DEFAULT_MAX_SIZE;
+
+    static bool get(CadrgFrameEntry* const entry, const int row, const int col, const int numComponents, unsigned char* const texels);
+    static bool decode(CadrgFrameEntry* const entry, CadrgFrame* const frame, const int row, const int col, const int numComponents, unsigned char* const texels);
+
+    static void setMaxSize(const std::size_t bytes);
+    static std::size_t getMaxSize();
+    static std::size_t getSize();
+    static void clear();
+
+    // Statistics
+    static unsigned long getHits();
+    static unsigned long getMisses();
+    static unsigned long getNumDecoded();
+    static double getDecodeTime();
+
+    SubframeCache() = delete;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,199 @@
+
+#ifndef __mixr_map_rpf_SubframeLoader_HPP__
+#define __mixr_map_rpf_SubframeLoader_HPP__
+
+#include "mixr/base/Component.hpp"
+#include "mixr/map/rpf/CadrgMap.hpp"
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace base { class Integer; class Number; }
+namespace rpf {
+class CadrgFrame;
+class CadrgFrameEntry;
+class CadrgTocEntry;
+class SubframeLoaderThread;
+
+// ------------------------------------------------------------------------------
+// Class: SubframeLoader
+//
+// Description: Background loader of a CadrgMap's subframes (i.e., its 256 x 256
+// tiles).  Pool threads read the frame files and decode the subframes ahead of
+// need, and the decoded subframes are held in an LRU cache for the texture
+// pagers, which only have to load them onto their textures.
+//
+// Factory name: SubframeLoader
+// Slots:
+//    numThreads  <Integer>   ! Number of loader threads (default: 2)
+//
+//    priority    <Number>    ! Priority of the loader threads (0->lowest, 1->highest)
+//                            ! (default: 0)
+//
+//    cacheSize   <Integer>   ! Max number of decoded subframes in the cache
+//                            ! (default: 128; about 192KB each)
+//
+//    lookAhead   <Integer>   ! Number of tiles to prefetch ahead of the map's
+//                            ! motion (default: 2)
+//
+// Example:
+//    ( CadrgMap
+//       ...
+//       loader: ( SubframeLoader numThreads: 2 cacheSize: 256 )
+//    )
+//
+// Notes:
+//    1) The loader is driven by the MapDrawer on the render thread.  Each
+//       frame, beginFrame() moves the finished subframes into the cache, the
+//       texture pagers use the cached subframes (getSubframe()) and request
+//       the others (request()), and endFrame() wakes the loader threads.
+//       Requests that aren't repeated by the next frame are dropped.
+//
+//    2) Requests are loaded by priority: the visible tiles, from the center
+//       out, then the tiles ahead of the map's motion (TexturePager), and then
+//       the center tiles of the next map level in the direction of the last
+//       zoom (CadrgMap::prefetchZoomLevel()).
+//
+//    3) The finished subframes are passed to the render thread using a
+//       lock-free list.  The cache is only used by the render thread.
+//
+//    4) The loader threads share a few loaded frames, so the 36 subframes of
+//       a frame are decoded from a single read of its file.
+//
+//    5) Without loader threads (e.g., they couldn't be created), endFrame()
+//       loads one subframe per frame; the same as not having a loader.
+// ------------------------------------------------------------------------------
+class SubframeLoader : public base::Component
+{
+    DECLARE_SUBCLASS(SubframeLoader, base::Component)
+
+public:
+    static const int MAX_THREADS {8};
+
+    // Request priorities; lower values are loaded first
+    enum { VISIBLE = 0, AHEAD = 1000, ZOOM = 2000 };
+
+    // A decoded subframe
+    struct Tile {
+        const CadrgTocEntry* toc {};        // TOC entry (zone and map level)
+        int row {};                         // Subframe row (see CadrgMap::getPixels())
+        int col {};                         // Subframe column
+        CadrgMap::ColorArray pixels;        // RGB texels
+        Tile* next {};                      // Next in the finished list
+    };
+
+public:
+    SubframeLoader();
+
+    int getNumThreads() const           { return numThreads; }
+    double getPriority() const          { return priority; }
+    int getCacheSize() const            { return cacheSize; }
+    int getLookAhead() const            { return lookAhead; }
+
+    virtual bool setNumThreads(const int);
+    virtual bool setPriority(const double);
+    virtual bool setCacheSize(const int);
+    virtual bool setLookAhead(const int);
+
+    // Render thread functions
+    void beginFrame();
+    const Tile* getSubframe(const CadrgTocEntry* const toc, const int row, const int col);
+    void request(CadrgTocEntry* const toc, const int row, const int col, const int pri);
+    void endFrame();
+
+    void reset() override;
+    bool shutdownNotification() override;
+
+private:
+    friend class SubframeLoaderThread;
+
+    // Subframe key
+    struct Key {
+        const CadrgTocEntry* toc {};
+        int row {};
+        int col {};
+        bool operator==(const Key& k) const   { return (toc == k.toc && row == k.row && col == k.col); }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const;
+    };
+
+    // Load request
+    struct Request {
+        Key key;
+        CadrgTocEntry* toc {};              // ref()'d
+        int pri {};                         // Priority
+        unsigned int frame {};              // Last requested by this frame
+    };
+
+    // Cached subframe
+    struct CacheEntry {
+        Tile* tile {};
+        std::list<Tile*>::iterator lru;
+    };
+
+    // Frame loaded by the loader threads
+    struct LoadedFrame {
+        CadrgFrameEntry* entry {};
+        CadrgFrame* frame {};               // ref()'d
+    };
+
+    static const int FRAMES_PER_THREAD {2}; // Loaded frames per loader thread
+
+    // Loader threads
+    void processRequests();
+    bool takeRequest(Request* const);
+    void finishRequest(const Request&, Tile* const);
+    Tile* newTile();
+    void decode(const Request&, Tile* const);
+    CadrgFrame* getFrame(CadrgFrameEntry* const);
+
+    void collect();
+    void clearCache();
+    void clearRequests();
+    void clearFrames();
+
+    void createThreads();
+    void deleteThreads();
+
+    // Render thread only
+    std::unordered_map<Key, CacheEntry, KeyHash> cache;    // Decoded subframes
+    std::list<Tile*> lru;                                   // Most recently used first
+
+    // Shared with the loader threads (semaphore)
+    std::vector<Request> pending;               // Waiting requests
+    std::vector<Key> busy;                      // Requests being loaded
+    std::vector<Tile*> freeTiles;               // Unused tiles
+    std::vector<LoadedFrame> frames;            // Loaded frames (most recently used first)
+    unsigned int frameCount {};                 // Render frame counter
+    mutable long semaphore {};
+
+    mutable long clutSemaphore {};              // Loading a frame entry's color table
+
+    std::atomic<Tile*> finished {};             // Finished tiles (lock-free list)
+
+    SubframeLoaderThread* threads[MAX_THREADS] {};
+    int numPoolThreads {};
+    bool threadsFailed {};
+    std::atomic<bool> stopping {};              // Loader threads are being stopped
+
+    int numThreads {2};                         // Number of loader threads
+    double priority {};                         // Loader thread priority
+    int cacheSize {128};                        // Max subframes in the cache
+    int lookAhead {2};                          // Tiles to prefetch ahead of the motion
+
+private:
+    // slot table helper methods
+    bool setSlotNumThreads(const base::Integer* const);
+    bool setSlotPriority(const base::Number* const);
+    bool setSlotCacheSize(const base::Integer* const);
+    bool setSlotLookAhead(const base::Integer* const);
+};
+
+}
+}
+
+#endif
@@ -7,6 +7,7 @@
 
 namespace mixr {
 namespace base { class List; }
+namespace graphics { class Texture; }
 namespace rpf {
 class CadrgMap;
 class CadrgTocEntry;
@@ -44,9 +45,16 @@ class CadrgTocEntry;
 //      void TexturePager::reuseTextures()
 //
 // loadNewTextures() - Create new texture objects for our table positions that
-// don't have one (not reused).
+// don't have one (not reused).  With the map's SubframeLoader, the subframes
+// are taken from the loader's cache (up to MAX_UPLOADS per frame) and the
+// missing ones are requested; otherwise, one subframe is loaded per frame.
 //      void TexturePager::loadNewTextures()
 //
+// prefetch() - Takes in the current pixel row and column of our reference
+// lat/lon, and requests the tiles ahead of its (smoothed) motion from the
+// map's SubframeLoader.
+//      void TexturePager::prefetch(const float originRow, const float originCol)
+//
 // flushTextures() - Clear out the textures and put them back on the stack. 
 //      void TexturePager::flushTextures()
 //
@@ -70,12 +78,17 @@ public:
 
     // Texture table operations
     void updateTextures(const int tRow, const int tCol);
+    void prefetch(const float originRow, const float originCol);
     void flushTextures();
 
 private:
+    static const int MAX_UPLOADS {2};           // Max cached subframes loaded onto textures per frame
+    static const float MIN_SPEED;               // Min motion (pixels per frame) to prefetch
+
     void freeTextures();
     void reuseTextures();
     void loadNewTextures();
+    graphics::Texture* useFreeTexture(const int r, const int c);
 
     base::List* stack {};
 
@@ -87,6 +100,13 @@ private:
     int diffRow {};
     int diffCol {};
     CadrgTocEntry* toc {};
+
+    // Motion of our reference point (pixels)
+    const CadrgTocEntry* lastToc {};
+    float lastRow {};
+    float lastCol {};
+    float velRow {};
+    float velCol {};
 };
 
 }
@@ -14,7 +14,7 @@
 // parseLocations() - At this point we are at the end of the header section 
 // and now we need to start reading the location data. - this function 
 // takes in a file, and finds the proper locations for our component types.
-//      void parseLocations(std::ifstream& fin, Location* locs, int count)
+//      void parseLocations(std::istream& fin, Location* locs, int count)
 //
 //------------------------------------------------------------------------------
 
@@ -143,7 +143,7 @@ struct Image {
 // Support functions
 
 // parseLocations() - Reads the proper locations in for the CADRG files.
-void parseLocations(std::ifstream& fin, Location* locs, int count);
+void parseLocations(std::istream& fin, Location* locs, int count);
 
 }
 }
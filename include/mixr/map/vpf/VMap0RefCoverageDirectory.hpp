@@ -5,6 +5,7 @@
 #include "mixr/map/vpf/VpfDirectory.hpp"
 
 #include <array>
+#include <vector>
 
 namespace mixr {
 namespace base { class Vec3d; }
@@ -61,7 +62,7 @@ private:
     std::array<VMap0FeatureClass*, MAX_FEATURE_CLASSES> featureClass {};
     int numFeatureClasses {};                      // Number of feature classes we have
 
-    std::array<int, 500> spatialQueryPrimIds {};   // Holds the primitive IDs of the last spatial query for quick access
+    std::vector<int> spatialQueryPrimIds;          // Holds the primitive IDs of the last spatial query for quick access
 
     std::array<VpfTable*, MAX_FEATURE_TABLES> featureTables {};
     std::array<VpfSpatialIndexTable*, MAX_SPATIAL_INDEX_TABLES> spatialTables {};
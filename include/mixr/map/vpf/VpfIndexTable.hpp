@@ -4,6 +4,8 @@
 
 #include "mixr/base/Object.hpp"
 
+#include <vector>
+
 namespace mixr {
 namespace base { class String; }
 namespace vpf {
@@ -12,7 +14,8 @@ class VpfDataType;
 // ------------------------------------------------------------
 // Class: VpfIndexTable
 // Description: Associated Index table with all tables which have
-// variable length text or coordinate strings
+// variable length text or coordinate strings; the index entries
+// (offset and length of each record) are loaded into memory.
 // ------------------------------------------------------------
 class VpfIndexTable : public base::Object
 {
@@ -34,6 +37,7 @@ private:
     int recordSize {sizeof(int) * 2};
     bool loaded {};
     base::String* fullPath {};
+    std::vector<int> entries;      // Offset and length of each record
 };
 
 }
@@ -4,6 +4,8 @@
 
 #include "mixr/base/Object.hpp"
 
+#include <vector>
+
 namespace mixr {
 namespace base { class String; }
 namespace vpf {
@@ -13,6 +15,16 @@ namespace vpf {
 // Description: Spatial index file which contains the minimum bounding 
 // rectangle (mbr) information about each primitive.  This allows
 // for quick referencing of primitives by area
+//
+// Notes:
+//    1) The file is read once, by loadIndexTableFromFile(), and its
+//       primitives are placed in an in-memory quadtree over the index's
+//       256 x 256 spatial grid; each primitive is held by the smallest
+//       quadtree node that contains its mbr.  A query only visits the
+//       nodes that overlap its point or area.
+//
+//    2) The primitive IDs are returned in the same order as they're
+//       listed by the file's cells.
 // ---------------------------------------------------------------
 class VpfSpatialIndexTable : public base::Object
 {
@@ -26,9 +38,36 @@ public:
     bool isLoaded()                 { return loaded; }
 
     int findPrimitivesBySpatialQuery(const float lat, const float lon, int primIds[], const float width = 0, const float height = 0);
+    int findPrimitivesBySpatialQuery(const float lat, const float lon, std::vector<int>& primIds, const float width = 0, const float height = 0) const;
 
 private:
-    void convertDegsToSpatialPoint(const float lat, const float lon, int& x, int& y);
+    // Primitive's mbr (spatial grid) and ID
+    struct Primitive {
+        unsigned char minLon {};
+        unsigned char minLat {};
+        unsigned char maxLon {};
+        unsigned char maxLat {};
+        int id {};
+    };
+
+    // Quadtree node
+    struct Node {
+        int x0 {}, y0 {};          // Lower left of the node's region (spatial grid)
+        int size {};               // Width and height of the node's region
+        int first {};              // First of our primitives in 'nodePrims'
+        int count {};              // Number of our primitives
+        int child[4] {-1, -1, -1, -1}; // Child nodes (or -1)
+    };
+
+    static const int MAX_LEAF_PRIMS {16};   // Primitives in a node before it's split
+    static const int MIN_NODE_SIZE {4};     // Smallest node (spatial grid)
+
+    int buildNode(std::vector<int>& list, const int x0, const int y0, const int size);
+    void searchNode(const int node, const bool spaceQuery, const int x, const int y,
+                    const int left, const int right, const int top, const int bottom,
+                    std::vector<int>& found) const;
+
+    void convertDegsToSpatialPoint(const float lat, const float lon, int& x, int& y) const;
     int type {1};
     int numPrims {};
     float mbrX1 {};
@@ -42,6 +81,10 @@ private:
     int binSize {};
     bool loaded {};
     base::String* fullPath {};
+
+    std::vector<Primitive> prims;  // Primitives, in the file's cell order
+    std::vector<Node> nodes;       // Quadtree nodes (root is the first)
+    std::vector<int> nodePrims;    // Primitives (indices) of each node
 };
 
 }
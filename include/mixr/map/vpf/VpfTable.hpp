@@ -5,6 +5,9 @@
 #include "mixr/base/Object.hpp"
 
 #include <array>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace mixr {
 namespace base { class List; class String; }
@@ -15,6 +18,15 @@ class VpfRecord;
 // --------------------------------------------------------------
 // Class: VpfTable
 // Description: Default vector product format table
+//
+// Notes:
+//    1) The table's file is read into memory once, by loadTableFromFile(),
+//       and its records are decoded from memory as they're needed.
+//
+//    2) The decoded records are held in a least recently used (LRU) cache of
+//       up to MAX_CACHED_RECORDS records; there's no limit on the number of
+//       rows.  getRecord() returns pre-ref()'d records, so a record that's
+//       dropped from the cache stays valid until its user unref()s it.
 // --------------------------------------------------------------
 class VpfTable : public base::Object
 {
@@ -76,16 +88,28 @@ public:
 
     // Size of one record (if we are fixed length)
     int getRecordSize()                         { return recordSize; }
-    VpfRecord* getRecord(const int idx);             
+    VpfRecord* getRecord(const int idx);        // Record 'idx' (Pre-ref()'d)
+
+    // The table's file contents (zero if the file isn't loaded)
+    const char* getFileData() const             { return (fileData.empty() ? nullptr : fileData.data()); }
+    std::size_t getFileSize() const             { return fileData.size(); }
 
     virtual bool loadTableFromFile(const char* pathname, const char* filename, const int xType = -1);
     static const int MAX_COLUMNS {50};
-    static const int MAX_ROWS    {5000};
+    static const int MAX_CACHED_RECORDS {4096};
 
     virtual void loadIndexFile();
 
 private:
+    // LRU record cache entry
+    struct CachedRecord {
+        VpfRecord* record {};                     // Decoded record
+        std::list<int>::iterator lru;             // Position in the LRU list
+    };
+
     void determineRecordSize();
+    void determineNumberOfRows();
+    void clearRecords();
     int headerLength {};   
     char byteOrder {};
     std::array<char, 255> tableDesc {};
@@ -100,7 +124,10 @@ private:
     base::String* name {};                        // Name of our table (basically the name of the file)
 
     std::array<ColumnDefinitions, MAX_COLUMNS> columns;
-    std::array<VpfRecord*, MAX_ROWS> records {};  // Holds our records
+    std::vector<char> fileData;                   // Contents of our file
+
+    std::unordered_map<int, CachedRecord> records;  // Cache of our decoded records (by index)
+    std::list<int> lru;                           // Cached record indices; most recently used first
 
     VpfIndexTable* idxTable {};                   // Holds our associated index table (if we need one)
     int type {};                                  // Type of table we are (header table, feature table, etc...)
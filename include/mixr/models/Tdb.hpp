@@ -5,7 +5,10 @@
 #include "mixr/models/system/System.hpp"
 #include "mixr/base/osg/Vec3d"
 
+#include <vector>
+
 namespace mixr {
+namespace terrain { class LosBatch; class LosService; class Terrain; }
 namespace models {
 class Gimbal;
 class Player;
@@ -35,8 +38,24 @@ class Player;
 //
 //       If we're using gaming area position vectors (i.e., not usingECEF()) then
 //       all target's with invalid gaming area position vectors are rejected.
+//
+//       When the world model has a line-of-sight service (see
+//       WorldModel::getLosService()), the terrain occulting checks of all
+//       of the candidate targets are queued in our line-of-sight batch, and
+//       they're left pending (see isLosPending()) until the batch has been
+//       evaluated by the service, either with the batches of the frame's
+//       other TDBs (see WorldModel::queueLosChecks()) or by itself using
+//       processLosChecks(); completeLosChecks() then adds the visible
+//       candidates to the targets.
+//       When the gimbal has a cached terrain viewshed that's ready for our
+//       position (see Gimbal::getViewshed()), most of the checks are table
+//       lookups, with the same answers; the targets near the edge of its
+//       mask or past its max range are checked the same as without it.
 //       
 // 
+//       A TDB, and its storage, can be reused from frame to frame; the
+//       targets of the last frame are cleared by processPlayers().
+//
 //       (Background task)
 //
 //    computeBoresightData() --- 
@@ -71,6 +90,24 @@ public:
    //------------------------------------------------------------------------------
    virtual unsigned int processPlayers(base::PairStream* const players);
 
+   // Terrain occulting checks, from processPlayers(), that are waiting for
+   // the line-of-sight service (see processPlayers())
+   bool isLosPending() const                          { return losPending; }
+
+   // The line-of-sight queries of the candidate targets
+   terrain::LosBatch* getLosBatch()                   { return losBatch; }
+
+   // Adds the visible candidate targets, after the line-of-sight batch has
+   // been processed, to the targets; returns the number of targets
+   virtual unsigned int completeLosChecks();
+
+   // Evaluates the pending line-of-sight batch by itself, and then completes
+   // the checks; returns the number of targets
+   unsigned int processLosChecks();
+
+   // Max number of targets (i.e., size of the arrays)
+   unsigned int getMaxTargets() const                 { return maxTargets; }
+
    // ---
    // Data from processPlayers()
    // ---
@@ -161,6 +198,16 @@ protected:
    double* za {};
    double* ra2 {};
    double* ra {};
+
+   // processPlayers() terrain occulting (using the line-of-sight service)
+   terrain::LosBatch* losBatch {};     // Line-of-sight queries (reused from frame to frame)
+   std::vector<Player*> losCandidates; // Candidate targets (one per query; ref()'d)
+   const terrain::Terrain* losTerrain {};       // Terrain of the pending checks
+   const terrain::LosService* losService {};    // Service of the pending checks
+   bool losPending {};                 // Checks are waiting for the service
+
+private:
+   void clearLosCandidates();
 };
 
 }
@@ -4,11 +4,15 @@
 
 #include "mixr/simulation/Simulation.hpp"
 
+#include <vector>
+
 namespace mixr {
 namespace base { class Boolean; class Identifier; class Latitude; class Length; class Longitude; class Number; }
-namespace terrain { class Terrain; }
+namespace terrain { class LosBatch; class LosService; class Terrain; }
 namespace models {
 class AbstractAtmosphere;
+class Gimbal;
+class Tdb;
 
 //------------------------------------------------------------------------------
 // Class: WorldModel
@@ -43,6 +47,7 @@ class AbstractAtmosphere;
 //
 //    terrain        <terrain:Terrain>        ! Terrain elevation database (default: nullptr)
 //    atmosphere     <Atmosphere>             ! Atmosphere
+//    losService     <terrain::LosService>    ! Batched terrain line-of-sight service (default: nullptr)
 //
 
 // Gaming area reference point:
@@ -72,7 +77,14 @@ class AbstractAtmosphere;
 // Environments:
 //
 //    Current simulation environments include terrain elevation posts, getTerrain(),
-//    and atmosphere model, getAtmosphere().
+//    and atmosphere model, getAtmosphere().  The optional line-of-sight service,
+//    getLosService(), evaluates batches of terrain occulting queries (e.g., the
+//    Tdb's targets) against the terrain.  The gimbals queue their TDBs' checks
+//    with queueLosChecks() during the background frame, and at the end of
+//    updateData(), after all of the players have been updated, all of the
+//    frame's checks are evaluated as one batch, whose storage is reused from
+//    frame to frame, and the TDBs are handed back to their gimbals (see
+//    Gimbal::losChecksProcessed()).
 //
 // Shutdown:
 //
@@ -111,7 +123,15 @@ public:
     const terrain::Terrain* getTerrain() const;            // returns the terrain elevation database
     AbstractAtmosphere* getAtmosphere();                   // returns the atmosphere model
     const AbstractAtmosphere* getAtmosphere() const;       // returns the atmosphere model (const version)
+    const terrain::LosService* getLosService() const;      // returns the line-of-sight service
+
+    // Queues the gimbal's TDB, whose terrain occulting checks are pending (see
+    // Tdb::isLosPending()), with the frame's other checks; returns false if
+    // they can't be queued (i.e., no service or not within updateData()), and
+    // then the TDB evaluates them itself.  (Background task)
+    virtual bool queueLosChecks(Gimbal* const gimbal, Tdb* const tdb);
 
+    void updateData(const double dt = 0.0) override;
     void reset() override;
 
 protected:
@@ -126,8 +146,12 @@ protected:
     terrain::Terrain* getTerrain();                        // returns the terrain elevation database
     bool shutdownNotification() override;
 
+    // Evaluates the frame's queued terrain occulting checks as one batch
+    virtual void processLosChecks();
+
 private:
    void initData();
+   void clearLosChecks();
 
    // Our Earth Model, or default to using base::EarthModel::wgs84 if zero
    const base::EarthModel* em{};
@@ -146,6 +170,18 @@ private:
 
    AbstractAtmosphere* atmosphere {};
    terrain::Terrain* terrain {};
+   terrain::LosService* losService {};
+
+   // The frame's terrain occulting checks (see queueLosChecks())
+   struct LosChecks {
+      Gimbal* gimbal {};
+      Tdb* tdb {};
+   };
+   std::vector<LosChecks> losChecks;            // Queued checks
+   std::vector<terrain::LosBatch*> losBatches;  // Batches of the queued TDBs
+   terrain::LosBatch* losFrameBatch {};         // All of the frame's queries (reused)
+   long losSemaphore {};                        // Semaphore for 'losChecks'
+   bool losQueueing {};                         // Checks can be queued (within updateData())
 
 private:
    // slot table helper methods
@@ -162,6 +198,7 @@ private:
    // environmental interface
    bool setSlotTerrain(terrain::Terrain* const);
    bool setSlotAtmosphere(AbstractAtmosphere* const);
+   bool setSlotLosService(terrain::LosService* const);
 };
 
 }
@@ -9,6 +9,7 @@
 
 namespace mixr {
 namespace base { class Angle; class Boolean; class Identifier; class Integer; class Length; class List; class Number; class PairStream; }
+namespace terrain { class Viewshed; }
 namespace models {
 class Emission;
 class SensorMsg;
@@ -27,7 +28,12 @@ class Tdb;
 //    own players of interest.  This gimbal class has its own variation of the
 //    processPlayersOfInterest() function that filters field of view and player
 //    type.  However, it is still the responsibility of the systems to use
-//    or not use our member function.
+//    or not use our member function.  Its target data block (TDB) is reused
+//    from frame to frame once no one else is using it, and when the TDB's
+//    terrain occulting checks are batched with the line-of-sight service,
+//    they're queued with the frame's other checks (see
+//    WorldModel::queueLosChecks()), and the TDB becomes the current TDB
+//    after they've been processed (see losChecksProcessed()).
 //
 //    3) Gimbal coordinates:
 //       X+ is along the gimbal/sensor boresight
@@ -91,6 +97,8 @@ class Tdb;
 //
 //    terrainOcculting     <Boolean>      ! Enable terrain occulting of the players of interest (default: false)
 //    checkHorizon         <Boolean>      ! Enable horizon masking check (default: true)
+//    viewshed             <terrain::Viewshed> ! Cached terrain viewshed, which is used for the terrain occulting
+//                                        ! checks while our player is stationary (default: none)
 //
 //    playerOfInterestTypes        <PairStream> ! List of player of interest types (default: all types )
 //                                              ! Valid identifiers: { air, ground, weapon, ship, building, lifeform, space }
@@ -216,6 +224,7 @@ public:  // Public section
    bool isLocalPlayersOfInterestOnly() const { return localOnly; }          // Local only players of interest flag
    bool isTerrainOccultingEnabled() const  { return terrainOcculting; }     // Terrain occulting enabled flag
    bool isHorizonCheckEnabled() const      { return checkHorizon; }         // Horizon masking enable flag
+   const terrain::Viewshed* getViewshed() const { return viewshed; }        // Cached terrain viewshed (or zero if none)
    bool isUsingWorldCoordinates() const    { return useWorld; }             // Returns true if using player of interest's world coordinates
    bool isUsingHeadingOnly() const         { return ownHeadingOnly; }       // Returns true if using players heading only
    double getEarthRadius() const;                                           // Returns earth radius (meters)
@@ -234,6 +243,10 @@ public:  // Public section
    // Process the Players-Of-Interest (POI) list
    virtual unsigned int processPlayersOfInterest(base::PairStream* const poi);
 
+   // Completes the TDB whose terrain occulting checks were queued with the
+   // world model, after they've been processed, and makes it the current TDB
+   virtual void losChecksProcessed(Tdb* const);
+
    // Sets the servo mode: { FREEZE_SERVO, RATE_SERVO, POSITION_SERVO }
    // Returns false if the mode could not be changed
    virtual bool setServoMode(const ServoMode);
@@ -278,6 +291,9 @@ protected:
    virtual bool setType(const Type rt);
    virtual void updateMatrix();
 
+   // Updates the cached terrain viewshed for our ownship's position
+   virtual void updateViewshed();
+
    Tdb* getCurrentTDB();               // Get the current TDB (pre-ref())
    const Tdb* getCurrentTDB() const;   // Get the current TDB (pre-ref(); const version)
 
@@ -324,8 +340,14 @@ private:
    bool     checkHorizon{true};       // Horizon masking check enabled flag
    bool     useWorld{true};           // Using player of interest's world coordinates
    bool     ownHeadingOnly{true};     // Whether only the ownship heading is used by the target data block
+   terrain::Viewshed* viewshed{};     // Cached terrain viewshed (stationary sensors)
 
    base::safe_ptr<Tdb> tdb;           // Target Data Block
+   Tdb* pendingTdb{};                 // TDB waiting for its terrain occulting checks
+   Tdb* spareTdb{};                   // Last TDB; reused once no one else is using it
+
+   void makeCurrentTdb(Tdb* const);
+   void clearTdbs();
 
 private:
    // slot table helper methods
@@ -379,6 +401,7 @@ private:
    bool setSlotUseWorldCoordinates(const base::Boolean* const);
 
    bool setSlotUseOwnHeadingOnly(const base::Boolean* const);
+   bool setSlotViewshed(terrain::Viewshed* const);
 };
 
 }
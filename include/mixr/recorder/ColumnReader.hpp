@@ -0,0 +1,112 @@
+
+#ifndef __mixr_recorder_ColumnReader_HPP__
+#define __mixr_recorder_ColumnReader_HPP__
+
+#include "mixr/base/Object.hpp"
+#include "mixr/recorder/column_utils.hpp"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace mixr {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Class: ColumnReader
+// Description: Reads a columnar data table written by the ColumnWriter
+//
+// Notes:
+//    1) The table's footer (column definitions, dictionaries and row group
+//       index) is read by openFile().
+//
+//    2) select() reads only the requested columns (projection) of the rows
+//       within a time range; row groups outside of the time range are
+//       skipped without being read.
+//
+//    3) The PLAYER and TRACK columns are dictionary indices; use the
+//       getPlayerXxx() and getTrackXxx() functions to decode them.
+//
+// Example:
+//    // all detonations between 100 and 200 seconds
+//    ColumnReader reader;
+//    reader.openFile("run1_detonations.col");
+//    const unsigned int cols[] { reader.findColumn("pos_x"), ... };
+//    std::vector<ColumnReader::Column> result;
+//    reader.select(cols, 3, 100.0, 200.0, &result);
+//------------------------------------------------------------------------------
+class ColumnReader : public base::Object
+{
+   DECLARE_SUBCLASS(ColumnReader, base::Object)
+
+public:
+   // Selected column data
+   struct Column {
+      unsigned int index {};              // Column index
+      ColumnType type {ColumnType::F64};  // Column type
+      std::vector<double> f64;            // F64 column values
+      std::vector<std::uint32_t> u32;     // U32, PLAYER and TRACK column values
+   };
+
+   static const unsigned int NOT_FOUND = 0xffffffff;
+
+public:
+   ColumnReader();
+
+   bool isOpen() const;                               // Is the table file open?
+   bool openFile(const char* const filename);         // Open the table file and read its footer
+   void closeFile();                                  // Close the table file
+
+   ColumnTable getTable() const;                      // Table type
+   unsigned int getNumColumns() const;                // Number of columns
+   const char* getColumnName(const unsigned int idx) const;
+   ColumnType getColumnType(const unsigned int idx) const;
+   unsigned int findColumn(const char* const name) const;   // Column index by name, or NOT_FOUND
+
+   unsigned int getNumRowGroups() const;              // Number of row groups
+   unsigned int getNumRows() const;                   // Total number of rows
+   double getStartTime() const;                       // Time span of the table
+   double getEndTime() const;
+
+   // Player dictionary
+   unsigned int getNumPlayers() const;
+   unsigned int getPlayerId(const unsigned int idx) const;
+   const char* getPlayerName(const unsigned int idx) const;
+   const char* getPlayerFederate(const unsigned int idx) const;
+
+   // Track dictionary
+   unsigned int getNumTracks() const;
+   const char* getTrackId(const unsigned int idx) const;
+   unsigned int getTrackPlayer(const unsigned int idx) const;  // Player dictionary index of the track's owner
+
+   // Reads the 'n' columns listed in 'columns' for all rows with a time in the
+   // range [ startTime ... endTime ]; returns the number of rows selected.
+   unsigned int select(
+      const unsigned int* const columns,     // Column indices
+      const unsigned int n,                  // Number of columns
+      const double startTime,                // Time range (seconds)
+      const double endTime,
+      std::vector<Column>* const result      // One column of values per selected column
+   );
+
+private:
+   bool readFooter();
+
+   struct Group { std::uint64_t offset; unsigned int rows; double startTime; double endTime; };
+   struct Player { unsigned int id; std::string federate; std::string name; };
+   struct Track { unsigned int player; std::string id; };
+   struct ColumnInfo { ColumnType type; std::string name; };
+
+   std::ifstream* sin {};
+   ColumnTable table {ColumnTable::PLAYER_DATA};
+   std::vector<ColumnInfo> columnInfo;
+   std::vector<Player> players;
+   std::vector<Track> tracks;
+   std::vector<Group> groups;
+   std::string buff;                  // Read buffer
+};
+
+}
+}
+
+#endif
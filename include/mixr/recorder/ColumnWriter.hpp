@@ -0,0 +1,121 @@
+
+#ifndef __mixr_recorder_ColumnWriter_HPP__
+#define __mixr_recorder_ColumnWriter_HPP__
+
+#include "mixr/recorder/OutputHandler.hpp"
+#include "mixr/recorder/column_utils.hpp"
+
+#include <array>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mixr {
+namespace base { class Integer; class Number; class String; }
+namespace recorder {
+namespace pb { class PlayerId; class EmissionData; }
+
+//------------------------------------------------------------------------------
+// Class: ColumnWriter
+// Description: Writes the recorded data as typed columnar tables for after-action
+//              analysis; one table file per record type (see column_utils.hpp)
+//
+//    <filename>_players.col      ! REID_PLAYER_DATA records
+//    <filename>_tracks.col       ! REID_NEW_TRACK, REID_TRACK_DATA and REID_TRACK_REMOVED records
+//    <filename>_detonations.col  ! REID_WEAPON_DETONATION records
+//    <filename>_emissions.col    ! Emission data of the track records
+//
+// Factory name: RecorderColumnWriter
+// Slots:
+//     filename       <String>     ! Table file name prefix (required)
+//     pathname       <String>     ! Path to the table files' directory (optional)
+//     rowGroupTime   <Number>     ! Sim time span of each row group (seconds) (default: 60)
+//     maxGroupRows   <Integer>    ! Max number of rows in a row group (default: 65536)
+//
+// Notes:
+//    1) To convert a recorded data file, pass the records read by a FileReader
+//       to this output handler (in the same way as the TabPrinter)
+//
+//    2) The table files are closed, and their footers written, with the
+//       end of data (REID_END_OF_DATA) message or at shutdown.
+//
+//    3) Use ColumnReader to read the tables.
+//------------------------------------------------------------------------------
+class ColumnWriter : public OutputHandler
+{
+   DECLARE_SUBCLASS(ColumnWriter, OutputHandler)
+
+public:
+   ColumnWriter();
+
+   bool isOpen() const;                   // Are the table files open?
+
+   bool openFiles();                      // Open the table files
+   void closeFiles();                     // Close the table files (writes the footers)
+
+   // Set before calling openFiles()
+   virtual bool setFilename(const base::String* const);
+   virtual bool setPathName(const base::String* const);
+   virtual bool setRowGroupTime(const double);
+   virtual bool setMaxGroupRows(const unsigned int);
+
+protected:
+   void processRecordImp(const DataRecordHandle* const handle) override;
+
+   bool shutdownNotification() override;
+
+private:
+   // One table file
+   struct Table {
+      std::ofstream* sout {};
+      std::vector<ColumnDef> columns;
+      std::vector<std::string> data;       // Row group column data (encoded)
+      unsigned int numRows {};             // Rows in this row group
+      double startTime {};                 // Row group time span
+      double endTime {};
+      struct GroupIndex { std::uint64_t offset; unsigned int rows; double startTime; double endTime; };
+      std::vector<GroupIndex> groups;      // Row group index
+   };
+
+   std::uint32_t playerIndex(const pb::PlayerId& id);
+   std::uint32_t trackIndex(const std::uint32_t player, const std::string& trackId);
+
+   void beginRow(Table& table, const double time);
+   void endRow(Table& table);
+   void writeGroup(Table& table);
+   void writeFooter(Table& table);
+
+   void addEmission(const double time, const std::uint32_t player, const std::uint32_t track, const pb::EmissionData& em);
+
+   std::array<Table, NUM_COLUMN_TABLES> tables;
+
+   // Dictionaries
+   std::map<std::pair<std::uint32_t, std::string>, std::uint32_t> playerMap;   // (id, federate) -> index
+   std::vector<std::pair<std::uint32_t, std::string>> playerIds;               // index -> (id, federate)
+   std::vector<std::string> playerNames;                                       // index -> name
+   std::map<std::pair<std::uint32_t, std::string>, std::uint32_t> trackMap;    // (player index, track id) -> index
+   std::vector<std::pair<std::uint32_t, std::string>> trackIds;                // index -> (player index, track id)
+
+   std::string filename;            // Table file name prefix
+   std::string pathname;            // Path to the table files
+   double rowGroupTime {60.0};      // Row group time span (seconds)
+   unsigned int maxGroupRows {65536};
+
+   bool filesOpened {};
+   bool filesFailed {};
+   bool eodFlag {};                 // REID_END_OF_DATA message has been processed
+
+private:
+   // slot table helper methods
+   bool setSlotFilename(const base::String* const x)                { return setFilename(x); }
+   bool setSlotPathName(const base::String* const x)                { return setPathName(x); }
+   bool setSlotRowGroupTime(const base::Number* const);
+   bool setSlotMaxGroupRows(const base::Integer* const);
+};
+
+}
+}
+
+#endif
@@ -25,6 +25,15 @@ class OutputHandler;
 // Notes:
 //    1) negative time values are used when time is unknown.
 //
+//    2) Only the records accepted by at least one output handler (see their
+//       'enabledList' and 'disabledList' slots) are created.  The set of
+//       accepted IDs is updated when the output handler is set and at reset;
+//       call updateConsumedIds() after changing the output handlers' filters.
+//
+//    3) The new player and weapon release records also include the player's
+//       side, major type and type string (see genPlayerType()), which are used
+//       to select the player templates of a replay (see ReplayNetIO).
+//
 //------------------------------------------------------------------------------
 // Recorder events handled ---
 //
@@ -39,6 +48,7 @@ class OutputHandler;
 //    REID_PLAYER_COLLISION   ! obj[0] => (player); obj[1] => (other player)
 //    REID_PLAYER_CRASH       ! obj[0] => (player)
 //    REID_PLAYER_KILLED      ! obj[0] => (player); obj[1] => (shooter)
+//    REID_PLAYER_FRAME       ! obj[0] => (player list)
 //
 //    REID_WEAPON_RELEASED    ! obj[0] => (weapon); obj[1] => (shooter); obj[2] => (tgt)
 //    REID_WEAPON_HUNG        ! obj[0] => (weapon); obj[1] => (shooter); obj[2] => (tgt)
@@ -71,6 +81,9 @@ public:
    void processRecords() override;
    void reset() override;
 
+   // Update the set of IDs accepted by our output handlers
+   void updateConsumedIds();
+
 protected:
    // Get functions
    OutputHandler* getOutputHandler();
@@ -83,6 +96,7 @@ protected:
 
    // data filler functions
    virtual void genPlayerId( pb::PlayerId* const id, const models::Player* const player );
+   virtual void genPlayerType( pb::PlayerId* const id, const models::Player* const player );
    virtual void genPlayerState( pb::PlayerState* const state, const models::Player* const player );
    virtual void genTrackData( pb::TrackData* const trkMsg, const models::Track* const track );
    virtual void genEmissionData( pb::EmissionData* const emMsg, const models::Emission* const emData);
@@ -102,6 +116,7 @@ protected:
    virtual bool recordPlayerCollision(const base::Object* objs[4], const double values[4]);
    virtual bool recordPlayerCrash(const base::Object* objs[4], const double values[4]);
    virtual bool recordPlayerKilled(const base::Object* objs[4], const double values[4]);
+   virtual bool recordPlayerFrame(const base::Object* objs[4], const double values[4]);
    virtual bool recordWeaponReleased(const base::Object* objs[4], const double values[4]);
    virtual bool recordWeaponHung(const base::Object* objs[4], const double values[4]);
    virtual bool recordWeaponDetonation(const base::Object* objs[4], const double values[4]);
@@ -3,10 +3,17 @@
 #define __mixr_recorder_FileReader_HPP__
 
 #include "mixr/recorder/InputHandler.hpp"
+#include "mixr/recorder/block_utils.hpp"
+#include "mixr/base/safe_ptr.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Boolean; class Integer; class String; }
 namespace recorder {
+class FileReaderThread;
+class FileParserThread;
 
 //------------------------------------------------------------------------------
 // Class: FileReader
@@ -16,52 +23,159 @@ namespace recorder {
 // Slots:
 //     filename       <String>     ! Data file name (required)
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     numWorkers     <Integer>    ! Number of parse worker threads, or zero to read and
+//                                 ! parse the records on the caller's thread (default: 0)
+//     readAhead      <Integer>    ! Number of batches of records read ahead of the
+//                                 ! caller (default: 16; max: MAX_READ_AHEAD)
+//     resync         <Boolean>    ! Skip the damaged regions of a block compressed file and
+//                                 ! resynchronize at the next valid block (default: true)
 //
 // Notes
 //    1) The data file consists of a sequence of serialized data records
 //    that are preceded by 4 bytes that provided the size of each data record
 //    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
 //    (e.g., " 123")
+//
+//    2) Block compressed data files (see FileWriter's 'blockSize' slot) are
+//    detected by their file header, and their blocks are decompressed as the
+//    data records are read.
+//
+//    3) When 'numWorkers' is set, the data file is played back by a pipeline:
+//    a read-ahead thread reads batches of serialized records (one compressed
+//    block, or up to BATCH_SIZE uncompressed records) into a bounded ring of
+//    'readAhead' batches, and the parse worker threads decompress and parse
+//    the batches.  The records are still returned by readRecord() strictly
+//    in file order; the caller waits only when the pipeline is empty.  The
+//    threads are stopped at the end of the file, and by closeFile(), rewind()
+//    and the SHUTDOWN_EVENT.
+//
+//    The pipeline's threads and the caller wait for work by sleeping for a
+//    millisecond at a time (base::msleep()), so, when the pipeline runs empty,
+//    the next batch can be returned up to about a millisecond after it's been
+//    parsed.  The threads don't sleep while there's work to do, so the read
+//    rate of a full pipeline isn't affected.
+//
+//    4) The number of records read and the read rate are reported (MSG_INFO)
+//    when the file is closed.
+//
+//    5) Each block of a block compressed file is checked (header and payload
+//    checksums).  A damaged block (e.g., the last block of a file whose writer
+//    was killed) ends the playback, unless 'resync' is enabled, in which case
+//    the reader scans for the sync marker of the next valid block.  The damaged
+//    regions are reported (MSG_WARNING).  A record of a valid block that can't
+//    be parsed damages the rest of its block the same way.  Legacy files can't
+//    be resynchronized, so any error ends their playback.
+//    See "mixr/recorder/file_recovery.hpp" to check and repair a file.
 //------------------------------------------------------------------------------
 class FileReader : public InputHandler
 {
     DECLARE_SUBCLASS(FileReader, InputHandler)
 
 public:
-   static const unsigned int MAX_INPUT_BUFFER_SIZE = 2000;
+   static const unsigned int MAX_INPUT_BUFFER_SIZE = 10000;   // Max record size of a legacy file (4 ascii digits)
+   static const unsigned int MAX_WORKERS = 16;        // Max number of parse worker threads
+   static const unsigned int MAX_READ_AHEAD = 256;    // Max number of batches read ahead
+   static const unsigned int BATCH_SIZE = 256;        // Records per batch of an uncompressed file
 
 public:
    FileReader();
 
    bool isOpen() const;             // Is the data file open?
    bool isFailed() const;           // Did we have an open or read error?
+   bool isBlockFile() const;        // Is this a block compressed data file?
+   unsigned int getNumWorkers() const;
+   unsigned int getReadAhead() const;
+   bool isResyncEnabled() const;               // Skip damaged blocks?
+   unsigned int getNumDamagedBlocks() const;   // Number of damaged regions skipped
+   std::uint64_t getNumSkippedBytes() const;   // Number of damaged bytes skipped
 
    virtual bool openFile();         // Open the data file
    virtual void closeFile();        // Close the data file
 
+   bool rewind() override;          // Re-open the data file at its first record
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const);
    virtual bool setPathName(const base::String* const);
 
+   // Playback pipeline; set before calling openFile()
+   virtual bool setNumWorkers(const unsigned int);
+   virtual bool setReadAhead(const unsigned int);
+
+   // Skip damaged blocks
+   virtual bool setResync(const bool);
+
 protected:
    const DataRecordHandle* readRecordImp() override;
 
+   bool shutdownNotification() override;
+
 private:
+   friend class FileReaderThread;
+   friend class FileParserThread;
+
+   // Batch of serialized data records (playback pipeline)
+   struct Batch;
+
    void initData();
+   bool readBlock();                 // Read and decompress the next block
+   BlockStatus readBlockData(BlockHeader* const, std::string* const);   // Read the next valid block
+
+   // Playback pipeline
+   bool startPlayback();             // Create the read-ahead and parse threads
+   void stopThreads();               // Stop the threads and wait for them to finish
+   void stopPlayback();              // Stop the threads and release the batches
+   const DataRecordHandle* nextPlaybackRecord();
+   unsigned int readBatches();       // Read ahead (read-ahead thread); returns number of batches read
+   bool readBatch(Batch* const);     // Read one batch; returns false at the end of the file
+   unsigned int parseBatches();      // Parse one read batch (parse threads); returns number parsed
+   void parseBatch(Batch* const);
+   void threadStarted();             // Called by the threads as they start
+   bool isReadDone() const;
+   bool isPlaybackStop() const;
+   void setFileFailed();             // Open or read failed
 
    char* ibuf {};                    // Input data buffer
 
+   bool blockFile {};                // Block compressed data file
+   std::string blockData;            // Decompressed block
+   std::string blockBuff;            // Compressed block
+   std::size_t blockPos {};          // Position of the next record in 'blockData'
+
    std::ifstream* sin {};            // Input stream
    const base::String* filename {};  // File name
    const base::String* pathname {};  // Path to the data file's directory
    bool fileOpened {};               // File opened
    bool fileFailed {};               // Open or read failed
    bool firstPassFlg {true};         // First pass flag
+   bool resync {true};               // Skip damaged blocks
+
+   unsigned int numWorkers {};       // Number of parse worker threads
+   unsigned int readAhead {16};      // Number of batches in the ring
+   Batch* batches {};                // Ring of batches
+   unsigned int readIdx {};          // Next batch to read (read-ahead thread)
+   unsigned int nextIdx {};          // Next batch to return records from (caller)
+   bool readDone {};                 // Read-ahead thread reached the end of the file
+   bool playbackStop {};             // Stop the playback threads
+   bool playback {};                 // Playback pipeline is running
+   unsigned int numStarted {};       // Number of threads that have started
+   base::safe_ptr<FileReaderThread> reader;
+   std::array<base::safe_ptr<FileParserThread>, MAX_WORKERS> workers;
+   mutable long semaphore {};        // Guards the batch states, and the flags shared with the threads
+
+   // statistics
+   double numRecords {};             // Number of records read
+   unsigned int numDamaged {};       // Number of damaged regions skipped
+   std::uint64_t numSkippedBytes {}; // Number of damaged bytes skipped
+   double startTime {};              // Computer time that the file was opened
 
 private:
    // slot table helper methods
    bool setSlotFilename(const base::String* const x)                 { return setFilename(x); }
    bool setSlotPathName(const base::String* const x)                 { return setPathName(x); }
+   bool setSlotNumWorkers(const base::Integer* const);
+   bool setSlotReadAhead(const base::Integer* const);
+   bool setSlotResync(const base::Boolean* const);
 };
 
 }
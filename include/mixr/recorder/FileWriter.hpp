@@ -3,10 +3,14 @@
 #define __mixr_recorder_FileWriter_HPP__
 
 #include "mixr/recorder/OutputHandler.hpp"
+#include "mixr/base/safe_ptr.hpp"
+#include "mixr/base/safe_queue.hpp"
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Integer; class Number; class String; }
 namespace recorder {
+class FileWriterThread;
+struct RecordBlock;
 
 //------------------------------------------------------------------------------
 // Class: FileWriter
@@ -17,12 +21,32 @@ namespace recorder {
 // Slots:
 //     filename       <String>     ! Data file name
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     blockSize      <Integer>    ! Number of data records per compressed block, or zero
+//                                 ! to write the uncompressed format (default: 0)
+//     compressionLevel <Integer>  ! zlib compression level [ 1 .. 9 ], or -1 for the
+//                                 ! zlib default level (default: -1)
+//     maxBlockTime   <Number>     ! Max sim time span of a block (seconds), or zero
+//                                 ! for no limit (default: 0)
 //
 // Note:
-//    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    1) The (uncompressed) data file consists of a sequence of serialized data
+//    records that are preceded by 4 bytes that provided the size of each data
+//    record in bytes.  The 4 bytes are stored as an ascii string with leading
+//    spaces (e.g., " 123"), so larger records (e.g., the player frame snapshots
+//    of large scenarios) can only be written using blocks.
+//
+//    When 'blockSize' is set, the data records are batched into blocks that
+//    are compressed independently (see "mixr/recorder/block_utils.hpp").
+//    A block is closed when it holds 'blockSize' records or MAX_BLOCK_BYTES of
+//    serialized data, and is then compressed and written by a background
+//    thread.  FileReader reads both formats.
+//
+//    Each block is flushed to the file as it's written, and carries its own
+//    sync marker and checksums, so a writer that is killed loses at most the
+//    blocks in progress; use 'maxBlockTime' to bound that loss in sim time.
+//    The FileReader skips a damaged block, and recoverRecorderFile() (see
+//    "mixr/recorder/file_recovery.hpp") truncates the file to its last good
+//    block.
 //
 //    2) During open(), if the file already exists then a version number is appended
 //    to the end of the file name.  (e.g., filename_v01 to filename_v99)
@@ -38,6 +62,11 @@ class FileWriter : public OutputHandler
 {
     DECLARE_SUBCLASS(FileWriter, OutputHandler)
 
+public:
+   static const unsigned int MAX_BLOCK_BYTES = 1024 * 1024;
+   static const unsigned int MAX_QUEUED_BLOCKS = 16;
+   static const unsigned int MAX_LEGACY_RECORD_SIZE = 9999;   // Max record size of an unblocked file (4 ascii digits)
+
 public:
    FileWriter();
 
@@ -53,10 +82,19 @@ public:
    const char* getFullFilename() const;   // File name with path and possible version number
                                           // (valid only while file is open)
 
+   unsigned int getBlockSize() const;     // Records per compressed block (zero for uncompressed)
+   int getCompressionLevel() const;       // zlib compression level
+   double getMaxBlockTime() const;        // Max sim time span of a block (seconds)
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const);
    virtual bool setPathName(const base::String* const);
 
+   // Block compression; set before calling openFile()
+   virtual bool setBlockSize(const unsigned int);
+   virtual bool setCompressionLevel(const int);
+   virtual bool setMaxBlockTime(const double);
+
 protected:
    void setFullFilename(const char* const);
 
@@ -65,6 +103,14 @@ protected:
    bool shutdownNotification() override;
 
 private:
+   friend class FileWriterThread;
+   unsigned int writeQueuedBlocks();      // Compress and write queued blocks; returns number written
+
+   void queueBlock();                     // Queue the current block to be compressed and written
+   void waitForQueuedBlocks();            // Wait until all queued blocks have been written
+   void writeBlock(const RecordBlock* const);
+   bool createWriterThread();
+
    std::ofstream* sout {};            // Output stream
 
    char* fullFilename {};             // Full file name of the output file
@@ -75,10 +121,29 @@ private:
    bool fileFailed {};                // Open or write failed
    bool eodFlag {};                   // REID_END_OF_DATA message has been written
 
+   unsigned int blockSize {};         // Records per compressed block (zero for the uncompressed format)
+   int compressionLevel {-1};         // zlib compression level
+   double maxBlockTime {};            // Max sim time span of a block (seconds)
+
+   RecordBlock* block {};                                // Block being filled
+   base::safe_queue<RecordBlock*> blockQueue {MAX_QUEUED_BLOCKS};  // Blocks waiting to be written
+   base::safe_ptr<FileWriterThread> thread;              // Compression and write thread
+   unsigned int numPending {};                           // Number of queued blocks not yet written
+   mutable long semaphore {};
+
+   // Statistics
+   unsigned int numRecords {};        // Number of records written
+   double numRawBytes {};             // Serialized data record bytes
+   double numFileBytes {};            // Bytes written to the file
+   double writeTime {};               // Time spent serializing, compressing and writing (seconds)
+
 private:
    // slot table helper methods
    bool setSlotFilename(const base::String* const x)                { return setFilename(x); }
    bool setSlotPathName(const base::String* const x)                { return setPathName(x); }
+   bool setSlotBlockSize(const base::Integer* const);
+   bool setSlotCompressionLevel(const base::Integer* const);
+   bool setSlotMaxBlockTime(const base::Number* const);
 };
 
 }
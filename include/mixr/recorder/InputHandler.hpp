@@ -22,6 +22,10 @@ public:
    // Read one data record; returns zero if no record is available
    const DataRecordHandle* readRecord();
 
+   // Restart the input at its first data record; returns false if this
+   // input can't be restarted (default)
+   virtual bool rewind();
+
 protected:
    // Read one record from our data source
    // -- Must be implemented by our derived classes
@@ -0,0 +1,82 @@
+#ifndef __mixr_recorder_LineBuffer_HPP__
+#define __mixr_recorder_LineBuffer_HPP__
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace mixr {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Class: LineBuffer
+// Description: Fixed-capacity text output buffer used by the print handlers
+//
+//    Values are formatted with the operator<<() functions directly into a
+//    buffer of BUFFER_SIZE characters, which is written to the output stream
+//    (default: the standard output) in blocks; when a value doesn't fit, the
+//    buffered text is written first.  Formatting doesn't use the stream's
+//    formatting, construct a stream or allocate memory.
+//
+//    The values are formatted the same as the standard stream operators with
+//    the stream's default format state: integers are decimal, bool values are
+//    1 or 0, and floating point values use printf's "%g" format (i.e., the
+//    default precision of six digits).
+//
+// Example:
+//    lineBuff << "PLAYER" << divider << x << divider << '\n';
+//    lineBuff.flush();
+//------------------------------------------------------------------------------
+class LineBuffer
+{
+public:
+   static const std::size_t BUFFER_SIZE = 64 * 1024;    // Buffer capacity
+
+public:
+   LineBuffer() = default;
+   LineBuffer(const LineBuffer&) = delete;
+   LineBuffer& operator=(const LineBuffer&) = delete;
+
+   // Output stream (default, nullptr: the standard output)
+   std::ostream* getOutput() const                    { return output; }
+   void setOutput(std::ostream* const x)              { output = x; }
+
+   const char* data() const                           { return buff; }
+   std::size_t length() const                         { return len; }
+   bool isEmpty() const                               { return (len == 0); }
+
+   // Write the buffered text to the output stream, and flush the stream
+   void flush();
+
+   // Discard the buffered text
+   void clear()                                       { len = 0; }
+
+   void append(const char* const s, const std::size_t n);
+
+   LineBuffer& operator<<(const char* const s);
+   LineBuffer& operator<<(const std::string& s)       { append(s.data(), s.length()); return *this; }
+   LineBuffer& operator<<(const char c);
+   LineBuffer& operator<<(const bool v)               { return (*this << (v ? '1' : '0')); }
+   LineBuffer& operator<<(const int v)                { return (*this << static_cast<long long>(v)); }
+   LineBuffer& operator<<(const unsigned int v)       { return (*this << static_cast<unsigned long long>(v)); }
+   LineBuffer& operator<<(const long v)               { return (*this << static_cast<long long>(v)); }
+   LineBuffer& operator<<(const unsigned long v)      { return (*this << static_cast<unsigned long long>(v)); }
+   LineBuffer& operator<<(const long long v);
+   LineBuffer& operator<<(const unsigned long long v);
+   LineBuffer& operator<<(const float v)              { return (*this << static_cast<double>(v)); }
+   LineBuffer& operator<<(const double v);
+
+private:
+   static const std::size_t NUMBER_SIZE = 32;          // Room for any formatted number
+
+   char* reserve(const std::size_t n);                 // Room for 'n' more characters
+
+   std::ostream* output {};                            // Output stream
+   std::size_t len {};                                 // Length of the buffered text
+   char buff[BUFFER_SIZE] {};
+};
+
+}
+}
+
+#endif
@@ -4,8 +4,13 @@
 
 #include "mixr/recorder/InputHandler.hpp"
 
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+
 namespace mixr {
-namespace base { class Boolean; class NetHandler; class Number; }
+namespace base { class Boolean; class Integer; class NetHandler; class Number; }
 namespace recorder {
 
 //------------------------------------------------------------------------------
@@ -14,15 +19,37 @@ namespace recorder {
 //
 // Factory name: NetInput
 // Slots:
-//      netHandler  <NetHandler>    Network input handler
-//      noWait      <Number>        No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//      netHandler     <NetHandler>    Network input handler
+//      noWait         <Number>        No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//      reorderWindow  <Integer>       Max number of out of order frames held for reordering
+//                                     (default: 0 -- frames are used in the order received)
+//      reorderTimeout <Number>        Max time a frame is held for reordering (seconds) (default: 0.2)
+//
+// Notes:
+//    1) Reads the frames sent by NetOutput (see frame_utils.hpp), and the
+//       records are returned one at a time by readRecord().  Datagrams that
+//       are not frames are parsed as a single data record (legacy senders).
+//
+//    2) The frame sequence numbers are checked: lost (gaps), duplicate and
+//       reordered frames are counted and reported as warnings.  Duplicate
+//       frames are dropped.  A new stream id restarts the sequence checks.
+//
+//    3) With a 'reorderWindow' of N frames, frames that arrive ahead of a
+//       gap are held until the missing frames arrive, until more than N
+//       frames are held, or until the oldest held frame has waited for
+//       'reorderTimeout' seconds; the gap is then skipped (frames lost).
+//       Frames that arrive after their gap was skipped are dropped (they're
+//       counted as dropped, and they stay counted as lost), so the records
+//       are always in sequence.  With a zero window, frames are used as
+//       received.
 //------------------------------------------------------------------------------
 class NetInput : public InputHandler
 {
     DECLARE_SUBCLASS(NetInput, InputHandler)
 
 public:
-   static const unsigned int MAX_INPUT_BUFFER_SIZE = 2000;
+   static const unsigned int MAX_INPUT_BUFFER_SIZE = 65536;
+   static const unsigned int MAX_REORDER_WINDOW = 1024;
 
 public:
    NetInput();
@@ -32,6 +59,17 @@ public:
    virtual bool initNetworks();
    virtual void closeConnections();
 
+   // Stream statistics
+   std::uint32_t getStreamId() const                  { return streamId; }
+   unsigned int getNumFramesReceived() const          { return numFrames; }
+   unsigned int getNumFramesLost() const              { return numLost; }
+   unsigned int getNumDuplicateFrames() const         { return numDuplicates; }
+   unsigned int getNumReorderedFrames() const         { return numReordered; }
+   unsigned int getNumDroppedFrames() const           { return numDropped; }
+
+   virtual bool setReorderWindow(const unsigned int);
+   virtual bool setReorderTimeout(const double);
+
 protected:
 
    const DataRecordHandle* readRecordImp() override;
@@ -39,6 +77,16 @@ protected:
 private:
    void initData();
 
+   void receiveFrame(const char* const buff, const unsigned int n);
+   void resetStream(const std::uint32_t id, const std::uint32_t seq);
+   void acceptFrame(const std::int64_t seq, const char* const payload, const std::size_t n);
+   void skipGap();
+
+   struct HeldFrame {
+      std::string payload;             // Frame payload
+      double time {};                  // Time received (computer time)
+   };
+
     base::safe_ptr<mixr::base::NetHandler> netHandler;   // Network handler (input/output, or just output if netInput is defined)
     bool networkInitialized {};        // Network has been initialized
     bool networkInitFailed {};         // Network initialization has failed
@@ -47,10 +95,31 @@ private:
 
    char* ibuf {};    // Input buffer
 
+   // Frame stream
+   unsigned int reorderWindow {};      // Max number of held out of order frames
+   double reorderTimeout {0.2};        // Max time a frame is held (seconds)
+   bool streamStarted {};              // Have we received a frame?
+   std::uint32_t streamId {};          // Current stream id
+   std::int64_t firstSeq {};           // First frame sequence number of the stream (extended)
+   std::int64_t nextSeq {};            // Next expected frame sequence number (extended)
+   std::uint64_t history {};           // Received flags of the 64 frames before 'nextSeq' (bit 0 is nextSeq-1)
+   std::map<std::int64_t, HeldFrame> heldFrames;     // Out of order frames waiting for a gap to fill
+   std::deque<std::string> frames;     // Payloads of the frames ready to be read
+   std::string payload;                // Payload of the frame being read
+   std::size_t payloadPos {};          // Position of the next record in 'payload'
+
+   unsigned int numFrames {};          // Number of frames received
+   unsigned int numLost {};            // Number of frames lost
+   unsigned int numDuplicates {};      // Number of duplicate frames
+   unsigned int numReordered {};       // Number of frames received out of order (and used)
+   unsigned int numDropped {};         // Number of late frames dropped (after their gap was skipped)
+
 private:
    // slot table helper methods
    bool setSlotNetwork(base::NetHandler* const);
    bool setSlotNoWait(base::Boolean* const);
+   bool setSlotReorderWindow(const base::Integer* const);
+   bool setSlotReorderTimeout(const base::Number* const);
 };
 
 }
@@ -3,24 +3,51 @@
 #define __mixr_recorder_NetOutput_HPP__
 
 #include "mixr/recorder/OutputHandler.hpp"
+#include "mixr/recorder/block_utils.hpp"
+
+#include <cstdint>
+#include <string>
 
 namespace mixr {
-namespace base { class Boolean; class NetHandler; class Number; }
+namespace base { class Boolean; class Integer; class NetHandler; class Number; }
 namespace recorder {
 
 //------------------------------------------------------------------------------
 // Class: NetOutput
-// Description: Serialize and write a DataRecord to a network
+// Description: Serialize and write DataRecords to a network
 //
 // Factory name: NetOutput
 // Slots:
-//      netHandler  <NetHandler>   ! Network output handler
-//      noWait      <Boolean>      ! No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//      netHandler     <NetHandler>   ! Network output handler
+//      noWait         <Boolean>      ! No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//      framing        <Boolean>      ! Pack the records into frames (default: false -- one record per datagram)
+//      maxFrameSize   <Integer>      ! Max frame (datagram) size in bytes (default: 1400)
+//      maxFrameDelay  <Number>       ! Max time a record is held in a frame (seconds) (default: 0.1)
+//      streamId       <Integer>      ! Stream identifier (default: 0 -- generated when the network is initialized)
+//
+// Notes:
+//    1) By default, each record is sent as one datagram (the legacy format,
+//       which all NetInput versions and other receivers read).  With
+//       'framing' set, the records are packed into frames (see frame_utils.hpp),
+//       which carry the stream id, a frame sequence number and the records'
+//       time span, and each frame is sent as one datagram; NetInput reads
+//       both formats.
+//
+//    2) A frame is sent when the next record would not fit within the
+//       'maxFrameSize', when its records span 'maxFrameDelay' seconds of
+//       sim time, when 'maxFrameDelay' seconds of wall clock time have passed
+//       since its first record (checked by updateOutput(), so a lone record
+//       isn't held), with the end of data (REID_END_OF_DATA) message, and by
+//       flushFrame(), closeConnections() and at shutdown.  A record that's
+//       larger than the 'maxFrameSize' is sent in a frame of its own.
 //------------------------------------------------------------------------------
 class NetOutput : public OutputHandler
 {
     DECLARE_SUBCLASS(NetOutput, OutputHandler)
 
+public:
+   static const unsigned int DEFAULT_FRAME_SIZE = 1400;     // Fits within a typical ethernet MTU
+
 public:
    NetOutput();
 
@@ -28,8 +55,22 @@ public:
    virtual bool initNetworks();              // Init the network
    virtual void closeConnections();          // close the network connection
 
+   void flushFrame();                        // Send the pending frame
+
+   bool isFraming() const                          { return framing; }
+   std::uint32_t getStreamId() const               { return streamId; }
+   std::uint32_t getNumFramesSent() const          { return sequence; }
+
+   virtual bool setFraming(const bool);
+   virtual bool setMaxFrameSize(const unsigned int);
+   virtual bool setMaxFrameDelay(const double);
+   virtual bool setStreamId(const std::uint32_t);
+
 protected:
    void processRecordImp(const DataRecordHandle* const handle) override;
+   void updateOutputImp() override;
+
+   bool shutdownNotification() override;
 
 private:
     base::safe_ptr<base::NetHandler> netHandler; // Network handler (input/output, or just output if netInput is defined)
@@ -37,10 +78,26 @@ private:
     bool networkInitFailed {};     // Network initialization has failed
     bool noWaitFlag {};            // No wait (unblocked) I/O flag
 
+    bool framing {};               // Pack the records into frames
+    unsigned int maxFrameSize {DEFAULT_FRAME_SIZE};   // Max frame size (bytes)
+    double maxFrameDelay {0.1};    // Max time a record is held in a frame (seconds)
+    std::uint32_t streamId {};     // Stream identifier
+    bool streamIdSet {};           // Stream identifier was set by the user
+    std::uint32_t sequence {};     // Next frame sequence number
+
+    RecordBlock frame;             // Records waiting to be sent
+    double frameWallTime {};       // Computer time of the frame's first record (seconds)
+    std::string wireFormat;        // Serialized record
+    std::string frameBuff;         // Encoded frame
+
 private:
    // slot table helper methods
    bool setSlotNetwork(base::NetHandler* const);
    bool setSlotNoWait(base::Boolean* const);
+   bool setSlotFraming(const base::Boolean* const);
+   bool setSlotMaxFrameSize(const base::Integer* const);
+   bool setSlotMaxFrameDelay(const base::Number* const);
+   bool setSlotStreamId(const base::Integer* const);
 };
 
 }
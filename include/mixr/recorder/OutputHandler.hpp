@@ -27,6 +27,16 @@ class DataRecordHandle;
 //    of subcomponent OutputHandlers.  The prcessRecord() function for each
 //    subcomponent OutputHandler is called from our processRecord() function.
 //
+//    4) updateOutput() is called by processQueue(), after the queued records,
+//    and, like processRecord(), calls updateOutputImp() and passes the call
+//    to the subcomponent OutputHandlers; handlers that hold their output
+//    (e.g., NetOutput's frames) send it by wall clock time, even if no more
+//    records arrive.
+//
+//    5) getAcceptedIds() returns the set of recorder event IDs accepted by
+//    this OutputHandler and its subcomponents, which is used by the
+//    DataRecorder to skip the records that no OutputHandler would process.
+//
 // Factory name: OutputHandler
 //
 // Overriding the Component class slot:
@@ -49,10 +59,23 @@ public:
    // Process all data records from the queue
    void processQueue();
 
+   // Send any held output that's due
+   void updateOutput();
+
+   // Adds the IDs accepted by this handler and its subcomponents to 'ids'
+   void getAcceptedIds(RecorderIdSet* const ids) const;
+
 protected:
    // Process record implementations by derived classes
    virtual void processRecordImp(const DataRecordHandle* const);
 
+   // Update output implementations by derived classes (default: none)
+   virtual void updateOutputImp();
+
+   // Does our processRecordImp() process the records?  (default: true
+   // for derived classes; false for a plain OutputHandler container)
+   virtual bool isRecordConsumer() const;
+
    // Checks the data enabled list and returns true if the record should be processed.
    bool isDataTypeEnabled(const DataRecordHandle* const handle) const;
 
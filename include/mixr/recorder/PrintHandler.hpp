@@ -3,6 +3,7 @@
 #define __mixr_recorder_PrintHandler_HPP__
 
 #include "mixr/recorder/OutputHandler.hpp"
+#include "mixr/recorder/LineBuffer.hpp"
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -20,6 +21,12 @@ namespace recorder {
 //       a) the file is created and the output is written to that file
 //       b) if the file already exists, a new file is still created
 //          with a version number appended to the file name.
+//    3) Lines are formatted into a fixed-capacity output buffer (see
+//       beginLine(), endLine() and LineBuffer), which is written in blocks
+//       of LineBuffer::BUFFER_SIZE characters; the output is also flushed
+//       by flushOutput(), closeFile() and at shutdown.  When the output is
+//       a console (terminal), each record's lines are written at the end of
+//       the record (see endRecord()).
 //
 // Factory name: PrintHandler
 // Slots:
@@ -36,6 +43,14 @@ public:
    // Print to the output stream
    void printToOutput(const char* const msg);
 
+   // Format a line: beginLine() returns the output buffer to format the
+   // line into, and endLine() ends the line
+   LineBuffer& beginLine();
+   void endLine();
+
+   void endRecord();                      // End of a record's lines (see note 3)
+   void flushOutput();                    // Write the buffered output
+
    bool isOpen() const;                   // Is the data file open?
    bool isFailed() const;                 // Did we have an open or write error?
    bool isFileEmpty() const;              // Has the file been written to yet?
@@ -58,7 +73,13 @@ protected:
 
    void processRecordImp(const DataRecordHandle* const handle) override;
 
+   bool shutdownNotification() override;
+
 private:
+   bool isConsole() const;            // Is the output a console?
+
+   LineBuffer outBuff;                // Output buffer
+
    // from FileWriter.hpp:
    std::ofstream* sout {};            // output file stream (pointer)
    char* fullFilename {};             // Full file name of the output file
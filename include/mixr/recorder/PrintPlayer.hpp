@@ -7,13 +7,15 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <utility>
+#include <vector>
 
 namespace mixr {
 namespace recorder {
 namespace pb {
 class Time; class FileIdMsg; class NewPlayerEventMsg; class PlayerRemovedEventMsg; class PlayerDataMsg;
 class PlayerDamagedEventMsg; class PlayerCollisionEventMsg; class PlayerCrashEventMsg;
-class PlayerKilledEventMsg; class WeaponReleaseEventMsg; class WeaponHungEventMsg;
+class PlayerKilledEventMsg; class PlayerFrameMsg; class WeaponReleaseEventMsg; class WeaponHungEventMsg;
 class WeaponDetonationEventMsg; class GunFiredEventMsg; class NewTrackEventMsg;
 class TrackRemovedEventMsg; class TrackDataMsg; class PlayerId; class PlayerState;
 class TrackData; class EmissionData;
@@ -26,6 +28,11 @@ class TrackData; class EmissionData;
 // Factory name: PrintPlayer
 // Slots:
 //   playerName  <base::String>  ! Player name
+//
+// Note:
+//    The player frame snapshot records (REID_PLAYER_FRAME) don't contain the
+//    player names, so when 'playerName' is set, the player's ID is learned from
+//    the other player records (e.g., REID_NEW_PLAYER) that contain its name.
 //------------------------------------------------------------------------------
 class PrintPlayer : public PrintHandler
 {
@@ -41,8 +48,13 @@ protected:
 
    void processRecordImp(const DataRecordHandle* const handle) override;
 
+   virtual void printPlayerFrame(const pb::PlayerFrameMsg* const msg);
+
 private:
+   bool isNamedPlayer(const unsigned int id, const std::string& fedName) const;
+
    const base::String* name {};    // Player name
+   std::vector<std::pair<unsigned int, std::string>> namedIds;   // IDs (id, federate name) of the named player
 
 private:
    // slot table helper methods
@@ -8,6 +8,7 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/message.h"
@@ -37,6 +38,12 @@ class TrackData; class EmissionData;
 //   compareToValD   <base::Number>   ! value to compare (dbl)
 //   condition       <base::String>   ! EQ, LT, or GT (ignored for bool and strings)
 //   timeOnly        <base::Boolean>  ! match time conditions only. Print ALL messages that match
+//
+// Notes:
+//    1) The selection criteria are compiled, by reset() or by the first
+//    record processed after the criteria have changed, into the descriptor
+//    paths, from the time message and the selected event message, to each
+//    field named 'fieldName'.  Only those fields are compared for each record.
 //------------------------------------------------------------------------------
 class PrintSelected : public PrintHandler
 {
@@ -63,13 +70,12 @@ public:
    bool setCompareCondition(const Condition);
    bool setTimeOnly(const bool);
 
+   void reset() override;
+
 protected:
 
    void processRecordImp(const DataRecordHandle* const handle) override;
 
-   // Recursive function to look at each embedded message
-   void processMessage(const google::protobuf::Message* const);
-
    // Recursive function to print all messages within a top-level message
    void printMessage(std::ostream& soutFields, std::ostream& soutVals, const google::protobuf::Message* const msg);
 
@@ -79,6 +85,24 @@ protected:
    std::string printTimeMsg(double time);
 
 private:
+   // Path of fields from a root message to a selected (non-message) field
+   typedef std::vector<const google::protobuf::FieldDescriptor*> FieldPath;
+
+   void compileSelection();
+   void findFieldPaths(const google::protobuf::Descriptor* const, FieldPath* const path, std::vector<FieldPath>* const paths) const;
+   bool isFieldSelected(const google::protobuf::Message& root, const FieldPath& path) const;
+   bool isValueSelected(const google::protobuf::Message& msg, const google::protobuf::FieldDescriptor* const field, const int index) const;
+   void printValue(std::ostream& sout, const google::protobuf::Message& msg, const google::protobuf::FieldDescriptor* const field, const int index) const;
+
+   // Compiled selection criteria
+   std::vector<FieldPath> timePaths;                           // Paths within the time message
+   std::vector<FieldPath> eventPaths;                          // Paths within the selected event message
+   const google::protobuf::FieldDescriptor* eventField {};    // Selected event message's data record field
+   std::string msgCat;                                         // Selected event message's category and type names
+   std::string msgType;
+   bool compiled {};                                           // Selection criteria have been compiled
+   bool firstRecord {true};                                    // First record processed
+
    unsigned int msgToken {};
    double compareValD {};
    int compareValI {};
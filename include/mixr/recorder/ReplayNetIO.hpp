@@ -0,0 +1,184 @@
+
+#ifndef __mixr_recorder_ReplayNetIO_HPP__
+#define __mixr_recorder_ReplayNetIO_HPP__
+
+#include "mixr/simulation/AbstractNetIO.hpp"
+#include "mixr/base/safe_ptr.hpp"
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace mixr {
+namespace base { class Boolean; class Identifier; class Integer; class Number; class PairStream; class Time; }
+namespace models { class Player; }
+namespace simulation { class Simulation; class Station; }
+namespace recorder {
+namespace pb { class DataRecord; class PlayerId; class PlayerState; }
+class InputHandler;
+class ReplayNib;
+
+//------------------------------------------------------------------------------
+// Class: ReplayNetIO
+// Description: Replays the players of recorded data into a running simulation.
+//
+//    A replay player (a proxy player with a ReplayNib) is created for each
+//    recorded player, and it's driven by the player's interpolated recorded
+//    kinematics.  The replay players are on the simulation's player list
+//    like any other networked player, so sensors, displays and the
+//    interoperability networks (see their 'relay' slot) see them as well.
+//
+//    The ReplayNetIO is added to the Station's list of 'networks', and its
+//    inputFrame() reads the data records as the replay time advances.
+//
+// Factory name: ReplayNetIO
+// Slots:
+//    inputHandler   <InputHandler>    ! Recorded data source (e.g., a FileReader) (required)
+//
+//    networkID      <Integer>         ! Network ID of the replay players [ 1 .. MAX_NETWORK_ID ]
+//                                     ! (default: 2)
+//
+//    federateName   <Identifier>      ! Federate name of the replayed local players; the
+//                                     ! replayed networked players keep their recorded
+//                                     ! federate names (default: replay)
+//
+//    templates      <PairStream>      ! Replay player templates (models::Player); a recorded
+//                                     ! player uses the template named by its recorded type
+//                                     ! (e.g., "F-16C"), or the first template of its major
+//                                     ! type, or a generic player (default: none)
+//
+//    rate           <Number>          ! Playback rate; a multiple of real time (default: 1)
+//
+//    paused         <Boolean>         ! Start paused (default: false)
+//
+//    startTime      <Time>            ! Initial replay time; recorded sim time
+//                                     ! (default: time of the first data record)
+//
+//    lookahead      <Time>            ! The data records are read up to this far past the
+//                                     ! replay time, so that the samples can be interpolated
+//                                     ! (default: 2 seconds)
+//
+// Replay time:
+//
+//    The replay time is the recorded sim time being replayed; it's advanced
+//    by the network frame's delta time times the playback rate, unless
+//    paused.  Use setRate(), setPaused() and seek() to control the replay;
+//    seek() is applied by the next inputFrame(), and seeking backwards
+//    rewinds the input handler (see InputHandler::rewind()) and replaces the
+//    replay players.
+//
+// Recorded kinematics:
+//
+//    The players' samples are taken from the new player, player data,
+//    player removed and player event records, the whole-frame player
+//    snapshot records (see Simulation's 'frameSnapshotTime' slot) and the
+//    weapon release records.  A replay player is created at the time of its
+//    first sample and removed at the time of its player removed record.
+//
+//    Players that are only known by their frame snapshots are named by
+//    their player ID (e.g., "P101").
+//------------------------------------------------------------------------------
+class ReplayNetIO : public simulation::AbstractNetIO
+{
+   DECLARE_SUBCLASS(ReplayNetIO, simulation::AbstractNetIO)
+
+public:
+   ReplayNetIO();
+
+   double getReplayTime() const;          // Recorded sim time being replayed (seconds)
+   double getRate() const;                // Playback rate
+   bool isPaused() const;                 // Is the replay paused?
+   unsigned int getNumReplayPlayers() const;
+   const std::string& getFederateName() const;
+
+   simulation::Station* getStation()                      { return station; }
+   const simulation::Station* getStation() const          { return station; }
+   simulation::Simulation* getSimulation()                { return simulation; }
+   const simulation::Simulation* getSimulation() const    { return simulation; }
+
+   InputHandler* getInputHandler()                        { return inputHandler; }
+   const InputHandler* getInputHandler() const            { return inputHandler; }
+
+   virtual bool setInputHandler(InputHandler* const);
+   virtual bool setNetworkID(const unsigned short);
+   virtual bool setFederateName(const std::string&);
+   virtual bool setTemplates(base::PairStream* const);
+   virtual bool setRate(const double);
+   virtual bool setPaused(const bool);
+   virtual bool setStartTime(const double);
+   virtual bool setLookahead(const double);
+
+   // Seek to a recorded sim time (seconds)
+   virtual bool seek(const double time);
+
+   // simulation::AbstractNetIO interface
+   void inputFrame(const double dt) override;
+   void outputFrame(const double dt) override;
+   unsigned short getNetworkID() const override;
+
+   void reset() override;
+
+protected:
+   // Process one data record
+   virtual void processRecord(const pb::DataRecord* const);
+
+   // Find or create the replay nib of a recorded player
+   ReplayNib* findNib(const unsigned short id, const std::string& fedName, const bool create = true);
+
+   // Add a sample to a recorded player
+   virtual ReplayNib* addSample(const double time, const pb::PlayerId&, const pb::PlayerState* const);
+
+   // Create and remove the replay players
+   virtual models::Player* createReplayPlayer(ReplayNib* const);
+   virtual void removeReplayPlayer(ReplayNib* const);
+
+   bool shutdownNotification() override;
+
+private:
+   bool initReplay();                     // Find our Station and Simulation
+   void readRecords();                    // Read up to the replay time plus the lookahead
+   void updateNibs();                     // Create, remove and update the replay players
+   bool rewind(const double time);        // Restart the replay at 'time'
+   void clearNibs();                      // Remove all replay players and nibs
+
+   using NibKey = std::pair<unsigned short, std::string>;
+
+   base::safe_ptr<InputHandler> inputHandler;      // Recorded data source
+   base::safe_ptr<base::PairStream> templates;     // Replay player templates
+   simulation::Station* station {};                // Our Station
+   simulation::Simulation* simulation {};          // Our Simulation
+
+   std::map<NibKey, ReplayNib*> nibs;              // Replay nibs (ref()'d)
+
+   unsigned short netID {2};             // Network ID
+   std::string federateName {"replay"};  // Federate name of the replayed local players
+   double rate {1.0};                    // Playback rate
+   bool paused {};                       // Replay paused
+   double startTime {-1.0};              // Initial replay time; or negative for the first record's time
+   double lookahead {2.0};               // Read ahead time (seconds)
+
+   double replayTime {};                 // Current replay time (seconds)
+   bool timeValid {};                    // Replay time has been set
+   double readTime {};                   // Time of the last data record read (seconds)
+   bool initFailed {};                   // Initialization failed
+
+   double seekTime {};                   // Requested seek time
+   bool seekPending {};                  // A seek has been requested
+   mutable long semaphore {};
+
+private:
+   // slot table helper methods
+   bool setSlotInputHandler(InputHandler* const x)            { return setInputHandler(x); }
+   bool setSlotNetworkID(const base::Integer* const);
+   bool setSlotFederateName(const base::Identifier* const);
+   bool setSlotTemplates(base::PairStream* const x)           { return setTemplates(x); }
+   bool setSlotRate(const base::Number* const);
+   bool setSlotPaused(const base::Boolean* const);
+   bool setSlotStartTime(const base::Time* const);
+   bool setSlotLookahead(const base::Time* const);
+};
+
+}
+}
+
+#endif
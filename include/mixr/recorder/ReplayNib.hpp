@@ -0,0 +1,117 @@
+
+#ifndef __mixr_recorder_ReplayNib_HPP__
+#define __mixr_recorder_ReplayNib_HPP__
+
+#include "mixr/simulation/AbstractNib.hpp"
+#include "mixr/base/safe_ptr.hpp"
+#include "mixr/base/osg/Vec3d"
+
+#include <deque>
+#include <string>
+
+namespace mixr {
+namespace models { class Player; }
+namespace simulation { class AbstractNetIO; }
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Class: ReplayNib
+// Description: Network Interface Block (Nib) of a replay player; holds the
+//              recorded kinematic samples of one recorded player and drives
+//              the replay (proxy) player by interpolating them.
+//
+// Factory name: ReplayNib
+//
+// Notes:
+//    1) The samples are added by the ReplayNetIO as the data records are read,
+//       and the samples older than the current replay time are dropped by
+//       setReplayTime().
+//
+//    2) updateDeadReckoning() advances the nib's replay time by the player's
+//       delta time scaled by the playback rate, and interpolates the samples
+//       that bracket that time: cubic (Hermite) interpolation of the position
+//       when both samples have a velocity, otherwise linear interpolation, and
+//       linear interpolation of the Euler angles.  Past the last sample, the
+//       position is extrapolated using its velocity.
+//------------------------------------------------------------------------------
+class ReplayNib : public simulation::AbstractNib
+{
+   DECLARE_SUBCLASS(ReplayNib, simulation::AbstractNib)
+
+public:
+   // Recorded kinematic sample
+   struct Sample
+   {
+      double time {};               // Recorded sim time (seconds)
+      base::Vec3d pos;              // Position ECEF (meters)
+      base::Vec3d vel;              // Velocity vector ECEF (meters/second)
+      base::Vec3d angles;           // Euler angles (body/ECEF) (radians)
+      bool velValid {};             // Velocity is valid
+   };
+
+public:
+   ReplayNib();
+
+   models::Player* getPlayer();                         // Our replay player (if any)
+   const std::string& getPlayerName() const;            // Recorded player name
+   const std::string& getPlayerType() const;            // Recorded player type (e.g., "F-16C"); empty if unknown
+   unsigned int getSide() const;                        // Recorded side; zero if unknown
+   unsigned int getMajorType() const;                   // Recorded major type; zero if unknown
+
+   double getFirstTime() const;                         // Time of the first sample; negative if none
+   bool isRemoved(const double time) const;             // Was the player removed at or before 'time'?
+
+   // Replay interface (ReplayNetIO)
+   virtual bool setNetIO(simulation::AbstractNetIO* const);
+   virtual bool setPlayer(models::Player* const);
+   virtual void setPlayerIds(const unsigned short id, const std::string& fedName, const std::string& name);
+   virtual void setPlayerType(const std::string& type, const unsigned int side, const unsigned int majorType);
+   virtual void addSample(const Sample&);
+   virtual void setRemovedTime(const double time);
+   virtual void setReplayTime(const double time, const double rate);
+
+   // simulation::AbstractNib interface
+   const std::string& getFederateName() const override;
+   unsigned short getPlayerID() const override;
+   simulation::AbstractNetIO* getNetIO() override;
+   bool updateDeadReckoning(
+      const double dt,
+      base::Vec3d* const pNewPos,
+      base::Vec3d* const pNewAngles
+   ) override;
+   const base::Vec3d& getDrVelocity() const override;
+   const base::Vec3d& getDrAcceleration() const override;
+   const base::Vec3d& getDrAngularVelocities() const override;
+
+private:
+   void interpolate(const double time);
+
+   base::safe_ptr<simulation::AbstractNetIO> netIO;   // Our ReplayNetIO
+   base::safe_ptr<models::Player> player;              // Our replay player
+
+   unsigned short playerID {};       // Recorded player ID
+   std::string federateName;         // Recorded federate name
+   std::string playerName;           // Recorded player name
+   std::string playerType;           // Recorded player type
+   unsigned int side {};             // Recorded side
+   unsigned int majorType {};        // Recorded major type
+
+   std::deque<Sample> samples;       // Samples from the last one at or before the replay time
+   double firstTime {-1.0};          // Time of the first sample
+   double removedTime {-1.0};        // Time that the player was removed; negative if not removed
+   double replayTime {};             // Current replay time (seconds)
+   double rate {};                   // Playback rate (zero while paused)
+
+   base::Vec3d drPos;                // Interpolated position
+   base::Vec3d drVel;                // Interpolated velocity
+   base::Vec3d drAngles;             // Interpolated Euler angles
+   base::Vec3d drAngularVel;         // Angular rates
+   base::Vec3d drAccel;              // Acceleration (always zero)
+
+   mutable long semaphore {};
+};
+
+}
+}
+
+#endif
@@ -14,7 +14,7 @@ namespace recorder {
 namespace pb {
 class Time; class FileIdMsg; class NewPlayerEventMsg; class PlayerRemovedEventMsg; class PlayerDataMsg;
 class PlayerDamagedEventMsg; class PlayerCollisionEventMsg; class PlayerCrashEventMsg;
-class PlayerKilledEventMsg; class WeaponReleaseEventMsg; class WeaponHungEventMsg;
+class PlayerKilledEventMsg; class PlayerFrameMsg; class WeaponReleaseEventMsg; class WeaponHungEventMsg;
 class WeaponDetonationEventMsg; class GunFiredEventMsg; class NewTrackEventMsg;
 class TrackRemovedEventMsg; class TrackDataMsg; class PlayerId; class PlayerState;
 class TrackData; class EmissionData; class MarkerMsg; class InputDeviceMsg;
@@ -53,6 +53,7 @@ protected:
    virtual void printPlayerCollisionEventMsg(const pb::Time* const, const pb::PlayerCollisionEventMsg* const);
    virtual void printPlayerCrashEventMsg(const pb::Time* const, const pb::PlayerCrashEventMsg* const);
    virtual void printPlayerKilledEventMsg(const pb::Time* const, const pb::PlayerKilledEventMsg* const);
+   virtual void printPlayerFrameMsg(const pb::Time* const, const pb::PlayerFrameMsg* const);
    virtual void printWeaponReleaseEventMsg(const pb::Time* const, const pb::WeaponReleaseEventMsg* const);
    virtual void printWeaponHungEventMsg(const pb::Time* const, const pb::WeaponHungEventMsg* const);
    virtual void printWeaponDetonationEventMsg(const pb::Time* const, const pb::WeaponDetonationEventMsg* const);
@@ -69,29 +70,29 @@ protected:
    virtual void printResetEvent(const pb::Time* const);
 
    // Common Data Messages
-   virtual void printTimeMsg(std::ostream& sout, const pb::Time* const);
-   virtual void printPlayerIdMsg(std::ostream& sout, const pb::PlayerId* const);
-   virtual void printPlayerStateMsg(std::ostream& sout, const pb::PlayerState* const);
-   virtual void printCommonTrackDataMsg(std::ostream& sout, const pb::TrackData* const);
-   virtual void printEmissionDataMsg(std::ostream& sout, const pb::EmissionData* const);
+   virtual void printTimeMsg(LineBuffer& sout, const pb::Time* const);
+   virtual void printPlayerIdMsg(LineBuffer& sout, const pb::PlayerId* const);
+   virtual void printPlayerStateMsg(LineBuffer& sout, const pb::PlayerState* const);
+   virtual void printCommonTrackDataMsg(LineBuffer& sout, const pb::TrackData* const);
+   virtual void printEmissionDataMsg(LineBuffer& sout, const pb::EmissionData* const);
 
    // Message Field Header functions
-   virtual void printTimeMsgHdr(std::ostream&);
-   virtual void printPlayerIdMsgHdr(std::ostream&);
-   virtual void printPlayerStateMsgHdr(std::ostream&);
-   virtual void printTrackDataHdr(std::ostream&);
-   virtual void printEmissionDataMsgHdr(std::ostream&);
-   virtual void printWeaponMsgHdr(std::ostream&);
-   virtual void printTrackMsgHdr(std::ostream&);
-
-   virtual void printEmissionDataSpacer(std::ostream&);
-   virtual void printPlayerIdSpacer(std::ostream&);
-   virtual void printPlayerDataSpacer(std::ostream&);
-   virtual void printTrackDataSpacer(std::ostream&);
-
-   void printExecTimeMsg(std::ostream& sout, double execTime);
-   void printSimTimeMsg(std::ostream& sout, double simTime);
-   void printUtcTimeMsg(std::ostream& sout, double utcTime);
+   virtual void printTimeMsgHdr(LineBuffer&);
+   virtual void printPlayerIdMsgHdr(LineBuffer&);
+   virtual void printPlayerStateMsgHdr(LineBuffer&);
+   virtual void printTrackDataHdr(LineBuffer&);
+   virtual void printEmissionDataMsgHdr(LineBuffer&);
+   virtual void printWeaponMsgHdr(LineBuffer&);
+   virtual void printTrackMsgHdr(LineBuffer&);
+
+   virtual void printEmissionDataSpacer(LineBuffer&);
+   virtual void printPlayerIdSpacer(LineBuffer&);
+   virtual void printPlayerDataSpacer(LineBuffer&);
+   virtual void printTrackDataSpacer(LineBuffer&);
+
+   void printExecTimeMsg(LineBuffer& sout, double execTime);
+   void printSimTimeMsg(LineBuffer& sout, double simTime);
+   void printUtcTimeMsg(LineBuffer& sout, double utcTime);
 
    void processRecordImp(const DataRecordHandle* const) override;
 
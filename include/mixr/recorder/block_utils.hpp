@@ -0,0 +1,153 @@
+
+#ifndef __mixr_recorder_block_utils_HPP__
+#define __mixr_recorder_block_utils_HPP__
+
+//------------------------------------------------------------------------------
+// Block-compressed data recorder file format
+//
+// The file starts with an 8 byte file header (BLOCK_FILE_MAGIC) followed by a
+// sequence of independently compressed blocks.  Each block is a fixed size
+// block header followed by its compressed payload:
+//
+//    sync marker    4 bytes  ! BLOCK_SYNC_MARKER
+//    numRecords     4 bytes  ! Number of data records in the block
+//    rawSize        4 bytes  ! Uncompressed payload size (bytes)
+//    dataSize       4 bytes  ! Compressed payload size (bytes)
+//    checksum       4 bytes  ! CRC-32 of the compressed payload
+//    startTime      8 bytes  ! Sim time of the first data record (seconds)
+//    endTime        8 bytes  ! Sim time of the last data record (seconds)
+//    headerCrc      4 bytes  ! CRC-32 of the previous 36 header bytes
+//
+// The uncompressed payload is the sequence of serialized DataRecords, each
+// preceded by its size in bytes.  All integers are little endian.
+//
+// Legacy files (no file header) start with a 4 character ascii record size,
+// so the two formats can be told apart by the first bytes of the file.
+//
+// Every block starts with the sync marker and carries the checksums of its
+// header and payload, so a reader can detect a damaged block (e.g., a block
+// truncated when the writer was killed) and resynchronize by scanning for the
+// sync marker of the next valid block (see readNextBlock()).
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+
+namespace mixr {
+namespace recorder {
+
+const unsigned int BLOCK_FILE_HEADER_SIZE{8};
+const char BLOCK_FILE_MAGIC[BLOCK_FILE_HEADER_SIZE + 1]{"MXRBLK01"};
+const std::uint32_t BLOCK_SYNC_MARKER{0x4b42584d};       // "MXBK"
+const unsigned int BLOCK_HEADER_SIZE{40};
+const unsigned int BLOCK_MAX_RAW_SIZE{16 * 1024 * 1024}; // Max uncompressed block size (bytes)
+
+//------------------------------------------------------------------------------
+// Block header
+//------------------------------------------------------------------------------
+struct BlockHeader
+{
+   std::uint32_t numRecords{};   // Number of data records
+   std::uint32_t rawSize{};      // Uncompressed payload size (bytes)
+   std::uint32_t dataSize{};     // Compressed payload size (bytes)
+   std::uint32_t checksum{};     // CRC-32 of the compressed payload
+   double startTime{};           // Sim time of the first data record (seconds)
+   double endTime{};             // Sim time of the last data record (seconds)
+};
+
+//------------------------------------------------------------------------------
+// Status of a block read by readNextBlock()
+//------------------------------------------------------------------------------
+enum class BlockStatus
+{
+   VALID,            // A valid block was read
+   END_OF_FILE,      // No more blocks
+   CORRUPTED         // Invalid or incomplete block (not resynchronizing)
+};
+
+//------------------------------------------------------------------------------
+// Block of serialized data records waiting to be compressed and written
+//------------------------------------------------------------------------------
+struct RecordBlock
+{
+   std::string raw;              // Size prefixed, serialized data records
+   std::uint32_t numRecords{};   // Number of data records
+   double startTime{};           // Sim time of the first data record (seconds)
+   double endTime{};             // Sim time of the last data record (seconds)
+};
+
+// Returns true if 'buff' (at least BLOCK_FILE_HEADER_SIZE bytes) is the block file header
+bool isBlockFileHeader(const char* const buff);
+
+// Appends one serialized data record, with its size prefix, to the block
+void appendRecord(RecordBlock* const block, const std::string& wireFormat, const double simTime);
+
+// Compresses the block's records into 'data' and fills in the block header;
+// 'level' is the zlib compression level [ -1 (default) ... 9 ]
+bool compressBlock(const RecordBlock& block, const int level, BlockHeader* const hdr, std::string* const data);
+
+// Decompresses a block's payload into 'raw'; checks the payload checksum
+bool decompressBlock(const BlockHeader& hdr, const char* const data, std::string* const raw);
+
+// Gets the next serialized data record from an uncompressed payload, starting
+// at byte 'pos'; 'pos' is advanced past the record
+bool nextRecord(const std::string& raw, std::size_t* const pos, const char** const rec, std::uint32_t* const n);
+
+// Encodes/decodes a block header (BLOCK_HEADER_SIZE bytes); decode checks the
+// sync marker and the header's own checksum.
+void encodeBlockHeader(const BlockHeader& hdr, char* const buff);
+bool decodeBlockHeader(const char* const buff, BlockHeader* const hdr);
+
+// Reads the next block (header and compressed payload) from the stream, and
+// checks its header and payload checksums.  When 'resync' is true, damaged
+// data is skipped by scanning for the sync marker of the next valid block;
+// the number of bytes skipped is added to 'skipped'.
+BlockStatus readNextBlock(std::istream& sin, const bool resync, BlockHeader* const hdr, std::string* const data, std::uint64_t* const skipped);
+
+// Returns the offset of the first sync marker at or after 'pos', or -1 if
+// there isn't one.  The stream's read position is undefined afterwards.
+std::int64_t findSyncMarker(std::istream& sin, const std::int64_t pos);
+
+// CRC-32 checksum
+std::uint32_t checksum(const char* const data, const std::size_t n);
+
+// Little endian integer and double encoders/decoders
+inline void putU32(char* const p, const std::uint32_t v)
+{
+   p[0] = static_cast<char>(v & 0xff);
+   p[1] = static_cast<char>((v >> 8) & 0xff);
+   p[2] = static_cast<char>((v >> 16) & 0xff);
+   p[3] = static_cast<char>((v >> 24) & 0xff);
+}
+
+inline std::uint32_t getU32(const char* const p)
+{
+   const auto q = reinterpret_cast<const unsigned char*>(p);
+   return static_cast<std::uint32_t>(q[0]) |
+         (static_cast<std::uint32_t>(q[1]) << 8) |
+         (static_cast<std::uint32_t>(q[2]) << 16) |
+         (static_cast<std::uint32_t>(q[3]) << 24);
+}
+
+inline void putF64(char* const p, const double v)
+{
+   std::uint64_t u{};
+   std::memcpy(&u, &v, sizeof(u));
+   putU32(p, static_cast<std::uint32_t>(u & 0xffffffff));
+   putU32(p + 4, static_cast<std::uint32_t>(u >> 32));
+}
+
+inline double getF64(const char* const p)
+{
+   const std::uint64_t u{static_cast<std::uint64_t>(getU32(p)) | (static_cast<std::uint64_t>(getU32(p + 4)) << 32)};
+   double v{};
+   std::memcpy(&v, &u, sizeof(v));
+   return v;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,68 @@
+
+#ifndef __mixr_recorder_column_utils_HPP__
+#define __mixr_recorder_column_utils_HPP__
+
+//------------------------------------------------------------------------------
+// Columnar data recorder table format (see ColumnWriter and ColumnReader)
+//
+// Each table file holds one record type, stored as a sequence of row groups
+// followed by a footer:
+//
+//    row group:  COLUMN_GROUP_MARKER, number of rows, start and end time, the
+//                number of columns and the byte size of each column, followed
+//                by each column's data (an array of little endian doubles or
+//                32 bit unsigned integers)
+//
+//    footer:     table type, column definitions, player and track dictionaries,
+//                and the row group index (file offset, rows and time span)
+//
+//    trailer:    footer size (4 bytes) and COLUMN_FILE_MAGIC (8 bytes)
+//
+// Player and track identifiers are dictionary encoded: the columns hold an
+// index into the footer's dictionaries, or COLUMN_NO_ENTRY.
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+
+namespace mixr {
+namespace recorder {
+
+const unsigned int COLUMN_FILE_MAGIC_SIZE{8};
+const char COLUMN_FILE_MAGIC[COLUMN_FILE_MAGIC_SIZE + 1]{"MXRCOL01"};
+const std::uint32_t COLUMN_GROUP_MARKER{0x4752584d};     // "MXRG"
+const std::uint32_t COLUMN_NO_ENTRY{0xffffffff};         // Dictionary encoded 'none'
+
+// Tables
+enum class ColumnTable : unsigned int {
+   PLAYER_DATA = 1,     // REID_PLAYER_DATA
+   TRACK = 2,           // REID_NEW_TRACK, REID_TRACK_DATA and REID_TRACK_REMOVED
+   DETONATION = 3,      // REID_WEAPON_DETONATION
+   EMISSION = 4         // Emission data of the track records
+};
+const unsigned int NUM_COLUMN_TABLES{4};
+
+// Column data types
+enum class ColumnType : unsigned int {
+   F64 = 1,             // double
+   U32 = 2,             // unsigned 32 bit integer
+   PLAYER = 3,          // player dictionary index (U32)
+   TRACK = 4            // track dictionary index (U32)
+};
+
+// Column definition
+struct ColumnDef
+{
+   const char* name;
+   ColumnType type;
+};
+
+// Column definitions for a table; the first column of all tables is the sim time
+const ColumnDef* getColumnDefs(const ColumnTable table, unsigned int* const n);
+
+// Table name (e.g., "players"), which is also used as the table's file name suffix
+const char* getColumnTableName(const ColumnTable table);
+
+}
+}
+
+#endif
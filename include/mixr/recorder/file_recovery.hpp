@@ -0,0 +1,57 @@
+
+#ifndef __mixr_recorder_file_recovery_HPP__
+#define __mixr_recorder_file_recovery_HPP__
+
+//------------------------------------------------------------------------------
+// Data recorder file check and recovery
+//
+//    checkRecorderFile() validates a data file written by the FileWriter:
+//       -- block compressed files: each block's header and payload checksums,
+//          its decompressed size and its record framing are checked; damaged
+//          regions are skipped by resynchronizing at the next sync marker.
+//       -- legacy files: the size prefix and length of each record are checked
+//          (there are no checksums, so only truncation is detected).
+//
+//    recoverRecorderFile() checks the file and truncates it to the end of its
+//    last good block (or record); for example, to remove the partial block
+//    left by a writer that was killed.  Damaged regions before the last good
+//    block remain in the file and are skipped by the FileReader.
+//
+// Example:
+//    FileCheck check;
+//    if (recoverRecorderFile("run1.dat", &check)) {
+//       std::cout << check.numRecords << " records; truncated ";
+//       std::cout << (check.fileSize - check.goodSize) << " bytes" << std::endl;
+//    }
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+
+namespace mixr {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// File check results
+//------------------------------------------------------------------------------
+struct FileCheck
+{
+   bool blockFile{};                // Block compressed file
+   std::uint64_t fileSize{};        // File size (bytes)
+   std::uint64_t goodSize{};        // Offset of the end of the last good block or record (bytes)
+   std::uint64_t numRecords{};      // Number of data records in the good blocks
+   unsigned int numBlocks{};        // Number of good blocks
+   unsigned int numDamaged{};       // Number of damaged regions (including a damaged tail)
+   std::uint64_t numDamagedBytes{}; // Number of bytes in the damaged regions
+};
+
+// Checks the data file; returns false if the file can't be read
+bool checkRecorderFile(const char* const filename, FileCheck* const check);
+
+// Checks the data file and truncates it to the end of its last good block or
+// record; returns false if the file can't be read or truncated
+bool recoverRecorderFile(const char* const filename, FileCheck* const check);
+
+}
+}
+
+#endif
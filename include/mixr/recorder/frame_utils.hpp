@@ -0,0 +1,65 @@
+
+#ifndef __mixr_recorder_frame_utils_HPP__
+#define __mixr_recorder_frame_utils_HPP__
+
+//------------------------------------------------------------------------------
+// Data recorder network frame format
+//
+// The NetOutput handler packs its data records into frames, and each frame is
+// sent as one datagram.  A frame is a fixed size frame header followed by its
+// payload:
+//
+//    marker         4 bytes  ! FRAME_MARKER
+//    streamId       4 bytes  ! Sender's stream identifier
+//    sequence       4 bytes  ! Frame sequence number (per stream, starts at zero)
+//    numRecords     4 bytes  ! Number of data records in the frame
+//    payloadSize    4 bytes  ! Payload size (bytes)
+//    startTime      8 bytes  ! Sim time of the first data record (seconds)
+//    endTime        8 bytes  ! Sim time of the last data record (seconds)
+//    checksum       4 bytes  ! CRC-32 of the payload
+//
+// The payload is the sequence of serialized DataRecords, each preceded by its
+// size in bytes (same as the block file payload; see block_utils.hpp).  All
+// integers are little endian.
+//
+// Datagrams that don't start with a frame marker are legacy datagrams that
+// contain a single serialized DataRecord.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/block_utils.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace mixr {
+namespace recorder {
+
+const std::uint32_t FRAME_MARKER{0x464e584d};            // "MXNF"
+const unsigned int FRAME_HEADER_SIZE{40};
+const unsigned int FRAME_MAX_SIZE{65507};                 // Max UDP datagram payload
+
+//------------------------------------------------------------------------------
+// Frame header
+//------------------------------------------------------------------------------
+struct FrameHeader
+{
+   std::uint32_t streamId{};     // Sender's stream identifier
+   std::uint32_t sequence{};     // Frame sequence number
+   std::uint32_t numRecords{};   // Number of data records
+   std::uint32_t payloadSize{};  // Payload size (bytes)
+   double startTime{};           // Sim time of the first data record (seconds)
+   double endTime{};             // Sim time of the last data record (seconds)
+};
+
+// Encodes the frame (header and the block's records) into 'frame'
+void encodeFrame(const std::uint32_t streamId, const std::uint32_t sequence, const RecordBlock& block, std::string* const frame);
+
+// Decodes the frame header of a datagram of 'n' bytes; returns false if this
+// isn't a valid frame (e.g., a legacy datagram).  The payload follows the
+// header and its checksum is checked.
+bool decodeFrame(const char* const buff, const std::size_t n, FrameHeader* const hdr);
+
+}
+}
+
+#endif
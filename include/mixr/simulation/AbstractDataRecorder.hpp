@@ -21,6 +21,10 @@ class Station;
 //
 //    3) Recorded data records are defined by their "recorder event id" tokens;
 //       (see mixr/simulation/dataRecorderTokens.hpp)
+//
+//    4) Derived classes can limit the recorded data to the IDs that are
+//       consumed downstream using setConsumedIds(); recordData() returns
+//       before calling recordDataImp() for IDs that aren't consumed.
 //------------------------------------------------------------------------------
 class AbstractDataRecorder : public AbstractRecorderComponent
 {
@@ -45,6 +49,9 @@ public:
    // Background thread processing of the data records
    virtual void processRecords();
 
+   // Set of the recorder event IDs that are consumed downstream (default: all)
+   const RecorderIdSet& getConsumedIds() const        { return consumedIds; }
+
 protected:
    // Implementation of the record data function
    virtual bool recordDataImp(
@@ -56,10 +63,15 @@ protected:
    // Process the unhandled or unknown recorder event IDs
    virtual bool processUnhandledId(const unsigned int id) =0;
 
+   // Set the recorder event IDs that are consumed downstream
+   void setConsumedIds(const RecorderIdSet& ids)      { consumedIds = ids; }
+
 private:
    Station* getStationImp();
    Simulation* getSimulationImp();
 
+   RecorderIdSet consumedIds;    // IDs consumed downstream
+
    Station* sta{};         // The station that owns us (not ref()'d)
    Simulation* sim{};      // The simulation system (not ref()'d)
 };
@@ -72,7 +84,7 @@ inline bool AbstractDataRecorder::recordData(
    )
 {
    bool recorded{};
-   if (isDataEnabled(id)) {
+   if (isDataEnabled(id) && (id >= MAX_RECORDER_IDS || consumedIds[id])) {
       recorded = recordDataImp(id, pObjects, values);
       if (!recorded) processUnhandledId(id);
    }
@@ -4,6 +4,7 @@
 
 #include "mixr/base/Component.hpp"
 #include "mixr/simulation/dataRecorderTokens.hpp"
+#include <bitset>
 
 namespace mixr {
 namespace base { class List; }
@@ -18,6 +19,9 @@ namespace simulation {
 //    DataRecords with matching recorder event IDs.  Default is to process
 //    all DataRecords.
 //
+//    2) The enabled and disabled lists are compiled into a set of enabled
+//    IDs (see getEnabledIds()), so checking a recorder event ID that's less
+//    than MAX_RECORDER_IDS is a single bit test.
 //
 // Slots:
 //    enabledList <base::List>   ! List of data records that are enabled for processing
@@ -34,12 +38,20 @@ class AbstractRecorderComponent : public base::Component
 {
    DECLARE_SUBCLASS(AbstractRecorderComponent, base::Component)
 
+public:
+   // Recorder event IDs [ 0 ... REID_LAST_USER_EVENT ]
+   static const unsigned int MAX_RECORDER_IDS = REID_LAST_USER_EVENT + 1;
+   typedef std::bitset<MAX_RECORDER_IDS> RecorderIdSet;
+
 public:
    AbstractRecorderComponent();
 
    // Checks the data filters and returns true if the record should be processed.
    bool isDataEnabled(const unsigned int id) const;
 
+   // Set of the recorder event IDs enabled by the data filters
+   const RecorderIdSet& getEnabledIds() const    { return enabledIds; }
+
    // Set a list of 'n' of data records enabled for processing,
    // or set 'n' to zero to enable all data records.
    bool setEnabledList(const unsigned int* const list, const unsigned int n);
@@ -48,6 +60,10 @@ public:
    bool setDisabledList(const unsigned int* const list, const unsigned int n);
 
 private:
+   void updateEnabledIds();
+
+   RecorderIdSet enabledIds;       // Enabled record IDs (compiled from the lists)
+
    unsigned int* enabledList{};    // List of data records enabled for processing (default: all)
    unsigned int numEnabled{};      // Number of enabled record IDs, or zero for all records enabled
 
@@ -66,7 +82,11 @@ inline bool AbstractRecorderComponent::isDataEnabled(const unsigned int id) cons
 {
    bool ok{true};   // default is enabled
 
-   if (id != REID_END_OF_DATA) { // END_OF_DATA message is always enabled
+   if (id < MAX_RECORDER_IDS) {
+      ok = (id == REID_END_OF_DATA || enabledIds[id]); // END_OF_DATA message is always enabled
+   }
+   else {
+      // IDs outside of the set -- check the lists
       // Do we have an enabled list?
       if (numEnabled > 0 && enabledList != nullptr) {
          ok = false; // yes -- then check to see if this message is enabled
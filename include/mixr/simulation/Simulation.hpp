@@ -55,6 +55,9 @@ class AbstractPlayer;
 //
 //    printFrameTimingStats <base:Boolean>    ! Enable/disable the printing of the frame timing statistics (default: false)
 //
+//    frameSnapshotTime <base::Time>          ! Time between player frame snapshot samples to the data
+//                                            ! recorder, or zero to disable (default: 0)
+//
 // The player list
 //
 //    a) is managed by the background thread
@@ -148,6 +151,16 @@ class AbstractPlayer;
 //    4) See "mixr/base/util/system.hpp" for additional time related functions.
 //
 //
+// Frame snapshots:
+//
+//    When the 'frameSnapshotTime' slot is set, the state of all active players
+//    is sampled to the data recorder as a single REID_PLAYER_FRAME record at the
+//    end of the time-critical frame, once per sample period.  This replaces the
+//    per-player REID_PLAYER_DATA records for large scenarios; use the recorder's
+//    'disabledList' to filter out REID_PLAYER_DATA, or don't set the players'
+//    'dataLogTime' slots.
+//
+//
 // Event IDs:
 //
 //    There are several player events that need to be identified uniquely
@@ -222,6 +235,8 @@ public:
     bool isFrameTimingEabled() const;                          // True if we're collecting frame timing
     bool isPrintFrameTimingEnabled() const;                    // True if we're printing the frame timing statistics
 
+    double getFrameSnapshotTime() const;                       // Time between player frame snapshots (seconds; zero if disabled)
+
     void updateTC(const double dt = 0.0) override;
     void updateData(const double dt = 0.0) override;
     void reset() override;
@@ -256,6 +271,9 @@ protected:
     virtual bool setPrintFrameTimingStats(const bool);
     virtual void printFrameTimingStats();
 
+    virtual bool setFrameSnapshotTime(const double);  // Sets the time between player frame snapshots (seconds)
+    virtual void recordFrameSnapshot(base::PairStream* const playerList);
+
     void printTimingStats() override;
     bool shutdownNotification() override;
 
@@ -315,6 +333,9 @@ private:
    double tcLastFrameTime{0.0};                                       // Previous frame time
    bool pfts{};                                                       // Print frame timing statistics
 
+   double snapshotTime{};                                             // Time between player frame snapshots (seconds)
+   double snapshotTimer{};                                            // Player frame snapshot timer (seconds)
+
 private:
    // slot table helper methods
    bool setSlotPlayers(base::PairStream* const);
@@ -330,6 +351,7 @@ private:
    bool setSlotNumBgThreads(const base::Integer* const);
    bool setSlotEnableFrameTiming(const base::Boolean* const);
    bool setSlotPrintFrameTimingStats(const base::Boolean* const);
+   bool setSlotFrameSnapshotTime(const base::Time* const);
 };
 
 // Returns the timing statistics for the frames
@@ -350,6 +372,12 @@ inline bool Simulation::isPrintFrameTimingEnabled() const
    return pfts;
 }
 
+// Time between player frame snapshots (seconds; zero if disabled)
+inline double Simulation::getFrameSnapshotTime() const
+{
+   return snapshotTime;
+}
+
 }
 }
 
@@ -38,6 +38,7 @@
 #define REID_PLAYER_COLLISION    45    // Player collision message; P1 => (player); P2 => (other player)
 #define REID_PLAYER_CRASH        46    // Player crash message; P1 => (player)
 #define REID_PLAYER_KILLED       47    // Player killed message; P1 => (player); P2 => (shooter)
+#define REID_PLAYER_FRAME        48    // Player frame snapshot message; P1 => (player list)
 
 // Weapon data messages
 #define REID_WEAPON_RELEASED     61    // Weapon Released message; P1 => (weapon); P2 => (shooter); P3 => (tgt)
@@ -3,6 +3,7 @@
 #define __mixr_terrain_DataFile_HPP__
 
 #include "mixr/terrain/Terrain.hpp"
+#include "mixr/terrain/ElevationPyramid.hpp"
 
 namespace mixr {
 namespace terrain {
@@ -16,6 +17,9 @@ namespace terrain {
 //    1) the first elevation point [0] of all arrays is at the reference point
 //    2) the final elevation point [n-1] is at the maximum range
 //    3) The size of all arrays, n, must contain at least 2 points (ref point & max range)
+//    4) A min/max elevation pyramid of the posts is built at reset(), once the
+//       data is loaded; it's used by getElevationBounds(), which lets the
+//       occulting checks skip (or accept) whole spans of their profiles.
 //------------------------------------------------------------------------------
 class DataFile : public Terrain
 {
@@ -52,6 +56,9 @@ public:
    //  Elevations are in meters
    const short* getColumn(const unsigned int idx) const;
 
+   // Value representing a void (missing) data point
+   short getVoidValue() const             { return voidValue; }
+
    // ---
    // simulation::Terrain interface
    // ---
@@ -80,6 +87,18 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   // Bounds the elevations of a lat/lon region (using the min/max elevation pyramid)
+   bool getElevationBounds(
+         double* const minElev,        // Min elevation (meters)
+         double* const maxElev,        // Max elevation (meters)
+         const double minLat,          // Southern latitude of the region (degs)
+         const double minLon,          // Western longitude of the region (degs)
+         const double maxLat,          // Northern latitude of the region (degs)
+         const double maxLon           // Eastern longitude of the region (degs)
+      ) const override;
+
+   void reset() override;
+
 protected:
    short**  columns {};           // Array of data columns (values in meters)
    double   latSpacing {};        // Spacing between latitude points (degs)
@@ -89,6 +108,12 @@ protected:
    short    voidValue {-32767};   // Value representing a void (missing) data point
 
    void clearData() override;
+
+private:
+   // Locates the elevation of a point (see getElevation())
+   bool locateElevation(double* const elev, const double lat, const double lon, const bool interp) const;
+
+   ElevationPyramid pyramid;      // Min/max elevation pyramid
 };
 
 }
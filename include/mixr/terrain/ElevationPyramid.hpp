@@ -0,0 +1,67 @@
+
+#ifndef __mixr_terrain_ElevationPyramid_HPP__
+#define __mixr_terrain_ElevationPyramid_HPP__
+
+#include <vector>
+
+namespace mixr {
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: ElevationPyramid
+// Description: Min/max elevation pyramid of a grid of elevation posts; used
+//              to bound the elevations of a region of the grid without
+//              visiting its posts.
+//
+//    Level zero holds the min/max elevations of each block of BLOCK x BLOCK
+//    posts, and each higher level holds the min/max elevations of 2x2 blocks
+//    of the level below, up to a single block that holds the min/max of the
+//    whole grid.
+//
+// Notes:
+//    1) The bounds are conservative: they're the min/max of the blocks that
+//       cover the region, so they may be wider than the region's min/max.
+//    2) The posts are indexed as the DataFile's columns: [icol][irow].
+//------------------------------------------------------------------------------
+class ElevationPyramid
+{
+public:
+   static const unsigned int BLOCK_SHIFT{2};                // log2 of the level zero block size
+   static const unsigned int BLOCK{1u << BLOCK_SHIFT};     // Level zero block size (posts)
+
+public:
+   // Builds the pyramid from the elevation posts; columns[icol][irow]
+   void build(const short* const* const columns, const unsigned int nptlat, const unsigned int nptlong);
+
+   void clear();
+   bool isEmpty() const                { return levels.empty(); }
+   unsigned int getNumLevels() const   { return static_cast<unsigned int>(levels.size()); }
+
+   // Min/max elevations of the posts [ irow0 .. irow1 ] x [ icol0 .. icol1 ];
+   // returns false if the pyramid is empty
+   bool getBounds(
+         short* const minElev,         // Min elevation (meters)
+         short* const maxElev,         // Max elevation (meters)
+         const unsigned int irow0,     // First row
+         const unsigned int irow1,     // Last row
+         const unsigned int icol0,     // First column
+         const unsigned int icol1      // Last column
+      ) const;
+
+private:
+   struct Level {
+      unsigned int rows {};            // Number of block rows
+      unsigned int cols {};            // Number of block columns
+      std::vector<short> minv;         // Block min elevations; [col * rows + row]
+      std::vector<short> maxv;         // Block max elevations; [col * rows + row]
+   };
+
+   std::vector<Level> levels;          // Level k blocks are (BLOCK << k) posts on a side
+   unsigned int nptlat {};             // Number of points in latitude
+   unsigned int nptlong {};            // Number of points in longitude
+};
+
+}
+}
+
+#endif
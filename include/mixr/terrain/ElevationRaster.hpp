@@ -0,0 +1,107 @@
+
+#ifndef __mixr_terrain_ElevationRaster_HPP__
+#define __mixr_terrain_ElevationRaster_HPP__
+
+#include <cstdint>
+#include <vector>
+
+namespace mixr {
+namespace terrain {
+class RasterService;
+
+//------------------------------------------------------------------------------
+// Class: ElevationRaster
+// Description: A georeferenced grid of terrain elevations, with optional
+//              hillshading and an RGBA image, that's generated by a RasterService.
+//
+//    The raster's area is set using setArea(), which takes the lat/lon box
+//    and the number of rows and columns.  The cells are equal steps of
+//    latitude and longitude, row 0 is the northern row, column 0 is the
+//    western column, and each cell's elevation is the terrain's elevation at
+//    the cell's center (see getLatitude() and getLongitude()).  The cell
+//    (row, col) is at index (row * numCols + col) of the arrays.
+//
+//    After RasterService::process(), the elevations (meters) are available
+//    from getElevations(), with getValidFlags() set if an elevation was
+//    found; the shading factors [ 0 .. 1 ] from getShading(), if hillshading
+//    was enabled; and the RGBA image (4 bytes per cell) from getImage(), if
+//    either hillshading or the elevation colors were enabled.
+//
+//    A raster is owned by its user (e.g., a map display), and it's reused by
+//    setting a new area.
+//------------------------------------------------------------------------------
+class ElevationRaster
+{
+   friend class RasterService;
+
+public:
+   ElevationRaster() = default;
+   ElevationRaster(const ElevationRaster&) = delete;
+   ElevationRaster& operator=(const ElevationRaster&) = delete;
+
+   // Sets the raster's area and size, and clears the results; returns false
+   // if the area or size isn't valid (the raster is unchanged)
+   bool setArea(
+         const double minLat,          // Southern latitude (degs)
+         const double minLon,          // Western longitude (degs)
+         const double maxLat,          // Northern latitude (degs)
+         const double maxLon,          // Eastern longitude (degs)
+         const unsigned int numRows,   // Number of rows (north to south)
+         const unsigned int numCols    // Number of columns (west to east)
+      );
+
+   double getMinLatitude() const       { return minLat; }
+   double getMinLongitude() const      { return minLon; }
+   double getMaxLatitude() const       { return maxLat; }
+   double getMaxLongitude() const      { return maxLon; }
+   unsigned int getNumRows() const     { return numRows; }
+   unsigned int getNumCols() const     { return numCols; }
+
+   double getLatitudeSpacing() const;                   // Cell height (degs)
+   double getLongitudeSpacing() const;                  // Cell width (degs)
+   double getLatitude(const unsigned int row) const;    // Latitude of the row's cell centers (degs)
+   double getLongitude(const unsigned int col) const;   // Longitude of the column's cell centers (degs)
+
+   // Has the raster been processed?
+   bool isProcessed() const            { return processed; }
+
+   // Results (zero if not generated)
+   const float* getElevations() const;             // Elevations (meters)
+   const std::uint8_t* getValidFlags() const;      // Valid elevation flags (non-zero if found)
+   const float* getShading() const;                // Shading factors
+   const std::uint8_t* getImage() const;           // RGBA image
+
+   // Elevation (meters) of the cell; returns false if there's no elevation
+   bool getElevation(double* const elev, const unsigned int row, const unsigned int col) const;
+
+private:
+   // Unit of work: a range of rows or a range of columns
+   struct Unit {
+      unsigned int begin {};
+      unsigned int end {};
+      bool columns {};
+   };
+
+   double minLat {}, minLon {};        // Southwest corner (degs)
+   double maxLat {}, maxLon {};        // Northeast corner (degs)
+   unsigned int numRows {};
+   unsigned int numCols {};
+
+   std::vector<float> elevations;      // Elevations (meters)
+   std::vector<std::uint8_t> valid;    // Valid elevation flags
+   std::vector<float> rowShade;        // Row (west to east) lighting factors
+   std::vector<float> colShade;        // Column (north to south) lighting factors
+   std::vector<float> shading;         // Shading factors
+   std::vector<std::uint8_t> image;    // RGBA image
+
+   std::vector<Unit> units;            // The current pass's units of work
+   unsigned int nextUnit {};           // Next unit to process
+   unsigned int pass {};               // Current pass (see RasterService)
+   long semaphore {};                  // Semaphore for 'nextUnit'
+   bool processed {};
+};
+
+}
+}
+
+#endif
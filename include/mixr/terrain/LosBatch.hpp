@@ -0,0 +1,131 @@
+
+#ifndef __mixr_terrain_LosBatch_HPP__
+#define __mixr_terrain_LosBatch_HPP__
+
+#include <cstdint>
+#include <vector>
+
+namespace mixr {
+namespace terrain {
+class LosService;
+class LosServiceThread;
+
+//------------------------------------------------------------------------------
+// Class: LosBatch
+// Description: A batch of terrain line-of-sight (occulting) queries, which are
+//              evaluated together by a LosService.
+//
+//    The queries are added using addQuery(), which takes the parameters of
+//    Terrain::targetOcculting2(), or addTarget(), which takes the parameters
+//    of Terrain::targetOcculting().  After LosService::process(), the
+//    visibility of each query is available from isVisible(i) or as a
+//    bitmask from getVisibility(), where bit (i % 32) of word (i / 32) is
+//    set if the i'th query is visible (i.e., not occulted).
+//
+//    A batch is owned by its user (e.g., a Tdb), and it's reused from frame
+//    to frame by clear(), which keeps its storage.  The batches of many users
+//    (e.g., all of a frame's Tdbs) can be evaluated as one by the service (see
+//    LosService::process()).
+//------------------------------------------------------------------------------
+class LosBatch
+{
+   friend class LosService;
+   friend class LosServiceThread;
+
+public:
+   LosBatch() = default;
+   LosBatch(const LosBatch&) = delete;
+   LosBatch& operator=(const LosBatch&) = delete;
+
+   // Clears the queries and results
+   void clear();
+
+   // Adds a query; same as Terrain::targetOcculting2().  Returns the query's index.
+   unsigned int addQuery(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double truBrg,          // True direction angle from north to look (degs)
+         const double dist,            // Distance to check (meters)
+         const double tanLookAng       // Tangent of the look angle
+      );
+
+   // Adds a query to a target point; same as Terrain::targetOcculting().
+   // Returns the query's index.
+   unsigned int addTarget(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const double tgtAlt           // Target altitude (meters)
+      );
+
+   unsigned int getNumQueries() const  { return static_cast<unsigned int>(queries.size()); }
+
+   // Have the queries been processed?
+   bool isProcessed() const            { return processed; }
+
+   // Is the i'th query's target visible (i.e., not occulted)?
+   bool isVisible(const unsigned int i) const;
+
+   // Visibility bitmask; bit (i % 32) of word (i / 32) is set if the i'th
+   // query is visible.  There are (getNumQueries() + 31) / 32 words.
+   const std::uint32_t* getVisibility() const;
+
+   // Number of visible queries
+   unsigned int getNumVisible() const;
+
+private:
+   // Line-of-sight query (the targetOcculting2() form)
+   struct Query {
+      double refLat {};             // Ref latitude (degs)
+      double refLon {};             // Ref longitude (degs)
+      double refAlt {};             // Ref altitude (meters)
+      double truBrg {};             // True direction angle (degs)
+      double dist {};               // Distance to check (meters)
+      double tanLookAng {};         // Tangent of the look angle
+      unsigned int numPts {};       // Number of profile points
+   };
+
+   // Unit of work: queries [ begin .. end ) of 'order', all from the same observer
+   struct Unit {
+      unsigned int begin {};
+      unsigned int end {};
+   };
+
+   // Bounds of an azimuth sector within a range ring
+   struct Bounds {
+      double minElev {};            // Min elevation (meters)
+      double maxElev {};            // Max elevation (meters)
+      bool noData {};               // No elevation data within the region
+      bool valid {};                // Bounds have been computed
+   };
+
+   // Work space of a thread that evaluates units (kept between frames)
+   struct Workspace {
+      std::vector<double> rings;    // Range rings (meters)
+      std::vector<Bounds> bounds;   // Bounds of the sectors within the rings
+   };
+
+   // Sets the visibility bitmask from the results
+   void setVisibility();
+
+   std::vector<Query> queries;            // Queries
+   std::vector<unsigned char> occulted;   // Results; true if occulted
+   std::vector<std::uint32_t> visibility; // Visibility bitmask
+
+   std::vector<unsigned int> order;       // Query indices; sorted by observer and bearing
+   std::vector<Unit> units;               // Units of work
+   unsigned int nextUnit {};              // Next unit to be evaluated
+   long semaphore {};                     // Semaphore for 'nextUnit'
+
+   bool processed {};                     // Queries have been processed
+
+   Workspace workspace;                   // Calling thread's work space
+};
+
+}
+}
+
+#endif
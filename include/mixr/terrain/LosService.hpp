@@ -0,0 +1,130 @@
+
+#ifndef __mixr_terrain_LosService_HPP__
+#define __mixr_terrain_LosService_HPP__
+
+#include "mixr/base/Component.hpp"
+#include "mixr/terrain/LosBatch.hpp"
+
+#include <vector>
+
+namespace mixr {
+namespace base { class Integer; class Number; }
+namespace terrain {
+class LosServiceThread;
+class Terrain;
+
+//------------------------------------------------------------------------------
+// Class: LosService
+// Description: Many-to-many line-of-sight service; evaluates a batch of
+//              terrain occulting queries (see LosBatch) in one call.
+//
+// Factory name: LosService
+// Slots:
+//    numThreads  <Integer>   ! Number of threads used to evaluate a batch, which
+//                            ! includes the calling thread (default: 1)
+//
+//    priority    <Number>    ! Priority of the pool threads (0->lowest, 1->highest)
+//                            ! (default: 0.5)
+//
+//    sectors     <Integer>   ! Number of azimuth sectors around each observer
+//                            ! (default: 64)
+//
+// Notes:
+//    1) The queries are grouped by observer, and sorted by bearing, into units
+//       of work that are shared by the calling thread and the pool threads.
+//       The results are the same as the Terrain's targetOcculting() and
+//       targetOcculting2() functions, query by query.
+//
+//    2) Around each observer, the terrain's elevation bounds are computed once
+//       for each azimuth sector and range ring (the first ring is 500 meters,
+//       and the rings double in width from there), and they're shared by all
+//       of the observer's queries that are within the sector.  A query whose
+//       line of sight is above the bounds of all of its rings is visible
+//       without sampling its profile; otherwise, its profile is checked by
+//       Terrain::isProfileOcculted().  The sectors are only used with terrain
+//       that has elevation bounds (see Terrain::getElevationBounds()).
+//
+//    3) The pool threads are created at reset().  A batch that's processed
+//       while the pool is busy with another batch (i.e., from another thread)
+//       is evaluated by its calling thread alone.
+//
+//    4) The batches of many users (e.g., all of the sensors' Tdbs of a
+//       frame; see WorldModel::updateData()) are evaluated as one batch by
+//       process(terrain, batches, n, frame): their queries are gathered into
+//       the caller's 'frame' batch, which is reused from frame to frame, and
+//       the results are handed back to each batch.  Each thread's work space
+//       (i.e., range rings and sector bounds) is also kept between batches.
+//------------------------------------------------------------------------------
+class LosService : public base::Component
+{
+   DECLARE_SUBCLASS(LosService, base::Component)
+
+public:
+   static const unsigned int MAX_THREADS{16};
+
+public:
+   LosService();
+
+   unsigned int getNumThreads() const     { return reqThreads; }
+   double getPriority() const             { return priority; }
+   unsigned int getNumSectors() const     { return numSectors; }
+
+   virtual bool setNumThreads(const unsigned int);
+   virtual bool setPriority(const double);
+   virtual bool setNumSectors(const unsigned int);
+
+   // Evaluates the batch's queries using the terrain; returns true if successful
+   bool process(const Terrain* const terrain, LosBatch* const batch) const;
+
+   // Evaluates the queries of the 'n' batches as one batch, using the
+   // caller's 'frame' batch (see Note 4); returns true if successful
+   bool process(
+         const Terrain* const terrain,
+         LosBatch* const* const batches,
+         const unsigned int n,
+         LosBatch* const frame
+      ) const;
+
+   void reset() override;
+   bool shutdownNotification() override;
+
+private:
+   friend class LosServiceThread;
+
+   // Evaluates the batch's units until there are no more (called by all
+   // threads, each with its own work space)
+   void processUnits(const Terrain* const terrain, LosBatch* const batch, LosBatch::Workspace* const ws) const;
+
+   // Evaluates the queries of one unit
+   void processUnit(
+         const Terrain* const terrain,
+         LosBatch* const batch,
+         const unsigned int idx,
+         LosBatch::Workspace* const ws
+      ) const;
+
+   void createThreads();
+   void deleteThreads();
+
+   LosServiceThread* threads[MAX_THREADS] {};   // Pool threads
+   unsigned int numPoolThreads {};              // Number of pool threads
+   bool threadsFailed {};                       // Failed to create the pool threads
+
+   mutable long poolSemaphore {};               // Semaphore for 'poolBusy'
+   mutable bool poolBusy {};                    // Pool is busy with a batch
+
+   unsigned int reqThreads {1};                 // Requested number of threads
+   double priority {0.5};                       // Pool thread priority
+   unsigned int numSectors {64};                // Number of azimuth sectors
+
+private:
+   // slot table helper methods
+   bool setSlotNumThreads(const base::Integer* const);
+   bool setSlotPriority(const base::Number* const);
+   bool setSlotNumSectors(const base::Integer* const);
+};
+
+}
+}
+
+#endif
@@ -53,6 +53,16 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   // Bounds the elevations of a lat/lon region (using the data files' bounds)
+   bool getElevationBounds(
+         double* const minElev,        // Min elevation (meters)
+         double* const maxElev,        // Max elevation (meters)
+         const double minLat,          // Southern latitude of the region (degs)
+         const double minLon,          // Western longitude of the region (degs)
+         const double maxLat,          // Northern latitude of the region (degs)
+         const double maxLon           // Eastern longitude of the region (degs)
+      ) const override;
+
    void reset() override;
 
 protected:
@@ -0,0 +1,179 @@
+
+#ifndef __mixr_terrain_RasterService_HPP__
+#define __mixr_terrain_RasterService_HPP__
+
+#include "mixr/base/Component.hpp"
+
+#include <vector>
+
+namespace mixr {
+namespace base { class Angle; class Boolean; class Hsva; class Integer; class Length; class Number; class PairStream; }
+namespace terrain {
+class ElevationRaster;
+class RasterServiceThread;
+class Terrain;
+
+//------------------------------------------------------------------------------
+// Class: RasterService
+// Description: Terrain elevation raster service; generates a georeferenced
+//              grid of elevations (see ElevationRaster), with optional
+//              hillshading and elevation colors, for map displays.
+//
+// Factory name: RasterService
+// Slots:
+//    numThreads     <Integer>    ! Number of threads used to generate a raster, which
+//                                ! includes the calling thread (default: 1)
+//
+//    priority       <Number>     ! Priority of the pool threads (0->lowest, 1->highest)
+//                                ! (default: 0.5)
+//
+//    tileSize       <Integer>    ! Number of rows (or columns) in a unit of work
+//                                ! (default: 32)
+//
+//    interpolate    <Boolean>    ! Interpolate between elevation posts (default: false)
+//
+//    hillshade      <Boolean>    ! Shade the raster's relief (default: false)
+//
+//    sunAzimuth     <Angle>      ! True direction to the light (default: 315 degs)
+//
+//    sunElevation   <Angle>      ! Elevation angle of the light (default: 45 degs)
+//
+//    colors         <PairStream> ! Elevation colors (base::Hsva), lowest to highest;
+//                                ! see Terrain::getElevationColor() (default: none)
+//
+//    minElevation   <Length>     ! Elevation of the first color (default: 0)
+//
+//    maxElevation   <Length>     ! Elevation of the last color (default: 0)
+//                                ! (if not greater than minElevation, the terrain's
+//                                ! min and max elevations are used)
+//
+// Example:
+//
+//    ( RasterService
+//       numThreads: 4
+//       hillshade: true
+//       colors: {
+//          ( hsva hue: 240 saturation: 1 value: 1 )   // blue
+//          ( hsva hue: 120 saturation: 1 value: 1 )   // green
+//          ( hsva hue:  60 saturation: 1 value: 1 )   // yellow
+//          ( hsva hue:   0 saturation: 0 value: 1 )   // white
+//       }
+//       maxElevation: ( Meters 4000 )
+//    )
+//
+// Notes:
+//    1) The raster is generated in three passes, and each pass is divided
+//       into units of work (tiles of rows or columns) that are shared by the
+//       calling thread and the pool threads: the elevations, using the
+//       terrain's getElevations() along each row; the lighting factors,
+//       using Terrain::cLight() along each row (west to east) and each column
+//       (north to south); and the image.  Each cell's results depend only
+//       on the elevations, so the results are the same for any number of
+//       threads or tile size.
+//
+//    2) The shading factor is the average of the row and column lighting
+//       factors, where the light's direction is projected onto each
+//       profile's vertical plane.  Cells without elevations are masked
+//       (i.e., shading factor of zero, and transparent in the image).
+//
+//    3) The image's color is the elevation color, scaled by the shading
+//       factor with hillshading; or the gray scale shading factor, without
+//       the elevation colors.
+//
+//    4) The pool threads are created at reset().  A raster that's generated
+//       while the pool is busy with another raster (i.e., from another
+//       thread) is generated by its calling thread alone.
+//------------------------------------------------------------------------------
+class RasterService : public base::Component
+{
+   DECLARE_SUBCLASS(RasterService, base::Component)
+
+public:
+   static const unsigned int MAX_THREADS{16};
+
+public:
+   RasterService();
+
+   unsigned int getNumThreads() const        { return reqThreads; }
+   double getPriority() const                { return priority; }
+   unsigned int getTileSize() const          { return tileSize; }
+   bool isInterpolating() const              { return interp; }
+   bool isHillshading() const                { return hillshade; }
+   double getSunAzimuth() const              { return sunAzimuth; }    // degs
+   double getSunElevation() const            { return sunElevation; }  // degs
+   unsigned int getNumColors() const         { return static_cast<unsigned int>(colors.size()); }
+   double getMinElevation() const            { return minElevation; }  // meters
+   double getMaxElevation() const            { return maxElevation; }  // meters
+
+   virtual bool setNumThreads(const unsigned int);
+   virtual bool setPriority(const double);
+   virtual bool setTileSize(const unsigned int);
+   virtual bool setInterpolate(const bool);
+   virtual bool setHillshade(const bool);
+   virtual bool setSunAzimuth(const double degs);
+   virtual bool setSunElevation(const double degs);
+   virtual bool setMinElevation(const double meters);
+   virtual bool setMaxElevation(const double meters);
+
+   // Generates the raster using the terrain; returns true if successful
+   bool process(const Terrain* const terrain, ElevationRaster* const raster) const;
+
+   void reset() override;
+   bool shutdownNotification() override;
+
+private:
+   friend class RasterServiceThread;
+
+   // Passes
+   enum { ELEVATIONS = 1, SHADING, IMAGE };
+
+   // Processes one pass of the raster
+   void processPass(const Terrain* const terrain, ElevationRaster* const raster, const unsigned int pass, const bool usePool) const;
+
+   // Processes the raster's units until there are no more (called by all threads)
+   void processUnits(const Terrain* const terrain, ElevationRaster* const raster) const;
+
+   // Processes one unit of the current pass
+   void processUnit(const Terrain* const terrain, ElevationRaster* const raster, const unsigned int idx) const;
+
+   void clearColors();
+
+   void createThreads();
+   void deleteThreads();
+
+   RasterServiceThread* threads[MAX_THREADS] {};   // Pool threads
+   unsigned int numPoolThreads {};                 // Number of pool threads
+   bool threadsFailed {};                          // Failed to create the pool threads
+
+   mutable long poolSemaphore {};                  // Semaphore for 'poolBusy'
+   mutable bool poolBusy {};                       // Pool is busy with a raster
+
+   unsigned int reqThreads {1};                    // Requested number of threads
+   double priority {0.5};                          // Pool thread priority
+   unsigned int tileSize {32};                     // Rows (or columns) per unit
+   bool interp {};                                 // Interpolate between posts
+   bool hillshade {};                              // Shade the relief
+   double sunAzimuth {315.0};                      // Direction to the light (degs)
+   double sunElevation {45.0};                     // Elevation of the light (degs)
+   std::vector<const base::Hsva*> colors;          // Elevation colors (ref()'d)
+   double minElevation {};                         // Elevation of the first color (meters)
+   double maxElevation {};                         // Elevation of the last color (meters)
+
+private:
+   // slot table helper methods
+   bool setSlotNumThreads(const base::Integer* const);
+   bool setSlotPriority(const base::Number* const);
+   bool setSlotTileSize(const base::Integer* const);
+   bool setSlotInterpolate(const base::Boolean* const);
+   bool setSlotHillshade(const base::Boolean* const);
+   bool setSlotSunAzimuth(const base::Angle* const);
+   bool setSlotSunElevation(const base::Angle* const);
+   bool setSlotColors(const base::PairStream* const);
+   bool setSlotMinElevation(const base::Length* const);
+   bool setSlotMaxElevation(const base::Length* const);
+};
+
+}
+}
+
+#endif
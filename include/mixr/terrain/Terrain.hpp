@@ -93,6 +93,36 @@ public:
       const double tanLookAng          // Tangent of the look angle
    ) const;
 
+   // Returns true if any of the 'n' elevation points along the profile, other
+   // than its first and last points, is at or above the line of sight from the
+   // ref altitude with a look angle of atan(tanLookAng); i.e., the same answer
+   // as getElevations() followed by occultCheck2().  When the elevation
+   // bounds are available (see getElevationBounds()), whole spans of the
+   // profile are accepted or rejected by their bounds, and only the spans
+   // that are near the line of sight are checked point by point.
+   virtual bool isProfileOcculted(
+         const unsigned int n,         // Number of elevation points
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const double direction,       // True direction (heading) angle of the profile (degs)
+         const double maxRng,          // Range to last elevation point (meters)
+         const double refAlt,          // Ref altitude (meters)
+         const double tanLookAng       // Tangent of the look angle
+      ) const;
+
+   // Bounds the elevations (meters) that getElevation() returns for any point
+   // within the lat/lon region; the bounds are conservative, and 'minElev' is
+   // greater than 'maxElev' if there's no data within the region.  Returns
+   // false if the bounds aren't available (default).
+   virtual bool getElevationBounds(
+         double* const minElev,        // Min elevation (meters)
+         double* const maxElev,        // Max elevation (meters)
+         const double minLat,          // Southern latitude of the region (degs)
+         const double minLon,          // Western longitude of the region (degs)
+         const double maxLat,          // Northern latitude of the region (degs)
+         const double maxLon           // Eastern longitude of the region (degs)
+      ) const;
+
    // Returns true if the target at the altitude 'tgtAlt' and range 'range' is
    // occulted by the elevation points as seen from the reference altitude, 'refAlt'.
    static bool occultCheck(
@@ -116,6 +146,17 @@ public:
          const double tanLookAng         // Tangent of the look angle
       );
 
+   // Computes the lat/lon steps (degs) between the 'n' points of a profile;
+   // the i'th point is at [ (lat + deltaLat * i) (lon + deltaLon * i) ]
+   static void computeProfileSteps(
+         double* const deltaLat,       // Latitude step (degs)
+         double* const deltaLon,       // Longitude step (degs)
+         const unsigned int n,         // Number of points
+         const double lat,             // Starting latitude (degs)
+         const double direction,       // True direction (heading) angle of the profile (degs)
+         const double maxRng           // Range to last elevation point (meters)
+      );
+
    // Vertical Beam Width and Shadow Check --
    // Sets an array of mask flags; the flags are set true if the point
    // is masked (in shadow or out of beam) as seen from the reference
@@ -186,6 +227,20 @@ protected:
    virtual bool setLongitudeNE(const double v);    // Northeast corner longitude of this database (degs: +/-180)
 
 private:
+   // Line of sight along a profile (see isProfileOcculted())
+   struct ProfileLos {
+      double lat {};                // Starting latitude (degs)
+      double lon {};                // Starting longitude (degs)
+      double deltaLat {};           // Latitude step (degs)
+      double deltaLon {};           // Longitude step (degs)
+      double deltaRng {};           // Range step (meters)
+      double refAlt {};             // Ref altitude (meters)
+      double tanLookAng {};         // Tangent of the look angle
+   };
+
+   // Checks points [ i0 .. i1 ] of the profile
+   bool isSpanOcculted(const ProfileLos&, const unsigned int i0, const unsigned int i1) const;
+
    virtual bool loadData() =0;      // Load the data file
 
    const base::String* path {};     // Data path name
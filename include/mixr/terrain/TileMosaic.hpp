@@ -0,0 +1,172 @@
+
+#ifndef __mixr_terrain_TileMosaic_HPP__
+#define __mixr_terrain_TileMosaic_HPP__
+
+#include "mixr/terrain/Terrain.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace base { class Boolean; class Identifier; class String; }
+namespace terrain {
+class DataFile;
+
+//------------------------------------------------------------------------------
+// Class: TileMosaic
+// Description: Manages any number of elevation data tiles (DTED, SRTM and DED
+//              files) as one seamless terrain database.
+//
+// Factory name: TileMosaic
+// Slots:
+//    directory   <String>       ! Directory that's scanned for tiles (default: none)
+//
+//    recursive   <Boolean>      ! Scan the directory's subdirectories as well (e.g., the
+//                               ! 'dted/w078/n38.dt1' layout) (default: true)
+//
+//    overlap     <Identifier>   ! How overlapping tiles are prioritized:
+//                               !    finest -- the tile with the finest post spacing first (default)
+//                               !    order  -- the component tiles, in order, then the scanned tiles
+//
+// Notes:
+//    1) The tiles are the mosaic's components (DataFile objects, e.g.,
+//       DtedFile, SrtmHgtFile and DedFile), plus the tiles that are found
+//       by scanning the 'directory' at reset().  The scanned file types are
+//       determined by their extensions: '.dt0', '.dt1' and '.dt2' (DTED),
+//       '.hgt' (SRTM) and '.ded' (DED).  Component tiles that don't set
+//       their own 'path' use the mosaic's 'path'.
+//
+//    2) Each tile is indexed by the one degree lat/lon cells that it covers,
+//       so locating the tiles of a point is a single hash lookup, and a
+//       profile (getElevations()) is sampled point by point across the tile
+//       seams.
+//
+//    3) Where tiles overlap, the elevation is taken from the highest priority
+//       tile (see 'overlap'); a void post falls through to the next tile.
+//
+//    4) Interpolation is seamless: when a point is past the last post of a
+//       tile (e.g., in the gap between two tiles that don't share their
+//       edge posts), the missing corner posts are taken from the neighboring
+//       tiles.
+//------------------------------------------------------------------------------
+class TileMosaic : public Terrain
+{
+   DECLARE_SUBCLASS(TileMosaic, Terrain)
+
+public:
+   enum class Overlap { FINEST, ORDER };
+
+public:
+   TileMosaic();
+
+   unsigned int getNumTiles() const;                     // Number of loaded tiles
+   const DataFile* getTile(const unsigned int i) const;  // i'th tile, in priority order
+
+   const char* getDirectory() const;                     // Scanned directory, or zero if none
+   bool isRecursive() const;                             // Scanning subdirectories?
+   Overlap getOverlap() const;                           // Overlap priority
+
+   virtual bool setDirectory(const std::string&);
+   virtual bool setRecursive(const bool);
+   virtual bool setOverlap(const Overlap);
+
+   // Rescans the directory and rebuilds the tile index
+   virtual bool rescan();
+
+   // ---
+   // Terrain interface
+   // ---
+
+   bool isDataLoaded() const override;
+
+   // Locates an array of (at least two) elevation points (and sets valid flags if found)
+   // returns the number of points found within this TileMosaic
+   unsigned int getElevations(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of elevation and valdFlags arrays
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const double direction,       // True direction (heading) angle of the data (degs)
+         const double maxRng,          // Range to last elevation point (meters)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates an elevation value (meters) for a given reference point and returns
+   // it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+   bool getElevation(
+         double* const elev,           // The elevation value (meters)
+         const double lat,             // Reference latitude (degs)
+         const double lon,             // Reference longitude (degs)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Bounds the elevations of a lat/lon region (using the tiles' bounds)
+   bool getElevationBounds(
+         double* const minElev,        // Min elevation (meters)
+         double* const maxElev,        // Max elevation (meters)
+         const double minLat,          // Southern latitude of the region (degs)
+         const double minLon,          // Western longitude of the region (degs)
+         const double maxLat,          // Northern latitude of the region (degs)
+         const double maxLon           // Eastern longitude of the region (degs)
+      ) const override;
+
+   void reset() override;
+
+protected:
+   virtual void scanDirectory();           // Loads the tiles found in our directory
+   virtual void buildIndex();              // Orders and indexes the tiles
+
+   void clearData() override;
+
+private:
+   // Indexed tile
+   struct Tile {
+      const DataFile* file {};      // The tile's data
+      double swLat {};              // Latitude of the south-west post (degs)
+      double swLon {};              // Longitude of the south-west post (degs)
+      double neLat {};              // Latitude of the north-east post (degs)
+      double neLon {};              // Longitude of the north-east post (degs)
+      double latSpacing {};         // Spacing between latitude points (degs)
+      double lonSpacing {};         // Spacing between longitude points (degs)
+      unsigned int nptlat {};       // Number of points in latitude
+      unsigned int nptlong {};      // Number of points in longitude
+      short voidValue {};           // Void (missing) post value
+   };
+
+   static int cellKey(const int ilat, const int ilon);
+   const std::vector<unsigned int>* findCell(const double lat, const double lon) const;
+
+   bool lookup(double* const elev, const double lat, const double lon, const bool interp) const;
+   bool sample(double* const elev, const Tile&, const double lat, const double lon, const bool interp) const;
+   bool findPost(double* const elev, const double lat, const double lon, const Tile* const skip) const;
+   bool getPost(double* const elev, const Tile&, const unsigned int irow, const unsigned int icol) const;
+
+   void scanPath(const std::string& dir, const unsigned int depth);
+   void clearScannedTiles();
+
+   bool loadData() override;
+
+   std::vector<DataFile*> scanned;                // Tiles loaded from our directory (ref()'d)
+   bool scanDone {};                              // Directory has been scanned
+
+   std::vector<Tile> tiles;                       // Indexed tiles, in priority order (ref()'d)
+   std::unordered_map<int, std::vector<unsigned int>> cells;   // Tiles (indices) covering each one degree cell
+   double maxSpacing {};                          // Largest post spacing of the tiles (degs)
+
+   std::string directory;                         // Directory to scan
+   bool recursive {true};                         // Scan subdirectories
+   Overlap overlap {Overlap::FINEST};             // Overlap priority
+
+private:
+   // slot table helper methods
+   bool setSlotDirectory(const base::String* const);
+   bool setSlotRecursive(const base::Boolean* const);
+   bool setSlotOverlap(const base::Identifier* const);
+};
+
+}
+}
+
+#endif
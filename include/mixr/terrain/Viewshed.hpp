@@ -0,0 +1,186 @@
+
+#ifndef __mixr_terrain_Viewshed_HPP__
+#define __mixr_terrain_Viewshed_HPP__
+
+#include "mixr/base/Component.hpp"
+#include "mixr/base/safe_ptr.hpp"
+
+#include <vector>
+
+namespace mixr {
+namespace base { class Boolean; class Integer; class Length; }
+namespace terrain {
+class Terrain;
+class ViewshedThread;
+
+//------------------------------------------------------------------------------
+// Class: Viewshed
+// Description: Terrain viewshed of a stationary sensor (e.g., a ground radar or
+//              a SAM site); for each azimuth sector around the sensor, and each
+//              range cell out to a max range, bounds of the elevation angle to
+//              the terrain.  Most of the terrain occulting checks of a target
+//              are then table lookups, with the same answers as the terrain's
+//              occulting functions.
+//
+// Factory name: Viewshed
+// Slots:
+//    azimuths    <Integer>   ! Number of azimuth sectors, equally spaced around
+//                            ! the sensor (default: 720; i.e., 0.5 degs)
+//
+//    maxRange    <Length>    ! Max range of the sectors (default: 100 km)
+//
+//    rangeStep   <Length>    ! Range between the sector's cells (default: 100 meters)
+//
+//    tolerance   <Length>    ! Distance (horizontal or vertical) that the sensor can move
+//                            ! before the viewshed is regenerated (default: 10 meters)
+//
+//    background  <Boolean>   ! Generate the viewshed with a background thread (default: true)
+//
+// Notes:
+//    1) The sensor's owner calls update() with the sensor's position (e.g.,
+//       each frame).  The first update(), and any update() with the sensor
+//       more than 'tolerance' from the viewshed's position, starts the
+//       generation of a new viewshed.  While it's being generated in the
+//       background, isReady() is false and the owner should use the
+//       Terrain's occulting functions; it's swapped in by a later update().
+//
+//    2) The table is built from the terrain's elevation bounds (see
+//       Terrain::getElevationBounds()), which cover all of the terrain
+//       within each cell of a sector.  For each sector and cell, it holds
+//       the max tangent of the elevation angle to the terrain out to the
+//       cell, and the greatest min tangent of the windows of cells that start
+//       at or before the cell, where a window is wide enough to hold a point
+//       of any of the profiles that Terrain::targetOcculting() checks.
+//
+//    3) A target is visible if its look angle is above the max tangent of
+//       its sector out to the last point of its profile in front of it.  If
+//       its look angle is at or below a window's min tangent, the profile's
+//       point within the window is checked, and the target is occulted if
+//       that point occults it.  These are the same answers as the terrain's
+//       occulting functions, which check the other targets (i.e., the ones
+//       near the edge of the mask), the targets past 'maxRange', and all of
+//       the targets of a terrain without elevation bounds, using the terrain
+//       of the last update().
+//------------------------------------------------------------------------------
+class Viewshed : public base::Component
+{
+   DECLARE_SUBCLASS(Viewshed, base::Component)
+
+public:
+   Viewshed();
+
+   unsigned int getNumAzimuths() const    { return numAzimuths; }
+   double getMaxRange() const             { return maxRange; }
+   double getRangeStep() const            { return rangeStep; }
+   double getTolerance() const            { return tolerance; }
+   bool isBackground() const              { return background; }
+
+   virtual bool setNumAzimuths(const unsigned int);
+   virtual bool setMaxRange(const double);
+   virtual bool setRangeStep(const double);
+   virtual bool setTolerance(const double);
+   virtual bool setBackground(const bool);
+
+   // Updates the viewshed for the sensor's position; (re)generates the viewshed
+   // if the sensor has moved more than 'tolerance'.  Returns true if the
+   // viewshed is ready for this position (see isReady()).
+   virtual bool update(const Terrain* const terrain, const double lat, const double lon, const double alt);
+
+   // Is the viewshed ready (i.e., generated for the last update()'s position)?
+   bool isReady() const                   { return ready; }
+
+   // Generating a viewshed in the background?
+   bool isGenerating() const;
+
+   // Position of the viewshed's sensor
+   double getLatitude() const             { return table.lat; }
+   double getLongitude() const            { return table.lon; }
+   double getAltitude() const             { return table.alt; }
+
+   // Min visible elevation angle (radians) of a point at 'range' (meters) on
+   // the true bearing 'truBrg' (degs), from the max tangent of its sector,
+   // so it's conservative; returns -PI/2 if nothing is masked, or if the
+   // terrain doesn't have elevation bounds.
+   double getMinVisibleElevation(const double truBrg, const double range) const;
+
+   // Returns true if the target point is occulted (same as Terrain::targetOcculting())
+   bool isTargetOcculted(
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const double tgtAlt           // Target altitude (meters)
+      ) const;
+
+   // Returns true if the look angle is occulted within range 'dist' on the
+   // true bearing 'truBrg' (same as Terrain::targetOcculting2())
+   bool isOcculted(
+         const double truBrg,          // True direction angle from north to look (degs)
+         const double dist,            // Distance to check (meters)
+         const double tanLookAng       // Tangent of the look angle
+      ) const;
+
+   bool shutdownNotification() override;
+
+private:
+   friend class ViewshedThread;
+
+   // Viewshed table
+   struct Table {
+      double lat {};                   // Sensor latitude (degs)
+      double lon {};                   // Sensor longitude (degs)
+      double alt {};                   // Sensor altitude (meters)
+      double rangeStep {};             // Range between cells (meters)
+      unsigned int numAzimuths {};     // Number of azimuth sectors
+      unsigned int numCells {};        // Number of cells per sector
+      unsigned int window {};          // Number of cells per window
+      const Terrain* terrain {};       // Terrain (see Note 3)
+
+      // Indexed [ sector * numCells + cell ]; empty if the terrain doesn't have elevation bounds
+      std::vector<double> maxTan;            // Max tangent to the terrain out to the cell
+      std::vector<float> minTan;             // Greatest min tangent of the windows that start by the cell
+      std::vector<unsigned int> minWindow;   // First cell of that window
+   };
+
+   // Generates the table (called by our thread, or by update())
+   void generate(const Terrain* const terrain, Table* const tbl) const;
+
+   // Index of the table's cell at 'range'
+   unsigned int cellIndex(const double range) const;
+
+   // Index of the azimuth sector of 'truBrg'
+   unsigned int sectorIndex(const double truBrg) const;
+
+   // Checks the look angle against the table (see Note 3); returns false if
+   // the table doesn't decide it
+   bool checkTable(const double truBrg, const double dist, const double tanLookAng, bool* const occulted) const;
+
+   bool isAtTable(const Table&, const double lat, const double lon, const double alt) const;
+
+   Table table;                              // Current viewshed
+   bool ready {};                            // Current viewshed is valid for the last update()
+
+   Table pending;                            // Viewshed being generated by our thread
+   const Terrain* pendingTerrain {};         // Terrain used by the pending viewshed
+   bool pendingBusy {};                      // Pending viewshed is being generated
+   bool pendingDone {};                      // Pending viewshed is complete
+   mutable long semaphore {};                // Semaphore for the 'pending' flags
+   base::safe_ptr<ViewshedThread> thread;    // Background thread
+
+   unsigned int numAzimuths {720};           // Number of azimuth sectors
+   double maxRange {100000.0};               // Max range (meters)
+   double rangeStep {100.0};                 // Range between cells (meters)
+   double tolerance {10.0};                  // Position tolerance (meters)
+   bool background {true};                   // Generate in the background
+
+private:
+   // slot table helper methods
+   bool setSlotNumAzimuths(const base::Integer* const);
+   bool setSlotMaxRange(const base::Length* const);
+   bool setSlotRangeStep(const base::Length* const);
+   bool setSlotTolerance(const base::Length* const);
+   bool setSlotBackground(const base::Boolean* const);
+};
+
+}
+}
+
+#endif
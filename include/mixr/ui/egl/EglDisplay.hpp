@@ -0,0 +1,108 @@
+
+#ifndef __mixr_ui_egl_EglDisplay_HPP__
+#define __mixr_ui_egl_EglDisplay_HPP__
+
+#include "mixr/graphics/Display.hpp"
+
+namespace mixr {
+namespace base { class Boolean; }
+namespace egl {
+
+//------------------------------------------------------------------------------
+// Class:  EglDisplay
+//
+// Description: Manages the Display as an offscreen (headless) EGL pbuffer
+//              surface; used to render pages without a window system (e.g.,
+//              golden image tests and render benchmarks; see RenderHarness).
+//
+// Notes:
+//    1) The surface is created by createWindow() with the display's viewport
+//    size (see graphics::Display slots 'vpWidth' and 'vpHeight'), and its size
+//    is fixed.  The surface's width is rounded up to a multiple of four, which
+//    is the row alignment of graphics::Display::readFrameBuffer().
+//
+//    2) The EGL display is Mesa's 'surfaceless' platform, if it's available,
+//    otherwise the default EGL display.  The context is a desktop OpenGL
+//    (compatibility profile) context, or an OpenGL 3.3 core profile context
+//    with 'coreProfile' set, which draws only through the display's vertex
+//    buffers (see graphics::Renderer); with Mesa, the software renderer
+//    (llvmpipe) is used when there's no GPU (e.g., LIBGL_ALWAYS_SOFTWARE=1).
+//
+//    3) Subdisplays (see our base class 'displays' slot) are not supported.
+//
+//    4) renderFrame() runs one frame of the normal display cycle: updateTC(),
+//    updateData() and drawIt().  The swapBuffers() function waits for the
+//    rendering to complete (i.e., glFinish()), so the time of drawIt() is the
+//    time to render the frame.
+//
+//    5) The EGL display is terminated by destroySurface() when the last of our
+//    instances using it releases its surface; eglTerminate() isn't reference
+//    counted, so our instances share one count per EGL display.
+//
+// Factory name: EglDisplay
+// Slots:
+//    stencilBuff    <Boolean>   ! Enable the stencil buffer (default: false)
+//    coreProfile    <Boolean>   ! Create an OpenGL 3.3 core profile context (default: false)
+//
+//------------------------------------------------------------------------------
+class EglDisplay : public graphics::Display
+{
+   DECLARE_SUBCLASS(EglDisplay, graphics::Display)
+
+public:
+   EglDisplay();
+
+   // Creates the offscreen surface and the context; returns true if successful
+   virtual bool createWindow();
+
+   // Has the surface been created?
+   bool isCreated() const;
+
+   // Is stencil buffer enabled?
+   bool isStencilBuff() const;
+
+   // Is the context a core profile context? (see note #2)
+   bool isCoreProfile() const;
+
+   // Surface size (pixels)
+   int getSurfaceWidth() const;
+   int getSurfaceHeight() const;
+
+   // Runs one frame of the display cycle (see note #4)
+   virtual void renderFrame(const double dt);
+
+   // Writes the current frame to a bitmap (BMP) file; returns true if successful
+   virtual bool writeFrame(const char* const filename, const char* const path = nullptr);
+
+   void select() override;                       // Selects this display.
+   void swapBuffers() override;
+
+   bool shutdownNotification() override;
+
+private:
+   void destroySurface();
+
+   void* eglDpy {};                    // EGL display (EGLDisplay)
+   void* surface {};                   // Pbuffer surface (EGLSurface)
+   void* context {};                   // Context (EGLContext)
+   int surfaceWidth {};                // Surface width (pixels)
+   int surfaceHeight {};               // Surface height (pixels)
+   bool stencilBuff {};                // Stencil buffer enabled
+   bool coreProfile {};                // Core profile context
+
+private:
+   // slot table helper methods
+   bool setSlotStencilBuff(const base::Boolean* const);
+   bool setSlotCoreProfile(const base::Boolean* const);
+};
+
+inline bool EglDisplay::isCreated() const                { return context != nullptr; }
+inline bool EglDisplay::isStencilBuff() const            { return stencilBuff;        }
+inline bool EglDisplay::isCoreProfile() const            { return coreProfile;        }
+inline int EglDisplay::getSurfaceWidth() const           { return surfaceWidth;       }
+inline int EglDisplay::getSurfaceHeight() const          { return surfaceHeight;      }
+
+}
+}
+
+#endif
@@ -0,0 +1,132 @@
+
+#ifndef __mixr_ui_egl_RenderHarness_HPP__
+#define __mixr_ui_egl_RenderHarness_HPP__
+
+#include "mixr/base/Component.hpp"
+
+#include <string>
+#include <vector>
+
+namespace mixr {
+namespace base { class Boolean; class Integer; class Number; class PairStream; class String; }
+namespace graphics { class Image; }
+namespace egl {
+class EglDisplay;
+
+//------------------------------------------------------------------------------
+// Class:  RenderHarness
+//
+// Description: Renders pages on an offscreen display (EglDisplay), compares
+//              the frames against golden images, and reports the draw time
+//              of each page.
+//
+//    For each page, run() selects the page (i.e., a subpage of the display),
+//    runs the warm up frames and then the timed frames (see
+//    EglDisplay::renderFrame()), and compares the last frame against the
+//    page's golden image, "<goldenPath>/<page>.bmp".  A pixel is bad if any
+//    of its color components differs from the golden image's by more than
+//    'tolerance', and the page fails if the ratio of bad pixels to all pixels
+//    is greater than 'maxBadPixels'.  The frame is written to
+//    "<outputPath>/<page>.bmp", if the output path is set.
+//
+//    With 'updateGolden' set, the frames are written as the new golden images
+//    and nothing is compared.
+//
+//    The display is reset by our reset(), so the harness is reset before
+//    run(), as an application resets its station.
+//
+// Factory name: RenderHarness
+// Slots:
+//    display        <EglDisplay>   ! Offscreen display (required)
+//    pages          <PairStream>   ! Names of the display's subpages (Identifier or
+//                                  ! String); if none, the display's current page
+//                                  ! is rendered as page "display" (default: none)
+//    frames         <Integer>      ! Number of timed frames per page (default: 10)
+//    warmupFrames   <Integer>      ! Number of frames before the timed frames (default: 2)
+//    frameRate      <Number>       ! Frame rate (Hz) of the display cycle; i.e., the
+//                                  ! 'dt' of renderFrame() (default: 20)
+//    goldenPath     <String>       ! Directory of the golden images (default: none)
+//    outputPath     <String>       ! Directory of the rendered frames (default: none)
+//    tolerance      <Integer>      ! Max difference of a color component [ 0 .. 255 ] (default: 2)
+//    maxBadPixels   <Number>       ! Max ratio of bad pixels [ 0 .. 1 ] (default: 0.001)
+//    updateGolden   <Boolean>      ! Write the golden images (default: false)
+//
+// Example:
+//
+//    ( RenderHarness
+//       display: ( EglDisplay vpWidth: 640 vpHeight: 480 ... pages: { ... } )
+//       pages: { pfd hsi map }
+//       frames: 50
+//       goldenPath: "golden"
+//       outputPath: "frames"
+//    )
+//
+//------------------------------------------------------------------------------
+class RenderHarness : public base::Component
+{
+   DECLARE_SUBCLASS(RenderHarness, base::Component)
+
+public:
+   // Results of a page
+   struct Result {
+      std::string page;             // Page name
+      double avgTime {};            // Average draw time (seconds)
+      double minTime {};            // Min draw time (seconds)
+      double maxTime {};            // Max draw time (seconds)
+      unsigned int badPixels {};    // Number of bad pixels
+      unsigned int numPixels {};    // Number of pixels
+      bool compared {};             // Compared against a golden image
+      bool passed {};               // Passed the comparison (or not compared)
+   };
+
+public:
+   RenderHarness();
+
+   EglDisplay* getDisplay()                        { return display; }
+   const std::vector<Result>& getResults() const   { return results; }
+
+   // Renders the pages; returns the number of pages that failed (or couldn't be rendered)
+   virtual unsigned int run();
+
+   void reset() override;
+   bool shutdownNotification() override;
+
+protected:
+   // Renders one page and sets its result; returns true if it passed
+   virtual bool runPage(const std::string& page, const bool select, Result* const result);
+
+   // Compares the frame against the golden image; returns the number of bad pixels
+   unsigned int compareImages(const graphics::Image* const frame, const graphics::Image* const golden) const;
+
+private:
+   EglDisplay* display {};                // Offscreen display
+   std::vector<std::string> pages;        // Page names
+   unsigned int frames {10};              // Timed frames per page
+   unsigned int warmupFrames {2};         // Frames before the timed frames
+   double frameRate {20.0};               // Frame rate (Hz)
+   std::string goldenPath;                // Golden image directory
+   std::string outputPath;                // Rendered frame directory
+   unsigned int tolerance {2};            // Max color component difference
+   double maxBadPixels {0.001};           // Max ratio of bad pixels
+   bool updateGolden {};                  // Write the golden images
+
+   std::vector<Result> results;           // Results of the last run()
+
+private:
+   // slot table helper methods
+   bool setSlotDisplay(EglDisplay* const);
+   bool setSlotPages(const base::PairStream* const);
+   bool setSlotFrames(const base::Integer* const);
+   bool setSlotWarmupFrames(const base::Integer* const);
+   bool setSlotFrameRate(const base::Number* const);
+   bool setSlotGoldenPath(const base::String* const);
+   bool setSlotOutputPath(const base::String* const);
+   bool setSlotTolerance(const base::Integer* const);
+   bool setSlotMaxBadPixels(const base::Number* const);
+   bool setSlotUpdateGolden(const base::Boolean* const);
+};
+
+}
+}
+
+#endif
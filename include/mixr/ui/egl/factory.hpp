@@ -0,0 +1,14 @@
+
+#ifndef __mixr_ui_egl_factory_HPP__
+#define __mixr_ui_egl_factory_HPP__
+
+#include <string>
+
+namespace mixr {
+namespace base { class Object; }
+namespace egl {
+base::Object* factory(const std::string&);
+}
+}
+
+#endif
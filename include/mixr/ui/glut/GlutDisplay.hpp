@@ -32,6 +32,13 @@ namespace glut {
 //    used whenever the main window is reshaped with subwindow reshaping (resizeSubwindows)
 //    enabled.  They can be changed and the subwindow reshaped using reshapeSubWindow().
 //
+//    5) By default, pick() only draws, in OpenGL's GL_SELECT mode, the selectable graphics
+//    whose screen space bounds, from the last frame that was drawn, are near the pick box
+//    (see graphics::PickIndex), and doesn't draw at all when there are none, so it selects
+//    the same graphic as drawing the whole display would.  With the 'selectBufferPick'
+//    slot true, or when the frame was drawn through vertex buffers, it draws the whole
+//    display in GL_SELECT mode.
+//
 // Factory name: GlutDisplay
 // Slots:
 //    fullScreen        <Boolean>   ! Flag to set full screen mode  -- Main windows only -- (default: false)
@@ -41,6 +48,7 @@ namespace glut {
 //    pickHeight        <Number>    ! Height of the pick area in screen coordinates(default: 10)
 //    accumBuff         <Boolean>   ! Enable the accumulation buffer (default: false)
 //    stencilBuff       <Boolean>   ! Enable the stencil buffer (default: false)
+//    selectBufferPick  <Boolean>   ! Always pick by drawing the whole display in GL_SELECT mode; see note #5 (default: false)
 //
 // Events:
 //    ESC_KEY     -- calls onEscKey() event handler; see note #2.
@@ -78,6 +86,9 @@ public:
    // Gets Height of the pick area in screen coordinates
    GLdouble getPickHeight() const;
 
+   // Is pick() always using the GL_SELECT select buffer?
+   bool isSelectBufferPick() const;
+
    // Gets/sets the idle sleep time in milliseconds.  This is used by
    // the idle time callback, idleCB(), to release the CPU.
    int getIdleSleepTime() const;
@@ -155,6 +166,7 @@ private:
    bool stencilBuff {};                // Stencil buffer enabled
    GLdouble pickWidth {10.0};          // Width of the pick area
    GLdouble pickHeight {10.0};         // Height of the pick area
+   bool selectBufferPick {};           // Always pick by drawing the whole display
    bool okToResize {};                 // Ok to resize our subwindows (main windows only)
 
    // main window only data
@@ -181,6 +193,7 @@ private:
    bool setSlotPickHeight(const base::Number* const);
    bool setSlotAccumBuff(const base::Boolean* const);
    bool setSlotStencilBuff(const base::Boolean* const);
+   bool setSlotSelectBufferPick(const base::Boolean* const);
 };
 
 inline int GlutDisplay::getWindowId() const                               { return winId;           }
@@ -188,6 +201,7 @@ inline bool GlutDisplay::isWindowId(const int id) const                   { retu
 inline bool GlutDisplay::isFullScreen() const                             { return fullScreenFlg;   }
 inline GLdouble GlutDisplay::getPickWidth() const                         { return pickWidth;       }
 inline GLdouble GlutDisplay::getPickHeight() const                        { return pickHeight;      }
+inline bool GlutDisplay::isSelectBufferPick() const                       { return selectBufferPick; }
 inline bool GlutDisplay::isAccumBuff() const                              { return accumBuff;       }
 inline bool GlutDisplay::isStencilBuff() const                            { return stencilBuff;     }
 inline int GlutDisplay::getIdleSleepTime() const                          { return idleSleepTimeMS; }
@@ -1,4 +1,11 @@
 
+#if !defined(WIN32)
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+
 #include "mixr/base/FileReader.hpp"
 
 #include "mixr/base/String.hpp"
@@ -6,6 +13,7 @@
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <iostream>
@@ -38,6 +46,7 @@ void FileReader::copyData(const FileReader& org, const bool)
 
    // Close the old file (we'll need to open() the new one)
    if (dbf != nullptr) dbf->close();
+   unmapFile();
 
    pathname = org.pathname;
    filename = org.filename;
@@ -56,6 +65,7 @@ void FileReader::deleteData()
       delete dbf;
       dbf = nullptr;
    }
+   unmapFile();
 
    // Delete the record buffer
    if (rec != nullptr) {
@@ -150,11 +160,64 @@ bool FileReader::open()
    dbf->open(file);
    dbf->clear();
 
+   // and try to map it
+   unmapFile();
+   if (dbf->is_open()) mapFile(file);
+
    rnum = 1;
    crnum = -1;
    return (dbf->is_open());
 }
 
+//------------------------------------------------------------------------------
+// mapFile() -- memory-maps the file (read only); returns true if mapped
+// unmapFile() -- unmaps the file
+//------------------------------------------------------------------------------
+bool FileReader::mapFile(const std::string& file)
+{
+#if !defined(WIN32)
+   const int fd{::open(file.c_str(), O_RDONLY)};
+   if (fd >= 0) {
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+         void* p{::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0)};
+         if (p != MAP_FAILED) {
+            map = static_cast<const char*>(p);
+            mapSize = static_cast<std::size_t>(st.st_size);
+         }
+      }
+      // the mapping stays valid after the file is closed
+      ::close(fd);
+   }
+#endif
+   return (map != nullptr);
+}
+
+void FileReader::unmapFile()
+{
+#if !defined(WIN32)
+   if (map != nullptr) {
+      ::munmap(const_cast<char*>(map), mapSize);
+   }
+#endif
+   map = nullptr;
+   mapSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// getRecordData() -- pointer to record 'n' within the mapped file
+//------------------------------------------------------------------------------
+const char* FileReader::getRecordData(const int n, const int ll) const
+{
+   const char* p{};
+   const int len{(ll == 0) ? rlen : ll};
+   if (map != nullptr && n >= 1 && rlen > 0 && len > 0) {
+      const std::size_t offset{static_cast<std::size_t>(rlen) * static_cast<std::size_t>(n - 1)};
+      if (offset + static_cast<std::size_t>(len) <= mapSize) p = map + offset;
+   }
+   return p;
+}
+
 const char* FileReader::getRecord(const int nn, const int ll)
 {
    // return nothing if we're not ready (e.g., the record length has not been set)
@@ -169,9 +232,15 @@ const char* FileReader::getRecord(const int nn, const int ll)
    int len{ll};
    if (len == 0) len = rlen;
 
-   // Read the record
+   // Read the record (copy it from the mapped file, if we have one)
    bool ok{};
-   if (!dbf->seekg(rlen*(n-1), std::ios::beg).eof()) {
+   if (map != nullptr) {
+      const char* p{getRecordData(n, len)};
+      if (p != nullptr) {
+         std::memcpy(rec, p, len);
+         ok = true;
+      }
+   } else if (!dbf->seekg(rlen*(n-1), std::ios::beg).eof()) {
       dbf->read(rec, len);
       if (!dbf->eof() && !dbf->fail()) ok = true;
    }
@@ -39,15 +39,18 @@ bool AbstractThread::start(const double _priority)
       ok = false;
    }
 
-   // Create the thread
-   if (ok) ok = createThread();
+   // Create the thread; clear the terminated flag first, because the
+   // thread can run (and finish) before createThread() returns
+   if (ok) {
+      killed = false;
+      ok = createThread();
+   }
 
    if (!ok) {
       std::cerr << "AbstractThread(" << this << ")::start() -- ERROR: Did NOT create the thread!" << std::endl;
+      killed = true;
    }
 
-   killed = !ok;
-
    return ok;
 }
 
@@ -13,6 +13,42 @@
 namespace mixr {
 namespace dafif {
 
+//------------------------------------------------------------------------------
+// Range query filters
+//------------------------------------------------------------------------------
+
+// select the 'type' airports with a runway of at least 'minRwLen'
+struct AirportLoader::AirportFilter : public Database::RangeFilter {
+   AirportFilter(const AirportLoader* const p, const Airport::Type t, const float len) : loader(p), type(t), minRwLen(len) {}
+   bool accept(const Key* const k) const override {
+      const auto apk = static_cast<const AirportKey*>(k);
+      return (type == apk->type || type == Airport::Type::ANY) && loader->chkRwLen(apk, minRwLen) != 0;
+   }
+   const AirportLoader* loader {};
+   Airport::Type type {Airport::Type::ANY};
+   float minRwLen {};
+};
+
+// select the airports with a 'freq' ILS component
+struct AirportLoader::FreqFilter : public Database::RangeFilter {
+   FreqFilter(const AirportLoader* const p, const float f) : loader(p), freq(f) {}
+   bool accept(const Key* const k) const override {
+      return loader->chkIlsFreq(static_cast<const AirportKey*>(k), freq) != 0;
+   }
+   const AirportLoader* loader {};
+   float freq {};
+};
+
+// select the airports with a 'chan' ILS component
+struct AirportLoader::ChanFilter : public Database::RangeFilter {
+   ChanFilter(const AirportLoader* const p, const int c) : loader(p), chan(c) {}
+   bool accept(const Key* const k) const override {
+      return loader->chkIlsChan(static_cast<const AirportKey*>(k), chan) != 0;
+   }
+   const AirportLoader* loader {};
+   int chan {};
+};
+
 IMPLEMENT_SUBCLASS(AirportLoader, "AirportLoader")
 EMPTY_SLOTTABLE(AirportLoader)
 EMPTY_DELETEDATA(AirportLoader)
@@ -97,6 +133,9 @@ bool AirportLoader::loadImpl(const std::string& country)
       ql = new Key*[nrl];
    }
 
+   // create the spatial index for the range queries
+   createRangeIndex();
+
 
    // ---
    // Next look for runway records
@@ -468,6 +507,7 @@ int AirportLoader::getMaxRecordsImpl()
 // getAirport() -- get airport record from the last query: 0 ... numberFound()-1
 // getRunway() -- get a runway record from the last query: 0 ... numberFound()-1
 // getIls() -- get an ILS record from the last query: 0 ... numberFound()-1
+// getAirport(results,n) -- get airport record found by a find function
 //------------------------------------------------------------------------------
 Airport* AirportLoader::airport(const int n)
 {
@@ -519,6 +559,19 @@ Ils* AirportLoader::getIls(const int n)
    return ils;
 }
 
+Airport* AirportLoader::getAirport(const Results& results, const int n) const
+{
+   Airport* ap = nullptr;
+   const std::string s = results.getRecord(n);
+   if (!s.empty()) {
+      if ( Record::dsAtoln( &s[FORMAT_CODE_POS-1], FORMAT_CODE_LEN ) == 1 ) {
+         // when we have an airport record
+         ap = new Airport(s);
+      }
+   }
+   return ap;
+}
+
 
 //------------------------------------------------------------------------------
 // queryByRange() -- find all airports within search area.
@@ -553,6 +606,27 @@ int AirportLoader::queryByKeyImpl(const char* subkey)
 }
 
 
+//------------------------------------------------------------------------------
+// findByIdent() -- find airport(s) by identifier (same as key; thread-safe)
+// findByKey() -- find a airport by the airport record key (thread-safe)
+//------------------------------------------------------------------------------
+int AirportLoader::findByIdentImpl(Results* const results, const char* id) const
+{
+   return findByKey(results, id);
+}
+
+int AirportLoader::findByKeyImpl(Results* const results, const char* subkey) const
+{
+   char apKey[AP_KEY_LEN+1];
+   base::utStrncpy(apKey,AP_KEY_LEN+1,subkey,AP_KEY_LEN);
+   apKey[AP_KEY_LEN] = '\0';
+
+   AirportKey key(apKey);
+   Key* pkey = &key;
+   return Database::sFind(results, &pkey, rl, nrl, kl_cmp);
+}
+
+
 //------------------------------------------------------------------------------
 // queryByLength() -- find all airports within search area with minimum
 // runway length.
@@ -578,29 +652,15 @@ int AirportLoader::queryByType(const Airport::Type type)
 //------------------------------------------------------------------------------
 int AirportLoader::queryByFreq(const float freq)
 {
-   double mr2(std::numeric_limits<float>::max());   // DDH? why float?
-   if (mrng > 0.0f) mr2 = mrng*mrng;
-
-   // compute range**2 to ref point and select all that have range less
-   // than maxRange
-   nql = 0;
-   for (int i = 0; i < nrl; i++) {
-      Key* k = rl[i];
-      k->rng2 = range2(k->lat,k->lon);
-      if (k->rng2 < mr2) {
-         if ( chkIlsFreq(static_cast<AirportKey*>(k), freq ) ) {
-            ql[nql++] = k;
-         }
-      }
-   }
-
-   // sort and limit by range
-   rangeSort2();
-
-   // limit number of result records
-   if (qlimit > 0 && nql > qlimit) nql = qlimit;
+   // find the nearest within the search area, sorted by range
+   const FreqFilter filter(this, freq);
+   return rangeQuery(&filter);
+}
 
-   return nql;
+int AirportLoader::findByFreq(Results* const results, const float freq) const
+{
+   const FreqFilter filter(this, freq);
+   return rangeFind(results, &filter);
 }
 
 
@@ -610,29 +670,15 @@ int AirportLoader::queryByFreq(const float freq)
 //------------------------------------------------------------------------------
 int AirportLoader::queryByChannel(const int chan)
 {
-   double mr2(std::numeric_limits<float>::max());   // DDH?
-   if (mrng > 0.0f) mr2 = mrng*mrng;
-
-   // compute range**2 to ref point and select all that have range less
-   // than maxRange
-   nql = 0;
-   for (int i = 0; i < nrl; i++) {
-      Key* k = rl[i];
-      k->rng2 = range2(k->lat,k->lon);
-      if (k->rng2 < mr2) {
-         if ( chkIlsChan(static_cast<AirportKey*>(k), chan ) ) {
-            ql[nql++] = k;
-         }
-      }
-   }
-
-   // sort and limit by range
-   rangeSort2();
-
-   // limit number of result records
-   if (qlimit > 0 && nql > qlimit) nql = qlimit;
+   // find the nearest within the search area, sorted by range
+   const ChanFilter filter(this, chan);
+   return rangeQuery(&filter);
+}
 
-   return nql;
+int AirportLoader::findByChannel(Results* const results, const int chan) const
+{
+   const ChanFilter filter(this, chan);
+   return rangeFind(results, &filter);
 }
 
 
@@ -642,31 +688,29 @@ int AirportLoader::queryByChannel(const int chan)
 //------------------------------------------------------------------------------
 int AirportLoader::queryAirport(const Airport::Type type, const float minRwLen)
 {
-   double mr2(std::numeric_limits<float>::max());  // DDH?
-   if (mrng > 0.0f) mr2 = mrng*mrng;
-
-   // compute range**2 to ref point and select all that have range less
-   // than maxRange
-   nql = 0;
-   for (int i = 0; i < nrl; i++) {
-      const auto k = static_cast<AirportKey*>(rl[i]);
-      if ( type == k->type || type == Airport::Type::ANY ) {
-         k->rng2 = range2(k->lat,k->lon);
-         if (k->rng2 < mr2) {
-            if ( chkRwLen( k, minRwLen ) ) {
-               ql[nql++] = k;
-            }
-         }
-      }
-   }
+   // find the nearest within the search area, sorted by range
+   const AirportFilter filter(this, type, minRwLen);
+   return rangeQuery(&filter);
+}
 
-   // sort and limit by range
-   rangeSort2();
+//------------------------------------------------------------------------------
+// findByLength(), findByType() and findAirport() -- thread-safe versions of
+// queryByLength(), queryByType() and queryAirport()
+//------------------------------------------------------------------------------
+int AirportLoader::findByLength(Results* const results, const float minRwLen) const
+{
+   return findAirport(results, Airport::Type::ANY, minRwLen);
+}
 
-   // limit number of result records
-   if (qlimit > 0 && nql > qlimit) nql = qlimit;
+int AirportLoader::findByType(Results* const results, const Airport::Type type) const
+{
+   return findAirport(results, type, 0.0f);
+}
 
-   return nql;
+int AirportLoader::findAirport(Results* const results, const Airport::Type type, const float minRwLen) const
+{
+   const AirportFilter filter(this, type, minRwLen);
+   return rangeFind(results, &filter);
 }
 
 
@@ -1171,7 +1215,7 @@ int AirportLoader::kl_cmp(const void* p1, const void* p2)
 //------------------------------------------------------------------------------
 // chkRwLen() -- checks if the airport has a runway of at least minRwLen.
 //------------------------------------------------------------------------------
-int AirportLoader::chkRwLen(const AirportKey* key, const float minRwLen)
+int AirportLoader::chkRwLen(const AirportKey* key, const float minRwLen) const
 {
    if (minRwLen <= 0) return true;
    for (const RunwayKey* rwk = key->runways; rwk != nullptr; rwk = rwk->next) {
@@ -1185,7 +1229,7 @@ int AirportLoader::chkRwLen(const AirportKey* key, const float minRwLen)
 // chkRwIlsFreq() -- checks if the runway has an ILS component with 'freq'
 // chkIlsFreq() -- checks if the airport has an ILS component with 'freq'
 //------------------------------------------------------------------------------
-int AirportLoader::chkRwIlsFreq(const RunwayKey* rwk, const float freq)
+int AirportLoader::chkRwIlsFreq(const RunwayKey* rwk, const float freq) const
 {
    if (freq <= 0.0f || rwk == nullptr) return 0;
    for (const IlsKey* ilsk = rwk->ils; ilsk != nullptr; ilsk = ilsk->next) {
@@ -1194,7 +1238,7 @@ int AirportLoader::chkRwIlsFreq(const RunwayKey* rwk, const float freq)
    return 0;
 }
 
-int AirportLoader::chkIlsFreq(const AirportKey* apk, const float freq)
+int AirportLoader::chkIlsFreq(const AirportKey* apk, const float freq) const
 {
    if (freq <= 0.0f || apk == nullptr) return true;
    for (const RunwayKey* rwk = apk->runways; rwk != nullptr; rwk = rwk->next) {
@@ -1208,7 +1252,7 @@ int AirportLoader::chkIlsFreq(const AirportKey* apk, const float freq)
 // chkRwIlsChan() -- checks if the runway has an ILS component with 'chan'
 // chkIlsChan() -- checks if the airport has an ILS component with 'chan'
 //------------------------------------------------------------------------------
-int AirportLoader::chkRwIlsChan(const RunwayKey* rwk, const int chan)
+int AirportLoader::chkRwIlsChan(const RunwayKey* rwk, const int chan) const
 {
    if (chan <= 0 || rwk == nullptr) return 0;
    for (const IlsKey* ilsk = rwk->ils; ilsk != nullptr; ilsk = ilsk->next) {
@@ -1217,7 +1261,7 @@ int AirportLoader::chkRwIlsChan(const RunwayKey* rwk, const int chan)
    return 0;
 }
 
-int AirportLoader::chkIlsChan(const AirportKey* apk, const int chan)
+int AirportLoader::chkIlsChan(const AirportKey* apk, const int chan) const
 {
    if (chan <= 0 || apk == nullptr) return true;
    for (const RunwayKey* rwk = apk->runways; rwk != nullptr; rwk = rwk->next) {
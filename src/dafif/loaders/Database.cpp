@@ -7,10 +7,13 @@
 #include "mixr/base/String.hpp"
 #include "mixr/base/units/util/angle_utils.hpp"
 #include "mixr/base/units/lengths.hpp"
+#include "mixr/base/util/atomics.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 
 namespace mixr {
 namespace dafif {
@@ -27,6 +30,8 @@ BEGIN_SLOT_MAP(Database)
     ON_SLOT(2, setSlotFilename, base::String)
 END_SLOT_MAP()
 
+const double Database::FIRST_RADIUS{60.0};
+
 Database::Database()
 {
    STANDARD_CONSTRUCTOR()
@@ -57,6 +62,10 @@ void Database::copyData(const Database& org, const bool cc)
    mrng = 0.0;
    dbInUse = false;
    dbLoaded = false;
+
+   cellStart.clear();
+   cellRecs.clear();
+   qcand.clear();
 }
 
 void Database::deleteData()
@@ -264,6 +273,46 @@ void Database::createIcaoList()
    }
 }
 
+//------------------------------------------------------------------------------
+// createRangeIndex() -- creates the spatial index of the record list; the
+// record positions in each cell are in record list order.
+//------------------------------------------------------------------------------
+void Database::createRangeIndex()
+{
+   const int ncells{CELL_LAT * CELL_LON};
+   cellStart.assign(ncells + 1, 0);
+   cellRecs.resize(nrl);
+
+   // count the records in each cell ...
+   std::vector<int> cells(nrl);
+   for (int i = 0; i < nrl; i++) {
+      cells[i] = cellLat(rl[i]->lat) * CELL_LON + cellLon(rl[i]->lon);
+      cellStart[cells[i] + 1]++;
+   }
+   for (int c = 0; c < ncells; c++) {
+      cellStart[c + 1] += cellStart[c];
+   }
+
+   // ... and fill the cells
+   std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+   for (int i = 0; i < nrl; i++) {
+      cellRecs[next[cells[i]]++] = i;
+   }
+}
+
+// cell index of a latitude or longitude (clamped to the grid)
+int Database::cellLat(const double lat)
+{
+   const int i{static_cast<int>(std::floor(lat + 90.0))};
+   return std::min(std::max(i, 0), CELL_LAT - 1);
+}
+
+int Database::cellLon(const double lon)
+{
+   const int i{static_cast<int>(std::floor(lon + 180.0))};
+   return std::min(std::max(i, 0), CELL_LON - 1);
+}
+
 //------------------------------------------------------------------------------
 // Set slot functions
 //------------------------------------------------------------------------------
@@ -353,6 +402,23 @@ int Database::queryByIcao(const char* code)
 void Database::expandResults(Key** key, Key** keyPtr,
                                     int (*cmp)(const void*, const void*),
                                     Key** base, std::size_t n)
+{
+   Key** b{};
+   Key** t{};
+   expandMatch(key, keyPtr, cmp, base, n, &b, &t);
+
+   // move the results to ql
+   nql = 0;
+   for (Key** p = b; p <= t; p++) {
+      ql[nql++] = *p;
+   }
+}
+
+// expandMatch() -- finds the set of records that match 'key' around 'keyPtr'
+void Database::expandMatch(Key** key, Key** keyPtr,
+                                    int (*cmp)(const void*, const void*),
+                                    Key** base, std::size_t n,
+                                    Key*** const first, Key*** const last)
 {
    // Look for the bottom end
    Key** b{keyPtr - 1};
@@ -373,11 +439,249 @@ void Database::expandResults(Key** key, Key** keyPtr,
    }
    --t;
 
-   // move the results to ql
+   *first = b;
+   *last = t;
+}
+
+
+//------------------------------------------------------------------------------
+// thread-safe find functions --- (see note #4)
+//------------------------------------------------------------------------------
+
+// find all records within the search area
+int Database::findByRange(Results* const results) const
+{
+   return rangeFind(results);
+}
+
+// find all records within the search area with ICAO code
+int Database::findByIcao(Results* const results, const char* code) const
+{
+   Key key(code);
+   Key* pkey{&key};
+   return mFind(results, &pkey, static_cast<Key**>(ol), nol, ol_cmp);
+}
+
+// Single find -- thread-safe version of sQuery()
+int Database::sFind(Results* const results, Key** key, Key** base,
+                            std::size_t n, int (*cmp)(const void*, const void*)) const
+{
+   results->db = this;
+   results->found.clear();
+   if (n != 0) {
+      Key** k{static_cast<Key**>(bsearch(key, base, n, sizeof(Key*), cmp))};
+      if (k != nullptr) {
+         Results::Found f;
+         f.key = *k;
+         f.rng2 = results->range2((*k)->lat, (*k)->lon);
+         results->found.push_back(f);
+      }
+   }
+   return results->numberFound();
+}
+
+// Multi-find -- thread-safe version of mQuery()
+int Database::mFind(Results* const results, Key** key, Key** base,
+                            std::size_t n, int (*cmp)(const void*, const void*)) const
+{
+   results->db = this;
+   results->found.clear();
+
+   // search the record list for matches and compute their range
+   if (n != 0) {
+      Key** k{static_cast<Key**>(bsearch(key, base, n, sizeof(Key*), cmp))};
+      if (k != nullptr) {
+         Key** b{};
+         Key** t{};
+         expandMatch(key, k, cmp, base, n, &b, &t);
+         for (Key** p = b; p <= t; p++) {
+            Results::Found f;
+            f.key = *p;
+            f.rng2 = results->range2((*p)->lat, (*p)->lon);
+            results->found.push_back(f);
+         }
+      }
+   }
+
+   // sort by range from ref point (same as rangeSort())
+   std::vector<Results::Found>& found{results->found};
+   if (found.size() > 1) {
+      std::stable_sort(found.begin(), found.end(),
+         [](const Results::Found& f1, const Results::Found& f2) { return f1.rng2 < f2.rng2; });
+
+      // reject records with a range greater than mrng
+      if (results->mrng > 0.0f) {
+         const double mr2{results->mrng * results->mrng};
+         while (!found.empty() && found.back().rng2 > mr2) found.pop_back();
+      }
+   }
+
+   // limit results
+   if (results->qlimit > 0 && results->numberFound() > results->qlimit) found.resize(results->qlimit);
+
+   return results->numberFound();
+}
+
+//------------------------------------------------------------------------------
+// readRecord() -- returns a copy of the key's record (thread-safe)
+//------------------------------------------------------------------------------
+std::string Database::readRecord(const Key* const key, const int size) const
+{
+   std::string s;
+   if (key != nullptr) {
+      const int ssize{(size != 0) ? size : key->size};
+      const char* p{db->getRecordData(key->idx, ssize)};
+      if (p != nullptr) {
+         s.assign(p, ssize);
+      } else if (!db->isMapped()) {
+         // not mapped, so share the file reader
+         base::lock(readSemaphore);
+         p = db->getRecord(key->idx, ssize);
+         if (p != nullptr) s.assign(p, ssize);
+         base::unlock(readSemaphore);
+      }
+   }
+   return s;
+}
+
+
+//------------------------------------------------------------------------------
+// rangeQuery() -- range query using the spatial index
+//------------------------------------------------------------------------------
+int Database::rangeQuery(const RangeFilter* const filter)
+{
    nql = 0;
-   for (Key** p = b; p <= t; p++) {
-      ql[nql++] = *p;
+   if (nrl == 0 || ql == nullptr) return nql;
+
+   // our search area
+   Results area(refLat, refLon, mrng, qlimit);
+   rangeSearch(area, filter, &qcand);
+
+   for (std::size_t i = 0; i < qcand.size(); i++) {
+      Key* k{rl[qcand[i].second]};
+      k->rng2 = qcand[i].first;
+      ql[nql++] = k;
+   }
+
+   return nql;
+}
+
+//------------------------------------------------------------------------------
+// rangeFind() -- range find using the spatial index (thread-safe)
+//------------------------------------------------------------------------------
+int Database::rangeFind(Results* const results, const RangeFilter* const filter) const
+{
+   results->db = this;
+   results->found.clear();
+
+   std::vector<std::pair<double, int>> cand;
+   rangeSearch(*results, filter, &cand);
+
+   results->found.resize(cand.size());
+   for (std::size_t i = 0; i < cand.size(); i++) {
+      results->found[i].key = rl[cand[i].second];
+      results->found[i].rng2 = cand[i].first;
+   }
+
+   return results->numberFound();
+}
+
+//------------------------------------------------------------------------------
+// rangeSearch() -- searches the spatial index
+//------------------------------------------------------------------------------
+void Database::rangeSearch(const Results& area, const RangeFilter* const filter,
+                           std::vector<std::pair<double, int>>* const cand) const
+{
+   cand->clear();
+   if (nrl == 0) return;
+
+   // the index must match the record list
+   if (cellRecs.size() != static_cast<std::size_t>(nrl)) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Database::rangeSearch(): the spatial index hasn't been created!" << std::endl;
+      }
+      return;
+   }
+
+   const double maxRng{area.mrng};
+   const int limit{area.qlimit};
+
+   double mr2(std::numeric_limits<float>::max());
+   if (maxRng > 0.0f) mr2 = maxRng*maxRng;
+
+   // Search radius: with a query limit, start near the ref point and grow the
+   // radius until we have enough records; otherwise search the max range, if
+   // any, or the full index.
+   double radius{maxRng > 0.0f ? maxRng : 0.0};
+   if (limit > 0 && (radius == 0.0 || radius > FIRST_RADIUS)) radius = FIRST_RADIUS;
+
+   bool done{};
+   while (!done) {
+      const bool all{rangeCandidates(area, radius, mr2, filter, cand)};
+      done = all || limit <= 0 || static_cast<int>(cand->size()) >= limit || (maxRng > 0.0f && radius >= maxRng);
+      if (!done) {
+         radius *= 4.0;
+         if (maxRng > 0.0f && radius > maxRng) radius = maxRng;
+      }
+   }
+
+   // sort by range (records at the same range stay in record list order) and
+   // limit the number of result records
+   if (limit > 0 && static_cast<int>(cand->size()) > limit) {
+      std::partial_sort(cand->begin(), cand->begin() + limit, cand->end());
+      cand->resize(limit);
+   } else {
+      std::sort(cand->begin(), cand->end());
+   }
+}
+
+// rangeCandidates() -- collects the records within 'radius' (nm; or all,
+// if zero) that are less than 'mr2' from the ref point and are accepted by
+// the filter.  Returns true if the full index was searched.
+bool Database::rangeCandidates(const Results& area, const double radius, const double mr2,
+                               const RangeFilter* const filter,
+                               std::vector<std::pair<double, int>>* const cand) const
+{
+   cand->clear();
+
+   // cells within the radius (a little larger, to be safe)
+   int lat0{0}, lat1{CELL_LAT - 1};
+   int lon0{0}, lon1{CELL_LON - 1};
+   double r2(std::numeric_limits<double>::max());
+   if (radius > 0.0) {
+      r2 = radius * radius;
+      const double dlat{radius / 60.0 + 1.0e-6};
+      lat0 = cellLat(area.refLat - dlat);
+      lat1 = cellLat(area.refLat + dlat);
+      if (area.coslat > 1.0e-6) {
+         const double dlon{radius / (60.0 * area.coslat) + 1.0e-6};
+         if (dlon < 360.0) {
+            lon0 = cellLon(area.refLon - dlon);
+            lon1 = cellLon(area.refLon + dlon);
+         }
+      }
    }
+
+   // searching the full index?
+   const bool all{lat0 == 0 && lat1 == CELL_LAT - 1 && lon0 == 0 && lon1 == CELL_LON - 1};
+   if (all) r2 = std::numeric_limits<double>::max();
+
+   for (int ilat = lat0; ilat <= lat1; ilat++) {
+      const int* const base{cellRecs.data()};
+      const int first{cellStart[ilat * CELL_LON + lon0]};
+      const int last{cellStart[ilat * CELL_LON + lon1 + 1]};
+      for (int j = first; j < last; j++) {
+         const Key* k{rl[base[j]]};
+         const double rng2{area.range2(k->lat,k->lon)};
+         if (rng2 < mr2 && rng2 <= r2) {
+            if (filter == nullptr || filter->accept(k)) {
+               cand->emplace_back(rng2, base[j]);
+            }
+         }
+      }
+   }
+
+   return all;
 }
 
 
@@ -468,6 +772,54 @@ void Database::printIcaoList(std::ostream& sout)
    }
 }
 
+//------------------------------------------------------------------------------
+// Database::Results
+//------------------------------------------------------------------------------
+Database::Results::Results(const double lat, const double lon, const double mr, const int mrec)
+{
+   setArea(lat, lon, mr);
+   setQueryLimit(mrec);
+}
+
+void Database::Results::setArea(const double lat, const double lon, const double mr)
+{
+   refLat = lat;
+   refLon = lon;
+   coslat = std::cos(lat * base::angle::D2RCC);
+   mrng   = mr;
+}
+
+// range squared (nm**2) to the ref point (same as Database::range2())
+double Database::Results::range2(const double lat, const double lon) const
+{
+   const double x{(lat - refLat) * 60.0};
+   const double y{(lon - refLon) * coslat * 60.0};
+   return (x * x + y * y);
+}
+
+const Database::Key* Database::Results::getKey(const int n) const
+{
+   const Key* k{};
+   if (n >= 0 && n < numberFound()) k = found[n].key;
+   return k;
+}
+
+double Database::Results::getRange(const int n) const
+{
+   double rng{};
+   if (n >= 0 && n < numberFound()) rng = std::sqrt(found[n].rng2);
+   return rng;
+}
+
+std::string Database::Results::getRecord(const int n, const int size) const
+{
+   std::string s;
+   if (db != nullptr && n >= 0 && n < numberFound()) {
+      s = db->readRecord(found[n].key, size);
+   }
+   return s;
+}
+
 //------------------------------------------------------------------------------
 // Database::Key
 //------------------------------------------------------------------------------
@@ -12,6 +12,15 @@
 namespace mixr {
 namespace dafif {
 
+// select the NAVAIDs of type 't'
+struct NavaidLoader::TypeFilter : public Database::RangeFilter {
+   explicit TypeFilter(const Navaid::NavaidType tt) : type(tt) {}
+   bool accept(const Key* const k) const override {
+      return (type == static_cast<const NavaidKey*>(k)->type);
+   }
+   Navaid::NavaidType type {Navaid::ANY};
+};
+
 IMPLEMENT_SUBCLASS(NavaidLoader, "NavaidLoader")
 EMPTY_SLOTTABLE(NavaidLoader)
 EMPTY_COPYDATA(NavaidLoader)
@@ -83,6 +92,9 @@ bool NavaidLoader::loadImpl(const std::string& country)
    // create the ICAO list
    createIcaoList();
 
+   // create the spatial index for the range queries
+   createRangeIndex();
+
    // allocate space for the freq and channel lists
    nql = 0;
    if (nrl > 0) {
@@ -151,6 +163,15 @@ Navaid* NavaidLoader::getNavaid(const int n)
        return nullptr;
 }
 
+Navaid* NavaidLoader::getNavaid(const Results& results, const int n) const
+{
+    const std::string s = results.getRecord(n);
+    if (!s.empty())
+       return new Navaid(s);
+    else
+       return nullptr;
+}
+
 //------------------------------------------------------------------------------
 // queryByRange() -- find NAVAID record(s) less than mrng from the
 // ref point (sorted by range)
@@ -211,29 +232,48 @@ int NavaidLoader::queryByChannel(const long chan, const char band)
 //------------------------------------------------------------------------------
 int NavaidLoader::queryByType(const Navaid::NavaidType t)
 {
-   double mr2(std::numeric_limits<float>::max());   // DDH?
-   if (mrng > 0.0f) mr2 = mrng*mrng;
+   // find the nearest within the search area, sorted by range
+   const TypeFilter filter(t);
+   return rangeQuery(t == Navaid::ANY ? nullptr : &filter);
+}
 
-   // compute range**2 to ref point and select all that have range less
-   // than mrng**2 and type 't'
-   nql = 0;
-   for (int i = 0; i < nrl; i++) {
-      NavaidKey* k = static_cast<NavaidKey*>(rl[i]);
-      if (t == k->type || t == Navaid::ANY) {
-         k->rng2 = range2(k->lat,k->lon);
-         if (k->rng2 < mr2) {
-            ql[nql++] = k;
-         }
-      }
-   }
+//------------------------------------------------------------------------------
+// thread-safe versions of the queries (see Database note #4)
+//------------------------------------------------------------------------------
+int NavaidLoader::findByIdentImpl(Results* const results, const char* id) const
+{
+   NavaidKey key(id, nullptr);
+   Key* pkey = &key;
+   return Database::mFind(results, &pkey, rl, nrl, il_cmp);
+}
 
-   // sort and limit by range
-   rangeSort2();
+int NavaidLoader::findByKeyImpl(Results* const results, const char* navaidkey) const
+{
+   NavaidKey key(navaidkey);
+   Key* pkey = &key;
+   return Database::sFind(results, &pkey, rl, nrl, kl_cmp);
+}
+
+int NavaidLoader::findByFreq(Results* const results, const float freq) const
+{
+   NavaidKey key(freq);
+   Key* pkey = &key;
+   return Database::mFind(results, &pkey, reinterpret_cast<Key**>(fl), nfl, fl_cmp);
+}
 
-   // limit number of result records
-   if (qlimit > 0 && nql > qlimit) nql = qlimit;
+int NavaidLoader::findByChannel(Results* const results, const long chan, const char band) const
+{
+   long chan1 = chan;
+   if (band == 'Y') chan1 = -chan1;
+   NavaidKey key(chan1);
+   Key* pkey = &key;
+   return Database::mFind(results, &pkey, reinterpret_cast<Key**>(cl), ncl, cl_cmp);
+}
 
-   return nql;
+int NavaidLoader::findByType(Results* const results, const Navaid::NavaidType t) const
+{
+   const TypeFilter filter(t);
+   return rangeFind(results, t == Navaid::ANY ? nullptr : &filter);
 }
 
 //------------------------------------------------------------------------------
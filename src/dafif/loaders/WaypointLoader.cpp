@@ -87,6 +87,9 @@ bool WaypointLoader::loadImpl(const std::string& country)
    // create the ICAO list
    createIcaoList();
 
+   // create the spatial index for the range queries
+   createRangeIndex();
+
    dbLoaded = true;
    return true;
 }
@@ -132,6 +135,15 @@ Waypoint* WaypointLoader::getWaypoint(const int n)
        return nullptr;
 }
 
+Waypoint* WaypointLoader::getWaypoint(const Results& results, const int n) const
+{
+    const std::string s = results.getRecord(n);
+    if (!s.empty())
+       return new Waypoint(s);
+    else
+       return nullptr;
+}
+
 
 //------------------------------------------------------------------------------
 // queryByRange() -- find waypoint record(s) less than maxRange from the
@@ -139,27 +151,8 @@ Waypoint* WaypointLoader::getWaypoint(const int n)
 //------------------------------------------------------------------------------
 int WaypointLoader::queryByRangeImpl()
 {
-   double mr2(std::numeric_limits<float>::max());
-   if (mrng > 0.0f) mr2 = mrng*mrng;
-
-   // compute range**2 to ref point and select all that have range less
-   // than maxRange
-   nql = 0;
-   for (int i = 0; i < nrl; i++) {
-      Key* k = rl[i];
-      k->rng2 = range2(k->lat,k->lon);
-      if (k->rng2 < mr2) {
-         ql[nql++] = k;
-      }
-   }
-
-   // sort and limit by range
-   rangeSort2();
-
-   // limit number of result records
-   if (qlimit > 0 && nql > qlimit) nql = qlimit;
-
-   return nql;
+   // find the nearest within the search area, sorted by range
+   return rangeQuery();
 }
 
 
@@ -185,6 +178,24 @@ int WaypointLoader::queryByKeyImpl(const char* waypointkey)
    return Database::sQuery(&pkey, rl, nrl, kl_cmp);
 }
 
+//------------------------------------------------------------------------------
+// findByIdent() -- find waypoint record(s) by identifier (thread-safe)
+// findByKey() -- find a waypoint record by the record key (thread-safe)
+//------------------------------------------------------------------------------
+int WaypointLoader::findByIdentImpl(Results* const results, const char* id) const
+{
+   WaypointKey key(id, nullptr);
+   Key* pkey = &key;
+   return Database::mFind(results, &pkey, rl, nrl, il_cmp);
+}
+
+int WaypointLoader::findByKeyImpl(Results* const results, const char* waypointkey) const
+{
+   WaypointKey key(waypointkey);
+   Key* pkey = &key;
+   return Database::sFind(results, &pkey, rl, nrl, kl_cmp);
+}
+
 //------------------------------------------------------------------------------
 // qsort and bsearch callbacks
 //------------------------------------------------------------------------------
@@ -5,6 +5,8 @@
 #include "mixr/graphics/Image.hpp"
 #include "mixr/graphics/Texture.hpp"
 #include "mixr/graphics/Material.hpp"
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Renderer.hpp"
 
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Integer.hpp"
@@ -65,6 +67,9 @@ BEGIN_SLOTTABLE(Display)
    "orientation",          // 23) display orientation { normal, cw90, ccw90, inverted } default: normal
    "materials",            // 24) List of material objects
    "antiAliasing",         // 25) Anti-aliasing flag (on/off)
+   "drawCaching",          // 26) Draw caching flag (on/off)
+   "culling",              // 27) Culling flag (on/off)
+   "vertexBuffers",        // 28) Vertex buffers flag (on/off)
 END_SLOTTABLE(Display)
 
 BEGIN_SLOT_MAP(Display)
@@ -99,6 +104,9 @@ BEGIN_SLOT_MAP(Display)
    ON_SLOT(24, setSlotMaterials,             base::PairStream)
    ON_SLOT(24, setSlotMaterials,             Material)
    ON_SLOT(25, setSlotAntialias,             base::Boolean)
+   ON_SLOT(26, setSlotDrawCaching,           base::Boolean)
+   ON_SLOT(27, setSlotCulling,               base::Boolean)
+   ON_SLOT(28, setSlotVertexBuffers,         base::Boolean)
 END_SLOT_MAP()
 
 Display::Display()
@@ -165,6 +173,14 @@ void Display::copyData(const Display& org, const bool cc)
    linewidth = org.linewidth;
 
    antialias = org.antialias;
+   drawCaching = org.drawCaching;
+   culling = org.culling;
+   vertexBuffers = org.vertexBuffers;
+
+   // Our copy creates its own renderer and pick index
+   if (renderer != nullptr) { delete renderer; renderer = nullptr; }
+   if (pickIndex != nullptr) { delete pickIndex; pickIndex = nullptr; }
+
    focusPtr = org.focusPtr;
    mx = org.mx;
    my = org.my;
@@ -213,6 +229,8 @@ void Display::deleteData()
    if (currentFont != nullptr) { currentFont->unref(); currentFont = nullptr; }
    if (normalFont != nullptr) { normalFont->unref(); normalFont = nullptr; }
    if (normalFontName != nullptr) { normalFontName->unref(); normalFontName = nullptr; }
+   if (renderer != nullptr) { delete renderer; renderer = nullptr; }
+   if (pickIndex != nullptr) { delete pickIndex; pickIndex = nullptr; }
 }
 
 //------------------------------------------------------------------------------
@@ -463,6 +481,7 @@ void Display::setStdLineWidth(const GLfloat lw)
    if (lw != stdLinewidth) {
       stdLinewidth = lw;
       //setLinewidth(stdLinewidth);
+      drawCacheSerial++;
    }
 }
 
@@ -475,6 +494,51 @@ bool Display::setAntialiasing(const bool on)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// setDrawCaching(), setCulling() -- retained drawing flags (see Graphic)
+//------------------------------------------------------------------------------
+bool Display::setDrawCaching(const bool on)
+{
+   if (drawCaching != on) drawCacheSerial++;
+   drawCaching = on;
+   return true;
+}
+
+bool Display::setCulling(const bool on)
+{
+   culling = on;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// getRenderer() -- our primitive renderer
+//------------------------------------------------------------------------------
+Renderer* Display::getRenderer()
+{
+   if (renderer == nullptr) renderer = new Renderer(this);
+   return renderer;
+}
+
+bool Display::isVertexBuffers() const
+{
+   return (renderer != nullptr && renderer->isBuffered());
+}
+
+bool Display::setVertexBuffers(const bool on)
+{
+   vertexBuffers = on;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// getPickIndex() -- our pick index
+//------------------------------------------------------------------------------
+PickIndex* Display::getPickIndex()
+{
+   if (pickIndex == nullptr) pickIndex = new PickIndex();
+   return pickIndex;
+}
+
 //------------------------------------------------------------------------------
 // setOrtho() -- set the ortho parameters (call before init())
 //------------------------------------------------------------------------------
@@ -514,33 +578,39 @@ void Display::drawIt()
 {
    select();
 
+   Renderer* const r{getRenderer()};
+   r->beginFrame(vertexBuffers);
+   getPickIndex()->beginFrame();
+
    glViewport(0,0,vpWidth,vpHeight);
-   glMatrixMode(GL_PROJECTION);
-   glLoadIdentity();
-   glOrtho(oLeft, oRight, oBottom, oTop, oNear, oFar);
-   glMatrixMode(GL_MODELVIEW);
-   glLoadIdentity();
+   r->ortho(oLeft, oRight, oBottom, oTop, oNear, oFar);
 
    configure();
    clear();
 
    if (getDisplayOrientation() != Orientation::NORMAL) {
-      glPushMatrix();
+      r->pushMatrix();
       if (getDisplayOrientation() == Orientation::CW90)
-         glRotated(-90.0, 0.0, 0.0, 1.0);
+         r->rotate(-90.0, 0.0, 0.0, 1.0);
       else if (getDisplayOrientation() == Orientation::CCW90)
-         glRotated(90.0, 0.0, 0.0, 1.0);
+         r->rotate(90.0, 0.0, 0.0, 1.0);
       else
-         glRotated(180.0, 0.0, 0.0, 1.0);
+         r->rotate(180.0, 0.0, 0.0, 1.0);
    }
 
    // Draw the display
    draw();
 
    if (getDisplayOrientation() != Orientation::NORMAL) {
-      glPopMatrix();
+      r->popMatrix();
    }
 
+   // Draw what's left in the vertex buffers
+   r->flush();
+
+   // Index the selectable graphics' bounds for pick()
+   pickIndex->endFrame();
+
    // Swap buffer
    if (okToSwap) swapBuffers();
 }
@@ -564,12 +634,10 @@ void Display::reshapeIt(int w, int h)
       oFar    = 10.0;
    }
 
+   Renderer* const r{getRenderer()};
+   r->flush();
    glViewport(0,0,vpWidth,vpHeight);
-   glMatrixMode(GL_PROJECTION);
-   glLoadIdentity();
-   glOrtho(oLeft, oRight, oBottom, oTop, oNear, oFar);
-   glMatrixMode(GL_MODELVIEW);
-   glLoadIdentity();
+   r->ortho(oLeft, oRight, oBottom, oTop, oNear, oFar);
 }
 
 //------------------------------------------------------------------------------
@@ -636,12 +704,10 @@ void Display::setSubscreen(const GLdouble lf, const GLdouble rt, const GLdouble
    GLint nw{GLint( static_cast<GLdouble>(vpWidth) * ((rt - lf)/(oRight - oLeft)) )};
    GLint nh{GLint( static_cast<GLdouble>(vpHeight) * ((tp - bt)/(oTop - oBottom)) )};
 
+   Renderer* const r{getRenderer()};
+   r->flush();
    glViewport(nx,ny,nw,nh);
-   glMatrixMode(GL_PROJECTION);
-   glLoadIdentity();
-   glOrtho(lf, rt, bt, tp, oNear, oFar);
-   glMatrixMode(GL_MODELVIEW);
-   glLoadIdentity();
+   r->ortho(lf, rt, bt, tp, oNear, oFar);
 }
 
 //-----------------------------------------------------------------------------
@@ -663,9 +729,20 @@ void Display::setScissor(const GLdouble scissorLeft, const GLdouble scissorRight
 
    // we have to get our model and
    GLdouble modelMatrix[16];
-   glGetDoublev(GL_MODELVIEW_MATRIX, modelMatrix);
    GLdouble projMatrix[16];
-   glGetDoublev(GL_PROJECTION_MATRIX, projMatrix);
+   Renderer* const r{getRenderer()};
+   if (r->isBuffered()) {
+      // the renderer holds the matrices; draw what's batched before the scissor test
+      r->flush();
+      for (unsigned int i = 0; i < 16; i++) {
+         modelMatrix[i] = r->getModelview().ptr()[i];
+         projMatrix[i] = r->getProjection().ptr()[i];
+      }
+   }
+   else {
+      glGetDoublev(GL_MODELVIEW_MATRIX, modelMatrix);
+      glGetDoublev(GL_PROJECTION_MATRIX, projMatrix);
+   }
    GLint viewport[4];
    glGetIntegerv(GL_VIEWPORT, viewport);
 
@@ -732,6 +809,7 @@ void Display::setScissor(const GLdouble scissorLeft, const GLdouble scissorRight
 //-----------------------------------------------------------------------------
 void Display::clearScissor()
 {
+   if (renderer != nullptr) renderer->flush();
    glDisable(GL_SCISSOR_TEST);
 }
 
@@ -760,6 +838,17 @@ void Display::setColor(const char* cname1)
    }
 }
 
+//------------------------------------------------------------------------------
+// restoreColor() -- restores the current color and color name, without
+// setting the GL color, which must already be this color
+//------------------------------------------------------------------------------
+void Display::restoreColor(const base::Vec4d& newColor, const char* const cname)
+{
+   color = newColor;
+   if (cname != nullptr && cname[0] != '\0') colorName->setStr(cname);
+   else colorName->empty();
+}
+
 //------------------------------------------------------------------------------
 // setClearColor() -- set the clear color (used by a screen clear)
 //------------------------------------------------------------------------------
@@ -836,6 +925,7 @@ bool Display::setColorTable(base::PairStream* const sctobj)
    bool ok{true};
    if (colorTable != nullptr) colorTable->unref();
    colorTable = sctobj;
+   drawCacheSerial++;
    if (colorTable != nullptr) colorTable->ref();
    else {
       if (isMessageEnabled(MSG_ERROR)) {
@@ -1311,6 +1401,7 @@ void Display::addColor(base::Color* cc)
       char cbuf[20];
       std::sprintf(cbuf,"%i",i);
       colorTable->put( new base::Pair(cbuf, cc) );
+      drawCacheSerial++;
    }
 }
 
@@ -1320,6 +1411,7 @@ void Display::addColor(base::Pair* pp)
       base::Object* obj = pp->object();
       if (obj->isClassType(typeid(base::Color))) {
          colorTable->put( pp );
+         drawCacheSerial++;
       }
    }
 }
@@ -1471,6 +1563,30 @@ bool Display::setSlotAntialias(const base::Boolean* const x)
    return setAntialiasing(x->asBool());
 }
 
+//------------------------------------------------------------------------------
+// setSlotDrawCaching() -- set draw caching flag
+//------------------------------------------------------------------------------
+bool Display::setSlotDrawCaching(const base::Boolean* const x)
+{
+   return setDrawCaching(x->asBool());
+}
+
+//------------------------------------------------------------------------------
+// setSlotCulling() -- set culling flag
+//------------------------------------------------------------------------------
+bool Display::setSlotCulling(const base::Boolean* const x)
+{
+   return setCulling(x->asBool());
+}
+
+//------------------------------------------------------------------------------
+// setSlotVertexBuffers() -- set vertex buffers flag
+//------------------------------------------------------------------------------
+bool Display::setSlotVertexBuffers(const base::Boolean* const x)
+{
+   return setVertexBuffers(x->asBool());
+}
+
 //------------------------------------------------------------------------------
 // setRightOrthoBound() -- set right orthogonal bound
 //------------------------------------------------------------------------------
@@ -3,6 +3,8 @@
 #include "mixr/graphics/Display.hpp"
 #include "mixr/graphics/ColorRotary.hpp"
 #include "mixr/graphics/Material.hpp"
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Renderer.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/colors/Rgb.hpp"
@@ -14,6 +16,9 @@
 
 #include "mixr/base/transformations/Transform.hpp"
 
+#include <cmath>
+#include <limits>
+
 namespace mixr {
 namespace graphics {
 
@@ -21,6 +26,7 @@ IMPLEMENT_SUBCLASS(Graphic, "Graphic")
 
 double Graphic::fTimer{};
 GLuint Graphic::autoSelName{0x00800000};
+bool Graphic::recording{};
 
 BEGIN_SLOTTABLE(Graphic)
     "color",                //  1: color
@@ -171,6 +177,11 @@ void Graphic::copyData(const Graphic& org, const bool cc)
 
     mask = org.mask;
     lightMoved = org.lightMoved;
+
+    // Our own draw batches (our old lists are deleted by our next draw)
+    for (DrawBatch& b : batches) b.count = 0;
+    updateChildren();
+    setDirty(DIRTY_ALL);
 }
 
 //------------------------------------------------------------------------------
@@ -185,6 +196,10 @@ void Graphic::deleteData()
     dlist = 0;
     noDisplayList = false;
 
+    // Delete draw batches
+    clearBatches();
+    children.clear();
+
     // Delete list of transformations
     if (transforms != nullptr) transforms->unref();
     transforms = nullptr;
@@ -325,6 +340,7 @@ bool Graphic::setTextureName(const char* newName)
         texName = nullptr;
     }
     texture = 0;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
@@ -389,6 +405,12 @@ void Graphic::setupMaterial()
 void Graphic::draw()
 {
     Display* display{getDisplay()};
+    Renderer* const r{display->getRenderer()};
+    const bool buffered{r->isBuffered()};
+
+    // Our changes are being drawn; make sure our cached subtree state is current
+    dirtyFlags = 0;
+    updateCache();
 
     // Flashing: return if flashing and the flash flip/flop is OFF
     if (isFlashing() && flashOff()) return;
@@ -396,10 +418,26 @@ void Graphic::draw()
     // When this object is visible ...
     if ( !isVisible() ) return;
 
+    // Cull our subtree when it's wholly outside of the viewport
+    if (boundsKnown && subtreeSize > 1 && !recording && display->isCulling()) {
+        if (isOutsideViewport(display, boundsLo, boundsHi)) return;
+    }
+
+    // Pick index: our select name, and when we're within one, the bounds of
+    // our subtree (if known; otherwise, of each of our drawings)
+    PickIndex* const pi{display->getPickIndex()};
+    if (getSelectName() > 0) pi->pushName(getSelectName(), this);
+    bool pickCovered{};
+    if (boundsKnown && getSelectedComponent() == nullptr && pi->isNamed()) {
+        addPickBounds(display, boundsLo, boundsHi);
+        pi->pushCovered();
+        pickCovered = true;
+    }
+
     // do any required translations, rotations, and/or scaling
     if ( matrixIsActive() ) {
-        glPushMatrix();
-        lcMultMatrix(m.ptr());
+        r->pushMatrix();
+        r->multMatrix(m);
     }
 
     // if we have a color and no material, switch to that color
@@ -418,6 +456,10 @@ void Graphic::draw()
         }
     }
 
+    // OpenGL state changes that apply to the batched primitives
+    const bool glState{lightMoved || materialName != nullptr || materialObj != nullptr || mask || stipple};
+    if (buffered && glState) r->flush();
+
     bool haveMaterial{};
     GLfloat oldPos[4]{};
     if (lightMoved) {
@@ -442,14 +484,25 @@ void Graphic::draw()
             // So forget about it.
             texName =nullptr;
         }
+        setDirty(DIRTY_ATTRIBUTES);
     }
 
+    GLuint otex{};
+    Renderer::Program oprog{};
     if (texture != 0) {
-        // we have a valid texture, enabled texturing and bind our texture.
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        // default to GL_DECAL
-        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+        // the renderer's texture (its TEXTURED program is GL_DECAL)
+        if (buffered) {
+            otex = r->getTexture();
+            oprog = r->getProgram();
+            r->setTexture(texture);
+        }
+        if (!r->isCoreProfile()) {
+            // we have a valid texture, enabled texturing and bind our texture.
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            // default to GL_DECAL
+            glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+        }
     }
 
     // set line width
@@ -459,12 +512,18 @@ void Graphic::draw()
         olw = display->setLinewidth(nlw);
     }
 
-    // set line stipple
-    if (stipple) {
-        glEnable(GL_LINE_STIPPLE);
-        if (stippleFactor > 0 && stippleFactor <= 256) glLineStipple(stippleFactor, stipplePattern);
+    // set line stipple (not with core profiles)
+    if (!r->isCoreProfile()) {
+        if (stipple) {
+            glEnable(GL_LINE_STIPPLE);
+            if (stippleFactor > 0 && stippleFactor <= 256) glLineStipple(stippleFactor, stipplePattern);
+        }
+        else if (!buffered) glDisable(GL_LINE_STIPPLE);
+        else if (glIsEnabled(GL_LINE_STIPPLE)) {
+            r->flush();
+            glDisable(GL_LINE_STIPPLE);
+        }
     }
-    else glDisable(GL_LINE_STIPPLE);
 
     // push our "select" name
     if (getSelectName() > 0) glPushName(getSelectName());
@@ -476,17 +535,25 @@ void Graphic::draw()
     // if we are masking, turn off our color mask
     if (mask) glColorMask(0,0,0,1);
 
+    // Our drawing's pick bounds
+    if (pi->isNamed()) {
+        base::Vec3d lo, hi;
+        if (getPickBounds(display, &lo, &hi)) addPickBounds(display, lo, hi);
+        else pi->setUnbounded();
+    }
+
     // Predraw our graphics before our components (children) graphics
     if (!postDraw) {
-        if (dlist > 0)
+        if (dlist > 0 && !buffered)
             glCallList(dlist);
-        else
+        else {
+            if (buffered && !isBufferedDraw()) r->flush();
             drawFunc();
+        }
     }
 
     // Draw my children
-    base::PairStream* subcomponents{getComponents()};
-    if (subcomponents != nullptr) {
+    if (!children.empty()) {
         Component* s{getSelectedComponent()};
         if (s != nullptr) {
             // When we've selected only one
@@ -497,33 +564,34 @@ void Graphic::draw()
         }
         else {
             // When we should draw them all
-            base::List::Item* item{subcomponents->getFirstItem()};
-            while (item != nullptr) {
-                const auto pair = static_cast<base::Pair*>(item->getValue());
-                const auto obj = dynamic_cast<Graphic*>( pair->object() );
-                if (obj != nullptr) obj->draw();
-                item = item->getNext();
-            }
+            drawComponents(display);
         }
-        subcomponents->unref();
-        subcomponents = nullptr;
     }
 
     // Postdraw our graphics after our components (children) graphics
     if (postDraw) {
-        if (dlist > 0)
+        if (dlist > 0 && !buffered)
             glCallList(dlist);
-        else
+        else {
+            if (buffered && !isBufferedDraw()) r->flush();
             drawFunc();
+        }
     }
 
     // undo any changes we made
+    if (buffered && glState) r->flush();
+    if (buffered && stipple && !r->isCoreProfile()) glDisable(GL_LINE_STIPPLE);
     if (haveScissorBoxHave()) display->clearScissor();
     if (getSelectName() > 0) glPopName();
+    if (pickCovered) pi->popCovered();
+    if (getSelectName() > 0) pi->popName();
     if (linewidth > 0.0f) display->setLinewidth(olw);
     if (setOldColor) display->setColor(ocolor);
-    if (texture != 0) glDisable(GL_TEXTURE_2D);
-    if (matrixIsActive()) glPopMatrix();
+    if (texture != 0) {
+        if (buffered) r->setTexture(otex, oprog);
+        if (!r->isCoreProfile()) glDisable(GL_TEXTURE_2D);
+    }
+    if (matrixIsActive()) r->popMatrix();
     if (mask) glColorMask(1,1,1,1);
     if (haveMaterial) {
         // if our light moved, move it back when we are finished
@@ -541,6 +609,416 @@ void Graphic::drawFunc()
 {
 }
 
+//------------------------------------------------------------------------------
+// drawComponents() -- draw all of our components; the draw batches of
+// unchanged components are called from (or recorded into) display lists
+//------------------------------------------------------------------------------
+void Graphic::drawComponents(Display* const display)
+{
+    if (recording || !display->isDrawCaching() || display->isVertexBuffers()) {
+        if (!recording && !batches.empty()) clearBatches();
+        for (Graphic* const g : children) {
+            g->draw();
+        }
+        return;
+    }
+
+    PickIndex* const pi{display->getPickIndex()};
+    std::size_t i{};
+    for (DrawBatch& b : batches) {
+        while (i < b.first) children[i++]->draw();
+        // (within a select name, the batch's bounds are its pick bounds)
+        const bool pickCovered{pi->isNamed()};
+        if (pickCovered) {
+            if (b.boundsKnown) addPickBounds(display, b.lo, b.hi);
+            else pi->setUnbounded();
+            pi->pushCovered();
+        }
+        drawBatch(&b, display);
+        if (pickCovered) pi->popCovered();
+        i = b.first + b.count;
+    }
+    while (i < children.size()) children[i++]->draw();
+}
+
+//------------------------------------------------------------------------------
+// drawBatch() -- draw a batch of components
+//------------------------------------------------------------------------------
+void Graphic::drawBatch(DrawBatch* const b, Display* const display)
+{
+    const unsigned int end{b->first + b->count};
+
+    // Have any of the components changed since they were last drawn?
+    bool changed{b->serial != display->getDrawCacheSerial()};
+    for (unsigned int i = b->first; i < end && !changed; i++) {
+        if (children[i]->dirtyFlags != 0) changed = true;
+    }
+    if (changed) {
+        if (b->list != 0) glDeleteLists(b->list, 1);
+        b->list = 0;
+        b->cleanFrames = 0;
+        b->serial = display->getDrawCacheSerial();
+    }
+    else if (b->cleanFrames < CACHE_FRAMES) {
+        b->cleanFrames++;
+    }
+
+    // Cull the batch when it's wholly outside of the viewport
+    if (b->boundsKnown && display->isCulling() && isOutsideViewport(display, b->lo, b->hi)) return;
+
+    // Display's current color
+    const base::Vec4d color0{display->getCurrentColor()};
+    const std::string colorName0{display->getCurrentColorName()->c_str()};
+
+    // Call the recorded list, which is only valid with the same display
+    // line width that it was recorded with
+    if (b->list != 0) {
+        if (b->linewidth0 == display->getLinewidth()) {
+            glCallList(b->list);
+            restoreColor(*b, display, color0, colorName0);
+            display->setLinewidth(b->linewidth1);
+            return;
+        }
+        // ... otherwise, record it again later
+        glDeleteLists(b->list, 1);
+        b->list = 0;
+        b->cleanFrames = 0;
+    }
+
+    // Record the batch, once it's been unchanged for a few frames
+    if (b->cleanFrames >= CACHE_FRAMES) {
+        b->list = glGenLists(1);
+    }
+    if (b->list != 0) {
+        // The display's color is unknown while recording, so that the list
+        // sets its own colors, and is valid with any current color.
+        const double nan{std::numeric_limits<double>::quiet_NaN()};
+        display->restoreColor(base::Vec4d(nan, nan, nan, nan), nullptr);
+        b->linewidth0 = display->getLinewidth();
+
+        glNewList(b->list, GL_COMPILE_AND_EXECUTE);
+        recording = true;
+        for (unsigned int i = b->first; i < end; i++) {
+            children[i]->draw();
+        }
+        recording = false;
+        glEndList();
+
+        b->color1 = display->getCurrentColor();
+        b->colorName1 = display->getCurrentColorName()->c_str();
+        b->linewidth1 = display->getLinewidth();
+        restoreColor(*b, display, color0, colorName0);
+    }
+    else {
+        for (unsigned int i = b->first; i < end; i++) {
+            children[i]->draw();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// restoreColor() -- sets the display's current color to the GL color after
+// a recorded batch; 'color0' and 'colorName0' are the display's color before
+// the batch, which is unchanged if the batch didn't set a color.
+//------------------------------------------------------------------------------
+void Graphic::restoreColor(const DrawBatch& b, Display* const display,
+                           const base::Vec4d& color0, const std::string& colorName0)
+{
+    if (std::isnan(b.color1[0])) display->restoreColor(color0, colorName0.c_str());
+    else display->restoreColor(b.color1, b.colorName1.c_str());
+}
+
+//------------------------------------------------------------------------------
+// updateCache() -- update our cached subtree state (static subtree flag,
+// bounds, size and draw batches), if we or our subtree have changed
+//------------------------------------------------------------------------------
+void Graphic::updateCache()
+{
+    if (cacheValid) return;
+
+    const bool staticDraw{isStaticDraw()};
+
+    // Our own state
+    staticSubtree = staticDraw && !isFlashing() && !haveScissorBoxHave() && !lightMoved &&
+                    materialName == nullptr && materialObj == nullptr &&
+                    (texName == nullptr || texture != 0) && getSelectedComponent() == nullptr &&
+                    getSelectName() == 0;
+    subtreeSize = 1;
+
+    boundsLo.set(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    boundsHi = -boundsLo;
+    boundsKnown = staticDraw;
+
+    // Our drawing and our components' (when visible)
+    if (isVisible()) {
+        if (boundsKnown) {
+            base::Vec3d lo, hi;
+            boundsKnown = getDrawBounds(&lo, &hi);
+            if (boundsKnown) addBounds(&boundsLo, &boundsHi, lo, hi);
+        }
+        for (Graphic* const g : children) {
+            g->updateCache();
+            subtreeSize += g->subtreeSize;
+            if (!g->staticSubtree) staticSubtree = false;
+            if (boundsKnown) {
+                if (g->boundsKnown) addBounds(&boundsLo, &boundsHi, g->boundsLo, g->boundsHi);
+                else boundsKnown = false;
+            }
+        }
+    }
+    else {
+        // Nothing is drawn
+        staticSubtree = staticDraw;
+    }
+
+    // Bounds in our container's coordinates
+    if (boundsKnown && haveMatrix) {
+        boundsKnown = transformBounds(&boundsLo, &boundsHi, m.ptr());
+    }
+
+    updateBatches();
+
+    cacheValid = true;
+}
+
+//------------------------------------------------------------------------------
+// updateBatches() -- group our consecutive components that are static subtrees
+// into draw batches; keeps the recorded lists of the unchanged batches
+//------------------------------------------------------------------------------
+void Graphic::updateBatches()
+{
+    std::vector<DrawBatch> nb;
+    if (isVisible() && getSelectedComponent() == nullptr) {
+        const unsigned int n{static_cast<unsigned int>(children.size())};
+        unsigned int i{};
+        while (i < n) {
+            if (!children[i]->staticSubtree) {
+                i++;
+                continue;
+            }
+
+            DrawBatch b;
+            b.first = i;
+            b.lo.set(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+            b.hi = -b.lo;
+            b.boundsKnown = true;
+            while (i < n && children[i]->staticSubtree) {
+                const Graphic* const g{children[i]};
+                b.size += g->subtreeSize;
+                if (b.boundsKnown) {
+                    if (g->boundsKnown) addBounds(&b.lo, &b.hi, g->boundsLo, g->boundsHi);
+                    else b.boundsKnown = false;
+                }
+                i++;
+            }
+            b.count = i - b.first;
+
+            if (b.size >= MIN_BATCH_SIZE) {
+                // Same components as an old batch? then keep its recorded list
+                for (DrawBatch& ob : batches) {
+                    if (ob.first == b.first && ob.count == b.count) {
+                        b.list = ob.list;
+                        b.cleanFrames = ob.cleanFrames;
+                        b.serial = ob.serial;
+                        b.color1 = ob.color1;
+                        b.colorName1 = ob.colorName1;
+                        b.linewidth0 = ob.linewidth0;
+                        b.linewidth1 = ob.linewidth1;
+                        ob.list = 0;
+                        break;
+                    }
+                }
+                nb.push_back(b);
+            }
+        }
+    }
+    clearBatches();
+    batches.swap(nb);
+}
+
+//------------------------------------------------------------------------------
+// clearBatches() -- delete our draw batches and their lists
+//------------------------------------------------------------------------------
+void Graphic::clearBatches()
+{
+    for (const DrawBatch& b : batches) {
+        if (b.list != 0) glDeleteLists(b.list, 1);
+    }
+    batches.clear();
+}
+
+//------------------------------------------------------------------------------
+// isStaticDraw() -- our draw() depends only on our dirty state
+//------------------------------------------------------------------------------
+bool Graphic::isStaticDraw() const
+{
+    return (typeid(*this) == typeid(Graphic));
+}
+
+//------------------------------------------------------------------------------
+// isBufferedDraw() -- our drawFunc() draws only through the display's renderer
+//------------------------------------------------------------------------------
+bool Graphic::isBufferedDraw() const
+{
+    return (typeid(*this) == typeid(Graphic));
+}
+
+//------------------------------------------------------------------------------
+// isVertexBuffers() -- is our display drawing through vertex buffers?
+//------------------------------------------------------------------------------
+bool Graphic::isVertexBuffers()
+{
+    return getDisplay()->isVertexBuffers();
+}
+
+//------------------------------------------------------------------------------
+// getDrawBounds() -- bounds of our own drawing (default: our vertices)
+//------------------------------------------------------------------------------
+bool Graphic::getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+    lo->set(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    *hi = -(*lo);
+    for (unsigned int i = 0; i < nv; i++) {
+        addBounds(lo, hi, vertices[i], vertices[i]);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// getPickBounds() -- bounds of our own drawing for picking (default: our
+// draw bounds, if we're a static draw)
+//------------------------------------------------------------------------------
+bool Graphic::getPickBounds(Display* const, base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+    return (isStaticDraw() && getDrawBounds(lo, hi));
+}
+
+//------------------------------------------------------------------------------
+// setDirty() -- mark this graphic dirty, and our (grand) containers'
+// subtrees dirty
+//------------------------------------------------------------------------------
+void Graphic::setDirty(const unsigned int flags)
+{
+    dirtyFlags |= flags;
+    cacheValid = false;
+
+    auto p = dynamic_cast<Graphic*>(container());
+    while (p != nullptr) {
+        p->dirtyFlags |= DIRTY_SUBTREE;
+        p->cacheValid = false;
+        p = dynamic_cast<Graphic*>(p->container());
+    }
+}
+
+//------------------------------------------------------------------------------
+// Bounds functions (bounds with lo > hi are empty)
+//------------------------------------------------------------------------------
+
+// addBounds() -- expand bounds 'lo' and 'hi' by bounds 'lo2' and 'hi2'
+void Graphic::addBounds(base::Vec3d* const lo, base::Vec3d* const hi, const base::Vec3d& lo2, const base::Vec3d& hi2)
+{
+    for (unsigned int i = 0; i < 3; i++) {
+        if (lo2[i] < (*lo)[i]) (*lo)[i] = lo2[i];
+        if (hi2[i] > (*hi)[i]) (*hi)[i] = hi2[i];
+    }
+}
+
+// transformBounds() -- transform the bounds by the (column major) matrix
+// 'mm'; returns false if they can't be (i.e., perspective)
+bool Graphic::transformBounds(base::Vec3d* const lo, base::Vec3d* const hi, const double* const mm)
+{
+    if ((*lo)[0] > (*hi)[0]) return true;
+
+    const base::Vec3d lo0{*lo};
+    const base::Vec3d hi0{*hi};
+    lo->set(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    *hi = -(*lo);
+    for (unsigned int k = 0; k < 8; k++) {
+        const double x{(k & 1) ? hi0[0] : lo0[0]};
+        const double y{(k & 2) ? hi0[1] : lo0[1]};
+        const double z{(k & 4) ? hi0[2] : lo0[2]};
+        const double w{mm[3]*x + mm[7]*y + mm[11]*z + mm[15]};
+        if (w <= 0.0) return false;
+        const base::Vec3d p{ (mm[0]*x + mm[4]*y + mm[8]*z + mm[12]) / w,
+                             (mm[1]*x + mm[5]*y + mm[9]*z + mm[13]) / w,
+                             (mm[2]*x + mm[6]*y + mm[10]*z + mm[14]) / w };
+        addBounds(lo, hi, p, p);
+    }
+    return true;
+}
+
+// isOutsideViewport() -- returns true if the bounds, in the current
+// modelview coordinates, are wholly outside of the viewport
+bool Graphic::isOutsideViewport(Display* const display, const base::Vec3d& lo, const base::Vec3d& hi)
+{
+    // Nothing is drawn
+    if (lo[0] > hi[0]) return true;
+
+    double c[16]{};
+    GLint vp[4]{};
+    if (!getClipMatrix(display, c, vp)) return false;
+
+    // Normalized device coordinates, with a margin for line widths and point sizes
+    const double mx{1.0 + 2.0 * CULL_MARGIN / vp[2]};
+    const double my{1.0 + 2.0 * CULL_MARGIN / vp[3]};
+    unsigned int left{}, right{}, bottom{}, top{};
+    for (unsigned int k = 0; k < 8; k++) {
+        const double x{(k & 1) ? hi[0] : lo[0]};
+        const double y{(k & 2) ? hi[1] : lo[1]};
+        const double z{(k & 4) ? hi[2] : lo[2]};
+        const double w{c[3]*x + c[7]*y + c[11]*z + c[15]};
+        if (w <= 0.0) return false;
+        const double nx{(c[0]*x + c[4]*y + c[8]*z + c[12]) / w};
+        const double ny{(c[1]*x + c[5]*y + c[9]*z + c[13]) / w};
+        if (nx < -mx) left++;
+        if (nx >  mx) right++;
+        if (ny < -my) bottom++;
+        if (ny >  my) top++;
+    }
+    return (left == 8 || right == 8 || bottom == 8 || top == 8);
+}
+
+// getClipMatrix() -- gets the current clip matrix (projection * modelview,
+// column major) and viewport; returns false if the viewport is empty
+bool Graphic::getClipMatrix(Display* const display, double* const c, GLint* const vp)
+{
+    // The renderer holds the matrices when drawing through vertex buffers
+    GLdouble mv[16]{};
+    GLdouble pj[16]{};
+    const Renderer* const r{display->getRenderer()};
+    if (r->isBuffered()) {
+        for (unsigned int i = 0; i < 16; i++) {
+            mv[i] = r->getModelview().ptr()[i];
+            pj[i] = r->getProjection().ptr()[i];
+        }
+    }
+    else {
+        glGetDoublev(GL_MODELVIEW_MATRIX, mv);
+        glGetDoublev(GL_PROJECTION_MATRIX, pj);
+    }
+    glGetIntegerv(GL_VIEWPORT, vp);
+    if (vp[2] <= 0 || vp[3] <= 0) return false;
+
+    for (unsigned int col = 0; col < 4; col++) {
+        for (unsigned int row = 0; row < 4; row++) {
+            c[col*4 + row] = pj[row]*mv[col*4] + pj[4 + row]*mv[col*4 + 1] + pj[8 + row]*mv[col*4 + 2] + pj[12 + row]*mv[col*4 + 3];
+        }
+    }
+    return true;
+}
+
+// addPickBounds() -- adds the bounds, in the current modelview coordinates,
+// to the display's pick index
+void Graphic::addPickBounds(Display* const display, const base::Vec3d& lo, const base::Vec3d& hi)
+{
+    // Nothing is drawn
+    if (lo[0] > hi[0]) return;
+
+    double c[16]{};
+    GLint vp[4]{};
+    if (getClipMatrix(display, c, vp)) display->getPickIndex()->addBounds(c, vp, lo, hi);
+}
+
 
 //------------------------------------------------------------------------------
 // Set Functions
@@ -549,6 +1027,7 @@ bool Graphic::setFlashRate(const double r)
 {
     if (r >= 0.0) {
         fRate = r;
+        setDirty(DIRTY_VISIBILITY);
         return true;
     }
     else return false;
@@ -557,54 +1036,63 @@ bool Graphic::setFlashRate(const double r)
 bool Graphic::setSelectName(const GLuint v)
 {
     selName = v;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setLineWidth(const GLfloat v)
 {
     linewidth = v;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setVisibility(const bool v)
 {
     visible = v;
+    setDirty(DIRTY_VISIBILITY);
     return true;
 }
 
 bool Graphic::setScissorX(const double newX)
 {
     scissorX = newX;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setScissorWidth(const double newWidth)
 {
     scissorWidth = newWidth;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setScissorY(const double newY)
 {
     scissorY = newY;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setScissorHeight(const double newHeight)
 {
     scissorHeight = newHeight;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
 bool Graphic::setDisplayList(const GLuint v)
 {
     dlist = v;
+    setDirty(DIRTY_GEOMETRY);
     return true;
 }
 
 bool Graphic::setDisableDisplayList(const bool flg)
 {
     noDisplayList = flg;
+    setDirty(DIRTY_GEOMETRY);
     return true;
 }
 
@@ -643,6 +1131,7 @@ void Graphic::setupMatrix()
             item = item->getNext();
         }
     }
+    setDirty(DIRTY_TRANSFORM);
 }
 
 //------------------------------------------------------------------------------
@@ -659,6 +1148,7 @@ bool Graphic::setColor(const base::Color* cobj)
         color = cobj->clone();
     }
 
+    setDirty(DIRTY_COLOR);
     return true;
 }
 
@@ -675,6 +1165,7 @@ bool Graphic::setColor(const base::Identifier* cnobj)
        // When we're being passed a name of a color from the color table ...
        colorName = cnobj->clone();
     }
+    setDirty(DIRTY_COLOR);
     return true;
 }
 
@@ -693,6 +1184,7 @@ bool Graphic::setColor(const base::Number* const cnobj)
         cr->determineColor(cnobj->asDouble());
     }
 
+    setDirty(DIRTY_COLOR);
     return true;
 }
 
@@ -876,6 +1368,7 @@ bool Graphic::setVertices(const base::Vec3d* const v, const unsigned int n)
          vertices[i] = v[i];
       }
    }
+   setDirty(DIRTY_GEOMETRY);
    return true;
 }
 
@@ -899,6 +1392,7 @@ bool Graphic::setNormals(const base::Vec3d* const v, const unsigned int n)
          norms[i] = v[i];
       }
    }
+   setDirty(DIRTY_GEOMETRY);
    return true;
 }
 
@@ -922,6 +1416,7 @@ bool Graphic::setTextureCoord(const base::Vec2d* const v, const unsigned int n)
          texCoord[i] = v[i];
       }
    }
+   setDirty(DIRTY_GEOMETRY);
    return true;
 }
 
@@ -932,6 +1427,7 @@ bool Graphic::setTextureCoord(const base::Vec2d* const v, const unsigned int n)
 bool Graphic::setTexture(const GLuint newTex)
 {
    texture = newTex;
+   setDirty(DIRTY_ATTRIBUTES);
    return true;
 }
 
@@ -939,12 +1435,14 @@ bool Graphic::setLightPosition(const double x, const double y, const double z, c
 {
     lightPos.set(x, y, z, w);
     lightMoved = true;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
     }
 
 bool Graphic::setLightPosition(base::Vec4d& newPos)
 {
     lightPos = newPos;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
@@ -961,6 +1459,7 @@ bool Graphic::setMaterial(const base::Identifier* const x)
         // When we're being passed a name of a material from the material table...
         materialName = x->clone();
     }
+    setDirty(DIRTY_COLOR);
     return true;
 }
 
@@ -978,6 +1477,7 @@ bool Graphic::setMaterial(const graphics::Material* const x)
         materialObj = x->clone();
     }
 
+    setDirty(DIRTY_COLOR);
     return true;
 }
 
@@ -985,6 +1485,7 @@ bool Graphic::setMaterial(const graphics::Material* const x)
 bool Graphic::setStippling(const bool x)
 {
    stipple = x;
+   setDirty(DIRTY_ATTRIBUTES);
    return true;
 }
 
@@ -992,6 +1493,7 @@ bool Graphic::setStippling(const bool x)
 bool Graphic::setStippleFactor(const GLuint x)
 {
    stippleFactor = x;
+   setDirty(DIRTY_ATTRIBUTES);
    return true;
 }
 
@@ -999,6 +1501,7 @@ bool Graphic::setStippleFactor(const GLuint x)
 bool Graphic::setStipplePattern(const GLushort x)
 {
    stipplePattern = x;
+   setDirty(DIRTY_ATTRIBUTES);
    return true;
 }
 
@@ -1014,6 +1517,48 @@ void Graphic::processComponents(
    )
 {
    base::Component::processComponents(list, typeid(Graphic),add,remove);
+   updateChildren();
+}
+
+//------------------------------------------------------------------------------
+// updateChildren() -- update our list of component graphics
+//------------------------------------------------------------------------------
+void Graphic::updateChildren()
+{
+   children.clear();
+   base::PairStream* subcomponents{getComponents()};
+   if (subcomponents != nullptr) {
+      const base::List::Item* item{subcomponents->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto g = dynamic_cast<Graphic*>( const_cast<base::Object*>(pair->object()) );
+         if (g != nullptr) children.push_back(g);
+         item = item->getNext();
+      }
+      subcomponents->unref();
+      subcomponents = nullptr;
+   }
+
+   // The old batches' components have changed (their lists are deleted by our next draw)
+   for (DrawBatch& b : batches) b.count = 0;
+   setDirty(DIRTY_COMPONENTS);
+}
+
+//------------------------------------------------------------------------------
+// select() -- select a component; only the selected component is drawn
+//------------------------------------------------------------------------------
+bool Graphic::select(const base::String* const name)
+{
+   const bool ok{BaseClass::select(name)};
+   setDirty(DIRTY_COMPONENTS);
+   return ok;
+}
+
+bool Graphic::select(const base::Integer* const num)
+{
+   const bool ok{BaseClass::select(num)};
+   setDirty(DIRTY_COMPONENTS);
+   return ok;
 }
 
 //------------------------------------------------------------------------------
@@ -1114,6 +1659,7 @@ bool Graphic::setSlotNoDisplayList(const base::Boolean* const x)
 bool Graphic::setSlotSubcomponentsFirst(const base::Boolean* const x)
 {
     postDraw = x->asBool();
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
@@ -1181,6 +1727,7 @@ bool Graphic::setSlotVisibility(const base::Boolean* const x)
 bool Graphic::setSlotMask(const base::Boolean* const x)
 {
    mask = x->asBool();
+   setDirty(DIRTY_ATTRIBUTES);
    return true;
 }
 
@@ -1331,6 +1878,7 @@ bool Graphic::setSlotTexCoord(const base::PairStream* const x)
 bool Graphic::setSlotTextureName(base::Identifier* x)
 {
     texName = x;
+    setDirty(DIRTY_ATTRIBUTES);
     return true;
 }
 
@@ -444,6 +444,14 @@ void Page::draw()
 
 }
 
+//------------------------------------------------------------------------------
+// isStaticDraw() -- our draw() also draws the current subpage
+//------------------------------------------------------------------------------
+bool Page::isStaticDraw() const
+{
+   return false;
+}
+
 //------------------------------------------------------------------------------
 // processSubpages() -- process our subpages; make sure they are all of
 // type Page (or derived from it)and tell them that we are their
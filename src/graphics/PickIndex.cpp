@@ -0,0 +1,257 @@
+
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Graphic.hpp"
+
+#include <GL/glu.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mixr {
+namespace graphics {
+
+const int PickIndex::CELL_SIZE;
+
+// The bounds are computed in double precision, and OpenGL transforms the
+// vertices in single precision, so entries that are within a pixel of the
+// pick box are redrawn
+const double PickIndex::MARGIN {1.0};
+
+//------------------------------------------------------------------------------
+// cell() -- grid cell (column or row) of the window coordinate 'v', clamped to
+// the grid's 'n' cells that start at 'v0'
+//------------------------------------------------------------------------------
+int PickIndex::cell(const double v, const int v0, const int n)
+{
+   const double c{std::floor((v - v0) / CELL_SIZE)};
+   if (c < 0.0) return 0;
+   if (c > n - 1) return n - 1;
+   return static_cast<int>(c);
+}
+
+//------------------------------------------------------------------------------
+// beginFrame() -- start collecting the entries of a frame
+//------------------------------------------------------------------------------
+void PickIndex::beginFrame()
+{
+   entries.clear();
+   unbounded.clear();
+   collecting = true;
+   indexed = false;
+   depth = 0;
+   covered = 0;
+   haveBounds = false;
+   vpX0 = std::numeric_limits<int>::max();
+   vpY0 = std::numeric_limits<int>::max();
+   vpX1 = std::numeric_limits<int>::min();
+   vpY1 = std::numeric_limits<int>::min();
+}
+
+//------------------------------------------------------------------------------
+// endFrame() -- sort the entries into the grid
+//------------------------------------------------------------------------------
+void PickIndex::endFrame()
+{
+   collecting = false;
+   indexed = true;
+   depth = 0;
+   covered = 0;
+
+   gridCols = 0;
+   gridRows = 0;
+   cellStart.clear();
+   cellItems.clear();
+   if (entries.empty() || vpX1 <= vpX0 || vpY1 <= vpY0) return;
+
+   // The grid covers the viewport(s) that the entries were drawn in
+   gridX0 = vpX0;
+   gridY0 = vpY0;
+   gridCols = (vpX1 - vpX0 + CELL_SIZE - 1) / CELL_SIZE;
+   gridRows = (vpY1 - vpY0 + CELL_SIZE - 1) / CELL_SIZE;
+
+   // Cell ranges of the entries; the edge cells also hold the entries that
+   // are outside of the grid, which a pick box that's over the edge can hit
+   const auto numEntries = static_cast<unsigned int>(entries.size());
+   std::vector<int> range(numEntries * 4);
+   cellStart.assign(static_cast<std::size_t>(gridCols * gridRows + 1), 0);
+   for (unsigned int i = 0; i < numEntries; i++) {
+      const Entry& e{entries[i]};
+      int* const r{&range[i * 4]};
+      if (!e.bounded) continue;
+      r[0] = cell(e.x0, gridX0, gridCols);
+      r[1] = cell(e.y0, gridY0, gridRows);
+      r[2] = cell(e.x1, gridX0, gridCols);
+      r[3] = cell(e.y1, gridY0, gridRows);
+      for (int row = r[1]; row <= r[3]; row++) {
+         for (int col = r[0]; col <= r[2]; col++) cellStart[row * gridCols + col + 1]++;
+      }
+   }
+   for (std::size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+
+   // Entries of each cell, in drawing order
+   cellItems.resize(cellStart.back());
+   std::vector<unsigned int> next(cellStart.begin(), cellStart.end() - 1);
+   for (unsigned int i = 0; i < numEntries; i++) {
+      if (!entries[i].bounded) continue;
+      const int* const r{&range[i * 4]};
+      for (int row = r[1]; row <= r[3]; row++) {
+         for (int col = r[0]; col <= r[2]; col++) cellItems[next[row * gridCols + col]++] = i;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// pushName(), popName() -- select name stack; the outermost name starts
+// (and ends) an entry
+//------------------------------------------------------------------------------
+void PickIndex::pushName(const GLuint name, Graphic* const graphic, const bool pushesName)
+{
+   if (!collecting) return;
+   if (depth++ == 0) {
+      current = Entry();
+      current.name = name;
+      current.graphic = graphic;
+      current.pushesName = pushesName;
+      glGetDoublev(GL_MODELVIEW_MATRIX, current.modelview);
+      glGetDoublev(GL_PROJECTION_MATRIX, current.projection);
+      haveBounds = false;
+   }
+}
+
+void PickIndex::popName()
+{
+   if (!collecting || depth == 0) return;
+   if (--depth == 0) {
+      if (!current.bounded) unbounded.push_back(static_cast<unsigned int>(entries.size()));
+      if (haveBounds || !current.bounded) entries.push_back(current);
+   }
+}
+
+//------------------------------------------------------------------------------
+// addBounds() -- adds the bounds to the current entry
+//------------------------------------------------------------------------------
+void PickIndex::addBounds(const double* const c, const GLint* const vp,
+                          const base::Vec3d& lo, const base::Vec3d& hi)
+{
+   if (!isNamed() || lo[0] > hi[0] || vp[2] <= 0 || vp[3] <= 0) return;
+
+   // Window coordinates of the corners
+   for (unsigned int k = 0; k < 8; k++) {
+      const double x{(k & 1) ? hi[0] : lo[0]};
+      const double y{(k & 2) ? hi[1] : lo[1]};
+      const double z{(k & 4) ? hi[2] : lo[2]};
+      const double w{c[3]*x + c[7]*y + c[11]*z + c[15]};
+      if (w <= 0.0) continue;
+      const double wx{vp[0] + vp[2] * ((c[0]*x + c[4]*y + c[8]*z  + c[12]) / w + 1.0) * 0.5};
+      const double wy{vp[1] + vp[3] * ((c[1]*x + c[5]*y + c[9]*z  + c[13]) / w + 1.0) * 0.5};
+      const double wz{((c[2]*x + c[6]*y + c[10]*z + c[14]) / w + 1.0) * 0.5};
+      if (!haveBounds) {
+         current.x0 = current.x1 = wx;
+         current.y0 = current.y1 = wy;
+         current.zmin = current.zmax = wz;
+         haveBounds = true;
+      }
+      else {
+         current.x0 = std::min(current.x0, wx);
+         current.y0 = std::min(current.y0, wy);
+         current.x1 = std::max(current.x1, wx);
+         current.y1 = std::max(current.y1, wy);
+         current.zmin = std::min(current.zmin, wz);
+         current.zmax = std::max(current.zmax, wz);
+      }
+   }
+
+   vpX0 = std::min(vpX0, static_cast<int>(vp[0]));
+   vpY0 = std::min(vpY0, static_cast<int>(vp[1]));
+   vpX1 = std::max(vpX1, static_cast<int>(vp[0] + vp[2]));
+   vpY1 = std::max(vpY1, static_cast<int>(vp[1] + vp[3]));
+}
+
+//------------------------------------------------------------------------------
+// getCandidates() -- entries that may be hit by the pick box
+//------------------------------------------------------------------------------
+const std::vector<unsigned int>& PickIndex::getCandidates(const double x, const double y,
+                                                          const double width, const double height) const
+{
+   hits.clear();
+   if (gridCols > 0 && gridRows > 0) {
+      // Pick box, with the margin
+      const double bx0{x - width * 0.5 - MARGIN};
+      const double by0{y - height * 0.5 - MARGIN};
+      const double bx1{x + width * 0.5 + MARGIN};
+      const double by1{y + height * 0.5 + MARGIN};
+
+      const int c0{cell(bx0, gridX0, gridCols)};
+      const int r0{cell(by0, gridY0, gridRows)};
+      const int c1{cell(bx1, gridX0, gridCols)};
+      const int r1{cell(by1, gridY0, gridRows)};
+
+      // Entries that are near (once each)
+      if (stamps.size() != entries.size()) stamps.assign(entries.size(), 0);
+      if (++stamp == 0) {
+         std::fill(stamps.begin(), stamps.end(), 0);
+         stamp = 1;
+      }
+      for (int row = r0; row <= r1; row++) {
+         for (int col = c0; col <= c1; col++) {
+            const unsigned int cell{static_cast<unsigned int>(row * gridCols + col)};
+            for (unsigned int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+               const unsigned int i{cellItems[k]};
+               if (stamps[i] == stamp) continue;
+               stamps[i] = stamp;
+               const Entry& e{entries[i]};
+               if (e.x1 >= bx0 && e.x0 <= bx1 && e.y1 >= by0 && e.y0 <= by1) hits.push_back(i);
+            }
+         }
+      }
+   }
+
+   // ... and the entries without bounds, in drawing order
+   hits.insert(hits.end(), unbounded.begin(), unbounded.end());
+   std::sort(hits.begin(), hits.end());
+   return hits;
+}
+
+//------------------------------------------------------------------------------
+// select() -- redraws the candidate entries in GL_SELECT mode
+//------------------------------------------------------------------------------
+GLint PickIndex::select(const double x, const double y, const double width, const double height,
+                        GLint* const vp, GLuint* const sbuff, const GLsizei size) const
+{
+   const std::vector<unsigned int>& list{getCandidates(x, y, width, height)};
+   if (list.empty()) return 0;
+
+   glMatrixMode(GL_PROJECTION);
+   glPushMatrix();
+   glMatrixMode(GL_MODELVIEW);
+   glPushMatrix();
+
+   glSelectBuffer(size, sbuff);
+   glRenderMode(GL_SELECT);
+   glInitNames();
+
+   for (const unsigned int i : list) {
+      const Entry& e{entries[i]};
+      glMatrixMode(GL_PROJECTION);
+      glLoadIdentity();
+      gluPickMatrix(x, y, width, height, vp);
+      glMultMatrixd(e.projection);
+      glMatrixMode(GL_MODELVIEW);
+      glLoadMatrixd(e.modelview);
+
+      if (!e.pushesName) glPushName(e.name);
+      e.graphic->draw();
+      if (!e.pushesName) glPopName();
+   }
+
+   const GLint numHits{glRenderMode(GL_RENDER)};
+
+   glMatrixMode(GL_PROJECTION);
+   glPopMatrix();
+   glMatrixMode(GL_MODELVIEW);
+   glPopMatrix();
+   return numHits;
+}
+
+}
+}
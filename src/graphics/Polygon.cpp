@@ -2,6 +2,8 @@
 #include "mixr/graphics/Polygon.hpp"
 #include "mixr/base/numeric/Number.hpp"
 #include "mixr/graphics/ColorGradient.hpp"
+#include "mixr/graphics/Display.hpp"
+#include "mixr/graphics/Renderer.hpp"
 #include "mixr/base/PairStream.hpp"
 #include <GL/glu.h>
 
@@ -120,24 +122,41 @@ void Polygon::drawFunc()
     const base::Vec3d* vertices = getVertices();
 
     if (nv >= 2) {
+        Renderer* const r{getDisplay()->getRenderer()};
 
         // Draw with texture
         unsigned int ntc = getNumberOfTextureCoords();
         if (ntc > 0 && hasTexture()) {
             const base::Vec2d* texCoord = getTextureCoord();
             unsigned int tc = 0; // texture count
-            glBegin(GL_POLYGON);
+            r->begin(GL_POLYGON);
             for (unsigned int i = 0; i < nv; i++) {
                 if (tc < ntc)  {
-                    lcTexCoord2v(texCoord[tc++].ptr());
+                    r->texCoord(texCoord[tc++]);
                 }
-                lcVertex3v( vertices[i].ptr() );
+                r->vertex( vertices[i] );
             }
-            glEnd();
+            r->end();
+
+        }
 
+        // Draw without texture or material
+        else if (getMaterialName() == nullptr && getMaterial() == nullptr) {
+            // get our color gradient, because if we have one, instead of a regular color, we will
+            // override it here and set it on a per vertex level.
+            const auto colGradient = dynamic_cast<ColorGradient*>(getColor());
+            r->begin(GL_POLYGON);
+            for (unsigned int i = 0; i < nv; i++) {
+                if (colGradient != nullptr) {
+                    base::Color* col = colGradient->getColorByIdx(i+1);
+                    if (col != nullptr) r->color(col->red(), col->green(), col->blue(), col->alpha());
+                }
+                r->vertex( vertices[i] );
+            }
+            r->end();
         }
 
-        // Draw without texture
+        // Draw with a material (lighting needs OpenGL's fixed function pipeline)
         else {
             // get our color gradient, because if we have one, instead of a regular color, we will
             // override it here and set it on a per vertex level.
@@ -172,6 +191,22 @@ void Polygon::drawFunc()
     END_DLIST
 }
 
+//------------------------------------------------------------------------------
+// isStaticDraw() -- static draw (exact type only)
+//------------------------------------------------------------------------------
+bool Polygon::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(Polygon));
+}
+
+//------------------------------------------------------------------------------
+// isBufferedDraw() -- buffered draw (exact type only, and without a material)
+//------------------------------------------------------------------------------
+bool Polygon::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(Polygon) && getMaterialName() == nullptr && getMaterial() == nullptr);
+}
+
 }
 }
 
@@ -0,0 +1,539 @@
+
+// The vertex buffer mode uses OpenGL 3.2 functions, which Windows' OpenGL
+// library doesn't export (they'd need a function loader), so on Windows
+// the renderer stays in immediate mode.
+#if !defined(WIN32)
+#define GL_GLEXT_PROTOTYPES
+#endif
+
+#include "mixr/graphics/Renderer.hpp"
+#include "mixr/graphics/Display.hpp"
+
+#include <GL/glext.h>
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace mixr {
+namespace graphics {
+
+namespace {
+
+// Vertex shader: the vertices are already in eye coordinates (see vertex())
+const char* const vertexShader {
+   "#version 150\n"
+   "uniform mat4 projection;\n"
+   "in vec3 position;\n"
+   "in vec2 texCoord;\n"
+   "in vec4 color;\n"
+   "out vec2 vTexCoord;\n"
+   "out vec4 vColor;\n"
+   "void main() {\n"
+   "   vTexCoord = texCoord;\n"
+   "   vColor = color;\n"
+   "   gl_Position = projection * vec4(position, 1.0);\n"
+   "}\n"
+};
+
+// Fragment shaders (by Renderer::Program)
+const char* const fragmentShaders[3] {
+   // SOLID
+   "#version 150\n"
+   "in vec2 vTexCoord;\n"
+   "in vec4 vColor;\n"
+   "out vec4 fragColor;\n"
+   "void main() {\n"
+   "   fragColor = vColor;\n"
+   "}\n",
+
+   // TEXTURED (GL_DECAL)
+   "#version 150\n"
+   "uniform sampler2D tex;\n"
+   "in vec2 vTexCoord;\n"
+   "in vec4 vColor;\n"
+   "out vec4 fragColor;\n"
+   "void main() {\n"
+   "   vec4 t = texture(tex, vTexCoord);\n"
+   "   fragColor = vec4(mix(vColor.rgb, t.rgb, t.a), vColor.a);\n"
+   "}\n",
+
+   // TEXT (glyph coverage)
+   "#version 150\n"
+   "uniform sampler2D tex;\n"
+   "in vec2 vTexCoord;\n"
+   "in vec4 vColor;\n"
+   "out vec4 fragColor;\n"
+   "void main() {\n"
+   "   fragColor = vec4(vColor.rgb, vColor.a * texture(tex, vTexCoord).r);\n"
+   "}\n"
+};
+
+// Color component [ 0 .. 1 ] to an unsigned byte
+GLubyte toUbyte(const double c)
+{
+   if (c <= 0.0) return 0;
+   if (c >= 1.0) return 255;
+   return static_cast<GLubyte>(c * 255.0 + 0.5);
+}
+
+}
+
+const unsigned int Renderer::MAX_VERTICES;
+const GLuint Renderer::RESTART_INDEX;
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+Renderer::Renderer(Display* const d) : display(d)
+{
+}
+
+//------------------------------------------------------------------------------
+// beginFrame() -- start of a frame
+//------------------------------------------------------------------------------
+void Renderer::beginFrame(const bool vertexBuffers)
+{
+   if (!initialized) {
+      initialized = true;
+
+      // OpenGL 3.0+ contexts report their version and profile
+      GLint major{};
+      glGetIntegerv(GL_MAJOR_VERSION, &major);
+      if (major >= 3) {
+         GLint mask{};
+         glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &mask);
+         coreProfile = ((mask & GL_CONTEXT_CORE_PROFILE_BIT) != 0);
+      }
+      glGetError();
+
+      // Core profile contexts can only draw through vertex buffers
+      if (vertexBuffers || coreProfile) {
+         buffered = setup();
+         if (!buffered && display->isMessageEnabled(base::Object::MSG_WARNING)) {
+            std::cerr << "Renderer::beginFrame(): vertex buffers are not available; using immediate mode" << std::endl;
+         }
+      }
+   }
+
+   texture = 0;
+   program = Program::SOLID;
+   inPrimitive = false;
+   prim.clear();
+   vertices.clear();
+   indices.clear();
+   modelview.resize(1);
+   modelview[0].makeIdentity();
+}
+
+//------------------------------------------------------------------------------
+// setup() -- builds the shader programs and the vertex buffers
+//------------------------------------------------------------------------------
+bool Renderer::setup()
+{
+#if !defined(WIN32)
+   GLint major{}, minor{};
+   glGetIntegerv(GL_MAJOR_VERSION, &major);
+   glGetIntegerv(GL_MINOR_VERSION, &minor);
+   if (major < 3 || (major == 3 && minor < 2)) return false;
+
+   bool ok{true};
+   for (unsigned int i = 0; i < 3 && ok; i++) {
+      programs[i] = buildProgram(fragmentShaders[i]);
+      if (programs[i] != 0) {
+         mvpLoc[i] = glGetUniformLocation(programs[i], "projection");
+         const GLint texLoc{glGetUniformLocation(programs[i], "tex")};
+         if (texLoc >= 0) {
+            glUseProgram(programs[i]);
+            glUniform1i(texLoc, 0);
+         }
+         projectionChanged[i] = true;
+      }
+      else ok = false;
+   }
+   glUseProgram(0);
+
+   if (!ok) {
+      for (unsigned int i = 0; i < 3; i++) {
+         if (programs[i] != 0) glDeleteProgram(programs[i]);
+         programs[i] = 0;
+      }
+      if (display->isMessageEnabled(base::Object::MSG_ERROR)) {
+         std::cerr << "Renderer::setup(): unable to build the shader programs" << std::endl;
+      }
+      return false;
+   }
+
+   glGenVertexArrays(1, &vao);
+   glGenBuffers(1, &vbo);
+   glGenBuffers(1, &ibo);
+
+   glBindVertexArray(vao);
+   glBindBuffer(GL_ARRAY_BUFFER, vbo);
+   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+   glEnableVertexAttribArray(0);
+   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const GLvoid*>(offsetof(Vertex, pos)));
+   glEnableVertexAttribArray(1);
+   glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const GLvoid*>(offsetof(Vertex, tex)));
+   glEnableVertexAttribArray(2);
+   glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const GLvoid*>(offsetof(Vertex, rgba)));
+   glBindVertexArray(0);
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// buildProgram() -- builds a shader program; returns zero on errors
+//------------------------------------------------------------------------------
+GLuint Renderer::buildProgram(const char* const fs)
+{
+   GLuint prog{};
+#if !defined(WIN32)
+   const GLuint vsh{glCreateShader(GL_VERTEX_SHADER)};
+   glShaderSource(vsh, 1, &vertexShader, nullptr);
+   glCompileShader(vsh);
+
+   const GLuint fsh{glCreateShader(GL_FRAGMENT_SHADER)};
+   glShaderSource(fsh, 1, &fs, nullptr);
+   glCompileShader(fsh);
+
+   GLint vok{}, fok{};
+   glGetShaderiv(vsh, GL_COMPILE_STATUS, &vok);
+   glGetShaderiv(fsh, GL_COMPILE_STATUS, &fok);
+   if (vok && fok) {
+      prog = glCreateProgram();
+      glAttachShader(prog, vsh);
+      glAttachShader(prog, fsh);
+      glBindAttribLocation(prog, 0, "position");
+      glBindAttribLocation(prog, 1, "texCoord");
+      glBindAttribLocation(prog, 2, "color");
+      glBindFragDataLocation(prog, 0, "fragColor");
+      glLinkProgram(prog);
+
+      GLint lok{};
+      glGetProgramiv(prog, GL_LINK_STATUS, &lok);
+      if (!lok) {
+         glDeleteProgram(prog);
+         prog = 0;
+      }
+   }
+   glDeleteShader(vsh);
+   glDeleteShader(fsh);
+#endif
+   return prog;
+}
+
+//------------------------------------------------------------------------------
+// flush() -- draws the batched vertices
+//------------------------------------------------------------------------------
+void Renderer::flush()
+{
+#if !defined(WIN32)
+   if (!buffered || indices.empty()) return;
+
+   const auto p = static_cast<unsigned int>(batchProgram);
+   glUseProgram(programs[p]);
+   if (projectionChanged[p]) {
+      GLfloat m[16]{};
+      const double* const pm{projection.ptr()};
+      for (unsigned int i = 0; i < 16; i++) m[i] = static_cast<GLfloat>(pm[i]);
+      glUniformMatrix4fv(mvpLoc[p], 1, GL_FALSE, m);
+      projectionChanged[p] = false;
+   }
+
+   glBindVertexArray(vao);
+   glBindBuffer(GL_ARRAY_BUFFER, vbo);
+   glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STREAM_DRAW);
+   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STREAM_DRAW);
+
+   // The display's line width and texture may have changed since the batch started
+   const GLfloat lw{display->getLinewidth()};
+   const bool setLw{batchLinewidth > 0.0f && batchLinewidth != lw};
+   if (setLw) glLineWidth(batchLinewidth);
+
+   GLint otex{};
+   if (batchTexture != 0) {
+      glGetIntegerv(GL_TEXTURE_BINDING_2D, &otex);
+      glBindTexture(GL_TEXTURE_2D, batchTexture);
+   }
+
+   const bool restart{batchMode == GL_LINE_STRIP || batchMode == GL_LINE_LOOP};
+   if (restart) {
+      glEnable(GL_PRIMITIVE_RESTART);
+      glPrimitiveRestartIndex(RESTART_INDEX);
+   }
+
+   glDrawElements(batchMode, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
+
+   if (restart) glDisable(GL_PRIMITIVE_RESTART);
+   if (batchTexture != 0) glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(otex));
+   if (setLw) glLineWidth(lw);
+
+   // back to the fixed function pipeline (compatibility profile)
+   glBindVertexArray(0);
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+   glUseProgram(0);
+#endif
+
+   vertices.clear();
+   indices.clear();
+}
+
+//------------------------------------------------------------------------------
+// Matrix functions
+//------------------------------------------------------------------------------
+void Renderer::ortho(const double left, const double right, const double bottom, const double top,
+                     const double zNear, const double zFar)
+{
+   if (buffered) {
+      flush();
+      projection.makeOrtho(left, right, bottom, top, zNear, zFar);
+      for (unsigned int i = 0; i < 3; i++) projectionChanged[i] = true;
+      modelview.back().makeIdentity();
+   }
+   if (!coreProfile) {
+      glMatrixMode(GL_PROJECTION);
+      glLoadIdentity();
+      glOrtho(left, right, bottom, top, zNear, zFar);
+      glMatrixMode(GL_MODELVIEW);
+      glLoadIdentity();
+   }
+}
+
+void Renderer::pushMatrix()
+{
+   if (buffered) modelview.push_back(modelview.back());
+   if (!coreProfile) glPushMatrix();
+}
+
+void Renderer::popMatrix()
+{
+   if (buffered && modelview.size() > 1) modelview.pop_back();
+   if (!coreProfile) glPopMatrix();
+}
+
+void Renderer::loadIdentity()
+{
+   if (buffered) modelview.back().makeIdentity();
+   if (!coreProfile) glLoadIdentity();
+}
+
+void Renderer::multMatrix(const base::Matrixd& mm)
+{
+   if (buffered) modelview.back() = mm * modelview.back();
+   if (!coreProfile) glMultMatrixd(mm.ptr());
+}
+
+void Renderer::translate(const double x, const double y, const double z)
+{
+   if (buffered) modelview.back().preMultTranslate(base::Vec3d(x, y, z));
+   if (!coreProfile) glTranslated(x, y, z);
+}
+
+void Renderer::rotate(const double angle, const double x, const double y, const double z)
+{
+   if (buffered) {
+      const double d2r{std::acos(-1.0) / 180.0};
+      modelview.back() = base::Matrixd::rotate(angle * d2r, x, y, z) * modelview.back();
+   }
+   if (!coreProfile) glRotated(angle, x, y, z);
+}
+
+void Renderer::scale(const double x, const double y, const double z)
+{
+   if (buffered) modelview.back() = base::Matrixd::scale(x, y, z) * modelview.back();
+   if (!coreProfile) glScaled(x, y, z);
+}
+
+//------------------------------------------------------------------------------
+// Primitive functions
+//------------------------------------------------------------------------------
+void Renderer::begin(const GLenum m)
+{
+   if (!buffered) {
+      glBegin(m);
+      return;
+   }
+
+   mode = m;
+   inPrimitive = true;
+   prim.clear();
+   const base::Vec4d& c{display->getCurrentColor()};
+   curColor[0] = toUbyte(c[0]);
+   curColor[1] = toUbyte(c[1]);
+   curColor[2] = toUbyte(c[2]);
+   curColor[3] = toUbyte(c[3]);
+}
+
+void Renderer::end()
+{
+   if (!buffered) {
+      glEnd();
+      return;
+   }
+
+   if (inPrimitive) addPrimitive();
+   inPrimitive = false;
+}
+
+void Renderer::vertex(const double x, const double y, const double z)
+{
+   if (!buffered) {
+      glVertex3d(x, y, z);
+      return;
+   }
+   if (!inPrimitive) return;
+
+   // Eye coordinates
+   const double* const m{modelview.back().ptr()};
+   double ex{m[0]*x + m[4]*y + m[8]*z  + m[12]};
+   double ey{m[1]*x + m[5]*y + m[9]*z  + m[13]};
+   double ez{m[2]*x + m[6]*y + m[10]*z + m[14]};
+   const double ew{m[3]*x + m[7]*y + m[11]*z + m[15]};
+   if (ew != 1.0 && ew != 0.0) {
+      ex /= ew;
+      ey /= ew;
+      ez /= ew;
+   }
+
+   Vertex v;
+   v.pos[0] = static_cast<GLfloat>(ex);
+   v.pos[1] = static_cast<GLfloat>(ey);
+   v.pos[2] = static_cast<GLfloat>(ez);
+   v.tex[0] = curTex[0];
+   v.tex[1] = curTex[1];
+   for (unsigned int i = 0; i < 4; i++) v.rgba[i] = curColor[i];
+   prim.push_back(v);
+}
+
+void Renderer::texCoord(const double s, const double t)
+{
+   if (!buffered) {
+      glTexCoord2d(s, t);
+      return;
+   }
+   curTex[0] = static_cast<GLfloat>(s);
+   curTex[1] = static_cast<GLfloat>(t);
+}
+
+void Renderer::color(const double r, const double g, const double b, const double a)
+{
+   if (!buffered) {
+      glColor4d(r, g, b, a);
+      return;
+   }
+   curColor[0] = toUbyte(r);
+   curColor[1] = toUbyte(g);
+   curColor[2] = toUbyte(b);
+   curColor[3] = toUbyte(a);
+}
+
+void Renderer::setTexture(const GLuint tex, const Program prog)
+{
+   texture = tex;
+   program = (tex != 0 ? prog : Program::SOLID);
+}
+
+//------------------------------------------------------------------------------
+// addPrimitive() -- adds the current primitive to the batch
+//------------------------------------------------------------------------------
+void Renderer::addPrimitive()
+{
+   const std::size_t n{prim.size()};
+
+   // Batch draw mode and the number of vertices that are used
+   GLenum dm{GL_TRIANGLES};
+   std::size_t nv{n};
+   switch (mode) {
+      case GL_POINTS:         dm = GL_POINTS;                     break;
+      case GL_LINES:          dm = GL_LINES;      nv = n - n % 2; break;
+      case GL_LINE_STRIP:     dm = GL_LINE_STRIP; if (n < 2) nv = 0; break;
+      case GL_LINE_LOOP:      dm = GL_LINE_LOOP;  if (n < 2) nv = 0; break;
+      case GL_TRIANGLES:      nv = n - n % 3;                     break;
+      case GL_QUADS:          nv = n - n % 4;                     break;
+      case GL_QUAD_STRIP:     nv = n - n % 2; if (nv < 4) nv = 0; break;
+      case GL_TRIANGLE_STRIP:
+      case GL_TRIANGLE_FAN:
+      case GL_POLYGON:        if (n < 3) nv = 0;                  break;
+      default:                nv = 0;                             break;
+   }
+   if (nv == 0) return;
+
+   // Line width only matters to lines
+   const bool lines{dm == GL_LINES || dm == GL_LINE_STRIP || dm == GL_LINE_LOOP};
+   const GLfloat lw{lines ? display->getLinewidth() : 0.0f};
+
+   // A new batch?
+   if ( !indices.empty() &&
+        (dm != batchMode || program != batchProgram || texture != batchTexture ||
+         lw != batchLinewidth || (vertices.size() + nv) > MAX_VERTICES) ) {
+      flush();
+   }
+   batchMode = dm;
+   batchProgram = program;
+   batchTexture = texture;
+   batchLinewidth = lw;
+
+   const auto base = static_cast<GLuint>(vertices.size());
+   vertices.insert(vertices.end(), prim.begin(), prim.begin() + nv);
+
+   switch (mode) {
+      case GL_POINTS:
+      case GL_LINES:
+      case GL_TRIANGLES: {
+         for (GLuint i = 0; i < nv; i++) indices.push_back(base + i);
+         break;
+      }
+      case GL_LINE_STRIP:
+      case GL_LINE_LOOP: {
+         if (!indices.empty()) indices.push_back(RESTART_INDEX);
+         for (GLuint i = 0; i < nv; i++) indices.push_back(base + i);
+         break;
+      }
+      case GL_TRIANGLE_STRIP: {
+         for (GLuint i = 2; i < nv; i++) {
+            if (i % 2 == 0) {
+               indices.push_back(base + i - 2);
+               indices.push_back(base + i - 1);
+            }
+            else {
+               indices.push_back(base + i - 1);
+               indices.push_back(base + i - 2);
+            }
+            indices.push_back(base + i);
+         }
+         break;
+      }
+      case GL_TRIANGLE_FAN:
+      case GL_POLYGON: {
+         for (GLuint i = 2; i < nv; i++) {
+            indices.push_back(base);
+            indices.push_back(base + i - 1);
+            indices.push_back(base + i);
+         }
+         break;
+      }
+      case GL_QUADS: {
+         for (GLuint i = 0; i < nv; i += 4) {
+            const GLuint q[6] = { 0, 1, 2, 0, 2, 3 };
+            for (const GLuint k : q) indices.push_back(base + i + k);
+         }
+         break;
+      }
+      case GL_QUAD_STRIP: {
+         for (GLuint i = 0; (i + 3) < nv; i += 2) {
+            const GLuint q[6] = { 0, 1, 3, 0, 3, 2 };
+            for (const GLuint k : q) indices.push_back(base + i + k);
+         }
+         break;
+      }
+      default: break;
+   }
+}
+
+}
+}
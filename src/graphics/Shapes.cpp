@@ -5,12 +5,102 @@
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/numeric/Number.hpp"
 #include "mixr/base/PairStream.hpp"
+#include "mixr/base/util/constants.hpp"
 #include "mixr/graphics/ColorGradient.hpp"
-#include <GL/glu.h>
+#include "mixr/graphics/Display.hpp"
+#include "mixr/graphics/Renderer.hpp"
+#include <cmath>
 
 namespace mixr {
 namespace graphics {
 
+namespace {
+
+//------------------------------------------------------------------------------
+// partialDisk() -- draws a disk, or a part of one, through the renderer, with
+// the same vertices as gluPartialDisk() (GLU_FILL or GLU_SILHOUETTE style)
+//------------------------------------------------------------------------------
+void partialDisk(Renderer* const r, const bool filled, const double innerRadius, const double outerRadius,
+                 int slices, const int loops, double startAngle, double sweepAngle)
+{
+   const int CACHE_SIZE{240};
+   if (slices >= CACHE_SIZE) slices = CACHE_SIZE - 1;
+   if (slices < 2 || loops < 1 || outerRadius <= 0.0 || innerRadius < 0.0 || innerRadius > outerRadius) return;
+
+   if (sweepAngle < -360.0) sweepAngle = 360.0;
+   if (sweepAngle > 360.0) sweepAngle = 360.0;
+   if (sweepAngle < 0.0) {
+      startAngle += sweepAngle;
+      sweepAngle = -sweepAngle;
+   }
+
+   const GLfloat deltaRadius{static_cast<GLfloat>(outerRadius - innerRadius)};
+
+   // vertex locations
+   GLfloat sinCache[CACHE_SIZE];
+   GLfloat cosCache[CACHE_SIZE];
+   const GLfloat angleOffset{static_cast<GLfloat>(startAngle / 180.0 * base::PI)};
+   for (int i = 0; i <= slices; i++) {
+      const GLfloat angle{static_cast<GLfloat>(angleOffset + ((base::PI * sweepAngle) / 180.0) * i / slices)};
+      sinCache[i] = static_cast<GLfloat>(std::sin(static_cast<double>(angle)));
+      cosCache[i] = static_cast<GLfloat>(std::cos(static_cast<double>(angle)));
+   }
+   if (sweepAngle == 360.0) {
+      sinCache[slices] = sinCache[0];
+      cosCache[slices] = cosCache[0];
+   }
+
+   if (filled) {
+      int finish{loops};
+      if (innerRadius == 0.0) {
+         // triangle fan for the inner loop
+         finish = loops - 1;
+         const GLfloat radiusLow{static_cast<GLfloat>(outerRadius - deltaRadius * (static_cast<GLfloat>(loops - 1) / loops))};
+         r->begin(GL_TRIANGLE_FAN);
+         r->vertex(0.0, 0.0);
+         for (int i = slices; i >= 0; i--) {
+            r->vertex(radiusLow * sinCache[i], radiusLow * cosCache[i]);
+         }
+         r->end();
+      }
+      for (int j = 0; j < finish; j++) {
+         const GLfloat radiusLow{static_cast<GLfloat>(outerRadius - deltaRadius * (static_cast<GLfloat>(j) / loops))};
+         const GLfloat radiusHigh{static_cast<GLfloat>(outerRadius - deltaRadius * (static_cast<GLfloat>(j + 1) / loops))};
+         r->begin(GL_QUAD_STRIP);
+         for (int i = 0; i <= slices; i++) {
+            r->vertex(radiusLow * sinCache[i], radiusLow * cosCache[i]);
+            r->vertex(radiusHigh * sinCache[i], radiusHigh * cosCache[i]);
+         }
+         r->end();
+      }
+   }
+   else {
+      // the radial edges, when it's not a full disk
+      if (sweepAngle < 360.0) {
+         for (int i = 0; i <= slices; i += slices) {
+            r->begin(GL_LINE_STRIP);
+            for (int j = 0; j <= loops; j++) {
+               const GLfloat radiusLow{static_cast<GLfloat>(outerRadius - deltaRadius * (static_cast<GLfloat>(j) / loops))};
+               r->vertex(radiusLow * sinCache[i], radiusLow * cosCache[i]);
+            }
+            r->end();
+         }
+      }
+      // the outer and inner edges
+      for (int i = 0; i <= 1; i++) {
+         const GLfloat radiusLow{static_cast<GLfloat>(outerRadius - deltaRadius * static_cast<GLfloat>(i))};
+         r->begin(GL_LINE_STRIP);
+         for (int j = 0; j <= slices; j++) {
+            r->vertex(radiusLow * sinCache[j], radiusLow * cosCache[j]);
+         }
+         r->end();
+         if (innerRadius == outerRadius) break;
+      }
+   }
+}
+
+}
+
 //==============================================================================
 // Class: Circle
 //==============================================================================
@@ -58,18 +148,31 @@ bool Circle::updateRadius(const base::Number* const x)
 void Circle::drawFunc()
 {
    BEGIN_DLIST
-   GLUquadricObj *qobj = gluNewQuadric();
-   if (filled) {
-      gluQuadricDrawStyle(qobj, GLU_FILL);
-   }
-   else {
-      gluQuadricDrawStyle(qobj, GLU_SILHOUETTE);
-   }
-   gluDisk( qobj, 0.,  radius, slices, 1);
-   gluDeleteQuadric(qobj);
+   partialDisk(getDisplay()->getRenderer(), filled, 0.0, radius, slices, 1, 0.0, 360.0);
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool Circle::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(Circle));
+}
+
+// Buffered draw (exact type only)
+bool Circle::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(Circle));
+}
+
+// Draw bounds
+bool Circle::getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+   const double r{std::fabs(radius)};
+   lo->set(-r, -r, 0.0);
+   hi->set( r,  r, 0.0);
+   return true;
+}
+
 // Set slot functions
 bool Circle::setSlotRadius(const base::Number* const x)
 {
@@ -123,18 +226,34 @@ void OcclusionCircle::copyData(const OcclusionCircle& org, const bool)
 void OcclusionCircle::drawFunc()
 {
    BEGIN_DLIST
-   GLUquadricObj* qobj = gluNewQuadric();
-   if (isFilled()) {
-      gluQuadricDrawStyle(qobj, GLU_FILL);
-   }
-   else {
-      gluQuadricDrawStyle(qobj, GLU_SILHOUETTE);
-   }
-   gluDisk( qobj, getRadius(),  outerRadius, getSlices(), 1);
-   gluDeleteQuadric(qobj);
+   partialDisk(getDisplay()->getRenderer(), isFilled(), getRadius(), outerRadius, getSlices(), 1, 0.0, 360.0);
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool OcclusionCircle::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(OcclusionCircle));
+}
+
+// Buffered draw (exact type only)
+bool OcclusionCircle::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(OcclusionCircle));
+}
+
+// Draw bounds
+bool OcclusionCircle::getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+   BaseClass::getDrawBounds(lo, hi);
+   const double r{std::fabs(outerRadius)};
+   if (r > (*hi)[0]) {
+      lo->set(-r, -r, 0.0);
+      hi->set( r,  r, 0.0);
+   }
+   return true;
+}
+
 // Set slot functions
 bool OcclusionCircle::setSlotOuterRadius(const base::Number* const x)
 {
@@ -179,23 +298,28 @@ void Arc::copyData(const Arc& org, const bool)
 void Arc::drawFunc()
 {
    BEGIN_DLIST
-   GLUquadricObj* qobj = gluNewQuadric();
-   if (isFilled()) {
-      gluQuadricDrawStyle(qobj, GLU_FILL);
-   }
-   else {
-      gluQuadricDrawStyle(qobj, GLU_SILHOUETTE);
-   }
+   Renderer* const r{getDisplay()->getRenderer()};
    if (connected) {
-      gluPartialDisk(qobj, 0, getRadius(), getSlices(), 2, startAngle, arcLength);
+      partialDisk(r, isFilled(), 0.0, getRadius(), getSlices(), 2, startAngle, arcLength);
    }
    else {
-      gluPartialDisk(qobj, getRadius(), getRadius(), getSlices(), 2, startAngle, arcLength);
+      partialDisk(r, isFilled(), getRadius(), getRadius(), getSlices(), 2, startAngle, arcLength);
    }
-   gluDeleteQuadric(qobj);
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool Arc::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(Arc));
+}
+
+// Buffered draw (exact type only)
+bool Arc::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(Arc));
+}
+
 // Set slot functions
 bool Arc::setSlotStartAngle(const base::Number* const x)
 {
@@ -250,18 +374,32 @@ void OcclusionArc::copyData(const OcclusionArc& org, const bool)
 void OcclusionArc::drawFunc()
 {
    BEGIN_DLIST
-   GLUquadricObj* qobj = gluNewQuadric();
-   if (isFilled()) {
-      gluQuadricDrawStyle(qobj, GLU_FILL);
-   }
-   else {
-      gluQuadricDrawStyle(qobj, GLU_SILHOUETTE);
-   }
+   partialDisk(getDisplay()->getRenderer(), isFilled(), getRadius(), outerRadius, getSlices(), 2, getStartAngle(), getArcLength());
+   END_DLIST
+}
 
-   gluPartialDisk(qobj, getRadius(), outerRadius, getSlices(), 2, getStartAngle(), getArcLength());
+// Static draw (exact type only)
+bool OcclusionArc::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(OcclusionArc));
+}
 
-   gluDeleteQuadric(qobj);
-   END_DLIST
+// Buffered draw (exact type only)
+bool OcclusionArc::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(OcclusionArc));
+}
+
+// Draw bounds
+bool OcclusionArc::getDrawBounds(base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+   BaseClass::getDrawBounds(lo, hi);
+   const double r{std::fabs(outerRadius)};
+   if (r > (*hi)[0]) {
+      lo->set(-r, -r, 0.0);
+      hi->set( r,  r, 0.0);
+   }
+   return true;
 }
 
 // Set slot functions
@@ -285,16 +423,29 @@ EMPTY_DELETEDATA(Point)
 void Point::drawFunc()
 {
    BEGIN_DLIST
+   Renderer* const r{getDisplay()->getRenderer()};
    const unsigned int n = getNumberOfVertices();
    const base::Vec3d* v = getVertices();
-   glBegin(GL_POINTS);
+   r->begin(GL_POINTS);
    for (unsigned int i = 0; i < n; i++) {
-      lcVertex3v( v[i].ptr() );
+      r->vertex( v[i] );
    }
-   glEnd();
+   r->end();
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool Point::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(Point));
+}
+
+// Buffered draw (exact type only)
+bool Point::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(Point));
+}
+
 
 //==============================================================================
 // Class: LineLoop
@@ -312,15 +463,28 @@ void LineLoop::drawFunc()
    const unsigned int n = getNumberOfVertices();
    const base::Vec3d* v = getVertices();
    if (n >= 2) {
-      glBegin(GL_LINE_LOOP);
+      Renderer* const r{getDisplay()->getRenderer()};
+      r->begin(GL_LINE_LOOP);
       for (unsigned int i = 0; i < n; i++) {
-         lcVertex3v( v[i].ptr() );
+         r->vertex( v[i] );
       }
-      glEnd();
+      r->end();
    }
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool LineLoop::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(LineLoop));
+}
+
+// Buffered draw (exact type only)
+bool LineLoop::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(LineLoop));
+}
+
 
 //==============================================================================
 // Class: Line
@@ -354,26 +518,39 @@ void Line::drawFunc()
    const unsigned int n = getNumberOfVertices();
    const base::Vec3d* v = getVertices();
    if (n >= 2) {
+      Renderer* const r{getDisplay()->getRenderer()};
       if (segment) {
          // Draw as line segments (pairs of vertices)
-         glBegin(GL_LINES);
+         r->begin(GL_LINES);
          for (unsigned int i = 0; i < n; i++) {
-            lcVertex3v( v[i].ptr() );
+            r->vertex( v[i] );
          }
-         glEnd();
+         r->end();
       }
       else {
          // Draw one long line
-         glBegin(GL_LINE_STRIP);
+         r->begin(GL_LINE_STRIP);
          for (unsigned int i = 0; i < n; i++) {
-            lcVertex3v( v[i].ptr() );
+            r->vertex( v[i] );
          }
-         glEnd();
+         r->end();
       }
    }
    END_DLIST
 }
 
+// Static draw (exact type only)
+bool Line::isStaticDraw() const
+{
+   return (typeid(*this) == typeid(Line));
+}
+
+// Buffered draw (exact type only)
+bool Line::isBufferedDraw() const
+{
+   return (typeid(*this) == typeid(Line));
+}
+
 // Set slot functions
 bool Line::setSlotSegments(const base::Boolean* const x)
 {
@@ -419,6 +596,7 @@ bool Quad::setSlotStrip(const base::Boolean* const x)
 
 void Quad::drawFunc()
 {
+    Renderer* const r{getDisplay()->getRenderer()};
     bool ok = false;
 
     // Draw with texture
@@ -429,7 +607,7 @@ void Quad::drawFunc()
             if (rem != 0) std::cerr << "Quad::drawFunc() - Quad have to have multiple of 4 vertices, add or remove vertices!!" << std::endl;
             else {
                 BEGIN_DLIST
-                glBegin(GL_QUADS);
+                r->begin(GL_QUADS);
                 ok = true;
             }
         }
@@ -438,7 +616,7 @@ void Quad::drawFunc()
             if (rem != 0) std::cerr << "Quad::drawFunc() - quad strips have to have multiple of 2 vertices, add or remove vertices!!" << std::endl;
             else {
                 BEGIN_DLIST
-                glBegin(GL_QUAD_STRIP);
+                r->begin(GL_QUAD_STRIP);
                 ok = true;
             }
         }
@@ -454,9 +632,9 @@ void Quad::drawFunc()
                 unsigned int tc = 0; // texture count
                 for (unsigned int i = 0; i < nv; i++) {
                     // add our textures coordinates
-                    if (tc < ntc)  lcTexCoord2v(texCoord[tc++].ptr());
+                    if (tc < ntc)  r->texCoord(texCoord[tc++]);
                     // now our vertices
-                    lcVertex3v( v[i].ptr() );
+                    r->vertex( v[i] );
                 }
 
             }
@@ -469,16 +647,13 @@ void Quad::drawFunc()
                     if (colGradient != nullptr) {
                         base::Color* col = colGradient->getColorByIdx(i+1);
                         if (col != nullptr)
-                            glColor4f(static_cast<GLfloat>(col->red()),
-                                      static_cast<GLfloat>(col->green()),
-                                      static_cast<GLfloat>(col->blue()),
-                                      static_cast<GLfloat>(col->alpha()));
+                            r->color(col->red(), col->green(), col->blue(), col->alpha());
                     }
                     // now add our vertex
-                    lcVertex3v( v[i].ptr() );
+                    r->vertex( v[i] );
                 }
             }
-            glEnd();
+            r->end();
             END_DLIST
         }
     }
@@ -486,6 +661,18 @@ void Quad::drawFunc()
     else std::cerr << "Quad::drawFunc() - Quad or QuadStrip needs at least 4 vertices!" << std::endl;
 }
 
+// Static draw (exact type only)
+bool Quad::isStaticDraw() const
+{
+    return (typeid(*this) == typeid(Quad));
+}
+
+// Buffered draw (exact type only)
+bool Quad::isBufferedDraw() const
+{
+    return (typeid(*this) == typeid(Quad));
+}
+
 //==============================================================================
 // Class: Triangle
 //==============================================================================
@@ -523,6 +710,7 @@ bool Triangle::setSlotFan(const base::Boolean* const x)
 
 void Triangle::drawFunc()
 {
+    Renderer* const r{getDisplay()->getRenderer()};
     // get our color gradient and apply it (if we have one)
     unsigned int nv {getNumberOfVertices()};
 
@@ -533,18 +721,18 @@ void Triangle::drawFunc()
             if (rem != 0) std::cerr << "Triangle::drawFunc() - Triangles have to have multiple of 3 vertices, add or remove vertices!!" << std::endl;
             else {
                 BEGIN_DLIST
-                glBegin(GL_TRIANGLES);
+                r->begin(GL_TRIANGLES);
                 ok = true;
             }
         }
         else if (fan) {
             BEGIN_DLIST
-            glBegin(GL_TRIANGLE_FAN);
+            r->begin(GL_TRIANGLE_FAN);
             ok = true;
         }
         else if (strip){
             BEGIN_DLIST
-            glBegin(GL_TRIANGLE_STRIP);
+            r->begin(GL_TRIANGLE_STRIP);
             ok = true;
         }
 
@@ -559,9 +747,9 @@ void Triangle::drawFunc()
                 unsigned int tc = 0; // texture count
                 for (unsigned int i = 0; i < nv; i++) {
                     // add our textures coordinates
-                    if (tc < ntc)  lcTexCoord2v(texCoord[tc++].ptr());
+                    if (tc < ntc)  r->texCoord(texCoord[tc++]);
                     // now our vertices
-                    lcVertex3v( v[i].ptr() );
+                    r->vertex( v[i] );
                 }
 
             }
@@ -574,21 +762,30 @@ void Triangle::drawFunc()
                     if (colGradient != nullptr) {
                         base::Color* col = colGradient->getColorByIdx(i+1);
                         if (col != nullptr)
-                            glColor4f(static_cast<GLfloat>(col->red()),
-                                      static_cast<GLfloat>(col->green()),
-                                      static_cast<GLfloat>(col->blue()),
-                                      static_cast<GLfloat>(col->alpha()));
+                            r->color(col->red(), col->green(), col->blue(), col->alpha());
                     }
                     // now add our vertex
-                    lcVertex3v( v[i].ptr() );
+                    r->vertex( v[i] );
                 }
             }
-            glEnd();
+            r->end();
             END_DLIST
         }
     }
     else std::cerr << "Triangle::drawFunc() - Triangle or Triangle needs at least 3 vertices!" << std::endl;
 }
 
+// Static draw (exact type only)
+bool Triangle::isStaticDraw() const
+{
+    return (typeid(*this) == typeid(Triangle));
+}
+
+// Buffered draw (exact type only)
+bool Triangle::isBufferedDraw() const
+{
+    return (typeid(*this) == typeid(Triangle));
+}
+
 }
 }
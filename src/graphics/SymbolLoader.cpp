@@ -4,32 +4,45 @@
 #include "mixr/graphics/Readouts.hpp"
 #include "mixr/graphics/Polygon.hpp"
 #include "mixr/graphics/Display.hpp"
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Renderer.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Float.hpp"
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/units/angles.hpp"
 #include "mixr/base/units/lengths.hpp"
 
 #include "mixr/base/util/str_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <iostream>
+#include <limits>
 
 namespace mixr {
 namespace graphics {
 
 IMPLEMENT_SUBCLASS(SymbolLoader, "SymbolLoader")
 
+const long long SymbolLoader::GRID_COLUMN;
+
 BEGIN_SLOTTABLE(SymbolLoader)
    "templates",         // 1) List of templates to use for navaids
    "showOnlyInRange",   // 2) only show symbols within map range
    "interconnect",      // 3) Interconnect the symbols
+   "maxSymbols",        // 4) Max number of active symbols (zero for no limit)
+   "instancing",        // 5) Draw unchanged symbols as instances of their template
 END_SLOTTABLE(SymbolLoader)
 
 BEGIN_SLOT_MAP(SymbolLoader)
    ON_SLOT(1, setSlotTemplates,       base::PairStream)
    ON_SLOT(2, setSlotShowInRangeOnly, base::Boolean)
    ON_SLOT(3, setSlotInterconnect,    base::Boolean)
+   ON_SLOT(4, setSlotMaxSymbols,      base::Integer)
+   ON_SLOT(5, setSlotInstancing,      base::Boolean)
 END_SLOT_MAP()
 
 SymbolLoader::SymbolLoader()
@@ -56,6 +69,8 @@ void SymbolLoader::copyData(const SymbolLoader& org, const bool)
 
    showInRangeOnly = org.showInRangeOnly;
    interconnect = org.interconnect;
+   maxSymbols = org.maxSymbols;
+   instancing = org.instancing;
 }
 
 void SymbolLoader::deleteData()
@@ -63,26 +78,58 @@ void SymbolLoader::deleteData()
    if (templates != nullptr) templates->unref();
    templates = nullptr;
 
-   // go through our whole array and 0 everyone out
-   for (int i = 0; i < MAX_SYMBOLS; i++) {
-      if (symbols[i] != nullptr) {
-         symbols[i]->setSymbolPair(nullptr);
-         symbols[i]->setValue(nullptr);
-         symbols[i]->unref();
+   // go through our whole table and 0 everyone out
+   for (SlSymbol* const sym : symbols) {
+      if (sym != nullptr) {
+         sym->setSymbolPair(nullptr);
+         sym->setValue(nullptr);
+         sym->unref();
       }
    }
+   symbols.clear();
+   drawModes.clear();
+   orders.clear();
+   freeEntries = std::priority_queue<int, std::vector<int>, std::greater<int>>();
+   numSymbols = 0;
+   graphicIndex.clear();
+
+   for (base::Pair* const pair : addedPairs) pair->unref();
+   addedPairs.clear();
+   removedGraphics.clear();
+
+   clearPrototypes();
+   instances.clear();
+   grid.clear();
+   gridValid = false;
 }
 
 //------------------------------------------------------------------------------
-// getNumberOfActiveSymbols() - returns the count of active symbols
+// setMaxSymbols() - sets the max number of active symbols (zero for no limit);
+// the current symbols are not removed
 //------------------------------------------------------------------------------
-int SymbolLoader::getNumberOfActiveSymbols() const
+bool SymbolLoader::setMaxSymbols(const int max)
 {
-   int num{};
-   for (int i = 0; i < MAX_SYMBOLS; i++) {
-      if (symbols[i] != nullptr) num++;
+   bool ok{};
+   if (max >= 0) {
+      maxSymbols = max;
+      ok = true;
    }
-   return num;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setInstancing() - sets the instanced drawing flag; when it's cleared, the
+// instances are drawn by their own graphical components again
+//------------------------------------------------------------------------------
+bool SymbolLoader::setInstancing(const bool x)
+{
+   instancing = x;
+   if (!instancing) {
+      for (DrawMode& mode : drawModes) mode = DrawMode::GRAPHIC;
+      instances.clear();
+      clearPrototypes();
+   }
+   return true;
 }
 
 //------------------------------------------------------------------------------
@@ -92,7 +139,7 @@ int SymbolLoader::getSymbolType(const int idx) const
 {
    int result{};
 
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr){
          result = symbols[i]->getType();
@@ -109,13 +156,8 @@ int SymbolLoader::getSymbolType(const int idx) const
 int SymbolLoader::getSymbolIndex(const graphics::Graphic* const mySymbol) const
 {
    int index{};
-   for (int i = 0; i < MAX_SYMBOLS; i++) {
-      if (symbols[i] != nullptr) {
-         base::Pair* p{symbols[i]->getSymbolPair()};
-         const auto graph = static_cast<graphics::Graphic*>(p->object());
-         if (mySymbol == graph) index = (i + 1);
-      }
-   }
+   const auto it = graphicIndex.find(mySymbol);
+   if (it != graphicIndex.end()) index = it->second;
    return index;
 }
 
@@ -145,25 +187,31 @@ SlSymbol* SymbolLoader::getSymbol(const int xPixel, const int yPixel)
       // our "snapping" cursor distance is basically 1 pixel in the y direction
       const double cursorDist{1.0 * inchPerPixHeight};
 
-      double symX{};
-      double symY{};
-      double distX{};
-      double distY{};
-      double dist{};
-      double lastDist{500000.0};
-
-      // now search our symbols for the closest symbol
-      for (int i = 0; i < MAX_SYMBOLS; i++) {
-         if (symbols[i] != nullptr) {
-            symX = symbols[i]->getScreenXPos();
-            symY = symbols[i]->getScreenYPos();
-            distX = symX - inchX;
-            distY = symY - inchY;
-            dist = (distX * distX) + (distY * distY);
-            if (dist < cursorDist) {
-               if (dist < lastDist) {
-                  lastDist = dist;
-                  id = i;
+      // The symbols within the cursor distance (its square root, since it's
+      // compared with the squared distance) are in the grid cells next to ours
+      const double cell{std::sqrt(cursorDist)};
+      if (cell > 0.0 && !std::isinf(cell)) {
+         updateGrid(cell);
+
+         const long long col{getGridCell(inchX, cell)};
+         const long long row{getGridCell(inchY, cell)};
+
+         double lastDist{500000.0};
+
+         // now search our symbols for the closest symbol
+         for (int i = -1; i <= 1; i++) {
+            const long long key{(col + i) * GRID_COLUMN + (row - 1)};
+            auto it = std::lower_bound(grid.begin(), grid.end(), std::make_pair(key, -1));
+            for ( ; it != grid.end() && it->first <= key + 2; ++it) {
+               const int j{it->second};
+               const double distX{symbols[j]->getScreenXPos() - inchX};
+               const double distY{symbols[j]->getScreenYPos() - inchY};
+               const double dist{(distX * distX) + (distY * distY)};
+               if (dist < cursorDist) {
+                  if (dist < lastDist || (dist == lastDist && j < id)) {
+                     lastDist = dist;
+                     id = j;
+                  }
                }
             }
          }
@@ -177,15 +225,50 @@ SlSymbol* SymbolLoader::getSymbol(const int xPixel, const int yPixel)
 }
 
 //------------------------------------------------------------------------------
-// addSymbol() - adds a symbol to our array list;
-// -- return the symbol's index; range [ 1 .. getMaxSymbols() ]
+// getGridCell() - grid column (or row) of the screen position 'v' (inches);
+// limited so that the keys of the cells next to it can't overflow
+//------------------------------------------------------------------------------
+long long SymbolLoader::getGridCell(const double v, const double cell)
+{
+   const double maxCell{static_cast<double>(std::numeric_limits<int>::max() - 2)};
+   return static_cast<long long>(std::max(-maxCell, std::min(maxCell, std::floor(v / cell))));
+}
+
+//------------------------------------------------------------------------------
+// updateGrid() - (re)builds the grid of the symbols' screen positions, with
+// cells that are 'cell' inches square, if the positions have changed
+//------------------------------------------------------------------------------
+void SymbolLoader::updateGrid(const double cell)
+{
+   if (gridValid && cell == gridCell) return;
+
+   // Key of each active symbol's cell: (column * GRID_COLUMN) + row
+   grid.clear();
+   const int n{getSymbolTableSize()};
+   for (int i = 0; i < n; i++) {
+      if (symbols[i] != nullptr) {
+         const double x{symbols[i]->getScreenXPos()};
+         const double y{symbols[i]->getScreenYPos()};
+         if (std::isnan(x) || std::isnan(y)) continue;
+         grid.emplace_back(getGridCell(x, cell) * GRID_COLUMN + getGridCell(y, cell), i);
+      }
+   }
+   std::sort(grid.begin(), grid.end());
+
+   gridCell = cell;
+   gridValid = true;
+}
+
+//------------------------------------------------------------------------------
+// addSymbol() - adds a symbol to our symbol table;
+// -- return the symbol's index; range [ 1 .. getSymbolTableSize() ]
 //    or zero if not added.
 //------------------------------------------------------------------------------
 int SymbolLoader::addSymbol(const int nType, const char* const id, int specName)
 {
    int idx{};
 
-   if (templates != nullptr) {
+   if (templates != nullptr && (maxSymbols == 0 || numSymbols < maxSymbols)) {
 
       // Find the graphic template for this type symbol, and make
       // sure that the template is a graphics::Graphic, since it
@@ -195,43 +278,57 @@ int SymbolLoader::addSymbol(const int nType, const char* const id, int specName)
          const auto tg = dynamic_cast<graphics::Graphic*>(tpair->object());
          if (tg != nullptr) {
 
-            // Find an empty symbol slot in our master symbol table
-            for (int i = 0; i < MAX_SYMBOLS && idx == 0; i++) {
-               if ( symbols[i] == nullptr ) {
-
-                  // Create a new SlSymbol object to manage this symbol.
-                  symbols[i] = symbolFactory();
-
-                  // Clone the graphic template and set it as the
-                  // symbol's graphical component.
-                  base::Pair* newPair{tpair->clone()};
-                  const auto newGraph = static_cast<graphics::Graphic*>(newPair->object());
-
-                  // Set the new graphical component's select name
-                  GLuint mySelName {};
-                  if (specName > 0) mySelName = specName;
-                  else mySelName = graphics::Graphic::getNewSelectName();
-                  newGraph->setSelectName(mySelName);
-
-                  // Add the symbol's graphical component to our component list.
-                  {
-                     base::PairStream* comp{getComponents()};
-                     base::Component::processComponents(comp, typeid(graphics::Graphic), newPair);
-                     if (comp != nullptr) comp->unref();
-                  }
-
-                  // Set the symbol's graphical component pointer
-                  symbols[i]->setSymbolPair( newPair );
-                  newPair->unref(); // symbol[i] now owns it.
-
-                  // Set the symbol's type and ID.
-                  symbols[i]->setType( nType );
-                  symbols[i]->setId( id );
-
-                  // And this is the new symbol's index
-                  idx = (i + 1);
-               }
+            // Use the lowest unused entry in our master symbol table,
+            // or add a new one
+            int i{};
+            if (!freeEntries.empty()) {
+               i = freeEntries.top();
+               freeEntries.pop();
+            }
+            else {
+               i = getSymbolTableSize();
+               symbols.push_back(nullptr);
+               drawModes.push_back(DrawMode::PENDING);
+               orders.push_back(0);
             }
+
+            // Create a new SlSymbol object to manage this symbol.
+            symbols[i] = symbolFactory();
+            numSymbols++;
+
+            // Clone the graphic template and set it as the
+            // symbol's graphical component.
+            base::Pair* newPair{tpair->clone()};
+            const auto newGraph = static_cast<graphics::Graphic*>(newPair->object());
+
+            // Set the new graphical component's select name
+            GLuint mySelName {};
+            if (specName > 0) mySelName = specName;
+            else mySelName = graphics::Graphic::getNewSelectName();
+            newGraph->setSelectName(mySelName);
+
+            // It's unchanged from its template (so far); see draw()
+            newGraph->clearDirty();
+            drawModes[i] = (instancing ? DrawMode::PENDING : DrawMode::GRAPHIC);
+            orders[i] = numAdded++;
+
+            // Add the symbol's graphical component to our component list
+            // (by updateComponents())
+            newPair->ref();
+            addedPairs.push_back(newPair);
+
+            // Set the symbol's graphical component pointer
+            symbols[i]->setSymbolPair( newPair );
+            newPair->unref(); // symbol[i] now owns it.
+            graphicIndex[newGraph] = (i + 1);
+
+            // Set the symbol's type and ID.
+            symbols[i]->setType( nType );
+            symbols[i]->setId( id );
+
+            // And this is the new symbol's index
+            idx = (i + 1);
+            gridValid = false;
          }
       }
    }
@@ -247,7 +344,7 @@ bool SymbolLoader::setSymbolType(const int idx, const int nType)
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
 
@@ -272,16 +369,22 @@ bool SymbolLoader::setSymbolType(const int idx, const int nType)
                   GLuint mySelName{oldG->getSelectName()};
                   newGraph->setSelectName(mySelName);
 
+                  // It's unchanged from its template (so far); see draw()
+                  newGraph->clearDirty();
+                  drawModes[i] = (instancing ? DrawMode::PENDING : DrawMode::GRAPHIC);
+                  orders[i] = numAdded++;
+
                   // Add the new and remove the old components from our subcomponent list
-                  {
-                     base::PairStream* comp = getComponents();
-                     base::Component::processComponents(comp, typeid(graphics::Graphic), newPair, oldG);
-                     if (comp != nullptr) comp->unref();
-                  }
+                  // (by updateComponents())
+                  newPair->ref();
+                  addedPairs.push_back(newPair);
+                  removedGraphics.insert(oldG);
+                  graphicIndex.erase(oldG);
 
                   // Set the symbol's graphical component pointer
                   symbols[i]->setSymbolPair( newPair );
                   newPair->unref(); // symbol[i] now owns it.
+                  graphicIndex[newGraph] = idx;
 
                   // Set new type
                   symbols[i]->setType( nType );
@@ -305,21 +408,21 @@ bool SymbolLoader::removeSymbol(const int idx)
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i {idx - 1};
       if (symbols[i] != nullptr) {
 
          // ---
          // remove the symbol's graphical component from our subcomponent list
+         // (by updateComponents())
          // ---
          {
             // Get the symbol's graphical component
             base::Pair* pair{symbols[i]->getSymbolPair()};
             const auto g = static_cast<graphics::Graphic*>(pair->object());
 
-            base::PairStream* x = getComponents();
-            base::Component::processComponents(x, typeid(graphics::Graphic), nullptr, g);
-            x->unref();
+            removedGraphics.insert(g);
+            graphicIndex.erase(g);
          }
 
          // ---
@@ -328,6 +431,9 @@ bool SymbolLoader::removeSymbol(const int idx)
          symbols[i]->setSymbolPair(nullptr);
          symbols[i]->unref();
          symbols[i] = nullptr;
+         freeEntries.push(i);
+         numSymbols--;
+         gridValid = false;
 
          ok = true;
       }
@@ -341,12 +447,54 @@ bool SymbolLoader::removeSymbol(const int idx)
 bool SymbolLoader::clearLoader()
 {
    bool ok{};
-   for (int idx = 1; idx <= MAX_SYMBOLS; idx++) {
+   const int n{getSymbolTableSize()};
+   for (int idx = 1; idx <= n; idx++) {
       removeSymbol(idx);
    }
+
+   // (and start again with an empty table)
+   symbols.clear();
+   drawModes.clear();
+   orders.clear();
+   freeEntries = std::priority_queue<int, std::vector<int>, std::greater<int>>();
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// updateComponents() - adds (and removes) the symbols' graphical components
+// to (and from) our component list
+//------------------------------------------------------------------------------
+void SymbolLoader::updateComponents()
+{
+   if (addedPairs.empty() && removedGraphics.empty()) return;
+
+   const auto list = new base::PairStream();
+
+   // Our current components, less the removed graphics
+   base::PairStream* comp{getComponents()};
+   if (comp != nullptr) {
+      base::List::Item* item{comp->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<base::Pair*>(item->getValue());
+         if (removedGraphics.count(pair->object()) == 0) list->put(pair);
+         else static_cast<base::Component*>(pair->object())->container(nullptr);
+         item = item->getNext();
+      }
+      comp->unref();
+   }
+
+   // and the added graphics (unless they've already been removed)
+   for (base::Pair* const pair : addedPairs) {
+      if (removedGraphics.count(pair->object()) == 0) list->put(pair);
+      pair->unref();
+   }
+   addedPairs.clear();
+   removedGraphics.clear();
+
+   processComponents(list, typeid(graphics::Graphic));
+   list->unref();
+}
+
 //------------------------------------------------------------------------------
    // Sets the show in-range symbols only flag
 //------------------------------------------------------------------------------
@@ -362,7 +510,7 @@ bool SymbolLoader::setShowInRangeOnly(const bool x)
 bool SymbolLoader::updateSymbolPositionLL(const int idx, const double nLat, const double nLon)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setXPosition( nLat );
@@ -383,7 +531,7 @@ bool SymbolLoader::updateSymbolPositionLL(const int idx, const double nLat, cons
 bool SymbolLoader::updateSymbolPositionXY(const int idx, const double xPos, const double yPos)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setXPosition( xPos );
@@ -403,7 +551,7 @@ bool SymbolLoader::updateSymbolPositionXY(const int idx, const double xPos, cons
 bool SymbolLoader::updateSymbolPositionXYAircraft(const int idx, const double xPos, const double yPos)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setXPosition( xPos );
@@ -425,7 +573,7 @@ bool SymbolLoader::updateSymbolPositionXYAircraft(const int idx, const double xP
 bool SymbolLoader::updateSymbolPositionXYScreen(const int idx, const double xPos, const double yPos)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setXScreenPos( xPos );
@@ -433,6 +581,7 @@ bool SymbolLoader::updateSymbolPositionXYScreen(const int idx, const double xPos
          symbols[i]->setLatLonFlag(false);
          symbols[i]->setACCoordFlag(false);
          symbols[i]->setScreenFlag(true);
+         gridValid = false;
          ok = true;
       }
    }
@@ -446,7 +595,7 @@ bool SymbolLoader::updateSymbolPositionXYScreen(const int idx, const double xPos
 bool SymbolLoader::updateSymbolHeading(const int idx, const double hdg)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setHeadingDeg( hdg );
@@ -462,7 +611,7 @@ bool SymbolLoader::updateSymbolHeading(const int idx, const double hdg)
 bool SymbolLoader::updateSymbolValue(const int idx, base::Object* const value)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          symbols[i]->setValue( value );
@@ -480,7 +629,7 @@ bool SymbolLoader::updateSymbolText(const int idx, const char* name, const char
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i {idx - 1};
       if (symbols[i] != nullptr) {
 
@@ -529,7 +678,7 @@ bool SymbolLoader::updateSymbolText(const int idx, const char* name, const doubl
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
 
@@ -579,16 +728,18 @@ bool SymbolLoader:: setSymbolVisible(const int idx, const char* name, bool visib
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          // if no name is passed, the symbol is invisible, otherwise just
          // parts are
          if (name == nullptr) symbols[i]->setVisible(visibility);
 
-         // Get its graphical component
+         // Get its graphical component (unless it's instanced, and then
+         // draw() sets its top level visibility)
          base::Pair* p{symbols[i]->getSymbolPair()};
-         if (p != nullptr) {
+         if (name == nullptr && drawModes[i] != DrawMode::GRAPHIC) ok = true;
+         else if (p != nullptr) {
             auto g = static_cast<graphics::Graphic*>(p->object());
             if (g != nullptr) {
 
@@ -625,7 +776,7 @@ bool SymbolLoader::setSymbolFlashRate(const int idx, const char* name, const dou
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
 
@@ -666,7 +817,7 @@ bool SymbolLoader::setSymbolColor(const int idx, const char* name, const base::C
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if(symbols[i] != nullptr) {
 
@@ -708,7 +859,7 @@ bool SymbolLoader::setSymbolColor(const int idx, const char* name, const base::I
    bool ok{};
 
    // Find the symbol
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if(symbols[i] != nullptr) {
 
@@ -748,13 +899,18 @@ bool SymbolLoader::setSymbolColor(const int idx, const char* name, const base::I
 bool SymbolLoader::updateSymbolSelectName(const int idx, const int newSN)
 {
    bool ok{};
-   if (idx >= 1 && idx <= MAX_SYMBOLS) {
+   if (idx >= 1 && idx <= getSymbolTableSize()) {
       const int i{idx - 1};
       if (symbols[i] != nullptr) {
          const auto pair = static_cast<base::Pair*>(symbols[i]->getSymbolPair());
          if (pair != nullptr) {
             const auto graphic = static_cast<graphics::Graphic*>(pair->object());
-            if (graphic != nullptr) graphic->setSelectName(newSN);
+            if (graphic != nullptr) {
+               // (an instanced symbol's graphic is still unchanged from its template)
+               const bool unchanged{!graphic->isDirty()};
+               graphic->setSelectName(newSN);
+               if (unchanged) graphic->clearDirty();
+            }
          }
          ok = true;
 
@@ -785,6 +941,17 @@ void SymbolLoader::updateTC(const double)
    // functions.
 }
 
+//------------------------------------------------------------------------------
+// updateData() - update non-time critical stuff here
+//------------------------------------------------------------------------------
+void SymbolLoader::updateData(const double dt)
+{
+   // Add (and remove) our symbols' graphical components
+   updateComponents();
+
+   BaseClass::updateData(dt);
+}
+
 
 //------------------------------------------------------------------------------
 // drawFunc() - interconnects the symbols (if we are interconnecting)
@@ -794,15 +961,37 @@ void SymbolLoader::drawFunc()
     if (interconnect) {
         glPushMatrix();
         glBegin(GL_LINE_STRIP);
-        for (int i = 0; i < MAX_SYMBOLS; i++) {
-            if (symbols[i] != nullptr)
-                glVertex2f(static_cast<GLfloat>(symbols[i]->getScreenXPos()),
-                           static_cast<GLfloat>(symbols[i]->getScreenYPos()));
+        for (const SlSymbol* const sym : symbols) {
+            if (sym != nullptr)
+                glVertex2f(static_cast<GLfloat>(sym->getScreenXPos()),
+                           static_cast<GLfloat>(sym->getScreenYPos()));
         }
         glEnd();
         glPopMatrix();
     }
     BaseClass::drawFunc();
+
+    // Symbols that are drawn as instances of their template's prototype,
+    // in place of their own graphical components (see draw())
+    if (!instances.empty()) {
+        Display* const dsp{getDisplay()};
+        Renderer* const r{dsp->getRenderer()};
+        PickIndex* const pi{dsp->getPickIndex()};
+        for (const Instance& inst : instances) {
+            r->pushMatrix();
+            r->translate(inst.x, inst.y);
+            if (inst.selName > 0) {
+                glPushName(inst.selName);
+                pi->pushName(inst.selName, inst.proto, false);
+            }
+            inst.proto->draw();
+            if (inst.selName > 0) {
+                pi->popName();
+                glPopName();
+            }
+            r->popMatrix();
+        }
+    }
 }
 
 
@@ -823,20 +1012,43 @@ void SymbolLoader::draw()
       else radius = getOuterRadius();
       double radius2{radius * radius};
 
+      // Add (and remove) our symbols' graphical components
+      updateComponents();
+
       // ---
       // Setup the drawing parameters for all of our symbols ...
       // ---
-      for (int i = 0; i < MAX_SYMBOLS; i++) {
+      instances.clear();
+      const int n{getSymbolTableSize()};
+      for (int i = 0; i < n; i++) {
 
          if (symbols[i] != nullptr) {
 
+            // Get the pointer to the symbol's graphical component
+            base::Pair* p{symbols[i]->getSymbolPair()};
+            const auto g = static_cast<graphics::Graphic*>(p->object());
+
+            // Draw the symbol as an instance of its template's prototype,
+            // until its graphical component changes (see Note 9)
+            Graphic* proto{};
+            if (drawModes[i] != DrawMode::GRAPHIC) {
+               if (!g->isDirty() && symbols[i]->getValue() == nullptr && !symbols[i]->isHeadingValid()) {
+                  proto = getPrototype(symbols[i]->getType());
+               }
+               if (proto == nullptr) {
+                  drawModes[i] = DrawMode::GRAPHIC;
+               }
+               else if (drawModes[i] == DrawMode::PENDING) {
+                  // (its own graphical component is not drawn, and it's unchanged)
+                  g->setVisibility(false);
+                  g->clearDirty();
+                  drawModes[i] = DrawMode::INSTANCE;
+               }
+            }
+
             // When the symbol visibility flag is true ...
             if (symbols[i]->isVisible()) {
 
-               // Get the pointer to the symbol's graphical component
-               base::Pair* p{symbols[i]->getSymbolPair()};
-               const auto g = static_cast<graphics::Graphic*>(p->object());
-
                // We need the symbol's position in screen coordinates (inches) ...
                auto xScn = static_cast<double>(symbols[i]->getScreenXPos());
                auto yScn = static_cast<double>(symbols[i]->getScreenYPos());
@@ -878,6 +1090,9 @@ void SymbolLoader::draw()
                   aircraft2Screen(acX, acY, &xScn, &yScn);
 
                   // 4) Save the screen coordinates (inches)
+                  if (xScn != symbols[i]->getScreenXPos() || yScn != symbols[i]->getScreenYPos()) {
+                     gridValid = false;
+                  }
                   symbols[i]->setXScreenPos(xScn);
                   symbols[i]->setYScreenPos(yScn);
                }
@@ -885,7 +1100,17 @@ void SymbolLoader::draw()
                // In range?  Do we care?
                bool inRange{!showInRangeOnly || (((xScn * xScn) + (yScn * yScn)) <= radius2)};
 
-               if (inRange) {
+               if (inRange && drawModes[i] == DrawMode::INSTANCE) {
+                  // drawn by our drawFunc()
+                  Instance inst;
+                  inst.proto = proto;
+                  inst.selName = g->getSelectName();
+                  inst.x = xScn;
+                  inst.y = yScn + displacement;
+                  inst.order = orders[i];
+                  instances.push_back(inst);
+               }
+               else if (inRange) {
 
                   // set symbol's visibility
                   g->setVisibility(true);
@@ -924,21 +1149,25 @@ void SymbolLoader::draw()
                         angNum->unref();
                      }
                   }
-               } else {
+               } else if (drawModes[i] == DrawMode::GRAPHIC) {
                   // out of range, so clear the graphical component's visibility flag
                   g->setVisibility(false);
                }
             }
 
             // When the symbol visibility flag is false ...
-            else {
-               base::Pair* p{symbols[i]->getSymbolPair()};
-               const auto g = static_cast<graphics::Graphic*>(p->object());
+            else if (drawModes[i] == DrawMode::GRAPHIC) {
                g->setVisibility(false);
             }
          }
       }
 
+      // Instances are drawn in the order of their graphical components
+      const auto byOrder = [](const Instance& a, const Instance& b) { return a.order < b.order; };
+      if (!std::is_sorted(instances.begin(), instances.end(), byOrder)) {
+         std::sort(instances.begin(), instances.end(), byOrder);
+      }
+
       // ---
       // Let our base class handle the drawing
       // ---
@@ -947,7 +1176,7 @@ void SymbolLoader::draw()
       // ---
       // now restore the matrices on all of our graphical components
       // ---
-      for (int i = 0; i < MAX_SYMBOLS; i++) {
+      for (int i = 0; i < n; i++) {
          if (symbols[i] != nullptr) {
             base::Pair* p{symbols[i]->getSymbolPair()};
             const auto g = static_cast<graphics::Graphic*>(p->object());
@@ -963,16 +1192,58 @@ void SymbolLoader::draw()
 //------------------------------------------------------------------------------
 int SymbolLoader::getSymbols(base::safe_ptr<SlSymbol>* const newSyms, const int max)
 {
-   int numSymbols{};
-   if (max > 0) {
-      for(int i = 0; i < MAX_SYMBOLS; i++) {
-         if (symbols[i] != nullptr) {
-            newSyms[i] = symbols[i];
-            numSymbols = i;
+   int num{};
+   const int n{getSymbolTableSize()};
+   for (int i = 0; i < n && num < max; i++) {
+      if (symbols[i] != nullptr) {
+         newSyms[num++] = symbols[i];
+      }
+   }
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// getPrototype() - returns the prototype copy of the template for the symbol
+// type 'nType', or zero if its symbols can't be drawn as instances
+//------------------------------------------------------------------------------
+Graphic* SymbolLoader::getPrototype(const int nType)
+{
+   const auto it = protos.find(nType);
+   if (it != protos.end()) return it->second;
+
+   Graphic* proto{};
+   if (templates != nullptr) {
+      base::Pair* tpair{templates->getPosition(nType)};
+      if (tpair != nullptr) {
+         const auto tg = dynamic_cast<graphics::Graphic*>(tpair->object());
+         if (tg != nullptr) {
+            // (drawn by our drawFunc(), but it's not one of our components)
+            proto = tg->clone();
+            proto->container(this);
+            if (!proto->isStaticSubtree()) {
+               proto->container(nullptr);
+               proto->unref();
+               proto = nullptr;
+            }
          }
       }
    }
-   return numSymbols;
+   protos[nType] = proto;
+   return proto;
+}
+
+//------------------------------------------------------------------------------
+// clearPrototypes() - clears the template prototypes
+//------------------------------------------------------------------------------
+void SymbolLoader::clearPrototypes()
+{
+   for (const auto& proto : protos) {
+      if (proto.second != nullptr) {
+         proto.second->container(nullptr);
+         proto.second->unref();
+      }
+   }
+   protos.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -987,6 +1258,10 @@ bool SymbolLoader::setSlotTemplates(base::PairStream* msg)
       if (templates != nullptr) templates->unref();
       templates = msg;
       if (templates != nullptr) templates->ref();
+
+      // The current symbols were cloned from the old templates
+      clearPrototypes();
+      for (DrawMode& mode : drawModes) mode = DrawMode::GRAPHIC;
       ok = true;
    }
    return ok;
@@ -1008,6 +1283,30 @@ bool SymbolLoader::setSlotInterconnect(const base::Boolean* const msg)
    return ok;
 }
 
+// Max number of active symbols
+bool SymbolLoader::setSlotMaxSymbols(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMaxSymbols(msg->asInt());
+      if (!ok) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "SymbolLoader::setSlotMaxSymbols(): invalid max symbols: " << msg->asInt()
+                      << "; must be zero (no limit) or more" << std::endl;
+         }
+      }
+   }
+   return ok;
+}
+
+// Instanced drawing flag
+bool SymbolLoader::setSlotInstancing(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setInstancing(msg->asBool());
+   return ok;
+}
+
 
 //==============================================================================
 // class SlSymbol
@@ -1,5 +1,7 @@
 
 #include "mixr/graphics/Translator.hpp"
+#include "mixr/graphics/Display.hpp"
+#include "mixr/graphics/Renderer.hpp"
 
 #include "mixr/base/numeric/Number.hpp"
 #include <iostream>
@@ -37,10 +39,19 @@ void Translator::copyData(const Translator& org, const bool)
 void Translator::draw()
 {
     // we are just translating here
-    glPushMatrix();
-        glTranslated(static_cast<double>(myXPos), static_cast<double>(myYPos), static_cast<double>(myZPos));
+    Renderer* const r{getDisplay()->getRenderer()};
+    r->pushMatrix();
+        r->translate(myXPos, myYPos, myZPos);
         Graphic::draw();
-    glPopMatrix();
+    r->popMatrix();
+}
+
+//------------------------------------------------------------------------------
+// isBufferedDraw() -- buffered draw (exact type only)
+//------------------------------------------------------------------------------
+bool Translator::isBufferedDraw() const
+{
+    return (typeid(*this) == typeid(Translator));
 }
 
 // EVENT functions
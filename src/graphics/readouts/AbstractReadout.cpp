@@ -4,6 +4,7 @@
 #include "mixr/graphics/Display.hpp"
 #include "mixr/graphics/Page.hpp"
 #include "mixr/graphics/Display.hpp"
+#include "mixr/graphics/fonts/AbstractFont.hpp"
 
 #include "mixr/base/Identifier.hpp"
 #include "mixr/base/List.hpp"
@@ -13,6 +14,9 @@
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace mixr {
 namespace graphics {
 
@@ -457,6 +461,60 @@ void AbstractReadout::drawFunc()
         dsp->setColor(ocolor);
 }
 
+//------------------------------------------------------------------------------
+// getPickBounds() -- the character cells of our text (and brackets)
+//------------------------------------------------------------------------------
+bool AbstractReadout::getPickBounds(Display* const dsp, base::Vec3d* const lo, base::Vec3d* const hi) const
+{
+    // Nothing is drawn
+    lo->set(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    *hi = -(*lo);
+    const int n {static_cast<int>(str.len())};
+    if (n == 0) return true;
+
+    // Same font and position as drawFunc()
+    const AbstractFont* font {};
+    if (!fontName.empty()) font = dsp->getFont(fontName.c_str());
+    if (font == nullptr) font = dsp->getNormalFont();
+    if (font == nullptr) return false;
+
+    int ll {line()};
+    int cc {column()};
+    const auto parent = dynamic_cast<const AbstractReadout*>(container());
+    if (ll == 0 && parent != nullptr) {
+        ll = parent->line();
+        cc = parent->column();
+    }
+
+    const double dx {font->getCharacterSpacing()};
+    const double dy {font->getLineSpacing()};
+    const bool positioned {ll > 0 && cc > 0};
+    double x {};
+    double y {};
+    if (positioned) font->position(ll, cc, x, y);
+
+    // Cells before and after our text: none, or the brackets (which are
+    // drawn at offsets -1 and width())
+    const int before {(positioned && areBracketsOn()) ? 1 : 0};
+    const int after {before ? (std::max(n, static_cast<int>(width())) + 1 - n) : 0};
+
+    if (isVertical()) {
+        lo->set(x, y - (n - 1 + after) * dy, 0.0);
+        hi->set(x + dx, y + (1 + before) * dy, 0.0);
+    }
+    else {
+        lo->set(x - before * dx, y, 0.0);
+        hi->set(x + (n + after) * dx, y + dy, 0.0);
+    }
+
+    // The glyphs (e.g., descenders) can be drawn outside of their cells, so
+    // pad the bounds by a glyph (the bounds only need to contain the drawing)
+    const base::Vec3d pad {std::max(dx, font->getFontWidth()), std::max(dy, font->getFontHeight()), 0.0};
+    *lo -= pad;
+    *hi += pad;
+    return true;
+}
+
 //------------------------------------------------------------------------------
 // setPosition() -- set position: [ Line Column ]
 //------------------------------------------------------------------------------
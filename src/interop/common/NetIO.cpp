@@ -590,8 +590,7 @@ Nib* NetIO::createNewOutputNib(models::Player* const player)
 
       std::string fName{getFederateName()};
       if (player->isProxyPlayer()) {
-         const auto pNib = dynamic_cast<Nib*>(player->getNib());
-         fName = pNib->getFederateName();
+         fName = player->getNib()->getFederateName();
       }
       nib->setFederateName(fName);
 
@@ -766,8 +765,7 @@ Nib* NetIO::findNib(const models::Player* const player, const IoType ioType)
       std::string fName{getFederateName()};
       if (player->isProxyPlayer()) {
          // If networked, used original IDs
-         const auto pNib = dynamic_cast<const Nib*>(player->getNib());
-         fName = pNib->getFederateName();
+         fName = player->getNib()->getFederateName();
       }
       // Now find the NIB using the player's IDs
       found = findNib(player->getID(), fName, ioType);
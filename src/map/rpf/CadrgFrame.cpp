@@ -2,13 +2,44 @@
 #include "mixr/map/rpf/CadrgFrame.hpp"
 
 #include "mixr/map/rpf/CadrgFrameEntry.hpp"
+#include "mixr/map/rpf/CadrgClut.hpp"
 #include "mixr/base/String.hpp"
+#include "mixr/base/util/atomics.hpp"
 
 #include <cstring>
+#include <memory>
+#include <streambuf>
+#include <vector>
 
 namespace mixr {
 namespace rpf {
 
+namespace {
+// Read-only stream buffer over a frame file's contents
+class MemoryBuffer : public std::streambuf
+{
+public:
+    MemoryBuffer(const char* const data, const std::size_t size) {
+        char* const p {const_cast<char*>(data)};
+        setg(p, p, p + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+        off_type pos {off};
+        if (dir == std::ios_base::cur) pos += (gptr() - eback());
+        else if (dir == std::ios_base::end) pos += (egptr() - eback());
+        if (pos < 0 || pos > (egptr() - eback())) return pos_type(off_type(-1));
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+}
+
 IMPLEMENT_SUBCLASS(CadrgFrame, "CadrgFrame")
 EMPTY_SLOTTABLE(CadrgFrame)
 
@@ -28,12 +59,14 @@ void CadrgFrame::copyData(const CadrgFrame& org, const bool)
         frameEntry->ref();
     }
     nitfHdrLength = org.nitfHdrLength;
+    clearCodebooks();
 }
 
 void CadrgFrame::deleteData()
 {
     if (frameEntry != nullptr) frameEntry->unref();
     frameEntry = nullptr;
+    clearCodebooks();
 }
 
 // -------------------------------------------------------------------------------------
@@ -81,20 +114,32 @@ void CadrgFrame::load(CadrgFrameEntry* entry)
        return;
     }
 
-    #if defined(WIN32)
-        std::ifstream   fin(string->c_str(), std::ios::in | std::ios::binary);
-    #else
-        std::ifstream   fin(string->c_str(), std::ios::in);
-    #endif
-
-    if (fin.fail()) {
-        std::cout << "CadrgFrame::load() : No filename " << *string << ", or directory found!  Error in reading the frame!" << std::endl;
-        fin.close();
-        return;
+    // Read the frame file with a single read, and then parse it from memory
+    std::vector<char> data;
+    {
+        std::ifstream file(string->c_str(), std::ios::in | std::ios::binary);
+        if (file.fail()) {
+            std::cout << "CadrgFrame::load() : No filename " << *string << ", or directory found!  Error in reading the frame!" << std::endl;
+            string->unref();
+            return;
+        }
+        file.seekg(0, std::ios::end);
+        const std::streamoff size {file.tellg()};
+        file.seekg(0, std::ios::beg);
+        if (size > 0) {
+            data.resize(static_cast<std::size_t>(size));
+            file.read(data.data(), size);
+        }
     }
 
     string->unref();
 
+    // New lookup table
+    clearCodebooks();
+
+    MemoryBuffer buffer(data.data(), data.size());
+    std::istream fin(&buffer);
+
     // National Imagery Transmission Format (NITF)  header check - skipped for now (SLS),
     // assume no NITF hdr
     nitfHdrLength = NITF_HDR_NONE;
@@ -312,8 +357,6 @@ void CadrgFrame::load(CadrgFrameEntry* entry)
             }
         }
     }
-
-    fin.close();
 }
 
 
@@ -377,6 +420,105 @@ int CadrgFrame::decompressSubframe(int x, int y, Subframe& subFrame)
     return 1;
 }
 
+// -------------------------------------------------------------------------------------
+// decodeSubframe() - Decode our subframe image directly to texels, in the order of
+// CadrgMap::subframeToTexels(); subframe image [j][i] is texel [255 - i][j]
+// -------------------------------------------------------------------------------------
+int CadrgFrame::decodeSubframe(const int x, const int y, const CadrgClut& clut, unsigned char* const texels, const int numComponents)
+{
+    if (texels == nullptr || (numComponents != 3 && numComponents != 4)) return 0;
+
+    const int nc {numComponents};
+    const int rowBytes {256 * nc};
+    const int blockBytes {4 * nc};                    // One row of a block
+
+    // Same subframe as decompressSubframe()
+    const int tx {x % 6};
+    const int ty {y % 6};
+
+    if (masked[tx][ty]) {
+        // Black pixels (transparent, with an alpha)
+        std::memset(texels, 0, 256 * rowBytes);
+    }
+    else {
+        const std::shared_ptr<const std::vector<unsigned char>> codebook {getCodebook(clut, nc)};
+        const unsigned char* const book {codebook->data()};
+        const unsigned char* ptr {subFrameTable[tx][ty]};
+        for (int i = 0; i < 256; i += 4) {
+            // Image columns i .. i+3 are texel rows 255-i .. 252-i
+            unsigned char* const row0 {texels + (255 - i) * rowBytes};
+            for (int j = 0; j < 256; j += 8, ptr += 3) {
+                // Two 12-bit values as indices into the codebook
+                const unsigned int vals {static_cast<unsigned int>(ptr[0] << 16 | ptr[1] << 8 | ptr[2])};
+                const unsigned char* src1 {book + ((vals >> 12) & 0xfff) * 4 * blockBytes};
+                const unsigned char* src2 {book + (vals & 0xfff) * 4 * blockBytes};
+                unsigned char* dst {row0 + j * nc};
+                for (int t = 0; t < 4; t++) {
+                    std::memcpy(dst, src1, blockBytes);
+                    std::memcpy(dst + blockBytes, src2, blockBytes);
+                    src1 += blockBytes;
+                    src2 += blockBytes;
+                    dst -= rowBytes;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// -------------------------------------------------------------------------------------
+// getCodebook() - Our lookup table converted to texels using the color table
+// -------------------------------------------------------------------------------------
+std::shared_ptr<const std::vector<unsigned char>> CadrgFrame::getCodebook(const CadrgClut& clut, const int numComponents)
+{
+    const int nc {numComponents};
+
+    base::lock(codebookSemaphore);
+    if (codebookClut != &clut) {
+        codebooks[0].reset();
+        codebooks[1].reset();
+        codebookClut = &clut;
+    }
+    if (codebooks[nc - 3] == nullptr) {
+        // Our colors (index 255 is the black pixel)
+        unsigned char colors[256][4] {};
+        for (int i = 0; i < 255; i++) {
+            const CadrgClut::Rgb& rgb = clut.getColor(i);
+            colors[i][0] = rgb.red;
+            colors[i][1] = rgb.green;
+            colors[i][2] = rgb.blue;
+            colors[i][3] = 255;
+        }
+
+        std::shared_ptr<std::vector<unsigned char>> book {std::make_shared<std::vector<unsigned char>>(4096 * 16 * nc)};
+        unsigned char* p {book->data()};
+        for (int val = 0; val < 4096; val++) {
+            for (int t = 0; t < 4; t++) {
+                for (int e = 0; e < 4; e++, p += nc) {
+                    std::memcpy(p, colors[lookupTable[val][e][t]], nc);
+                }
+            }
+        }
+        codebooks[nc - 3] = book;
+    }
+    const std::shared_ptr<const std::vector<unsigned char>> book {codebooks[nc - 3]};
+    base::unlock(codebookSemaphore);
+
+    return book;
+}
+
+// -------------------------------------------------------------------------------------
+// clearCodebooks() - Our lookup table has changed
+// -------------------------------------------------------------------------------------
+void CadrgFrame::clearCodebooks()
+{
+    base::lock(codebookSemaphore);
+    codebooks[0].reset();
+    codebooks[1].reset();
+    codebookClut = nullptr;
+    base::unlock(codebookSemaphore);
+}
+
 }
 }
 
@@ -1,8 +1,12 @@
 
 #include "mixr/map/rpf/CadrgMap.hpp"
+#include "mixr/map/rpf/CadrgClut.hpp"
 #include "mixr/map/rpf/CadrgFile.hpp"
 #include "mixr/map/rpf/CadrgFrame.hpp"
+#include "mixr/map/rpf/CadrgFrameEntry.hpp"
 #include "mixr/map/rpf/CadrgTocEntry.hpp"
+#include "mixr/map/rpf/SubframeCache.hpp"
+#include "mixr/map/rpf/SubframeLoader.hpp"
 #include "mixr/map/rpf/TexturePager.hpp"
 #include "mixr/map/rpf/MapDrawer.hpp"
 #include "mixr/graphics/Texture.hpp"
@@ -13,6 +17,7 @@
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/String.hpp"
 
+#include <cstdlib>
 #include <cstring>
 
 namespace mixr {
@@ -24,14 +29,25 @@ BEGIN_SLOTTABLE(CadrgMap)
     "pathNames",        // Path names to our TOC file
     "maxTableSize",     // Max table size to set up
     "mapLevel",         // Map level we are going to set (if it exists)
+    "loader",           // Background subframe loader
+    "subframeCacheSize", // Size (MB) of the decoded subframe cache (shared by all maps)
 END_SLOTTABLE(CadrgMap)
 
 BEGIN_SLOT_MAP(CadrgMap)
     ON_SLOT(1, setSlotPathnames,    base::PairStream)
     ON_SLOT(2, setSlotMaxTableSize, base::Integer)
     ON_SLOT(3, setSlotMapLevel,     base::String)
+    ON_SLOT(4, setSlotLoader,       SubframeLoader)
+    ON_SLOT(5, setSlotSubframeCacheSize, base::Integer)
 END_SLOT_MAP()
 
+// Our texels are decoded as packed RGB bytes
+static_assert(sizeof(CadrgMap::ColorArray) == (256 * 256 * 3), "CadrgMap::ColorArray must be packed RGB texels");
+
+// Map levels, in the order of zooming in
+static const char* const ZOOM_LEVELS[] { "1:5M", "1:2M", "1:1M", "1:500K", "1:250K", "10M", "5M" };
+static const int NUM_ZOOM_LEVELS {sizeof(ZOOM_LEVELS) / sizeof(ZOOM_LEVELS[0])};
+
 CadrgMap::CadrgMap()
 {
     STANDARD_CONSTRUCTOR()
@@ -66,6 +82,14 @@ void CadrgMap::copyData(const CadrgMap& org, const bool)
     maxTableSize = org.maxTableSize;
     numFiles = org.numFiles;
     initLevelLoaded = org.initLevelLoaded;
+    zoomDirection = org.zoomDirection;
+
+    if (org.loader != nullptr) {
+        SubframeLoader* copy {org.loader->clone()};
+        setSlotLoader(copy);
+        copy->unref();
+    }
+    else setSlotLoader(nullptr);
 }
 
 void CadrgMap::deleteData()
@@ -83,6 +107,26 @@ void CadrgMap::deleteData()
 
     if (stack != nullptr) stack->unref();
     stack = nullptr;
+
+    setSlotLoader(nullptr);
+}
+
+//------------------------------------------------------------------------------
+// reset() - Resets our loader (which creates its threads).
+//------------------------------------------------------------------------------
+void CadrgMap::reset()
+{
+    BaseClass::reset();
+    if (loader != nullptr) loader->reset();
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() - Shuts down our loader.
+//------------------------------------------------------------------------------
+bool CadrgMap::shutdownNotification()
+{
+    if (loader != nullptr) loader->event(SHUTDOWN_EVENT);
+    return BaseClass::shutdownNotification();
 }
 
 //------------------------------------------------------------------------------
@@ -251,15 +295,16 @@ bool CadrgMap::setPathName(const char* aGenPathName)
 void CadrgMap::loadFrameToTexture(graphics::Texture* tex, void* pixels)
 {
     if (tex != nullptr) {
+        // Size the image before setting the pixels, which are copied using the size
+        tex->setWidth(256);
+        tex->setHeight(256);
+        tex->setNumComponents(3);
         tex->setPixels((GLubyte*)pixels);
         tex->setWrapS(GL_CLAMP);
         tex->setWrapT(GL_CLAMP);
-        tex->setWidth(256);
-        tex->setHeight(256);
         tex->setFormat(GL_RGB);
         tex->setMagFilter(GL_LINEAR);
         tex->setMinFilter(GL_LINEAR);
-        tex->setNumComponents(3);
         tex->loadTexture();
     }
 }
@@ -342,6 +387,7 @@ bool CadrgMap::zoomInMapLevel()
             index = 6;
         }
         if (ok) {
+            zoomDirection = 1;
             ok = setMapLevel(newLevel->c_str());
             if (!ok) {
                 while (!ok && index > 0) {
@@ -405,6 +451,7 @@ bool CadrgMap::zoomOutMapLevel()
         }
 
         if (ok) {
+            zoomDirection = -1;
             ok = setMapLevel(newLevel->c_str());
             if (!ok) {
                 while (!ok && index > 0) {
@@ -617,7 +664,9 @@ void* CadrgMap::getPixels(const int row, const int column, TexturePager* tp)
             int frameRow = row / 6;
             int frameCol = column / 6;
             CadrgFrameEntry* frameEntry = currentToc->getFrameEntry(frameRow, frameCol);
-            if (frameEntry != nullptr) {
+            // Use the decoded subframe, if it's cached
+            unsigned char* const texels {&outTile.texel[0][0].red};
+            if (frameEntry != nullptr && !SubframeCache::get(frameEntry, row, column, 3, texels)) {
                 frameEntry->loadClut();
                 CadrgFrame* frame = frameEntry->getFrame();
                 // If we don't have an entry, let's pull one from the stack
@@ -637,25 +686,98 @@ void* CadrgMap::getPixels(const int row, const int column, TexturePager* tp)
                 // Get our frame again, because it now has been loaded
                 frame = frameEntry->getFrame();
                 if (frame != nullptr) {
-                    // Setup our subframe for decompression
-                    Subframe subframe;
-                    // Decompress our subframe
-                    frame->decompressSubframe(row, column, subframe);
-                    // Set our color based on subframe image
-                    for (int i = 0; i < 256; i++) {
-                        for (int j = 0; j < 256; j++) {
-                            CadrgClut::Rgb rgb = frameEntry->getClut().getColor(subframe.image[j][255-i]);
-                            outTile.texel[i][j].red = rgb.red;
-                            outTile.texel[i][j].green = rgb.green;
-                            outTile.texel[i][j].blue = rgb.blue;
+                    // Decode our subframe to texels (and cache it)
+                    SubframeCache::decode(frameEntry, frame, row, column, 3, texels);
+                }
+            }
+        }
+    }
+
+    return static_cast<void*>(&outTile);
+}
+
+// ------------------------------------------------------------------------
+// subframeToTexels() - Converts a decompressed subframe to RGB texels using
+// the color lookup table.
+// ------------------------------------------------------------------------
+void CadrgMap::subframeToTexels(const Subframe& subframe, const CadrgClut& clut, ColorArray& texels)
+{
+    for (int i = 0; i < 256; i++) {
+        for (int j = 0; j < 256; j++) {
+            const CadrgClut::Rgb& rgb = clut.getColor(subframe.image[j][255-i]);
+            texels.texel[i][j].red = rgb.red;
+            texels.texel[i][j].green = rgb.green;
+            texels.texel[i][j].blue = rgb.blue;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------
+// prefetchZoomLevel() - Requests the subframes around the lat/lon of the next
+// map level in the direction of our last zoom, so that zooming again doesn't
+// have to wait for them.
+// ------------------------------------------------------------------------
+void CadrgMap::prefetchZoomLevel(const double lat, const double lon)
+{
+    if (loader == nullptr || zoomDirection == 0 || mapLevel == nullptr) return;
+
+    // Our current level ...
+    int idx {-1};
+    for (int i = 0; i < NUM_ZOOM_LEVELS; i++) {
+        if (std::strcmp(ZOOM_LEVELS[i], mapLevel->c_str()) == 0) idx = i;
+    }
+
+    // ... and the next level that we have
+    CadrgFile* file {};
+    if (idx >= 0) {
+        for (int i = idx + zoomDirection; i >= 0 && i < NUM_ZOOM_LEVELS && file == nullptr; i += zoomDirection) {
+            file = findFileByLevel(ZOOM_LEVELS[i]);
+        }
+    }
+
+    if (file != nullptr) {
+        // Find its zone ...
+        const int nb {file->getNumBoundaries()};
+        for (int i = 0; i < nb; i++) {
+            CadrgTocEntry* toc {file->entry(i)};
+            if (toc != nullptr && toc->isMapImage() && toc->isInZone(lat, lon)) {
+                // ... and request the tiles around the lat/lon
+                const double vInt {toc->getVertInterval()};
+                const double hInt {toc->getHorizInterval()};
+                if (vInt != 0 && hInt != 0) {
+                    const int tileRow {static_cast<int>((toc->getNWLat() - lat) / vInt) / 256};
+                    const int tileCol {static_cast<int>((lon - toc->getNWLon()) / hInt) / 256};
+                    for (int r = -1; r <= 1; r++) {
+                        for (int c = -1; c <= 1; c++) {
+                            const int row {tileRow + r};
+                            const int col {tileCol + c};
+                            if (row >= 0 && row < (toc->getVertFrames() * 6) && col >= 0 && col < (toc->getHorizFrames() * 6)) {
+                                loader->request(toc, row, col, SubframeLoader::ZOOM + std::abs(r) + std::abs(c));
+                            }
                         }
                     }
                 }
+                break;
             }
         }
     }
+}
 
-    return static_cast<void*>(&outTile);
+//------------------------------------------------------------------------------
+// findFileByLevel() - Returns our file with the given map level, if any.
+//------------------------------------------------------------------------------
+CadrgFile* CadrgMap::findFileByLevel(const char* x)
+{
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (mergedCadrgFiles[i] != nullptr) {
+            const int nb {mergedCadrgFiles[i]->getNumBoundaries()};
+            for (int j = 0; j < nb; j++) {
+                CadrgTocEntry* toc {mergedCadrgFiles[i]->entry(j)};
+                if (toc != nullptr && std::strcmp(toc->getScale(), x) == 0) return mergedCadrgFiles[i];
+            }
+        }
+    }
+    return nullptr;
 }
 
 // ------------------------------------------------------------------------
@@ -703,6 +825,36 @@ const char* CadrgMap::getLevel()
     return nullptr;
 }
 
+//------------------------------------------------------------------------------
+// setSlotLoader() - Sets our background subframe loader.
+//------------------------------------------------------------------------------
+bool CadrgMap::setSlotLoader(SubframeLoader* const x)
+{
+    if (loader != nullptr) loader->unref();
+    loader = x;
+    if (loader != nullptr) loader->ref();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// setSlotSubframeCacheSize() - Sets the size (MB) of the decoded subframe cache
+//------------------------------------------------------------------------------
+bool CadrgMap::setSlotSubframeCacheSize(const base::Integer* const x)
+{
+    bool ok {};
+    if (x != nullptr) {
+        const int mb {x->asInt()};
+        if (mb >= 0) {
+            SubframeCache::setMaxSize(static_cast<std::size_t>(mb) * 1024 * 1024);
+            ok = true;
+        }
+        else if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "CadrgMap::setSlotSubframeCacheSize(): invalid size: " << mb << "; use zero (no cache) or more" << std::endl;
+        }
+    }
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // updateData() - Update map data.
 //------------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 #include "mixr/map/rpf/CadrgMap.hpp"
 #include "mixr/map/rpf/TexturePager.hpp"
 #include "mixr/map/rpf/CadrgTocEntry.hpp"
+#include "mixr/map/rpf/SubframeLoader.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/graphics/Display.hpp"
@@ -221,6 +222,10 @@ void MapDrawer::drawFunc()
     if (getDisplay() != nullptr) getDisplay()->getOrtho(dLeft, dRight, dBottom, dTop, dNear, dFar);
 
     if (myMap != nullptr) {
+        // Take the subframes that our loader has finished
+        SubframeLoader* loader {myMap->getLoader()};
+        if (loader != nullptr) loader->beginFrame();
+
         const double rLat {myMap->getReferenceLatDeg()};
         const double rLon {myMap->getReferenceLonDeg()};
         const int refZone {myMap->findBestZone(rLat, rLon)};
@@ -280,7 +285,13 @@ void MapDrawer::drawFunc()
 
             // Set our reference zone.
             myMap->setZone(zones[CENTER_PAGER], pagers[CENTER_PAGER]);
+
+            // Prefetch the next map level in the direction of our last zoom
+            myMap->prefetchZoomLevel(rLat, rLon);
         }
+
+        // Start loading this frame's requests
+        if (loader != nullptr) loader->endFrame();
     }
 
     // Set our ortho and our color back to its original state after we draw.
@@ -323,6 +334,8 @@ void MapDrawer::drawMap(const int zone, const int idx)
     if (myMap != nullptr && pagers[idx] != nullptr && showMap && getDisplay() != nullptr){
         // Update the tiles for the pager
         pagers[idx]->updateTextures(textureRow[idx], textureCol[idx]);
+        // Prefetch the tiles ahead of our motion
+        pagers[idx]->prefetch(originRow[idx], originCol[idx]);
         // Set up for drawing
         lcColor3(mapIntensity, mapIntensity, mapIntensity);
         glPushMatrix();
@@ -0,0 +1,220 @@
+
+#include "mixr/map/rpf/SubframeCache.hpp"
+#include "mixr/map/rpf/CadrgFrame.hpp"
+#include "mixr/map/rpf/CadrgFrameEntry.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstring>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace rpf {
+
+const std::size_t SubframeCache::DEFAULT_MAX_SIZE {32 * 1024 * 1024};
+
+namespace {
+
+// Subframe key
+struct Key {
+    std::string file;
+    int row {};
+    int col {};
+    int numComponents {};
+    bool operator==(const Key& k) const   { return (row == k.row && col == k.col && numComponents == k.numComponents && file == k.file); }
+};
+
+struct KeyHash {
+    std::size_t operator()(const Key& k) const {
+        return std::hash<std::string>()(k.file) ^ (static_cast<std::size_t>((k.row * 6 + k.col) * 5 + k.numComponents) << 1);
+    }
+};
+
+// Cached subframe
+struct Entry {
+    std::vector<unsigned char> texels;
+    std::list<Key>::iterator lru;
+};
+
+// The cache
+struct Cache {
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::list<Key> lru;                         // Most recently used first
+    std::size_t size {};                        // Bytes of texels
+    std::size_t maxSize {SubframeCache::DEFAULT_MAX_SIZE};
+    unsigned long hits {};
+    unsigned long misses {};
+    unsigned long numDecoded {};
+    double decodeTime {};
+    long semaphore {};
+
+    // Drop the least recently used until we're within 'max' bytes
+    void trim(const std::size_t max) {
+        while (size > max && !lru.empty()) {
+            const auto it = entries.find(lru.back());
+            size -= it->second.texels.size();
+            entries.erase(it);
+            lru.pop_back();
+        }
+    }
+};
+
+Cache& cache()
+{
+    static Cache c;
+    return c;
+}
+
+bool makeKey(CadrgFrameEntry* const entry, const int row, const int col, const int nc, Key* const key)
+{
+    if (entry == nullptr || entry->getDirectory() == nullptr) return false;
+    key->file = entry->getDirectory();
+    key->file += entry->getFileName();
+    key->row = row % 6;
+    key->col = col % 6;
+    key->numComponents = nc;
+    return true;
+}
+
+}
+
+//------------------------------------------------------------------------------
+// get() - Copies a cached subframe's texels
+//------------------------------------------------------------------------------
+bool SubframeCache::get(CadrgFrameEntry* const entry, const int row, const int col, const int numComponents, unsigned char* const texels)
+{
+    Key key;
+    if (texels == nullptr || !makeKey(entry, row, col, numComponents, &key)) return false;
+
+    bool found {};
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const auto it = c.entries.find(key);
+    if (it != c.entries.end()) {
+        c.lru.splice(c.lru.begin(), c.lru, it->second.lru);
+        std::memcpy(texels, it->second.texels.data(), it->second.texels.size());
+        c.hits++;
+        found = true;
+    }
+    else c.misses++;
+    base::unlock(c.semaphore);
+
+    return found;
+}
+
+//------------------------------------------------------------------------------
+// decode() - Decodes the subframe, and adds it to the cache
+//------------------------------------------------------------------------------
+bool SubframeCache::decode(CadrgFrameEntry* const entry, CadrgFrame* const frame, const int row, const int col, const int numComponents, unsigned char* const texels)
+{
+    if (entry == nullptr || frame == nullptr) return false;
+
+    const double start {base::getComputerTime()};
+    const bool ok {frame->decodeSubframe(row, col, entry->getClut(), texels, numComponents) != 0};
+    const double dt {base::getComputerTime() - start};
+
+    if (ok) {
+        Key key;
+        const bool keyed {makeKey(entry, row, col, numComponents, &key)};
+        const std::size_t n {static_cast<std::size_t>(256 * 256 * numComponents)};
+
+        Cache& c = cache();
+        base::lock(c.semaphore);
+        c.numDecoded++;
+        c.decodeTime += dt;
+        if (keyed && n <= c.maxSize && c.entries.find(key) == c.entries.end()) {
+            c.trim(c.maxSize - n);
+            c.lru.push_front(key);
+            Entry& e = c.entries[key];
+            e.texels.assign(texels, texels + n);
+            e.lru = c.lru.begin();
+            c.size += n;
+        }
+        base::unlock(c.semaphore);
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// Size functions
+//------------------------------------------------------------------------------
+void SubframeCache::setMaxSize(const std::size_t bytes)
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    c.maxSize = bytes;
+    c.trim(bytes);
+    base::unlock(c.semaphore);
+}
+
+std::size_t SubframeCache::getMaxSize()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const std::size_t v {c.maxSize};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+std::size_t SubframeCache::getSize()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const std::size_t v {c.size};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+void SubframeCache::clear()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    c.trim(0);
+    base::unlock(c.semaphore);
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+unsigned long SubframeCache::getHits()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const unsigned long v {c.hits};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+unsigned long SubframeCache::getMisses()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const unsigned long v {c.misses};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+unsigned long SubframeCache::getNumDecoded()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const unsigned long v {c.numDecoded};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+double SubframeCache::getDecodeTime()
+{
+    Cache& c = cache();
+    base::lock(c.semaphore);
+    const double v {c.decodeTime};
+    base::unlock(c.semaphore);
+    return v;
+}
+
+}
+}
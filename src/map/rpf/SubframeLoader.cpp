@@ -0,0 +1,590 @@
+
+#include "mixr/map/rpf/SubframeLoader.hpp"
+
+#include "SubframeLoaderThread.hpp"
+
+#include "mixr/map/rpf/CadrgFrame.hpp"
+#include "mixr/map/rpf/CadrgFrameEntry.hpp"
+#include "mixr/map/rpf/CadrgTocEntry.hpp"
+#include "mixr/map/rpf/SubframeCache.hpp"
+#include "mixr/map/rpf/map_utils.hpp"
+
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+namespace mixr {
+namespace rpf {
+
+IMPLEMENT_SUBCLASS(SubframeLoader, "SubframeLoader")
+
+BEGIN_SLOTTABLE(SubframeLoader)
+    "numThreads",       // 1) Number of loader threads
+    "priority",         // 2) Priority of the loader threads
+    "cacheSize",        // 3) Max number of decoded subframes in the cache
+    "lookAhead",        // 4) Number of tiles to prefetch ahead of the map's motion
+END_SLOTTABLE(SubframeLoader)
+
+BEGIN_SLOT_MAP(SubframeLoader)
+    ON_SLOT(1, setSlotNumThreads,   base::Integer)
+    ON_SLOT(2, setSlotPriority,     base::Number)
+    ON_SLOT(3, setSlotCacheSize,    base::Integer)
+    ON_SLOT(4, setSlotLookAhead,    base::Integer)
+END_SLOT_MAP()
+
+SubframeLoader::SubframeLoader()
+{
+    STANDARD_CONSTRUCTOR()
+}
+
+void SubframeLoader::copyData(const SubframeLoader& org, const bool)
+{
+    BaseClass::copyData(org);
+
+    // Our copy has its own threads and cache
+    deleteThreads();
+
+    numThreads = org.numThreads;
+    priority = org.priority;
+    cacheSize = org.cacheSize;
+    lookAhead = org.lookAhead;
+}
+
+void SubframeLoader::deleteData()
+{
+    deleteThreads();
+    clearRequests();
+    clearFrames();
+    collect();
+    clearCache();
+}
+
+//------------------------------------------------------------------------------
+// reset() -- create the loader threads
+//------------------------------------------------------------------------------
+void SubframeLoader::reset()
+{
+    BaseClass::reset();
+
+    if (numThreads > 0 && numPoolThreads == 0 && !threadsFailed) {
+        createThreads();
+    }
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- shut down the loader threads
+//------------------------------------------------------------------------------
+bool SubframeLoader::shutdownNotification()
+{
+    const bool ok {BaseClass::shutdownNotification()};
+
+    // Stop the threads and wait for them to exit
+    deleteThreads();
+
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool SubframeLoader::setNumThreads(const int v)
+{
+    bool ok {};
+    if (v >= 0 && v <= MAX_THREADS) {
+        numThreads = v;
+        ok = true;
+    }
+    return ok;
+}
+
+bool SubframeLoader::setPriority(const double v)
+{
+    bool ok {};
+    if (v >= 0 && v <= 1) {
+        priority = v;
+        ok = true;
+    }
+    return ok;
+}
+
+bool SubframeLoader::setCacheSize(const int v)
+{
+    bool ok {};
+    if (v > 0) {
+        cacheSize = v;
+        ok = true;
+    }
+    return ok;
+}
+
+bool SubframeLoader::setLookAhead(const int v)
+{
+    bool ok {};
+    if (v >= 0) {
+        lookAhead = v;
+        ok = true;
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// beginFrame() -- starts a frame of requests; the finished subframes are
+// moved into the cache.
+//------------------------------------------------------------------------------
+void SubframeLoader::beginFrame()
+{
+    collect();
+
+    base::lock(semaphore);
+    frameCount++;
+    base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// getSubframe() -- returns the decoded subframe, or nullptr if it's not in
+// the cache (it's now our most recently used subframe)
+//------------------------------------------------------------------------------
+const SubframeLoader::Tile* SubframeLoader::getSubframe(const CadrgTocEntry* const toc, const int row, const int col)
+{
+    Key key;
+    key.toc = toc;
+    key.row = row;
+    key.col = col;
+    const auto it = cache.find(key);
+    if (it != cache.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru);
+        return it->second.tile;
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// request() -- requests a subframe for this frame; lower priorities are
+// loaded first
+//------------------------------------------------------------------------------
+void SubframeLoader::request(CadrgTocEntry* const toc, const int row, const int col, const int pri)
+{
+    if (toc == nullptr) return;
+
+    // Already cached (keep it)
+    if (getSubframe(toc, row, col) != nullptr) return;
+
+    Key key;
+    key.toc = toc;
+    key.row = row;
+    key.col = col;
+
+    base::lock(semaphore);
+    if (std::find(busy.begin(), busy.end(), key) == busy.end()) {
+        bool found {};
+        for (auto& p : pending) {
+            if (p.key == key) {
+                // Requested again; use this frame's priority (or the
+                // highest of this frame's requests)
+                if (p.frame != frameCount || pri < p.pri) p.pri = pri;
+                p.frame = frameCount;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            Request r;
+            r.key = key;
+            r.toc = toc;
+            r.toc->ref();
+            r.pri = pri;
+            r.frame = frameCount;
+            pending.push_back(r);
+        }
+    }
+    base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// endFrame() -- the frame's requests are complete; wake the loader threads
+//------------------------------------------------------------------------------
+void SubframeLoader::endFrame()
+{
+    if (numThreads > 0 && numPoolThreads == 0 && !threadsFailed && isNotShutdown()) {
+        createThreads();
+    }
+
+    if (numPoolThreads > 0) {
+        base::lock(semaphore);
+        const bool work {!pending.empty()};
+        base::unlock(semaphore);
+        if (work) {
+            for (int i = 0; i < numPoolThreads; i++) {
+                threads[i]->wake();
+            }
+        }
+    }
+    else {
+        // No loader threads, so we'll load one subframe per frame
+        Request r;
+        if (takeRequest(&r)) {
+            Tile* const tile {newTile()};
+            decode(r, tile);
+            finishRequest(r, tile);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// processRequests() -- loads the requests until there are no more (called
+// by the loader threads)
+//------------------------------------------------------------------------------
+void SubframeLoader::processRequests()
+{
+    Request r;
+    while (isNotShutdown() && !stopping && takeRequest(&r)) {
+        Tile* const tile {newTile()};
+        decode(r, tile);
+        finishRequest(r, tile);
+    }
+}
+
+// Takes the highest priority request; the requests that weren't repeated
+// by this frame or the last frame are dropped.
+bool SubframeLoader::takeRequest(Request* const r)
+{
+    bool ok {};
+    base::lock(semaphore);
+    int best {-1};
+    for (unsigned int i = 0; i < pending.size(); ) {
+        if ((pending[i].frame + 1) < frameCount) {
+            pending[i].toc->unref();
+            pending[i] = pending.back();
+            pending.pop_back();
+        }
+        else {
+            if (best < 0 || pending[i].pri < pending[best].pri) best = static_cast<int>(i);
+            i++;
+        }
+    }
+    if (best >= 0) {
+        *r = pending[best];
+        pending.erase(pending.begin() + best);
+        busy.push_back(r->key);
+        ok = true;
+    }
+    base::unlock(semaphore);
+    return ok;
+}
+
+// Passes the decoded subframe to the render thread
+void SubframeLoader::finishRequest(const Request& r, Tile* const tile)
+{
+    // Push it on our lock-free list of finished tiles ...
+    Tile* head {finished.load(std::memory_order_relaxed)};
+    do {
+        tile->next = head;
+    } while (!finished.compare_exchange_weak(head, tile, std::memory_order_release, std::memory_order_relaxed));
+
+    // ... and then it's no longer busy
+    base::lock(semaphore);
+    const auto it = std::find(busy.begin(), busy.end(), r.key);
+    if (it != busy.end()) busy.erase(it);
+    base::unlock(semaphore);
+
+    r.toc->unref();
+}
+
+// Returns an unused tile
+SubframeLoader::Tile* SubframeLoader::newTile()
+{
+    Tile* tile {};
+    base::lock(semaphore);
+    if (!freeTiles.empty()) {
+        tile = freeTiles.back();
+        freeTiles.pop_back();
+    }
+    base::unlock(semaphore);
+    if (tile == nullptr) tile = new Tile();
+    return tile;
+}
+
+//------------------------------------------------------------------------------
+// decode() -- decodes the requested subframe (see CadrgMap::getPixels());
+// missing subframes are black.
+//------------------------------------------------------------------------------
+void SubframeLoader::decode(const Request& r, Tile* const tile)
+{
+    tile->toc = r.key.toc;
+    tile->row = r.key.row;
+    tile->col = r.key.col;
+    tile->next = nullptr;
+
+    bool ok {};
+    CadrgTocEntry* const toc {r.toc};
+    if (r.key.row >= 0 && r.key.row < (toc->getVertFrames() * 6) && r.key.col >= 0 && r.key.col < (toc->getHorizFrames() * 6)) {
+        CadrgFrameEntry* const entry {toc->getFrameEntry(r.key.row / 6, r.key.col / 6)};
+        unsigned char* const texels {&tile->pixels.texel[0][0].red};
+        if (entry != nullptr && SubframeCache::get(entry, r.key.row, r.key.col, 3, texels)) {
+            ok = true;
+        }
+        else if (entry != nullptr) {
+            base::lock(clutSemaphore);
+            entry->loadClut();
+            base::unlock(clutSemaphore);
+
+            CadrgFrame* const frame {getFrame(entry)};
+            if (frame != nullptr) {
+                ok = SubframeCache::decode(entry, frame, r.key.row, r.key.col, 3, texels);
+                frame->unref();
+            }
+        }
+    }
+    if (!ok) std::memset(static_cast<void*>(&tile->pixels), 0, sizeof(tile->pixels));
+}
+
+// Returns the loaded frame of the frame entry (ref()'d); the most recently
+// used frames are kept.
+CadrgFrame* SubframeLoader::getFrame(CadrgFrameEntry* const entry)
+{
+    CadrgFrame* frame {};
+
+    base::lock(semaphore);
+    for (unsigned int i = 0; i < frames.size() && frame == nullptr; i++) {
+        if (frames[i].entry == entry) {
+            const LoadedFrame lf {frames[i]};
+            frames.erase(frames.begin() + i);
+            frames.insert(frames.begin(), lf);
+            frame = lf.frame;
+            frame->ref();
+        }
+    }
+    base::unlock(semaphore);
+
+    if (frame == nullptr) {
+        // Load it ...
+        CadrgFrame* const loaded {new CadrgFrame()};
+        loaded->load(entry);
+
+        // ... and keep it, unless another thread has beaten us to it
+        base::lock(semaphore);
+        for (unsigned int i = 0; i < frames.size() && frame == nullptr; i++) {
+            if (frames[i].entry == entry) frame = frames[i].frame;
+        }
+        if (frame == nullptr) {
+            LoadedFrame lf;
+            lf.entry = entry;
+            lf.frame = loaded;
+            loaded->ref();
+            frames.insert(frames.begin(), lf);
+            const unsigned int maxFrames {static_cast<unsigned int>(std::max(numPoolThreads, 1) * FRAMES_PER_THREAD)};
+            while (frames.size() > maxFrames) {
+                frames.back().frame->unref();
+                frames.pop_back();
+            }
+            frame = loaded;                     // (our reference is the caller's)
+            base::unlock(semaphore);
+        }
+        else {
+            frame->ref();
+            base::unlock(semaphore);
+            loaded->unref();
+        }
+    }
+
+    return frame;
+}
+
+//------------------------------------------------------------------------------
+// collect() -- moves the finished tiles into the cache (render thread)
+//------------------------------------------------------------------------------
+void SubframeLoader::collect()
+{
+    // Take the finished list, and put it back in the order that they finished
+    Tile* list {finished.exchange(nullptr, std::memory_order_acquire)};
+    Tile* ordered {};
+    while (list != nullptr) {
+        Tile* const next {list->next};
+        list->next = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    std::vector<Tile*> unused;
+    while (ordered != nullptr) {
+        Tile* const tile {ordered};
+        ordered = tile->next;
+        tile->next = nullptr;
+
+        Key key;
+        key.toc = tile->toc;
+        key.row = tile->row;
+        key.col = tile->col;
+        if (cache.find(key) == cache.end()) {
+            lru.push_front(tile);
+            CacheEntry& entry = cache[key];
+            entry.tile = tile;
+            entry.lru = lru.begin();
+        }
+        else {
+            // decoded twice
+            unused.push_back(tile);
+        }
+    }
+
+    // Drop the least recently used
+    while (static_cast<int>(cache.size()) > cacheSize) {
+        Tile* const tile {lru.back()};
+        lru.pop_back();
+        Key key;
+        key.toc = tile->toc;
+        key.row = tile->row;
+        key.col = tile->col;
+        cache.erase(key);
+        unused.push_back(tile);
+    }
+
+    if (!unused.empty()) {
+        base::lock(semaphore);
+        freeTiles.insert(freeTiles.end(), unused.begin(), unused.end());
+        base::unlock(semaphore);
+    }
+}
+
+void SubframeLoader::clearCache()
+{
+    for (Tile* tile : lru) {
+        delete tile;
+    }
+    lru.clear();
+    cache.clear();
+
+    base::lock(semaphore);
+    for (Tile* tile : freeTiles) {
+        delete tile;
+    }
+    freeTiles.clear();
+    base::unlock(semaphore);
+}
+
+void SubframeLoader::clearRequests()
+{
+    base::lock(semaphore);
+    for (auto& p : pending) {
+        p.toc->unref();
+    }
+    pending.clear();
+    base::unlock(semaphore);
+}
+
+void SubframeLoader::clearFrames()
+{
+    base::lock(semaphore);
+    for (auto& f : frames) {
+        f.frame->unref();
+    }
+    frames.clear();
+    base::unlock(semaphore);
+}
+
+std::size_t SubframeLoader::KeyHash::operator()(const Key& k) const
+{
+    return std::hash<const void*>()(k.toc) ^ (static_cast<std::size_t>(k.row) * 73856093u) ^ (static_cast<std::size_t>(k.col) * 19349663u);
+}
+
+//------------------------------------------------------------------------------
+// Loader threads
+//------------------------------------------------------------------------------
+void SubframeLoader::createThreads()
+{
+    for (int i = 0; i < numThreads; i++) {
+        threads[numPoolThreads] = new SubframeLoaderThread(this);
+        const bool ok {threads[numPoolThreads]->start(priority)};
+        if (ok) {
+            numPoolThreads++;
+        }
+        else {
+            threads[numPoolThreads]->unref();
+            threads[numPoolThreads] = nullptr;
+            if (isMessageEnabled(MSG_ERROR)) {
+                std::cerr << "SubframeLoader::createThreads(): ERROR, failed to create a loader thread!" << std::endl;
+            }
+        }
+    }
+
+    // If we still don't have any threads then something failed
+    threadsFailed = (numPoolThreads == 0);
+}
+
+// Stops the threads and waits for them to exit, so that none of them is still
+// using our requests, frames and cache when they're cleared
+void SubframeLoader::deleteThreads()
+{
+    stopping = true;
+    for (int i = 0; i < numPoolThreads; i++) {
+        threads[i]->stop();
+    }
+    for (int i = 0; i < numPoolThreads; i++) {
+        threads[i]->join();
+        threads[i]->unref();
+        threads[i] = nullptr;
+    }
+    numPoolThreads = 0;
+    threadsFailed = false;
+    stopping = false;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool SubframeLoader::setSlotNumThreads(const base::Integer* const msg)
+{
+    bool ok {};
+    if (msg != nullptr) {
+        ok = setNumThreads(msg->asInt());
+        if (!ok && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "SubframeLoader::setSlotNumThreads(): invalid number of threads: " << msg->asInt();
+            std::cerr << "; use [ 0 .. " << MAX_THREADS << " ]" << std::endl;
+        }
+    }
+    return ok;
+}
+
+bool SubframeLoader::setSlotPriority(const base::Number* const msg)
+{
+    bool ok {};
+    if (msg != nullptr) {
+        ok = setPriority(msg->asDouble());
+        if (!ok && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "SubframeLoader::setSlotPriority(): invalid priority; use [ 0 .. 1 ]" << std::endl;
+        }
+    }
+    return ok;
+}
+
+bool SubframeLoader::setSlotCacheSize(const base::Integer* const msg)
+{
+    bool ok {};
+    if (msg != nullptr) {
+        ok = setCacheSize(msg->asInt());
+        if (!ok && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "SubframeLoader::setSlotCacheSize(): cache size must be greater than zero" << std::endl;
+        }
+    }
+    return ok;
+}
+
+bool SubframeLoader::setSlotLookAhead(const base::Integer* const msg)
+{
+    bool ok {};
+    if (msg != nullptr) {
+        ok = setLookAhead(msg->asInt());
+        if (!ok && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "SubframeLoader::setSlotLookAhead(): look ahead must be zero or greater" << std::endl;
+        }
+    }
+    return ok;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+
+#include "SubframeLoaderThread.hpp"
+
+#include "mixr/map/rpf/SubframeLoader.hpp"
+
+#include "mixr/base/Component.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+namespace mixr {
+namespace rpf {
+
+SubframeLoaderThread::SubframeLoaderThread(base::Component* const parent): base::OneShotThread(parent)
+{
+}
+
+void SubframeLoaderThread::wake()
+{
+    base::lock(semaphore);
+    work = true;
+    base::unlock(semaphore);
+}
+
+void SubframeLoaderThread::stop()
+{
+    base::lock(semaphore);
+    quit = true;
+    base::unlock(semaphore);
+}
+
+void SubframeLoaderThread::join()
+{
+    bool exited {};
+    while (!exited) {
+        base::lock(semaphore);
+        exited = done;
+        base::unlock(semaphore);
+        if (!exited) base::msleep(1);
+    }
+}
+
+unsigned long SubframeLoaderThread::userFunc()
+{
+    SubframeLoader* loader {static_cast<SubframeLoader*>(getParent())};
+
+    while (loader->isNotShutdown()) {
+        base::lock(semaphore);
+        const bool woken {work};
+        const bool stopped {quit};
+        work = false;
+        base::unlock(semaphore);
+        if (stopped) break;
+
+        // Load the requests until there are no more; wait a bit when we
+        // haven't been woken
+        if (woken) loader->processRequests();
+        else base::msleep(1);
+    }
+
+    // We're done with the loader; only our (and its) unref() follow
+    base::lock(semaphore);
+    done = true;
+    base::unlock(semaphore);
+    return 0;
+}
+
+}
+}
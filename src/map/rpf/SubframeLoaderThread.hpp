@@ -0,0 +1,38 @@
+
+#ifndef __mixr_map_rpf_SubframeLoaderThread_HPP__
+#define __mixr_map_rpf_SubframeLoaderThread_HPP__
+
+#include "mixr/base/threads/OneShotThread.hpp"
+
+namespace mixr {
+namespace base { class Component; }
+namespace rpf {
+
+//------------------------------------------------------------------------------
+// Class: SubframeLoaderThread
+// Description: SubframeLoader's thread; loads the requested subframes each
+//              time it's woken, until it's stopped or the loader is shut down
+//------------------------------------------------------------------------------
+class SubframeLoaderThread final : public base::OneShotThread
+{
+public:
+    SubframeLoaderThread(base::Component* const parent);
+
+    void wake();        // There are requests to load
+    void stop();        // Finish the current request and exit
+    void join();        // Wait for the thread to exit
+
+private:
+    // OneShotThread class function -- our userFunc()
+    unsigned long userFunc() final;
+
+    mutable long semaphore {};
+    bool work {};       // Woken
+    bool quit {};       // Stopped
+    bool done {};       // Exited
+};
+
+}
+}
+
+#endif
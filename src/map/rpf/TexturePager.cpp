@@ -3,15 +3,21 @@
 #include "mixr/map/rpf/CadrgTocEntry.hpp"
 #include "mixr/graphics/Texture.hpp"
 #include "mixr/map/rpf/CadrgMap.hpp"
+#include "mixr/map/rpf/SubframeLoader.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/List.hpp"
 
+#include <cmath>
+#include <cstdlib>
+
 namespace mixr {
 namespace rpf {
 
 IMPLEMENT_SUBCLASS(TexturePager, "TexturePager")
 EMPTY_SLOTTABLE(TexturePager)
 
+const float TexturePager::MIN_SPEED {0.5f};
+
 TexturePager::TexturePager()
 {
     STANDARD_CONSTRUCTOR()
@@ -40,6 +46,10 @@ void TexturePager::copyData(const TexturePager& org, const bool)
     col = org.col;
     diffRow = org.diffRow;
     diffCol = org.diffCol;
+
+    lastToc = nullptr;
+    velRow = 0;
+    velCol = 0;
 }
 
 void TexturePager::deleteData()
@@ -113,6 +123,58 @@ void TexturePager::updateTextures(const int tRow, const int tCol)
     loadNewTextures();
 }
 
+// -------------------------------------------------------------------------
+// prefetch() - Takes in the current pixel row and column of our reference
+// lat/lon, and requests the tiles ahead of its (smoothed) motion from the
+// map's SubframeLoader, so they're decoded before they're needed.
+// -------------------------------------------------------------------------
+void TexturePager::prefetch(const float originRow, const float originCol)
+{
+    SubframeLoader* loader {(map != nullptr ? map->getLoader() : nullptr)};
+    if (loader == nullptr || toc == nullptr) return;
+
+    const float dRow {originRow - lastRow};
+    const float dCol {originCol - lastCol};
+    lastRow = originRow;
+    lastCol = originCol;
+
+    // Restart on a new TOC entry or a jump
+    if (toc != lastToc || std::fabs(dRow) >= 256.0f || std::fabs(dCol) >= 256.0f) {
+        lastToc = toc;
+        velRow = 0;
+        velCol = 0;
+        return;
+    }
+
+    // Smoothed motion
+    velRow = 0.8f * velRow + 0.2f * dRow;
+    velCol = 0.8f * velCol + 0.2f * dCol;
+    const float speed {std::sqrt(velRow * velRow + velCol * velCol)};
+    if (speed < MIN_SPEED) return;
+
+    // Predicted tile, 'lookAhead' tiles ahead of our motion
+    const float ahead {static_cast<float>(loader->getLookAhead() * 256)};
+    const float pRow {originRow + velRow / speed * ahead};
+    const float pCol {originCol + velCol / speed * ahead};
+    if (pRow < 0 || pCol < 0) return;
+    const int tRow {static_cast<int>(pRow) / 256};
+    const int tCol {static_cast<int>(pCol) / 256};
+
+    // Request the tiles of the predicted table that aren't in our table
+    const int lb {table.getLowerBoundIndex()};
+    const int ub {table.getUpperBoundIndex()};
+    for (int i = lb; i <= ub; i++) {
+        for (int j = lb; j <= ub; j++) {
+            const int r {tRow + i};
+            const int c {tCol + j};
+            if (!table.isInBounds(r - row, c - col) && map->isValidFrame(r, c, this)) {
+                const int dist {std::abs(i) > std::abs(j) ? std::abs(i) : std::abs(j)};
+                loader->request(toc, r, c, SubframeLoader::AHEAD + dist);
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 // setToc() - Sets the toc entry we are associated to.
 //------------------------------------------------------------------------------
@@ -211,6 +273,9 @@ void TexturePager::loadNewTextures()
     // The max table size should be odd that way there is always a middle table position
     // to process all textures in a spiral from inside to out
     const int maxSize {table.getMaxTableSize()};
+    SubframeLoader* loader {map->getLoader()};
+    int count {};
+    int uploads {};
     if (maxSize % 2) {
         for (int level = 0; level < maxSize; level += 2) {
             int r {level >> 1};
@@ -223,7 +288,22 @@ void TexturePager::loadNewTextures()
                     // to add one, but only if the row and column + our center row and column position fall
                     // within our valid frames.
                     graphics::Texture* texObj {table.getTexture(r, c)};
-                    if (texObj == nullptr && map->isValidFrame(r + row, c + col, this)) {
+                    if (texObj == nullptr && map->isValidFrame(r + row, c + col, this) && loader != nullptr) {
+                        // Use the loader's subframe, or request it (from the center out)
+                        const SubframeLoader::Tile* tile {loader->getSubframe(toc, r + row, c + col)};
+                        if (tile == nullptr) {
+                            loader->request(toc, r + row, c + col, SubframeLoader::VISIBLE + count);
+                        }
+                        else if (uploads < MAX_UPLOADS) {
+                            graphics::Texture* obj {useFreeTexture(r, c)};
+                            if (obj != nullptr) {
+                                map->loadFrameToTexture(obj, const_cast<CadrgMap::ColorArray*>(&tile->pixels));
+                                uploads++;
+                            }
+                        }
+                        count++;
+                    }
+                    else if (texObj == nullptr && map->isValidFrame(r + row, c + col, this)) {
                         if (stack != nullptr) {
                             base::List::Item* item {stack->getFirstItem()};
                             if (item != nullptr) {
@@ -250,6 +330,26 @@ void TexturePager::loadNewTextures()
     return;
 }
 
+//------------------------------------------------------------------------------
+// useFreeTexture() - Moves a texture object from the stack to our table
+// position, and returns it (or zero if none)
+//------------------------------------------------------------------------------
+graphics::Texture* TexturePager::useFreeTexture(const int r, const int c)
+{
+    graphics::Texture* obj {};
+    if (stack != nullptr) {
+        base::List::Item* item {stack->getFirstItem()};
+        if (item != nullptr) {
+            obj = dynamic_cast<graphics::Texture*>(item->getValue());
+            if (obj != nullptr) {
+                table.setTextureObject(r, c, obj);
+                stack->removeHead();
+            }
+        }
+    }
+    return obj;
+}
+
 //------------------------------------------------------------------------------
 // flushTextures() - Clear out the textures and put them back on the stack.
 //------------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include "mixr/map/rpf/factory.hpp"
 #include "mixr/map/rpf/MapDrawer.hpp"
 #include "mixr/map/rpf/CadrgMap.hpp"
+#include "mixr/map/rpf/SubframeLoader.hpp"
 
 #include <string>
 
@@ -20,6 +21,9 @@ base::Object* factory(const std::string& name)
     // CadrgMap
     else if ( name == CadrgMap::getFactoryName() ) { obj = new CadrgMap();  }
 
+    // Subframe loader
+    else if ( name == SubframeLoader::getFactoryName() ) { obj = new SubframeLoader(); }
+
     return obj;
 }
 
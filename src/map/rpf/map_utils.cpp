@@ -40,7 +40,7 @@ char* stringToLowercase(char* str)
 // and now we need to start reading the location data. - this function
 // takes in a file, and finds the proper locations for our component types.
 // -------------------------------------------------------------------------
-void parseLocations(std::ifstream& fin, Location* locs, int count)
+void parseLocations(std::istream& fin, Location* locs, int count)
 {
     // We are at the location section portion of the file, which holds the
     // following information (MIL-STD-2411, page 45)
@@ -87,6 +87,7 @@ void VMap0MainDirectory::loadTables()
                 //    if (libDirectory == 0) libDirectory = new VMAP0LibDirectory();
                 //    libDirectory->setSlotPath(string);
                 //}
+                record->unref();
                 index++;
                 record = table->getRecord(index);
             }
@@ -129,9 +129,11 @@ int VMap0RefCoverageDirectory::getPolBndCoordsByLatLon(const float maxLat, const
                     if (r != nullptr) {
                         const int temp {r->getCoordinate(8, vec, idx, max)};
                         numCoords += temp;
+                        r->unref();
                     }
                 }
             }                        
+            record->unref();
             index++;
             record = featureTables[EBR]->getRecord(index);
          }
@@ -153,6 +155,7 @@ int VMap0RefCoverageDirectory::getPlacenameCoordsByRecord(const int r, base::Vec
         // our coordinate is column 3
         if (rec != nullptr) {
             numCoords = rec->getCoordinate(3, vec, idx, max);
+            rec->unref();
         }
     }
     else std::cout << "NO ENTITY NODE PRIMITIVE TABLE FOUND, PATH = " << getPath() << std::endl;
@@ -166,16 +169,19 @@ int VMap0RefCoverageDirectory::getPlacenameCoordsByRange(const float width, cons
     int tempIdx {idx};
     // get our node spatial index to do a query
     if (spatialTables[NSI] != nullptr) {
-        int numPrims {spatialTables[NSI]->findPrimitivesBySpatialQuery(refLat, refLon, spatialQueryPrimIds.data(), width, height)};
+        int numPrims {spatialTables[NSI]->findPrimitivesBySpatialQuery(refLat, refLon, spatialQueryPrimIds, width, height)};
         VpfRecord* v {};
         for (int i = 0; i < numPrims && (i < max-1); i++) {
             // now that we have the primitive ids of the values, we can query our entity node primitive table to obtain the coordinates
             if (featureTables[END] != nullptr) {
                 v = featureTables[END]->getRecord(spatialQueryPrimIds[i]);
-                if (v != nullptr && numCoords < max) {
-                    int temp {v->getCoordinate(3, vec, tempIdx, max)};
-                    numCoords += temp;
-                    tempIdx += temp;
+                if (v != nullptr) {
+                    if (numCoords < max) {
+                        int temp {v->getCoordinate(3, vec, tempIdx, max)};
+                        numCoords += temp;
+                        tempIdx += temp;
+                    }
+                    v->unref();
                 }
             }
         }
@@ -185,7 +191,7 @@ int VMap0RefCoverageDirectory::getPlacenameCoordsByRange(const float width, cons
 
 int VMap0RefCoverageDirectory::getSpatialQueryPlacenamePrimID(const int idx)
 {
-    if (idx < 500) return spatialQueryPrimIds[idx-1];
+    if (idx >= 1 && idx <= static_cast<int>(spatialQueryPrimIds.size())) return spatialQueryPrimIds[idx-1];
     return -1;
 }
 
@@ -201,6 +207,7 @@ bool VMap0RefCoverageDirectory::getPlacenameByRecord(const int r, char* p)
             //lcStrcpy(p, sizeof(p), rec->getData(2));
             std::strcpy(p, rec->getData(2));
             //std::sprintf(p, "%s", rec->getData(2));
+            rec->unref();
         }
     }
     else std::cout << "NO PLACENAME POINT FEATURE TABLE FOUND, PATH = " << getPath() << std::endl;
@@ -214,7 +221,10 @@ int VMap0RefCoverageDirectory::getPolBndCoordsByRecord(const int r, base::Vec3d
     if (featureTables[EDG] != nullptr && featureTables[EDG]->isLoaded()) {
         VpfRecord* rec {featureTables[EDG]->getRecord(r)};
         // our boundary coordinate is column 8
-        if (rec != nullptr) numCoords = rec->getCoordinate(8, vec, idx, max);            
+        if (rec != nullptr) {
+            numCoords = rec->getCoordinate(8, vec, idx, max);
+            rec->unref();
+        }
     }
     else std::cout << "NO EDGE TABLE FOUND, PATH = " << getPath() << std::endl;
     return numCoords;
@@ -228,9 +238,8 @@ void VMap0RefCoverageDirectory::buildFeatureClasses()
     VpfTable* fcs {getTable(VpfDirectory::FCS)};
     // first, build our classes, then add the relationships
     if (fcs != nullptr) {
-        VpfRecord* record {};
-        for (int i = 1; fcs->getRecord(i) != 0 && numFeatureClasses < MAX_FEATURE_CLASSES; i++) {
-            record = fcs->getRecord(i);
+        VpfRecord* record {fcs->getRecord(1)};
+        for (int i = 1; record != nullptr && numFeatureClasses < MAX_FEATURE_CLASSES; i++) {
             d = (char*)record->getData(2); 
             // now count our table name and truncate it
             std::size_t size {strlen(d)};
@@ -269,7 +278,10 @@ void VMap0RefCoverageDirectory::buildFeatureClasses()
                     numFeatureClasses++;
                 }
             }
+            record->unref();
+            record = fcs->getRecord(i + 1);
         }
+        if (record != nullptr) record->unref();
     }
 }
 
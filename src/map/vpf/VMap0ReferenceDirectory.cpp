@@ -71,6 +71,7 @@ void VMap0ReferenceDirectory::loadTables()
 #endif
                     }
                 }
+                r->unref();
                 r = table->getRecord(++count);
             }
         }
@@ -172,6 +173,7 @@ void VMap0ReferenceDirectory::loadTables()
                     coverages[CVG_POLBND]->setSlotPath(string);
                 }
 #endif 
+                record->unref();
                 index++;
                 record = table->getRecord(index);
             }
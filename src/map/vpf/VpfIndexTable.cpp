@@ -26,29 +26,20 @@ void VpfIndexTable::deleteData()
         fullPath->unref();
         fullPath = 0;
     }
+    entries.clear();
 }
 
 // get a record quickly from our index file
 void VpfIndexTable::getRecordPosition(const int idx, int& offset, int& length) 
 {
-    // we know our record size is exactly 2 integers, and we know the offset is our numBytes, 
-    // because numBytes is the header length in the VPFTable associated with this index table, 
-    if (fullPath != nullptr && !fullPath->isEmpty()) {
-        std::ifstream stream;
-        stream.open(fullPath->c_str());
-        if (!stream.fail()) {
-            // our record size is actually the same size of our num entires and numBytes, which
-            // are both integers, so we can use that to seek 8 + idx * 8 to get the record
-            stream.seekg(recordSize + ((idx - 1) * recordSize), std::ios::beg);
-            int off {}, len {};
-            stream.read((char*)&off, sizeof(off));
-            stream.read((char*)&len, sizeof(len));
-            offset = off;
-            length = len;
-            //std::cout << "OFFSET AND LENGTH FOR RECORD " << idx << " = " << offset << ", " << length << std::endl;
-            stream.close();
-        }
-        else std::cout << "FAILED TO OPEN INDEX FILE " << fullPath->c_str() << std::endl;
+    // the entries were loaded with the table (two integers per record)
+    if (idx >= 1 && idx <= numEntries) {
+        offset = entries[(idx - 1) * 2];
+        length = entries[(idx - 1) * 2 + 1];
+    }
+    else {
+        offset = 0;
+        length = 0;
     }
 }
 
@@ -70,6 +61,17 @@ void VpfIndexTable::loadIndexTableFromFile(const char* pathname, const char* fil
         // number of bytes in table header
         inStream.read((char*)&numBytes, sizeof(numBytes));
         //std::cout << "NUM BYTES IN HEADER = " << numBytes << std::endl;
+        // now the offset and length of each record
+        if (numEntries < 0) numEntries = 0;
+        entries.assign(numEntries * 2, 0);
+        if (numEntries > 0) {
+            inStream.read(reinterpret_cast<char*>(entries.data()), numEntries * recordSize);
+            if (inStream.gcount() < numEntries * recordSize) {
+                // short file; only keep the complete entries
+                numEntries = static_cast<int>(inStream.gcount()) / recordSize;
+                entries.resize(numEntries * 2);
+            }
+        }
         loaded = true;
     }
     inStream.close();
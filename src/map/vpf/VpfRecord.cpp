@@ -9,10 +9,37 @@
 
 #include <cstdlib>
 #include <fstream>
+#include <streambuf>
 
 namespace mixr {
 namespace vpf {
 
+namespace {
+// Read-only stream buffer over a table's file contents (see VpfTable::getFileData())
+class MemoryBuffer : public std::streambuf
+{
+public:
+    MemoryBuffer(const char* const data, const std::size_t size) {
+        char* const p {const_cast<char*>(data)};
+        setg(p, p, p + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+        off_type pos {off};
+        if (dir == std::ios_base::cur) pos += (gptr() - eback());
+        else if (dir == std::ios_base::end) pos += (egptr() - eback());
+        if (pos < 0 || pos > (egptr() - eback())) return pos_type(off_type(-1));
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+}
+
 IMPLEMENT_SUBCLASS(VpfRecord, "VpfRecord")
 EMPTY_SLOTTABLE(VpfRecord)
 EMPTY_COPYDATA(VpfRecord)
@@ -47,10 +74,20 @@ void VpfRecord::createRecord(VpfTable* x, const char* file, const int idx)
     index = idx;
 
     // ok, we have our table and our file, let's open it up, skip the header, 
-    // grab the record, then load up our data, and return
-    std::ifstream stream;
-    stream.open(filename->c_str());
-    if (!stream.fail() && parent != 0) {
+    // grab the record, then load up our data, and return; use the table's
+    // file contents, if it has them, instead of reopening the file
+    std::ifstream fileStream;
+    std::istream stream(nullptr);
+    const char* fileData {(parent != nullptr ? parent->getFileData() : nullptr)};
+    MemoryBuffer buffer(fileData, (fileData != nullptr ? parent->getFileSize() : 0));
+    if (fileData != nullptr) {
+        stream.rdbuf(&buffer);
+    }
+    else {
+        fileStream.open(filename->c_str());
+        if (!fileStream.fail()) stream.rdbuf(fileStream.rdbuf());
+    }
+    if (stream.rdbuf() != nullptr && parent != 0) {
         // let's try to get the size of my file contents
         stream.seekg(0);
         std::streamoff begin{stream.tellg()};
@@ -378,7 +415,6 @@ void VpfRecord::createRecord(VpfTable* x, const char* file, const int idx)
                 std::cout << "ERROR: VPFTable has no index table and no associated record!" << std::endl;
             }
         }
-        stream.close();
     }
     else {
         std::cout << "FAILURE TO OPEN FILE = " << filename->c_str() << std::endl;
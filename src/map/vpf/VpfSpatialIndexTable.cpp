@@ -4,8 +4,10 @@
 
 #include "mixr/base/String.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <cstring>
 
 namespace mixr {
 namespace vpf {
@@ -25,6 +27,9 @@ void VpfSpatialIndexTable::deleteData()
         fullPath->unref();
         fullPath = nullptr;
     }
+    prims.clear();
+    nodes.clear();
+    nodePrims.clear();
 }
 
 void VpfSpatialIndexTable::loadIndexTableFromFile(const char* pathname, const char* filename, const int t)
@@ -59,6 +64,43 @@ void VpfSpatialIndexTable::loadIndexTableFromFile(const char* pathname, const ch
         headerByteOffset = 24;
         binSize = numNodes * 8;
 
+        // read the rest of the file, the cells and their primitives, ...
+        std::vector<char> data;
+        inStream.seekg(0, std::ios::end);
+        const std::streamoff fileSize {inStream.tellg()};
+        if (fileSize > 0) {
+            data.resize(static_cast<std::size_t>(fileSize));
+            inStream.seekg(0, std::ios::beg);
+            inStream.read(data.data(), fileSize);
+        }
+
+        // ... and collect the primitives in cell order
+        prims.clear();
+        nodes.clear();
+        nodePrims.clear();
+        const long long size {static_cast<long long>(data.size())};
+        for (int i = 0; i < numNodes && (headerByteOffset + i * 8 + 8) <= size; i++) {
+            int offset {}, count {};
+            std::memcpy(&offset, &data[headerByteOffset + (i * 8)], sizeof(offset));
+            std::memcpy(&count, &data[headerByteOffset + (i * 8) + 4], sizeof(count));
+            const long long start {static_cast<long long>(headerByteOffset) + binSize + offset};
+            for (int j = 0; j < count && start >= 0 && (start + j * 8 + 8) <= size; j++) {
+                const char* p {&data[start + j * 8]};
+                Primitive prim;
+                prim.minLon = static_cast<unsigned char>(p[0]);
+                prim.minLat = static_cast<unsigned char>(p[1]);
+                prim.maxLon = static_cast<unsigned char>(p[2]);
+                prim.maxLat = static_cast<unsigned char>(p[3]);
+                std::memcpy(&prim.id, p + 4, sizeof(prim.id));
+                prims.push_back(prim);
+            }
+        }
+
+        // build our quadtree over the 256 x 256 spatial grid
+        std::vector<int> list(prims.size());
+        for (std::size_t i = 0; i < prims.size(); i++) list[i] = static_cast<int>(i);
+        buildNode(list, 0, 0, 256);
+
         loaded = true;
         inStream.close();
     }
@@ -68,11 +110,19 @@ void VpfSpatialIndexTable::loadIndexTableFromFile(const char* pathname, const ch
 }
 
 int VpfSpatialIndexTable::findPrimitivesBySpatialQuery(const float lat, const float lon, int primIds[], const float width, const float height)
+{
+    std::vector<int> found;
+    const int primCount {findPrimitivesBySpatialQuery(lat, lon, found, width, height)};
+    for (int i = 0; i < primCount; i++) primIds[i] = found[i];
+    return primCount;
+}
+
+int VpfSpatialIndexTable::findPrimitivesBySpatialQuery(const float lat, const float lon, std::vector<int>& primIds, const float width, const float height) const
 {
     //std::cout << "LAT / LON = " << lat << " / " << lon << std::endl;
-    int primCount {}; 
+    primIds.clear();
     // first, check our minimum bounding rectangle just to see if we contain this lat/lon point
-    if ((lon >= mbrX1 && lon <= mbrX2) && (lat >= mbrY1 && lat <= mbrY2)) {
+    if (!nodes.empty() && (lon >= mbrX1 && lon <= mbrX2) && (lat >= mbrY1 && lat <= mbrY2)) {
         //std::cout << "VALID LAT / LON convert to spatial coordinates!" << std::endl;
         int x{}, y{};
         int left{}, right{}, top{}, bottom{};
@@ -95,66 +145,99 @@ int VpfSpatialIndexTable::findPrimitivesBySpatialQuery(const float lat, const fl
         std::cout << "TOP RIGHT Spatial point = " << top << ", " << right << std::endl;
         std::cout << "BOTTOM LEFT Spatial point = " << bottom << ", " << left << std::endl;
 #endif
-        // ok, we have the spatial point, now let's start reading the records that are in this coordinate
-        std::fstream stream;
-        stream.open(fullPath->c_str(), std::ios::in | std::ios::binary);
-        if (stream.fail()) std::cout << "COULD NOT OPEN FILE = " << fullPath->c_str() << std::endl;
+        // walk the quadtree, and then put the primitives back into the file's order
+        std::vector<int> found;
+        searchNode(0, spaceQuery, x, y, left, right, top, bottom, found);
+        std::sort(found.begin(), found.end());
+        for (const int p : found) primIds.push_back(prims[p].id);
+    }
+    return static_cast<int>(primIds.size());
+}
+
+// builds the quadtree node for the primitives 'list' within the region; returns the node's index
+int VpfSpatialIndexTable::buildNode(std::vector<int>& list, const int x0, const int y0, const int size)
+{
+    const int idx {static_cast<int>(nodes.size())};
+    nodes.push_back(Node());
+    nodes[idx].x0 = x0;
+    nodes[idx].y0 = y0;
+    nodes[idx].size = size;
+
+    // sort the primitives that fit within one of our quadrants into that quadrant
+    std::vector<int> quads[4];
+    std::vector<int> mine;
+    const int half {size / 2};
+    const bool split {static_cast<int>(list.size()) > MAX_LEAF_PRIMS && half >= MIN_NODE_SIZE};
+    for (const int p : list) {
+        const Primitive& prim {prims[p]};
+        int q {-1};
+        if (split && prim.minLon <= prim.maxLon && prim.minLat <= prim.maxLat) {
+            const int midX {x0 + half};
+            const int midY {y0 + half};
+            int qx {-1}, qy {-1};
+            if (prim.maxLon < midX) qx = 0;
+            else if (prim.minLon >= midX) qx = 1;
+            if (prim.maxLat < midY) qy = 0;
+            else if (prim.minLat >= midY) qy = 1;
+            if (qx >= 0 && qy >= 0) q = qy * 2 + qx;
+        }
+        if (q >= 0) quads[q].push_back(p);
+        else mine.push_back(p);
+    }
+    list.clear();
+
+    // our primitives ...
+    nodes[idx].first = static_cast<int>(nodePrims.size());
+    nodes[idx].count = static_cast<int>(mine.size());
+    nodePrims.insert(nodePrims.end(), mine.begin(), mine.end());
+
+    // ... and our children
+    for (int q = 0; q < 4; q++) {
+        if (!quads[q].empty()) {
+            const int child {buildNode(quads[q], x0 + (q % 2) * half, y0 + (q / 2) * half, half)};
+            nodes[idx].child[q] = child;
+        }
+    }
+    return idx;
+}
+
+// searches the node, and its children, for primitives that fit the query
+void VpfSpatialIndexTable::searchNode(const int node, const bool spaceQuery, const int x, const int y,
+                                      const int left, const int right, const int top, const int bottom,
+                                      std::vector<int>& found) const
+{
+    const Node& n {nodes[node]};
+
+    // our primitives are within our region, so skip regions that miss the query
+    const int x1 {n.x0 + n.size - 1};
+    const int y1 {n.y0 + n.size - 1};
+    if (spaceQuery) {
+        if (right < n.x0 || left > x1 || top < n.y0 || bottom > y1) return;
+    }
+    else {
+        if (x < n.x0 || x > x1 || y < n.y0 || y > y1) return;
+    }
+
+    for (int i = n.first; i < n.first + n.count; i++) {
+        const Primitive& prim {prims[nodePrims[i]]};
+        if (spaceQuery) {
+            if ((left <= prim.minLon && right >= prim.maxLon) && (top >= prim.maxLat && bottom <= prim.minLat)) {
+                found.push_back(nodePrims[i]);
+            }
+        }
         else {
-            // now get our first cell, and go from there
-            for (int i = 0; i < numNodes; i++) {
-                stream.seekg(headerByteOffset + (i * 8), std::ios::beg);
-                int offset {}, count {};
-                stream.read((char*)&offset, sizeof(offset));
-                stream.read((char*)&count, sizeof(count));
-                if (count == 0 && offset == 0) {
-                    //std::cout << "NO PRIMITIVES FOR CELL #" << i+1 << std::endl;
-                }
-                else {
-                    //std::cout << "CELL #" << i+1 << " OFFSET/COUNT = " << offset << " / " << count << std::endl;
-                    stream.seekg(headerByteOffset + binSize + offset, std::ios::beg);
-                    // now read our primitive information
-                    for (int i = 0; i < count; i++) {
-                        int minLon {};
-                        int minLat {};
-                        int maxLon {};
-                        int maxLat {};
-                        stream.read((char*)&minLon, 1);
-                        stream.read((char*)&minLat, 1);
-                        stream.read((char*)&maxLon, 1);
-                        stream.read((char*)&maxLat, 1);
-                        int primId {};
-                        stream.read((char*)&primId, sizeof(primId));
-                        if (spaceQuery) {
-                            if ((left <= minLon && right >= maxLon) && (top >= maxLat && bottom <= minLat)) {
-                                //std::cout << "PRIMITIVE ID OF PRIMITIVE THAT FITS QUERY = " << primId << std::endl;
-                                //std::cout << "Min LONGITUDE = " << minLon << std::endl;
-                                //std::cout << "Max LONGITUDE = " << maxLon << std::endl;
-                                //std::cout << "Min LATITUDE = " << minLat << std::endl;
-                                //std::cout << "Max LATITUDE = " << maxLat << std::endl;
-                                primIds[primCount++] = primId;
-                            }
-                        }
-                        else {
-                            if ((x >= minLon && x <= maxLon) && (y >= minLat && y <= maxLat)) {
-                                //std::cout << "PRIMITIVE ID OF PRIMITIVE THAT FITS QUERY = " << primId << std::endl;
-                                //std::cout << "Min LONGITUDE = " << minLon << std::endl;
-                                //std::cout << "Max LONGITUDE = " << maxLon << std::endl;
-                                //std::cout << "Min LATITUDE = " << minLat << std::endl;
-                                //std::cout << "Max LATITUDE = " << maxLat << std::endl;
-                                primIds[primCount++] = primId;
-                            }
-                        }
-                    }
-                }
+            if ((x >= prim.minLon && x <= prim.maxLon) && (y >= prim.minLat && y <= prim.maxLat)) {
+                found.push_back(nodePrims[i]);
             }
-            stream.close();       
         }
     }
-    return primCount;
 
+    for (int q = 0; q < 4; q++) {
+        if (n.child[q] >= 0) searchNode(n.child[q], spaceQuery, x, y, left, right, top, bottom, found);
+    }
 }
 
-void VpfSpatialIndexTable::convertDegsToSpatialPoint(const float lat, const float lon, int& y, int& x)
+void VpfSpatialIndexTable::convertDegsToSpatialPoint(const float lat, const float lon, int& y, int& x) const
 {
     // we should already have checked the mbr to make sure these lat/lons are valid
     if ((mbrY2 - mbrY1) != 0) y = static_cast<int>(255 * (lat - mbrY1) / (mbrY2 - mbrY1));
@@ -30,11 +30,10 @@ VpfTable::VpfTable()
 void VpfTable::deleteData()
 {
     // delete all of our data objects
-    for (int i = 0; i < MAX_ROWS; i++) {
-        if (records[i] != nullptr) records[i]->unref();
-        records[i] = nullptr;
-    }
+    clearRecords();
+    fileData.clear();
     if (idxTable != nullptr) idxTable->unref();
+    idxTable = nullptr;
     if (path != nullptr) {
         path->unref();
         path = nullptr;
@@ -85,6 +84,14 @@ bool VpfTable::loadTableFromFile(const char* pathname, const char* filename, con
     }
     else {         
         ok = true;
+        // read the whole file into memory; our records are decoded from it
+        inStream.seekg(0, std::ios::end);
+        const std::streamoff fileSize {inStream.tellg()};
+        fileData.resize(fileSize > 0 ? static_cast<std::size_t>(fileSize) : 0);
+        inStream.seekg(0, std::ios::beg);
+        if (!fileData.empty()) inStream.read(fileData.data(), fileSize);
+        inStream.clear();
+        clearRecords();
         // start reading our file
         headerLength = 0;
         inStream.seekg(0, std::ios::beg);
@@ -193,6 +200,7 @@ bool VpfTable::loadTableFromFile(const char* pathname, const char* filename, con
         }
         // now at the end, load our index file if we need to
         if (hasIdx) loadIndexFile();
+        determineNumberOfRows();
         //std::cout << std::endl;
 
         // if we are a certain type of table, we need specific information
@@ -231,34 +239,74 @@ void VpfTable::loadIndexFile()
 
 VpfRecord* VpfTable::getRecord(const int idx)
 {
-    if (idx < MAX_ROWS && path != nullptr && name != nullptr) {
-        if (records[idx-1] == nullptr) {
-            // we haven't created this record yet, so let's do it
-            records[idx-1] = new VpfRecord();
-            // this will load the record for us
-            base::String* string = new base::String(path->c_str());
-            string->catStr(name->c_str());
-            records[idx-1]->createRecord(this, string->c_str(), idx);
-            string->unref();
-            //std::cout << "CREATED RECORD NUMBER AND TABLE NAME = " << idx << ", " << this->getType() << std::endl;
-            // if our record is invalid, it means we have reached the end of the record
-            bool eor {records[idx-1]->isEOR()};
-            if (eor) {
-                // we have to delete our record, because it's was not valid
-                records[idx-1]->unref();
-                records[idx-1] = nullptr;
-                return nullptr;
-            }
-            else return records[idx-1];
+    if (idx >= 1 && idx <= numRows && path != nullptr && name != nullptr) {
+        const auto it = records.find(idx);
+        if (it != records.end()) {
+            // cache hit; it's now our most recently used record
+            lru.splice(lru.begin(), lru, it->second.lru);
+            it->second.record->ref();
+            return it->second.record;
+        }
+
+        // we haven't created this record yet, so let's do it
+        VpfRecord* record {new VpfRecord()};
+        // this will load the record for us
+        base::String* string = new base::String(path->c_str());
+        string->catStr(name->c_str());
+        record->createRecord(this, string->c_str(), idx);
+        string->unref();
+        //std::cout << "CREATED RECORD NUMBER AND TABLE NAME = " << idx << ", " << this->getType() << std::endl;
+        // if our record is invalid, it means we have reached the end of the record
+        if (record->isEOR()) {
+            // we have to delete our record, because it's was not valid
+            record->unref();
+            return nullptr;
         }
-        else {
-            if (records[idx-1]->isEOR()) return nullptr;
-            return records[idx-1];
+
+        // drop our least recently used record, if the cache is full (its
+        // users still have their references)
+        if (static_cast<int>(records.size()) >= MAX_CACHED_RECORDS) {
+            const int oldest {lru.back()};
+            lru.pop_back();
+            const auto old = records.find(oldest);
+            old->second.record->unref();
+            records.erase(old);
         }
+        lru.push_front(idx);
+        CachedRecord& entry = records[idx];
+        entry.record = record;
+        entry.lru = lru.begin();
+        // one reference for the cache, and one for our caller
+        record->ref();
+        return record;
     }
     return nullptr;
 }
 
+void VpfTable::clearRecords()
+{
+    for (auto& entry : records) {
+        entry.second.record->unref();
+    }
+    records.clear();
+    lru.clear();
+}
+
+void VpfTable::determineNumberOfRows()
+{
+    numRows = 0;
+    if (recordSize > 0) {
+        // fixed length records follow the header (and its length); a partial
+        // last record is still counted
+        const long long dataSize {static_cast<long long>(fileData.size()) - headerLength - static_cast<long long>(sizeof(int))};
+        if (dataSize > 0) numRows = static_cast<int>((dataSize + recordSize - 1) / recordSize);
+    }
+    else if (idxTable != nullptr) {
+        // variable length records, one per index entry
+        numRows = idxTable->getNumRecords();
+    }
+}
+
 void VpfTable::determineRecordSize()
 {
     // determine our total record size
@@ -5,7 +5,10 @@
 #include "mixr/models/system/Gimbal.hpp"
 #include "mixr/models/WorldModel.hpp"
 
+#include "mixr/terrain/LosBatch.hpp"
+#include "mixr/terrain/LosService.hpp"
 #include "mixr/terrain/Terrain.hpp"
+#include "mixr/terrain/Viewshed.hpp"
 
 #include "mixr/base/List.hpp"
 #include "mixr/base/PairStream.hpp"
@@ -82,6 +85,12 @@ void Tdb::deleteData()
 {
    resizeArrays(0);
    setGimbal(nullptr);
+
+   clearLosCandidates();
+   if (losBatch != nullptr) {
+      delete losBatch;
+      losBatch = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -175,6 +184,12 @@ bool Tdb::resizeArrays(const unsigned int newSize)
 //------------------------------------------------------------------------------
 unsigned int Tdb::processPlayers(base::PairStream* const players)
 {
+   // ---
+   // Clear the last frame's targets and checks (we may be reused)
+   // ---
+   clearArrays();
+   clearLosCandidates();
+
    // ---
    // Early out checks (no ownship, no players of interest, no target data arrays)
    // ---
@@ -184,9 +199,16 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    // Terrain occulting check setup
    // ---
    const terrain::Terrain* terrain{};
+   const terrain::LosService* service{};
+   const terrain::Viewshed* viewshed{};
    if (gimbal->isTerrainOccultingEnabled()) {
       const WorldModel* const sim{ownship->getWorldModel()};
       terrain = sim->getTerrain();
+      service = sim->getLosService();
+
+      // Use the gimbal's cached viewshed, if it's ready for our position
+      viewshed = gimbal->getViewshed();
+      if (terrain == nullptr || (viewshed != nullptr && !viewshed->isReady())) viewshed = nullptr;
    }
 
    // ---
@@ -273,6 +295,15 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    // Are we a space vehicle?
    const bool osSpaceVehicle{ownship->isMajorType(Player::SPACE_VEHICLE)};
 
+   // Batch the terrain occulting checks with the line-of-sight service?
+   const bool batchLos{terrain != nullptr && service != nullptr && viewshed == nullptr && !osSpaceVehicle};
+   if (batchLos) {
+      if (losBatch == nullptr) losBatch = new terrain::LosBatch();
+      losBatch->clear();
+      losTerrain = terrain;
+      losService = service;
+   }
+
    // ---
    // 1) Scan the player list ---
    // ---
@@ -349,7 +380,38 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
 
                   // Terrain occulting if we have terrain data and we're not a space vehicle
                   bool occulted{};
-                  if (terrain != nullptr && !osSpaceVehicle) {
+                  if (viewshed != nullptr && !osSpaceVehicle) {
+                     // Table lookup using the cached viewshed
+                     const double tgtLat{target->getLatitude()};
+                     const double tgtLon{target->getLongitude()};
+                     const double tgtAlt{target->getAltitudeM()};
+
+                     if ( target->isMajorType(Player::SPACE_VEHICLE) ) {
+                        double tbrg{}, distNM{};
+                        base::nav::vll2bd(osLat, osLon, tgtLat, tgtLon, &tbrg, &distNM);
+                        occulted = viewshed->isOcculted(tbrg, (60.0 * base::length::NM2M), -tanTgtAng);
+                     } else {
+                        occulted = viewshed->isTargetOcculted(tgtLat, tgtLon, tgtAlt);
+                     }
+                  }
+                  else if (batchLos) {
+                     // Queue the check with the other candidate targets
+                     const double tgtLat{target->getLatitude()};
+                     const double tgtLon{target->getLongitude()};
+                     const double tgtAlt{target->getAltitudeM()};
+
+                     if ( target->isMajorType(Player::SPACE_VEHICLE) ) {
+                        double tbrg{}, distNM{};
+                        base::nav::vll2bd(osLat, osLon, tgtLat, tgtLon, &tbrg, &distNM);
+                        losBatch->addQuery(osLat, osLon, osAlt, tbrg, (60.0 * base::length::NM2M), -tanTgtAng);
+                     } else {
+                        losBatch->addTarget(osLat, osLon, osAlt, tgtLat, tgtLon, tgtAlt);
+                     }
+                     target->ref();
+                     losCandidates.push_back(target);
+                     occulted = true;  // (added by completeLosChecks())
+                  }
+                  else if (terrain != nullptr && !osSpaceVehicle) {
 
                      const double tgtLat{target->getLatitude()};
                      const double tgtLon{target->getLongitude()};
@@ -386,9 +448,61 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
       }
    }
 
+   // ---
+   // 2) Batched terrain occulting: the candidates wait for the service
+   // ---
+   losPending = !losCandidates.empty();
+
+   return numTgts;
+}
+
+//------------------------------------------------------------------------------
+// Complete the batched terrain occulting checks --- add the visible candidate
+// targets, in order, after the line-of-sight batch has been processed.
+// (Background task)
+//------------------------------------------------------------------------------
+unsigned int Tdb::completeLosChecks()
+{
+   if (losPending && losBatch != nullptr && losBatch->isProcessed()) {
+      const unsigned int n{static_cast<unsigned int>(losCandidates.size())};
+      for (unsigned int i = 0; i < n && numTgts < maxTargets; i++) {
+         if (losBatch->isVisible(i)) {
+            losCandidates[i]->ref();
+            targets[numTgts++] = losCandidates[i];
+         }
+      }
+   }
+   clearLosCandidates();
+
    return numTgts;
 }
 
+//------------------------------------------------------------------------------
+// Process the batched terrain occulting checks by ourself, and complete them
+// (Background task)
+//------------------------------------------------------------------------------
+unsigned int Tdb::processLosChecks()
+{
+   if (losPending && losService != nullptr) {
+      losService->process(losTerrain, losBatch);
+   }
+   return completeLosChecks();
+}
+
+//------------------------------------------------------------------------------
+// Clear the candidate targets of the batched terrain occulting checks
+//------------------------------------------------------------------------------
+void Tdb::clearLosCandidates()
+{
+   for (Player* const p : losCandidates) {
+      p->unref();
+   }
+   losCandidates.clear();
+   losTerrain = nullptr;
+   losService = nullptr;
+   losPending = false;
+}
+
 
 //------------------------------------------------------------------------------
 // Compute Boresight Data --- Scan the target list, which as been pre-processed by
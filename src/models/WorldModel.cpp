@@ -12,10 +12,15 @@
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Number.hpp"
 
+#include "mixr/base/util/atomics.hpp"
 #include "mixr/base/util/nav_utils.hpp"
 
 // environment models
 #include "mixr/models/environment/AbstractAtmosphere.hpp"
+#include "mixr/models/system/Gimbal.hpp"
+#include "mixr/models/Tdb.hpp"
+#include "mixr/terrain/LosBatch.hpp"
+#include "mixr/terrain/LosService.hpp"
 #include "mixr/terrain/Terrain.hpp"
 
 #include <cmath>
@@ -41,6 +46,7 @@ BEGIN_SLOTTABLE(WorldModel)
 
    "terrain",                 //  6) Terrain elevation database
    "atmosphere",              //  7) Atmospheric model
+   "losService",              //  8) Terrain line-of-sight service
 END_SLOTTABLE(WorldModel)
 
 BEGIN_SLOT_MAP(WorldModel)
@@ -59,6 +65,7 @@ BEGIN_SLOT_MAP(WorldModel)
 
     ON_SLOT( 6, setSlotTerrain,              terrain::Terrain)
     ON_SLOT( 7, setSlotAtmosphere,           AbstractAtmosphere)
+    ON_SLOT( 8, setSlotLosService,           terrain::LosService)
 END_SLOT_MAP()
 
 WorldModel::WorldModel()
@@ -106,10 +113,25 @@ void WorldModel::copyData(const WorldModel& org, const bool cc)
    else {
       setSlotAtmosphere(nullptr);
    }
+
+   if (org.losService != nullptr) {
+      terrain::LosService* copy = org.losService->clone();
+      setSlotLosService( copy );
+      copy->unref();
+   }
+   else {
+      setSlotLosService(nullptr);
+   }
 }
 
 void WorldModel::deleteData()
 {
+   clearLosChecks();
+   if (losFrameBatch != nullptr) {
+      delete losFrameBatch;
+      losFrameBatch = nullptr;
+   }
+   setSlotLosService( nullptr );
    setSlotAtmosphere( nullptr );
    setSlotTerrain( nullptr );
 }
@@ -131,6 +153,87 @@ void WorldModel::reset()
    // Reset atmospheric model
    // ---
    if (atmosphere != nullptr) atmosphere->reset();
+
+   // ---
+   // Reset (and start the threads of) the line-of-sight service
+   // ---
+   if (losService != nullptr) losService->reset();
+}
+
+//------------------------------------------------------------------------------
+// updateData() -- update background data here
+//------------------------------------------------------------------------------
+void WorldModel::updateData(const double dt)
+{
+   // ---
+   // Update our players, who queue their terrain occulting checks ...
+   // ---
+   losQueueing = (losService != nullptr && terrain != nullptr);
+   BaseClass::updateData(dt);
+   losQueueing = false;
+
+   // ---
+   // ... and then evaluate all of them as one batch
+   // ---
+   processLosChecks();
+}
+
+//------------------------------------------------------------------------------
+// queueLosChecks() -- queue the TDB's terrain occulting checks with the
+// frame's other checks (called by the background threads)
+//------------------------------------------------------------------------------
+bool WorldModel::queueLosChecks(Gimbal* const gimbal, Tdb* const tdb)
+{
+   bool ok{};
+   if (losQueueing && gimbal != nullptr && tdb != nullptr && tdb->getLosBatch() != nullptr) {
+      gimbal->ref();
+      tdb->ref();
+      LosChecks checks;
+      checks.gimbal = gimbal;
+      checks.tdb = tdb;
+      base::lock(losSemaphore);
+      losChecks.push_back(checks);
+      base::unlock(losSemaphore);
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// processLosChecks() -- evaluate the frame's queued terrain occulting checks
+// as one batch, and hand the TDBs back to their gimbals
+//------------------------------------------------------------------------------
+void WorldModel::processLosChecks()
+{
+   if (losChecks.empty()) return;
+
+   losBatches.clear();
+   for (const LosChecks& checks : losChecks) {
+      losBatches.push_back(checks.tdb->getLosBatch());
+   }
+
+   if (losFrameBatch == nullptr) losFrameBatch = new terrain::LosBatch();
+   if (losService != nullptr) {
+      losService->process(terrain, losBatches.data(), static_cast<unsigned int>(losBatches.size()), losFrameBatch);
+   }
+
+   for (const LosChecks& checks : losChecks) {
+      checks.gimbal->losChecksProcessed(checks.tdb);
+   }
+   clearLosChecks();
+}
+
+//------------------------------------------------------------------------------
+// clearLosChecks() -- release the queued terrain occulting checks
+//------------------------------------------------------------------------------
+void WorldModel::clearLosChecks()
+{
+   for (const LosChecks& checks : losChecks) {
+      checks.tdb->unref();
+      checks.gimbal->unref();
+   }
+   losChecks.clear();
+   losBatches.clear();
 }
 
 bool WorldModel::shutdownNotification()
@@ -145,6 +248,8 @@ bool WorldModel::shutdownNotification()
    // ---
    if (atmosphere != nullptr) atmosphere->event(SHUTDOWN_EVENT);
    if (terrain != nullptr) terrain->event(SHUTDOWN_EVENT);
+   if (losService != nullptr) losService->event(SHUTDOWN_EVENT);
+   clearLosChecks();
 
    return true;
 }
@@ -365,6 +470,12 @@ const AbstractAtmosphere* WorldModel::getAtmosphere() const
    return atmosphere;
 }
 
+// returns the terrain line-of-sight service
+const terrain::LosService* WorldModel::getLosService() const
+{
+   return losService;
+}
+
 bool WorldModel::setSlotTerrain(terrain::Terrain* const msg)
 {
    if (terrain != nullptr) terrain->unref();
@@ -381,5 +492,13 @@ bool WorldModel::setSlotAtmosphere(AbstractAtmosphere* const msg)
    return true;
 }
 
+bool WorldModel::setSlotLosService(terrain::LosService* const msg)
+{
+   if (losService != nullptr) losService->unref();
+   losService = msg;
+   if (losService != nullptr) losService->ref();
+   return true;
+}
+
 }
 }
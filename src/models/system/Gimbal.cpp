@@ -3,6 +3,10 @@
 #include "mixr/models/player/Player.hpp"
 #include "mixr/models/Emission.hpp"
 #include "mixr/models/Tdb.hpp"
+#include "mixr/models/WorldModel.hpp"
+
+#include "mixr/terrain/Terrain.hpp"
+#include "mixr/terrain/Viewshed.hpp"
 
 #include "mixr/base/Identifier.hpp"
 #include "mixr/base/List.hpp"
@@ -70,6 +74,7 @@ BEGIN_SLOTTABLE(Gimbal)
     "localPlayersOfInterestOnly",   // 34: Sets the local only players of interest flag (default: false)
     "useWorldCoordinates",          // 35: Using player of interest's world (ECEF) coordinate system
     "ownHeadingOnly",               // 36: Whether only the ownship heading is used by the target data block
+    "viewshed",                     // 37: Cached terrain viewshed (stationary sensors)
 END_SLOTTABLE(Gimbal)
 
 BEGIN_SLOT_MAP(Gimbal)
@@ -121,6 +126,7 @@ BEGIN_SLOT_MAP(Gimbal)
 
     ON_SLOT(35, setSlotUseWorldCoordinates,        base::Boolean)    // Using player of interest's world (ECEF) coordinate system
     ON_SLOT(36, setSlotUseOwnHeadingOnly,          base::Boolean)
+    ON_SLOT(37, setSlotViewshed,                   terrain::Viewshed)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(Gimbal)
@@ -186,12 +192,21 @@ void Gimbal::copyData(const Gimbal& org, const bool cc)
    playerTypes = org.playerTypes;
    maxPlayers = org.maxPlayers;
 
-   tdb = nullptr;
+   if (org.viewshed != nullptr) {
+      terrain::Viewshed* copy{org.viewshed->clone()};
+      setSlotViewshed(copy);
+      copy->unref();
+   } else {
+      setSlotViewshed(nullptr);
+   }
+
+   clearTdbs();
 }
 
 void Gimbal::deleteData()
 {
-   tdb = nullptr;
+   clearTdbs();
+   setSlotViewshed(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -204,6 +219,9 @@ void Gimbal::reset()
    cmdPos = initCmdPos;
    updateMatrix();
    BaseClass::reset();
+
+   // Start generating our viewshed (if the terrain's loaded)
+   updateViewshed();
 }
 
 //------------------------------------------------------------------------------
@@ -211,7 +229,8 @@ void Gimbal::reset()
 //------------------------------------------------------------------------------
 bool Gimbal::shutdownNotification()
 {
-    tdb = nullptr;
+    clearTdbs();
+    if (viewshed != nullptr) viewshed->event(SHUTDOWN_EVENT);
 
     return BaseClass::shutdownNotification();
 }
@@ -1187,6 +1206,31 @@ bool Gimbal::setSlotUseOwnHeadingOnly(const base::Boolean* const msg)
    return ok;
 }
 
+// Cached terrain viewshed
+bool Gimbal::setSlotViewshed(terrain::Viewshed* const msg)
+{
+   if (viewshed != nullptr) viewshed->unref();
+   viewshed = msg;
+   if (viewshed != nullptr) viewshed->ref();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// updateViewshed() -- updates the cached terrain viewshed for our ownship's
+// position; the viewshed is (re)generated in the background when our ownship
+// has moved beyond its tolerance.
+//------------------------------------------------------------------------------
+void Gimbal::updateViewshed()
+{
+   if (viewshed != nullptr && terrainOcculting) {
+      const Player* own{getOwnship()};
+      const WorldModel* sim{getWorldModel()};
+      if (own != nullptr && sim != nullptr) {
+         viewshed->update(sim->getTerrain(), own->getLatitude(), own->getLongitude(), own->getAltitudeM());
+      }
+   }
+}
+
 //------------------------------------------------------------------------------
 // updateMatrix() -- update the A/C coord to gimbal's coord matrix
 //------------------------------------------------------------------------------
@@ -1290,15 +1334,73 @@ void Gimbal::limitVec(base::Vec3d& vec, const base::Vec3d& ll, const base::Vec3d
 //------------------------------------------------------------------------------
 unsigned int Gimbal::processPlayersOfInterest(base::PairStream* const poi)
 {
-   const auto tdb0 = new Tdb(maxPlayers, this);
+   updateViewshed();
+
+   // Reuse our last TDB, and its storage, if no one else is using it
+   Tdb* tdb0{};
+   if (spareTdb != nullptr && spareTdb->getRefCount() == 1 && spareTdb->getMaxTargets() == maxPlayers) {
+      tdb0 = spareTdb;
+   } else {
+      if (spareTdb != nullptr) spareTdb->unref();
+      tdb0 = new Tdb(maxPlayers, this);
+   }
+   spareTdb = nullptr;
 
    unsigned int ntgts{tdb0->processPlayers(poi)};
-   setCurrentTdb(tdb0);
+
+   if (tdb0->isLosPending()) {
+      // Queue the terrain occulting checks with the frame's other checks;
+      // the TDB becomes current once they've been processed
+      WorldModel* const sim{getWorldModel()};
+      if (sim != nullptr && sim->queueLosChecks(this, tdb0)) {
+         if (pendingTdb != nullptr) pendingTdb->unref();
+         pendingTdb = tdb0;
+         return ntgts;
+      }
+      ntgts = tdb0->processLosChecks();
+   }
+   makeCurrentTdb(tdb0);
    tdb0->unref();
 
    return ntgts;
 }
 
+//------------------------------------------------------------------------------
+// losChecksProcessed() -- the TDB's queued terrain occulting checks have been
+// processed (see WorldModel::queueLosChecks())
+//------------------------------------------------------------------------------
+void Gimbal::losChecksProcessed(Tdb* const tdb0)
+{
+   // Ignore a TDB that was replaced while it was waiting
+   if (tdb0 != nullptr && tdb0 == pendingTdb) {
+      tdb0->completeLosChecks();
+      pendingTdb = nullptr;
+      makeCurrentTdb(tdb0);
+      tdb0->unref();
+   }
+}
+
+//------------------------------------------------------------------------------
+// makeCurrentTdb() -- sets the current TDB, and keeps the old one as our spare
+//------------------------------------------------------------------------------
+void Gimbal::makeCurrentTdb(Tdb* const newTdb)
+{
+   Tdb* const old{tdb.getRefPtr()};
+   setCurrentTdb(newTdb);
+   if (spareTdb != nullptr) spareTdb->unref();
+   spareTdb = old;
+}
+
+//------------------------------------------------------------------------------
+// clearTdbs() -- releases our TDBs
+//------------------------------------------------------------------------------
+void Gimbal::clearTdbs()
+{
+   tdb = nullptr;
+   if (pendingTdb != nullptr) { pendingTdb->unref(); pendingTdb = nullptr; }
+   if (spareTdb != nullptr)   { spareTdb->unref();   spareTdb = nullptr; }
+}
+
 //------------------------------------------------------------------------------
 // Returns the current TDB (pre-ref())
 //------------------------------------------------------------------------------
@@ -100,6 +100,8 @@ void IrSeeker::reset()
 //------------------------------------------------------------------------------
 unsigned int IrSeeker::processPlayersOfInterest(base::PairStream* const poi)
 {
+   updateViewshed();
+
    const auto tdb0 = new TdbIr(getMaxPlayersOfInterest(), this);
 
    unsigned int ntgts = tdb0->processPlayers(poi);
@@ -0,0 +1,384 @@
+
+#include "mixr/recorder/ColumnReader.hpp"
+#include "mixr/recorder/block_utils.hpp"
+
+#include <fstream>
+#include <cstring>
+
+namespace mixr {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(ColumnReader, "RecorderColumnReader")
+EMPTY_SLOTTABLE(ColumnReader)
+
+namespace {
+
+// Footer decoder
+class Decoder
+{
+public:
+   Decoder(const std::string& s) : data(s) {}
+
+   bool isOk() const { return ok; }
+
+   std::uint32_t u32() {
+      std::uint32_t v{};
+      if (check(4)) { v = getU32(data.data() + pos); pos += 4; }
+      return v;
+   }
+
+   double f64() {
+      double v{};
+      if (check(8)) { v = getF64(data.data() + pos); pos += 8; }
+      return v;
+   }
+
+   std::string str() {
+      std::string v;
+      const std::uint32_t n{u32()};
+      if (check(n)) { v.assign(data.data() + pos, n); pos += n; }
+      return v;
+   }
+
+private:
+   bool check(const std::size_t n) {
+      ok = ok && (pos + n <= data.length());
+      return ok;
+   }
+
+   const std::string& data;
+   std::size_t pos {};
+   bool ok {true};
+};
+
+}
+
+ColumnReader::ColumnReader()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void ColumnReader::copyData(const ColumnReader& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // Need to re-open the file
+   closeFile();
+}
+
+void ColumnReader::deleteData()
+{
+   closeFile();
+}
+
+//------------------------------------------------------------------------------
+// Open the table file and read its footer
+//------------------------------------------------------------------------------
+bool ColumnReader::isOpen() const
+{
+   return (sin != nullptr && sin->is_open());
+}
+
+bool ColumnReader::openFile(const char* const filename)
+{
+   closeFile();
+   if (filename == nullptr) return false;
+
+   sin = new std::ifstream();
+   sin->open(filename, std::ios_base::in | std::ios_base::binary);
+   if (sin->fail()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::openFile(): Failed to open table file: " << filename << std::endl;
+      }
+      closeFile();
+      return false;
+   }
+
+   const bool ok{readFooter()};
+   if (!ok) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::openFile(): Invalid or incomplete table file: " << filename << std::endl;
+      }
+      closeFile();
+   }
+   return ok;
+}
+
+void ColumnReader::closeFile()
+{
+   if (sin != nullptr) {
+      if (sin->is_open()) sin->close();
+      delete sin;
+      sin = nullptr;
+   }
+   columnInfo.clear();
+   players.clear();
+   tracks.clear();
+   groups.clear();
+}
+
+//------------------------------------------------------------------------------
+// Read the table's footer
+//------------------------------------------------------------------------------
+bool ColumnReader::readFooter()
+{
+   // trailer: footer size and file magic
+   const std::streamoff trailerSize{4 + COLUMN_FILE_MAGIC_SIZE};
+   sin->seekg(0, std::ios_base::end);
+   const std::streamoff fileSize{sin->tellg()};
+   if (fileSize < trailerSize) return false;
+
+   char trailer[4 + COLUMN_FILE_MAGIC_SIZE];
+   sin->seekg(fileSize - trailerSize);
+   sin->read(trailer, trailerSize);
+   if (sin->fail() || std::memcmp(trailer + 4, COLUMN_FILE_MAGIC, COLUMN_FILE_MAGIC_SIZE) != 0) return false;
+
+   const std::streamoff footerSize{getU32(trailer)};
+   if (footerSize + trailerSize > fileSize) return false;
+
+   std::string footer(static_cast<std::size_t>(footerSize), '\0');
+   sin->seekg(fileSize - trailerSize - footerSize);
+   sin->read(&footer[0], footerSize);
+   if (sin->fail()) return false;
+
+   Decoder dec(footer);
+
+   // table and column definitions
+   table = static_cast<ColumnTable>(dec.u32());
+   const std::uint32_t nc{dec.u32()};
+   for (std::uint32_t i = 0; i < nc && dec.isOk(); i++) {
+      ColumnInfo info;
+      info.type = static_cast<ColumnType>(dec.u32());
+      info.name = dec.str();
+      columnInfo.push_back(info);
+   }
+
+   // dictionaries
+   const std::uint32_t np{dec.u32()};
+   for (std::uint32_t i = 0; i < np && dec.isOk(); i++) {
+      Player p;
+      p.id = dec.u32();
+      p.federate = dec.str();
+      p.name = dec.str();
+      players.push_back(p);
+   }
+   const std::uint32_t nt{dec.u32()};
+   for (std::uint32_t i = 0; i < nt && dec.isOk(); i++) {
+      Track t;
+      t.player = dec.u32();
+      t.id = dec.str();
+      tracks.push_back(t);
+   }
+
+   // row group index
+   const std::uint32_t ng{dec.u32()};
+   for (std::uint32_t i = 0; i < ng && dec.isOk(); i++) {
+      Group g;
+      g.offset = dec.u32();
+      g.offset |= (static_cast<std::uint64_t>(dec.u32()) << 32);
+      g.rows = dec.u32();
+      g.startTime = dec.f64();
+      g.endTime = dec.f64();
+      groups.push_back(g);
+   }
+
+   return dec.isOk() && !columnInfo.empty();
+}
+
+//------------------------------------------------------------------------------
+// Table information
+//------------------------------------------------------------------------------
+ColumnTable ColumnReader::getTable() const
+{
+   return table;
+}
+
+unsigned int ColumnReader::getNumColumns() const
+{
+   return static_cast<unsigned int>(columnInfo.size());
+}
+
+const char* ColumnReader::getColumnName(const unsigned int idx) const
+{
+   return (idx < columnInfo.size()) ? columnInfo[idx].name.c_str() : nullptr;
+}
+
+ColumnType ColumnReader::getColumnType(const unsigned int idx) const
+{
+   return (idx < columnInfo.size()) ? columnInfo[idx].type : ColumnType::F64;
+}
+
+unsigned int ColumnReader::findColumn(const char* const name) const
+{
+   unsigned int idx{NOT_FOUND};
+   for (unsigned int i = 0; name != nullptr && i < columnInfo.size() && idx == NOT_FOUND; i++) {
+      if (columnInfo[i].name == name) idx = i;
+   }
+   return idx;
+}
+
+unsigned int ColumnReader::getNumRowGroups() const
+{
+   return static_cast<unsigned int>(groups.size());
+}
+
+unsigned int ColumnReader::getNumRows() const
+{
+   unsigned int n{};
+   for (unsigned int i = 0; i < groups.size(); i++) n += groups[i].rows;
+   return n;
+}
+
+double ColumnReader::getStartTime() const
+{
+   double t{};
+   for (unsigned int i = 0; i < groups.size(); i++) {
+      if (i == 0 || groups[i].startTime < t) t = groups[i].startTime;
+   }
+   return t;
+}
+
+double ColumnReader::getEndTime() const
+{
+   double t{};
+   for (unsigned int i = 0; i < groups.size(); i++) {
+      if (i == 0 || groups[i].endTime > t) t = groups[i].endTime;
+   }
+   return t;
+}
+
+//------------------------------------------------------------------------------
+// Dictionaries
+//------------------------------------------------------------------------------
+unsigned int ColumnReader::getNumPlayers() const
+{
+   return static_cast<unsigned int>(players.size());
+}
+
+unsigned int ColumnReader::getPlayerId(const unsigned int idx) const
+{
+   return (idx < players.size()) ? players[idx].id : 0;
+}
+
+const char* ColumnReader::getPlayerName(const unsigned int idx) const
+{
+   return (idx < players.size()) ? players[idx].name.c_str() : nullptr;
+}
+
+const char* ColumnReader::getPlayerFederate(const unsigned int idx) const
+{
+   return (idx < players.size()) ? players[idx].federate.c_str() : nullptr;
+}
+
+unsigned int ColumnReader::getNumTracks() const
+{
+   return static_cast<unsigned int>(tracks.size());
+}
+
+const char* ColumnReader::getTrackId(const unsigned int idx) const
+{
+   return (idx < tracks.size()) ? tracks[idx].id.c_str() : nullptr;
+}
+
+unsigned int ColumnReader::getTrackPlayer(const unsigned int idx) const
+{
+   return (idx < tracks.size()) ? tracks[idx].player : COLUMN_NO_ENTRY;
+}
+
+//------------------------------------------------------------------------------
+// Select the columns of the rows within the time range
+//------------------------------------------------------------------------------
+unsigned int ColumnReader::select(
+      const unsigned int* const columns,
+      const unsigned int n,
+      const double startTime,
+      const double endTime,
+      std::vector<Column>* const result
+   )
+{
+   if (result == nullptr) return 0;
+
+   result->clear();
+   result->resize(n);
+   for (unsigned int i = 0; i < n; i++) {
+      if (columns[i] >= columnInfo.size()) return 0;
+      (*result)[i].index = columns[i];
+      (*result)[i].type = columnInfo[columns[i]].type;
+   }
+   if (!isOpen()) return 0;
+
+   const std::size_t nc{columnInfo.size()};
+   const std::size_t hdrSize{28 + 4 * nc};
+
+   unsigned int numSelected{};
+   std::vector<std::streamoff> offsets(nc);
+   std::vector<std::uint32_t> sizes(nc);
+   std::vector<unsigned int> rows;
+
+   for (unsigned int g = 0; g < groups.size(); g++) {
+      const Group& group{groups[g]};
+
+      // skip row groups outside of the time range
+      if (group.endTime < startTime || group.startTime > endTime) continue;
+
+      // row group header
+      buff.resize(hdrSize);
+      sin->clear();
+      sin->seekg(static_cast<std::streamoff>(group.offset));
+      sin->read(&buff[0], hdrSize);
+      if (sin->fail() || getU32(buff.data()) != COLUMN_GROUP_MARKER || getU32(buff.data() + 24) != nc) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "ColumnReader::select(): invalid row group header" << std::endl;
+         }
+         return numSelected;
+      }
+      const unsigned int numRows{getU32(buff.data() + 4)};
+      std::streamoff pos{static_cast<std::streamoff>(group.offset + hdrSize)};
+      for (std::size_t c = 0; c < nc; c++) {
+         sizes[c] = getU32(buff.data() + 28 + 4 * c);
+         offsets[c] = pos;
+         pos += sizes[c];
+      }
+
+      // the time column (always the first) selects the rows
+      rows.clear();
+      if (group.startTime >= startTime && group.endTime <= endTime) {
+         for (unsigned int r = 0; r < numRows; r++) rows.push_back(r);
+      }
+      else {
+         buff.resize(sizes[0]);
+         sin->seekg(offsets[0]);
+         sin->read(&buff[0], sizes[0]);
+         for (unsigned int r = 0; r < numRows && (r + 1) * 8 <= sizes[0]; r++) {
+            const double t{getF64(buff.data() + r * 8)};
+            if (t >= startTime && t <= endTime) rows.push_back(r);
+         }
+      }
+      if (rows.empty()) continue;
+
+      // read only the selected columns
+      for (unsigned int i = 0; i < n; i++) {
+         const unsigned int c{columns[i]};
+         buff.resize(sizes[c]);
+         sin->seekg(offsets[c]);
+         sin->read(&buff[0], sizes[c]);
+         Column& col{(*result)[i]};
+         if (col.type == ColumnType::F64) {
+            for (unsigned int r : rows) {
+               col.f64.push_back(((r + 1) * 8 <= sizes[c]) ? getF64(buff.data() + r * 8) : 0);
+            }
+         }
+         else {
+            for (unsigned int r : rows) {
+               col.u32.push_back(((r + 1) * 4 <= sizes[c]) ? getU32(buff.data() + r * 4) : COLUMN_NO_ENTRY);
+            }
+         }
+      }
+      numSelected += static_cast<unsigned int>(rows.size());
+   }
+
+   return numSelected;
+}
+
+}
+}
@@ -0,0 +1,528 @@
+
+#include "mixr/recorder/ColumnWriter.hpp"
+#include "mixr/recorder/protobuf/DataRecord.pb.h"
+#include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/block_utils.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/String.hpp"
+
+#include <fstream>
+#include <limits>
+
+namespace mixr {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(ColumnWriter, "RecorderColumnWriter")
+
+BEGIN_SLOTTABLE(ColumnWriter)
+    "filename",         // 1) Table file name prefix (required)
+    "pathname",         // 2) Path to the table files' directory (optional)
+    "rowGroupTime",     // 3) Sim time span of each row group (seconds)
+    "maxGroupRows",     // 4) Max number of rows in a row group
+END_SLOTTABLE(ColumnWriter)
+
+BEGIN_SLOT_MAP(ColumnWriter)
+    ON_SLOT( 1, setSlotFilename,     base::String)
+    ON_SLOT( 2, setSlotPathName,     base::String)
+    ON_SLOT( 3, setSlotRowGroupTime, base::Number)
+    ON_SLOT( 4, setSlotMaxGroupRows, base::Integer)
+END_SLOT_MAP()
+
+namespace {
+
+const double NO_VALUE{std::numeric_limits<double>::quiet_NaN()};
+
+// Column data encoders
+void addF64(std::string& col, const double v)
+{
+   char buff[8];
+   putF64(buff, v);
+   col.append(buff, 8);
+}
+
+void addU32(std::string& col, const std::uint32_t v)
+{
+   char buff[4];
+   putU32(buff, v);
+   col.append(buff, 4);
+}
+
+void addStr(std::string& s, const std::string& v)
+{
+   addU32(s, static_cast<std::uint32_t>(v.length()));
+   s.append(v);
+}
+
+}
+
+ColumnWriter::ColumnWriter()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void ColumnWriter::copyData(const ColumnWriter& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   filename = org.filename;
+   pathname = org.pathname;
+   rowGroupTime = org.rowGroupTime;
+   maxGroupRows = org.maxGroupRows;
+
+   // Need to re-open the files
+   closeFiles();
+   filesFailed = false;
+   eodFlag = false;
+}
+
+void ColumnWriter::deleteData()
+{
+   closeFiles();
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool ColumnWriter::shutdownNotification()
+{
+   closeFiles();
+   return BaseClass::shutdownNotification();
+}
+
+bool ColumnWriter::isOpen() const
+{
+   return filesOpened;
+}
+
+//------------------------------------------------------------------------------
+// Open the table files
+//------------------------------------------------------------------------------
+bool ColumnWriter::openFiles()
+{
+   if (isOpen()) return true;
+
+   if (filename.empty()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnWriter::openFiles(): Unable to open table files: no file name" << std::endl;
+      }
+      filesFailed = true;
+      return false;
+   }
+
+   std::string prefix;
+   if (!pathname.empty()) prefix = pathname + "/";
+   prefix += filename;
+
+   bool ok{true};
+   for (unsigned int i = 0; i < NUM_COLUMN_TABLES; i++) {
+      const auto type = static_cast<ColumnTable>(i + 1);
+      Table& table{tables[i]};
+
+      unsigned int n{};
+      const ColumnDef* defs{getColumnDefs(type, &n)};
+      table.columns.assign(defs, defs + n);
+      table.data.assign(n, std::string());
+      table.numRows = 0;
+      table.groups.clear();
+
+      const std::string fullname{prefix + "_" + getColumnTableName(type) + ".col"};
+      if (table.sout == nullptr) table.sout = new std::ofstream();
+      table.sout->open(fullname.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+      if (table.sout->fail()) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "ColumnWriter::openFiles(): Failed to open table file: " << fullname << std::endl;
+         }
+         ok = false;
+      }
+      else if (isMessageEnabled(MSG_INFO)) {
+         std::cout << "ColumnWriter::openFiles() Opening table file = " << fullname << std::endl;
+      }
+   }
+
+   // new dictionaries
+   playerMap.clear();
+   playerIds.clear();
+   playerNames.clear();
+   trackMap.clear();
+   trackIds.clear();
+
+   filesOpened = ok;
+   filesFailed = !ok;
+   eodFlag = false;
+   if (!ok) closeFiles();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Close the table files; writes the remaining rows and the footers
+//------------------------------------------------------------------------------
+void ColumnWriter::closeFiles()
+{
+   for (unsigned int i = 0; i < NUM_COLUMN_TABLES; i++) {
+      Table& table{tables[i]};
+      if (table.sout != nullptr) {
+         if (filesOpened && table.sout->is_open()) {
+            writeGroup(table);
+            writeFooter(table);
+         }
+         if (table.sout->is_open()) table.sout->close();
+         delete table.sout;
+         table.sout = nullptr;
+      }
+      table.data.clear();
+      table.groups.clear();
+      table.numRows = 0;
+   }
+   filesOpened = false;
+}
+
+//------------------------------------------------------------------------------
+// Dictionary encoding of the player and track IDs
+//------------------------------------------------------------------------------
+std::uint32_t ColumnWriter::playerIndex(const pb::PlayerId& id)
+{
+   const std::pair<std::uint32_t, std::string> key(id.id(), id.fed_name());
+   const auto it = playerMap.find(key);
+   if (it != playerMap.end()) return it->second;
+
+   const auto idx = static_cast<std::uint32_t>(playerIds.size());
+   playerMap[key] = idx;
+   playerIds.push_back(key);
+   playerNames.push_back(id.name());
+   return idx;
+}
+
+std::uint32_t ColumnWriter::trackIndex(const std::uint32_t player, const std::string& trackId)
+{
+   const std::pair<std::uint32_t, std::string> key(player, trackId);
+   const auto it = trackMap.find(key);
+   if (it != trackMap.end()) return it->second;
+
+   const auto idx = static_cast<std::uint32_t>(trackIds.size());
+   trackMap[key] = idx;
+   trackIds.push_back(key);
+   return idx;
+}
+
+//------------------------------------------------------------------------------
+// Start a new row; the row group is written when it's full or when this row's
+// time is outside of the group's time span.
+//------------------------------------------------------------------------------
+void ColumnWriter::beginRow(Table& table, const double time)
+{
+   if (table.numRows > 0) {
+      const double t0{(time < table.startTime) ? time : table.startTime};
+      const double t1{(time > table.endTime) ? time : table.endTime};
+      if ((t1 - t0) >= rowGroupTime) writeGroup(table);
+   }
+
+   if (table.numRows == 0) {
+      table.startTime = time;
+      table.endTime = time;
+   }
+   else {
+      if (time < table.startTime) table.startTime = time;
+      if (time > table.endTime) table.endTime = time;
+   }
+
+   addF64(table.data[0], time);
+}
+
+void ColumnWriter::endRow(Table& table)
+{
+   table.numRows++;
+   if (table.numRows >= maxGroupRows) writeGroup(table);
+}
+
+//------------------------------------------------------------------------------
+// Write the current row group
+//------------------------------------------------------------------------------
+void ColumnWriter::writeGroup(Table& table)
+{
+   if (table.numRows == 0 || table.sout == nullptr) return;
+
+   Table::GroupIndex index;
+   index.offset = static_cast<std::uint64_t>(table.sout->tellp());
+   index.rows = table.numRows;
+   index.startTime = table.startTime;
+   index.endTime = table.endTime;
+   table.groups.push_back(index);
+
+   std::string hdr;
+   addU32(hdr, COLUMN_GROUP_MARKER);
+   addU32(hdr, table.numRows);
+   addF64(hdr, table.startTime);
+   addF64(hdr, table.endTime);
+   addU32(hdr, static_cast<std::uint32_t>(table.data.size()));
+   for (unsigned int i = 0; i < table.data.size(); i++) {
+      addU32(hdr, static_cast<std::uint32_t>(table.data[i].length()));
+   }
+   table.sout->write(hdr.data(), hdr.length());
+
+   for (unsigned int i = 0; i < table.data.size(); i++) {
+      table.sout->write(table.data[i].data(), table.data[i].length());
+      table.data[i].clear();
+   }
+   table.numRows = 0;
+}
+
+//------------------------------------------------------------------------------
+// Write the table's footer and trailer
+//------------------------------------------------------------------------------
+void ColumnWriter::writeFooter(Table& table)
+{
+   std::string footer;
+
+   // table and column definitions
+   unsigned int tableType{};
+   for (unsigned int i = 0; i < NUM_COLUMN_TABLES; i++) {
+      if (&tables[i] == &table) tableType = i + 1;
+   }
+   addU32(footer, tableType);
+   addU32(footer, static_cast<std::uint32_t>(table.columns.size()));
+   for (unsigned int i = 0; i < table.columns.size(); i++) {
+      addU32(footer, static_cast<std::uint32_t>(table.columns[i].type));
+      addStr(footer, table.columns[i].name);
+   }
+
+   // dictionaries
+   addU32(footer, static_cast<std::uint32_t>(playerIds.size()));
+   for (unsigned int i = 0; i < playerIds.size(); i++) {
+      addU32(footer, playerIds[i].first);
+      addStr(footer, playerIds[i].second);
+      addStr(footer, playerNames[i]);
+   }
+   addU32(footer, static_cast<std::uint32_t>(trackIds.size()));
+   for (unsigned int i = 0; i < trackIds.size(); i++) {
+      addU32(footer, trackIds[i].first);
+      addStr(footer, trackIds[i].second);
+   }
+
+   // row group index
+   addU32(footer, static_cast<std::uint32_t>(table.groups.size()));
+   for (unsigned int i = 0; i < table.groups.size(); i++) {
+      addU32(footer, static_cast<std::uint32_t>(table.groups[i].offset & 0xffffffff));
+      addU32(footer, static_cast<std::uint32_t>(table.groups[i].offset >> 32));
+      addU32(footer, table.groups[i].rows);
+      addF64(footer, table.groups[i].startTime);
+      addF64(footer, table.groups[i].endTime);
+   }
+
+   // trailer
+   addU32(footer, static_cast<std::uint32_t>(footer.length()));
+   footer.append(COLUMN_FILE_MAGIC, COLUMN_FILE_MAGIC_SIZE);
+
+   table.sout->write(footer.data(), footer.length());
+}
+
+//------------------------------------------------------------------------------
+// Add an emission data row
+//------------------------------------------------------------------------------
+void ColumnWriter::addEmission(const double time, const std::uint32_t player, const std::uint32_t track, const pb::EmissionData& em)
+{
+   Table& t{tables[static_cast<unsigned int>(ColumnTable::EMISSION) - 1]};
+   beginRow(t, time);
+   addU32(t.data[1], player);
+   addU32(t.data[2], track);
+   addU32(t.data[3], em.has_origin_id() ? playerIndex(em.origin_id()) : COLUMN_NO_ENTRY);
+   addU32(t.data[4], em.has_target_id() ? playerIndex(em.target_id()) : COLUMN_NO_ENTRY);
+   addF64(t.data[5], em.frequency());
+   addF64(t.data[6], em.wave_length());
+   addF64(t.data[7], em.pulse_width());
+   addF64(t.data[8], em.bandwidth());
+   addF64(t.data[9], em.prf());
+   addF64(t.data[10], em.power());
+   addU32(t.data[11], static_cast<std::uint32_t>(em.polarization()));
+   addF64(t.data[12], em.azimuth_aoi());
+   addF64(t.data[13], em.elevation_aoi());
+   endRow(t);
+}
+
+//------------------------------------------------------------------------------
+// Add the data record to its table
+//------------------------------------------------------------------------------
+void ColumnWriter::processRecordImp(const DataRecordHandle* const handle)
+{
+   if (handle == nullptr) return;
+
+   const pb::DataRecord* dataRecord{handle->getRecord()};
+   const unsigned int id{dataRecord->id()};
+
+   if (id == REID_END_OF_DATA) {
+      closeFiles();
+      eodFlag = true;
+      return;
+   }
+
+   // Open the files, if they haven't been already ...
+   if (!filesOpened && !filesFailed && !eodFlag) openFiles();
+   if (!filesOpened) return;
+
+   const double time{dataRecord->time().sim_time()};
+
+   switch (id) {
+
+      case REID_PLAYER_DATA: {
+         const pb::PlayerDataMsg& msg{dataRecord->player_data_msg()};
+         const pb::PlayerState& state{msg.state()};
+         Table& t{tables[static_cast<unsigned int>(ColumnTable::PLAYER_DATA) - 1]};
+         beginRow(t, time);
+         addU32(t.data[1], playerIndex(msg.id()));
+         addF64(t.data[2], state.pos().x());
+         addF64(t.data[3], state.pos().y());
+         addF64(t.data[4], state.pos().z());
+         addF64(t.data[5], state.angles().x());
+         addF64(t.data[6], state.angles().y());
+         addF64(t.data[7], state.angles().z());
+         addF64(t.data[8], state.has_vel() ? state.vel().x() : NO_VALUE);
+         addF64(t.data[9], state.has_vel() ? state.vel().y() : NO_VALUE);
+         addF64(t.data[10], state.has_vel() ? state.vel().z() : NO_VALUE);
+         addF64(t.data[11], state.has_damage() ? state.damage() : NO_VALUE);
+         addF64(t.data[12], msg.has_alpha() ? msg.alpha() : NO_VALUE);
+         addF64(t.data[13], msg.has_beta() ? msg.beta() : NO_VALUE);
+         addF64(t.data[14], msg.has_cas() ? msg.cas() : NO_VALUE);
+         endRow(t);
+         break;
+      }
+
+      case REID_NEW_TRACK:
+      case REID_TRACK_DATA:
+      case REID_TRACK_REMOVED: {
+         // common track fields
+         const pb::PlayerId* playerId{};
+         const std::string* trackId{};
+         const pb::TrackData* trk{};
+         const pb::PlayerId* trkPlayerId{};
+         const pb::EmissionData* em{};
+         if (id == REID_NEW_TRACK) {
+            const pb::NewTrackEventMsg& msg{dataRecord->new_track_event_msg()};
+            playerId = &msg.player_id();
+            trackId = &msg.track_id();
+            if (msg.has_track_data()) trk = &msg.track_data();
+            if (msg.has_trk_player_id()) trkPlayerId = &msg.trk_player_id();
+            if (msg.has_emission_data()) em = &msg.emission_data();
+         }
+         else if (id == REID_TRACK_DATA) {
+            const pb::TrackDataMsg& msg{dataRecord->track_data_msg()};
+            playerId = &msg.player_id();
+            trackId = &msg.track_id();
+            if (msg.has_track_data()) trk = &msg.track_data();
+            if (msg.has_trk_player_id()) trkPlayerId = &msg.trk_player_id();
+            if (msg.has_emission_data()) em = &msg.emission_data();
+         }
+         else {
+            const pb::TrackRemovedEventMsg& msg{dataRecord->track_removed_event_msg()};
+            playerId = &msg.player_id();
+            trackId = &msg.track_id();
+         }
+
+         const std::uint32_t player{playerIndex(*playerId)};
+         const std::uint32_t track{trackIndex(player, *trackId)};
+
+         Table& t{tables[static_cast<unsigned int>(ColumnTable::TRACK) - 1]};
+         beginRow(t, time);
+         addU32(t.data[1], id);
+         addU32(t.data[2], player);
+         addU32(t.data[3], track);
+         addU32(t.data[4], (trkPlayerId != nullptr) ? playerIndex(*trkPlayerId) : COLUMN_NO_ENTRY);
+         addU32(t.data[5], (trk != nullptr) ? trk->type() : 0);
+         addF64(t.data[6], (trk != nullptr) ? trk->quality() : NO_VALUE);
+         addF64(t.data[7], (trk != nullptr) ? trk->true_az() : NO_VALUE);
+         addF64(t.data[8], (trk != nullptr) ? trk->rel_az() : NO_VALUE);
+         addF64(t.data[9], (trk != nullptr) ? trk->elevation() : NO_VALUE);
+         addF64(t.data[10], (trk != nullptr) ? trk->range() : NO_VALUE);
+         addF64(t.data[11], (trk != nullptr) ? trk->latitude() : NO_VALUE);
+         addF64(t.data[12], (trk != nullptr) ? trk->longitude() : NO_VALUE);
+         addF64(t.data[13], (trk != nullptr && trk->has_altitude()) ? trk->altitude() : NO_VALUE);
+         addF64(t.data[14], (trk != nullptr && trk->has_avg_signal()) ? trk->avg_signal() : NO_VALUE);
+         endRow(t);
+
+         if (em != nullptr) addEmission(time, player, track, *em);
+         break;
+      }
+
+      case REID_WEAPON_DETONATION: {
+         const pb::WeaponDetonationEventMsg& msg{dataRecord->weapon_detonation_event_msg()};
+         Table& t{tables[static_cast<unsigned int>(ColumnTable::DETONATION) - 1]};
+         beginRow(t, time);
+         addU32(t.data[1], playerIndex(msg.wpn_id()));
+         addU32(t.data[2], msg.has_shooter_id() ? playerIndex(msg.shooter_id()) : COLUMN_NO_ENTRY);
+         addU32(t.data[3], msg.has_tgt_id() ? playerIndex(msg.tgt_id()) : COLUMN_NO_ENTRY);
+         addU32(t.data[4], static_cast<std::uint32_t>(msg.det_type()));
+         addF64(t.data[5], msg.has_miss_dist() ? msg.miss_dist() : NO_VALUE);
+         addF64(t.data[6], msg.has_wpn_state() ? msg.wpn_state().pos().x() : NO_VALUE);
+         addF64(t.data[7], msg.has_wpn_state() ? msg.wpn_state().pos().y() : NO_VALUE);
+         addF64(t.data[8], msg.has_wpn_state() ? msg.wpn_state().pos().z() : NO_VALUE);
+         endRow(t);
+         break;
+      }
+
+      default: {
+         break;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool ColumnWriter::setFilename(const base::String* const msg)
+{
+   filename.clear();
+   if (msg != nullptr) filename = msg->c_str();
+   return true;
+}
+
+bool ColumnWriter::setPathName(const base::String* const msg)
+{
+   pathname.clear();
+   if (msg != nullptr) pathname = msg->c_str();
+   return true;
+}
+
+bool ColumnWriter::setRowGroupTime(const double dt)
+{
+   bool ok{dt > 0};
+   if (ok) rowGroupTime = dt;
+   return ok;
+}
+
+bool ColumnWriter::setMaxGroupRows(const unsigned int n)
+{
+   bool ok{n > 0};
+   if (ok) maxGroupRows = n;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool ColumnWriter::setSlotRowGroupTime(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setRowGroupTime(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnWriter::setSlotRowGroupTime(): row group time must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool ColumnWriter::setSlotMaxGroupRows(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n > 0) ok = setMaxGroupRows(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnWriter::setSlotMaxGroupRows(): max rows must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -16,6 +16,8 @@
 #include "mixr/simulation/Simulation.hpp"
 
 #include "mixr/base/Identifier.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/util/math_utils.hpp"
 
@@ -65,6 +67,7 @@ BEGIN_RECORDER_HANDLER_TABLE(DataRecorder)
    ON_RECORDER_EVENT_ID( REID_PLAYER_COLLISION,  recordPlayerCollision )
    ON_RECORDER_EVENT_ID( REID_PLAYER_CRASH,      recordPlayerCrash )
    ON_RECORDER_EVENT_ID( REID_PLAYER_KILLED,     recordPlayerKilled )
+   ON_RECORDER_EVENT_ID( REID_PLAYER_FRAME,      recordPlayerFrame )
    ON_RECORDER_EVENT_ID( REID_WEAPON_RELEASED,   recordWeaponReleased)
    ON_RECORDER_EVENT_ID( REID_WEAPON_HUNG,       recordWeaponHung)
    ON_RECORDER_EVENT_ID( REID_WEAPON_DETONATION, recordWeaponDetonation)
@@ -77,6 +80,7 @@ END_RECORDER_HANDLER_TABLE()
 DataRecorder::DataRecorder()
 {
    STANDARD_CONSTRUCTOR()
+   updateConsumedIds();
 }
 
 void DataRecorder::copyData(const DataRecorder& org, const bool)
@@ -118,6 +122,8 @@ void DataRecorder::processRecords()
 //------------------------------------------------------------------------------
 bool DataRecorder::processUnhandledId(const unsigned int id)
 {
+   if (!getConsumedIds()[REID_UNHANDLED_ID_TOKEN]) return false;
+
    const auto msg = new pb::DataRecord();
 
    // Record the unknown ID
@@ -142,10 +148,27 @@ void DataRecorder::reset()
 {
    BaseClass::reset();
 
-   const auto msg = new pb::DataRecord();
-   timeStamp(msg);
-   msg->set_id( REID_RESET_EVENT );
-   sendDataRecord(msg);
+   // The output handlers' filters are set by now
+   updateConsumedIds();
+
+   if (getConsumedIds()[REID_RESET_EVENT]) {
+      const auto msg = new pb::DataRecord();
+      timeStamp(msg);
+      msg->set_id( REID_RESET_EVENT );
+      sendDataRecord(msg);
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Update the set of IDs consumed by our output handlers
+//------------------------------------------------------------------------------
+void DataRecorder::updateConsumedIds()
+{
+   RecorderIdSet ids;
+   if (outputHandler != nullptr) outputHandler->getAcceptedIds(&ids);
+   ids.set(REID_END_OF_DATA);
+   setConsumedIds(ids);
 }
 
 
@@ -270,6 +293,7 @@ bool DataRecorder::recordNewPlayer(const base::Object* objs[4], const double val
    pb::NewPlayerEventMsg* newPlayerMsg {msg->mutable_new_player_event_msg()};
 
    genPlayerId( newPlayerMsg->mutable_id(), player );
+   genPlayerType( newPlayerMsg->mutable_id(), player );
    genPlayerState( newPlayerMsg->mutable_state(), player );
 
    // Send the message for processing
@@ -339,6 +363,98 @@ bool DataRecorder::recordPlayerData(const base::Object* objs[4], const double va
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Player frame snapshot handler
+//    objs[0] => the player list
+//
+// Samples the players that are in play (i.e., not inactive, pre-release or
+// waiting to be deleted) into one message of packed arrays.
+//------------------------------------------------------------------------------
+bool DataRecorder::recordPlayerFrame(const base::Object* objs[4], const double values[4])
+{
+   const auto playerList = dynamic_cast<const base::PairStream*>( objs[0] );
+   if (playerList == nullptr) return false;
+
+   const auto msg = new pb::DataRecord();
+
+   // DataRecord header
+   timeStamp(msg);
+   msg->set_id( REID_PLAYER_FRAME );
+
+   // player frame message
+   pb::PlayerFrameMsg* frameMsg {msg->mutable_player_frame_msg()};
+
+   const int n {static_cast<int>(playerList->entries())};
+   frameMsg->mutable_id()->Reserve(n);
+   frameMsg->mutable_mode()->Reserve(n);
+   frameMsg->mutable_pos()->Reserve(3 * n);
+   frameMsg->mutable_vel()->Reserve(3 * n);
+   frameMsg->mutable_angles()->Reserve(3 * n);
+
+   int numPlayers {};
+   bool networked {};
+   const base::List::Item* item {playerList->getFirstItem()};
+   while (item != nullptr) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      const auto player = dynamic_cast<const models::Player*>(pair->object());
+      if (player != nullptr) {
+         const simulation::AbstractPlayer::Mode mode {player->getMode()};
+         if (mode != simulation::AbstractPlayer::Mode::INACTIVE &&
+             mode != simulation::AbstractPlayer::Mode::PRE_RELEASE &&
+             mode != simulation::AbstractPlayer::Mode::DELETE_REQUEST) {
+
+            frameMsg->add_id( player->getID() );
+            frameMsg->add_mode( static_cast<unsigned int>(mode) );
+
+            const base::Vec3d& pos {player->getGeocPosition()};
+            frameMsg->add_pos(pos[0]);
+            frameMsg->add_pos(pos[1]);
+            frameMsg->add_pos(pos[2]);
+
+            const base::Vec3d& vel {player->getGeocVelocity()};
+            frameMsg->add_vel(vel[0]);
+            frameMsg->add_vel(vel[1]);
+            frameMsg->add_vel(vel[2]);
+
+            const base::Vec3d& angles {player->getGeocEulerAngles()};
+            frameMsg->add_angles(angles[0]);
+            frameMsg->add_angles(angles[1]);
+            frameMsg->add_angles(angles[2]);
+
+            // Networked player's federate index (the list is sorted
+            // with the local players first)
+            unsigned int fed {};
+            if (player->isProxyPlayer() && player->getNib() != nullptr) {
+               const std::string& fedName {player->getNib()->getFederateName()};
+               const int nf {frameMsg->federates_size()};
+               for (int i = 0; i < nf && fed == 0; i++) {
+                  if (frameMsg->federates(i) == fedName) fed = static_cast<unsigned int>(i + 1);
+               }
+               if (fed == 0) {
+                  frameMsg->add_federates(fedName);
+                  fed = static_cast<unsigned int>(nf + 1);
+               }
+            }
+            if (fed != 0 && !networked) {
+               // first networked player: the local players before it have no federate
+               frameMsg->mutable_federate()->Reserve(n);
+               for (int i = 0; i < numPlayers; i++) frameMsg->add_federate(0);
+               networked = true;
+            }
+            if (networked) frameMsg->add_federate(fed);
+
+            numPlayers++;
+         }
+      }
+      item = item->getNext();
+   }
+
+   // Send the message for processing
+   sendDataRecord(msg);
+
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Player damaged event handler
 //    objs[0] => the player damaged
@@ -477,6 +593,7 @@ bool DataRecorder::recordWeaponReleased(const base::Object* objs[4], const doubl
    pb::WeaponReleaseEventMsg* wpnRelMsg {msg->mutable_weapon_release_event_msg()};
 
    genPlayerId( wpnRelMsg->mutable_wpn_id(), wpn );
+   genPlayerType( wpnRelMsg->mutable_wpn_id(), wpn );
    genPlayerState( wpnRelMsg->mutable_wpn_state(), wpn );
 
    const auto shooter = dynamic_cast<const models::Player*>( objs[1] );
@@ -815,6 +932,19 @@ void DataRecorder::genPlayerId(pb::PlayerId* const id, const models::Player* con
    }
 }
 
+//------------------------------------------------------------------------------
+// Generate the player's type data (side, major type and type string); added
+// to the new player and weapon release records only
+//------------------------------------------------------------------------------
+void DataRecorder::genPlayerType(pb::PlayerId* const id, const models::Player* const player)
+{
+   if (id != nullptr && player != nullptr) {
+      id->set_side( static_cast<unsigned int>(player->getSide()) );
+      id->set_major_type( player->getMajorType() );
+      if (!player->getType().empty()) id->set_ac_type( player->getType() );
+   }
+}
+
 //------------------------------------------------------------------------------
 // Generate the player state data
 //------------------------------------------------------------------------------
@@ -1075,6 +1205,7 @@ bool DataRecorder::setOutputHandler(OutputHandler* const msg)
    if (outputHandler != nullptr) outputHandler->unref();
    outputHandler = msg;
    if (outputHandler != nullptr) outputHandler->ref();
+   updateConsumedIds();
    return true;
 }
 
@@ -2,12 +2,19 @@
 #include "mixr/recorder/FileReader.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/block_utils.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/util/str_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include "FileReaderThread.hpp"
+
 #include <fstream>
 #include <cstdlib>
+#include <vector>
 
 namespace mixr {
 namespace recorder {
@@ -17,13 +24,40 @@ IMPLEMENT_SUBCLASS(FileReader, "RecorderFileReader")
 BEGIN_SLOTTABLE(FileReader)
     "filename",         // 1) Data file name
     "pathname",         // 2) Path to the data file directory (optional)
+    "numWorkers",       // 3) Number of parse worker threads (optional)
+    "readAhead",        // 4) Number of batches read ahead (optional)
+    "resync",           // 5) Skip damaged blocks and resynchronize (optional)
 END_SLOTTABLE(FileReader)
 
 BEGIN_SLOT_MAP(FileReader)
-    ON_SLOT( 1, setSlotFilename, base::String)
-    ON_SLOT( 2, setSlotPathName, base::String)
+    ON_SLOT( 1, setSlotFilename,   base::String)
+    ON_SLOT( 2, setSlotPathName,   base::String)
+    ON_SLOT( 3, setSlotNumWorkers, base::Integer)
+    ON_SLOT( 4, setSlotReadAhead,  base::Integer)
+    ON_SLOT( 5, setSlotResync,     base::Boolean)
 END_SLOT_MAP()
 
+//------------------------------------------------------------------------------
+// Batch of serialized data records (playback pipeline)
+//
+// A batch is FREE until the read-ahead thread fills it (READ), then it's
+// claimed by a parse thread (PARSING) and its records are parsed (PARSED).
+// The caller returns the parsed records, in order, and then frees the batch.
+//------------------------------------------------------------------------------
+struct FileReader::Batch
+{
+   enum class State { FREE, READ, PARSING, PARSED };
+
+   State state {State::FREE};
+   bool compressed {};                 // 'data' is a compressed block
+   BlockHeader hdr;                    // Compressed block's header
+   std::string data;                   // Compressed block, or size prefixed serialized records
+   std::string raw;                    // Decompressed block
+   std::vector<const DataRecordHandle*> records;   // Parsed data records
+   std::size_t next {};                // Next record to return
+   bool failed {};                     // Read or parse error
+};
+
 FileReader::FileReader()
 {
    STANDARD_CONSTRUCTOR()
@@ -39,6 +73,11 @@ void FileReader::copyData(const FileReader& org, const bool cc)
 {
    BaseClass::copyData(org);
    if (cc) initData();
+   else stopPlayback();
+
+   numWorkers = org.numWorkers;
+   readAhead = org.readAhead;
+   resync = org.resync;
 
    // Need to re-open the file
    if (sin != nullptr) {
@@ -51,10 +90,17 @@ void FileReader::copyData(const FileReader& org, const bool cc)
    fileOpened = false;
    fileFailed = false;
    firstPassFlg = true;
+   blockFile = false;
+   blockData.clear();
+   blockPos = 0;
+   numDamaged = 0;
+   numSkippedBytes = 0;
 }
 
 void FileReader::deleteData()
 {
+   stopPlayback();
+
    if (sin != nullptr) {
       if (isOpen()) sin->close();
       delete sin;
@@ -77,7 +123,51 @@ bool FileReader::isOpen() const
 
 bool FileReader::isFailed() const
 {
-   return fileFailed || (sin != nullptr && sin->fail());
+   base::lock(semaphore);
+   const bool failed{fileFailed};
+   base::unlock(semaphore);
+   return failed || (sin != nullptr && sin->fail());
+}
+
+bool FileReader::isBlockFile() const
+{
+   return blockFile;
+}
+
+unsigned int FileReader::getNumWorkers() const
+{
+   return numWorkers;
+}
+
+unsigned int FileReader::getReadAhead() const
+{
+   return readAhead;
+}
+
+bool FileReader::isResyncEnabled() const
+{
+   return resync;
+}
+
+unsigned int FileReader::getNumDamagedBlocks() const
+{
+   return numDamaged;
+}
+
+std::uint64_t FileReader::getNumSkippedBytes() const
+{
+   return numSkippedBytes;
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool FileReader::shutdownNotification()
+{
+   // Stop the playback threads and close the file
+   closeFile();
+
+   return BaseClass::shutdownNotification();
 }
 
 //------------------------------------------------------------------------------
@@ -156,6 +246,22 @@ bool FileReader::openFile()
             tFailed = true;
          }
 
+         //---
+         // Check for the block compressed file header; otherwise
+         // rewind to the first record of the uncompressed file
+         //---
+         if (tOpened) {
+            char hbuff[BLOCK_FILE_HEADER_SIZE]{};
+            sin->read(hbuff, BLOCK_FILE_HEADER_SIZE);
+            blockFile = (sin->gcount() == BLOCK_FILE_HEADER_SIZE && isBlockFileHeader(hbuff));
+            blockData.clear();
+            blockPos = 0;
+            if (!blockFile) {
+               sin->clear();
+               sin->seekg(0);
+            }
+         }
+
       }
 
       delete[] fullname;
@@ -163,6 +269,15 @@ bool FileReader::openFile()
 
    fileOpened = tOpened;
    fileFailed = tFailed;
+
+   numRecords = 0;
+   numDamaged = 0;
+   numSkippedBytes = 0;
+   startTime = base::getComputerTime();
+
+   // Start the playback pipeline
+   if (fileOpened && numWorkers > 0) startPlayback();
+
    return fileOpened;
 }
 
@@ -172,19 +287,41 @@ bool FileReader::openFile()
 //------------------------------------------------------------------------------
 void FileReader::closeFile()
 {
+   stopPlayback();
+
    if (isOpen()) {
+      if (isMessageEnabled(MSG_INFO) && numRecords > 0) {
+         const double dt{base::getComputerTime() - startTime};
+         std::cout << "FileReader::closeFile(): " << numRecords << " records read in " << dt << " seconds";
+         if (dt > 0) std::cout << " (" << (numRecords / dt) << " records/sec)";
+         std::cout << " with " << numWorkers << " parse workers" << std::endl;
+      }
+      if (isMessageEnabled(MSG_WARNING) && numDamaged > 0) {
+         std::cerr << "FileReader::closeFile(): skipped " << numDamaged << " damaged regions (";
+         std::cerr << numSkippedBytes << " bytes)" << std::endl;
+      }
       sin->close();
       fileOpened = false;
       fileFailed = false;
    }
 }
 
+//------------------------------------------------------------------------------
+// Re-open the data file at its first record
+//------------------------------------------------------------------------------
+bool FileReader::rewind()
+{
+   closeFile();
+   firstPassFlg = false;
+   return openFile();
+}
+
 //------------------------------------------------------------------------------
 // Read a record
 //------------------------------------------------------------------------------
 const DataRecordHandle* FileReader::readRecordImp()
 {
-   DataRecordHandle* handle{};
+   const DataRecordHandle* handle{};
 
    // First pass?  Does the file need to be opened?
    if (firstPassFlg) {
@@ -194,9 +331,46 @@ const DataRecordHandle* FileReader::readRecordImp()
       firstPassFlg = false;
    }
 
+   // Playback pipeline: the records have been read and parsed by our threads
+   if ( playback ) {
+      handle = nextPlaybackRecord();
+   }
+
+   // Block compressed file: parse the next record from the current block,
+   // reading the next block when this one is empty.
+   else if ( blockFile ) {
+      bool done{};
+      while (!done && handle == nullptr) {
+         const char* rec{};
+         std::uint32_t n{};
+         if (nextRecord(blockData, &blockPos, &rec, &n)) {
+            const auto dataRecord = new pb::DataRecord();
+            if (dataRecord->ParseFromArray(rec, static_cast<int>(n))) {
+               handle = new DataRecordHandle(dataRecord);
+            }
+            else {
+               if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                  std::cerr << "FileReader::readRecord() -- ParseFromArray() error" << std::endl;
+               }
+               delete dataRecord;
+               // the rest of the block is damaged; same as an invalid block (see readBlock())
+               blockData.clear();
+               blockPos = 0;
+               if (resync) numDamaged++;
+               else {
+                  fileFailed = true;
+                  done = true;
+               }
+            }
+         }
+         else {
+            done = !readBlock();
+         }
+      }
+   }
 
    // When the file is open and ready ...
-   if ( isOpen() && !isFailed() && !sin->eof() ) {
+   else if ( isOpen() && !isFailed() && !sin->eof() ) {
 
       // Number of bytes in the next serialized DataRecord
       unsigned int n{};
@@ -252,11 +426,14 @@ const DataRecordHandle* FileReader::readRecordImp()
                handle = new DataRecordHandle(dataRecord);
             }
 
-            // parsing error
-            else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-               std::cerr << "FileReader::readRecord() -- ParseFromString() error" << std::endl;
+            // parsing error; legacy files can't be resynchronized
+            else {
+               if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                  std::cerr << "FileReader::readRecord() -- ParseFromString() error" << std::endl;
+               }
                delete dataRecord;
                dataRecord = nullptr;
+               fileFailed = true;
             }
          }
 
@@ -264,10 +441,428 @@ const DataRecordHandle* FileReader::readRecordImp()
 
    }
 
+   if (handle != nullptr) numRecords++;
+
    return handle;
 }
 
 
+//------------------------------------------------------------------------------
+// Read and decompress the next block; returns false at the end of the file
+// or on error.
+//------------------------------------------------------------------------------
+bool FileReader::readBlock()
+{
+   blockData.clear();
+   blockPos = 0;
+   if ( !isOpen() || isFailed() ) return false;
+
+   bool ok{};
+   bool done{};
+   while (!done) {
+      // Read and check the next block
+      BlockHeader hdr;
+      const BlockStatus status{readBlockData(&hdr, &blockBuff)};
+      if (status == BlockStatus::END_OF_FILE) return false;
+
+      // and decompress it
+      ok = (status == BlockStatus::VALID && decompressBlock(hdr, blockBuff.data(), &blockData));
+      if (!ok) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::readBlock() -- invalid block" << std::endl;
+         }
+         blockData.clear();
+         if (resync && status == BlockStatus::VALID) numDamaged++;
+         else fileFailed = true;
+      }
+      done = (ok || fileFailed);
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Read the next block's header and compressed payload; when resynchronizing,
+// the damaged regions of the file are skipped.
+//------------------------------------------------------------------------------
+BlockStatus FileReader::readBlockData(BlockHeader* const hdr, std::string* const data)
+{
+   std::uint64_t skipped{};
+   const BlockStatus status{readNextBlock(*sin, resync, hdr, data, &skipped)};
+   if (skipped > 0) {
+      base::lock(semaphore);
+      numDamaged++;
+      numSkippedBytes += skipped;
+      base::unlock(semaphore);
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "FileReader::readBlockData() -- skipped " << skipped << " bytes of damaged data" << std::endl;
+      }
+   }
+   if (status == BlockStatus::END_OF_FILE) sin->clear(std::ios_base::eofbit);
+   return status;
+}
+
+//------------------------------------------------------------------------------
+// Create the read-ahead and parse worker threads; returns false if the
+// read-ahead thread couldn't be created, in which case the records are read
+// and parsed by the caller.
+//------------------------------------------------------------------------------
+bool FileReader::startPlayback()
+{
+   if (playback) return true;
+
+   batches = new Batch[readAhead];
+   readIdx = 0;
+   nextIdx = 0;
+   readDone = false;
+   playbackStop = false;
+   numStarted = 0;
+
+   reader = new FileReaderThread(this);
+   reader->unref(); // 'reader' is a safe_ptr<>
+   if ( !reader->start(0) ) {
+      reader = nullptr;
+      delete[] batches;
+      batches = nullptr;
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileReader::startPlayback(): ERROR, failed to create the read-ahead thread; records will be read by the caller" << std::endl;
+      }
+      return false;
+   }
+
+   // Without parse threads, the caller parses the batches as they're needed
+   unsigned int numThreads{1};
+   for (unsigned int i = 0; i < numWorkers; i++) {
+      workers[i] = new FileParserThread(this);
+      workers[i]->unref(); // 'workers[i]' is a safe_ptr<>
+      if ( workers[i]->start(0) ) numThreads++;
+      else {
+         workers[i] = nullptr;
+         if (isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "FileReader::startPlayback(): failed to create parse thread " << (i + 1) << std::endl;
+         }
+      }
+   }
+
+   // Wait for the threads to start.  Each thread holds a reference to us
+   // while it runs (see base::AbstractThread), so once they've started, we
+   // can't be deleted until they've finished.
+   bool started{};
+   while (!started) {
+      base::lock(semaphore);
+      started = (numStarted == numThreads);
+      base::unlock(semaphore);
+      if (!started) base::msleep(1);
+   }
+
+   playback = true;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Stop the playback threads and wait for them to finish
+//------------------------------------------------------------------------------
+void FileReader::stopThreads()
+{
+   base::lock(semaphore);
+   playbackStop = true;
+   base::unlock(semaphore);
+
+   bool done{};
+   while (!done) {
+      done = (reader == nullptr || reader->isTerminated());
+      for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+         if (workers[i] != nullptr && !workers[i]->isTerminated()) done = false;
+      }
+      if (!done) base::msleep(1);
+   }
+   reader = nullptr;
+   for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+      workers[i] = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Stop the playback threads and release the records that weren't returned
+//------------------------------------------------------------------------------
+void FileReader::stopPlayback()
+{
+   if (!playback) return;
+
+   stopThreads();
+
+   for (unsigned int i = 0; i < readAhead; i++) {
+      Batch& b{batches[i]};
+      for (std::size_t j = b.next; j < b.records.size(); j++) {
+         b.records[j]->unref();
+      }
+   }
+   delete[] batches;
+   batches = nullptr;
+
+   playback = false;
+}
+
+//------------------------------------------------------------------------------
+// Returns the next record from the playback pipeline, in file order; waits
+// (helping to parse) while the next batch isn't ready.  Returns zero at the
+// end of the file.
+//------------------------------------------------------------------------------
+const DataRecordHandle* FileReader::nextPlaybackRecord()
+{
+   const DataRecordHandle* handle{};
+   bool finished{};
+
+   while (handle == nullptr && !finished) {
+      Batch* const b{&batches[nextIdx]};
+
+      base::lock(semaphore);
+      const Batch::State state{b->state};
+      const bool eof{readDone};
+      base::unlock(semaphore);
+
+      if (state == Batch::State::PARSED) {
+         if (b->next < b->records.size()) {
+            handle = b->records[b->next++];
+         }
+         else {
+            // Done with this batch; a read or parse error ends the playback,
+            // unless we're skipping the damaged blocks (as readRecordImp() does)
+            if (b->failed) {
+               if (resync && b->compressed) {
+                  base::lock(semaphore);
+                  numDamaged++;
+                  base::unlock(semaphore);
+               }
+               else {
+                  setFileFailed();
+                  finished = true;
+               }
+            }
+            b->records.clear();
+            b->next = 0;
+
+            base::lock(semaphore);
+            b->state = Batch::State::FREE;
+            nextIdx = (nextIdx + 1) % readAhead;
+            base::unlock(semaphore);
+         }
+      }
+
+      // The read-ahead thread is finished and there are no more batches
+      else if (state == Batch::State::FREE && (eof || reader == nullptr || reader->isTerminated())) {
+         finished = true;
+      }
+
+      // Help parse the batches while we wait
+      else if (parseBatches() == 0) {
+         base::msleep(1);
+      }
+   }
+
+   // End of the playback; stop the threads while our caller still holds a
+   // reference to us, so we're not deleted by the last thread to finish
+   if (finished && reader != nullptr) stopThreads();
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Read the next batches into the free slots of the ring (read-ahead thread);
+// returns the number of batches read.
+//------------------------------------------------------------------------------
+unsigned int FileReader::readBatches()
+{
+   unsigned int n{};
+   bool done{};
+
+   while (!done && !isPlaybackStop()) {
+      Batch* const b{&batches[readIdx]};
+
+      base::lock(semaphore);
+      const bool isFree{b->state == Batch::State::FREE};
+      base::unlock(semaphore);
+
+      if (isFree) {
+         const bool ok{readBatch(b)};
+
+         base::lock(semaphore);
+         if (ok) b->state = Batch::State::READ;
+         else readDone = true;
+         base::unlock(semaphore);
+
+         if (ok) {
+            readIdx = (readIdx + 1) % readAhead;
+            n++;
+         }
+         done = !ok;
+      }
+      else done = true;
+   }
+
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Read one batch: the next compressed block, or up to BATCH_SIZE uncompressed
+// records; returns false at the end of the file or on error.
+//------------------------------------------------------------------------------
+bool FileReader::readBatch(Batch* const b)
+{
+   b->data.clear();
+   b->raw.clear();
+   b->compressed = blockFile;
+   b->failed = false;
+   if ( !isOpen() || isFailed() ) return false;
+
+   bool ok{};
+   if (blockFile) {
+      // Compressed block; decompressed by the parse thread
+      const BlockStatus status{readBlockData(&b->hdr, &b->data)};
+      if (status == BlockStatus::END_OF_FILE) return false;
+
+      ok = (status == BlockStatus::VALID);
+      if (!ok) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::readBatch() -- invalid or incomplete block" << std::endl;
+         }
+         setFileFailed();
+      }
+   }
+   else {
+      // Uncompressed records; stored size prefixed (see nextRecord())
+      unsigned int cnt{};
+      bool done{};
+      while (!done && cnt < BATCH_SIZE) {
+         char nbuff[8]{};
+         sin->read(nbuff, 4);
+         if (sin->gcount() == 0 && sin->eof()) done = true;
+         else if (sin->gcount() != 4) {
+            if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "FileReader::readBatch() -- error reading data record size" << std::endl;
+            }
+            setFileFailed();
+            done = true;
+         }
+         else {
+            nbuff[4] = '\0';
+            const int n{std::atoi(nbuff)};
+            if (n > 0) {
+               const std::size_t pos{b->data.length()};
+               b->data.resize(pos + 4 + n);
+               putU32(&b->data[pos], static_cast<std::uint32_t>(n));
+               sin->read(&b->data[pos + 4], n);
+               if (sin->gcount() != n) {
+                  if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                     std::cerr << "FileReader::readBatch() -- error reading data record" << std::endl;
+                  }
+                  b->data.resize(pos);
+                  setFileFailed();
+                  done = true;
+               }
+               else cnt++;
+            }
+            else done = true;
+         }
+      }
+      ok = (cnt > 0);
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Claim and parse the oldest read batch (parse threads and the caller);
+// returns the number of batches parsed.
+//------------------------------------------------------------------------------
+unsigned int FileReader::parseBatches()
+{
+   Batch* b{};
+
+   base::lock(semaphore);
+   for (unsigned int i = 0; i < readAhead && b == nullptr; i++) {
+      Batch* const p{&batches[(nextIdx + i) % readAhead]};
+      if (p->state == Batch::State::READ) {
+         p->state = Batch::State::PARSING;
+         b = p;
+      }
+   }
+   base::unlock(semaphore);
+
+   if (b == nullptr) return 0;
+
+   parseBatch(b);
+
+   base::lock(semaphore);
+   b->state = Batch::State::PARSED;
+   base::unlock(semaphore);
+
+   return 1;
+}
+
+void FileReader::parseBatch(Batch* const b)
+{
+   const std::string* raw{&b->data};
+   if (b->compressed) {
+      raw = &b->raw;
+      if (!decompressBlock(b->hdr, b->data.data(), &b->raw)) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::parseBatch() -- error decompressing block" << std::endl;
+         }
+         b->raw.clear();
+         b->failed = true;
+      }
+   }
+
+   std::size_t pos{};
+   const char* rec{};
+   std::uint32_t n{};
+   while (!b->failed && nextRecord(*raw, &pos, &rec, &n)) {
+      const auto dataRecord = new pb::DataRecord();
+      if (dataRecord->ParseFromArray(rec, static_cast<int>(n))) {
+         b->records.push_back(new DataRecordHandle(dataRecord));
+      }
+      else {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::parseBatch() -- ParseFromArray() error" << std::endl;
+         }
+         delete dataRecord;
+         b->failed = true;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Playback flags shared with the threads
+//------------------------------------------------------------------------------
+void FileReader::threadStarted()
+{
+   base::lock(semaphore);
+   numStarted++;
+   base::unlock(semaphore);
+}
+
+bool FileReader::isReadDone() const
+{
+   base::lock(semaphore);
+   const bool f{readDone};
+   base::unlock(semaphore);
+   return f;
+}
+
+bool FileReader::isPlaybackStop() const
+{
+   base::lock(semaphore);
+   const bool f{playbackStop};
+   base::unlock(semaphore);
+   return f;
+}
+
+void FileReader::setFileFailed()
+{
+   base::lock(semaphore);
+   fileFailed = true;
+   base::unlock(semaphore);
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -295,5 +890,63 @@ bool FileReader::setPathName(const base::String* const msg)
    return true;
 }
 
+bool FileReader::setNumWorkers(const unsigned int n)
+{
+   bool ok{n <= MAX_WORKERS};
+   if (ok) numWorkers = n;
+   return ok;
+}
+
+bool FileReader::setReadAhead(const unsigned int n)
+{
+   bool ok{n > 0 && n <= MAX_READ_AHEAD};
+   if (ok) readAhead = n;
+   return ok;
+}
+
+bool FileReader::setResync(const bool f)
+{
+   resync = f;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool FileReader::setSlotNumWorkers(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n >= 0) ok = setNumWorkers(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileReader::setSlotNumWorkers(): invalid number of workers: " << n << "; use [ 0 .. " << MAX_WORKERS << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileReader::setSlotReadAhead(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n > 0) ok = setReadAhead(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileReader::setSlotReadAhead(): invalid read ahead: " << n << "; use [ 1 .. " << MAX_READ_AHEAD << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileReader::setSlotResync(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setResync(msg->asBool());
+   }
+   return ok;
+}
+
 }
 }
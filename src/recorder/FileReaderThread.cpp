@@ -0,0 +1,46 @@
+
+#include "FileReaderThread.hpp"
+
+#include "mixr/recorder/FileReader.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+namespace mixr {
+namespace recorder {
+
+FileReaderThread::FileReaderThread(base::Component* const parent): base::OneShotThread(parent)
+{
+}
+
+unsigned long FileReaderThread::userFunc()
+{
+   FileReader* reader{static_cast<FileReader*>(getParent())};
+   reader->threadStarted();
+   while ( !reader->isShutdown() && !reader->isPlaybackStop() && !reader->isReadDone() ) {
+      // read ahead until the ring is full; wait a bit for the caller to free a batch
+      if (reader->readBatches() == 0) base::msleep(1);
+   }
+   return 0;
+}
+
+FileParserThread::FileParserThread(base::Component* const parent): base::OneShotThread(parent)
+{
+}
+
+unsigned long FileParserThread::userFunc()
+{
+   FileReader* reader{static_cast<FileReader*>(getParent())};
+   reader->threadStarted();
+   bool done{};
+   while ( !done && !reader->isShutdown() && !reader->isPlaybackStop() ) {
+      // parse the read batches; we're done once the whole file has been read and parsed
+      const bool eof{reader->isReadDone()};
+      if (reader->parseBatches() == 0) {
+         if (eof) done = true;
+         else base::msleep(1);
+      }
+   }
+   return 0;
+}
+
+}
+}
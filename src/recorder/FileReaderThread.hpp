@@ -0,0 +1,31 @@
+
+#ifndef __mixr_recorder_FileReaderThread_HPP__
+#define __mixr_recorder_FileReaderThread_HPP__
+
+#include "mixr/base/threads/OneShotThread.hpp"
+
+namespace mixr {
+namespace recorder {
+
+// ---
+// Playback read-ahead thread
+// ---
+class FileReaderThread final : public base::OneShotThread
+{
+   public: FileReaderThread(base::Component* const parent);
+   private: unsigned long userFunc() final;
+};
+
+// ---
+// Playback parse worker thread
+// ---
+class FileParserThread final : public base::OneShotThread
+{
+   public: FileParserThread(base::Component* const parent);
+   private: unsigned long userFunc() final;
+};
+
+}
+}
+
+#endif
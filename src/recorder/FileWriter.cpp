@@ -2,10 +2,15 @@
 #include "mixr/recorder/FileWriter.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/block_utils.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include "FileWriterThread.hpp"
+
 #include <fstream>
 #include <cstring>
 
@@ -17,11 +22,17 @@ IMPLEMENT_SUBCLASS(FileWriter, "RecorderFileWriter")
 BEGIN_SLOTTABLE(FileWriter)
     "filename",         // 1) Data file name (required)
     "pathname",         // 2) Path to the data file directory (optional)
+    "blockSize",        // 3) Number of data records per compressed block (optional)
+    "compressionLevel", // 4) zlib compression level (optional)
+    "maxBlockTime",     // 5) Max sim time span of a block (optional)
 END_SLOTTABLE(FileWriter)
 
 BEGIN_SLOT_MAP(FileWriter)
-    ON_SLOT( 1, setSlotFilename, base::String)
-    ON_SLOT( 2, setSlotPathName, base::String)
+    ON_SLOT( 1, setSlotFilename,         base::String)
+    ON_SLOT( 2, setSlotPathName,         base::String)
+    ON_SLOT( 3, setSlotBlockSize,        base::Integer)
+    ON_SLOT( 4, setSlotCompressionLevel, base::Integer)
+    ON_SLOT( 5, setSlotMaxBlockTime,     base::Number)
 END_SLOT_MAP()
 
 FileWriter::FileWriter()
@@ -35,6 +46,9 @@ void FileWriter::copyData(const FileWriter& org, const bool)
 
    setFilename(org.filename);
    setPathName(org.pathname);
+   blockSize = org.blockSize;
+   compressionLevel = org.compressionLevel;
+   maxBlockTime = org.maxBlockTime;
 
    // Need to re-open the file
    if (sout != nullptr) {
@@ -46,10 +60,23 @@ void FileWriter::copyData(const FileWriter& org, const bool)
    fileFailed = false;
    eodFlag    = false;
    setFullFilename(nullptr);
+
+   // and a new block queue and writer thread
+   if (block != nullptr) { delete block; block = nullptr; }
+   blockQueue.clear();
+   thread = nullptr;
+   numPending = 0;
 }
 
 void FileWriter::deleteData()
 {
+   // Our writer thread has terminated, so write any remaining blocks ourself
+   if (isOpen()) {
+      queueBlock();
+      writeQueuedBlocks();
+   }
+   thread = nullptr;
+
    if (sout != nullptr) {
       if (isOpen()) sout->close();
       delete sout;
@@ -95,6 +122,24 @@ const char* FileWriter::getFullFilename() const
    return fullFilename;
 }
 
+// Records per compressed block (zero for the uncompressed format)
+unsigned int FileWriter::getBlockSize() const
+{
+   return blockSize;
+}
+
+// zlib compression level
+int FileWriter::getCompressionLevel() const
+{
+   return compressionLevel;
+}
+
+// Max sim time span of a block (seconds; zero for no limit)
+double FileWriter::getMaxBlockTime() const
+{
+   return maxBlockTime;
+}
+
 // File name as entered
 const char* FileWriter::getFilename() const
 {
@@ -223,6 +268,20 @@ bool FileWriter::openFile()
       delete[] fullname;
    }
 
+   //---
+   // Block compressed format: write the file header and make sure
+   // we have a thread to compress and write the blocks
+   //---
+   if (tOpened && blockSize > 0) {
+      sout->write(BLOCK_FILE_MAGIC, BLOCK_FILE_HEADER_SIZE);
+      if (thread == nullptr) createWriterThread();
+   }
+
+   numRecords = 0;
+   numRawBytes = 0;
+   numFileBytes = 0;
+   writeTime = 0;
+
    fileOpened = tOpened;
    fileFailed = tFailed;
    return fileOpened;
@@ -263,6 +322,18 @@ void FileWriter::closeFile()
          handle = nullptr;
       }
 
+      // Write the last block, and wait for the writer thread to finish
+      queueBlock();
+      waitForQueuedBlocks();
+
+      if (isMessageEnabled(MSG_INFO) && numRecords > 0) {
+         std::cout << "FileWriter::closeFile(): " << numRecords << " records, ";
+         std::cout << (numFileBytes / numRecords) << " bytes/record (";
+         std::cout << (numRawBytes / numRecords) << " serialized)";
+         if (writeTime > 0) std::cout << ", " << (numRawBytes / writeTime / 1.0e6) << " MB/s";
+         std::cout << std::endl;
+      }
+
       // now close the file
       sout->close();
       fileOpened = false;
@@ -289,6 +360,7 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
    // --- serialize and write the data record.
    // ---
    if ( fileOpened ) {
+      const double startTime{base::getComputerTime()};
 
       // The DataRecord to be sent
       const pb::DataRecord* dataRecord{handle->getRecord()};
@@ -297,8 +369,28 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       std::string wireFormat;
 	   bool ok{dataRecord->SerializeToString(&wireFormat)};
 
+      // Add the serialized DataRecord to the current block; the full
+      // block is compressed and written by the writer thread
+      if (ok && blockSize > 0) {
+         if (block == nullptr) block = new RecordBlock();
+         appendRecord(block, wireFormat, dataRecord->time().sim_time());
+         if (block->numRecords >= blockSize || block->raw.length() >= MAX_BLOCK_BYTES ||
+             (maxBlockTime > 0 && (block->endTime - block->startTime) >= maxBlockTime)) {
+            queueBlock();
+         }
+      }
+
+      // Legacy files store the record size as four ascii digits
+      else if (ok && wireFormat.length() > MAX_LEGACY_RECORD_SIZE) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "FileWriter::processRecordImp(): record ID " << dataRecord->id();
+            std::cerr << " is too large (" << wireFormat.length() << " bytes) for an unblocked file;";
+            std::cerr << " use the 'blockSize' slot" << std::endl;
+         }
+      }
+
       // Write the serialized DataRecord with its length to the file
-      if (ok) {
+      else if (ok) {
 		  int n{static_cast<int>(wireFormat.length())};
 
          // Convert size to an integer string
@@ -321,6 +413,10 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 
          // Write the serialized DataRecord
          sout->write( wireFormat.c_str(), n );
+
+         numRecords++;
+         numRawBytes += n;
+         numFileBytes += (n + 4);
       }
 
       else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
@@ -331,6 +427,7 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       // Check for END_OF_DATA message
       thisIsEodMsg = (dataRecord->id() == REID_END_OF_DATA);
 
+      if (blockSize == 0) writeTime += (base::getComputerTime() - startTime);
    }
 
    // ---
@@ -343,6 +440,125 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Queue the current block to be compressed and written by the writer thread,
+// or write it now if we don't have a writer thread.
+//------------------------------------------------------------------------------
+void FileWriter::queueBlock()
+{
+   if (block == nullptr) return;
+
+   if (block->numRecords > 0) {
+      if (thread != nullptr && !thread->isTerminated()) {
+         base::lock(semaphore);
+         numPending++;
+         base::unlock(semaphore);
+
+         // the queue is full, wait for the writer thread
+         while (!blockQueue.put(block)) {
+            base::msleep(1);
+         }
+      }
+      else {
+         writeBlock(block);
+         delete block;
+      }
+   }
+   else delete block;
+
+   block = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Wait until all queued blocks have been written
+//------------------------------------------------------------------------------
+void FileWriter::waitForQueuedBlocks()
+{
+   bool done{};
+   while (!done) {
+      base::lock(semaphore);
+      done = (numPending == 0);
+      base::unlock(semaphore);
+
+      if (!done) {
+         if (thread == nullptr || thread->isTerminated()) writeQueuedBlocks();
+         else base::msleep(1);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Compress and write all queued blocks (called by the writer thread);
+// returns the number of blocks written
+//------------------------------------------------------------------------------
+unsigned int FileWriter::writeQueuedBlocks()
+{
+   unsigned int n{};
+   RecordBlock* p{blockQueue.get()};
+   while (p != nullptr) {
+      writeBlock(p);
+      delete p;
+      n++;
+
+      base::lock(semaphore);
+      numPending--;
+      base::unlock(semaphore);
+
+      p = blockQueue.get();
+   }
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Compress and write one block
+//------------------------------------------------------------------------------
+void FileWriter::writeBlock(const RecordBlock* const p)
+{
+   const double startTime{base::getComputerTime()};
+
+   BlockHeader hdr;
+   std::string data;
+   if (compressBlock(*p, compressionLevel, &hdr, &data)) {
+      char hbuff[BLOCK_HEADER_SIZE];
+      encodeBlockHeader(hdr, hbuff);
+      sout->write(hbuff, BLOCK_HEADER_SIZE);
+      sout->write(data.data(), data.length());
+
+      // Hand the complete block to the OS, so a killed process leaves
+      // only whole blocks behind
+      sout->flush();
+
+      numRecords += hdr.numRecords;
+      numRawBytes += (hdr.rawSize - 4.0 * hdr.numRecords);
+      numFileBytes += (BLOCK_HEADER_SIZE + hdr.dataSize);
+   }
+   else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+      std::cerr << "FileWriter::writeBlock() -- compression error; " << p->numRecords << " records lost" << std::endl;
+   }
+
+   writeTime += (base::getComputerTime() - startTime);
+}
+
+//------------------------------------------------------------------------------
+// Create the block compression and write thread
+//------------------------------------------------------------------------------
+bool FileWriter::createWriterThread()
+{
+   if ( thread == nullptr ) {
+      thread = new FileWriterThread(this);
+      thread->unref(); // 'thread' is a safe_ptr<>
+
+      bool ok{thread->start(0)};
+      if (!ok) {
+         thread = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "FileWriter::createWriterThread(): ERROR, failed to create the thread; blocks will be written by the caller" << std::endl;
+         }
+      }
+   }
+   return (thread != nullptr);
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -376,5 +592,65 @@ bool FileWriter::setPathName(const base::String* const msg)
    return true;
 }
 
+bool FileWriter::setBlockSize(const unsigned int n)
+{
+   blockSize = n;
+   return true;
+}
+
+bool FileWriter::setCompressionLevel(const int level)
+{
+   bool ok{level >= -1 && level <= 9};
+   if (ok) compressionLevel = level;
+   return ok;
+}
+
+bool FileWriter::setMaxBlockTime(const double t)
+{
+   bool ok{t >= 0};
+   if (ok) maxBlockTime = t;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool FileWriter::setSlotBlockSize(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n >= 0) ok = setBlockSize(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::setSlotBlockSize(): invalid block size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotCompressionLevel(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setCompressionLevel(msg->asInt());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::setSlotCompressionLevel(): invalid level: " << msg->asInt() << "; use [ -1 .. 9 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotMaxBlockTime(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMaxBlockTime(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::setSlotMaxBlockTime(): invalid time: " << msg->asDouble() << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
@@ -0,0 +1,25 @@
+
+#include "FileWriterThread.hpp"
+
+#include "mixr/recorder/FileWriter.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+namespace mixr {
+namespace recorder {
+
+FileWriterThread::FileWriterThread(base::Component* const parent): base::OneShotThread(parent)
+{
+}
+
+unsigned long FileWriterThread::userFunc()
+{
+   FileWriter* writer{static_cast<FileWriter*>(getParent())};
+   while ( !writer->isShutdown() ) {
+      // compress and write the queued blocks; wait a bit when there's nothing to do
+      if (writer->writeQueuedBlocks() == 0) base::msleep(2);
+   }
+   return 0;
+}
+
+}
+}
@@ -0,0 +1,22 @@
+
+#ifndef __mixr_recorder_FileWriterThread_HPP__
+#define __mixr_recorder_FileWriterThread_HPP__
+
+#include "mixr/base/threads/OneShotThread.hpp"
+
+namespace mixr {
+namespace recorder {
+
+// ---
+// Block compression and write thread
+// ---
+class FileWriterThread final : public base::OneShotThread
+{
+   public: FileWriterThread(base::Component* const parent);
+   private: unsigned long userFunc() final;
+};
+
+}
+}
+
+#endif
@@ -44,5 +44,13 @@ const DataRecordHandle* InputHandler::readRecord()
    return p;
 }
 
+//------------------------------------------------------------------------------
+// Restart the input at its first data record
+//------------------------------------------------------------------------------
+bool InputHandler::rewind()
+{
+   return false;
+}
+
 }
 }
@@ -0,0 +1,106 @@
+
+#include "mixr/recorder/LineBuffer.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace mixr {
+namespace recorder {
+
+const std::size_t LineBuffer::BUFFER_SIZE;
+const std::size_t LineBuffer::NUMBER_SIZE;
+
+//------------------------------------------------------------------------------
+// Write the buffered text to the output stream
+//------------------------------------------------------------------------------
+void LineBuffer::flush()
+{
+   if (len == 0) return;
+   std::ostream* const sout{(output != nullptr) ? output : &std::cout};
+   sout->write(buff, static_cast<std::streamsize>(len));
+   sout->flush();
+   len = 0;
+}
+
+//------------------------------------------------------------------------------
+// Room for 'n' more characters; writes the buffered text when they don't fit
+//------------------------------------------------------------------------------
+char* LineBuffer::reserve(const std::size_t n)
+{
+   if ((BUFFER_SIZE - len) < n) flush();
+   return &buff[len];
+}
+
+//------------------------------------------------------------------------------
+// Append the characters; text that's longer than the buffer is written
+// through it in blocks
+//------------------------------------------------------------------------------
+void LineBuffer::append(const char* const s, const std::size_t n)
+{
+   std::size_t i{};
+   while (i < n) {
+      if (len == BUFFER_SIZE) flush();
+      std::size_t cnt{BUFFER_SIZE - len};
+      if (cnt > (n - i)) cnt = (n - i);
+      std::memcpy(&buff[len], &s[i], cnt);
+      len += cnt;
+      i += cnt;
+   }
+}
+
+LineBuffer& LineBuffer::operator<<(const char* const s)
+{
+   if (s != nullptr) append(s, std::strlen(s));
+   return *this;
+}
+
+LineBuffer& LineBuffer::operator<<(const char c)
+{
+   *reserve(1) = c;
+   len++;
+   return *this;
+}
+
+//------------------------------------------------------------------------------
+// Integers: decimal digits
+//------------------------------------------------------------------------------
+LineBuffer& LineBuffer::operator<<(const long long v)
+{
+   if (v < 0) {
+      *this << '-';
+      // negate as unsigned, so the most negative value doesn't overflow
+      return (*this << (0ULL - static_cast<unsigned long long>(v)));
+   }
+   return (*this << static_cast<unsigned long long>(v));
+}
+
+LineBuffer& LineBuffer::operator<<(const unsigned long long v)
+{
+   char digits[NUMBER_SIZE];
+   char* p{digits + NUMBER_SIZE};
+   unsigned long long x{v};
+   do {
+      *--p = static_cast<char>('0' + (x % 10));
+      x /= 10;
+   } while (x != 0);
+   const std::size_t n{static_cast<std::size_t>(digits + NUMBER_SIZE - p)};
+   std::memcpy(reserve(n), p, n);
+   len += n;
+   return *this;
+}
+
+//------------------------------------------------------------------------------
+// Floating point: printf's "%g" format, which is the standard stream's
+// default format (precision of six digits)
+//------------------------------------------------------------------------------
+LineBuffer& LineBuffer::operator<<(const double v)
+{
+   char* const p{reserve(NUMBER_SIZE)};
+   const int n{std::snprintf(p, NUMBER_SIZE, "%g", v)};
+   if (n > 0) len += static_cast<std::size_t>(n);
+   return *this;
+}
+
+}
+}
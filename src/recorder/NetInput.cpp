@@ -2,9 +2,12 @@
 #include "mixr/recorder/NetInput.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/frame_utils.hpp"
 #include "mixr/base/network/NetHandler.hpp"
 #include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/util/system_utils.hpp"
 
 namespace mixr {
 namespace recorder {
@@ -14,11 +17,15 @@ IMPLEMENT_SUBCLASS(NetInput, "RecorderNetInput")
 BEGIN_SLOTTABLE(NetInput)
    "netHandler",           // 1) Network handler
    "noWait",               // 2) No wait (unblocked) I/O flag (default: false -- blocked I/O)
+   "reorderWindow",        // 3) Max number of out of order frames held for reordering (default: 0)
+   "reorderTimeout",       // 4) Max time a frame is held for reordering (seconds) (default: 0.2)
 END_SLOTTABLE(NetInput)
 
 BEGIN_SLOT_MAP(NetInput)
-    ON_SLOT(1, setSlotNetwork,   mixr::base::NetHandler)
-    ON_SLOT(2, setSlotNoWait,    mixr::base::Boolean)
+    ON_SLOT(1, setSlotNetwork,        mixr::base::NetHandler)
+    ON_SLOT(2, setSlotNoWait,         mixr::base::Boolean)
+    ON_SLOT(3, setSlotReorderWindow,  mixr::base::Integer)
+    ON_SLOT(4, setSlotReorderTimeout, mixr::base::Number)
 END_SLOT_MAP()
 
 NetInput::NetInput()
@@ -38,12 +45,25 @@ void NetInput::copyData(const NetInput& org, const bool cc)
    if (cc) initData();
 
    noWaitFlag = org.noWaitFlag;
+   reorderWindow = org.reorderWindow;
+   reorderTimeout = org.reorderTimeout;
 
    // We need to init this ourselves, so ...
    netHandler = nullptr;
    networkInitialized = false;
    networkInitFailed = false;
    firstPassFlg = true;
+
+   streamStarted = false;
+   heldFrames.clear();
+   frames.clear();
+   payload.clear();
+   payloadPos = 0;
+   numFrames = 0;
+   numLost = 0;
+   numDuplicates = 0;
+   numReordered = 0;
+   numDropped = 0;
 }
 
 void NetInput::deleteData()
@@ -83,11 +103,42 @@ bool NetInput::initNetworks()
 //------------------------------------------------------------------------------
 void NetInput::closeConnections()
 {
-   if (netHandler != nullptr && networkInitialized) netHandler->closeConnection();
+   if (netHandler != nullptr && networkInitialized) {
+      netHandler->closeConnection();
+
+      if (isMessageEnabled(MSG_INFO) && numFrames > 0) {
+         std::cout << "NetInput::closeConnections(): " << numFrames << " frames received, ";
+         std::cout << numLost << " lost, " << numDuplicates << " duplicates, " << numReordered << " reordered, ";
+         std::cout << numDropped << " dropped" << std::endl;
+      }
+   }
    networkInitialized = false;
    networkInitFailed = false;
 }
 
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool NetInput::setReorderWindow(const unsigned int n)
+{
+   bool ok{};
+   if (n <= MAX_REORDER_WINDOW) {
+      reorderWindow = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool NetInput::setReorderTimeout(const double dt)
+{
+   bool ok{};
+   if (dt >= 0) {
+      reorderTimeout = dt;
+      ok = true;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Read a record
 //------------------------------------------------------------------------------
@@ -107,29 +158,55 @@ const DataRecordHandle* NetInput::readRecordImp()
    if ( networkInitialized && netHandler->isConnected() ) {
 
       // ---
-      // Try to read a message into 'ibuf'
+      // When we've used all of the received records, try to read
+      // a datagram into 'ibuf'
       // ---
-      unsigned int n{netHandler->recvData( ibuf, MAX_INPUT_BUFFER_SIZE )};
+      if (payloadPos >= payload.length() && frames.empty()) {
+         unsigned int n{netHandler->recvData( ibuf, MAX_INPUT_BUFFER_SIZE )};
+         if (n > 0) receiveFrame(ibuf, n);
+
+         // Stop waiting for the missing frames when the oldest held
+         // frame has been held too long
+         if (frames.empty() && !heldFrames.empty()) {
+            if ((base::getComputerTime() - heldFrames.begin()->second.time) > reorderTimeout) skipGap();
+         }
+      }
 
       // ---
-      // If we've successfully read a message from the network
-      // then parse it as a DataRecord and put it into a Handle.
+      // Parse the next record as a DataRecord and put it into a Handle.
       // ---
-      if (n > 0) {
-         // Parse the data record
-         std::string wireFormat(ibuf, n);
-         auto dataRecord = new pb::DataRecord();
-         bool ok{dataRecord->ParseFromString(wireFormat)};
-
-         if (ok) {
-            // Create a handle for the data record (it now has ownership)
-            handle = new DataRecordHandle(dataRecord);
+      while (handle == nullptr && (payloadPos < payload.length() || !frames.empty())) {
+
+         // Next frame
+         if (payloadPos >= payload.length()) {
+            payload.swap(frames.front());
+            frames.pop_front();
+            payloadPos = 0;
          }
 
-         else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-            std::cerr << "NetInput::readRecord() -- ParseFromString() error" << std::endl;
-            delete dataRecord;
-            dataRecord = nullptr;
+         const char* rec{};
+         std::uint32_t n{};
+         if (nextRecord(payload, &payloadPos, &rec, &n)) {
+            // Parse the data record
+            auto dataRecord = new pb::DataRecord();
+            bool ok{dataRecord->ParseFromArray(rec, static_cast<int>(n))};
+
+            if (ok) {
+               // Create a handle for the data record (it now has ownership)
+               handle = new DataRecordHandle(dataRecord);
+            }
+
+            else {
+               if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                  std::cerr << "NetInput::readRecord() -- ParseFromArray() error" << std::endl;
+               }
+               delete dataRecord;
+               dataRecord = nullptr;
+            }
+         }
+         else {
+            // truncated payload
+            payloadPos = payload.length();
          }
 
       }
@@ -138,6 +215,164 @@ const DataRecordHandle* NetInput::readRecordImp()
 }
 
 
+//------------------------------------------------------------------------------
+// Check the sequence of a received frame, and queue its payload to be read
+//------------------------------------------------------------------------------
+void NetInput::receiveFrame(const char* const buff, const unsigned int n)
+{
+   FrameHeader hdr;
+   if (!decodeFrame(buff, n, &hdr)) {
+      if (n >= 4 && getU32(buff) == FRAME_MARKER) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "NetInput::receiveFrame() -- invalid frame dropped" << std::endl;
+         }
+      }
+      else {
+         // Legacy datagram: a single data record
+         char nbuff[4];
+         putU32(nbuff, n);
+         frames.emplace_back(nbuff, 4);
+         frames.back().append(buff, n);
+      }
+      return;
+   }
+
+   numFrames++;
+
+   // New stream?
+   if (!streamStarted || hdr.streamId != streamId) {
+      if (streamStarted && isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "NetInput::receiveFrame() -- new stream id: " << hdr.streamId << std::endl;
+      }
+      // Streams start at frame zero, so frames before this one are expected
+      // unless we've joined a stream that's been running for a while
+      resetStream(hdr.streamId, (hdr.sequence < 64) ? 0 : hdr.sequence);
+   }
+
+   const char* const p{buff + FRAME_HEADER_SIZE};
+   const std::int32_t d{static_cast<std::int32_t>(hdr.sequence - static_cast<std::uint32_t>(nextSeq))};
+   const std::int64_t seq{nextSeq + d};
+
+   // ---
+   // Frame from before the expected frame: a duplicate or late frame
+   // ---
+   if (d < 0) {
+      const std::int64_t i{nextSeq - 1 - seq};
+      if (i < 64 && ((history >> i) & 1) != 0) {
+         numDuplicates++;
+         if (isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "NetInput::receiveFrame() -- duplicate frame " << hdr.sequence << " dropped" << std::endl;
+         }
+         return;
+      }
+      if (i < 64) history |= (static_cast<std::uint64_t>(1) << i);
+
+      if (reorderWindow == 0) {
+         // use it anyway; frames after the start of the stream were counted as lost
+         numReordered++;
+         if (seq >= firstSeq && numLost > 0) numLost--;
+         frames.emplace_back(p, hdr.payloadSize);
+      }
+      else {
+         // its gap has been skipped (and it was counted as lost)
+         numDropped++;
+         if (isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "NetInput::receiveFrame() -- late frame " << hdr.sequence << " dropped" << std::endl;
+         }
+      }
+   }
+
+   // ---
+   // The expected frame
+   // ---
+   else if (d == 0) {
+      if (!heldFrames.empty()) numReordered++;
+      acceptFrame(seq, p, hdr.payloadSize);
+   }
+
+   // ---
+   // Frame after a gap
+   // ---
+   else if (reorderWindow == 0) {
+      numLost += static_cast<unsigned int>(d);
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "NetInput::receiveFrame() -- " << d << " frame(s) lost before frame " << hdr.sequence << std::endl;
+      }
+      acceptFrame(seq, p, hdr.payloadSize);
+   }
+   else if (heldFrames.count(seq) != 0) {
+      numDuplicates++;
+   }
+   else {
+      // Hold it until the gap is filled ...
+      HeldFrame& held{heldFrames[seq]};
+      held.payload.assign(p, hdr.payloadSize);
+      held.time = base::getComputerTime();
+
+      // ... or until we're holding too many frames
+      while (heldFrames.size() > reorderWindow) {
+         skipGap();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Skip the gap before the first held frame; the missing frames are lost
+//------------------------------------------------------------------------------
+void NetInput::skipGap()
+{
+   if (heldFrames.empty()) return;
+
+   const auto it = heldFrames.begin();
+   const std::int64_t lost{it->first - nextSeq};
+   numLost += static_cast<unsigned int>(lost);
+   if (isMessageEnabled(MSG_WARNING)) {
+      std::cerr << "NetInput::skipGap() -- " << lost << " frame(s) lost before frame ";
+      std::cerr << static_cast<std::uint32_t>(it->first) << std::endl;
+   }
+   acceptFrame(it->first, it->second.payload.data(), it->second.payload.length());
+}
+
+//------------------------------------------------------------------------------
+// Start a new stream; any held frames of the old stream are used first
+//------------------------------------------------------------------------------
+void NetInput::resetStream(const std::uint32_t id, const std::uint32_t seq)
+{
+   for (auto& f : heldFrames) {
+      frames.push_back(std::move(f.second.payload));
+   }
+   heldFrames.clear();
+
+   streamStarted = true;
+   streamId = id;
+   firstSeq = seq;
+   nextSeq = seq;
+   history = 0;
+}
+
+//------------------------------------------------------------------------------
+// Queue frame 'seq' (at or after the expected frame) to be read, followed
+// by any held frames that are now in sequence
+//------------------------------------------------------------------------------
+void NetInput::acceptFrame(const std::int64_t seq, const char* const data, const std::size_t n)
+{
+   frames.emplace_back(data, n);
+
+   const std::int64_t shift{seq + 1 - nextSeq};
+   history = (shift < 64) ? ((history << shift) | 1) : 1;
+   nextSeq = seq + 1;
+   heldFrames.erase(seq);
+
+   auto it = heldFrames.begin();
+   while (it != heldFrames.end() && it->first == nextSeq) {
+      frames.push_back(std::move(it->second.payload));
+      history = (history << 1) | 1;
+      nextSeq++;
+      it = heldFrames.erase(it);
+   }
+}
+
+
 //------------------------------------------------------------------------------
 // Slot functions
 //------------------------------------------------------------------------------
@@ -160,5 +395,32 @@ bool NetInput::setSlotNoWait(mixr::base::Boolean* const msg)
    return ok;
 }
 
+// Max number of held out of order frames
+bool NetInput::setSlotReorderWindow(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n >= 0) ok = setReorderWindow(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "NetInput::setSlotReorderWindow(): invalid window: " << n << "; use [ 0 .. " << MAX_REORDER_WINDOW << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Max time a frame is held for reordering (seconds)
+bool NetInput::setSlotReorderTimeout(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setReorderTimeout(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "NetInput::setSlotReorderTimeout(): invalid timeout: " << msg->asDouble() << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
@@ -2,9 +2,12 @@
 #include "mixr/recorder/NetOutput.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/frame_utils.hpp"
 #include "mixr/base/network/NetHandler.hpp"
 #include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/util/system_utils.hpp"
 
 namespace mixr {
 namespace recorder {
@@ -14,11 +17,19 @@ IMPLEMENT_SUBCLASS(NetOutput, "RecorderNetOutput")
 BEGIN_SLOTTABLE(NetOutput)
    "netHandler",           // 1) Network handler
    "noWait",               // 2) No wait (unblocked) I/O flag (default: false -- blocked I/O)
+   "maxFrameSize",         // 3) Max frame (datagram) size in bytes (default: 1400)
+   "maxFrameDelay",        // 4) Max time a record is held in a frame (seconds) (default: 0.1)
+   "streamId",             // 5) Stream identifier (default: generated)
+   "framing",              // 6) Pack the records into frames (default: false -- one record per datagram)
 END_SLOTTABLE(NetOutput)
 
 BEGIN_SLOT_MAP(NetOutput)
-    ON_SLOT(1, setSlotNetwork,   mixr::base::NetHandler)
-    ON_SLOT(2, setSlotNoWait,    mixr::base::Boolean)
+    ON_SLOT(1, setSlotNetwork,       mixr::base::NetHandler)
+    ON_SLOT(2, setSlotNoWait,        mixr::base::Boolean)
+    ON_SLOT(3, setSlotMaxFrameSize,  mixr::base::Integer)
+    ON_SLOT(4, setSlotMaxFrameDelay, mixr::base::Number)
+    ON_SLOT(5, setSlotStreamId,      mixr::base::Integer)
+    ON_SLOT(6, setSlotFraming,       mixr::base::Boolean)
 END_SLOT_MAP()
 
 NetOutput::NetOutput()
@@ -30,10 +41,19 @@ void NetOutput::copyData(const NetOutput& org, const bool)
 {
    BaseClass::copyData(org);
 
+   noWaitFlag = org.noWaitFlag;
+   framing = org.framing;
+   maxFrameSize = org.maxFrameSize;
+   maxFrameDelay = org.maxFrameDelay;
+   streamId = org.streamId;
+   streamIdSet = org.streamIdSet;
+
    // We need to init this ourselves, so ...
    netHandler = nullptr;
    networkInitialized = false;
    networkInitFailed = false;
+   sequence = 0;
+   frame = RecordBlock();
 }
 
 void NetOutput::deleteData()
@@ -63,6 +83,16 @@ bool NetOutput::initNetworks()
       networkInitialized = ok;
       networkInitFailed = !ok;
    }
+
+   // New stream
+   if (ok) {
+      if (!streamIdSet) {
+         const auto t = static_cast<std::uint64_t>(base::getComputerTime() * 1000000.0);
+         streamId = static_cast<std::uint32_t>(t ^ (t >> 32) ^ reinterpret_cast<std::uintptr_t>(this));
+      }
+      sequence = 0;
+      frame = RecordBlock();
+   }
    return ok;
 }
 
@@ -72,6 +102,7 @@ bool NetOutput::initNetworks()
 //------------------------------------------------------------------------------
 void NetOutput::closeConnections()
 {
+   flushFrame();
    if (netHandler != nullptr && networkInitialized) netHandler->closeConnection();
    networkInitialized = false;
    networkInitFailed = false;
@@ -79,7 +110,55 @@ void NetOutput::closeConnections()
 
 
 //------------------------------------------------------------------------------
-// Serialize and write a DataRecord to a network
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool NetOutput::shutdownNotification()
+{
+   closeConnections();
+   return BaseClass::shutdownNotification();
+}
+
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool NetOutput::setFraming(const bool flg)
+{
+   if (!flg) flushFrame();
+   framing = flg;
+   return true;
+}
+
+bool NetOutput::setMaxFrameSize(const unsigned int n)
+{
+   bool ok{};
+   if (n > FRAME_HEADER_SIZE && n <= FRAME_MAX_SIZE) {
+      maxFrameSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool NetOutput::setMaxFrameDelay(const double dt)
+{
+   bool ok{};
+   if (dt >= 0) {
+      maxFrameDelay = dt;
+      ok = true;
+   }
+   return ok;
+}
+
+bool NetOutput::setStreamId(const std::uint32_t id)
+{
+   streamId = id;
+   streamIdSet = true;
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+// Serialize a DataRecord and add it to the frame
 //------------------------------------------------------------------------------
 void NetOutput::processRecordImp(const DataRecordHandle* const handle)
 {
@@ -96,14 +175,41 @@ void NetOutput::processRecordImp(const DataRecordHandle* const handle)
       const pb::DataRecord* dataRecord{handle->getRecord()};
 
       // Serialize the DataRecord
-      std::string wireFormat;
+      wireFormat.clear();
       bool ok{dataRecord->SerializeToString(&wireFormat)};
 
-      // Write the serialized message to the network
-      if (ok) {
+      // A record must fit into one datagram (e.g., the player frame
+      // snapshots of large scenarios may not)
+      const std::size_t overhead{framing ? (FRAME_HEADER_SIZE + 4) : 0};
+      if (ok && (overhead + wireFormat.length()) > FRAME_MAX_SIZE) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "NetOutput::processRecordImp() -- record ID " << dataRecord->id();
+            std::cerr << " is too large (" << wireFormat.length() << " bytes) for a datagram" << std::endl;
+         }
+      }
+
+      // Legacy format: write the serialized record as one datagram
+      else if (ok && !framing) {
          netHandler->sendData( wireFormat.c_str(), static_cast<int>(wireFormat.length()) );
       }
 
+      else if (ok) {
+         // Send the pending frame first if this record won't fit
+         if (frame.numRecords > 0 && (FRAME_HEADER_SIZE + frame.raw.length() + 4 + wireFormat.length()) > maxFrameSize) {
+            flushFrame();
+         }
+
+         if (frame.numRecords == 0) frameWallTime = base::getComputerTime();
+         appendRecord(&frame, wireFormat, dataRecord->time().sim_time());
+
+         // Send the frame when it's full or it spans the max delay
+         if ( (FRAME_HEADER_SIZE + frame.raw.length()) >= maxFrameSize ||
+              (frame.endTime - frame.startTime) >= maxFrameDelay ||
+              (base::getComputerTime() - frameWallTime) >= maxFrameDelay ) {
+            flushFrame();
+         }
+      }
+
       else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
          // If we had an error serializing the DataRecord
          std::cerr << "NetOutput::processRecordImp() -- SerializeToString() error" << std::endl;
@@ -115,7 +221,7 @@ void NetOutput::processRecordImp(const DataRecordHandle* const handle)
    }
 
    // ---
-   // Close the file at END_OF_DATA message
+   // Close the network (sends the last frame) at END_OF_DATA message
    // ---
    if (thisIsEodMsg) {
       closeConnections();
@@ -123,6 +229,36 @@ void NetOutput::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Send the pending frame when its first record has waited for the max delay
+// (wall clock), so that the last records of a burst aren't held
+//------------------------------------------------------------------------------
+void NetOutput::updateOutputImp()
+{
+   if (frame.numRecords > 0 && (base::getComputerTime() - frameWallTime) >= maxFrameDelay) {
+      flushFrame();
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Write the pending frame to the network
+//------------------------------------------------------------------------------
+void NetOutput::flushFrame()
+{
+   if (frame.numRecords == 0) return;
+
+   if (networkInitialized && netHandler->isConnected()) {
+      encodeFrame(streamId, sequence, frame, &frameBuff);
+      netHandler->sendData( frameBuff.data(), static_cast<int>(frameBuff.length()) );
+      sequence++;
+   }
+
+   frame.raw.clear();
+   frame.numRecords = 0;
+}
+
+
 //------------------------------------------------------------------------------
 // Slot functions
 //------------------------------------------------------------------------------
@@ -145,5 +281,56 @@ bool NetOutput::setSlotNoWait(mixr::base::Boolean* const msg)
    return ok;
 }
 
+// Pack the records into frames
+bool NetOutput::setSlotFraming(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setFraming(msg->asBool());
+   }
+   return ok;
+}
+
+// Max frame size (bytes)
+bool NetOutput::setSlotMaxFrameSize(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n > 0) ok = setMaxFrameSize(static_cast<unsigned int>(n));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "NetOutput::setSlotMaxFrameSize(): invalid frame size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Max time a record is held in a frame (seconds)
+bool NetOutput::setSlotMaxFrameDelay(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMaxFrameDelay(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "NetOutput::setSlotMaxFrameDelay(): invalid delay: " << msg->asDouble() << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Stream identifier
+bool NetOutput::setSlotStreamId(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int id{msg->asInt()};
+      if (id > 0) ok = setStreamId(static_cast<std::uint32_t>(id));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "NetOutput::setSlotStreamId(): invalid stream id: " << id << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
@@ -122,6 +122,30 @@ void OutputHandler::processQueue()
       dataRecord = static_cast<const DataRecordHandle*>(queue.get());
       base::unlock( semaphore );
    }
+
+   // Send any held output that's due
+   updateOutput();
+}
+
+
+//------------------------------------------------------------------------------
+// Send any held output that's due, and pass the call to all of our
+// subcomponents (see processRecord() above)
+//------------------------------------------------------------------------------
+void OutputHandler::updateOutput()
+{
+   updateOutputImp();
+
+   base::PairStream* subcomponents{getComponents()};
+   if (subcomponents != nullptr) {
+      for (base::List::Item* item = subcomponents->getFirstItem(); item != nullptr; item = item->getNext()) {
+         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+         OutputHandler* sc{static_cast<OutputHandler*>(pair->object())};
+         sc->updateOutput();
+      }
+      subcomponents->unref();
+      subcomponents = nullptr;
+   }
 }
 
 
@@ -133,6 +157,51 @@ void OutputHandler::processRecordImp(const DataRecordHandle* const)
 }
 
 
+//------------------------------------------------------------------------------
+// updateOutputImp() stub
+//------------------------------------------------------------------------------
+void OutputHandler::updateOutputImp()
+{
+}
+
+
+//------------------------------------------------------------------------------
+// Does our processRecordImp() process the records?
+//------------------------------------------------------------------------------
+bool OutputHandler::isRecordConsumer() const
+{
+   // the OutputHandler itself only passes the records to its subcomponents
+   return (typeid(*this) != typeid(OutputHandler));
+}
+
+
+//------------------------------------------------------------------------------
+// Add the IDs accepted by this handler and its subcomponents to 'ids'
+//------------------------------------------------------------------------------
+void OutputHandler::getAcceptedIds(RecorderIdSet* const ids) const
+{
+   if (ids == nullptr) return;
+
+   RecorderIdSet accepted;
+   if (isRecordConsumer()) accepted.set();
+
+   // Our subcomponent OutputHandlers
+   const base::PairStream* subcomponents{getComponents()};
+   if (subcomponents != nullptr) {
+      for (const base::List::Item* item = subcomponents->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto sc = static_cast<const OutputHandler*>(pair->object());
+         sc->getAcceptedIds(&accepted);
+      }
+      subcomponents->unref();
+      subcomponents = nullptr;
+   }
+
+   // ... limited by our own data filters
+   *ids |= (accepted & getEnabledIds());
+}
+
+
 //------------------------------------------------------------------------------
 // Check the data filters and return true if we should process this type message
 //------------------------------------------------------------------------------
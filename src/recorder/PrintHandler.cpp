@@ -5,8 +5,15 @@
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <cstdio>
 #include <cstring>
 
+#if defined(WIN32)
+   #include <io.h>
+#else
+   #include <unistd.h>
+#endif
+
 namespace mixr {
 namespace recorder {
 
@@ -45,10 +52,14 @@ void PrintHandler::copyData(const PrintHandler& org, const bool)
    firstPassFlg = true;
    fileEmpty = true;
    setFullFilename(nullptr);
+   outBuff.clear();
+   outBuff.setOutput(nullptr);
 }
 
 void PrintHandler::deleteData()
 {
+   flushOutput();
+
    if (sout != nullptr) {
       if (isOpen()) sout->close();
       delete sout;
@@ -222,10 +233,13 @@ bool PrintHandler::openFile()
 //------------------------------------------------------------------------------
 void PrintHandler::closeFile()
 {
+   flushOutput();
+
    if (isOpen()) {
 
       // close the file
       if (sout != nullptr) sout->close();
+      outBuff.setOutput(nullptr);
 
       fileOpened = false;
       fileFailed = false;
@@ -267,10 +281,28 @@ bool PrintHandler::setPathName(const base::String* const msg)
 }
 
 
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool PrintHandler::shutdownNotification()
+{
+   flushOutput();
+   return BaseClass::shutdownNotification();
+}
+
 //------------------------------------------------------------------------------
 // print to output stream
 //------------------------------------------------------------------------------
 void PrintHandler::printToOutput(const char* const msg)
+{
+   beginLine() << msg;
+   endLine();
+}
+
+//------------------------------------------------------------------------------
+// Format and print a line
+//------------------------------------------------------------------------------
+LineBuffer& PrintHandler::beginLine()
 {
    // First pass?  Do we need to open a file?
    if (firstPassFlg) {
@@ -280,16 +312,48 @@ void PrintHandler::printToOutput(const char* const msg)
       firstPassFlg = false;
    }
 
-   // Output to a file?
+   // Output to the file, or to the standard output stream
    if (sout != nullptr && isOpen()) {
-      *sout << msg << std::endl;
+      outBuff.setOutput(sout);
       fileEmpty = false;
    }
+   else outBuff.setOutput(nullptr);
 
-   // Or to the standard output stream
-   else {
-      std::cout << msg << std::endl;
-   }
+   return outBuff;
+}
+
+void PrintHandler::endLine()
+{
+   outBuff << '\n';
+}
+
+//------------------------------------------------------------------------------
+// End of a record's lines: a console's output is written now
+//------------------------------------------------------------------------------
+void PrintHandler::endRecord()
+{
+   if (isConsole()) flushOutput();
+}
+
+//------------------------------------------------------------------------------
+// Write the buffered output to the file or to the standard output stream
+//------------------------------------------------------------------------------
+void PrintHandler::flushOutput()
+{
+   outBuff.flush();
+}
+
+//------------------------------------------------------------------------------
+// Is the output a console? (the standard output, and it's a terminal)
+//------------------------------------------------------------------------------
+bool PrintHandler::isConsole() const
+{
+#if defined(WIN32)
+   static const bool tty{_isatty(_fileno(stdout)) != 0};
+#else
+   static const bool tty{isatty(fileno(stdout)) != 0};
+#endif
+   return (tty && outBuff.getOutput() == nullptr);
 }
 
 //------------------------------------------------------------------------------
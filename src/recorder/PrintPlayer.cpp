@@ -30,6 +30,8 @@ void PrintPlayer::copyData(const PrintPlayer& org, const bool)
 {
    BaseClass::copyData(org);
 
+   namedIds = org.namedIds;
+
    { // clone player name
       const base::String* clone{};
       if (org.name != nullptr) clone = org.name->clone();
@@ -51,6 +53,7 @@ bool PrintPlayer::setName(const base::String* const msg)
    if (name != nullptr) { name->unref(); }
    name = msg;
    if (name != nullptr) { name->ref(); }
+   namedIds.clear();
    return true;
 }
 
@@ -154,6 +157,13 @@ void PrintPlayer::processRecordImp(const DataRecordHandle* const handle)
          }
          break;
       }
+      case REID_PLAYER_FRAME : {
+         if (dataRecord->has_player_frame_msg()) {
+            printPlayerFrame(&dataRecord->player_frame_msg());
+            endRecord();
+         }
+         return;
+      }
       default: {
          // not a message handled here.
          msgType = UNKNOWN;
@@ -170,11 +180,16 @@ void PrintPlayer::processRecordImp(const DataRecordHandle* const handle)
          if (playerIdMsg != nullptr && playerIdMsg->has_name()) {
             const char* sname{playerIdMsg->name().c_str()};
             printIt = (*name == sname);
+
+            // remember the named player's ID for the frame records
+            if (printIt && !isNamedPlayer(playerIdMsg->id(), playerIdMsg->fed_name())) {
+               namedIds.emplace_back(playerIdMsg->id(), playerIdMsg->fed_name());
+            }
          }
       }
 
       if (printIt) {
-         std::stringstream sout;
+         LineBuffer& sout{beginLine()};
 
          // Print the Message Type
          sout << "PLAYER " << msgTypeStr << "     ";
@@ -217,9 +232,71 @@ void PrintPlayer::processRecordImp(const DataRecordHandle* const handle)
             }
          }
 
-         printToOutput( sout.str().c_str() );
+         endLine();
+         endRecord();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Print the players of a frame snapshot record; one line per player
+//------------------------------------------------------------------------------
+void PrintPlayer::printPlayerFrame(const pb::PlayerFrameMsg* const msg)
+{
+   const int n{msg->id_size()};
+   const bool hasFed{msg->federate_size() >= n};
+   const bool hasMode{msg->mode_size() >= n};
+   const bool hasAngles{msg->angles_size() >= 3 * n};
+   const bool hasVel{msg->vel_size() >= 3 * n};
+   const bool hasPos{msg->pos_size() >= 3 * n};
+
+   static const std::string localFed;
+   for (int i = 0; i < n; i++) {
+      const std::string* fedName{&localFed};
+      if (hasFed && msg->federate(i) > 0 && static_cast<int>(msg->federate(i)) <= msg->federates_size()) {
+         fedName = &msg->federates(msg->federate(i) - 1);
       }
+
+      if (name != nullptr && !isNamedPlayer(msg->id(i), *fedName)) continue;
+
+      LineBuffer& sout{beginLine()};
+
+      // Print the Message Type
+      sout << "PLAYER FRAME     ";
+
+      // Print the Player ID data
+      sout << msg->id(i) << ";  ";
+      if (!fedName->empty()) sout << *fedName << ";  ";
+      if (hasMode) sout << msg->mode(i) << ";  ";
+
+      // Angles:
+      if (hasAngles) {
+         sout << msg->angles(3*i) << ", " << msg->angles(3*i + 1) << ", " << msg->angles(3*i + 2) << ";  ";
+      }
+
+      // Velocity:
+      if (hasVel) {
+         sout << msg->vel(3*i) << ", " << msg->vel(3*i + 1) << ", " << msg->vel(3*i + 2) << ";  ";
+      }
+
+      // Position:
+      if (hasPos) {
+         sout << msg->pos(3*i) << ", " << msg->pos(3*i + 1) << ", " << msg->pos(3*i + 2) << ";  ";
+      }
+
+      endLine();
+   }
+}
+
+//------------------------------------------------------------------------------
+// True if this is the ID of the named player
+//------------------------------------------------------------------------------
+bool PrintPlayer::isNamedPlayer(const unsigned int id, const std::string& fedName) const
+{
+   for (const auto& x : namedIds) {
+      if (x.first == id && x.second == fedName) return true;
    }
+   return false;
 }
 
 
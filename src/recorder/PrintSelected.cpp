@@ -63,6 +63,19 @@ void PrintSelected::copyData(const PrintSelected& org, const bool)
    foundSelected = org.foundSelected;
    printHeader = org.printHeader;
    timeOnly = org.timeOnly;
+
+   // recompile the selection criteria
+   compiled = false;
+   firstRecord = true;
+}
+
+//------------------------------------------------------------------------------
+// reset() -- compile the selection criteria
+//------------------------------------------------------------------------------
+void PrintSelected::reset()
+{
+   BaseClass::reset();
+   compileSelection();
 }
 
 // Slots
@@ -71,8 +84,7 @@ bool PrintSelected::setSlotMsgToken(const base::Integer* const msg)
 {
    bool ok{};
    if (msg != nullptr) {
-      ok = true;
-      msgToken = msg->asInt();
+      ok = setMsgToken(msg->asInt());
    }
    return ok;
 }
@@ -81,8 +93,7 @@ bool PrintSelected::setSlotFieldName(const base::String* const msg)
 {
    bool ok{};
    if (msg != nullptr) {
-      ok = true;
-      fieldNameStr.assign( msg->c_str() );
+      ok = setFieldOfInterest( msg->c_str() );
    }
    return ok;
 
@@ -162,170 +173,30 @@ void PrintSelected::processRecordImp(const DataRecordHandle* const handle)
    const pb::DataRecord* dataRecord{handle->getRecord()};
    if (dataRecord == nullptr) return;  // cannot continue
 
-   // using reflection:
-   // save to: const google::protobuf::Message* recMsg
-   recMsg = dataRecord;
-   //const google::protobuf::Message& root = *recMsg;
-   const google::protobuf::Descriptor* descriptor{recMsg->GetDescriptor()};
-   const google::protobuf::Reflection* reflection{recMsg->GetReflection()};
+   if (!compiled) compileSelection();
 
-   const google::protobuf::FieldDescriptor* idField{descriptor->FindFieldByName("id")};
-   unsigned int id{reflection->GetUInt32(*recMsg, idField)};
-
-   foundSelected = false;
+   recMsg = dataRecord;
+   const unsigned int id{dataRecord->id()};
 
-   // Process time message
-   processMessage( &dataRecord->time());
+   // Print the header with our first record, or when the file is empty
+   if (eventField != nullptr) {
+      if (firstRecord || isFileEmpty()) printHeader = true;
+      firstRecord = false;
+   }
 
-   // Process the event message
-   const google::protobuf::Message* processMsg{};
-   std::string msgCat{""};
-   std::string msgType{""};
+   // Only the selected event message is printed, unless we're matching time only
+   if (!timeOnly && id != msgToken) return;
 
-   switch (msgToken) {
-      case REID_FILE_ID: {
-         processMsg = &dataRecord->file_id_msg();
-         msgCat =  "FILE     ";
-         msgType = "ID       ";
-         static bool firstTime{true};
-         if ((firstTime) || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_NEW_PLAYER: {
-         processMsg = &dataRecord->new_player_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "NEW      ";
-         static bool firstTime{true};
-         if ((firstTime) || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_REMOVED: {
-         processMsg = &dataRecord->player_removed_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "REMOVED  ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_DATA: {
-         processMsg = &dataRecord->player_data_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "DATA     ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) {
-            printHeader = true;
-         }
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_DAMAGED: {
-         processMsg = &dataRecord->player_damaged_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "DAMAGED  ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_COLLISION: {
-         processMsg = &dataRecord->player_collision_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "COLLISION";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_CRASH: {
-         processMsg = &dataRecord->player_crash_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "CRASH    ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_PLAYER_KILLED: {
-         processMsg = &dataRecord->player_killed_event_msg();
-         msgCat =  "PLAYER   ";
-         msgType = "KILLED   ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_WEAPON_RELEASED: {
-         processMsg = &dataRecord->weapon_release_event_msg();
-         msgCat =  "WEAPON   ";
-         msgType = "RELEASED ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_WEAPON_HUNG: {
-         processMsg = &dataRecord->weapon_hung_event_msg();
-         msgCat =  "WEAPON   ";
-         msgType = "HUNG     ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_WEAPON_DETONATION: {
-         processMsg = &dataRecord->weapon_detonation_event_msg();
-         msgCat =  "WEAPON  ";
-         msgType = "DETONATE";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_GUN_FIRED: {
-         processMsg = &dataRecord->gun_fired_event_msg();
-         msgCat =  "GUN     ";
-         msgType = "FIRED   ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_NEW_TRACK: {
-         processMsg = &dataRecord->new_track_event_msg();
-         msgCat =  "TRACK   ";
-         msgType = "NEW     ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_TRACK_REMOVED: {
-         processMsg = &dataRecord->track_removed_event_msg();
-         msgCat =  "TRACK   ";
-         msgType = "REMOVED ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      case REID_TRACK_DATA: {
-         processMsg = &dataRecord->track_data_msg();
-         msgCat =  "TRACK   ";
-         msgType = "DATA    ";
-         static bool firstTime{true};
-         if (firstTime || isFileEmpty()) printHeader = true;
-         firstTime = false;
-         break;
-      }
-      default: break;
+   // Check the selected fields of the time message and the event message
+   foundSelected = false;
+   for (unsigned int i = 0; i < timePaths.size() && !foundSelected; i++) {
+      foundSelected = isFieldSelected(dataRecord->time(), timePaths[i]);
    }
-
-   // Process the message and see if the conditions are found
-   if (!timeOnly && (processMsg != nullptr)) {
-      processMessage(processMsg);
+   if (!timeOnly && eventField != nullptr) {
+      const google::protobuf::Message& processMsg = dataRecord->GetReflection()->GetMessage(*dataRecord, eventField);
+      for (unsigned int i = 0; i < eventPaths.size() && !foundSelected; i++) {
+         foundSelected = isFieldSelected(processMsg, eventPaths[i]);
+      }
    }
 
    // If the condition has been found and this is the message we want, print it
@@ -404,116 +275,165 @@ void PrintSelected::processRecordImp(const DataRecordHandle* const handle)
       }
       printToOutput( soutVals.str().c_str() );
    }
+   endRecord();
 }
 
 //------------------------------------------------------------------------------
-// processMessage(): Recursive function to go through all messages
+// compileSelection(): find the selected event message and the paths to the
+// selected fields within it and the time message
 //---------------------------------------------------------------------------
-void PrintSelected::processMessage(const google::protobuf::Message* const msg)
+void PrintSelected::compileSelection()
 {
-   const google::protobuf::Message& root = *msg;
-   const google::protobuf::Descriptor* descriptor{msg->GetDescriptor()};
-   const google::protobuf::Reflection* reflection{msg->GetReflection()};
+   timePaths.clear();
+   eventPaths.clear();
+   eventField = nullptr;
 
-   int fieldCount{descriptor->field_count()};
-   const google::protobuf::FieldDescriptor* fieldDescriptor{};
+   int fieldNumber{};
+   switch (msgToken) {
+      case REID_FILE_ID:           { fieldNumber = pb::DataRecord::kFileIdMsgFieldNumber;              msgCat = "FILE     "; msgType = "ID       "; break; }
+      case REID_NEW_PLAYER:        { fieldNumber = pb::DataRecord::kNewPlayerEventMsgFieldNumber;      msgCat = "PLAYER   "; msgType = "NEW      "; break; }
+      case REID_PLAYER_REMOVED:    { fieldNumber = pb::DataRecord::kPlayerRemovedEventMsgFieldNumber;  msgCat = "PLAYER   "; msgType = "REMOVED  "; break; }
+      case REID_PLAYER_DATA:       { fieldNumber = pb::DataRecord::kPlayerDataMsgFieldNumber;          msgCat = "PLAYER   "; msgType = "DATA     "; break; }
+      case REID_PLAYER_DAMAGED:    { fieldNumber = pb::DataRecord::kPlayerDamagedEventMsgFieldNumber;  msgCat = "PLAYER   "; msgType = "DAMAGED  "; break; }
+      case REID_PLAYER_COLLISION:  { fieldNumber = pb::DataRecord::kPlayerCollisionEventMsgFieldNumber; msgCat = "PLAYER   "; msgType = "COLLISION"; break; }
+      case REID_PLAYER_FRAME:      { fieldNumber = pb::DataRecord::kPlayerFrameMsgFieldNumber;         msgCat = "PLAYER   "; msgType = "FRAME    "; break; }
+      case REID_PLAYER_CRASH:      { fieldNumber = pb::DataRecord::kPlayerCrashEventMsgFieldNumber;    msgCat = "PLAYER   "; msgType = "CRASH    "; break; }
+      case REID_PLAYER_KILLED:     { fieldNumber = pb::DataRecord::kPlayerKilledEventMsgFieldNumber;   msgCat = "PLAYER   "; msgType = "KILLED   "; break; }
+      case REID_WEAPON_RELEASED:   { fieldNumber = pb::DataRecord::kWeaponReleaseEventMsgFieldNumber;  msgCat = "WEAPON   "; msgType = "RELEASED "; break; }
+      case REID_WEAPON_HUNG:       { fieldNumber = pb::DataRecord::kWeaponHungEventMsgFieldNumber;     msgCat = "WEAPON   "; msgType = "HUNG     "; break; }
+      case REID_WEAPON_DETONATION: { fieldNumber = pb::DataRecord::kWeaponDetonationEventMsgFieldNumber; msgCat = "WEAPON  "; msgType = "DETONATE"; break; }
+      case REID_GUN_FIRED:         { fieldNumber = pb::DataRecord::kGunFiredEventMsgFieldNumber;       msgCat = "GUN     "; msgType = "FIRED   "; break; }
+      case REID_NEW_TRACK:         { fieldNumber = pb::DataRecord::kNewTrackEventMsgFieldNumber;       msgCat = "TRACK   "; msgType = "NEW     "; break; }
+      case REID_TRACK_REMOVED:     { fieldNumber = pb::DataRecord::kTrackRemovedEventMsgFieldNumber;   msgCat = "TRACK   "; msgType = "REMOVED "; break; }
+      case REID_TRACK_DATA:        { fieldNumber = pb::DataRecord::kTrackDataMsgFieldNumber;           msgCat = "TRACK   "; msgType = "DATA    "; break; }
+      default: { msgCat = ""; msgType = ""; break; }
+   }
+   if (fieldNumber != 0) {
+      eventField = pb::DataRecord::descriptor()->FindFieldByNumber(fieldNumber);
+   }
 
-   // look at fields to find a match with the slot condition
-   if (fieldCount > 0) {
-      // Look at each field in this message
-      for (int i = 0; i < fieldCount; i++) {
+   FieldPath path;
+   findFieldPaths(pb::Time::descriptor(), &path, &timePaths);
+   if (eventField != nullptr) {
+      findFieldPaths(eventField->message_type(), &path, &eventPaths);
+   }
 
-         // Get field descriptor (includes messages)
-         fieldDescriptor = descriptor->field(i);
+   compiled = true;
+}
 
-         // what type is this field?
-         google::protobuf::FieldDescriptor::CppType cppType{fieldDescriptor->cpp_type()};
+//------------------------------------------------------------------------------
+// findFieldPaths(): Recursive function to find the paths to all fields named
+// 'fieldNameStr' within a message type
+//---------------------------------------------------------------------------
+void PrintSelected::findFieldPaths(const google::protobuf::Descriptor* const descriptor, FieldPath* const path, std::vector<FieldPath>* const paths) const
+{
+   const int fieldCount{descriptor->field_count()};
+   for (int i = 0; i < fieldCount; i++) {
+      const google::protobuf::FieldDescriptor* fieldDescriptor{descriptor->field(i)};
+      path->push_back(fieldDescriptor);
+
+      // If this field is a message, then look at its fields (a repeated
+      // message's fields have no single value to select)
+      if (fieldDescriptor->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+         if (!fieldDescriptor->is_repeated()) findFieldPaths(fieldDescriptor->message_type(), path, paths);
+      }
+      else if (fieldDescriptor->full_name() == fieldNameStr) {
+         paths->push_back(*path);
+      }
 
-         // If this field is a message, then call this again
-         if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
-            // Get sub message
-            const google::protobuf::Message& sub_message = reflection->GetMessage(root, fieldDescriptor);
-            processMessage(&sub_message);
-         }
-         else {
-            // field is not a message. Check File name for match
-            if (fieldDescriptor->full_name() == fieldNameStr) {
-
-               // This is the right field. Now check the value, based on type
-               if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_STRING) {
-                  std::string str{reflection->GetString(root, fieldDescriptor)};
-                  std::string matchStr{getCompareToStr()};
-                  if (str == matchStr) {
-                     // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_INT32) {
-                  const int num{reflection->GetInt32(root, fieldDescriptor)};
-                  if (((condition == Condition::EQ) && (num == getCompareToNum())) ||
-                     ((condition == Condition::GT) && (num > getCompareToNum())) ||
-                     ((condition == Condition::LT) && (num < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_INT64) {
-                  const long long num{reflection->GetInt64(root, fieldDescriptor)};
-                  if (((condition == Condition::EQ) && (num == getCompareToNum())) ||
-                     ((condition == Condition::GT) && (num > getCompareToNum())) ||
-                     ((condition == Condition::LT) && (num < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_UINT32) {
-                  const int num{static_cast<int>(reflection->GetUInt32(root, fieldDescriptor))};
-                  if (((condition == Condition::EQ) && (num == getCompareToNum())) ||
-                     ((condition == Condition::GT) && (static_cast<int>(num) > getCompareToNum())) ||
-                     ((condition == Condition::LT) && (static_cast<int>(num) < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_FLOAT) {
-                  const double num{static_cast<double>(reflection->GetFloat(root, fieldDescriptor))};
-                  if ( ((condition == Condition::EQ) && base::equal(num, getCompareToDbl())) ||
-                     ((condition == Condition::GT) && (num > getCompareToDbl())) ||
-                     ((condition == Condition::LT) && (num < getCompareToDbl()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE) {
-                  const double num{reflection->GetDouble(root, fieldDescriptor)};
-                  if ( ((condition == Condition::EQ) && base::equal(num, getCompareToDbl())) ||
-                     ((condition == Condition::GT) && (num > getCompareToDbl())) ||
-                     ((condition == Condition::LT) && (num < getCompareToDbl()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_BOOL) {
-                  const bool num{reflection->GetBool(root, fieldDescriptor)};
-                  if (num == getCompareToBool()) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_ENUM) {
-                  const google::protobuf::EnumValueDescriptor* enumVal{reflection->GetEnum(root, fieldDescriptor)};
-                  const int enumIndex{enumVal->index()};
-                  if (((condition == Condition::EQ) && (enumIndex == getCompareToNum())) ||
-                     ((condition == Condition::GT) && (enumIndex > getCompareToNum())) ||
-                     ((condition == Condition::LT) && (enumIndex < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-            }
-         }
+      path->pop_back();
+   }
+}
+
+//------------------------------------------------------------------------------
+// isFieldSelected(): Follow a field path from the root message and compare
+// the field's value with the selection criteria
+//---------------------------------------------------------------------------
+bool PrintSelected::isFieldSelected(const google::protobuf::Message& root, const FieldPath& path) const
+{
+   // Get the message that contains the field
+   const google::protobuf::Message* msg{&root};
+   for (std::size_t i = 0; (i + 1) < path.size(); i++) {
+      msg = &msg->GetReflection()->GetMessage(*msg, path[i]);
+   }
+   const google::protobuf::FieldDescriptor* fieldDescriptor{path.back()};
+
+   // A repeated field is selected if any of its values is
+   if (fieldDescriptor->is_repeated()) {
+      const int n{msg->GetReflection()->FieldSize(*msg, fieldDescriptor)};
+      for (int i = 0; i < n; i++) {
+         if (isValueSelected(*msg, fieldDescriptor, i)) return true;
       }
+      return false;
    }
+   return isValueSelected(*msg, fieldDescriptor, -1);
+}
+
+//------------------------------------------------------------------------------
+// isValueSelected(): compare a field's value with the selection criteria;
+// 'index' is the value's index in a repeated field, or -1 if not repeated
+//---------------------------------------------------------------------------
+bool PrintSelected::isValueSelected(const google::protobuf::Message& msg, const google::protobuf::FieldDescriptor* const fieldDescriptor, const int index) const
+{
+   const google::protobuf::Reflection* reflection{msg.GetReflection()};
+   const bool rep{index >= 0};
+
+   // Check the value, based on type
+   bool found{};
+   switch (fieldDescriptor->cpp_type()) {
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+         found = ((rep ? reflection->GetRepeatedString(msg, fieldDescriptor, index) : reflection->GetString(msg, fieldDescriptor)) == compareStr);
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
+         const int num{rep ? reflection->GetRepeatedInt32(msg, fieldDescriptor, index) : reflection->GetInt32(msg, fieldDescriptor)};
+         found = ((condition == Condition::EQ) && (num == compareValI)) ||
+                 ((condition == Condition::GT) && (num > compareValI)) ||
+                 ((condition == Condition::LT) && (num < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
+         const long long num{rep ? reflection->GetRepeatedInt64(msg, fieldDescriptor, index) : reflection->GetInt64(msg, fieldDescriptor)};
+         found = ((condition == Condition::EQ) && (num == compareValI)) ||
+                 ((condition == Condition::GT) && (num > compareValI)) ||
+                 ((condition == Condition::LT) && (num < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
+         const int num{static_cast<int>(rep ? reflection->GetRepeatedUInt32(msg, fieldDescriptor, index) : reflection->GetUInt32(msg, fieldDescriptor))};
+         found = ((condition == Condition::EQ) && (num == compareValI)) ||
+                 ((condition == Condition::GT) && (num > compareValI)) ||
+                 ((condition == Condition::LT) && (num < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
+         const double num{static_cast<double>(rep ? reflection->GetRepeatedFloat(msg, fieldDescriptor, index) : reflection->GetFloat(msg, fieldDescriptor))};
+         found = ((condition == Condition::EQ) && base::equal(num, compareValD)) ||
+                 ((condition == Condition::GT) && (num > compareValD)) ||
+                 ((condition == Condition::LT) && (num < compareValD));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
+         const double num{rep ? reflection->GetRepeatedDouble(msg, fieldDescriptor, index) : reflection->GetDouble(msg, fieldDescriptor)};
+         found = ((condition == Condition::EQ) && base::equal(num, compareValD)) ||
+                 ((condition == Condition::GT) && (num > compareValD)) ||
+                 ((condition == Condition::LT) && (num < compareValD));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
+         found = ((rep ? reflection->GetRepeatedBool(msg, fieldDescriptor, index) : reflection->GetBool(msg, fieldDescriptor)) == getCompareToBool());
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
+         const int enumIndex{(rep ? reflection->GetRepeatedEnum(msg, fieldDescriptor, index) : reflection->GetEnum(msg, fieldDescriptor))->index()};
+         found = ((condition == Condition::EQ) && (enumIndex == compareValI)) ||
+                 ((condition == Condition::GT) && (enumIndex > compareValI)) ||
+                 ((condition == Condition::LT) && (enumIndex < compareValI));
+         break;
+      }
+      default: break;
+   }
+   return found;
 }
 
 //------------------------------------------------------------------------------
@@ -552,58 +472,37 @@ void PrintSelected::printMessage(std::ostream& soutFields, std::ostream& soutVal
          if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
 
             // do the same again for this message, etc.
-            const google::protobuf::Message& sub_message = reflection->GetMessage(root, fieldDescriptor);
-            printMessage(soutFields, soutVals, &sub_message);
+            if (fieldDescriptor->is_repeated()) {
+               const int n{reflection->FieldSize(root, fieldDescriptor)};
+               for (int j = 0; j < n; j++) {
+                  printMessage(soutFields, soutVals, &reflection->GetRepeatedMessage(root, fieldDescriptor, j));
+               }
+            }
+            else {
+               const google::protobuf::Message& sub_message = reflection->GetMessage(root, fieldDescriptor);
+               printMessage(soutFields, soutVals, &sub_message);
+            }
          }
          else {
             // not a message: Print the field
-            if (reflection->HasField(root, fieldDescriptor)) {
+            // (repeated fields have no HasField(); print their values, if any, space separated)
+            const bool repeated{fieldDescriptor->is_repeated()};
+            if (repeated ? (reflection->FieldSize(root, fieldDescriptor) > 0) : reflection->HasField(root, fieldDescriptor)) {
                soutFields <<  std::left << std::setw(12) << fieldDescriptor->name(); // Field name
 
-               // get the value
-               switch (cppType) {
-                  case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
-                     soutVals <<  std::left << std::setw(12)<<  reflection->GetString(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
-                     soutVals <<  std::left << std::setw(12)<<  reflection->GetInt32(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
-                     soutVals <<  std::left << std::setw(12)<< reflection->GetInt64(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
-                     soutVals <<  std::left << std::setw(12)<< reflection->GetUInt32(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: {
-                     soutVals <<  std::left << std::setw(12)<< reflection->GetUInt64(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
-                     soutVals  <<  std::left << std::setw(12)<< reflection->GetDouble(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
-                     soutVals  <<  std::left << std::setw(12)<< reflection->GetFloat(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
-                     soutVals <<  std::left << std::setw(12)<< reflection->GetBool(root, fieldDescriptor);
-                     break;
-                  }
-                  case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
-                     const google::protobuf::EnumValueDescriptor* enumVal = reflection->GetEnum(root, fieldDescriptor);
-                     int enumIndex = enumVal->index();
-                     soutVals <<  std::left << std::setw(12)<<  enumIndex;
-                     break;
-                  }
-                  default: {
-                     soutVals << "   \t";
-                     break;
+               // get the value(s)
+               if (repeated) {
+                  std::stringstream values;
+                  const int n{reflection->FieldSize(root, fieldDescriptor)};
+                  for (int j = 0; j < n; j++) {
+                     if (j > 0) values << " ";
+                     printValue(values, root, fieldDescriptor, j);
                   }
+                  soutVals <<  std::left << std::setw(12) << values.str();
+               }
+               else {
+                  soutVals <<  std::left << std::setw(12);
+                  printValue(soutVals, root, fieldDescriptor, -1);
                }
             }  // end if has field
             else {
@@ -627,6 +526,60 @@ void PrintSelected::printMessage(std::ostream& soutFields, std::ostream& soutVal
    soutFields.setf( oldFlags );
 }
 
+//------------------------------------------------------------------------------
+// printValue(): print a (non-message) field's value; 'index' is the value's
+// index in a repeated field, or -1 if not repeated
+//---------------------------------------------------------------------------
+void PrintSelected::printValue(std::ostream& sout, const google::protobuf::Message& msg, const google::protobuf::FieldDescriptor* const fieldDescriptor, const int index) const
+{
+   const google::protobuf::Reflection* reflection{msg.GetReflection()};
+   const bool rep{index >= 0};
+
+   switch (fieldDescriptor->cpp_type()) {
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+         sout << (rep ? reflection->GetRepeatedString(msg, fieldDescriptor, index) : reflection->GetString(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
+         sout << (rep ? reflection->GetRepeatedInt32(msg, fieldDescriptor, index) : reflection->GetInt32(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
+         sout << (rep ? reflection->GetRepeatedInt64(msg, fieldDescriptor, index) : reflection->GetInt64(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
+         sout << (rep ? reflection->GetRepeatedUInt32(msg, fieldDescriptor, index) : reflection->GetUInt32(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: {
+         sout << (rep ? reflection->GetRepeatedUInt64(msg, fieldDescriptor, index) : reflection->GetUInt64(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
+         sout << (rep ? reflection->GetRepeatedDouble(msg, fieldDescriptor, index) : reflection->GetDouble(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
+         sout << (rep ? reflection->GetRepeatedFloat(msg, fieldDescriptor, index) : reflection->GetFloat(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
+         sout << (rep ? reflection->GetRepeatedBool(msg, fieldDescriptor, index) : reflection->GetBool(msg, fieldDescriptor));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
+         const google::protobuf::EnumValueDescriptor* enumVal{rep ? reflection->GetRepeatedEnum(msg, fieldDescriptor, index) : reflection->GetEnum(msg, fieldDescriptor)};
+         sout << enumVal->index();
+         break;
+      }
+      default: {
+         sout << "   \t";
+         break;
+      }
+   }
+}
+
 // Set selection data by function call:
 //------------------------------------------------------------------------------
 // setMsgToken(): Set Event Token of interest
@@ -634,6 +587,7 @@ void PrintSelected::printMessage(std::ostream& soutFields, std::ostream& soutVal
 bool PrintSelected::setMsgToken(const unsigned int token)
 {
    msgToken = token;
+   compiled = false;
    return true;
 }
 
@@ -643,6 +597,7 @@ bool PrintSelected::setMsgToken(const unsigned int token)
 bool PrintSelected::setFieldOfInterest(const std::string& field )
 {
    fieldNameStr = field;
+   compiled = false;
    return true;
 }
 
@@ -713,8 +668,8 @@ std::string PrintSelected::getEventMsgName(const google::protobuf::Message* cons
          // Get field descriptor (includes messages)
          fieldDescriptor = descriptor->field(i);
 
-         // Is this a message?
-         if (fieldDescriptor->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+         // Is this a (non-repeated) message?
+         if (fieldDescriptor->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE && !fieldDescriptor->is_repeated()) {
             // Yes, check has field, then save the name
             if (reflection->HasField(root, fieldDescriptor)) {
                if (fieldDescriptor->name() != "time") {
@@ -0,0 +1,637 @@
+
+#include "mixr/recorder/ReplayNetIO.hpp"
+
+#include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/InputHandler.hpp"
+#include "mixr/recorder/ReplayNib.hpp"
+#include "mixr/recorder/protobuf/DataRecord.pb.h"
+
+#include "mixr/models/player/Player.hpp"
+
+#include "mixr/simulation/Simulation.hpp"
+#include "mixr/simulation/Station.hpp"
+#include "mixr/simulation/dataRecorderTokens.hpp"
+
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/times.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+namespace mixr {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(ReplayNetIO, "ReplayNetIO")
+
+BEGIN_SLOTTABLE(ReplayNetIO)
+   "inputHandler",      // 1) Recorded data source
+   "networkID",         // 2) Network ID of the replay players
+   "federateName",      // 3) Federate name of the replayed local players
+   "templates",         // 4) Replay player templates
+   "rate",              // 5) Playback rate
+   "paused",            // 6) Start paused
+   "startTime",         // 7) Initial replay time
+   "lookahead",         // 8) Read ahead time
+END_SLOTTABLE(ReplayNetIO)
+
+BEGIN_SLOT_MAP(ReplayNetIO)
+   ON_SLOT( 1, setSlotInputHandler,  InputHandler)
+   ON_SLOT( 2, setSlotNetworkID,     base::Integer)
+   ON_SLOT( 3, setSlotFederateName,  base::Identifier)
+   ON_SLOT( 4, setSlotTemplates,     base::PairStream)
+   ON_SLOT( 5, setSlotRate,          base::Number)
+   ON_SLOT( 6, setSlotPaused,        base::Boolean)
+   ON_SLOT( 7, setSlotStartTime,     base::Time)
+   ON_SLOT( 8, setSlotLookahead,     base::Time)
+END_SLOT_MAP()
+
+ReplayNetIO::ReplayNetIO()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void ReplayNetIO::copyData(const ReplayNetIO& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   clearNibs();
+
+   InputHandler* copy{};
+   if (org.inputHandler != nullptr) copy = org.inputHandler->clone();
+   setInputHandler(copy);
+   if (copy != nullptr) copy->unref();
+
+   base::PairStream* tcopy{};
+   if (org.templates != nullptr) tcopy = org.templates->clone();
+   setTemplates(tcopy);
+   if (tcopy != nullptr) tcopy->unref();
+
+   station = nullptr;
+   simulation = nullptr;
+   netID = org.netID;
+   federateName = org.federateName;
+   rate = org.rate;
+   paused = org.paused;
+   startTime = org.startTime;
+   lookahead = org.lookahead;
+   replayTime = 0;
+   timeValid = false;
+   readTime = 0;
+   initFailed = false;
+   seekTime = 0;
+   seekPending = false;
+}
+
+void ReplayNetIO::deleteData()
+{
+   clearNibs();
+   setInputHandler(nullptr);
+   setTemplates(nullptr);
+}
+
+//------------------------------------------------------------------------------
+// reset() -- restart the replay
+//------------------------------------------------------------------------------
+void ReplayNetIO::reset()
+{
+   if (simulation == nullptr && !initFailed) initReplay();
+
+   if (timeValid) rewind(startTime);
+
+   BaseClass::reset();
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- remove the replay players and close the input
+//------------------------------------------------------------------------------
+bool ReplayNetIO::shutdownNotification()
+{
+   clearNibs();
+   if (inputHandler != nullptr) inputHandler->event(SHUTDOWN_EVENT);
+   return BaseClass::shutdownNotification();
+}
+
+//------------------------------------------------------------------------------
+// Get functions
+//------------------------------------------------------------------------------
+double ReplayNetIO::getReplayTime() const
+{
+   return replayTime;
+}
+
+double ReplayNetIO::getRate() const
+{
+   return rate;
+}
+
+bool ReplayNetIO::isPaused() const
+{
+   return paused;
+}
+
+unsigned int ReplayNetIO::getNumReplayPlayers() const
+{
+   unsigned int n{};
+   for (const auto& item : nibs) {
+      if (item.second->getPlayer() != nullptr) n++;
+   }
+   return n;
+}
+
+const std::string& ReplayNetIO::getFederateName() const
+{
+   return federateName;
+}
+
+unsigned short ReplayNetIO::getNetworkID() const
+{
+   return netID;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool ReplayNetIO::setInputHandler(InputHandler* const p)
+{
+   inputHandler = p;
+   return true;
+}
+
+bool ReplayNetIO::setNetworkID(const unsigned short v)
+{
+   netID = v;
+   return true;
+}
+
+bool ReplayNetIO::setFederateName(const std::string& x)
+{
+   federateName = x;
+   return true;
+}
+
+bool ReplayNetIO::setTemplates(base::PairStream* const p)
+{
+   templates = p;
+   return true;
+}
+
+bool ReplayNetIO::setRate(const double x)
+{
+   bool ok{};
+   if (x > 0) {
+      rate = x;
+      ok = true;
+   }
+   return ok;
+}
+
+bool ReplayNetIO::setPaused(const bool x)
+{
+   paused = x;
+   return true;
+}
+
+bool ReplayNetIO::setStartTime(const double x)
+{
+   startTime = x;
+   return true;
+}
+
+bool ReplayNetIO::setLookahead(const double x)
+{
+   bool ok{};
+   if (x >= 0) {
+      lookahead = x;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Seek to a recorded sim time; applied by the next inputFrame()
+//------------------------------------------------------------------------------
+bool ReplayNetIO::seek(const double time)
+{
+   base::lock(semaphore);
+   seekTime = time;
+   seekPending = true;
+   base::unlock(semaphore);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// inputFrame() -- advance the replay time, read the data records and update
+// the replay players
+//------------------------------------------------------------------------------
+void ReplayNetIO::inputFrame(const double dt)
+{
+   if (simulation == nullptr && !initFailed) initReplay();
+   if (simulation == nullptr) return;
+
+   base::lock(semaphore);
+   const bool seekReq{seekPending};
+   const double t{seekTime};
+   seekPending = false;
+   base::unlock(semaphore);
+
+   if (seekReq) {
+      if (timeValid && t < replayTime) rewind(t);
+      else {
+         replayTime = t;
+         timeValid = true;
+      }
+   }
+   else if (timeValid && !paused) {
+      replayTime += dt * rate;
+   }
+
+   readRecords();
+   updateNibs();
+}
+
+//------------------------------------------------------------------------------
+// outputFrame() -- nothing to output
+//------------------------------------------------------------------------------
+void ReplayNetIO::outputFrame(const double)
+{
+}
+
+//------------------------------------------------------------------------------
+// Find our Station and Simulation
+//------------------------------------------------------------------------------
+bool ReplayNetIO::initReplay()
+{
+   station = static_cast<simulation::Station*>( findContainerByType(typeid(simulation::Station)) );
+   if (station != nullptr) {
+      simulation = station->getSimulation();
+   }
+
+   if (simulation == nullptr) {
+      station = nullptr;
+      initFailed = true;
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ReplayNetIO::initReplay(): ERROR, unable to find our Station and Simulation" << std::endl;
+      }
+   }
+   if (inputHandler == nullptr && isMessageEnabled(MSG_WARNING)) {
+      std::cerr << "ReplayNetIO::initReplay(): no input handler" << std::endl;
+   }
+
+   return (simulation != nullptr);
+}
+
+//------------------------------------------------------------------------------
+// Read the data records up to the replay time plus the lookahead
+//------------------------------------------------------------------------------
+void ReplayNetIO::readRecords()
+{
+   if (inputHandler == nullptr) return;
+
+   bool done{};
+   while (!done) {
+      if (timeValid && readTime > replayTime + lookahead) done = true;
+      else {
+         const DataRecordHandle* handle{inputHandler->readRecord()};
+         if (handle == nullptr) done = true;
+         else {
+            const pb::DataRecord* record{handle->getRecord()};
+            const double t{record->time().sim_time()};
+            if (!timeValid) {
+               replayTime = (startTime >= 0 ? startTime : t);
+               timeValid = true;
+            }
+            if (t > readTime) readTime = t;
+            processRecord(record);
+            handle->unref();
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Create, remove and update the replay players
+//------------------------------------------------------------------------------
+void ReplayNetIO::updateNibs()
+{
+   const double r{paused ? 0.0 : rate};
+   auto it = nibs.begin();
+   while (it != nibs.end()) {
+      ReplayNib* nib{it->second};
+      if (nib->isRemoved(replayTime)) {
+         removeReplayPlayer(nib);
+         nib->setNetIO(nullptr);
+         nib->unref();
+         it = nibs.erase(it);
+      }
+      else {
+         nib->setReplayTime(replayTime, r);
+         if (nib->getPlayer() == nullptr && nib->getFirstTime() >= 0 && nib->getFirstTime() <= replayTime) {
+            createReplayPlayer(nib);
+         }
+         ++it;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Restart the replay at 'time' (or, if negative, at the first record's time)
+//------------------------------------------------------------------------------
+bool ReplayNetIO::rewind(const double time)
+{
+   bool ok{inputHandler != nullptr && inputHandler->rewind()};
+   if (ok) {
+      clearNibs();
+      replayTime = time;
+      timeValid = (time >= 0);
+      readTime = 0;
+   }
+   else if (isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "ReplayNetIO::rewind(): ERROR, unable to rewind the input handler" << std::endl;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Remove all replay players and nibs
+//------------------------------------------------------------------------------
+void ReplayNetIO::clearNibs()
+{
+   for (auto& item : nibs) {
+      ReplayNib* nib{item.second};
+      removeReplayPlayer(nib);
+      nib->setNetIO(nullptr);
+      nib->unref();
+   }
+   nibs.clear();
+}
+
+//------------------------------------------------------------------------------
+// Process one data record
+//------------------------------------------------------------------------------
+void ReplayNetIO::processRecord(const pb::DataRecord* const record)
+{
+   const double t{record->time().sim_time()};
+
+   switch (record->id()) {
+
+      case REID_NEW_PLAYER: {
+         const pb::NewPlayerEventMsg& msg{record->new_player_event_msg()};
+         addSample(t, msg.id(), &msg.state());
+         break;
+      }
+
+      case REID_PLAYER_DATA: {
+         const pb::PlayerDataMsg& msg{record->player_data_msg()};
+         addSample(t, msg.id(), &msg.state());
+         break;
+      }
+
+      case REID_PLAYER_REMOVED: {
+         const pb::PlayerRemovedEventMsg& msg{record->player_removed_event_msg()};
+         ReplayNib* nib{findNib(msg.id().id(), msg.id().fed_name(), false)};
+         if (nib != nullptr) nib->setRemovedTime(t);
+         break;
+      }
+
+      case REID_PLAYER_DAMAGED: {
+         const pb::PlayerDamagedEventMsg& msg{record->player_damaged_event_msg()};
+         addSample(t, msg.id(), (msg.has_state() ? &msg.state() : nullptr));
+         break;
+      }
+
+      case REID_PLAYER_COLLISION: {
+         const pb::PlayerCollisionEventMsg& msg{record->player_collision_event_msg()};
+         addSample(t, msg.id(), (msg.has_state() ? &msg.state() : nullptr));
+         break;
+      }
+
+      case REID_PLAYER_CRASH: {
+         const pb::PlayerCrashEventMsg& msg{record->player_crash_event_msg()};
+         addSample(t, msg.id(), (msg.has_state() ? &msg.state() : nullptr));
+         break;
+      }
+
+      case REID_PLAYER_KILLED: {
+         const pb::PlayerKilledEventMsg& msg{record->player_killed_event_msg()};
+         addSample(t, msg.id(), (msg.has_state() ? &msg.state() : nullptr));
+         break;
+      }
+
+      case REID_WEAPON_RELEASED: {
+         const pb::WeaponReleaseEventMsg& msg{record->weapon_release_event_msg()};
+         addSample(t, msg.wpn_id(), (msg.has_wpn_state() ? &msg.wpn_state() : nullptr));
+         break;
+      }
+
+      case REID_PLAYER_FRAME: {
+         const pb::PlayerFrameMsg& msg{record->player_frame_msg()};
+         const int n{msg.id_size()};
+         const bool velValid{msg.vel_size() == 3 * n};
+         if (msg.pos_size() != 3 * n || msg.angles_size() != 3 * n) break;
+
+         static const std::string noFed;
+         for (int i = 0; i < n; i++) {
+            const unsigned int fed{msg.federate_size() == n ? msg.federate(i) : 0};
+            const std::string& fedName{(fed > 0 && static_cast<int>(fed) <= msg.federates_size()) ? msg.federates(fed - 1) : noFed};
+
+            ReplayNib* nib{findNib(static_cast<unsigned short>(msg.id(i)), fedName)};
+            ReplayNib::Sample s;
+            s.time = t;
+            s.pos.set(msg.pos(3 * i), msg.pos(3 * i + 1), msg.pos(3 * i + 2));
+            s.angles.set(msg.angles(3 * i), msg.angles(3 * i + 1), msg.angles(3 * i + 2));
+            if (velValid) s.vel.set(msg.vel(3 * i), msg.vel(3 * i + 1), msg.vel(3 * i + 2));
+            s.velValid = velValid;
+            nib->addSample(s);
+         }
+         break;
+      }
+
+      default:
+         break;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Find (or create) the replay nib of a recorded player
+//------------------------------------------------------------------------------
+ReplayNib* ReplayNetIO::findNib(const unsigned short id, const std::string& fedName, const bool create)
+{
+   ReplayNib* nib{};
+
+   const auto it = nibs.find(NibKey(id, fedName));
+   if (it != nibs.end()) nib = it->second;
+   else if (create) {
+      char name[32]{};
+      std::snprintf(name, sizeof(name), "P%u", static_cast<unsigned int>(id));
+
+      nib = new ReplayNib();
+      nib->setNetIO(this);
+      nib->setPlayerIds(id, (fedName.empty() ? federateName : fedName), name);
+      nibs[NibKey(id, fedName)] = nib;
+   }
+
+   return nib;
+}
+
+//------------------------------------------------------------------------------
+// Add a sample to a recorded player; the player's name and type are taken
+// from the first record that has them.
+//------------------------------------------------------------------------------
+ReplayNib* ReplayNetIO::addSample(const double time, const pb::PlayerId& id, const pb::PlayerState* const state)
+{
+   ReplayNib* nib{findNib(static_cast<unsigned short>(id.id()), id.fed_name())};
+
+   if (nib->getPlayer() == nullptr) {
+      if (id.has_name() && !id.name().empty() && id.name() != nib->getPlayerName()) {
+         nib->setPlayerIds(nib->getPlayerID(), nib->getFederateName(), id.name());
+      }
+      if (id.has_ac_type() || id.has_side() || id.has_major_type()) {
+         nib->setPlayerType(id.ac_type(), id.side(), id.major_type());
+      }
+   }
+
+   if (state != nullptr) {
+      ReplayNib::Sample s;
+      s.time = time;
+      s.pos.set(state->pos().x(), state->pos().y(), state->pos().z());
+      s.angles.set(state->angles().x(), state->angles().y(), state->angles().z());
+      if (state->has_vel()) {
+         s.vel.set(state->vel().x(), state->vel().y(), state->vel().z());
+         s.velValid = true;
+      }
+      nib->addSample(s);
+   }
+
+   return nib;
+}
+
+//------------------------------------------------------------------------------
+// Create a replay player: clone the player's template (if any), and add it
+// to the simulation's player list
+//------------------------------------------------------------------------------
+models::Player* ReplayNetIO::createReplayPlayer(ReplayNib* const nib)
+{
+   models::Player* player{};
+
+   // Find the template by type, or else by major type
+   if (templates != nullptr) {
+      const models::Player* byType{};
+      const models::Player* byMajorType{};
+      const base::List::Item* item{templates->getFirstItem()};
+      while (item != nullptr && byType == nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto p = dynamic_cast<const models::Player*>(pair->object());
+         if (p != nullptr) {
+            if (!nib->getPlayerType().empty() && nib->getPlayerType() == pair->slot()) byType = p;
+            else if (byMajorType == nullptr && nib->getMajorType() != 0 && p->isMajorType(nib->getMajorType())) byMajorType = p;
+         }
+         item = item->getNext();
+      }
+      if (byType != nullptr) player = byType->clone();
+      else if (byMajorType != nullptr) player = byMajorType->clone();
+   }
+   if (player == nullptr) player = new models::Player();
+
+   // Initial state
+   base::Vec3d pos;
+   base::Vec3d angles;
+   nib->updateDeadReckoning(0.0, &pos, &angles);
+
+   player->container(simulation);
+   player->setID( nib->getPlayerID() );
+   if (nib->getSide() != 0) player->setSide( static_cast<models::Player::Side>(nib->getSide()) );
+   player->setName( nib->getPlayerName() );
+   if (!nib->getPlayerType().empty()) player->setType( nib->getPlayerType() );
+   player->setNib(nib);
+   player->setMode(models::Player::Mode::INACTIVE);
+   player->setGeocPosition( pos );
+   player->setGeocEulerAngles( angles );
+   player->setGeocVelocity( nib->getDrVelocity() );
+   player->setCrashOverride(true);
+   nib->setPlayer(player);
+
+   // Add it to the player list
+   const auto playerPair = new base::Pair(nib->getPlayerName().c_str(), player);
+   simulation->addNewPlayer(playerPair);
+
+   player->reset();
+   player->setMode(models::Player::Mode::ACTIVE);
+
+   // the simulation has it, so we should unref() both the player and the pair.
+   player->unref();
+   playerPair->unref();
+
+   return player;
+}
+
+//------------------------------------------------------------------------------
+// Remove a replay player
+//------------------------------------------------------------------------------
+void ReplayNetIO::removeReplayPlayer(ReplayNib* const nib)
+{
+   models::Player* player{nib->getPlayer()};
+   if (player != nullptr) {
+      player->setMode(models::Player::Mode::DELETE_REQUEST);
+      nib->setPlayer(nullptr);
+   }
+   nib->setReplayTime(replayTime, 0.0);
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool ReplayNetIO::setSlotNetworkID(const base::Integer* const num)
+{
+   bool ok{};
+   const int v{num->asInt()};
+   if (v >= 1 && v <= static_cast<int>(MAX_NETWORK_ID)) {
+      ok = setNetworkID(static_cast<unsigned short>(v));
+   }
+   else if (isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "ReplayNetIO::setSlotNetworkID(): invalid number(" << v << "); ";
+      std::cerr << "valid range:[1 ... " << MAX_NETWORK_ID << " ]" << std::endl;
+   }
+   return ok;
+}
+
+bool ReplayNetIO::setSlotFederateName(const base::Identifier* const x)
+{
+   return setFederateName(x->asString());
+}
+
+bool ReplayNetIO::setSlotRate(const base::Number* const x)
+{
+   const bool ok{setRate(x->asDouble())};
+   if (!ok && isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "ReplayNetIO::setSlotRate(): invalid rate: " << x->asDouble() << "; must be greater than zero" << std::endl;
+   }
+   return ok;
+}
+
+bool ReplayNetIO::setSlotPaused(const base::Boolean* const x)
+{
+   return setPaused(x->asBool());
+}
+
+bool ReplayNetIO::setSlotStartTime(const base::Time* const x)
+{
+   return setStartTime(x->getValueInSeconds());
+}
+
+bool ReplayNetIO::setSlotLookahead(const base::Time* const x)
+{
+   const bool ok{setLookahead(x->getValueInSeconds())};
+   if (!ok && isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "ReplayNetIO::setSlotLookahead(): invalid time: " << x->getValueInSeconds() << std::endl;
+   }
+   return ok;
+}
+
+}
+}
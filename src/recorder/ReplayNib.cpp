@@ -0,0 +1,263 @@
+
+#include "mixr/recorder/ReplayNib.hpp"
+
+#include "mixr/models/player/Player.hpp"
+#include "mixr/simulation/AbstractNetIO.hpp"
+
+#include "mixr/base/units/util/angle_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+namespace mixr {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(ReplayNib, "ReplayNib")
+EMPTY_SLOTTABLE(ReplayNib)
+
+ReplayNib::ReplayNib()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void ReplayNib::copyData(const ReplayNib& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   netIO = nullptr;
+   player = nullptr;
+   playerID = org.playerID;
+   federateName = org.federateName;
+   playerName = org.playerName;
+   playerType = org.playerType;
+   side = org.side;
+   majorType = org.majorType;
+   samples = org.samples;
+   firstTime = org.firstTime;
+   removedTime = org.removedTime;
+   replayTime = org.replayTime;
+   rate = org.rate;
+   drPos = org.drPos;
+   drVel = org.drVel;
+   drAngles = org.drAngles;
+   drAngularVel = org.drAngularVel;
+   drAccel = org.drAccel;
+   semaphore = 0;
+}
+
+void ReplayNib::deleteData()
+{
+   player = nullptr;
+   netIO = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Get functions
+//------------------------------------------------------------------------------
+models::Player* ReplayNib::getPlayer()
+{
+   return player;
+}
+
+const std::string& ReplayNib::getPlayerName() const
+{
+   return playerName;
+}
+
+const std::string& ReplayNib::getPlayerType() const
+{
+   return playerType;
+}
+
+unsigned int ReplayNib::getSide() const
+{
+   return side;
+}
+
+unsigned int ReplayNib::getMajorType() const
+{
+   return majorType;
+}
+
+double ReplayNib::getFirstTime() const
+{
+   return firstTime;
+}
+
+bool ReplayNib::isRemoved(const double time) const
+{
+   return (removedTime >= 0 && removedTime <= time);
+}
+
+const std::string& ReplayNib::getFederateName() const
+{
+   return federateName;
+}
+
+unsigned short ReplayNib::getPlayerID() const
+{
+   return playerID;
+}
+
+simulation::AbstractNetIO* ReplayNib::getNetIO()
+{
+   return netIO;
+}
+
+const base::Vec3d& ReplayNib::getDrVelocity() const
+{
+   return drVel;
+}
+
+const base::Vec3d& ReplayNib::getDrAcceleration() const
+{
+   return drAccel;
+}
+
+const base::Vec3d& ReplayNib::getDrAngularVelocities() const
+{
+   return drAngularVel;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool ReplayNib::setNetIO(simulation::AbstractNetIO* const p)
+{
+   netIO = p;
+   return true;
+}
+
+bool ReplayNib::setPlayer(models::Player* const p)
+{
+   player = p;
+   return true;
+}
+
+void ReplayNib::setPlayerIds(const unsigned short id, const std::string& fedName, const std::string& name)
+{
+   playerID = id;
+   federateName = fedName;
+   playerName = name;
+}
+
+void ReplayNib::setPlayerType(const std::string& type, const unsigned int s, const unsigned int mt)
+{
+   playerType = type;
+   side = s;
+   majorType = mt;
+}
+
+//------------------------------------------------------------------------------
+// Add a sample; samples are expected in time order, and a sample that's older
+// than the last one is dropped.
+//------------------------------------------------------------------------------
+void ReplayNib::addSample(const Sample& s)
+{
+   base::lock(semaphore);
+   if (samples.empty() || s.time >= samples.back().time) {
+      if (samples.empty()) {
+         drPos = s.pos;
+         drAngles = s.angles;
+         if (s.velValid) drVel = s.vel;
+      }
+      samples.push_back(s);
+      if (firstTime < 0) firstTime = s.time;
+   }
+   base::unlock(semaphore);
+}
+
+void ReplayNib::setRemovedTime(const double time)
+{
+   removedTime = time;
+}
+
+//------------------------------------------------------------------------------
+// Set the replay time and playback rate (zero while paused), and drop the
+// samples that are no longer needed
+//------------------------------------------------------------------------------
+void ReplayNib::setReplayTime(const double time, const double r)
+{
+   base::lock(semaphore);
+   replayTime = time;
+   rate = r;
+   while (samples.size() > 1 && samples[1].time <= time) {
+      samples.pop_front();
+   }
+   base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// Dead reckoning: advance our replay time and interpolate the samples
+//------------------------------------------------------------------------------
+bool ReplayNib::updateDeadReckoning(
+      const double dt,
+      base::Vec3d* const pNewPos,
+      base::Vec3d* const pNewAngles
+   )
+{
+   base::lock(semaphore);
+   replayTime += dt * rate;
+   interpolate(replayTime);
+   *pNewPos = drPos;
+   *pNewAngles = drAngles;
+   base::unlock(semaphore);
+   return true;
+}
+
+void ReplayNib::interpolate(const double time)
+{
+   if (samples.empty()) return;
+
+   // find the samples that bracket 'time'
+   std::size_t i{};
+   while (i + 1 < samples.size() && samples[i + 1].time <= time) i++;
+   const Sample& s0{samples[i]};
+
+   if (i + 1 < samples.size() && time > s0.time) {
+      // Interpolate between s0 and s1
+      const Sample& s1{samples[i + 1]};
+      const double h{s1.time - s0.time};
+      const double s{(time - s0.time) / h};
+      const double s2{s * s};
+      const double s3{s2 * s};
+
+      if (s0.velValid && s1.velValid) {
+         // cubic Hermite spline using the recorded velocities
+         const double h00{2.0 * s3 - 3.0 * s2 + 1.0};
+         const double h10{s3 - 2.0 * s2 + s};
+         const double h01{-2.0 * s3 + 3.0 * s2};
+         const double h11{s3 - s2};
+         drPos = s0.pos * h00 + s0.vel * (h10 * h) + s1.pos * h01 + s1.vel * (h11 * h);
+
+         const double d00{(6.0 * s2 - 6.0 * s) / h};
+         const double d10{3.0 * s2 - 4.0 * s + 1.0};
+         const double d11{3.0 * s2 - 2.0 * s};
+         drVel = (s1.pos - s0.pos) * (-d00) + s0.vel * d10 + s1.vel * d11;
+      }
+      else {
+         drPos = s0.pos + (s1.pos - s0.pos) * s;
+         drVel = (s1.pos - s0.pos) / h;
+      }
+
+      for (unsigned int k = 0; k < 3; k++) {
+         const double da{base::angle::aepcdRad(s1.angles[k] - s0.angles[k])};
+         drAngles[k] = base::angle::aepcdRad(s0.angles[k] + da * s);
+         drAngularVel[k] = da / h;
+      }
+   }
+   else {
+      // Before the second sample is available (or past the last sample):
+      // extrapolate using the sample's velocity
+      const double dt{time - s0.time};
+      drPos = s0.pos;
+      drVel.set(0, 0, 0);
+      if (s0.velValid) {
+         if (dt > 0) drPos = s0.pos + s0.vel * dt;
+         drVel = s0.vel;
+      }
+      drAngles = s0.angles;
+      drAngularVel.set(0, 0, 0);
+   }
+}
+
+}
+}
@@ -239,6 +239,15 @@ void TabPrinter::processRecordImp(const DataRecordHandle* const handle)
          }
          break;
       }
+      case REID_PLAYER_FRAME : {
+         if (dataRecord->has_player_frame_msg()) {
+            if ((option == MsgHdrOptions::NEW_MSG) && (playerHeader)) printHeader = true;
+            playerHeader = false;
+            const pb::PlayerFrameMsg* msg{&dataRecord->player_frame_msg()};
+            printPlayerFrameMsg(timeMsg, msg);
+         }
+         break;
+      }
       case REID_WEAPON_RELEASED : {
          if (dataRecord->has_weapon_release_event_msg()) {
             if ((option == MsgHdrOptions::NEW_MSG) && (weaponHeader)) printHeader = true;
@@ -357,6 +366,7 @@ void TabPrinter::processRecordImp(const DataRecordHandle* const handle)
    }
 
    lastMessage = messageId;
+   endRecord();
 }
 
 //------------------------------------------------------------------------------
@@ -368,7 +378,7 @@ void TabPrinter::processRecordImp(const DataRecordHandle* const handle)
 //-----------------------------------------------------------------------------
 void TabPrinter::printFileIdMsg(const pb::Time* const timeMsg, const pb::FileIdMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "FILE ID" << divider << "IDENTIFIER" << divider << "HEADER"  << divider;
@@ -382,8 +392,7 @@ void TabPrinter::printFileIdMsg(const pb::Time* const timeMsg, const pb::FileIdM
          "Day" << divider <<
          "Month" << divider <<
          "Year";
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "FILE ID" << divider << "IDENTIFIER" << divider << "DATA"  << divider;
@@ -441,7 +450,7 @@ void TabPrinter::printFileIdMsg(const pb::Time* const timeMsg, const pb::FileIdM
          sout << divider;
       }
    }
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -449,15 +458,14 @@ void TabPrinter::printFileIdMsg(const pb::Time* const timeMsg, const pb::FileIdM
 //--------------------------------------------------------------------------
 void TabPrinter::printNewPlayerEventMsg(const pb::Time* const timeMsg, const pb::NewPlayerEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "NEW" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);
       printPlayerIdMsgHdr(sout);  // player
       printPlayerStateMsgHdr(sout);
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "NEW" << divider << "DATA" << divider;
@@ -481,7 +489,7 @@ void TabPrinter::printNewPlayerEventMsg(const pb::Time* const timeMsg, const pb:
       printPlayerIdSpacer(sout);
       printPlayerDataSpacer(sout);
    }
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -489,15 +497,14 @@ void TabPrinter::printNewPlayerEventMsg(const pb::Time* const timeMsg, const pb:
 //--------------------------------------------------------------------------
 void TabPrinter::printPlayerRemovedEventMsg(const pb::Time* const timeMsg, const pb::PlayerRemovedEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "REMOVED" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);
       printPlayerIdMsgHdr(sout);  // player
       printPlayerStateMsgHdr(sout);
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "REMOVED" << divider << "DATA" << divider;
@@ -521,7 +528,7 @@ void TabPrinter::printPlayerRemovedEventMsg(const pb::Time* const timeMsg, const
       printPlayerIdSpacer(sout);
       printPlayerDataSpacer(sout);
    }
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -529,7 +536,7 @@ void TabPrinter::printPlayerRemovedEventMsg(const pb::Time* const timeMsg, const
 //--------------------------------------------------------------------------
 void TabPrinter::printPlayerDataMsg(const pb::Time* const timeMsg, const pb::PlayerDataMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "DATA" << divider << "HEADER" << divider;
@@ -541,8 +548,7 @@ void TabPrinter::printPlayerDataMsg(const pb::Time* const timeMsg, const pb::Pla
          << "beta" << divider
          << "cas" << divider;
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
       sout << "PLAYER" << divider << "DATA" << divider << "DATA" << divider;
@@ -582,7 +588,89 @@ void TabPrinter::printPlayerDataMsg(const pb::Time* const timeMsg, const pb::Pla
       sout << divider << divider << divider;
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
+}
+
+//------------------------------------------------------------------------------
+// printPlayerFrameMsg -- one line per player in the frame snapshot
+//------------------------------------------------------------------------------
+void TabPrinter::printPlayerFrameMsg(const pb::Time* const timeMsg, const pb::PlayerFrameMsg* const msg)
+{
+   if (printHeader) {
+      LineBuffer& sout{beginLine()};
+      sout << "PLAYER" << divider << "FRAME" << divider << "HEADER" << divider;
+
+      printTimeMsgHdr(sout);
+      sout << "player ID" << divider << "federate name" << divider;
+      sout << "Latitude" << divider << "Longitude" << divider << "Altitude" << divider;
+      sout << "X position" << divider
+         << "Y position" << divider
+         << "Z position" << divider;
+      sout << "X orientation" << divider
+         << "Y orientation" << divider
+         << "Z orientation" << divider;
+      sout << "X velocity" << divider
+         << "Y velocity" << divider
+         << "Z velocity" << divider;
+      sout << "mode" << divider;
+
+      endLine();
+   }
+
+   if (msg == nullptr) return;
+
+   const int n{msg->id_size()};
+   const bool hasPos{msg->pos_size() >= 3 * n};
+   const bool hasAngles{msg->angles_size() >= 3 * n};
+   const bool hasVel{msg->vel_size() >= 3 * n};
+   const bool hasMode{msg->mode_size() >= n};
+   const bool hasFed{msg->federate_size() >= n};
+
+   for (int i = 0; i < n; i++) {
+      LineBuffer& sout{beginLine()};
+      sout << "PLAYER" << divider << "FRAME" << divider << "DATA" << divider;
+      printTimeMsg(sout, timeMsg);
+
+      // player ID and federate name
+      sout << msg->id(i) << divider;
+      if (hasFed && msg->federate(i) > 0 && static_cast<int>(msg->federate(i)) <= msg->federates_size()) {
+         sout << msg->federates(msg->federate(i) - 1);
+      }
+      sout << divider;
+
+      // position
+      if (hasPos) {
+         const double x{msg->pos(3*i)};
+         const double y{msg->pos(3*i + 1)};
+         const double z{msg->pos(3*i + 2)};
+         double pLat{};
+         double pLon{};
+         double pAlt{};
+         mixr::base::nav::convertEcef2Geod(x, y, z, &pLat, &pLon, &pAlt);
+         sout << pLat << divider << pLon << divider << pAlt << divider;
+         sout << x << divider << y << divider << z << divider;
+      }
+      else sout << divider << divider << divider << divider << divider << divider;
+
+      // angles (convert to degrees)
+      if (hasAngles) {
+         sout << msg->angles(3*i) * base::angle::R2DCC << divider
+            << msg->angles(3*i + 1) * base::angle::R2DCC << divider
+            << msg->angles(3*i + 2) * base::angle::R2DCC << divider;
+      }
+      else sout << divider << divider << divider;
+
+      // velocity
+      if (hasVel) {
+         sout << msg->vel(3*i) << divider << msg->vel(3*i + 1) << divider << msg->vel(3*i + 2) << divider;
+      }
+      else sout << divider << divider << divider;
+
+      if (hasMode) sout << msg->mode(i);
+      sout << divider;
+
+      endLine();
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -590,7 +678,7 @@ void TabPrinter::printPlayerDataMsg(const pb::Time* const timeMsg, const pb::Pla
 //------------------------------------------------------------------------------
 void TabPrinter::printPlayerDamagedEventMsg(const pb::Time* const timeMsg, const pb::PlayerDamagedEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "DAMAGE" << divider << "HEADER" << divider;
@@ -599,8 +687,7 @@ void TabPrinter::printPlayerDamagedEventMsg(const pb::Time* const timeMsg, const
       printPlayerIdMsgHdr(sout);  // player
       printPlayerStateMsgHdr(sout);
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "DAMAGE" << divider << "DATA" << divider;
@@ -624,7 +711,7 @@ void TabPrinter::printPlayerDamagedEventMsg(const pb::Time* const timeMsg, const
       printPlayerDataSpacer(sout);
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -632,7 +719,7 @@ void TabPrinter::printPlayerDamagedEventMsg(const pb::Time* const timeMsg, const
 //------------------------------------------------------------------------------
 void TabPrinter::printPlayerCollisionEventMsg(const pb::Time* const timeMsg, const pb::PlayerCollisionEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "COLLISION" << divider << "HEADER" << divider;
@@ -641,8 +728,7 @@ void TabPrinter::printPlayerCollisionEventMsg(const pb::Time* const timeMsg, con
       printPlayerStateMsgHdr(sout);
       printPlayerIdMsgHdr(sout);  // other player
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "COLLISION" << divider << "DATA" << divider;
@@ -674,7 +760,7 @@ void TabPrinter::printPlayerCollisionEventMsg(const pb::Time* const timeMsg, con
       printPlayerIdSpacer(sout);    // other player
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -682,7 +768,7 @@ void TabPrinter::printPlayerCollisionEventMsg(const pb::Time* const timeMsg, con
 //------------------------------------------------------------------------------
 void TabPrinter::printPlayerCrashEventMsg(const pb::Time* const timeMsg, const pb::PlayerCrashEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "CRASH" << divider << "HEADER" << divider;
@@ -690,8 +776,7 @@ void TabPrinter::printPlayerCrashEventMsg(const pb::Time* const timeMsg, const p
       printPlayerIdMsgHdr(sout);  // player
       printPlayerStateMsgHdr(sout);
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "CRASH" << divider << "DATA" << divider;
@@ -715,7 +800,7 @@ void TabPrinter::printPlayerCrashEventMsg(const pb::Time* const timeMsg, const p
       printPlayerDataSpacer(sout);
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -723,7 +808,7 @@ void TabPrinter::printPlayerCrashEventMsg(const pb::Time* const timeMsg, const p
 //------------------------------------------------------------------------------
 void TabPrinter::printPlayerKilledEventMsg(const pb::Time* const timeMsg, const pb::PlayerKilledEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "PLAYER" << divider << "KILL" << divider << "HEADER" << divider;
@@ -732,8 +817,7 @@ void TabPrinter::printPlayerKilledEventMsg(const pb::Time* const timeMsg, const
       printPlayerStateMsgHdr(sout);
       printPlayerIdMsgHdr(sout);  // shooter
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "PLAYER" << divider << "KILL" << divider << "DATA" << divider;
@@ -764,7 +848,7 @@ void TabPrinter::printPlayerKilledEventMsg(const pb::Time* const timeMsg, const
       printPlayerIdSpacer(sout);    // shooter
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -772,13 +856,12 @@ void TabPrinter::printPlayerKilledEventMsg(const pb::Time* const timeMsg, const
 //------------------------------------------------------------------------------
 void TabPrinter::printWeaponReleaseEventMsg(const pb::Time* const timeMsg, const pb::WeaponReleaseEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "WEAPON" << divider << "RELEASE" << divider << "HEADER" << divider;
       printWeaponMsgHdr(sout);
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "WEAPON" << divider << "RELEASE" << divider << "DATA" << divider;
@@ -817,7 +900,7 @@ void TabPrinter::printWeaponReleaseEventMsg(const pb::Time* const timeMsg, const
       printPlayerIdSpacer(sout);    // target
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -825,13 +908,12 @@ void TabPrinter::printWeaponReleaseEventMsg(const pb::Time* const timeMsg, const
 //------------------------------------------------------------------------------
 void TabPrinter::printWeaponHungEventMsg(const pb::Time* const timeMsg, const pb::WeaponHungEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "WEAPON" << divider << "HUNG" << divider << "HEADER" << divider;
       printWeaponMsgHdr(sout);
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "WEAPON" << divider << "HUNG" << divider << "DATA" << divider;
@@ -869,7 +951,7 @@ void TabPrinter::printWeaponHungEventMsg(const pb::Time* const timeMsg, const pb
       printPlayerIdSpacer(sout);    // target
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -877,7 +959,7 @@ void TabPrinter::printWeaponHungEventMsg(const pb::Time* const timeMsg, const pb
 //------------------------------------------------------------------------------
 void TabPrinter::printWeaponDetonationEventMsg(const pb::Time* const timeMsg, const pb::WeaponDetonationEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
 
    if (printHeader) {
@@ -885,8 +967,7 @@ void TabPrinter::printWeaponDetonationEventMsg(const pb::Time* const timeMsg, co
       printWeaponMsgHdr(sout);
       sout << "detonation type" << divider;
       sout << "missile Distance" << divider;
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "WEAPON" << divider << "DETONATION" << divider << "DATA" << divider;
@@ -938,7 +1019,7 @@ void TabPrinter::printWeaponDetonationEventMsg(const pb::Time* const timeMsg, co
       sout <<  divider;       // missile Distance
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -946,7 +1027,7 @@ void TabPrinter::printWeaponDetonationEventMsg(const pb::Time* const timeMsg, co
 //------------------------------------------------------------------------------
 void TabPrinter::printGunFiredEventMsg(const pb::Time* const timeMsg, const pb::GunFiredEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "GUN" << divider << "FIRED" << divider << "HEADER" << divider;
@@ -955,8 +1036,7 @@ void TabPrinter::printGunFiredEventMsg(const pb::Time* const timeMsg, const pb::
       printPlayerIdMsgHdr(sout);  // launcher
       sout << "rounds" << divider;
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "GUN" << divider << "FIRED" << divider << "DATA" << divider;
@@ -980,7 +1060,7 @@ void TabPrinter::printGunFiredEventMsg(const pb::Time* const timeMsg, const pb::
       sout << divider;
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -988,14 +1068,13 @@ void TabPrinter::printGunFiredEventMsg(const pb::Time* const timeMsg, const pb::
 //------------------------------------------------------------------------------
 void TabPrinter::printNewTrackEventMsg(const pb::Time* const timeMsg, const pb::NewTrackEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "TRACK" << divider << "ADDED" << divider << "HEADER" << divider;
       printTrackMsgHdr(sout);
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "TRACK" << divider << "ADDED" << divider << "DATA" << divider;
@@ -1058,7 +1137,7 @@ void TabPrinter::printNewTrackEventMsg(const pb::Time* const timeMsg, const pb::
       }
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -1066,13 +1145,12 @@ void TabPrinter::printNewTrackEventMsg(const pb::Time* const timeMsg, const pb::
 //------------------------------------------------------------------------------
 void TabPrinter::printTrackRemovedEventMsg(const pb::Time* const timeMsg, const pb::TrackRemovedEventMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "TRACK" << divider << "REMOVED" << divider << "HEADER" << divider;
       printTrackMsgHdr(sout);
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "TRACK" << divider << "REMOVED" << divider << "DATA" << divider;
@@ -1102,7 +1180,7 @@ void TabPrinter::printTrackRemovedEventMsg(const pb::Time* const timeMsg, const
       printEmissionDataSpacer(sout);  // emission data
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -1110,14 +1188,13 @@ void TabPrinter::printTrackRemovedEventMsg(const pb::Time* const timeMsg, const
 //------------------------------------------------------------------------------
 void TabPrinter::printTrackDataMsg(const pb::Time* const timeMsg, const pb::TrackDataMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "TRACK" << divider << "UPDATE" << divider << "HEADER" << divider;
       printTrackMsgHdr(sout);
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "TRACK" << divider << "UPDATE" << divider << "DATA" << divider;
@@ -1180,13 +1257,13 @@ void TabPrinter::printTrackDataMsg(const pb::Time* const timeMsg, const pb::Trac
       }
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
 // printTrackMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printTrackMsgHdr(std::ostream& sout)
+void TabPrinter::printTrackMsgHdr(LineBuffer& sout)
 {
       printTimeMsgHdr(sout);
 
@@ -1209,7 +1286,7 @@ void TabPrinter::printTrackMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printTimeMsg
 //------------------------------------------------------------------------------
-void TabPrinter::printTimeMsg(std::ostream& sout, const pb::Time* const timeMsg)
+void TabPrinter::printTimeMsg(LineBuffer& sout, const pb::Time* const timeMsg)
 {
    // print time message values:
    if (timeMsg != nullptr) {
@@ -1238,7 +1315,7 @@ void TabPrinter::printTimeMsg(std::ostream& sout, const pb::Time* const timeMsg)
 //------------------------------------------------------------------------------
 // printTimeMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printTimeMsgHdr(std::ostream& sout)
+void TabPrinter::printTimeMsgHdr(LineBuffer& sout)
 {
    // print time message:
    // header
@@ -1250,7 +1327,7 @@ void TabPrinter::printTimeMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printPlayerIdMsg
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerIdMsg(std::ostream& sout, const pb::PlayerId* const msg)
+void TabPrinter::printPlayerIdMsg(LineBuffer& sout, const pb::PlayerId* const msg)
 {
    // values
    if (msg != nullptr) {
@@ -1288,7 +1365,7 @@ void TabPrinter::printPlayerIdMsg(std::ostream& sout, const pb::PlayerId* const
 //------------------------------------------------------------------------------
 // printPlayerIdMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerIdMsgHdr(std::ostream& sout)
+void TabPrinter::printPlayerIdMsgHdr(LineBuffer& sout)
 {
    // header
    sout << "player ID"               << divider;
@@ -1299,7 +1376,7 @@ void TabPrinter::printPlayerIdMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printPlayerIdSpacer() -- creates empty space for the player ID message
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerIdSpacer(std::ostream& sout)
+void TabPrinter::printPlayerIdSpacer(LineBuffer& sout)
 {
     sout << divider;    // player ID
     sout << divider;    // player name
@@ -1309,7 +1386,7 @@ void TabPrinter::printPlayerIdSpacer(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printPlayerStateMsg
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerStateMsg(std::ostream& sout, const pb::PlayerState* const msg)
+void TabPrinter::printPlayerStateMsg(LineBuffer& sout, const pb::PlayerState* const msg)
 {
    // Player State
    if (msg != nullptr) {
@@ -1391,7 +1468,7 @@ void TabPrinter::printPlayerStateMsg(std::ostream& sout, const pb::PlayerState*
 //------------------------------------------------------------------------------
 // printPlayerStateMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerStateMsgHdr(std::ostream& sout)
+void TabPrinter::printPlayerStateMsgHdr(LineBuffer& sout)
 {
    // header
    sout << "Latitude" << divider << "Longitude" << divider << "Altitude" << divider;
@@ -1410,7 +1487,7 @@ void TabPrinter::printPlayerStateMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printPlayerDataSpacer() -- creates empty space for the player ID message
 //------------------------------------------------------------------------------
-void TabPrinter::printPlayerDataSpacer(std::ostream& sout)
+void TabPrinter::printPlayerDataSpacer(LineBuffer& sout)
 {
    sout << divider       // X position
         << divider       // Y position
@@ -1427,7 +1504,7 @@ void TabPrinter::printPlayerDataSpacer(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printWeaponMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printWeaponMsgHdr(std::ostream& sout)
+void TabPrinter::printWeaponMsgHdr(LineBuffer& sout)
 {
    // print common weapon message header:
    printTimeMsgHdr(sout);
@@ -1440,7 +1517,7 @@ void TabPrinter::printWeaponMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printCommonTrackDataMsg
 //------------------------------------------------------------------------------
-void TabPrinter::printCommonTrackDataMsg(std::ostream& sout, const pb::TrackData* const msg)
+void TabPrinter::printCommonTrackDataMsg(LineBuffer& sout, const pb::TrackData* const msg)
 {
    // Track Data
 
@@ -1534,7 +1611,7 @@ void TabPrinter::printCommonTrackDataMsg(std::ostream& sout, const pb::TrackData
 //------------------------------------------------------------------------------
 // printTrackDataHdr (common track data)
 //------------------------------------------------------------------------------
-void TabPrinter::printTrackDataHdr(std::ostream& sout)
+void TabPrinter::printTrackDataHdr(LineBuffer& sout)
 {
    // Track Data Header
    sout << "type" << divider;
@@ -1560,7 +1637,7 @@ void TabPrinter::printTrackDataHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printTrackDataSpacer (for common track data)
 //------------------------------------------------------------------------------
-void TabPrinter::printTrackDataSpacer(std::ostream& sout)
+void TabPrinter::printTrackDataSpacer(LineBuffer& sout)
 {
    // Track Data Header Spacers
    sout <<  divider;              // type
@@ -1582,7 +1659,7 @@ void TabPrinter::printTrackDataSpacer(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printEmissionDataMsg
 //------------------------------------------------------------------------------
-void TabPrinter::printEmissionDataMsg(std::ostream& sout, const pb::EmissionData* const msg)
+void TabPrinter::printEmissionDataMsg(LineBuffer& sout, const pb::EmissionData* const msg)
 {
    if (msg != nullptr) {
       // emission data values
@@ -1631,7 +1708,7 @@ void TabPrinter::printEmissionDataMsg(std::ostream& sout, const pb::EmissionData
 //------------------------------------------------------------------------------
 // printEmissionDataMsgHdr
 //------------------------------------------------------------------------------
-void TabPrinter::printEmissionDataMsgHdr(std::ostream& sout)
+void TabPrinter::printEmissionDataMsgHdr(LineBuffer& sout)
 {
    // emission data header
    sout << "frequency" << divider;
@@ -1648,7 +1725,7 @@ void TabPrinter::printEmissionDataMsgHdr(std::ostream& sout)
 //------------------------------------------------------------------------------
 // printEmissionDataSpacer() -- print the tab spaces for emission data message
 //------------------------------------------------------------------------------
-void TabPrinter::printEmissionDataSpacer(std::ostream& sout)
+void TabPrinter::printEmissionDataSpacer(LineBuffer& sout)
 {
    sout << divider;       //frequency
    sout << divider;       //wave length
@@ -1667,15 +1744,14 @@ void TabPrinter::printEmissionDataSpacer(std::ostream& sout)
 //------------------------------------------------------------------------------
 void TabPrinter::printMarkerMsg(const pb::Time* const timeMsg, const pb::MarkerMsg* const msg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "MARKER" << divider << "MESSAGE" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);  // time header
       sout << "ID    " << divider << "SOURCE ID" << divider;
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "MARKER" << divider << "MESSAGE" << divider << "DATA" << divider;
@@ -1699,7 +1775,7 @@ void TabPrinter::printMarkerMsg(const pb::Time* const timeMsg, const pb::MarkerM
       sout <<  divider;    // SOURCE ID
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 
@@ -1708,7 +1784,7 @@ void TabPrinter::printMarkerMsg(const pb::Time* const timeMsg, const pb::MarkerM
 //------------------------------------------------------------------------------
 void TabPrinter::printInputDeviceMsg(const pb::Time* const timeMsg, const pb::InputDeviceMsg* const msg, const unsigned int msgId)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
    std::string inputType{""};
 
    if (msgId == REID_AI_EVENT) inputType = "ANALOG ";
@@ -1719,8 +1795,7 @@ void TabPrinter::printInputDeviceMsg(const pb::Time* const timeMsg, const pb::In
       printTimeMsgHdr(sout);  // time header
       sout << "TYPE" << divider << "ID    " << divider << "SOURCE ID" << divider << "VALUE" << divider;
 
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "INPUT"  << divider << "DEVICE" << divider << "DATA" << divider;
@@ -1752,7 +1827,7 @@ void TabPrinter::printInputDeviceMsg(const pb::Time* const timeMsg, const pb::In
       sout <<  divider;    // VALUE
    }
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 
@@ -1761,20 +1836,22 @@ void TabPrinter::printInputDeviceMsg(const pb::Time* const timeMsg, const pb::In
 //------------------------------------------------------------------------------
 void TabPrinter::printEndOfData(const pb::Time* const timeMsg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "LAST " << divider << "MESSAGE" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);  // time header
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "LAST " << divider << "MESSAGE" << divider << "DATA" << divider;
 
    printTimeMsg(sout, timeMsg);
 
-   printToOutput( sout.str().c_str() );
+   endLine();
+
+   // Last record; write the buffered output
+   flushOutput();
 }
 
 //------------------------------------------------------------------------------
@@ -1782,20 +1859,19 @@ void TabPrinter::printEndOfData(const pb::Time* const timeMsg)
 //------------------------------------------------------------------------------
 void TabPrinter::printUnhandledIdToken(const pb::Time* const timeMsg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "UNHANDLED " << divider << "TOKEN" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);  // time header
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "UNHANDLED " << divider << "TOKEN" << divider << "DATA" << divider;
 
    printTimeMsg(sout, timeMsg);
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
@@ -1803,26 +1879,25 @@ void TabPrinter::printUnhandledIdToken(const pb::Time* const timeMsg)
 //------------------------------------------------------------------------------
 void TabPrinter::printResetEvent(const pb::Time* const timeMsg)
 {
-   std::stringstream sout;
+   LineBuffer& sout{beginLine()};
 
    if (printHeader) {
       sout << "RESET " << divider << "EVENT" << divider << "HEADER" << divider;
       printTimeMsgHdr(sout);  // time header
-      printToOutput( sout.str().c_str() );
-      sout.str("");
+      endLine();
    }
 
    sout << "RESET " << divider << "EVENT" << divider << "DATA" << divider;
 
    printTimeMsg(sout, timeMsg);
 
-   printToOutput( sout.str().c_str() );
+   endLine();
 }
 
 //------------------------------------------------------------------------------
 // printExecTimeMsg() -- print the time string for EXEC time
 //------------------------------------------------------------------------------
-void TabPrinter::printExecTimeMsg(std::ostream& sout, double execTime)
+void TabPrinter::printExecTimeMsg(LineBuffer& sout, double execTime)
 {
     char cbuf[16]{};
     int hh{};         // Hours
@@ -1838,7 +1913,7 @@ void TabPrinter::printExecTimeMsg(std::ostream& sout, double execTime)
 //------------------------------------------------------------------------------
 // printUtcTimeMsg() -- print the time string for UTC time
 //------------------------------------------------------------------------------
-void TabPrinter::printUtcTimeMsg(std::ostream& sout, double utcTime)
+void TabPrinter::printUtcTimeMsg(LineBuffer& sout, double utcTime)
 {
     char cbuf[16]{};
     int hh{};         // Hours
@@ -1854,7 +1929,7 @@ void TabPrinter::printUtcTimeMsg(std::ostream& sout, double utcTime)
 //------------------------------------------------------------------------------
 // printSimTimeMsg() -- print the time string for Simulation time
 //------------------------------------------------------------------------------
-void TabPrinter::printSimTimeMsg(std::ostream& sout, double simTime)
+void TabPrinter::printSimTimeMsg(LineBuffer& sout, double simTime)
 {
     char cbuf[16]{};
     int hh{};         // Hours
@@ -0,0 +1,199 @@
+
+#include "mixr/recorder/block_utils.hpp"
+
+#include <zlib.h>
+#include <cstring>
+#include <istream>
+
+namespace mixr {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// File header check
+//------------------------------------------------------------------------------
+bool isBlockFileHeader(const char* const buff)
+{
+   return (std::memcmp(buff, BLOCK_FILE_MAGIC, BLOCK_FILE_HEADER_SIZE) == 0);
+}
+
+//------------------------------------------------------------------------------
+// Append a size prefixed record to the block
+//------------------------------------------------------------------------------
+void appendRecord(RecordBlock* const block, const std::string& wireFormat, const double simTime)
+{
+   char nbuff[4];
+   putU32(nbuff, static_cast<std::uint32_t>(wireFormat.length()));
+   block->raw.append(nbuff, 4);
+   block->raw.append(wireFormat);
+
+   if (block->numRecords == 0) block->startTime = simTime;
+   block->endTime = simTime;
+   block->numRecords++;
+}
+
+//------------------------------------------------------------------------------
+// Compress a block
+//------------------------------------------------------------------------------
+bool compressBlock(const RecordBlock& block, const int level, BlockHeader* const hdr, std::string* const data)
+{
+   uLongf n{compressBound(static_cast<uLong>(block.raw.length()))};
+   data->resize(n);
+
+   const int status{compress2(
+         reinterpret_cast<Bytef*>(&(*data)[0]), &n,
+         reinterpret_cast<const Bytef*>(block.raw.data()), static_cast<uLong>(block.raw.length()),
+         level)};
+   if (status != Z_OK) return false;
+   data->resize(n);
+
+   hdr->numRecords = block.numRecords;
+   hdr->rawSize = static_cast<std::uint32_t>(block.raw.length());
+   hdr->dataSize = static_cast<std::uint32_t>(n);
+   hdr->checksum = checksum(data->data(), data->length());
+   hdr->startTime = block.startTime;
+   hdr->endTime = block.endTime;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Decompress a block
+//------------------------------------------------------------------------------
+bool decompressBlock(const BlockHeader& hdr, const char* const data, std::string* const raw)
+{
+   if (checksum(data, hdr.dataSize) != hdr.checksum) return false;
+
+   raw->resize(hdr.rawSize);
+   uLongf n{hdr.rawSize};
+   const int status{uncompress(
+         reinterpret_cast<Bytef*>(&(*raw)[0]), &n,
+         reinterpret_cast<const Bytef*>(data), hdr.dataSize)};
+   return (status == Z_OK && n == hdr.rawSize);
+}
+
+//------------------------------------------------------------------------------
+// Next record from an uncompressed payload
+//------------------------------------------------------------------------------
+bool nextRecord(const std::string& raw, std::size_t* const pos, const char** const rec, std::uint32_t* const n)
+{
+   if (*pos + 4 > raw.length()) return false;
+   const std::uint32_t len{getU32(raw.data() + *pos)};
+   if (*pos + 4 + len > raw.length()) return false;
+
+   *rec = raw.data() + *pos + 4;
+   *n = len;
+   *pos += 4 + len;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Block header encoder/decoder
+//------------------------------------------------------------------------------
+void encodeBlockHeader(const BlockHeader& hdr, char* const buff)
+{
+   putU32(buff,      BLOCK_SYNC_MARKER);
+   putU32(buff + 4,  hdr.numRecords);
+   putU32(buff + 8,  hdr.rawSize);
+   putU32(buff + 12, hdr.dataSize);
+   putU32(buff + 16, hdr.checksum);
+   putF64(buff + 20, hdr.startTime);
+   putF64(buff + 28, hdr.endTime);
+   putU32(buff + 36, checksum(buff, 36));
+}
+
+bool decodeBlockHeader(const char* const buff, BlockHeader* const hdr)
+{
+   if (getU32(buff) != BLOCK_SYNC_MARKER) return false;
+   if (getU32(buff + 36) != checksum(buff, 36)) return false;
+
+   hdr->numRecords = getU32(buff + 4);
+   hdr->rawSize    = getU32(buff + 8);
+   hdr->dataSize   = getU32(buff + 12);
+   hdr->checksum   = getU32(buff + 16);
+   hdr->startTime  = getF64(buff + 20);
+   hdr->endTime    = getF64(buff + 28);
+   return (hdr->rawSize <= BLOCK_MAX_RAW_SIZE && hdr->dataSize <= compressBound(BLOCK_MAX_RAW_SIZE));
+}
+
+//------------------------------------------------------------------------------
+// Read the next valid block
+//------------------------------------------------------------------------------
+BlockStatus readNextBlock(std::istream& sin, const bool resync, BlockHeader* const hdr, std::string* const data, std::uint64_t* const skipped)
+{
+   std::int64_t pos{static_cast<std::int64_t>(sin.tellg())};
+   if (pos < 0) return BlockStatus::END_OF_FILE;
+
+   for (;;) {
+      char hbuff[BLOCK_HEADER_SIZE]{};
+      sin.read(hbuff, BLOCK_HEADER_SIZE);
+      const std::streamsize n{sin.gcount()};
+      if (n == 0) return BlockStatus::END_OF_FILE;
+
+      bool ok{n == BLOCK_HEADER_SIZE && decodeBlockHeader(hbuff, hdr)};
+      if (ok) {
+         data->resize(hdr->dataSize);
+         if (hdr->dataSize > 0) sin.read(&(*data)[0], hdr->dataSize);
+         ok = (hdr->dataSize == 0 || static_cast<std::uint32_t>(sin.gcount()) == hdr->dataSize);
+         if (ok) ok = (checksum(data->data(), hdr->dataSize) == hdr->checksum);
+      }
+      if (ok) return BlockStatus::VALID;
+      if (!resync) return BlockStatus::CORRUPTED;
+
+      // Skip to the next sync marker and try again
+      const std::int64_t next{findSyncMarker(sin, pos + 1)};
+      sin.clear();
+      if (next < 0) {
+         sin.seekg(0, std::ios_base::end);
+         *skipped += static_cast<std::uint64_t>(static_cast<std::int64_t>(sin.tellg()) - pos);
+         return BlockStatus::END_OF_FILE;
+      }
+      *skipped += static_cast<std::uint64_t>(next - pos);
+      pos = next;
+      sin.seekg(pos);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Find the next sync marker
+//------------------------------------------------------------------------------
+std::int64_t findSyncMarker(std::istream& sin, const std::int64_t pos)
+{
+   char marker[4];
+   putU32(marker, BLOCK_SYNC_MARKER);
+
+   static const std::size_t CHUNK_SIZE{64 * 1024};
+   std::string buff(CHUNK_SIZE + 3, '\0');
+
+   sin.clear();
+   sin.seekg(pos);
+   std::int64_t offset{pos};     // File offset of buff[0]
+   std::size_t carry{};          // Bytes carried over from the previous chunk
+   for (;;) {
+      sin.read(&buff[carry], CHUNK_SIZE);
+      const std::size_t n{carry + static_cast<std::size_t>(sin.gcount())};
+      if (n < 4) return -1;
+
+      for (std::size_t i = 0; i + 4 <= n; i++) {
+         if (buff[i] == marker[0] && std::memcmp(&buff[i], marker, 4) == 0) {
+            return offset + static_cast<std::int64_t>(i);
+         }
+      }
+      if (sin.eof()) return -1;
+
+      // keep the last 3 bytes; the marker may straddle the chunks
+      std::memmove(&buff[0], &buff[n - 3], 3);
+      offset += static_cast<std::int64_t>(n - 3);
+      carry = 3;
+   }
+}
+
+//------------------------------------------------------------------------------
+// CRC-32 checksum
+//------------------------------------------------------------------------------
+std::uint32_t checksum(const char* const data, const std::size_t n)
+{
+   const uLong crc{crc32(0L, Z_NULL, 0)};
+   return static_cast<std::uint32_t>(crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(n)));
+}
+
+}
+}
@@ -0,0 +1,103 @@
+
+#include "mixr/recorder/column_utils.hpp"
+
+namespace mixr {
+namespace recorder {
+
+namespace {
+
+const ColumnDef playerDataColumns[] {
+   { "time",         ColumnType::F64 },
+   { "player",       ColumnType::PLAYER },
+   { "pos_x",        ColumnType::F64 },
+   { "pos_y",        ColumnType::F64 },
+   { "pos_z",        ColumnType::F64 },
+   { "angles_x",     ColumnType::F64 },
+   { "angles_y",     ColumnType::F64 },
+   { "angles_z",     ColumnType::F64 },
+   { "vel_x",        ColumnType::F64 },
+   { "vel_y",        ColumnType::F64 },
+   { "vel_z",        ColumnType::F64 },
+   { "damage",       ColumnType::F64 },
+   { "alpha",        ColumnType::F64 },
+   { "beta",         ColumnType::F64 },
+   { "cas",          ColumnType::F64 }
+};
+
+const ColumnDef trackColumns[] {
+   { "time",         ColumnType::F64 },
+   { "event",        ColumnType::U32 },
+   { "player",       ColumnType::PLAYER },
+   { "track",        ColumnType::TRACK },
+   { "trk_player",   ColumnType::PLAYER },
+   { "type",         ColumnType::U32 },
+   { "quality",      ColumnType::F64 },
+   { "true_az",      ColumnType::F64 },
+   { "rel_az",       ColumnType::F64 },
+   { "elevation",    ColumnType::F64 },
+   { "range",        ColumnType::F64 },
+   { "latitude",     ColumnType::F64 },
+   { "longitude",    ColumnType::F64 },
+   { "altitude",     ColumnType::F64 },
+   { "avg_signal",   ColumnType::F64 }
+};
+
+const ColumnDef detonationColumns[] {
+   { "time",         ColumnType::F64 },
+   { "weapon",       ColumnType::PLAYER },
+   { "shooter",      ColumnType::PLAYER },
+   { "target",       ColumnType::PLAYER },
+   { "det_type",     ColumnType::U32 },
+   { "miss_dist",    ColumnType::F64 },
+   { "pos_x",        ColumnType::F64 },
+   { "pos_y",        ColumnType::F64 },
+   { "pos_z",        ColumnType::F64 }
+};
+
+const ColumnDef emissionColumns[] {
+   { "time",         ColumnType::F64 },
+   { "player",       ColumnType::PLAYER },
+   { "track",        ColumnType::TRACK },
+   { "origin",       ColumnType::PLAYER },
+   { "target",       ColumnType::PLAYER },
+   { "frequency",    ColumnType::F64 },
+   { "wave_length",  ColumnType::F64 },
+   { "pulse_width",  ColumnType::F64 },
+   { "bandwidth",    ColumnType::F64 },
+   { "prf",          ColumnType::F64 },
+   { "power",        ColumnType::F64 },
+   { "polarization", ColumnType::U32 },
+   { "azimuth_aoi",  ColumnType::F64 },
+   { "elevation_aoi",ColumnType::F64 }
+};
+
+}
+
+const ColumnDef* getColumnDefs(const ColumnTable table, unsigned int* const n)
+{
+   const ColumnDef* p{};
+   unsigned int cnt{};
+   switch (table) {
+      case ColumnTable::PLAYER_DATA: { p = playerDataColumns; cnt = sizeof(playerDataColumns) / sizeof(ColumnDef); break; }
+      case ColumnTable::TRACK:       { p = trackColumns;      cnt = sizeof(trackColumns) / sizeof(ColumnDef);      break; }
+      case ColumnTable::DETONATION:  { p = detonationColumns; cnt = sizeof(detonationColumns) / sizeof(ColumnDef); break; }
+      case ColumnTable::EMISSION:    { p = emissionColumns;   cnt = sizeof(emissionColumns) / sizeof(ColumnDef);   break; }
+   }
+   if (n != nullptr) *n = cnt;
+   return p;
+}
+
+const char* getColumnTableName(const ColumnTable table)
+{
+   const char* p{""};
+   switch (table) {
+      case ColumnTable::PLAYER_DATA: { p = "players";     break; }
+      case ColumnTable::TRACK:       { p = "tracks";      break; }
+      case ColumnTable::DETONATION:  { p = "detonations"; break; }
+      case ColumnTable::EMISSION:    { p = "emissions";   break; }
+   }
+   return p;
+}
+
+}
+}
@@ -3,6 +3,7 @@
 
 #include "mixr/base/Object.hpp"
 
+#include "mixr/recorder/ColumnWriter.hpp"
 #include "mixr/recorder/DataRecorder.hpp"
 #include "mixr/recorder/FileWriter.hpp"
 #include "mixr/recorder/FileReader.hpp"
@@ -12,6 +13,7 @@
 #include "mixr/recorder/TabPrinter.hpp"
 #include "mixr/recorder/PrintPlayer.hpp"
 #include "mixr/recorder/PrintSelected.hpp"
+#include "mixr/recorder/ReplayNetIO.hpp"
 
 #include <string>
 
@@ -49,6 +51,12 @@ base::Object* factory(const std::string& name)
     else if ( name == PrintSelected::getFactoryName() ) {
         obj = new PrintSelected();
     }
+    else if ( name == ColumnWriter::getFactoryName() ) {
+        obj = new ColumnWriter();
+    }
+    else if ( name == ReplayNetIO::getFactoryName() ) {
+        obj = new ReplayNetIO();
+    }
 
     return obj;
 }
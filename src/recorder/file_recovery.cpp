@@ -0,0 +1,171 @@
+
+#include "mixr/recorder/file_recovery.hpp"
+#include "mixr/recorder/block_utils.hpp"
+
+#include <fstream>
+#include <string>
+
+#if defined(WIN32)
+   #include <io.h>
+   #include <fcntl.h>
+   #include <sys/stat.h>
+#else
+   #include <unistd.h>
+#endif
+
+namespace mixr {
+namespace recorder {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Check the blocks of a block compressed file
+//------------------------------------------------------------------------------
+void checkBlocks(std::ifstream& sin, FileCheck* const check)
+{
+   BlockHeader hdr;
+   std::string data;
+   std::string raw;
+
+   bool done{};
+   while (!done) {
+      std::uint64_t skipped{};
+      const BlockStatus status{readNextBlock(sin, true, &hdr, &data, &skipped)};
+      if (skipped > 0) {
+         check->numDamaged++;
+         check->numDamagedBytes += skipped;
+      }
+
+      if (status == BlockStatus::VALID) {
+         const std::uint64_t end{static_cast<std::uint64_t>(sin.tellg())};
+
+         // decompress and check the record framing
+         bool ok{decompressBlock(hdr, data.data(), &raw)};
+         std::uint32_t cnt{};
+         if (ok) {
+            std::size_t pos{};
+            const char* rec{};
+            std::uint32_t n{};
+            while (nextRecord(raw, &pos, &rec, &n)) cnt++;
+            ok = (pos == raw.length() && cnt == hdr.numRecords);
+         }
+
+         if (ok) {
+            check->numBlocks++;
+            check->numRecords += cnt;
+            check->goodSize = end;
+         }
+         else {
+            check->numDamaged++;
+            check->numDamagedBytes += BLOCK_HEADER_SIZE + hdr.dataSize;
+         }
+      }
+      else done = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Check the records of a legacy file; the first bad size prefix or
+// incomplete record ends the check
+//------------------------------------------------------------------------------
+void checkRecords(std::ifstream& sin, FileCheck* const check)
+{
+   std::uint64_t pos{};
+   bool done{};
+   while (!done) {
+      char nbuff[8]{};
+      sin.read(nbuff, 4);
+      const std::streamsize n4{sin.gcount()};
+
+      // size prefix: an ascii number with leading spaces
+      int n{};
+      bool ok{n4 == 4};
+      for (int i = 0; i < 4 && ok; i++) {
+         if (nbuff[i] >= '0' && nbuff[i] <= '9') n = n * 10 + (nbuff[i] - '0');
+         else ok = (nbuff[i] == ' ' && n == 0);
+      }
+      ok = (ok && n > 0);
+
+      if (ok) {
+         sin.seekg(n, std::ios_base::cur);
+         ok = (pos + 4 + n <= check->fileSize);
+      }
+
+      if (ok) {
+         pos += 4 + n;
+         check->numRecords++;
+         check->goodSize = pos;
+      }
+      else {
+         if (n4 > 0) {
+            check->numDamaged++;
+            check->numDamagedBytes = check->fileSize - pos;
+         }
+         done = true;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Truncate a file
+//------------------------------------------------------------------------------
+bool truncateFile(const char* const filename, const std::uint64_t size)
+{
+#if defined(WIN32)
+   int fd{};
+   if (_sopen_s(&fd, filename, _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) return false;
+   const bool ok{_chsize_s(fd, static_cast<__int64>(size)) == 0};
+   _close(fd);
+   return ok;
+#else
+   return (::truncate(filename, static_cast<off_t>(size)) == 0);
+#endif
+}
+
+}
+
+//------------------------------------------------------------------------------
+// Check a data file
+//------------------------------------------------------------------------------
+bool checkRecorderFile(const char* const filename, FileCheck* const check)
+{
+   *check = FileCheck();
+
+   std::ifstream sin(filename, std::ios_base::in | std::ios_base::binary);
+   if (!sin.is_open()) return false;
+
+   sin.seekg(0, std::ios_base::end);
+   check->fileSize = static_cast<std::uint64_t>(sin.tellg());
+   sin.seekg(0);
+
+   char hbuff[BLOCK_FILE_HEADER_SIZE]{};
+   sin.read(hbuff, BLOCK_FILE_HEADER_SIZE);
+   check->blockFile = (sin.gcount() == BLOCK_FILE_HEADER_SIZE && isBlockFileHeader(hbuff));
+
+   if (check->blockFile) {
+      check->goodSize = BLOCK_FILE_HEADER_SIZE;
+      checkBlocks(sin, check);
+   }
+   else {
+      sin.clear();
+      sin.seekg(0);
+      checkRecords(sin, check);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Check and truncate a data file to its last good block or record
+//------------------------------------------------------------------------------
+bool recoverRecorderFile(const char* const filename, FileCheck* const check)
+{
+   bool ok{checkRecorderFile(filename, check)};
+   if (ok && check->goodSize < check->fileSize) {
+      ok = truncateFile(filename, check->goodSize);
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,45 @@
+
+#include "mixr/recorder/frame_utils.hpp"
+
+namespace mixr {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Frame encoder
+//------------------------------------------------------------------------------
+void encodeFrame(const std::uint32_t streamId, const std::uint32_t sequence, const RecordBlock& block, std::string* const frame)
+{
+   char buff[FRAME_HEADER_SIZE];
+   putU32(buff,      FRAME_MARKER);
+   putU32(buff + 4,  streamId);
+   putU32(buff + 8,  sequence);
+   putU32(buff + 12, block.numRecords);
+   putU32(buff + 16, static_cast<std::uint32_t>(block.raw.length()));
+   putF64(buff + 20, block.startTime);
+   putF64(buff + 28, block.endTime);
+   putU32(buff + 36, checksum(block.raw.data(), block.raw.length()));
+
+   frame->assign(buff, FRAME_HEADER_SIZE);
+   frame->append(block.raw);
+}
+
+//------------------------------------------------------------------------------
+// Frame decoder
+//------------------------------------------------------------------------------
+bool decodeFrame(const char* const buff, const std::size_t n, FrameHeader* const hdr)
+{
+   if (n < FRAME_HEADER_SIZE || getU32(buff) != FRAME_MARKER) return false;
+
+   hdr->streamId    = getU32(buff + 4);
+   hdr->sequence    = getU32(buff + 8);
+   hdr->numRecords  = getU32(buff + 12);
+   hdr->payloadSize = getU32(buff + 16);
+   hdr->startTime   = getF64(buff + 20);
+   hdr->endTime     = getF64(buff + 28);
+
+   if (hdr->payloadSize != n - FRAME_HEADER_SIZE) return false;
+   return (getU32(buff + 36) == checksum(buff + FRAME_HEADER_SIZE, hdr->payloadSize));
+}
+
+}
+}
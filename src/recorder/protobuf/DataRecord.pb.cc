@@ -1,12060 +1,12171 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
 // source: mixr/recorder/protobuf/DataRecord.proto
 
-#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 
 #include <algorithm>
 
-#include <google/protobuf/stubs/common.h>
-#include <google/protobuf/stubs/once.h>
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/reflection_ops.h>
 #include <google/protobuf/wire_format.h>
 // @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
 
 namespace mixr {
 namespace recorder {
 namespace pb {
-
-namespace {
-
-const ::google::protobuf::Descriptor* DataRecord_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  DataRecord_reflection_ = NULL;
-const ::google::protobuf::Descriptor* FileIdMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  FileIdMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* UnknownIdMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  UnknownIdMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* MarkerMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  MarkerMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* InputDeviceMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  InputDeviceMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* NewPlayerEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  NewPlayerEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerRemovedEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerRemovedEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerDataMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerDataMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerDamagedEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerDamagedEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerCollisionEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerCollisionEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerCrashEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerCrashEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerKilledEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerKilledEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* WeaponReleaseEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  WeaponReleaseEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* WeaponHungEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  WeaponHungEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* WeaponDetonationEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  WeaponDetonationEventMsg_reflection_ = NULL;
-const ::google::protobuf::EnumDescriptor* WeaponDetonationEventMsg_DetonationType_descriptor_ = NULL;
-const ::google::protobuf::Descriptor* GunFiredEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  GunFiredEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* NewTrackEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  NewTrackEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* TrackRemovedEventMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  TrackRemovedEventMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* TrackDataMsg_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  TrackDataMsg_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Vector_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Vector_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Time_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Time_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerId_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerId_reflection_ = NULL;
-const ::google::protobuf::Descriptor* PlayerState_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  PlayerState_reflection_ = NULL;
-const ::google::protobuf::Descriptor* TrackData_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  TrackData_reflection_ = NULL;
-const ::google::protobuf::Descriptor* EmissionData_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  EmissionData_reflection_ = NULL;
-const ::google::protobuf::EnumDescriptor* EmissionData_Polarization_descriptor_ = NULL;
-
-}  // namespace
-
-
-void protobuf_AssignDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto() {
-  protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  const ::google::protobuf::FileDescriptor* file =
-    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
-      "mixr/recorder/protobuf/DataRecord.proto");
-  GOOGLE_CHECK(file != NULL);
-  DataRecord_descriptor_ = file->message_type(0);
-  static const int DataRecord_offsets_[20] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, time_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, file_id_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, unknown_id_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, marker_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, input_device_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, new_player_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_removed_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_data_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_damaged_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_collision_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_crash_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, player_killed_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, weapon_release_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, weapon_hung_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, weapon_detonation_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, gun_fired_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, new_track_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, track_removed_event_msg_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, track_data_msg_),
+PROTOBUF_CONSTEXPR DataRecord::DataRecord(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.time_)*/nullptr
+  , /*decltype(_impl_.file_id_msg_)*/nullptr
+  , /*decltype(_impl_.unknown_id_msg_)*/nullptr
+  , /*decltype(_impl_.marker_msg_)*/nullptr
+  , /*decltype(_impl_.input_device_msg_)*/nullptr
+  , /*decltype(_impl_.new_player_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_removed_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_data_msg_)*/nullptr
+  , /*decltype(_impl_.player_damaged_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_collision_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_crash_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_killed_event_msg_)*/nullptr
+  , /*decltype(_impl_.player_frame_msg_)*/nullptr
+  , /*decltype(_impl_.weapon_release_event_msg_)*/nullptr
+  , /*decltype(_impl_.weapon_hung_event_msg_)*/nullptr
+  , /*decltype(_impl_.weapon_detonation_event_msg_)*/nullptr
+  , /*decltype(_impl_.gun_fired_event_msg_)*/nullptr
+  , /*decltype(_impl_.new_track_event_msg_)*/nullptr
+  , /*decltype(_impl_.track_removed_event_msg_)*/nullptr
+  , /*decltype(_impl_.track_data_msg_)*/nullptr
+  , /*decltype(_impl_.id_)*/0u} {}
+struct DataRecordDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR DataRecordDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~DataRecordDefaultTypeInternal() {}
+  union {
+    DataRecord _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DataRecordDefaultTypeInternal _DataRecord_default_instance_;
+PROTOBUF_CONSTEXPR FileIdMsg::FileIdMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.event_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.application_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.case_num_)*/0u
+  , /*decltype(_impl_.mission_num_)*/0u
+  , /*decltype(_impl_.subject_num_)*/0u
+  , /*decltype(_impl_.run_num_)*/0u
+  , /*decltype(_impl_.day_)*/0u
+  , /*decltype(_impl_.month_)*/0u
+  , /*decltype(_impl_.year_)*/0u} {}
+struct FileIdMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR FileIdMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~FileIdMsgDefaultTypeInternal() {}
+  union {
+    FileIdMsg _instance;
   };
-  DataRecord_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      DataRecord_descriptor_,
-      DataRecord::default_instance_,
-      DataRecord_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DataRecord, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(DataRecord));
-  FileIdMsg_descriptor_ = file->message_type(1);
-  static const int FileIdMsg_offsets_[9] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, event_name_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, application_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, case_num_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, mission_num_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, subject_num_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, run_num_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, day_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, month_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, year_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 FileIdMsgDefaultTypeInternal _FileIdMsg_default_instance_;
+PROTOBUF_CONSTEXPR UnknownIdMsg::UnknownIdMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/0u} {}
+struct UnknownIdMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR UnknownIdMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~UnknownIdMsgDefaultTypeInternal() {}
+  union {
+    UnknownIdMsg _instance;
   };
-  FileIdMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      FileIdMsg_descriptor_,
-      FileIdMsg::default_instance_,
-      FileIdMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(FileIdMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(FileIdMsg));
-  UnknownIdMsg_descriptor_ = file->message_type(2);
-  static const int UnknownIdMsg_offsets_[1] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(UnknownIdMsg, id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 UnknownIdMsgDefaultTypeInternal _UnknownIdMsg_default_instance_;
+PROTOBUF_CONSTEXPR MarkerMsg::MarkerMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/0u
+  , /*decltype(_impl_.source_id_)*/0u} {}
+struct MarkerMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MarkerMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MarkerMsgDefaultTypeInternal() {}
+  union {
+    MarkerMsg _instance;
   };
-  UnknownIdMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      UnknownIdMsg_descriptor_,
-      UnknownIdMsg::default_instance_,
-      UnknownIdMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(UnknownIdMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(UnknownIdMsg, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(UnknownIdMsg));
-  MarkerMsg_descriptor_ = file->message_type(3);
-  static const int MarkerMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(MarkerMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(MarkerMsg, source_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MarkerMsgDefaultTypeInternal _MarkerMsg_default_instance_;
+PROTOBUF_CONSTEXPR InputDeviceMsg::InputDeviceMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/0u
+  , /*decltype(_impl_.source_id_)*/0u
+  , /*decltype(_impl_.value_)*/0} {}
+struct InputDeviceMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR InputDeviceMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~InputDeviceMsgDefaultTypeInternal() {}
+  union {
+    InputDeviceMsg _instance;
   };
-  MarkerMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      MarkerMsg_descriptor_,
-      MarkerMsg::default_instance_,
-      MarkerMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(MarkerMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(MarkerMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(MarkerMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(MarkerMsg));
-  InputDeviceMsg_descriptor_ = file->message_type(4);
-  static const int InputDeviceMsg_offsets_[3] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, source_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, value_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 InputDeviceMsgDefaultTypeInternal _InputDeviceMsg_default_instance_;
+PROTOBUF_CONSTEXPR NewPlayerEventMsg::NewPlayerEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr} {}
+struct NewPlayerEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR NewPlayerEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~NewPlayerEventMsgDefaultTypeInternal() {}
+  union {
+    NewPlayerEventMsg _instance;
   };
-  InputDeviceMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      InputDeviceMsg_descriptor_,
-      InputDeviceMsg::default_instance_,
-      InputDeviceMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(InputDeviceMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(InputDeviceMsg));
-  NewPlayerEventMsg_descriptor_ = file->message_type(5);
-  static const int NewPlayerEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewPlayerEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewPlayerEventMsg, state_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 NewPlayerEventMsgDefaultTypeInternal _NewPlayerEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerRemovedEventMsg::PlayerRemovedEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr} {}
+struct PlayerRemovedEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerRemovedEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerRemovedEventMsgDefaultTypeInternal() {}
+  union {
+    PlayerRemovedEventMsg _instance;
   };
-  NewPlayerEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      NewPlayerEventMsg_descriptor_,
-      NewPlayerEventMsg::default_instance_,
-      NewPlayerEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewPlayerEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewPlayerEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewPlayerEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(NewPlayerEventMsg));
-  PlayerRemovedEventMsg_descriptor_ = file->message_type(6);
-  static const int PlayerRemovedEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerRemovedEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerRemovedEventMsg, state_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerRemovedEventMsgDefaultTypeInternal _PlayerRemovedEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerDataMsg::PlayerDataMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr
+  , /*decltype(_impl_.alpha_)*/0
+  , /*decltype(_impl_.beta_)*/0
+  , /*decltype(_impl_.cas_)*/0} {}
+struct PlayerDataMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerDataMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerDataMsgDefaultTypeInternal() {}
+  union {
+    PlayerDataMsg _instance;
   };
-  PlayerRemovedEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerRemovedEventMsg_descriptor_,
-      PlayerRemovedEventMsg::default_instance_,
-      PlayerRemovedEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerRemovedEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerRemovedEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerRemovedEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerRemovedEventMsg));
-  PlayerDataMsg_descriptor_ = file->message_type(7);
-  static const int PlayerDataMsg_offsets_[5] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, alpha_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, beta_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, cas_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerDataMsgDefaultTypeInternal _PlayerDataMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerDamagedEventMsg::PlayerDamagedEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr} {}
+struct PlayerDamagedEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerDamagedEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerDamagedEventMsgDefaultTypeInternal() {}
+  union {
+    PlayerDamagedEventMsg _instance;
   };
-  PlayerDataMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerDataMsg_descriptor_,
-      PlayerDataMsg::default_instance_,
-      PlayerDataMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDataMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerDataMsg));
-  PlayerDamagedEventMsg_descriptor_ = file->message_type(8);
-  static const int PlayerDamagedEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDamagedEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDamagedEventMsg, state_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerDamagedEventMsgDefaultTypeInternal _PlayerDamagedEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerCollisionEventMsg::PlayerCollisionEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr
+  , /*decltype(_impl_.other_player_id_)*/nullptr} {}
+struct PlayerCollisionEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerCollisionEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerCollisionEventMsgDefaultTypeInternal() {}
+  union {
+    PlayerCollisionEventMsg _instance;
   };
-  PlayerDamagedEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerDamagedEventMsg_descriptor_,
-      PlayerDamagedEventMsg::default_instance_,
-      PlayerDamagedEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDamagedEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDamagedEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerDamagedEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerDamagedEventMsg));
-  PlayerCollisionEventMsg_descriptor_ = file->message_type(9);
-  static const int PlayerCollisionEventMsg_offsets_[3] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, other_player_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerCollisionEventMsgDefaultTypeInternal _PlayerCollisionEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerCrashEventMsg::PlayerCrashEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr} {}
+struct PlayerCrashEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerCrashEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerCrashEventMsgDefaultTypeInternal() {}
+  union {
+    PlayerCrashEventMsg _instance;
   };
-  PlayerCollisionEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerCollisionEventMsg_descriptor_,
-      PlayerCollisionEventMsg::default_instance_,
-      PlayerCollisionEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCollisionEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerCollisionEventMsg));
-  PlayerCrashEventMsg_descriptor_ = file->message_type(10);
-  static const int PlayerCrashEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCrashEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCrashEventMsg, state_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerCrashEventMsgDefaultTypeInternal _PlayerCrashEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerKilledEventMsg::PlayerKilledEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/nullptr
+  , /*decltype(_impl_.state_)*/nullptr
+  , /*decltype(_impl_.shooter_id_)*/nullptr} {}
+struct PlayerKilledEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerKilledEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerKilledEventMsgDefaultTypeInternal() {}
+  union {
+    PlayerKilledEventMsg _instance;
   };
-  PlayerCrashEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerCrashEventMsg_descriptor_,
-      PlayerCrashEventMsg::default_instance_,
-      PlayerCrashEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCrashEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCrashEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerCrashEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerCrashEventMsg));
-  PlayerKilledEventMsg_descriptor_ = file->message_type(11);
-  static const int PlayerKilledEventMsg_offsets_[3] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, shooter_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerKilledEventMsgDefaultTypeInternal _PlayerKilledEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR PlayerFrameMsg::PlayerFrameMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_.id_)*/{}
+  , /*decltype(_impl_._id_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.federate_)*/{}
+  , /*decltype(_impl_._federate_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.pos_)*/{}
+  , /*decltype(_impl_.vel_)*/{}
+  , /*decltype(_impl_.angles_)*/{}
+  , /*decltype(_impl_.mode_)*/{}
+  , /*decltype(_impl_._mode_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.federates_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct PlayerFrameMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerFrameMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerFrameMsgDefaultTypeInternal() {}
+  union {
+    PlayerFrameMsg _instance;
   };
-  PlayerKilledEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerKilledEventMsg_descriptor_,
-      PlayerKilledEventMsg::default_instance_,
-      PlayerKilledEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerKilledEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerKilledEventMsg));
-  WeaponReleaseEventMsg_descriptor_ = file->message_type(12);
-  static const int WeaponReleaseEventMsg_offsets_[4] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, wpn_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, wpn_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, shooter_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, tgt_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerFrameMsgDefaultTypeInternal _PlayerFrameMsg_default_instance_;
+PROTOBUF_CONSTEXPR WeaponReleaseEventMsg::WeaponReleaseEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.wpn_id_)*/nullptr
+  , /*decltype(_impl_.wpn_state_)*/nullptr
+  , /*decltype(_impl_.shooter_id_)*/nullptr
+  , /*decltype(_impl_.tgt_id_)*/nullptr} {}
+struct WeaponReleaseEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR WeaponReleaseEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~WeaponReleaseEventMsgDefaultTypeInternal() {}
+  union {
+    WeaponReleaseEventMsg _instance;
   };
-  WeaponReleaseEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      WeaponReleaseEventMsg_descriptor_,
-      WeaponReleaseEventMsg::default_instance_,
-      WeaponReleaseEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponReleaseEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(WeaponReleaseEventMsg));
-  WeaponHungEventMsg_descriptor_ = file->message_type(13);
-  static const int WeaponHungEventMsg_offsets_[4] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, wpn_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, wpn_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, shooter_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, tgt_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 WeaponReleaseEventMsgDefaultTypeInternal _WeaponReleaseEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR WeaponHungEventMsg::WeaponHungEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.wpn_id_)*/nullptr
+  , /*decltype(_impl_.wpn_state_)*/nullptr
+  , /*decltype(_impl_.shooter_id_)*/nullptr
+  , /*decltype(_impl_.tgt_id_)*/nullptr} {}
+struct WeaponHungEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR WeaponHungEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~WeaponHungEventMsgDefaultTypeInternal() {}
+  union {
+    WeaponHungEventMsg _instance;
   };
-  WeaponHungEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      WeaponHungEventMsg_descriptor_,
-      WeaponHungEventMsg::default_instance_,
-      WeaponHungEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponHungEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(WeaponHungEventMsg));
-  WeaponDetonationEventMsg_descriptor_ = file->message_type(14);
-  static const int WeaponDetonationEventMsg_offsets_[6] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, wpn_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, wpn_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, shooter_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, tgt_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, det_type_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, miss_dist_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 WeaponHungEventMsgDefaultTypeInternal _WeaponHungEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR WeaponDetonationEventMsg::WeaponDetonationEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.wpn_id_)*/nullptr
+  , /*decltype(_impl_.wpn_state_)*/nullptr
+  , /*decltype(_impl_.shooter_id_)*/nullptr
+  , /*decltype(_impl_.tgt_id_)*/nullptr
+  , /*decltype(_impl_.miss_dist_)*/0
+  , /*decltype(_impl_.det_type_)*/0} {}
+struct WeaponDetonationEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR WeaponDetonationEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~WeaponDetonationEventMsgDefaultTypeInternal() {}
+  union {
+    WeaponDetonationEventMsg _instance;
   };
-  WeaponDetonationEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      WeaponDetonationEventMsg_descriptor_,
-      WeaponDetonationEventMsg::default_instance_,
-      WeaponDetonationEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WeaponDetonationEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(WeaponDetonationEventMsg));
-  WeaponDetonationEventMsg_DetonationType_descriptor_ = WeaponDetonationEventMsg_descriptor_->enum_type(0);
-  GunFiredEventMsg_descriptor_ = file->message_type(15);
-  static const int GunFiredEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GunFiredEventMsg, shooter_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GunFiredEventMsg, rounds_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 WeaponDetonationEventMsgDefaultTypeInternal _WeaponDetonationEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR GunFiredEventMsg::GunFiredEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.shooter_id_)*/nullptr
+  , /*decltype(_impl_.rounds_)*/0u} {}
+struct GunFiredEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GunFiredEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GunFiredEventMsgDefaultTypeInternal() {}
+  union {
+    GunFiredEventMsg _instance;
   };
-  GunFiredEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      GunFiredEventMsg_descriptor_,
-      GunFiredEventMsg::default_instance_,
-      GunFiredEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GunFiredEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GunFiredEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GunFiredEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(GunFiredEventMsg));
-  NewTrackEventMsg_descriptor_ = file->message_type(16);
-  static const int NewTrackEventMsg_offsets_[7] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, player_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, track_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, track_data_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, player_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, trk_player_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, trk_player_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, emission_data_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GunFiredEventMsgDefaultTypeInternal _GunFiredEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR NewTrackEventMsg::NewTrackEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.track_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.player_id_)*/nullptr
+  , /*decltype(_impl_.track_data_)*/nullptr
+  , /*decltype(_impl_.player_state_)*/nullptr
+  , /*decltype(_impl_.trk_player_id_)*/nullptr
+  , /*decltype(_impl_.trk_player_state_)*/nullptr
+  , /*decltype(_impl_.emission_data_)*/nullptr} {}
+struct NewTrackEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR NewTrackEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~NewTrackEventMsgDefaultTypeInternal() {}
+  union {
+    NewTrackEventMsg _instance;
   };
-  NewTrackEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      NewTrackEventMsg_descriptor_,
-      NewTrackEventMsg::default_instance_,
-      NewTrackEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(NewTrackEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(NewTrackEventMsg));
-  TrackRemovedEventMsg_descriptor_ = file->message_type(17);
-  static const int TrackRemovedEventMsg_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackRemovedEventMsg, player_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackRemovedEventMsg, track_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 NewTrackEventMsgDefaultTypeInternal _NewTrackEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR TrackRemovedEventMsg::TrackRemovedEventMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.track_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.player_id_)*/nullptr} {}
+struct TrackRemovedEventMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TrackRemovedEventMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TrackRemovedEventMsgDefaultTypeInternal() {}
+  union {
+    TrackRemovedEventMsg _instance;
   };
-  TrackRemovedEventMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      TrackRemovedEventMsg_descriptor_,
-      TrackRemovedEventMsg::default_instance_,
-      TrackRemovedEventMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackRemovedEventMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackRemovedEventMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackRemovedEventMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(TrackRemovedEventMsg));
-  TrackDataMsg_descriptor_ = file->message_type(18);
-  static const int TrackDataMsg_offsets_[7] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, player_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, track_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, track_data_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, player_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, trk_player_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, trk_player_state_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, emission_data_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TrackRemovedEventMsgDefaultTypeInternal _TrackRemovedEventMsg_default_instance_;
+PROTOBUF_CONSTEXPR TrackDataMsg::TrackDataMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.track_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.player_id_)*/nullptr
+  , /*decltype(_impl_.track_data_)*/nullptr
+  , /*decltype(_impl_.player_state_)*/nullptr
+  , /*decltype(_impl_.trk_player_id_)*/nullptr
+  , /*decltype(_impl_.trk_player_state_)*/nullptr
+  , /*decltype(_impl_.emission_data_)*/nullptr} {}
+struct TrackDataMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TrackDataMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TrackDataMsgDefaultTypeInternal() {}
+  union {
+    TrackDataMsg _instance;
   };
-  TrackDataMsg_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      TrackDataMsg_descriptor_,
-      TrackDataMsg::default_instance_,
-      TrackDataMsg_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackDataMsg, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(TrackDataMsg));
-  Vector_descriptor_ = file->message_type(19);
-  static const int Vector_offsets_[4] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, x_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, y_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, z_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, w_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TrackDataMsgDefaultTypeInternal _TrackDataMsg_default_instance_;
+PROTOBUF_CONSTEXPR Vector::Vector(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.x_)*/0
+  , /*decltype(_impl_.y_)*/0
+  , /*decltype(_impl_.z_)*/0
+  , /*decltype(_impl_.w_)*/0} {}
+struct VectorDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR VectorDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~VectorDefaultTypeInternal() {}
+  union {
+    Vector _instance;
   };
-  Vector_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Vector_descriptor_,
-      Vector::default_instance_,
-      Vector_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Vector, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Vector));
-  Time_descriptor_ = file->message_type(20);
-  static const int Time_offsets_[3] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, sim_time_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, exec_time_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, utc_time_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 VectorDefaultTypeInternal _Vector_default_instance_;
+PROTOBUF_CONSTEXPR Time::Time(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.sim_time_)*/0
+  , /*decltype(_impl_.exec_time_)*/0
+  , /*decltype(_impl_.utc_time_)*/0} {}
+struct TimeDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TimeDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TimeDefaultTypeInternal() {}
+  union {
+    Time _instance;
   };
-  Time_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Time_descriptor_,
-      Time::default_instance_,
-      Time_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Time, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Time));
-  PlayerId_descriptor_ = file->message_type(21);
-  static const int PlayerId_offsets_[6] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, name_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, fed_name_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, side_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, major_type_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, ac_type_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TimeDefaultTypeInternal _Time_default_instance_;
+PROTOBUF_CONSTEXPR PlayerId::PlayerId(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.fed_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.ac_type_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.id_)*/0u
+  , /*decltype(_impl_.side_)*/0u
+  , /*decltype(_impl_.major_type_)*/0u} {}
+struct PlayerIdDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerIdDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerIdDefaultTypeInternal() {}
+  union {
+    PlayerId _instance;
   };
-  PlayerId_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerId_descriptor_,
-      PlayerId::default_instance_,
-      PlayerId_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerId, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerId));
-  PlayerState_descriptor_ = file->message_type(22);
-  static const int PlayerState_offsets_[4] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, pos_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, angles_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, vel_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, damage_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerIdDefaultTypeInternal _PlayerId_default_instance_;
+PROTOBUF_CONSTEXPR PlayerState::PlayerState(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.pos_)*/nullptr
+  , /*decltype(_impl_.angles_)*/nullptr
+  , /*decltype(_impl_.vel_)*/nullptr
+  , /*decltype(_impl_.damage_)*/0} {}
+struct PlayerStateDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlayerStateDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlayerStateDefaultTypeInternal() {}
+  union {
+    PlayerState _instance;
   };
-  PlayerState_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      PlayerState_descriptor_,
-      PlayerState::default_instance_,
-      PlayerState_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PlayerState, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(PlayerState));
-  TrackData_descriptor_ = file->message_type(23);
-  static const int TrackData_offsets_[14] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, type_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, quality_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, true_az_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, rel_az_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, elevation_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, range_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, latitude_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, longitude_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, altitude_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, position_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, velocity_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, avg_signal_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, sl_index_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, wpn_rel_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerStateDefaultTypeInternal _PlayerState_default_instance_;
+PROTOBUF_CONSTEXPR TrackData::TrackData(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.position_)*/nullptr
+  , /*decltype(_impl_.velocity_)*/nullptr
+  , /*decltype(_impl_.quality_)*/0
+  , /*decltype(_impl_.true_az_)*/0
+  , /*decltype(_impl_.rel_az_)*/0
+  , /*decltype(_impl_.elevation_)*/0
+  , /*decltype(_impl_.range_)*/0
+  , /*decltype(_impl_.latitude_)*/0
+  , /*decltype(_impl_.type_)*/0u
+  , /*decltype(_impl_.sl_index_)*/0u
+  , /*decltype(_impl_.longitude_)*/0
+  , /*decltype(_impl_.altitude_)*/0
+  , /*decltype(_impl_.avg_signal_)*/0
+  , /*decltype(_impl_.wpn_rel_)*/false} {}
+struct TrackDataDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TrackDataDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TrackDataDefaultTypeInternal() {}
+  union {
+    TrackData _instance;
   };
-  TrackData_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      TrackData_descriptor_,
-      TrackData::default_instance_,
-      TrackData_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TrackData, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(TrackData));
-  EmissionData_descriptor_ = file->message_type(24);
-  static const int EmissionData_offsets_[11] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, frequency_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, wave_length_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, pulse_width_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, bandwidth_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, prf_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, power_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, polarization_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, azimuth_aoi_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, elevation_aoi_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, origin_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, target_id_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TrackDataDefaultTypeInternal _TrackData_default_instance_;
+PROTOBUF_CONSTEXPR EmissionData::EmissionData(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._extensions_)*/{}
+  , /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.origin_id_)*/nullptr
+  , /*decltype(_impl_.target_id_)*/nullptr
+  , /*decltype(_impl_.frequency_)*/0
+  , /*decltype(_impl_.wave_length_)*/0
+  , /*decltype(_impl_.pulse_width_)*/0
+  , /*decltype(_impl_.bandwidth_)*/0
+  , /*decltype(_impl_.prf_)*/0
+  , /*decltype(_impl_.power_)*/0
+  , /*decltype(_impl_.azimuth_aoi_)*/0
+  , /*decltype(_impl_.elevation_aoi_)*/0
+  , /*decltype(_impl_.polarization_)*/0} {}
+struct EmissionDataDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR EmissionDataDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~EmissionDataDefaultTypeInternal() {}
+  union {
+    EmissionData _instance;
   };
-  EmissionData_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      EmissionData_descriptor_,
-      EmissionData::default_instance_,
-      EmissionData_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, _unknown_fields_),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EmissionData, _extensions_),
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(EmissionData));
-  EmissionData_Polarization_descriptor_ = EmissionData_descriptor_->enum_type(0);
-}
-
-namespace {
-
-GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
-inline void protobuf_AssignDescriptorsOnce() {
-  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
-                 &protobuf_AssignDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto);
-}
-
-void protobuf_RegisterTypes(const ::std::string&) {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    DataRecord_descriptor_, &DataRecord::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    FileIdMsg_descriptor_, &FileIdMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    UnknownIdMsg_descriptor_, &UnknownIdMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    MarkerMsg_descriptor_, &MarkerMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    InputDeviceMsg_descriptor_, &InputDeviceMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    NewPlayerEventMsg_descriptor_, &NewPlayerEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerRemovedEventMsg_descriptor_, &PlayerRemovedEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerDataMsg_descriptor_, &PlayerDataMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerDamagedEventMsg_descriptor_, &PlayerDamagedEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerCollisionEventMsg_descriptor_, &PlayerCollisionEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerCrashEventMsg_descriptor_, &PlayerCrashEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerKilledEventMsg_descriptor_, &PlayerKilledEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    WeaponReleaseEventMsg_descriptor_, &WeaponReleaseEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    WeaponHungEventMsg_descriptor_, &WeaponHungEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    WeaponDetonationEventMsg_descriptor_, &WeaponDetonationEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    GunFiredEventMsg_descriptor_, &GunFiredEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    NewTrackEventMsg_descriptor_, &NewTrackEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    TrackRemovedEventMsg_descriptor_, &TrackRemovedEventMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    TrackDataMsg_descriptor_, &TrackDataMsg::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Vector_descriptor_, &Vector::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Time_descriptor_, &Time::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerId_descriptor_, &PlayerId::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    PlayerState_descriptor_, &PlayerState::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    TrackData_descriptor_, &TrackData::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    EmissionData_descriptor_, &EmissionData::default_instance());
-}
-
-}  // namespace
-
-void protobuf_ShutdownFile_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto() {
-  delete DataRecord::default_instance_;
-  delete DataRecord_reflection_;
-  delete FileIdMsg::default_instance_;
-  delete FileIdMsg_reflection_;
-  delete UnknownIdMsg::default_instance_;
-  delete UnknownIdMsg_reflection_;
-  delete MarkerMsg::default_instance_;
-  delete MarkerMsg_reflection_;
-  delete InputDeviceMsg::default_instance_;
-  delete InputDeviceMsg_reflection_;
-  delete NewPlayerEventMsg::default_instance_;
-  delete NewPlayerEventMsg_reflection_;
-  delete PlayerRemovedEventMsg::default_instance_;
-  delete PlayerRemovedEventMsg_reflection_;
-  delete PlayerDataMsg::default_instance_;
-  delete PlayerDataMsg_reflection_;
-  delete PlayerDamagedEventMsg::default_instance_;
-  delete PlayerDamagedEventMsg_reflection_;
-  delete PlayerCollisionEventMsg::default_instance_;
-  delete PlayerCollisionEventMsg_reflection_;
-  delete PlayerCrashEventMsg::default_instance_;
-  delete PlayerCrashEventMsg_reflection_;
-  delete PlayerKilledEventMsg::default_instance_;
-  delete PlayerKilledEventMsg_reflection_;
-  delete WeaponReleaseEventMsg::default_instance_;
-  delete WeaponReleaseEventMsg_reflection_;
-  delete WeaponHungEventMsg::default_instance_;
-  delete WeaponHungEventMsg_reflection_;
-  delete WeaponDetonationEventMsg::default_instance_;
-  delete WeaponDetonationEventMsg_reflection_;
-  delete GunFiredEventMsg::default_instance_;
-  delete GunFiredEventMsg_reflection_;
-  delete NewTrackEventMsg::default_instance_;
-  delete NewTrackEventMsg_reflection_;
-  delete TrackRemovedEventMsg::default_instance_;
-  delete TrackRemovedEventMsg_reflection_;
-  delete TrackDataMsg::default_instance_;
-  delete TrackDataMsg_reflection_;
-  delete Vector::default_instance_;
-  delete Vector_reflection_;
-  delete Time::default_instance_;
-  delete Time_reflection_;
-  delete PlayerId::default_instance_;
-  delete PlayerId_reflection_;
-  delete PlayerState::default_instance_;
-  delete PlayerState_reflection_;
-  delete TrackData::default_instance_;
-  delete TrackData_reflection_;
-  delete EmissionData::default_instance_;
-  delete EmissionData_reflection_;
-}
-
-void protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto() {
-  static bool already_here = false;
-  if (already_here) return;
-  already_here = true;
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-    "\n\'mixr/recorder/protobuf/DataRecord.prot"
-    "o\022\020mixr.recorder.pb\"\373\t\n\nDataRecord\022$\n\004ti"
-    "me\030\001 \002(\0132\026.mixr.recorder.pb.Time\022\n\n\002id\030\002"
-    " \002(\r\0220\n\013file_id_msg\030\013 \001(\0132\033.mixr.recorde"
-    "r.pb.FileIdMsg\0226\n\016unknown_id_msg\030\r \001(\0132\036"
-    ".mixr.recorder.pb.UnknownIdMsg\022/\n\nmarker"
-    "_msg\030\016 \001(\0132\033.mixr.recorder.pb.MarkerMsg\022"
-    ":\n\020input_device_msg\030\017 \001(\0132 .mixr.recorde"
-    "r.pb.InputDeviceMsg\022A\n\024new_player_event_"
-    "msg\030\037 \001(\0132#.mixr.recorder.pb.NewPlayerEv"
-    "entMsg\022I\n\030player_removed_event_msg\030  \001(\013"
-    "2\'.mixr.recorder.pb.PlayerRemovedEventMs"
-    "g\0228\n\017player_data_msg\030! \001(\0132\037.mixr.record"
-    "er.pb.PlayerDataMsg\022I\n\030player_damaged_ev"
-    "ent_msg\030\" \001(\0132\'.mixr.recorder.pb.PlayerD"
-    "amagedEventMsg\022M\n\032player_collision_event"
-    "_msg\030# \001(\0132).mixr.recorder.pb.PlayerColl"
-    "isionEventMsg\022E\n\026player_crash_event_msg\030"
-    "$ \001(\0132%.mixr.recorder.pb.PlayerCrashEven"
-    "tMsg\022G\n\027player_killed_event_msg\030% \001(\0132&."
-    "mixr.recorder.pb.PlayerKilledEventMsg\022I\n"
-    "\030weapon_release_event_msg\0303 \001(\0132\'.mixr.r"
-    "ecorder.pb.WeaponReleaseEventMsg\022C\n\025weap"
-    "on_hung_event_msg\0304 \001(\0132$.mixr.recorder."
-    "pb.WeaponHungEventMsg\022O\n\033weapon_detonati"
-    "on_event_msg\0305 \001(\0132*.mixr.recorder.pb.We"
-    "aponDetonationEventMsg\022\?\n\023gun_fired_even"
-    "t_msg\0306 \001(\0132\".mixr.recorder.pb.GunFiredE"
-    "ventMsg\022\?\n\023new_track_event_msg\030G \001(\0132\".m"
-    "ixr.recorder.pb.NewTrackEventMsg\022G\n\027trac"
-    "k_removed_event_msg\030H \001(\0132&.mixr.recorde"
-    "r.pb.TrackRemovedEventMsg\0226\n\016track_data_"
-    "msg\030I \001(\0132\036.mixr.recorder.pb.TrackDataMs"
-    "g*\006\010\364\003\020\350\007*\006\010\350\007\020\220N\"\270\001\n\tFileIdMsg\022\022\n\nevent"
-    "_name\030\001 \001(\t\022\023\n\013application\030\002 \001(\t\022\020\n\010case"
-    "_num\030\003 \001(\r\022\023\n\013mission_num\030\004 \001(\r\022\023\n\013subje"
-    "ct_num\030\005 \001(\r\022\017\n\007run_num\030\006 \001(\r\022\013\n\003day\030\007 \001"
-    "(\r\022\r\n\005month\030\010 \001(\r\022\014\n\004year\030\t \001(\r*\004\0102\020d*\005\010"
-    "d\020\350\007\"\032\n\014UnknownIdMsg\022\n\n\002id\030\001 \002(\r\"7\n\tMark"
-    "erMsg\022\n\n\002id\030\001 \001(\r\022\021\n\tsource_id\030\002 \001(\r*\004\0102"
-    "\020d*\005\010d\020\350\007\"K\n\016InputDeviceMsg\022\n\n\002id\030\001 \002(\r\022"
-    "\021\n\tsource_id\030\002 \001(\r\022\r\n\005value\030\003 \001(\002*\004\0102\020d*"
-    "\005\010d\020\350\007\"v\n\021NewPlayerEventMsg\022&\n\002id\030\001 \002(\0132"
-    "\032.mixr.recorder.pb.PlayerId\022,\n\005state\030\002 \002"
-    "(\0132\035.mixr.recorder.pb.PlayerState*\004\0102\020d*"
-    "\005\010d\020\350\007\"z\n\025PlayerRemovedEventMsg\022&\n\002id\030\001 "
-    "\002(\0132\032.mixr.recorder.pb.PlayerId\022,\n\005state"
-    "\030\002 \001(\0132\035.mixr.recorder.pb.PlayerState*\004\010"
-    "2\020d*\005\010d\020\350\007\"\234\001\n\rPlayerDataMsg\022&\n\002id\030\001 \002(\013"
-    "2\032.mixr.recorder.pb.PlayerId\022,\n\005state\030\002 "
-    "\002(\0132\035.mixr.recorder.pb.PlayerState\022\r\n\005al"
-    "pha\030\003 \001(\001\022\014\n\004beta\030\004 \001(\001\022\013\n\003cas\030\005 \001(\001*\004\0102"
-    "\020d*\005\010d\020\350\007\"z\n\025PlayerDamagedEventMsg\022&\n\002id"
-    "\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId\022,\n\005st"
-    "ate\030\002 \001(\0132\035.mixr.recorder.pb.PlayerState"
-    "*\004\0102\020d*\005\010d\020\350\007\"\261\001\n\027PlayerCollisionEventMs"
-    "g\022&\n\002id\030\001 \002(\0132\032.mixr.recorder.pb.PlayerI"
-    "d\022,\n\005state\030\002 \001(\0132\035.mixr.recorder.pb.Play"
-    "erState\0223\n\017other_player_id\030\003 \001(\0132\032.mixr."
-    "recorder.pb.PlayerId*\004\0102\020d*\005\010d\020\350\007\"x\n\023Pla"
-    "yerCrashEventMsg\022&\n\002id\030\001 \002(\0132\032.mixr.reco"
-    "rder.pb.PlayerId\022,\n\005state\030\002 \001(\0132\035.mixr.r"
-    "ecorder.pb.PlayerState*\004\0102\020d*\005\010d\020\350\007\"\251\001\n\024"
-    "PlayerKilledEventMsg\022&\n\002id\030\001 \002(\0132\032.mixr."
-    "recorder.pb.PlayerId\022,\n\005state\030\002 \001(\0132\035.mi"
-    "xr.recorder.pb.PlayerState\022.\n\nshooter_id"
-    "\030\003 \001(\0132\032.mixr.recorder.pb.PlayerId*\004\0102\020d"
-    "*\005\010d\020\350\007\"\336\001\n\025WeaponReleaseEventMsg\022*\n\006wpn"
-    "_id\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId\0220\n"
-    "\twpn_state\030\002 \001(\0132\035.mixr.recorder.pb.Play"
-    "erState\022.\n\nshooter_id\030\003 \001(\0132\032.mixr.recor"
-    "der.pb.PlayerId\022*\n\006tgt_id\030\004 \001(\0132\032.mixr.r"
-    "ecorder.pb.PlayerId*\004\0102\020d*\005\010d\020\350\007\"\333\001\n\022Wea"
-    "ponHungEventMsg\022*\n\006wpn_id\030\001 \002(\0132\032.mixr.r"
-    "ecorder.pb.PlayerId\0220\n\twpn_state\030\002 \001(\0132\035"
-    ".mixr.recorder.pb.PlayerState\022.\n\nshooter"
-    "_id\030\003 \001(\0132\032.mixr.recorder.pb.PlayerId\022*\n"
-    "\006tgt_id\030\004 \001(\0132\032.mixr.recorder.pb.PlayerI"
-    "d*\004\0102\020d*\005\010d\020\350\007\"\240\004\n\030WeaponDetonationEvent"
-    "Msg\022*\n\006wpn_id\030\001 \002(\0132\032.mixr.recorder.pb.P"
-    "layerId\0220\n\twpn_state\030\002 \001(\0132\035.mixr.record"
-    "er.pb.PlayerState\022.\n\nshooter_id\030\003 \001(\0132\032."
-    "mixr.recorder.pb.PlayerId\022*\n\006tgt_id\030\004 \001("
-    "\0132\032.mixr.recorder.pb.PlayerId\022K\n\010det_typ"
-    "e\030\005 \001(\01629.mixr.recorder.pb.WeaponDetonat"
-    "ionEventMsg.DetonationType\022\021\n\tmiss_dist\030"
-    "\006 \001(\001\"\334\001\n\016DetonationType\022\022\n\016DETONATE_OTH"
-    "ER\020\000\022\032\n\026DETONATE_ENTITY_IMPACT\020\001\022(\n$DETO"
-    "NATE_ENTITY_PROXIMATE_DETONATION\020\002\022\032\n\026DE"
-    "TONATE_GROUND_IMPACT\020\003\022(\n$DETONATE_GROUN"
-    "D_PROXIMATE_DETONATION\020\004\022\027\n\023DETONATE_DET"
-    "ONATION\020\005\022\021\n\rDETONATE_NONE\020\006*\004\0102\020d*\005\010d\020\350"
-    "\007\"_\n\020GunFiredEventMsg\022.\n\nshooter_id\030\001 \002("
-    "\0132\032.mixr.recorder.pb.PlayerId\022\016\n\006rounds\030"
-    "\002 \001(\r*\004\0102\020d*\005\010d\020\350\007\"\351\002\n\020NewTrackEventMsg\022"
-    "-\n\tplayer_id\030\001 \002(\0132\032.mixr.recorder.pb.Pl"
-    "ayerId\022\020\n\010track_id\030\002 \002(\t\022/\n\ntrack_data\030\003"
-    " \001(\0132\033.mixr.recorder.pb.TrackData\0223\n\014pla"
-    "yer_state\030\004 \001(\0132\035.mixr.recorder.pb.Playe"
-    "rState\0221\n\rtrk_player_id\030\005 \001(\0132\032.mixr.rec"
-    "order.pb.PlayerId\0227\n\020trk_player_state\030\006 "
-    "\001(\0132\035.mixr.recorder.pb.PlayerState\0225\n\rem"
-    "ission_data\030\007 \001(\0132\036.mixr.recorder.pb.Emi"
-    "ssionData*\004\0102\020d*\005\010d\020\350\007\"d\n\024TrackRemovedEv"
-    "entMsg\022-\n\tplayer_id\030\001 \002(\0132\032.mixr.recorde"
-    "r.pb.PlayerId\022\020\n\010track_id\030\002 \002(\t*\004\0102\020d*\005\010"
-    "d\020\350\007\"\345\002\n\014TrackDataMsg\022-\n\tplayer_id\030\001 \002(\013"
-    "2\032.mixr.recorder.pb.PlayerId\022\020\n\010track_id"
-    "\030\002 \002(\t\022/\n\ntrack_data\030\003 \001(\0132\033.mixr.record"
-    "er.pb.TrackData\0223\n\014player_state\030\004 \001(\0132\035."
-    "mixr.recorder.pb.PlayerState\0221\n\rtrk_play"
-    "er_id\030\005 \001(\0132\032.mixr.recorder.pb.PlayerId\022"
-    "7\n\020trk_player_state\030\006 \001(\0132\035.mixr.recorde"
-    "r.pb.PlayerState\0225\n\remission_data\030\007 \001(\0132"
-    "\036.mixr.recorder.pb.EmissionData*\004\0102\020d*\005\010"
-    "d\020\350\007\"4\n\006Vector\022\t\n\001x\030\001 \002(\001\022\t\n\001y\030\002 \002(\001\022\t\n\001"
-    "z\030\003 \001(\001\022\t\n\001w\030\004 \001(\001\"J\n\004Time\022\020\n\010sim_time\030\001"
-    " \002(\001\022\021\n\texec_time\030\002 \001(\001\022\020\n\010utc_time\030\003 \001("
-    "\001*\004\0102\020d*\005\010d\020\350\007\"v\n\010PlayerId\022\n\n\002id\030\001 \002(\r\022\014"
-    "\n\004name\030\002 \001(\t\022\020\n\010fed_name\030\003 \001(\t\022\014\n\004side\030\004"
-    " \001(\r\022\022\n\nmajor_type\030\005 \001(\r\022\017\n\007ac_type\030\006 \001("
-    "\t*\004\0102\020d*\005\010d\020\350\007\"\242\001\n\013PlayerState\022%\n\003pos\030\001 "
-    "\002(\0132\030.mixr.recorder.pb.Vector\022(\n\006angles\030"
-    "\002 \002(\0132\030.mixr.recorder.pb.Vector\022%\n\003vel\030\003"
-    " \001(\0132\030.mixr.recorder.pb.Vector\022\016\n\006damage"
-    "\030\004 \001(\001*\004\0102\020d*\005\010d\020\350\007\"\300\002\n\tTrackData\022\014\n\004typ"
-    "e\030\001 \001(\r\022\017\n\007quality\030\002 \001(\001\022\017\n\007true_az\030\003 \001("
-    "\001\022\016\n\006rel_az\030\004 \001(\001\022\021\n\televation\030\005 \001(\001\022\r\n\005"
-    "range\030\006 \001(\001\022\020\n\010latitude\030\007 \001(\001\022\021\n\tlongitu"
-    "de\030\010 \001(\001\022\020\n\010altitude\030\t \001(\001\022*\n\010position\030\n"
-    " \001(\0132\030.mixr.recorder.pb.Vector\022*\n\010veloci"
-    "ty\030\013 \001(\0132\030.mixr.recorder.pb.Vector\022\022\n\nav"
-    "g_signal\030\014 \001(\001\022\020\n\010sl_index\030\r \001(\r\022\017\n\007wpn_"
-    "rel\030\016 \001(\010*\004\0102\020d*\005\010d\020\350\007\"\251\003\n\014EmissionData\022"
-    "\021\n\tfrequency\030\001 \001(\001\022\023\n\013wave_length\030\002 \001(\001\022"
-    "\023\n\013pulse_width\030\003 \001(\001\022\021\n\tbandwidth\030\004 \001(\001\022"
-    "\013\n\003prf\030\005 \001(\001\022\r\n\005power\030\006 \001(\001\022A\n\014polarizat"
-    "ion\030\007 \001(\0162+.mixr.recorder.pb.EmissionDat"
-    "a.Polarization\022\023\n\013azimuth_aoi\030\010 \001(\001\022\025\n\re"
-    "levation_aoi\030\t \001(\001\022-\n\torigin_id\030\n \001(\0132\032."
-    "mixr.recorder.pb.PlayerId\022-\n\ttarget_id\030\013"
-    " \001(\0132\032.mixr.recorder.pb.PlayerId\"S\n\014Pola"
-    "rization\022\010\n\004NONE\020\000\022\014\n\010VERTICAL\020\001\022\016\n\nHORI"
-    "ZONTAL\020\002\022\t\n\005SLANT\020\003\022\007\n\003RHC\020\004\022\007\n\003LHC\020\005*\004\010"
-    "2\020d*\005\010d\020\350\007", 5770);
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
-    "mixr/recorder/protobuf/DataRecord.proto", &protobuf_RegisterTypes);
-  DataRecord::default_instance_ = new DataRecord();
-  FileIdMsg::default_instance_ = new FileIdMsg();
-  UnknownIdMsg::default_instance_ = new UnknownIdMsg();
-  MarkerMsg::default_instance_ = new MarkerMsg();
-  InputDeviceMsg::default_instance_ = new InputDeviceMsg();
-  NewPlayerEventMsg::default_instance_ = new NewPlayerEventMsg();
-  PlayerRemovedEventMsg::default_instance_ = new PlayerRemovedEventMsg();
-  PlayerDataMsg::default_instance_ = new PlayerDataMsg();
-  PlayerDamagedEventMsg::default_instance_ = new PlayerDamagedEventMsg();
-  PlayerCollisionEventMsg::default_instance_ = new PlayerCollisionEventMsg();
-  PlayerCrashEventMsg::default_instance_ = new PlayerCrashEventMsg();
-  PlayerKilledEventMsg::default_instance_ = new PlayerKilledEventMsg();
-  WeaponReleaseEventMsg::default_instance_ = new WeaponReleaseEventMsg();
-  WeaponHungEventMsg::default_instance_ = new WeaponHungEventMsg();
-  WeaponDetonationEventMsg::default_instance_ = new WeaponDetonationEventMsg();
-  GunFiredEventMsg::default_instance_ = new GunFiredEventMsg();
-  NewTrackEventMsg::default_instance_ = new NewTrackEventMsg();
-  TrackRemovedEventMsg::default_instance_ = new TrackRemovedEventMsg();
-  TrackDataMsg::default_instance_ = new TrackDataMsg();
-  Vector::default_instance_ = new Vector();
-  Time::default_instance_ = new Time();
-  PlayerId::default_instance_ = new PlayerId();
-  PlayerState::default_instance_ = new PlayerState();
-  TrackData::default_instance_ = new TrackData();
-  EmissionData::default_instance_ = new EmissionData();
-  DataRecord::default_instance_->InitAsDefaultInstance();
-  FileIdMsg::default_instance_->InitAsDefaultInstance();
-  UnknownIdMsg::default_instance_->InitAsDefaultInstance();
-  MarkerMsg::default_instance_->InitAsDefaultInstance();
-  InputDeviceMsg::default_instance_->InitAsDefaultInstance();
-  NewPlayerEventMsg::default_instance_->InitAsDefaultInstance();
-  PlayerRemovedEventMsg::default_instance_->InitAsDefaultInstance();
-  PlayerDataMsg::default_instance_->InitAsDefaultInstance();
-  PlayerDamagedEventMsg::default_instance_->InitAsDefaultInstance();
-  PlayerCollisionEventMsg::default_instance_->InitAsDefaultInstance();
-  PlayerCrashEventMsg::default_instance_->InitAsDefaultInstance();
-  PlayerKilledEventMsg::default_instance_->InitAsDefaultInstance();
-  WeaponReleaseEventMsg::default_instance_->InitAsDefaultInstance();
-  WeaponHungEventMsg::default_instance_->InitAsDefaultInstance();
-  WeaponDetonationEventMsg::default_instance_->InitAsDefaultInstance();
-  GunFiredEventMsg::default_instance_->InitAsDefaultInstance();
-  NewTrackEventMsg::default_instance_->InitAsDefaultInstance();
-  TrackRemovedEventMsg::default_instance_->InitAsDefaultInstance();
-  TrackDataMsg::default_instance_->InitAsDefaultInstance();
-  Vector::default_instance_->InitAsDefaultInstance();
-  Time::default_instance_->InitAsDefaultInstance();
-  PlayerId::default_instance_->InitAsDefaultInstance();
-  PlayerState::default_instance_->InitAsDefaultInstance();
-  TrackData::default_instance_->InitAsDefaultInstance();
-  EmissionData::default_instance_->InitAsDefaultInstance();
-  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto);
-}
-
-// Force AddDescriptors() to be called at static initialization time.
-struct StaticDescriptorInitializer_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto {
-  StaticDescriptorInitializer_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto() {
-    protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  }
-} static_descriptor_initializer_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_;
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 EmissionDataDefaultTypeInternal _EmissionData_default_instance_;
+}  // namespace pb
+}  // namespace recorder
+}  // namespace mixr
+static ::_pb::Metadata file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[26];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[2];
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto = nullptr;
+
+const uint32_t TableStruct_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.time_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.file_id_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.unknown_id_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.marker_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.input_device_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.new_player_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_removed_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_data_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_damaged_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_collision_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_crash_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_killed_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.player_frame_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.weapon_release_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.weapon_hung_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.weapon_detonation_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.gun_fired_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.new_track_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.track_removed_event_msg_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::DataRecord, _impl_.track_data_msg_),
+  0,
+  20,
+  1,
+  2,
+  3,
+  4,
+  5,
+  6,
+  7,
+  8,
+  9,
+  10,
+  11,
+  12,
+  13,
+  14,
+  15,
+  16,
+  17,
+  18,
+  19,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.event_name_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.application_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.case_num_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.mission_num_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.subject_num_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.run_num_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.day_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.month_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::FileIdMsg, _impl_.year_),
+  0,
+  1,
+  2,
+  3,
+  4,
+  5,
+  6,
+  7,
+  8,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::UnknownIdMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::UnknownIdMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::UnknownIdMsg, _impl_.id_),
+  0,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::MarkerMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::MarkerMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::MarkerMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::MarkerMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::MarkerMsg, _impl_.source_id_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _impl_.source_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::InputDeviceMsg, _impl_.value_),
+  0,
+  1,
+  2,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewPlayerEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewPlayerEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewPlayerEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewPlayerEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewPlayerEventMsg, _impl_.state_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerRemovedEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerRemovedEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerRemovedEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerRemovedEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerRemovedEventMsg, _impl_.state_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_.state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_.alpha_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_.beta_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDataMsg, _impl_.cas_),
+  0,
+  1,
+  2,
+  3,
+  4,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDamagedEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDamagedEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDamagedEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDamagedEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerDamagedEventMsg, _impl_.state_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _impl_.state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCollisionEventMsg, _impl_.other_player_id_),
+  0,
+  1,
+  2,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCrashEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCrashEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCrashEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCrashEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerCrashEventMsg, _impl_.state_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _impl_.state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerKilledEventMsg, _impl_.shooter_id_),
+  0,
+  1,
+  2,
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.federate_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.pos_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.vel_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.angles_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.mode_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerFrameMsg, _impl_.federates_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_.wpn_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_.wpn_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_.shooter_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponReleaseEventMsg, _impl_.tgt_id_),
+  0,
+  1,
+  2,
+  3,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_.wpn_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_.wpn_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_.shooter_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponHungEventMsg, _impl_.tgt_id_),
+  0,
+  1,
+  2,
+  3,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.wpn_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.wpn_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.shooter_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.tgt_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.det_type_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::WeaponDetonationEventMsg, _impl_.miss_dist_),
+  0,
+  1,
+  2,
+  3,
+  5,
+  4,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::GunFiredEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::GunFiredEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::GunFiredEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::GunFiredEventMsg, _impl_.shooter_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::GunFiredEventMsg, _impl_.rounds_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.player_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.track_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.track_data_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.player_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.trk_player_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.trk_player_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::NewTrackEventMsg, _impl_.emission_data_),
+  1,
+  0,
+  2,
+  3,
+  4,
+  5,
+  6,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackRemovedEventMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackRemovedEventMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackRemovedEventMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackRemovedEventMsg, _impl_.player_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackRemovedEventMsg, _impl_.track_id_),
+  1,
+  0,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.player_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.track_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.track_data_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.player_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.trk_player_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.trk_player_state_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackDataMsg, _impl_.emission_data_),
+  1,
+  0,
+  2,
+  3,
+  4,
+  5,
+  6,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _impl_.x_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _impl_.y_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _impl_.z_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Vector, _impl_.w_),
+  0,
+  1,
+  2,
+  3,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _impl_.sim_time_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _impl_.exec_time_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::Time, _impl_.utc_time_),
+  0,
+  1,
+  2,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.fed_name_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.side_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.major_type_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerId, _impl_.ac_type_),
+  3,
+  0,
+  1,
+  4,
+  5,
+  2,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_.pos_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_.angles_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_.vel_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::PlayerState, _impl_.damage_),
+  0,
+  1,
+  2,
+  3,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.type_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.quality_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.true_az_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.rel_az_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.elevation_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.range_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.latitude_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.longitude_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.altitude_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.position_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.velocity_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.avg_signal_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.sl_index_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::TrackData, _impl_.wpn_rel_),
+  8,
+  2,
+  3,
+  4,
+  5,
+  6,
+  7,
+  10,
+  11,
+  0,
+  1,
+  12,
+  9,
+  13,
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _internal_metadata_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_._extensions_),
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.frequency_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.wave_length_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.pulse_width_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.bandwidth_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.prf_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.power_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.polarization_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.azimuth_aoi_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.elevation_aoi_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.origin_id_),
+  PROTOBUF_FIELD_OFFSET(::mixr::recorder::pb::EmissionData, _impl_.target_id_),
+  2,
+  3,
+  4,
+  5,
+  6,
+  7,
+  10,
+  8,
+  9,
+  0,
+  1,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 27, -1, sizeof(::mixr::recorder::pb::DataRecord)},
+  { 48, 63, -1, sizeof(::mixr::recorder::pb::FileIdMsg)},
+  { 72, 79, -1, sizeof(::mixr::recorder::pb::UnknownIdMsg)},
+  { 80, 88, -1, sizeof(::mixr::recorder::pb::MarkerMsg)},
+  { 90, 99, -1, sizeof(::mixr::recorder::pb::InputDeviceMsg)},
+  { 102, 110, -1, sizeof(::mixr::recorder::pb::NewPlayerEventMsg)},
+  { 112, 120, -1, sizeof(::mixr::recorder::pb::PlayerRemovedEventMsg)},
+  { 122, 133, -1, sizeof(::mixr::recorder::pb::PlayerDataMsg)},
+  { 138, 146, -1, sizeof(::mixr::recorder::pb::PlayerDamagedEventMsg)},
+  { 148, 157, -1, sizeof(::mixr::recorder::pb::PlayerCollisionEventMsg)},
+  { 160, 168, -1, sizeof(::mixr::recorder::pb::PlayerCrashEventMsg)},
+  { 170, 179, -1, sizeof(::mixr::recorder::pb::PlayerKilledEventMsg)},
+  { 182, -1, -1, sizeof(::mixr::recorder::pb::PlayerFrameMsg)},
+  { 195, 205, -1, sizeof(::mixr::recorder::pb::WeaponReleaseEventMsg)},
+  { 209, 219, -1, sizeof(::mixr::recorder::pb::WeaponHungEventMsg)},
+  { 223, 235, -1, sizeof(::mixr::recorder::pb::WeaponDetonationEventMsg)},
+  { 241, 249, -1, sizeof(::mixr::recorder::pb::GunFiredEventMsg)},
+  { 251, 264, -1, sizeof(::mixr::recorder::pb::NewTrackEventMsg)},
+  { 271, 279, -1, sizeof(::mixr::recorder::pb::TrackRemovedEventMsg)},
+  { 281, 294, -1, sizeof(::mixr::recorder::pb::TrackDataMsg)},
+  { 301, 311, -1, sizeof(::mixr::recorder::pb::Vector)},
+  { 315, 324, -1, sizeof(::mixr::recorder::pb::Time)},
+  { 327, 339, -1, sizeof(::mixr::recorder::pb::PlayerId)},
+  { 345, 355, -1, sizeof(::mixr::recorder::pb::PlayerState)},
+  { 359, 379, -1, sizeof(::mixr::recorder::pb::TrackData)},
+  { 393, 410, -1, sizeof(::mixr::recorder::pb::EmissionData)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::mixr::recorder::pb::_DataRecord_default_instance_._instance,
+  &::mixr::recorder::pb::_FileIdMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_UnknownIdMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_MarkerMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_InputDeviceMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_NewPlayerEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerRemovedEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerDataMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerDamagedEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerCollisionEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerCrashEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerKilledEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerFrameMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_WeaponReleaseEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_WeaponHungEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_WeaponDetonationEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_GunFiredEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_NewTrackEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_TrackRemovedEventMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_TrackDataMsg_default_instance_._instance,
+  &::mixr::recorder::pb::_Vector_default_instance_._instance,
+  &::mixr::recorder::pb::_Time_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerId_default_instance_._instance,
+  &::mixr::recorder::pb::_PlayerState_default_instance_._instance,
+  &::mixr::recorder::pb::_TrackData_default_instance_._instance,
+  &::mixr::recorder::pb::_EmissionData_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\'mixr/recorder/protobuf/DataRecord.prot"
+  "o\022\020mixr.recorder.pb\"\267\n\n\nDataRecord\022$\n\004ti"
+  "me\030\001 \002(\0132\026.mixr.recorder.pb.Time\022\n\n\002id\030\002"
+  " \002(\r\0220\n\013file_id_msg\030\013 \001(\0132\033.mixr.recorde"
+  "r.pb.FileIdMsg\0226\n\016unknown_id_msg\030\r \001(\0132\036"
+  ".mixr.recorder.pb.UnknownIdMsg\022/\n\nmarker"
+  "_msg\030\016 \001(\0132\033.mixr.recorder.pb.MarkerMsg\022"
+  ":\n\020input_device_msg\030\017 \001(\0132 .mixr.recorde"
+  "r.pb.InputDeviceMsg\022A\n\024new_player_event_"
+  "msg\030\037 \001(\0132#.mixr.recorder.pb.NewPlayerEv"
+  "entMsg\022I\n\030player_removed_event_msg\030  \001(\013"
+  "2\'.mixr.recorder.pb.PlayerRemovedEventMs"
+  "g\0228\n\017player_data_msg\030! \001(\0132\037.mixr.record"
+  "er.pb.PlayerDataMsg\022I\n\030player_damaged_ev"
+  "ent_msg\030\" \001(\0132\'.mixr.recorder.pb.PlayerD"
+  "amagedEventMsg\022M\n\032player_collision_event"
+  "_msg\030# \001(\0132).mixr.recorder.pb.PlayerColl"
+  "isionEventMsg\022E\n\026player_crash_event_msg\030"
+  "$ \001(\0132%.mixr.recorder.pb.PlayerCrashEven"
+  "tMsg\022G\n\027player_killed_event_msg\030% \001(\0132&."
+  "mixr.recorder.pb.PlayerKilledEventMsg\022:\n"
+  "\020player_frame_msg\030& \001(\0132 .mixr.recorder."
+  "pb.PlayerFrameMsg\022I\n\030weapon_release_even"
+  "t_msg\0303 \001(\0132\'.mixr.recorder.pb.WeaponRel"
+  "easeEventMsg\022C\n\025weapon_hung_event_msg\0304 "
+  "\001(\0132$.mixr.recorder.pb.WeaponHungEventMs"
+  "g\022O\n\033weapon_detonation_event_msg\0305 \001(\0132*"
+  ".mixr.recorder.pb.WeaponDetonationEventM"
+  "sg\022\?\n\023gun_fired_event_msg\0306 \001(\0132\".mixr.r"
+  "ecorder.pb.GunFiredEventMsg\022\?\n\023new_track"
+  "_event_msg\030G \001(\0132\".mixr.recorder.pb.NewT"
+  "rackEventMsg\022G\n\027track_removed_event_msg\030"
+  "H \001(\0132&.mixr.recorder.pb.TrackRemovedEve"
+  "ntMsg\0226\n\016track_data_msg\030I \001(\0132\036.mixr.rec"
+  "order.pb.TrackDataMsg*\006\010\364\003\020\350\007*\006\010\350\007\020\220N\"\270\001"
+  "\n\tFileIdMsg\022\022\n\nevent_name\030\001 \001(\t\022\023\n\013appli"
+  "cation\030\002 \001(\t\022\020\n\010case_num\030\003 \001(\r\022\023\n\013missio"
+  "n_num\030\004 \001(\r\022\023\n\013subject_num\030\005 \001(\r\022\017\n\007run_"
+  "num\030\006 \001(\r\022\013\n\003day\030\007 \001(\r\022\r\n\005month\030\010 \001(\r\022\014\n"
+  "\004year\030\t \001(\r*\004\0102\020d*\005\010d\020\350\007\"\032\n\014UnknownIdMsg"
+  "\022\n\n\002id\030\001 \002(\r\"7\n\tMarkerMsg\022\n\n\002id\030\001 \001(\r\022\021\n"
+  "\tsource_id\030\002 \001(\r*\004\0102\020d*\005\010d\020\350\007\"K\n\016InputDe"
+  "viceMsg\022\n\n\002id\030\001 \002(\r\022\021\n\tsource_id\030\002 \001(\r\022\r"
+  "\n\005value\030\003 \001(\002*\004\0102\020d*\005\010d\020\350\007\"v\n\021NewPlayerE"
+  "ventMsg\022&\n\002id\030\001 \002(\0132\032.mixr.recorder.pb.P"
+  "layerId\022,\n\005state\030\002 \002(\0132\035.mixr.recorder.p"
+  "b.PlayerState*\004\0102\020d*\005\010d\020\350\007\"z\n\025PlayerRemo"
+  "vedEventMsg\022&\n\002id\030\001 \002(\0132\032.mixr.recorder."
+  "pb.PlayerId\022,\n\005state\030\002 \001(\0132\035.mixr.record"
+  "er.pb.PlayerState*\004\0102\020d*\005\010d\020\350\007\"\234\001\n\rPlaye"
+  "rDataMsg\022&\n\002id\030\001 \002(\0132\032.mixr.recorder.pb."
+  "PlayerId\022,\n\005state\030\002 \002(\0132\035.mixr.recorder."
+  "pb.PlayerState\022\r\n\005alpha\030\003 \001(\001\022\014\n\004beta\030\004 "
+  "\001(\001\022\013\n\003cas\030\005 \001(\001*\004\0102\020d*\005\010d\020\350\007\"z\n\025PlayerD"
+  "amagedEventMsg\022&\n\002id\030\001 \002(\0132\032.mixr.record"
+  "er.pb.PlayerId\022,\n\005state\030\002 \001(\0132\035.mixr.rec"
+  "order.pb.PlayerState*\004\0102\020d*\005\010d\020\350\007\"\261\001\n\027Pl"
+  "ayerCollisionEventMsg\022&\n\002id\030\001 \002(\0132\032.mixr"
+  ".recorder.pb.PlayerId\022,\n\005state\030\002 \001(\0132\035.m"
+  "ixr.recorder.pb.PlayerState\0223\n\017other_pla"
+  "yer_id\030\003 \001(\0132\032.mixr.recorder.pb.PlayerId"
+  "*\004\0102\020d*\005\010d\020\350\007\"x\n\023PlayerCrashEventMsg\022&\n\002"
+  "id\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId\022,\n\005"
+  "state\030\002 \001(\0132\035.mixr.recorder.pb.PlayerSta"
+  "te*\004\0102\020d*\005\010d\020\350\007\"\251\001\n\024PlayerKilledEventMsg"
+  "\022&\n\002id\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId"
+  "\022,\n\005state\030\002 \001(\0132\035.mixr.recorder.pb.Playe"
+  "rState\022.\n\nshooter_id\030\003 \001(\0132\032.mixr.record"
+  "er.pb.PlayerId*\004\0102\020d*\005\010d\020\350\007\"\236\001\n\016PlayerFr"
+  "ameMsg\022\016\n\002id\030\001 \003(\rB\002\020\001\022\024\n\010federate\030\002 \003(\r"
+  "B\002\020\001\022\017\n\003pos\030\003 \003(\001B\002\020\001\022\017\n\003vel\030\004 \003(\001B\002\020\001\022\022"
+  "\n\006angles\030\005 \003(\001B\002\020\001\022\020\n\004mode\030\006 \003(\rB\002\020\001\022\021\n\t"
+  "federates\030\007 \003(\t*\004\0102\020d*\005\010d\020\350\007\"\336\001\n\025WeaponR"
+  "eleaseEventMsg\022*\n\006wpn_id\030\001 \002(\0132\032.mixr.re"
+  "corder.pb.PlayerId\0220\n\twpn_state\030\002 \001(\0132\035."
+  "mixr.recorder.pb.PlayerState\022.\n\nshooter_"
+  "id\030\003 \001(\0132\032.mixr.recorder.pb.PlayerId\022*\n\006"
+  "tgt_id\030\004 \001(\0132\032.mixr.recorder.pb.PlayerId"
+  "*\004\0102\020d*\005\010d\020\350\007\"\333\001\n\022WeaponHungEventMsg\022*\n\006"
+  "wpn_id\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId"
+  "\0220\n\twpn_state\030\002 \001(\0132\035.mixr.recorder.pb.P"
+  "layerState\022.\n\nshooter_id\030\003 \001(\0132\032.mixr.re"
+  "corder.pb.PlayerId\022*\n\006tgt_id\030\004 \001(\0132\032.mix"
+  "r.recorder.pb.PlayerId*\004\0102\020d*\005\010d\020\350\007\"\240\004\n\030"
+  "WeaponDetonationEventMsg\022*\n\006wpn_id\030\001 \002(\013"
+  "2\032.mixr.recorder.pb.PlayerId\0220\n\twpn_stat"
+  "e\030\002 \001(\0132\035.mixr.recorder.pb.PlayerState\022."
+  "\n\nshooter_id\030\003 \001(\0132\032.mixr.recorder.pb.Pl"
+  "ayerId\022*\n\006tgt_id\030\004 \001(\0132\032.mixr.recorder.p"
+  "b.PlayerId\022K\n\010det_type\030\005 \001(\01629.mixr.reco"
+  "rder.pb.WeaponDetonationEventMsg.Detonat"
+  "ionType\022\021\n\tmiss_dist\030\006 \001(\001\"\334\001\n\016Detonatio"
+  "nType\022\022\n\016DETONATE_OTHER\020\000\022\032\n\026DETONATE_EN"
+  "TITY_IMPACT\020\001\022(\n$DETONATE_ENTITY_PROXIMA"
+  "TE_DETONATION\020\002\022\032\n\026DETONATE_GROUND_IMPAC"
+  "T\020\003\022(\n$DETONATE_GROUND_PROXIMATE_DETONAT"
+  "ION\020\004\022\027\n\023DETONATE_DETONATION\020\005\022\021\n\rDETONA"
+  "TE_NONE\020\006*\004\0102\020d*\005\010d\020\350\007\"_\n\020GunFiredEventM"
+  "sg\022.\n\nshooter_id\030\001 \002(\0132\032.mixr.recorder.p"
+  "b.PlayerId\022\016\n\006rounds\030\002 \001(\r*\004\0102\020d*\005\010d\020\350\007\""
+  "\351\002\n\020NewTrackEventMsg\022-\n\tplayer_id\030\001 \002(\0132"
+  "\032.mixr.recorder.pb.PlayerId\022\020\n\010track_id\030"
+  "\002 \002(\t\022/\n\ntrack_data\030\003 \001(\0132\033.mixr.recorde"
+  "r.pb.TrackData\0223\n\014player_state\030\004 \001(\0132\035.m"
+  "ixr.recorder.pb.PlayerState\0221\n\rtrk_playe"
+  "r_id\030\005 \001(\0132\032.mixr.recorder.pb.PlayerId\0227"
+  "\n\020trk_player_state\030\006 \001(\0132\035.mixr.recorder"
+  ".pb.PlayerState\0225\n\remission_data\030\007 \001(\0132\036"
+  ".mixr.recorder.pb.EmissionData*\004\0102\020d*\005\010d"
+  "\020\350\007\"d\n\024TrackRemovedEventMsg\022-\n\tplayer_id"
+  "\030\001 \002(\0132\032.mixr.recorder.pb.PlayerId\022\020\n\010tr"
+  "ack_id\030\002 \002(\t*\004\0102\020d*\005\010d\020\350\007\"\345\002\n\014TrackDataM"
+  "sg\022-\n\tplayer_id\030\001 \002(\0132\032.mixr.recorder.pb"
+  ".PlayerId\022\020\n\010track_id\030\002 \002(\t\022/\n\ntrack_dat"
+  "a\030\003 \001(\0132\033.mixr.recorder.pb.TrackData\0223\n\014"
+  "player_state\030\004 \001(\0132\035.mixr.recorder.pb.Pl"
+  "ayerState\0221\n\rtrk_player_id\030\005 \001(\0132\032.mixr."
+  "recorder.pb.PlayerId\0227\n\020trk_player_state"
+  "\030\006 \001(\0132\035.mixr.recorder.pb.PlayerState\0225\n"
+  "\remission_data\030\007 \001(\0132\036.mixr.recorder.pb."
+  "EmissionData*\004\0102\020d*\005\010d\020\350\007\"4\n\006Vector\022\t\n\001x"
+  "\030\001 \002(\001\022\t\n\001y\030\002 \002(\001\022\t\n\001z\030\003 \001(\001\022\t\n\001w\030\004 \001(\001\""
+  "J\n\004Time\022\020\n\010sim_time\030\001 \002(\001\022\021\n\texec_time\030\002"
+  " \001(\001\022\020\n\010utc_time\030\003 \001(\001*\004\0102\020d*\005\010d\020\350\007\"v\n\010P"
+  "layerId\022\n\n\002id\030\001 \002(\r\022\014\n\004name\030\002 \001(\t\022\020\n\010fed"
+  "_name\030\003 \001(\t\022\014\n\004side\030\004 \001(\r\022\022\n\nmajor_type\030"
+  "\005 \001(\r\022\017\n\007ac_type\030\006 \001(\t*\004\0102\020d*\005\010d\020\350\007\"\242\001\n\013"
+  "PlayerState\022%\n\003pos\030\001 \002(\0132\030.mixr.recorder"
+  ".pb.Vector\022(\n\006angles\030\002 \002(\0132\030.mixr.record"
+  "er.pb.Vector\022%\n\003vel\030\003 \001(\0132\030.mixr.recorde"
+  "r.pb.Vector\022\016\n\006damage\030\004 \001(\001*\004\0102\020d*\005\010d\020\350\007"
+  "\"\300\002\n\tTrackData\022\014\n\004type\030\001 \001(\r\022\017\n\007quality\030"
+  "\002 \001(\001\022\017\n\007true_az\030\003 \001(\001\022\016\n\006rel_az\030\004 \001(\001\022\021"
+  "\n\televation\030\005 \001(\001\022\r\n\005range\030\006 \001(\001\022\020\n\010lati"
+  "tude\030\007 \001(\001\022\021\n\tlongitude\030\010 \001(\001\022\020\n\010altitud"
+  "e\030\t \001(\001\022*\n\010position\030\n \001(\0132\030.mixr.recorde"
+  "r.pb.Vector\022*\n\010velocity\030\013 \001(\0132\030.mixr.rec"
+  "order.pb.Vector\022\022\n\navg_signal\030\014 \001(\001\022\020\n\010s"
+  "l_index\030\r \001(\r\022\017\n\007wpn_rel\030\016 \001(\010*\004\0102\020d*\005\010d"
+  "\020\350\007\"\251\003\n\014EmissionData\022\021\n\tfrequency\030\001 \001(\001\022"
+  "\023\n\013wave_length\030\002 \001(\001\022\023\n\013pulse_width\030\003 \001("
+  "\001\022\021\n\tbandwidth\030\004 \001(\001\022\013\n\003prf\030\005 \001(\001\022\r\n\005pow"
+  "er\030\006 \001(\001\022A\n\014polarization\030\007 \001(\0162+.mixr.re"
+  "corder.pb.EmissionData.Polarization\022\023\n\013a"
+  "zimuth_aoi\030\010 \001(\001\022\025\n\relevation_aoi\030\t \001(\001\022"
+  "-\n\torigin_id\030\n \001(\0132\032.mixr.recorder.pb.Pl"
+  "ayerId\022-\n\ttarget_id\030\013 \001(\0132\032.mixr.recorde"
+  "r.pb.PlayerId\"S\n\014Polarization\022\010\n\004NONE\020\000\022"
+  "\014\n\010VERTICAL\020\001\022\016\n\nHORIZONTAL\020\002\022\t\n\005SLANT\020\003"
+  "\022\007\n\003RHC\020\004\022\007\n\003LHC\020\005*\004\0102\020d*\005\010d\020\350\007"
+  ;
+static ::_pbi::once_flag descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto = {
+    false, false, 5991, descriptor_table_protodef_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto,
+    "mixr/recorder/protobuf/DataRecord.proto",
+    &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once, nullptr, 0, 26,
+    schemas, file_default_instances, TableStruct_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto::offsets,
+    file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto, file_level_enum_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto,
+    file_level_service_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter() {
+  return &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto(&descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto);
+namespace mixr {
+namespace recorder {
+namespace pb {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* WeaponDetonationEventMsg_DetonationType_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto);
+  return file_level_enum_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[0];
+}
+bool WeaponDetonationEventMsg_DetonationType_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+    case 6:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_OTHER;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_ENTITY_IMPACT;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_ENTITY_PROXIMATE_DETONATION;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_GROUND_IMPACT;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_GROUND_PROXIMATE_DETONATION;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_DETONATION;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_NONE;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DetonationType_MIN;
+constexpr WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DetonationType_MAX;
+constexpr int WeaponDetonationEventMsg::DetonationType_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* EmissionData_Polarization_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto);
+  return file_level_enum_descriptors_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[1];
+}
+bool EmissionData_Polarization_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr EmissionData_Polarization EmissionData::NONE;
+constexpr EmissionData_Polarization EmissionData::VERTICAL;
+constexpr EmissionData_Polarization EmissionData::HORIZONTAL;
+constexpr EmissionData_Polarization EmissionData::SLANT;
+constexpr EmissionData_Polarization EmissionData::RHC;
+constexpr EmissionData_Polarization EmissionData::LHC;
+constexpr EmissionData_Polarization EmissionData::Polarization_MIN;
+constexpr EmissionData_Polarization EmissionData::Polarization_MAX;
+constexpr int EmissionData::Polarization_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int DataRecord::kTimeFieldNumber;
-const int DataRecord::kIdFieldNumber;
-const int DataRecord::kFileIdMsgFieldNumber;
-const int DataRecord::kUnknownIdMsgFieldNumber;
-const int DataRecord::kMarkerMsgFieldNumber;
-const int DataRecord::kInputDeviceMsgFieldNumber;
-const int DataRecord::kNewPlayerEventMsgFieldNumber;
-const int DataRecord::kPlayerRemovedEventMsgFieldNumber;
-const int DataRecord::kPlayerDataMsgFieldNumber;
-const int DataRecord::kPlayerDamagedEventMsgFieldNumber;
-const int DataRecord::kPlayerCollisionEventMsgFieldNumber;
-const int DataRecord::kPlayerCrashEventMsgFieldNumber;
-const int DataRecord::kPlayerKilledEventMsgFieldNumber;
-const int DataRecord::kWeaponReleaseEventMsgFieldNumber;
-const int DataRecord::kWeaponHungEventMsgFieldNumber;
-const int DataRecord::kWeaponDetonationEventMsgFieldNumber;
-const int DataRecord::kGunFiredEventMsgFieldNumber;
-const int DataRecord::kNewTrackEventMsgFieldNumber;
-const int DataRecord::kTrackRemovedEventMsgFieldNumber;
-const int DataRecord::kTrackDataMsgFieldNumber;
-#endif  // !_MSC_VER
-
-DataRecord::DataRecord()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.DataRecord)
-}
-
-void DataRecord::InitAsDefaultInstance() {
-  time_ = const_cast< ::mixr::recorder::pb::Time*>(&::mixr::recorder::pb::Time::default_instance());
-  file_id_msg_ = const_cast< ::mixr::recorder::pb::FileIdMsg*>(&::mixr::recorder::pb::FileIdMsg::default_instance());
-  unknown_id_msg_ = const_cast< ::mixr::recorder::pb::UnknownIdMsg*>(&::mixr::recorder::pb::UnknownIdMsg::default_instance());
-  marker_msg_ = const_cast< ::mixr::recorder::pb::MarkerMsg*>(&::mixr::recorder::pb::MarkerMsg::default_instance());
-  input_device_msg_ = const_cast< ::mixr::recorder::pb::InputDeviceMsg*>(&::mixr::recorder::pb::InputDeviceMsg::default_instance());
-  new_player_event_msg_ = const_cast< ::mixr::recorder::pb::NewPlayerEventMsg*>(&::mixr::recorder::pb::NewPlayerEventMsg::default_instance());
-  player_removed_event_msg_ = const_cast< ::mixr::recorder::pb::PlayerRemovedEventMsg*>(&::mixr::recorder::pb::PlayerRemovedEventMsg::default_instance());
-  player_data_msg_ = const_cast< ::mixr::recorder::pb::PlayerDataMsg*>(&::mixr::recorder::pb::PlayerDataMsg::default_instance());
-  player_damaged_event_msg_ = const_cast< ::mixr::recorder::pb::PlayerDamagedEventMsg*>(&::mixr::recorder::pb::PlayerDamagedEventMsg::default_instance());
-  player_collision_event_msg_ = const_cast< ::mixr::recorder::pb::PlayerCollisionEventMsg*>(&::mixr::recorder::pb::PlayerCollisionEventMsg::default_instance());
-  player_crash_event_msg_ = const_cast< ::mixr::recorder::pb::PlayerCrashEventMsg*>(&::mixr::recorder::pb::PlayerCrashEventMsg::default_instance());
-  player_killed_event_msg_ = const_cast< ::mixr::recorder::pb::PlayerKilledEventMsg*>(&::mixr::recorder::pb::PlayerKilledEventMsg::default_instance());
-  weapon_release_event_msg_ = const_cast< ::mixr::recorder::pb::WeaponReleaseEventMsg*>(&::mixr::recorder::pb::WeaponReleaseEventMsg::default_instance());
-  weapon_hung_event_msg_ = const_cast< ::mixr::recorder::pb::WeaponHungEventMsg*>(&::mixr::recorder::pb::WeaponHungEventMsg::default_instance());
-  weapon_detonation_event_msg_ = const_cast< ::mixr::recorder::pb::WeaponDetonationEventMsg*>(&::mixr::recorder::pb::WeaponDetonationEventMsg::default_instance());
-  gun_fired_event_msg_ = const_cast< ::mixr::recorder::pb::GunFiredEventMsg*>(&::mixr::recorder::pb::GunFiredEventMsg::default_instance());
-  new_track_event_msg_ = const_cast< ::mixr::recorder::pb::NewTrackEventMsg*>(&::mixr::recorder::pb::NewTrackEventMsg::default_instance());
-  track_removed_event_msg_ = const_cast< ::mixr::recorder::pb::TrackRemovedEventMsg*>(&::mixr::recorder::pb::TrackRemovedEventMsg::default_instance());
-  track_data_msg_ = const_cast< ::mixr::recorder::pb::TrackDataMsg*>(&::mixr::recorder::pb::TrackDataMsg::default_instance());
-}
+class DataRecord::_Internal {
+ public:
+  using HasBits = decltype(std::declval<DataRecord>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::Time& time(const DataRecord* msg);
+  static void set_has_time(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1048576u;
+  }
+  static const ::mixr::recorder::pb::FileIdMsg& file_id_msg(const DataRecord* msg);
+  static void set_has_file_id_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::UnknownIdMsg& unknown_id_msg(const DataRecord* msg);
+  static void set_has_unknown_id_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::MarkerMsg& marker_msg(const DataRecord* msg);
+  static void set_has_marker_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static const ::mixr::recorder::pb::InputDeviceMsg& input_device_msg(const DataRecord* msg);
+  static void set_has_input_device_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static const ::mixr::recorder::pb::NewPlayerEventMsg& new_player_event_msg(const DataRecord* msg);
+  static void set_has_new_player_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static const ::mixr::recorder::pb::PlayerRemovedEventMsg& player_removed_event_msg(const DataRecord* msg);
+  static void set_has_player_removed_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static const ::mixr::recorder::pb::PlayerDataMsg& player_data_msg(const DataRecord* msg);
+  static void set_has_player_data_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
+  }
+  static const ::mixr::recorder::pb::PlayerDamagedEventMsg& player_damaged_event_msg(const DataRecord* msg);
+  static void set_has_player_damaged_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
+  }
+  static const ::mixr::recorder::pb::PlayerCollisionEventMsg& player_collision_event_msg(const DataRecord* msg);
+  static void set_has_player_collision_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 512u;
+  }
+  static const ::mixr::recorder::pb::PlayerCrashEventMsg& player_crash_event_msg(const DataRecord* msg);
+  static void set_has_player_crash_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 1024u;
+  }
+  static const ::mixr::recorder::pb::PlayerKilledEventMsg& player_killed_event_msg(const DataRecord* msg);
+  static void set_has_player_killed_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 2048u;
+  }
+  static const ::mixr::recorder::pb::PlayerFrameMsg& player_frame_msg(const DataRecord* msg);
+  static void set_has_player_frame_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 4096u;
+  }
+  static const ::mixr::recorder::pb::WeaponReleaseEventMsg& weapon_release_event_msg(const DataRecord* msg);
+  static void set_has_weapon_release_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 8192u;
+  }
+  static const ::mixr::recorder::pb::WeaponHungEventMsg& weapon_hung_event_msg(const DataRecord* msg);
+  static void set_has_weapon_hung_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 16384u;
+  }
+  static const ::mixr::recorder::pb::WeaponDetonationEventMsg& weapon_detonation_event_msg(const DataRecord* msg);
+  static void set_has_weapon_detonation_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 32768u;
+  }
+  static const ::mixr::recorder::pb::GunFiredEventMsg& gun_fired_event_msg(const DataRecord* msg);
+  static void set_has_gun_fired_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 65536u;
+  }
+  static const ::mixr::recorder::pb::NewTrackEventMsg& new_track_event_msg(const DataRecord* msg);
+  static void set_has_new_track_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 131072u;
+  }
+  static const ::mixr::recorder::pb::TrackRemovedEventMsg& track_removed_event_msg(const DataRecord* msg);
+  static void set_has_track_removed_event_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 262144u;
+  }
+  static const ::mixr::recorder::pb::TrackDataMsg& track_data_msg(const DataRecord* msg);
+  static void set_has_track_data_msg(HasBits* has_bits) {
+    (*has_bits)[0] |= 524288u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00100001) ^ 0x00100001) != 0;
+  }
+};
 
+const ::mixr::recorder::pb::Time&
+DataRecord::_Internal::time(const DataRecord* msg) {
+  return *msg->_impl_.time_;
+}
+const ::mixr::recorder::pb::FileIdMsg&
+DataRecord::_Internal::file_id_msg(const DataRecord* msg) {
+  return *msg->_impl_.file_id_msg_;
+}
+const ::mixr::recorder::pb::UnknownIdMsg&
+DataRecord::_Internal::unknown_id_msg(const DataRecord* msg) {
+  return *msg->_impl_.unknown_id_msg_;
+}
+const ::mixr::recorder::pb::MarkerMsg&
+DataRecord::_Internal::marker_msg(const DataRecord* msg) {
+  return *msg->_impl_.marker_msg_;
+}
+const ::mixr::recorder::pb::InputDeviceMsg&
+DataRecord::_Internal::input_device_msg(const DataRecord* msg) {
+  return *msg->_impl_.input_device_msg_;
+}
+const ::mixr::recorder::pb::NewPlayerEventMsg&
+DataRecord::_Internal::new_player_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.new_player_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerRemovedEventMsg&
+DataRecord::_Internal::player_removed_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_removed_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerDataMsg&
+DataRecord::_Internal::player_data_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_data_msg_;
+}
+const ::mixr::recorder::pb::PlayerDamagedEventMsg&
+DataRecord::_Internal::player_damaged_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_damaged_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerCollisionEventMsg&
+DataRecord::_Internal::player_collision_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_collision_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerCrashEventMsg&
+DataRecord::_Internal::player_crash_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_crash_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerKilledEventMsg&
+DataRecord::_Internal::player_killed_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_killed_event_msg_;
+}
+const ::mixr::recorder::pb::PlayerFrameMsg&
+DataRecord::_Internal::player_frame_msg(const DataRecord* msg) {
+  return *msg->_impl_.player_frame_msg_;
+}
+const ::mixr::recorder::pb::WeaponReleaseEventMsg&
+DataRecord::_Internal::weapon_release_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.weapon_release_event_msg_;
+}
+const ::mixr::recorder::pb::WeaponHungEventMsg&
+DataRecord::_Internal::weapon_hung_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.weapon_hung_event_msg_;
+}
+const ::mixr::recorder::pb::WeaponDetonationEventMsg&
+DataRecord::_Internal::weapon_detonation_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.weapon_detonation_event_msg_;
+}
+const ::mixr::recorder::pb::GunFiredEventMsg&
+DataRecord::_Internal::gun_fired_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.gun_fired_event_msg_;
+}
+const ::mixr::recorder::pb::NewTrackEventMsg&
+DataRecord::_Internal::new_track_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.new_track_event_msg_;
+}
+const ::mixr::recorder::pb::TrackRemovedEventMsg&
+DataRecord::_Internal::track_removed_event_msg(const DataRecord* msg) {
+  return *msg->_impl_.track_removed_event_msg_;
+}
+const ::mixr::recorder::pb::TrackDataMsg&
+DataRecord::_Internal::track_data_msg(const DataRecord* msg) {
+  return *msg->_impl_.track_data_msg_;
+}
+DataRecord::DataRecord(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.DataRecord)
+}
 DataRecord::DataRecord(const DataRecord& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  DataRecord* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.time_){nullptr}
+    , decltype(_impl_.file_id_msg_){nullptr}
+    , decltype(_impl_.unknown_id_msg_){nullptr}
+    , decltype(_impl_.marker_msg_){nullptr}
+    , decltype(_impl_.input_device_msg_){nullptr}
+    , decltype(_impl_.new_player_event_msg_){nullptr}
+    , decltype(_impl_.player_removed_event_msg_){nullptr}
+    , decltype(_impl_.player_data_msg_){nullptr}
+    , decltype(_impl_.player_damaged_event_msg_){nullptr}
+    , decltype(_impl_.player_collision_event_msg_){nullptr}
+    , decltype(_impl_.player_crash_event_msg_){nullptr}
+    , decltype(_impl_.player_killed_event_msg_){nullptr}
+    , decltype(_impl_.player_frame_msg_){nullptr}
+    , decltype(_impl_.weapon_release_event_msg_){nullptr}
+    , decltype(_impl_.weapon_hung_event_msg_){nullptr}
+    , decltype(_impl_.weapon_detonation_event_msg_){nullptr}
+    , decltype(_impl_.gun_fired_event_msg_){nullptr}
+    , decltype(_impl_.new_track_event_msg_){nullptr}
+    , decltype(_impl_.track_removed_event_msg_){nullptr}
+    , decltype(_impl_.track_data_msg_){nullptr}
+    , decltype(_impl_.id_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_time()) {
+    _this->_impl_.time_ = new ::mixr::recorder::pb::Time(*from._impl_.time_);
+  }
+  if (from._internal_has_file_id_msg()) {
+    _this->_impl_.file_id_msg_ = new ::mixr::recorder::pb::FileIdMsg(*from._impl_.file_id_msg_);
+  }
+  if (from._internal_has_unknown_id_msg()) {
+    _this->_impl_.unknown_id_msg_ = new ::mixr::recorder::pb::UnknownIdMsg(*from._impl_.unknown_id_msg_);
+  }
+  if (from._internal_has_marker_msg()) {
+    _this->_impl_.marker_msg_ = new ::mixr::recorder::pb::MarkerMsg(*from._impl_.marker_msg_);
+  }
+  if (from._internal_has_input_device_msg()) {
+    _this->_impl_.input_device_msg_ = new ::mixr::recorder::pb::InputDeviceMsg(*from._impl_.input_device_msg_);
+  }
+  if (from._internal_has_new_player_event_msg()) {
+    _this->_impl_.new_player_event_msg_ = new ::mixr::recorder::pb::NewPlayerEventMsg(*from._impl_.new_player_event_msg_);
+  }
+  if (from._internal_has_player_removed_event_msg()) {
+    _this->_impl_.player_removed_event_msg_ = new ::mixr::recorder::pb::PlayerRemovedEventMsg(*from._impl_.player_removed_event_msg_);
+  }
+  if (from._internal_has_player_data_msg()) {
+    _this->_impl_.player_data_msg_ = new ::mixr::recorder::pb::PlayerDataMsg(*from._impl_.player_data_msg_);
+  }
+  if (from._internal_has_player_damaged_event_msg()) {
+    _this->_impl_.player_damaged_event_msg_ = new ::mixr::recorder::pb::PlayerDamagedEventMsg(*from._impl_.player_damaged_event_msg_);
+  }
+  if (from._internal_has_player_collision_event_msg()) {
+    _this->_impl_.player_collision_event_msg_ = new ::mixr::recorder::pb::PlayerCollisionEventMsg(*from._impl_.player_collision_event_msg_);
+  }
+  if (from._internal_has_player_crash_event_msg()) {
+    _this->_impl_.player_crash_event_msg_ = new ::mixr::recorder::pb::PlayerCrashEventMsg(*from._impl_.player_crash_event_msg_);
+  }
+  if (from._internal_has_player_killed_event_msg()) {
+    _this->_impl_.player_killed_event_msg_ = new ::mixr::recorder::pb::PlayerKilledEventMsg(*from._impl_.player_killed_event_msg_);
+  }
+  if (from._internal_has_player_frame_msg()) {
+    _this->_impl_.player_frame_msg_ = new ::mixr::recorder::pb::PlayerFrameMsg(*from._impl_.player_frame_msg_);
+  }
+  if (from._internal_has_weapon_release_event_msg()) {
+    _this->_impl_.weapon_release_event_msg_ = new ::mixr::recorder::pb::WeaponReleaseEventMsg(*from._impl_.weapon_release_event_msg_);
+  }
+  if (from._internal_has_weapon_hung_event_msg()) {
+    _this->_impl_.weapon_hung_event_msg_ = new ::mixr::recorder::pb::WeaponHungEventMsg(*from._impl_.weapon_hung_event_msg_);
+  }
+  if (from._internal_has_weapon_detonation_event_msg()) {
+    _this->_impl_.weapon_detonation_event_msg_ = new ::mixr::recorder::pb::WeaponDetonationEventMsg(*from._impl_.weapon_detonation_event_msg_);
+  }
+  if (from._internal_has_gun_fired_event_msg()) {
+    _this->_impl_.gun_fired_event_msg_ = new ::mixr::recorder::pb::GunFiredEventMsg(*from._impl_.gun_fired_event_msg_);
+  }
+  if (from._internal_has_new_track_event_msg()) {
+    _this->_impl_.new_track_event_msg_ = new ::mixr::recorder::pb::NewTrackEventMsg(*from._impl_.new_track_event_msg_);
+  }
+  if (from._internal_has_track_removed_event_msg()) {
+    _this->_impl_.track_removed_event_msg_ = new ::mixr::recorder::pb::TrackRemovedEventMsg(*from._impl_.track_removed_event_msg_);
+  }
+  if (from._internal_has_track_data_msg()) {
+    _this->_impl_.track_data_msg_ = new ::mixr::recorder::pb::TrackDataMsg(*from._impl_.track_data_msg_);
+  }
+  _this->_impl_.id_ = from._impl_.id_;
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.DataRecord)
 }
 
-void DataRecord::SharedCtor() {
-  _cached_size_ = 0;
-  time_ = NULL;
-  id_ = 0u;
-  file_id_msg_ = NULL;
-  unknown_id_msg_ = NULL;
-  marker_msg_ = NULL;
-  input_device_msg_ = NULL;
-  new_player_event_msg_ = NULL;
-  player_removed_event_msg_ = NULL;
-  player_data_msg_ = NULL;
-  player_damaged_event_msg_ = NULL;
-  player_collision_event_msg_ = NULL;
-  player_crash_event_msg_ = NULL;
-  player_killed_event_msg_ = NULL;
-  weapon_release_event_msg_ = NULL;
-  weapon_hung_event_msg_ = NULL;
-  weapon_detonation_event_msg_ = NULL;
-  gun_fired_event_msg_ = NULL;
-  new_track_event_msg_ = NULL;
-  track_removed_event_msg_ = NULL;
-  track_data_msg_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void DataRecord::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.time_){nullptr}
+    , decltype(_impl_.file_id_msg_){nullptr}
+    , decltype(_impl_.unknown_id_msg_){nullptr}
+    , decltype(_impl_.marker_msg_){nullptr}
+    , decltype(_impl_.input_device_msg_){nullptr}
+    , decltype(_impl_.new_player_event_msg_){nullptr}
+    , decltype(_impl_.player_removed_event_msg_){nullptr}
+    , decltype(_impl_.player_data_msg_){nullptr}
+    , decltype(_impl_.player_damaged_event_msg_){nullptr}
+    , decltype(_impl_.player_collision_event_msg_){nullptr}
+    , decltype(_impl_.player_crash_event_msg_){nullptr}
+    , decltype(_impl_.player_killed_event_msg_){nullptr}
+    , decltype(_impl_.player_frame_msg_){nullptr}
+    , decltype(_impl_.weapon_release_event_msg_){nullptr}
+    , decltype(_impl_.weapon_hung_event_msg_){nullptr}
+    , decltype(_impl_.weapon_detonation_event_msg_){nullptr}
+    , decltype(_impl_.gun_fired_event_msg_){nullptr}
+    , decltype(_impl_.new_track_event_msg_){nullptr}
+    , decltype(_impl_.track_removed_event_msg_){nullptr}
+    , decltype(_impl_.track_data_msg_){nullptr}
+    , decltype(_impl_.id_){0u}
+  };
 }
 
 DataRecord::~DataRecord() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.DataRecord)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void DataRecord::SharedDtor() {
-  if (this != default_instance_) {
-    delete time_;
-    delete file_id_msg_;
-    delete unknown_id_msg_;
-    delete marker_msg_;
-    delete input_device_msg_;
-    delete new_player_event_msg_;
-    delete player_removed_event_msg_;
-    delete player_data_msg_;
-    delete player_damaged_event_msg_;
-    delete player_collision_event_msg_;
-    delete player_crash_event_msg_;
-    delete player_killed_event_msg_;
-    delete weapon_release_event_msg_;
-    delete weapon_hung_event_msg_;
-    delete weapon_detonation_event_msg_;
-    delete gun_fired_event_msg_;
-    delete new_track_event_msg_;
-    delete track_removed_event_msg_;
-    delete track_data_msg_;
-  }
+inline void DataRecord::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.time_;
+  if (this != internal_default_instance()) delete _impl_.file_id_msg_;
+  if (this != internal_default_instance()) delete _impl_.unknown_id_msg_;
+  if (this != internal_default_instance()) delete _impl_.marker_msg_;
+  if (this != internal_default_instance()) delete _impl_.input_device_msg_;
+  if (this != internal_default_instance()) delete _impl_.new_player_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_removed_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_data_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_damaged_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_collision_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_crash_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_killed_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.player_frame_msg_;
+  if (this != internal_default_instance()) delete _impl_.weapon_release_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.weapon_hung_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.weapon_detonation_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.gun_fired_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.new_track_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.track_removed_event_msg_;
+  if (this != internal_default_instance()) delete _impl_.track_data_msg_;
 }
 
 void DataRecord::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* DataRecord::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return DataRecord_descriptor_;
-}
-
-const DataRecord& DataRecord::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-DataRecord* DataRecord::default_instance_ = NULL;
-
-DataRecord* DataRecord::New() const {
-  return new DataRecord;
+  _impl_._cached_size_.Set(size);
 }
 
 void DataRecord::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 255) {
-    if (has_time()) {
-      if (time_ != NULL) time_->::mixr::recorder::pb::Time::Clear();
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.DataRecord)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.time_ != nullptr);
+      _impl_.time_->Clear();
     }
-    id_ = 0u;
-    if (has_file_id_msg()) {
-      if (file_id_msg_ != NULL) file_id_msg_->::mixr::recorder::pb::FileIdMsg::Clear();
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.file_id_msg_ != nullptr);
+      _impl_.file_id_msg_->Clear();
     }
-    if (has_unknown_id_msg()) {
-      if (unknown_id_msg_ != NULL) unknown_id_msg_->::mixr::recorder::pb::UnknownIdMsg::Clear();
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.unknown_id_msg_ != nullptr);
+      _impl_.unknown_id_msg_->Clear();
     }
-    if (has_marker_msg()) {
-      if (marker_msg_ != NULL) marker_msg_->::mixr::recorder::pb::MarkerMsg::Clear();
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.marker_msg_ != nullptr);
+      _impl_.marker_msg_->Clear();
     }
-    if (has_input_device_msg()) {
-      if (input_device_msg_ != NULL) input_device_msg_->::mixr::recorder::pb::InputDeviceMsg::Clear();
+    if (cached_has_bits & 0x00000010u) {
+      GOOGLE_DCHECK(_impl_.input_device_msg_ != nullptr);
+      _impl_.input_device_msg_->Clear();
     }
-    if (has_new_player_event_msg()) {
-      if (new_player_event_msg_ != NULL) new_player_event_msg_->::mixr::recorder::pb::NewPlayerEventMsg::Clear();
+    if (cached_has_bits & 0x00000020u) {
+      GOOGLE_DCHECK(_impl_.new_player_event_msg_ != nullptr);
+      _impl_.new_player_event_msg_->Clear();
     }
-    if (has_player_removed_event_msg()) {
-      if (player_removed_event_msg_ != NULL) player_removed_event_msg_->::mixr::recorder::pb::PlayerRemovedEventMsg::Clear();
+    if (cached_has_bits & 0x00000040u) {
+      GOOGLE_DCHECK(_impl_.player_removed_event_msg_ != nullptr);
+      _impl_.player_removed_event_msg_->Clear();
+    }
+    if (cached_has_bits & 0x00000080u) {
+      GOOGLE_DCHECK(_impl_.player_data_msg_ != nullptr);
+      _impl_.player_data_msg_->Clear();
     }
   }
-  if (_has_bits_[8 / 32] & 65280) {
-    if (has_player_data_msg()) {
-      if (player_data_msg_ != NULL) player_data_msg_->::mixr::recorder::pb::PlayerDataMsg::Clear();
+  if (cached_has_bits & 0x0000ff00u) {
+    if (cached_has_bits & 0x00000100u) {
+      GOOGLE_DCHECK(_impl_.player_damaged_event_msg_ != nullptr);
+      _impl_.player_damaged_event_msg_->Clear();
     }
-    if (has_player_damaged_event_msg()) {
-      if (player_damaged_event_msg_ != NULL) player_damaged_event_msg_->::mixr::recorder::pb::PlayerDamagedEventMsg::Clear();
+    if (cached_has_bits & 0x00000200u) {
+      GOOGLE_DCHECK(_impl_.player_collision_event_msg_ != nullptr);
+      _impl_.player_collision_event_msg_->Clear();
     }
-    if (has_player_collision_event_msg()) {
-      if (player_collision_event_msg_ != NULL) player_collision_event_msg_->::mixr::recorder::pb::PlayerCollisionEventMsg::Clear();
+    if (cached_has_bits & 0x00000400u) {
+      GOOGLE_DCHECK(_impl_.player_crash_event_msg_ != nullptr);
+      _impl_.player_crash_event_msg_->Clear();
     }
-    if (has_player_crash_event_msg()) {
-      if (player_crash_event_msg_ != NULL) player_crash_event_msg_->::mixr::recorder::pb::PlayerCrashEventMsg::Clear();
+    if (cached_has_bits & 0x00000800u) {
+      GOOGLE_DCHECK(_impl_.player_killed_event_msg_ != nullptr);
+      _impl_.player_killed_event_msg_->Clear();
     }
-    if (has_player_killed_event_msg()) {
-      if (player_killed_event_msg_ != NULL) player_killed_event_msg_->::mixr::recorder::pb::PlayerKilledEventMsg::Clear();
+    if (cached_has_bits & 0x00001000u) {
+      GOOGLE_DCHECK(_impl_.player_frame_msg_ != nullptr);
+      _impl_.player_frame_msg_->Clear();
     }
-    if (has_weapon_release_event_msg()) {
-      if (weapon_release_event_msg_ != NULL) weapon_release_event_msg_->::mixr::recorder::pb::WeaponReleaseEventMsg::Clear();
+    if (cached_has_bits & 0x00002000u) {
+      GOOGLE_DCHECK(_impl_.weapon_release_event_msg_ != nullptr);
+      _impl_.weapon_release_event_msg_->Clear();
     }
-    if (has_weapon_hung_event_msg()) {
-      if (weapon_hung_event_msg_ != NULL) weapon_hung_event_msg_->::mixr::recorder::pb::WeaponHungEventMsg::Clear();
+    if (cached_has_bits & 0x00004000u) {
+      GOOGLE_DCHECK(_impl_.weapon_hung_event_msg_ != nullptr);
+      _impl_.weapon_hung_event_msg_->Clear();
     }
-    if (has_weapon_detonation_event_msg()) {
-      if (weapon_detonation_event_msg_ != NULL) weapon_detonation_event_msg_->::mixr::recorder::pb::WeaponDetonationEventMsg::Clear();
+    if (cached_has_bits & 0x00008000u) {
+      GOOGLE_DCHECK(_impl_.weapon_detonation_event_msg_ != nullptr);
+      _impl_.weapon_detonation_event_msg_->Clear();
     }
   }
-  if (_has_bits_[16 / 32] & 983040) {
-    if (has_gun_fired_event_msg()) {
-      if (gun_fired_event_msg_ != NULL) gun_fired_event_msg_->::mixr::recorder::pb::GunFiredEventMsg::Clear();
+  if (cached_has_bits & 0x000f0000u) {
+    if (cached_has_bits & 0x00010000u) {
+      GOOGLE_DCHECK(_impl_.gun_fired_event_msg_ != nullptr);
+      _impl_.gun_fired_event_msg_->Clear();
     }
-    if (has_new_track_event_msg()) {
-      if (new_track_event_msg_ != NULL) new_track_event_msg_->::mixr::recorder::pb::NewTrackEventMsg::Clear();
+    if (cached_has_bits & 0x00020000u) {
+      GOOGLE_DCHECK(_impl_.new_track_event_msg_ != nullptr);
+      _impl_.new_track_event_msg_->Clear();
     }
-    if (has_track_removed_event_msg()) {
-      if (track_removed_event_msg_ != NULL) track_removed_event_msg_->::mixr::recorder::pb::TrackRemovedEventMsg::Clear();
+    if (cached_has_bits & 0x00040000u) {
+      GOOGLE_DCHECK(_impl_.track_removed_event_msg_ != nullptr);
+      _impl_.track_removed_event_msg_->Clear();
     }
-    if (has_track_data_msg()) {
-      if (track_data_msg_ != NULL) track_data_msg_->::mixr::recorder::pb::TrackDataMsg::Clear();
+    if (cached_has_bits & 0x00080000u) {
+      GOOGLE_DCHECK(_impl_.track_data_msg_ != nullptr);
+      _impl_.track_data_msg_->Clear();
     }
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  _impl_.id_ = 0u;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-bool DataRecord::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.DataRecord)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(16383);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* DataRecord::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.Time time = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_time()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_time(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(16)) goto parse_id;
-        break;
-      }
-
+        continue;
       // required uint32 id = 2;
-      case 2: {
-        if (tag == 16) {
-         parse_id:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &id_)));
-          set_has_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(90)) goto parse_file_id_msg;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.FileIdMsg file_id_msg = 11;
-      case 11: {
-        if (tag == 90) {
-         parse_file_id_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_file_id_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(106)) goto parse_unknown_id_msg;
-        break;
-      }
-
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 90)) {
+          ptr = ctx->ParseMessage(_internal_mutable_file_id_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.UnknownIdMsg unknown_id_msg = 13;
-      case 13: {
-        if (tag == 106) {
-         parse_unknown_id_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_unknown_id_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(114)) goto parse_marker_msg;
-        break;
-      }
-
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 106)) {
+          ptr = ctx->ParseMessage(_internal_mutable_unknown_id_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.MarkerMsg marker_msg = 14;
-      case 14: {
-        if (tag == 114) {
-         parse_marker_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_marker_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(122)) goto parse_input_device_msg;
-        break;
-      }
-
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 114)) {
+          ptr = ctx->ParseMessage(_internal_mutable_marker_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.InputDeviceMsg input_device_msg = 15;
-      case 15: {
-        if (tag == 122) {
-         parse_input_device_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_input_device_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(250)) goto parse_new_player_event_msg;
-        break;
-      }
-
+      case 15:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 122)) {
+          ptr = ctx->ParseMessage(_internal_mutable_input_device_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.NewPlayerEventMsg new_player_event_msg = 31;
-      case 31: {
-        if (tag == 250) {
-         parse_new_player_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_new_player_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(258)) goto parse_player_removed_event_msg;
-        break;
-      }
-
+      case 31:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 250)) {
+          ptr = ctx->ParseMessage(_internal_mutable_new_player_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerRemovedEventMsg player_removed_event_msg = 32;
-      case 32: {
-        if (tag == 258) {
-         parse_player_removed_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_removed_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(266)) goto parse_player_data_msg;
-        break;
-      }
-
+      case 32:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 2)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_removed_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerDataMsg player_data_msg = 33;
-      case 33: {
-        if (tag == 266) {
-         parse_player_data_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_data_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(274)) goto parse_player_damaged_event_msg;
-        break;
-      }
-
+      case 33:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_data_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerDamagedEventMsg player_damaged_event_msg = 34;
-      case 34: {
-        if (tag == 274) {
-         parse_player_damaged_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_damaged_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(282)) goto parse_player_collision_event_msg;
-        break;
-      }
-
+      case 34:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_damaged_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerCollisionEventMsg player_collision_event_msg = 35;
-      case 35: {
-        if (tag == 282) {
-         parse_player_collision_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_collision_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(290)) goto parse_player_crash_event_msg;
-        break;
-      }
-
+      case 35:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_collision_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerCrashEventMsg player_crash_event_msg = 36;
-      case 36: {
-        if (tag == 290) {
-         parse_player_crash_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_crash_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(298)) goto parse_player_killed_event_msg;
-        break;
-      }
-
+      case 36:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_crash_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerKilledEventMsg player_killed_event_msg = 37;
-      case 37: {
-        if (tag == 298) {
-         parse_player_killed_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_killed_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(410)) goto parse_weapon_release_event_msg;
-        break;
-      }
-
+      case 37:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_killed_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerFrameMsg player_frame_msg = 38;
+      case 38:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_frame_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.WeaponReleaseEventMsg weapon_release_event_msg = 51;
-      case 51: {
-        if (tag == 410) {
-         parse_weapon_release_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_weapon_release_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(418)) goto parse_weapon_hung_event_msg;
-        break;
-      }
-
+      case 51:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 154)) {
+          ptr = ctx->ParseMessage(_internal_mutable_weapon_release_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.WeaponHungEventMsg weapon_hung_event_msg = 52;
-      case 52: {
-        if (tag == 418) {
-         parse_weapon_hung_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_weapon_hung_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(426)) goto parse_weapon_detonation_event_msg;
-        break;
-      }
-
+      case 52:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 162)) {
+          ptr = ctx->ParseMessage(_internal_mutable_weapon_hung_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.WeaponDetonationEventMsg weapon_detonation_event_msg = 53;
-      case 53: {
-        if (tag == 426) {
-         parse_weapon_detonation_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_weapon_detonation_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(434)) goto parse_gun_fired_event_msg;
-        break;
-      }
-
+      case 53:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 170)) {
+          ptr = ctx->ParseMessage(_internal_mutable_weapon_detonation_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.GunFiredEventMsg gun_fired_event_msg = 54;
-      case 54: {
-        if (tag == 434) {
-         parse_gun_fired_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_gun_fired_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(570)) goto parse_new_track_event_msg;
-        break;
-      }
-
+      case 54:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 178)) {
+          ptr = ctx->ParseMessage(_internal_mutable_gun_fired_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.NewTrackEventMsg new_track_event_msg = 71;
-      case 71: {
-        if (tag == 570) {
-         parse_new_track_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_new_track_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(578)) goto parse_track_removed_event_msg;
-        break;
-      }
-
+      case 71:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr = ctx->ParseMessage(_internal_mutable_new_track_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.TrackRemovedEventMsg track_removed_event_msg = 72;
-      case 72: {
-        if (tag == 578) {
-         parse_track_removed_event_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_track_removed_event_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(586)) goto parse_track_data_msg;
-        break;
-      }
-
+      case 72:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          ptr = ctx->ParseMessage(_internal_mutable_track_removed_event_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.TrackDataMsg track_data_msg = 73;
-      case 73: {
-        if (tag == 586) {
-         parse_track_data_msg:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_track_data_msg()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((4000u <= tag && tag < 8000u) ||
-            (8000u <= tag && tag < 80000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.DataRecord)
-  return true;
+      case 73:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          ptr = ctx->ParseMessage(_internal_mutable_track_data_msg(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((4000u <= tag && tag < 8000u) ||
+        (8000u <= tag && tag < 80000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.DataRecord)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void DataRecord::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.DataRecord)
+uint8_t* DataRecord::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.DataRecord)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.Time time = 1;
-  if (has_time()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->time(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::time(this),
+        _Internal::time(this).GetCachedSize(), target, stream);
   }
 
   // required uint32 id = 2;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->id(), output);
+  if (cached_has_bits & 0x00100000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_id(), target);
   }
 
   // optional .mixr.recorder.pb.FileIdMsg file_id_msg = 11;
-  if (has_file_id_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      11, this->file_id_msg(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(11, _Internal::file_id_msg(this),
+        _Internal::file_id_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.UnknownIdMsg unknown_id_msg = 13;
-  if (has_unknown_id_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      13, this->unknown_id_msg(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(13, _Internal::unknown_id_msg(this),
+        _Internal::unknown_id_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.MarkerMsg marker_msg = 14;
-  if (has_marker_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      14, this->marker_msg(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(14, _Internal::marker_msg(this),
+        _Internal::marker_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.InputDeviceMsg input_device_msg = 15;
-  if (has_input_device_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      15, this->input_device_msg(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(15, _Internal::input_device_msg(this),
+        _Internal::input_device_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.NewPlayerEventMsg new_player_event_msg = 31;
-  if (has_new_player_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      31, this->new_player_event_msg(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(31, _Internal::new_player_event_msg(this),
+        _Internal::new_player_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerRemovedEventMsg player_removed_event_msg = 32;
-  if (has_player_removed_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      32, this->player_removed_event_msg(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(32, _Internal::player_removed_event_msg(this),
+        _Internal::player_removed_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerDataMsg player_data_msg = 33;
-  if (has_player_data_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      33, this->player_data_msg(), output);
+  if (cached_has_bits & 0x00000080u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(33, _Internal::player_data_msg(this),
+        _Internal::player_data_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerDamagedEventMsg player_damaged_event_msg = 34;
-  if (has_player_damaged_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      34, this->player_damaged_event_msg(), output);
+  if (cached_has_bits & 0x00000100u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(34, _Internal::player_damaged_event_msg(this),
+        _Internal::player_damaged_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerCollisionEventMsg player_collision_event_msg = 35;
-  if (has_player_collision_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      35, this->player_collision_event_msg(), output);
+  if (cached_has_bits & 0x00000200u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(35, _Internal::player_collision_event_msg(this),
+        _Internal::player_collision_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerCrashEventMsg player_crash_event_msg = 36;
-  if (has_player_crash_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      36, this->player_crash_event_msg(), output);
+  if (cached_has_bits & 0x00000400u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(36, _Internal::player_crash_event_msg(this),
+        _Internal::player_crash_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerKilledEventMsg player_killed_event_msg = 37;
-  if (has_player_killed_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      37, this->player_killed_event_msg(), output);
+  if (cached_has_bits & 0x00000800u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(37, _Internal::player_killed_event_msg(this),
+        _Internal::player_killed_event_msg(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .mixr.recorder.pb.PlayerFrameMsg player_frame_msg = 38;
+  if (cached_has_bits & 0x00001000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(38, _Internal::player_frame_msg(this),
+        _Internal::player_frame_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.WeaponReleaseEventMsg weapon_release_event_msg = 51;
-  if (has_weapon_release_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      51, this->weapon_release_event_msg(), output);
+  if (cached_has_bits & 0x00002000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(51, _Internal::weapon_release_event_msg(this),
+        _Internal::weapon_release_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.WeaponHungEventMsg weapon_hung_event_msg = 52;
-  if (has_weapon_hung_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      52, this->weapon_hung_event_msg(), output);
+  if (cached_has_bits & 0x00004000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(52, _Internal::weapon_hung_event_msg(this),
+        _Internal::weapon_hung_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.WeaponDetonationEventMsg weapon_detonation_event_msg = 53;
-  if (has_weapon_detonation_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      53, this->weapon_detonation_event_msg(), output);
+  if (cached_has_bits & 0x00008000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(53, _Internal::weapon_detonation_event_msg(this),
+        _Internal::weapon_detonation_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.GunFiredEventMsg gun_fired_event_msg = 54;
-  if (has_gun_fired_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      54, this->gun_fired_event_msg(), output);
+  if (cached_has_bits & 0x00010000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(54, _Internal::gun_fired_event_msg(this),
+        _Internal::gun_fired_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.NewTrackEventMsg new_track_event_msg = 71;
-  if (has_new_track_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      71, this->new_track_event_msg(), output);
+  if (cached_has_bits & 0x00020000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(71, _Internal::new_track_event_msg(this),
+        _Internal::new_track_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.TrackRemovedEventMsg track_removed_event_msg = 72;
-  if (has_track_removed_event_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      72, this->track_removed_event_msg(), output);
+  if (cached_has_bits & 0x00040000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(72, _Internal::track_removed_event_msg(this),
+        _Internal::track_removed_event_msg(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.TrackDataMsg track_data_msg = 73;
-  if (has_track_data_msg()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      73, this->track_data_msg(), output);
+  if (cached_has_bits & 0x00080000u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(73, _Internal::track_data_msg(this),
+        _Internal::track_data_msg(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [500, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      500, 1000, output);
-
-  // Extension range [1000, 10000)
-  _extensions_.SerializeWithCachedSizes(
-      1000, 10000, output);
+  // Extension range [500, 10000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 500, 10000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.DataRecord)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.DataRecord)
+  return target;
 }
 
-::google::protobuf::uint8* DataRecord::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.DataRecord)
-  // required .mixr.recorder.pb.Time time = 1;
-  if (has_time()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->time(), target);
-  }
-
-  // required uint32 id = 2;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->id(), target);
-  }
-
-  // optional .mixr.recorder.pb.FileIdMsg file_id_msg = 11;
-  if (has_file_id_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        11, this->file_id_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.UnknownIdMsg unknown_id_msg = 13;
-  if (has_unknown_id_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        13, this->unknown_id_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.MarkerMsg marker_msg = 14;
-  if (has_marker_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        14, this->marker_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.InputDeviceMsg input_device_msg = 15;
-  if (has_input_device_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        15, this->input_device_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.NewPlayerEventMsg new_player_event_msg = 31;
-  if (has_new_player_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        31, this->new_player_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerRemovedEventMsg player_removed_event_msg = 32;
-  if (has_player_removed_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        32, this->player_removed_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerDataMsg player_data_msg = 33;
-  if (has_player_data_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        33, this->player_data_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerDamagedEventMsg player_damaged_event_msg = 34;
-  if (has_player_damaged_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        34, this->player_damaged_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerCollisionEventMsg player_collision_event_msg = 35;
-  if (has_player_collision_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        35, this->player_collision_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerCrashEventMsg player_crash_event_msg = 36;
-  if (has_player_crash_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        36, this->player_crash_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerKilledEventMsg player_killed_event_msg = 37;
-  if (has_player_killed_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        37, this->player_killed_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.WeaponReleaseEventMsg weapon_release_event_msg = 51;
-  if (has_weapon_release_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        51, this->weapon_release_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.WeaponHungEventMsg weapon_hung_event_msg = 52;
-  if (has_weapon_hung_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        52, this->weapon_hung_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.WeaponDetonationEventMsg weapon_detonation_event_msg = 53;
-  if (has_weapon_detonation_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        53, this->weapon_detonation_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.GunFiredEventMsg gun_fired_event_msg = 54;
-  if (has_gun_fired_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        54, this->gun_fired_event_msg(), target);
-  }
-
-  // optional .mixr.recorder.pb.NewTrackEventMsg new_track_event_msg = 71;
-  if (has_new_track_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        71, this->new_track_event_msg(), target);
-  }
+size_t DataRecord::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.DataRecord)
+  size_t total_size = 0;
 
-  // optional .mixr.recorder.pb.TrackRemovedEventMsg track_removed_event_msg = 72;
-  if (has_track_removed_event_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        72, this->track_removed_event_msg(), target);
+  if (_internal_has_time()) {
+    // required .mixr.recorder.pb.Time time = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.time_);
   }
 
-  // optional .mixr.recorder.pb.TrackDataMsg track_data_msg = 73;
-  if (has_track_data_msg()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        73, this->track_data_msg(), target);
+  if (_internal_has_id()) {
+    // required uint32 id = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
   }
 
-  // Extension range [500, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      500, 1000, target);
-
-  // Extension range [1000, 10000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      1000, 10000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.DataRecord)
-  return target;
+  return total_size;
 }
+size_t DataRecord::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.DataRecord)
+  size_t total_size = 0;
 
-int DataRecord::ByteSize() const {
-  int total_size = 0;
+  total_size += _impl_._extensions_.ByteSize();
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x00100001) ^ 0x00100001) == 0) {  // All required fields are present.
     // required .mixr.recorder.pb.Time time = 1;
-    if (has_time()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->time());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.time_);
 
     // required uint32 id = 2;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->id());
-    }
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000feu) {
     // optional .mixr.recorder.pb.FileIdMsg file_id_msg = 11;
-    if (has_file_id_msg()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->file_id_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.file_id_msg_);
     }
 
     // optional .mixr.recorder.pb.UnknownIdMsg unknown_id_msg = 13;
-    if (has_unknown_id_msg()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->unknown_id_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.unknown_id_msg_);
     }
 
     // optional .mixr.recorder.pb.MarkerMsg marker_msg = 14;
-    if (has_marker_msg()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->marker_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.marker_msg_);
     }
 
     // optional .mixr.recorder.pb.InputDeviceMsg input_device_msg = 15;
-    if (has_input_device_msg()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->input_device_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.input_device_msg_);
     }
 
     // optional .mixr.recorder.pb.NewPlayerEventMsg new_player_event_msg = 31;
-    if (has_new_player_event_msg()) {
+    if (cached_has_bits & 0x00000020u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->new_player_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.new_player_event_msg_);
     }
 
     // optional .mixr.recorder.pb.PlayerRemovedEventMsg player_removed_event_msg = 32;
-    if (has_player_removed_event_msg()) {
+    if (cached_has_bits & 0x00000040u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_removed_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_removed_event_msg_);
     }
 
-  }
-  if (_has_bits_[8 / 32] & (0xffu << (8 % 32))) {
     // optional .mixr.recorder.pb.PlayerDataMsg player_data_msg = 33;
-    if (has_player_data_msg()) {
+    if (cached_has_bits & 0x00000080u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_data_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_data_msg_);
     }
 
+  }
+  if (cached_has_bits & 0x0000ff00u) {
     // optional .mixr.recorder.pb.PlayerDamagedEventMsg player_damaged_event_msg = 34;
-    if (has_player_damaged_event_msg()) {
+    if (cached_has_bits & 0x00000100u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_damaged_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_damaged_event_msg_);
     }
 
     // optional .mixr.recorder.pb.PlayerCollisionEventMsg player_collision_event_msg = 35;
-    if (has_player_collision_event_msg()) {
+    if (cached_has_bits & 0x00000200u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_collision_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_collision_event_msg_);
     }
 
     // optional .mixr.recorder.pb.PlayerCrashEventMsg player_crash_event_msg = 36;
-    if (has_player_crash_event_msg()) {
+    if (cached_has_bits & 0x00000400u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_crash_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_crash_event_msg_);
     }
 
     // optional .mixr.recorder.pb.PlayerKilledEventMsg player_killed_event_msg = 37;
-    if (has_player_killed_event_msg()) {
+    if (cached_has_bits & 0x00000800u) {
+      total_size += 2 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_killed_event_msg_);
+    }
+
+    // optional .mixr.recorder.pb.PlayerFrameMsg player_frame_msg = 38;
+    if (cached_has_bits & 0x00001000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_killed_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_frame_msg_);
     }
 
     // optional .mixr.recorder.pb.WeaponReleaseEventMsg weapon_release_event_msg = 51;
-    if (has_weapon_release_event_msg()) {
+    if (cached_has_bits & 0x00002000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->weapon_release_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.weapon_release_event_msg_);
     }
 
     // optional .mixr.recorder.pb.WeaponHungEventMsg weapon_hung_event_msg = 52;
-    if (has_weapon_hung_event_msg()) {
+    if (cached_has_bits & 0x00004000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->weapon_hung_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.weapon_hung_event_msg_);
     }
 
     // optional .mixr.recorder.pb.WeaponDetonationEventMsg weapon_detonation_event_msg = 53;
-    if (has_weapon_detonation_event_msg()) {
+    if (cached_has_bits & 0x00008000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->weapon_detonation_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.weapon_detonation_event_msg_);
     }
 
   }
-  if (_has_bits_[16 / 32] & (0xffu << (16 % 32))) {
+  if (cached_has_bits & 0x000f0000u) {
     // optional .mixr.recorder.pb.GunFiredEventMsg gun_fired_event_msg = 54;
-    if (has_gun_fired_event_msg()) {
+    if (cached_has_bits & 0x00010000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->gun_fired_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.gun_fired_event_msg_);
     }
 
     // optional .mixr.recorder.pb.NewTrackEventMsg new_track_event_msg = 71;
-    if (has_new_track_event_msg()) {
+    if (cached_has_bits & 0x00020000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->new_track_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.new_track_event_msg_);
     }
 
     // optional .mixr.recorder.pb.TrackRemovedEventMsg track_removed_event_msg = 72;
-    if (has_track_removed_event_msg()) {
+    if (cached_has_bits & 0x00040000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->track_removed_event_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.track_removed_event_msg_);
     }
 
     // optional .mixr.recorder.pb.TrackDataMsg track_data_msg = 73;
-    if (has_track_data_msg()) {
+    if (cached_has_bits & 0x00080000u) {
       total_size += 2 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->track_data_msg());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.track_data_msg_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void DataRecord::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const DataRecord* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const DataRecord*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData DataRecord::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    DataRecord::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*DataRecord::GetClassData() const { return &_class_data_; }
 
-void DataRecord::MergeFrom(const DataRecord& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_time()) {
-      mutable_time()->::mixr::recorder::pb::Time::MergeFrom(from.time());
+
+void DataRecord::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<DataRecord*>(&to_msg);
+  auto& from = static_cast<const DataRecord&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.DataRecord)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_time()->::mixr::recorder::pb::Time::MergeFrom(
+          from._internal_time());
     }
-    if (from.has_id()) {
-      set_id(from.id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_file_id_msg()->::mixr::recorder::pb::FileIdMsg::MergeFrom(
+          from._internal_file_id_msg());
     }
-    if (from.has_file_id_msg()) {
-      mutable_file_id_msg()->::mixr::recorder::pb::FileIdMsg::MergeFrom(from.file_id_msg());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_unknown_id_msg()->::mixr::recorder::pb::UnknownIdMsg::MergeFrom(
+          from._internal_unknown_id_msg());
     }
-    if (from.has_unknown_id_msg()) {
-      mutable_unknown_id_msg()->::mixr::recorder::pb::UnknownIdMsg::MergeFrom(from.unknown_id_msg());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_marker_msg()->::mixr::recorder::pb::MarkerMsg::MergeFrom(
+          from._internal_marker_msg());
     }
-    if (from.has_marker_msg()) {
-      mutable_marker_msg()->::mixr::recorder::pb::MarkerMsg::MergeFrom(from.marker_msg());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_internal_mutable_input_device_msg()->::mixr::recorder::pb::InputDeviceMsg::MergeFrom(
+          from._internal_input_device_msg());
     }
-    if (from.has_input_device_msg()) {
-      mutable_input_device_msg()->::mixr::recorder::pb::InputDeviceMsg::MergeFrom(from.input_device_msg());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_internal_mutable_new_player_event_msg()->::mixr::recorder::pb::NewPlayerEventMsg::MergeFrom(
+          from._internal_new_player_event_msg());
     }
-    if (from.has_new_player_event_msg()) {
-      mutable_new_player_event_msg()->::mixr::recorder::pb::NewPlayerEventMsg::MergeFrom(from.new_player_event_msg());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_internal_mutable_player_removed_event_msg()->::mixr::recorder::pb::PlayerRemovedEventMsg::MergeFrom(
+          from._internal_player_removed_event_msg());
     }
-    if (from.has_player_removed_event_msg()) {
-      mutable_player_removed_event_msg()->::mixr::recorder::pb::PlayerRemovedEventMsg::MergeFrom(from.player_removed_event_msg());
+    if (cached_has_bits & 0x00000080u) {
+      _this->_internal_mutable_player_data_msg()->::mixr::recorder::pb::PlayerDataMsg::MergeFrom(
+          from._internal_player_data_msg());
     }
   }
-  if (from._has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    if (from.has_player_data_msg()) {
-      mutable_player_data_msg()->::mixr::recorder::pb::PlayerDataMsg::MergeFrom(from.player_data_msg());
+  if (cached_has_bits & 0x0000ff00u) {
+    if (cached_has_bits & 0x00000100u) {
+      _this->_internal_mutable_player_damaged_event_msg()->::mixr::recorder::pb::PlayerDamagedEventMsg::MergeFrom(
+          from._internal_player_damaged_event_msg());
     }
-    if (from.has_player_damaged_event_msg()) {
-      mutable_player_damaged_event_msg()->::mixr::recorder::pb::PlayerDamagedEventMsg::MergeFrom(from.player_damaged_event_msg());
+    if (cached_has_bits & 0x00000200u) {
+      _this->_internal_mutable_player_collision_event_msg()->::mixr::recorder::pb::PlayerCollisionEventMsg::MergeFrom(
+          from._internal_player_collision_event_msg());
     }
-    if (from.has_player_collision_event_msg()) {
-      mutable_player_collision_event_msg()->::mixr::recorder::pb::PlayerCollisionEventMsg::MergeFrom(from.player_collision_event_msg());
+    if (cached_has_bits & 0x00000400u) {
+      _this->_internal_mutable_player_crash_event_msg()->::mixr::recorder::pb::PlayerCrashEventMsg::MergeFrom(
+          from._internal_player_crash_event_msg());
     }
-    if (from.has_player_crash_event_msg()) {
-      mutable_player_crash_event_msg()->::mixr::recorder::pb::PlayerCrashEventMsg::MergeFrom(from.player_crash_event_msg());
+    if (cached_has_bits & 0x00000800u) {
+      _this->_internal_mutable_player_killed_event_msg()->::mixr::recorder::pb::PlayerKilledEventMsg::MergeFrom(
+          from._internal_player_killed_event_msg());
     }
-    if (from.has_player_killed_event_msg()) {
-      mutable_player_killed_event_msg()->::mixr::recorder::pb::PlayerKilledEventMsg::MergeFrom(from.player_killed_event_msg());
+    if (cached_has_bits & 0x00001000u) {
+      _this->_internal_mutable_player_frame_msg()->::mixr::recorder::pb::PlayerFrameMsg::MergeFrom(
+          from._internal_player_frame_msg());
     }
-    if (from.has_weapon_release_event_msg()) {
-      mutable_weapon_release_event_msg()->::mixr::recorder::pb::WeaponReleaseEventMsg::MergeFrom(from.weapon_release_event_msg());
+    if (cached_has_bits & 0x00002000u) {
+      _this->_internal_mutable_weapon_release_event_msg()->::mixr::recorder::pb::WeaponReleaseEventMsg::MergeFrom(
+          from._internal_weapon_release_event_msg());
     }
-    if (from.has_weapon_hung_event_msg()) {
-      mutable_weapon_hung_event_msg()->::mixr::recorder::pb::WeaponHungEventMsg::MergeFrom(from.weapon_hung_event_msg());
+    if (cached_has_bits & 0x00004000u) {
+      _this->_internal_mutable_weapon_hung_event_msg()->::mixr::recorder::pb::WeaponHungEventMsg::MergeFrom(
+          from._internal_weapon_hung_event_msg());
     }
-    if (from.has_weapon_detonation_event_msg()) {
-      mutable_weapon_detonation_event_msg()->::mixr::recorder::pb::WeaponDetonationEventMsg::MergeFrom(from.weapon_detonation_event_msg());
+    if (cached_has_bits & 0x00008000u) {
+      _this->_internal_mutable_weapon_detonation_event_msg()->::mixr::recorder::pb::WeaponDetonationEventMsg::MergeFrom(
+          from._internal_weapon_detonation_event_msg());
     }
   }
-  if (from._has_bits_[16 / 32] & (0xffu << (16 % 32))) {
-    if (from.has_gun_fired_event_msg()) {
-      mutable_gun_fired_event_msg()->::mixr::recorder::pb::GunFiredEventMsg::MergeFrom(from.gun_fired_event_msg());
+  if (cached_has_bits & 0x001f0000u) {
+    if (cached_has_bits & 0x00010000u) {
+      _this->_internal_mutable_gun_fired_event_msg()->::mixr::recorder::pb::GunFiredEventMsg::MergeFrom(
+          from._internal_gun_fired_event_msg());
     }
-    if (from.has_new_track_event_msg()) {
-      mutable_new_track_event_msg()->::mixr::recorder::pb::NewTrackEventMsg::MergeFrom(from.new_track_event_msg());
+    if (cached_has_bits & 0x00020000u) {
+      _this->_internal_mutable_new_track_event_msg()->::mixr::recorder::pb::NewTrackEventMsg::MergeFrom(
+          from._internal_new_track_event_msg());
     }
-    if (from.has_track_removed_event_msg()) {
-      mutable_track_removed_event_msg()->::mixr::recorder::pb::TrackRemovedEventMsg::MergeFrom(from.track_removed_event_msg());
+    if (cached_has_bits & 0x00040000u) {
+      _this->_internal_mutable_track_removed_event_msg()->::mixr::recorder::pb::TrackRemovedEventMsg::MergeFrom(
+          from._internal_track_removed_event_msg());
     }
-    if (from.has_track_data_msg()) {
-      mutable_track_data_msg()->::mixr::recorder::pb::TrackDataMsg::MergeFrom(from.track_data_msg());
+    if (cached_has_bits & 0x00080000u) {
+      _this->_internal_mutable_track_data_msg()->::mixr::recorder::pb::TrackDataMsg::MergeFrom(
+          from._internal_track_data_msg());
     }
+    if (cached_has_bits & 0x00100000u) {
+      _this->_impl_.id_ = from._impl_.id_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void DataRecord::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void DataRecord::CopyFrom(const DataRecord& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.DataRecord)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool DataRecord::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_time()) {
-    if (!this->time().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_time()) {
+    if (!_impl_.time_->IsInitialized()) return false;
   }
-  if (has_file_id_msg()) {
-    if (!this->file_id_msg().IsInitialized()) return false;
+  if (_internal_has_file_id_msg()) {
+    if (!_impl_.file_id_msg_->IsInitialized()) return false;
   }
-  if (has_unknown_id_msg()) {
-    if (!this->unknown_id_msg().IsInitialized()) return false;
+  if (_internal_has_unknown_id_msg()) {
+    if (!_impl_.unknown_id_msg_->IsInitialized()) return false;
   }
-  if (has_marker_msg()) {
-    if (!this->marker_msg().IsInitialized()) return false;
+  if (_internal_has_marker_msg()) {
+    if (!_impl_.marker_msg_->IsInitialized()) return false;
   }
-  if (has_input_device_msg()) {
-    if (!this->input_device_msg().IsInitialized()) return false;
+  if (_internal_has_input_device_msg()) {
+    if (!_impl_.input_device_msg_->IsInitialized()) return false;
   }
-  if (has_new_player_event_msg()) {
-    if (!this->new_player_event_msg().IsInitialized()) return false;
+  if (_internal_has_new_player_event_msg()) {
+    if (!_impl_.new_player_event_msg_->IsInitialized()) return false;
   }
-  if (has_player_removed_event_msg()) {
-    if (!this->player_removed_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_removed_event_msg()) {
+    if (!_impl_.player_removed_event_msg_->IsInitialized()) return false;
   }
-  if (has_player_data_msg()) {
-    if (!this->player_data_msg().IsInitialized()) return false;
+  if (_internal_has_player_data_msg()) {
+    if (!_impl_.player_data_msg_->IsInitialized()) return false;
   }
-  if (has_player_damaged_event_msg()) {
-    if (!this->player_damaged_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_damaged_event_msg()) {
+    if (!_impl_.player_damaged_event_msg_->IsInitialized()) return false;
   }
-  if (has_player_collision_event_msg()) {
-    if (!this->player_collision_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_collision_event_msg()) {
+    if (!_impl_.player_collision_event_msg_->IsInitialized()) return false;
   }
-  if (has_player_crash_event_msg()) {
-    if (!this->player_crash_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_crash_event_msg()) {
+    if (!_impl_.player_crash_event_msg_->IsInitialized()) return false;
   }
-  if (has_player_killed_event_msg()) {
-    if (!this->player_killed_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_killed_event_msg()) {
+    if (!_impl_.player_killed_event_msg_->IsInitialized()) return false;
   }
-  if (has_weapon_release_event_msg()) {
-    if (!this->weapon_release_event_msg().IsInitialized()) return false;
+  if (_internal_has_player_frame_msg()) {
+    if (!_impl_.player_frame_msg_->IsInitialized()) return false;
   }
-  if (has_weapon_hung_event_msg()) {
-    if (!this->weapon_hung_event_msg().IsInitialized()) return false;
+  if (_internal_has_weapon_release_event_msg()) {
+    if (!_impl_.weapon_release_event_msg_->IsInitialized()) return false;
   }
-  if (has_weapon_detonation_event_msg()) {
-    if (!this->weapon_detonation_event_msg().IsInitialized()) return false;
+  if (_internal_has_weapon_hung_event_msg()) {
+    if (!_impl_.weapon_hung_event_msg_->IsInitialized()) return false;
   }
-  if (has_gun_fired_event_msg()) {
-    if (!this->gun_fired_event_msg().IsInitialized()) return false;
+  if (_internal_has_weapon_detonation_event_msg()) {
+    if (!_impl_.weapon_detonation_event_msg_->IsInitialized()) return false;
   }
-  if (has_new_track_event_msg()) {
-    if (!this->new_track_event_msg().IsInitialized()) return false;
+  if (_internal_has_gun_fired_event_msg()) {
+    if (!_impl_.gun_fired_event_msg_->IsInitialized()) return false;
   }
-  if (has_track_removed_event_msg()) {
-    if (!this->track_removed_event_msg().IsInitialized()) return false;
+  if (_internal_has_new_track_event_msg()) {
+    if (!_impl_.new_track_event_msg_->IsInitialized()) return false;
   }
-  if (has_track_data_msg()) {
-    if (!this->track_data_msg().IsInitialized()) return false;
+  if (_internal_has_track_removed_event_msg()) {
+    if (!_impl_.track_removed_event_msg_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
-}
-
-void DataRecord::Swap(DataRecord* other) {
-  if (other != this) {
-    std::swap(time_, other->time_);
-    std::swap(id_, other->id_);
-    std::swap(file_id_msg_, other->file_id_msg_);
-    std::swap(unknown_id_msg_, other->unknown_id_msg_);
-    std::swap(marker_msg_, other->marker_msg_);
-    std::swap(input_device_msg_, other->input_device_msg_);
-    std::swap(new_player_event_msg_, other->new_player_event_msg_);
-    std::swap(player_removed_event_msg_, other->player_removed_event_msg_);
-    std::swap(player_data_msg_, other->player_data_msg_);
-    std::swap(player_damaged_event_msg_, other->player_damaged_event_msg_);
-    std::swap(player_collision_event_msg_, other->player_collision_event_msg_);
-    std::swap(player_crash_event_msg_, other->player_crash_event_msg_);
-    std::swap(player_killed_event_msg_, other->player_killed_event_msg_);
-    std::swap(weapon_release_event_msg_, other->weapon_release_event_msg_);
-    std::swap(weapon_hung_event_msg_, other->weapon_hung_event_msg_);
-    std::swap(weapon_detonation_event_msg_, other->weapon_detonation_event_msg_);
-    std::swap(gun_fired_event_msg_, other->gun_fired_event_msg_);
-    std::swap(new_track_event_msg_, other->new_track_event_msg_);
-    std::swap(track_removed_event_msg_, other->track_removed_event_msg_);
-    std::swap(track_data_msg_, other->track_data_msg_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
+  if (_internal_has_track_data_msg()) {
+    if (!_impl_.track_data_msg_->IsInitialized()) return false;
   }
+  return true;
 }
 
-::google::protobuf::Metadata DataRecord::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = DataRecord_descriptor_;
-  metadata.reflection = DataRecord_reflection_;
-  return metadata;
+void DataRecord::InternalSwap(DataRecord* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(DataRecord, _impl_.id_)
+      + sizeof(DataRecord::_impl_.id_)
+      - PROTOBUF_FIELD_OFFSET(DataRecord, _impl_.time_)>(
+          reinterpret_cast<char*>(&_impl_.time_),
+          reinterpret_cast<char*>(&other->_impl_.time_));
 }
 
+::PROTOBUF_NAMESPACE_ID::Metadata DataRecord::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[0]);
+}
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int FileIdMsg::kEventNameFieldNumber;
-const int FileIdMsg::kApplicationFieldNumber;
-const int FileIdMsg::kCaseNumFieldNumber;
-const int FileIdMsg::kMissionNumFieldNumber;
-const int FileIdMsg::kSubjectNumFieldNumber;
-const int FileIdMsg::kRunNumFieldNumber;
-const int FileIdMsg::kDayFieldNumber;
-const int FileIdMsg::kMonthFieldNumber;
-const int FileIdMsg::kYearFieldNumber;
-#endif  // !_MSC_VER
-
-FileIdMsg::FileIdMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.FileIdMsg)
-}
+class FileIdMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<FileIdMsg>()._impl_._has_bits_);
+  static void set_has_event_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_application(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_case_num(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_mission_num(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_subject_num(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_run_num(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_day(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static void set_has_month(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
+  }
+  static void set_has_year(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
+  }
+};
 
-void FileIdMsg::InitAsDefaultInstance() {
+FileIdMsg::FileIdMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.FileIdMsg)
 }
-
 FileIdMsg::FileIdMsg(const FileIdMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  FileIdMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.event_name_){}
+    , decltype(_impl_.application_){}
+    , decltype(_impl_.case_num_){}
+    , decltype(_impl_.mission_num_){}
+    , decltype(_impl_.subject_num_){}
+    , decltype(_impl_.run_num_){}
+    , decltype(_impl_.day_){}
+    , decltype(_impl_.month_){}
+    , decltype(_impl_.year_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _impl_.event_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.event_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_event_name()) {
+    _this->_impl_.event_name_.Set(from._internal_event_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.application_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.application_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_application()) {
+    _this->_impl_.application_.Set(from._internal_application(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.case_num_, &from._impl_.case_num_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.year_) -
+    reinterpret_cast<char*>(&_impl_.case_num_)) + sizeof(_impl_.year_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.FileIdMsg)
 }
 
-void FileIdMsg::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  event_name_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  application_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  case_num_ = 0u;
-  mission_num_ = 0u;
-  subject_num_ = 0u;
-  run_num_ = 0u;
-  day_ = 0u;
-  month_ = 0u;
-  year_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void FileIdMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.event_name_){}
+    , decltype(_impl_.application_){}
+    , decltype(_impl_.case_num_){0u}
+    , decltype(_impl_.mission_num_){0u}
+    , decltype(_impl_.subject_num_){0u}
+    , decltype(_impl_.run_num_){0u}
+    , decltype(_impl_.day_){0u}
+    , decltype(_impl_.month_){0u}
+    , decltype(_impl_.year_){0u}
+  };
+  _impl_.event_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.event_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.application_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.application_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 FileIdMsg::~FileIdMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.FileIdMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void FileIdMsg::SharedDtor() {
-  if (event_name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete event_name_;
-  }
-  if (application_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete application_;
-  }
-  if (this != default_instance_) {
-  }
+inline void FileIdMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.event_name_.Destroy();
+  _impl_.application_.Destroy();
 }
 
 void FileIdMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* FileIdMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return FileIdMsg_descriptor_;
-}
-
-const FileIdMsg& FileIdMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-FileIdMsg* FileIdMsg::default_instance_ = NULL;
-
-FileIdMsg* FileIdMsg::New() const {
-  return new FileIdMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void FileIdMsg::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<FileIdMsg*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 255) {
-    ZR_(case_num_, month_);
-    if (has_event_name()) {
-      if (event_name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        event_name_->clear();
-      }
-    }
-    if (has_application()) {
-      if (application_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        application_->clear();
-      }
-    }
-  }
-  year_ = 0u;
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool FileIdMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.FileIdMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.FileIdMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.event_name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.application_.ClearNonDefaultToEmpty();
+    }
+  }
+  if (cached_has_bits & 0x000000fcu) {
+    ::memset(&_impl_.case_num_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.month_) -
+        reinterpret_cast<char*>(&_impl_.case_num_)) + sizeof(_impl_.month_));
+  }
+  _impl_.year_ = 0u;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* FileIdMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // optional string event_name = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_event_name()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->event_name().data(), this->event_name().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "event_name");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_application;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_event_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.FileIdMsg.event_name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional string application = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_application:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_application()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->application().data(), this->application().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "application");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(24)) goto parse_case_num;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_application();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.FileIdMsg.application");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 case_num = 3;
-      case 3: {
-        if (tag == 24) {
-         parse_case_num:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &case_num_)));
-          set_has_case_num();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(32)) goto parse_mission_num;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_case_num(&has_bits);
+          _impl_.case_num_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 mission_num = 4;
-      case 4: {
-        if (tag == 32) {
-         parse_mission_num:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &mission_num_)));
-          set_has_mission_num();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(40)) goto parse_subject_num;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_mission_num(&has_bits);
+          _impl_.mission_num_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 subject_num = 5;
-      case 5: {
-        if (tag == 40) {
-         parse_subject_num:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &subject_num_)));
-          set_has_subject_num();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(48)) goto parse_run_num;
-        break;
-      }
-
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_subject_num(&has_bits);
+          _impl_.subject_num_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 run_num = 6;
-      case 6: {
-        if (tag == 48) {
-         parse_run_num:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &run_num_)));
-          set_has_run_num();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(56)) goto parse_day;
-        break;
-      }
-
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_run_num(&has_bits);
+          _impl_.run_num_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 day = 7;
-      case 7: {
-        if (tag == 56) {
-         parse_day:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &day_)));
-          set_has_day();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(64)) goto parse_month;
-        break;
-      }
-
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _Internal::set_has_day(&has_bits);
+          _impl_.day_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 month = 8;
-      case 8: {
-        if (tag == 64) {
-         parse_month:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &month_)));
-          set_has_month();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(72)) goto parse_year;
-        break;
-      }
-
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _Internal::set_has_month(&has_bits);
+          _impl_.month_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 year = 9;
-      case 9: {
-        if (tag == 72) {
-         parse_year:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &year_)));
-          set_has_year();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.FileIdMsg)
-  return true;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          _Internal::set_has_year(&has_bits);
+          _impl_.year_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.FileIdMsg)
-  return false;
-#undef DO_
-}
-
-void FileIdMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.FileIdMsg)
-  // optional string event_name = 1;
-  if (has_event_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->event_name().data(), this->event_name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "event_name");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      1, this->event_name(), output);
-  }
-
-  // optional string application = 2;
-  if (has_application()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->application().data(), this->application().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "application");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      2, this->application(), output);
-  }
-
-  // optional uint32 case_num = 3;
-  if (has_case_num()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(3, this->case_num(), output);
-  }
-
-  // optional uint32 mission_num = 4;
-  if (has_mission_num()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->mission_num(), output);
-  }
-
-  // optional uint32 subject_num = 5;
-  if (has_subject_num()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->subject_num(), output);
-  }
-
-  // optional uint32 run_num = 6;
-  if (has_run_num()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(6, this->run_num(), output);
-  }
-
-  // optional uint32 day = 7;
-  if (has_day()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(7, this->day(), output);
-  }
-
-  // optional uint32 month = 8;
-  if (has_month()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(8, this->month(), output);
-  }
-
-  // optional uint32 year = 9;
-  if (has_year()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(9, this->year(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.FileIdMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* FileIdMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* FileIdMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.FileIdMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // optional string event_name = 1;
-  if (has_event_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->event_name().data(), this->event_name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "event_name");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        1, this->event_name(), target);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_event_name().data(), static_cast<int>(this->_internal_event_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.FileIdMsg.event_name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_event_name(), target);
   }
 
   // optional string application = 2;
-  if (has_application()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->application().data(), this->application().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "application");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        2, this->application(), target);
+  if (cached_has_bits & 0x00000002u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_application().data(), static_cast<int>(this->_internal_application().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.FileIdMsg.application");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_application(), target);
   }
 
   // optional uint32 case_num = 3;
-  if (has_case_num()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(3, this->case_num(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_case_num(), target);
   }
 
   // optional uint32 mission_num = 4;
-  if (has_mission_num()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->mission_num(), target);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_mission_num(), target);
   }
 
   // optional uint32 subject_num = 5;
-  if (has_subject_num()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->subject_num(), target);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_subject_num(), target);
   }
 
   // optional uint32 run_num = 6;
-  if (has_run_num()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(6, this->run_num(), target);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(6, this->_internal_run_num(), target);
   }
 
   // optional uint32 day = 7;
-  if (has_day()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(7, this->day(), target);
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(7, this->_internal_day(), target);
   }
 
   // optional uint32 month = 8;
-  if (has_month()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(8, this->month(), target);
+  if (cached_has_bits & 0x00000080u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(8, this->_internal_month(), target);
   }
 
   // optional uint32 year = 9;
-  if (has_year()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(9, this->year(), target);
+  if (cached_has_bits & 0x00000100u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(9, this->_internal_year(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.FileIdMsg)
   return target;
 }
 
-int FileIdMsg::ByteSize() const {
-  int total_size = 0;
+size_t FileIdMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.FileIdMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
     // optional string event_name = 1;
-    if (has_event_name()) {
+    if (cached_has_bits & 0x00000001u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->event_name());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_event_name());
     }
 
     // optional string application = 2;
-    if (has_application()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->application());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_application());
     }
 
     // optional uint32 case_num = 3;
-    if (has_case_num()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->case_num());
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_case_num());
     }
 
     // optional uint32 mission_num = 4;
-    if (has_mission_num()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->mission_num());
+    if (cached_has_bits & 0x00000008u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_mission_num());
     }
 
     // optional uint32 subject_num = 5;
-    if (has_subject_num()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->subject_num());
+    if (cached_has_bits & 0x00000010u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_subject_num());
     }
 
     // optional uint32 run_num = 6;
-    if (has_run_num()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->run_num());
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_run_num());
     }
 
     // optional uint32 day = 7;
-    if (has_day()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->day());
+    if (cached_has_bits & 0x00000040u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_day());
     }
 
     // optional uint32 month = 8;
-    if (has_month()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->month());
+    if (cached_has_bits & 0x00000080u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_month());
     }
 
   }
-  if (_has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    // optional uint32 year = 9;
-    if (has_year()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->year());
-    }
-
+  // optional uint32 year = 9;
+  if (cached_has_bits & 0x00000100u) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_year());
   }
-  total_size += _extensions_.ByteSize();
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void FileIdMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const FileIdMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const FileIdMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData FileIdMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    FileIdMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*FileIdMsg::GetClassData() const { return &_class_data_; }
+
+
+void FileIdMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<FileIdMsg*>(&to_msg);
+  auto& from = static_cast<const FileIdMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.FileIdMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void FileIdMsg::MergeFrom(const FileIdMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_event_name()) {
-      set_event_name(from.event_name());
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_event_name(from._internal_event_name());
     }
-    if (from.has_application()) {
-      set_application(from.application());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_application(from._internal_application());
     }
-    if (from.has_case_num()) {
-      set_case_num(from.case_num());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.case_num_ = from._impl_.case_num_;
     }
-    if (from.has_mission_num()) {
-      set_mission_num(from.mission_num());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.mission_num_ = from._impl_.mission_num_;
     }
-    if (from.has_subject_num()) {
-      set_subject_num(from.subject_num());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.subject_num_ = from._impl_.subject_num_;
     }
-    if (from.has_run_num()) {
-      set_run_num(from.run_num());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.run_num_ = from._impl_.run_num_;
     }
-    if (from.has_day()) {
-      set_day(from.day());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.day_ = from._impl_.day_;
     }
-    if (from.has_month()) {
-      set_month(from.month());
+    if (cached_has_bits & 0x00000080u) {
+      _this->_impl_.month_ = from._impl_.month_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  if (from._has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    if (from.has_year()) {
-      set_year(from.year());
-    }
+  if (cached_has_bits & 0x00000100u) {
+    _this->_internal_set_year(from._internal_year());
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void FileIdMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void FileIdMsg::CopyFrom(const FileIdMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.FileIdMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool FileIdMsg::IsInitialized() const {
-
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
-}
-
-void FileIdMsg::Swap(FileIdMsg* other) {
-  if (other != this) {
-    std::swap(event_name_, other->event_name_);
-    std::swap(application_, other->application_);
-    std::swap(case_num_, other->case_num_);
-    std::swap(mission_num_, other->mission_num_);
-    std::swap(subject_num_, other->subject_num_);
-    std::swap(run_num_, other->run_num_);
-    std::swap(day_, other->day_);
-    std::swap(month_, other->month_);
-    std::swap(year_, other->year_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
   }
-}
 
-::google::protobuf::Metadata FileIdMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = FileIdMsg_descriptor_;
-  metadata.reflection = FileIdMsg_reflection_;
-  return metadata;
+  return true;
 }
 
+void FileIdMsg::InternalSwap(FileIdMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.event_name_, lhs_arena,
+      &other->_impl_.event_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.application_, lhs_arena,
+      &other->_impl_.application_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(FileIdMsg, _impl_.year_)
+      + sizeof(FileIdMsg::_impl_.year_)
+      - PROTOBUF_FIELD_OFFSET(FileIdMsg, _impl_.case_num_)>(
+          reinterpret_cast<char*>(&_impl_.case_num_),
+          reinterpret_cast<char*>(&other->_impl_.case_num_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata FileIdMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[1]);
+}
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int UnknownIdMsg::kIdFieldNumber;
-#endif  // !_MSC_VER
-
-UnknownIdMsg::UnknownIdMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.UnknownIdMsg)
-}
+class UnknownIdMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<UnknownIdMsg>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-void UnknownIdMsg::InitAsDefaultInstance() {
+UnknownIdMsg::UnknownIdMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.UnknownIdMsg)
 }
-
 UnknownIdMsg::UnknownIdMsg(const UnknownIdMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  UnknownIdMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.id_ = from._impl_.id_;
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.UnknownIdMsg)
 }
 
-void UnknownIdMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void UnknownIdMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){0u}
+  };
 }
 
 UnknownIdMsg::~UnknownIdMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.UnknownIdMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void UnknownIdMsg::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void UnknownIdMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
 }
 
 void UnknownIdMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* UnknownIdMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return UnknownIdMsg_descriptor_;
-}
-
-const UnknownIdMsg& UnknownIdMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-UnknownIdMsg* UnknownIdMsg::default_instance_ = NULL;
-
-UnknownIdMsg* UnknownIdMsg::New() const {
-  return new UnknownIdMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void UnknownIdMsg::Clear() {
-  id_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool UnknownIdMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.UnknownIdMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.UnknownIdMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.id_ = 0u;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* UnknownIdMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint32 id = 1;
-      case 1: {
-        if (tag == 8) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &id_)));
-          set_has_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.UnknownIdMsg)
-  return true;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.UnknownIdMsg)
-  return false;
-#undef DO_
-}
-
-void UnknownIdMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.UnknownIdMsg)
-  // required uint32 id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->id(), output);
-  }
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.UnknownIdMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* UnknownIdMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* UnknownIdMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.UnknownIdMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_id(), target);
   }
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.UnknownIdMsg)
   return target;
 }
 
-int UnknownIdMsg::ByteSize() const {
-  int total_size = 0;
+size_t UnknownIdMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.UnknownIdMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required uint32 id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->id());
-    }
-
-  }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // required uint32 id = 1;
+  if (_internal_has_id()) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-void UnknownIdMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const UnknownIdMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const UnknownIdMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void UnknownIdMsg::MergeFrom(const UnknownIdMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      set_id(from.id());
-    }
-  }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData UnknownIdMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    UnknownIdMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*UnknownIdMsg::GetClassData() const { return &_class_data_; }
 
-void UnknownIdMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+
+void UnknownIdMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<UnknownIdMsg*>(&to_msg);
+  auto& from = static_cast<const UnknownIdMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.UnknownIdMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_has_id()) {
+    _this->_internal_set_id(from._internal_id());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void UnknownIdMsg::CopyFrom(const UnknownIdMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.UnknownIdMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool UnknownIdMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void UnknownIdMsg::Swap(UnknownIdMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void UnknownIdMsg::InternalSwap(UnknownIdMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  swap(_impl_.id_, other->_impl_.id_);
 }
 
-::google::protobuf::Metadata UnknownIdMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = UnknownIdMsg_descriptor_;
-  metadata.reflection = UnknownIdMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata UnknownIdMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[2]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int MarkerMsg::kIdFieldNumber;
-const int MarkerMsg::kSourceIdFieldNumber;
-#endif  // !_MSC_VER
-
-MarkerMsg::MarkerMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.MarkerMsg)
-}
+class MarkerMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<MarkerMsg>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_source_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
 
-void MarkerMsg::InitAsDefaultInstance() {
+MarkerMsg::MarkerMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.MarkerMsg)
 }
-
 MarkerMsg::MarkerMsg(const MarkerMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  MarkerMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){}
+    , decltype(_impl_.source_id_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.source_id_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.source_id_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.MarkerMsg)
 }
 
-void MarkerMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = 0u;
-  source_id_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void MarkerMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){0u}
+    , decltype(_impl_.source_id_){0u}
+  };
 }
 
 MarkerMsg::~MarkerMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.MarkerMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void MarkerMsg::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void MarkerMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
 }
 
 void MarkerMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* MarkerMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return MarkerMsg_descriptor_;
-}
-
-const MarkerMsg& MarkerMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-MarkerMsg* MarkerMsg::default_instance_ = NULL;
-
-MarkerMsg* MarkerMsg::New() const {
-  return new MarkerMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void MarkerMsg::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<MarkerMsg*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  ZR_(id_, source_id_);
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool MarkerMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.MarkerMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.MarkerMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.id_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.source_id_) -
+        reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.source_id_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* MarkerMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // optional uint32 id = 1;
-      case 1: {
-        if (tag == 8) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &id_)));
-          set_has_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(16)) goto parse_source_id;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 source_id = 2;
-      case 2: {
-        if (tag == 16) {
-         parse_source_id:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &source_id_)));
-          set_has_source_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.MarkerMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_source_id(&has_bits);
+          _impl_.source_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.MarkerMsg)
-  return false;
-#undef DO_
-}
-
-void MarkerMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.MarkerMsg)
-  // optional uint32 id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->id(), output);
-  }
-
-  // optional uint32 source_id = 2;
-  if (has_source_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->source_id(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.MarkerMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* MarkerMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* MarkerMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.MarkerMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // optional uint32 id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_id(), target);
   }
 
   // optional uint32 source_id = 2;
-  if (has_source_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->source_id(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_source_id(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.MarkerMsg)
   return target;
 }
 
-int MarkerMsg::ByteSize() const {
-  int total_size = 0;
+size_t MarkerMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.MarkerMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
     // optional uint32 id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->id());
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
     }
 
     // optional uint32 source_id = 2;
-    if (has_source_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->source_id());
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_source_id());
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void MarkerMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const MarkerMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const MarkerMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData MarkerMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    MarkerMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*MarkerMsg::GetClassData() const { return &_class_data_; }
+
 
-void MarkerMsg::MergeFrom(const MarkerMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      set_id(from.id());
+void MarkerMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<MarkerMsg*>(&to_msg);
+  auto& from = static_cast<const MarkerMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.MarkerMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.id_ = from._impl_.id_;
     }
-    if (from.has_source_id()) {
-      set_source_id(from.source_id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.source_id_ = from._impl_.source_id_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void MarkerMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void MarkerMsg::CopyFrom(const MarkerMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.MarkerMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool MarkerMsg::IsInitialized() const {
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void MarkerMsg::Swap(MarkerMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(source_id_, other->source_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void MarkerMsg::InternalSwap(MarkerMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(MarkerMsg, _impl_.source_id_)
+      + sizeof(MarkerMsg::_impl_.source_id_)
+      - PROTOBUF_FIELD_OFFSET(MarkerMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata MarkerMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = MarkerMsg_descriptor_;
-  metadata.reflection = MarkerMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata MarkerMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[3]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int InputDeviceMsg::kIdFieldNumber;
-const int InputDeviceMsg::kSourceIdFieldNumber;
-const int InputDeviceMsg::kValueFieldNumber;
-#endif  // !_MSC_VER
-
-InputDeviceMsg::InputDeviceMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.InputDeviceMsg)
-}
+class InputDeviceMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<InputDeviceMsg>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_source_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-void InputDeviceMsg::InitAsDefaultInstance() {
+InputDeviceMsg::InputDeviceMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.InputDeviceMsg)
 }
-
 InputDeviceMsg::InputDeviceMsg(const InputDeviceMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  InputDeviceMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){}
+    , decltype(_impl_.source_id_){}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.value_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.value_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.InputDeviceMsg)
 }
 
-void InputDeviceMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = 0u;
-  source_id_ = 0u;
-  value_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void InputDeviceMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){0u}
+    , decltype(_impl_.source_id_){0u}
+    , decltype(_impl_.value_){0}
+  };
 }
 
 InputDeviceMsg::~InputDeviceMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.InputDeviceMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void InputDeviceMsg::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void InputDeviceMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
 }
 
 void InputDeviceMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* InputDeviceMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return InputDeviceMsg_descriptor_;
-}
-
-const InputDeviceMsg& InputDeviceMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-InputDeviceMsg* InputDeviceMsg::default_instance_ = NULL;
-
-InputDeviceMsg* InputDeviceMsg::New() const {
-  return new InputDeviceMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void InputDeviceMsg::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<InputDeviceMsg*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  ZR_(id_, value_);
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool InputDeviceMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.InputDeviceMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.InputDeviceMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.id_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.value_) -
+        reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.value_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* InputDeviceMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint32 id = 1;
-      case 1: {
-        if (tag == 8) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &id_)));
-          set_has_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(16)) goto parse_source_id;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 source_id = 2;
-      case 2: {
-        if (tag == 16) {
-         parse_source_id:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &source_id_)));
-          set_has_source_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(29)) goto parse_value;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_source_id(&has_bits);
+          _impl_.source_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional float value = 3;
-      case 3: {
-        if (tag == 29) {
-         parse_value:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
-                 input, &value_)));
-          set_has_value();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.InputDeviceMsg)
-  return true;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 29)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.InputDeviceMsg)
-  return false;
-#undef DO_
-}
-
-void InputDeviceMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.InputDeviceMsg)
-  // required uint32 id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->id(), output);
-  }
-
-  // optional uint32 source_id = 2;
-  if (has_source_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->source_id(), output);
-  }
-
-  // optional float value = 3;
-  if (has_value()) {
-    ::google::protobuf::internal::WireFormatLite::WriteFloat(3, this->value(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.InputDeviceMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* InputDeviceMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* InputDeviceMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.InputDeviceMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_id(), target);
   }
 
   // optional uint32 source_id = 2;
-  if (has_source_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->source_id(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_source_id(), target);
   }
 
   // optional float value = 3;
-  if (has_value()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(3, this->value(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(3, this->_internal_value(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.InputDeviceMsg)
   return target;
 }
 
-int InputDeviceMsg::ByteSize() const {
-  int total_size = 0;
+size_t InputDeviceMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.InputDeviceMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required uint32 id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required uint32 id = 1;
+  if (_internal_has_id()) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000006u) {
     // optional uint32 source_id = 2;
-    if (has_source_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->source_id());
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_source_id());
     }
 
     // optional float value = 3;
-    if (has_value()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 4;
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void InputDeviceMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const InputDeviceMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const InputDeviceMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData InputDeviceMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    InputDeviceMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*InputDeviceMsg::GetClassData() const { return &_class_data_; }
+
 
-void InputDeviceMsg::MergeFrom(const InputDeviceMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      set_id(from.id());
+void InputDeviceMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<InputDeviceMsg*>(&to_msg);
+  auto& from = static_cast<const InputDeviceMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.InputDeviceMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.id_ = from._impl_.id_;
     }
-    if (from.has_source_id()) {
-      set_source_id(from.source_id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.source_id_ = from._impl_.source_id_;
     }
-    if (from.has_value()) {
-      set_value(from.value());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.value_ = from._impl_.value_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void InputDeviceMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void InputDeviceMsg::CopyFrom(const InputDeviceMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.InputDeviceMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool InputDeviceMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
 }
 
-void InputDeviceMsg::Swap(InputDeviceMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(source_id_, other->source_id_);
-    std::swap(value_, other->value_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void InputDeviceMsg::InternalSwap(InputDeviceMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(InputDeviceMsg, _impl_.value_)
+      + sizeof(InputDeviceMsg::_impl_.value_)
+      - PROTOBUF_FIELD_OFFSET(InputDeviceMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata InputDeviceMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = InputDeviceMsg_descriptor_;
-  metadata.reflection = InputDeviceMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata InputDeviceMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[4]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int NewPlayerEventMsg::kIdFieldNumber;
-const int NewPlayerEventMsg::kStateFieldNumber;
-#endif  // !_MSC_VER
+class NewPlayerEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<NewPlayerEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const NewPlayerEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const NewPlayerEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-NewPlayerEventMsg::NewPlayerEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.NewPlayerEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+NewPlayerEventMsg::_Internal::id(const NewPlayerEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void NewPlayerEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+NewPlayerEventMsg::_Internal::state(const NewPlayerEventMsg* msg) {
+  return *msg->_impl_.state_;
+}
+NewPlayerEventMsg::NewPlayerEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.NewPlayerEventMsg)
 }
-
 NewPlayerEventMsg::NewPlayerEventMsg(const NewPlayerEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  NewPlayerEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.NewPlayerEventMsg)
 }
 
-void NewPlayerEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void NewPlayerEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+  };
 }
 
 NewPlayerEventMsg::~NewPlayerEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.NewPlayerEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void NewPlayerEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-  }
+inline void NewPlayerEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
 }
 
 void NewPlayerEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* NewPlayerEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return NewPlayerEventMsg_descriptor_;
-}
-
-const NewPlayerEventMsg& NewPlayerEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-NewPlayerEventMsg* NewPlayerEventMsg::default_instance_ = NULL;
-
-NewPlayerEventMsg* NewPlayerEventMsg::New() const {
-  return new NewPlayerEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void NewPlayerEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool NewPlayerEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.NewPlayerEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.NewPlayerEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* NewPlayerEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // required .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.NewPlayerEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.NewPlayerEventMsg)
-  return false;
-#undef DO_
-}
-
-void NewPlayerEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.NewPlayerEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // required .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.NewPlayerEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* NewPlayerEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* NewPlayerEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.NewPlayerEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // required .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.NewPlayerEventMsg)
   return target;
 }
 
-int NewPlayerEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t NewPlayerEventMsg::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.NewPlayerEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (_internal_has_id()) {
     // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
+  }
 
+  if (_internal_has_state()) {
     // required .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
-    }
-
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
   }
-  total_size += _extensions_.ByteSize();
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
   return total_size;
 }
+size_t NewPlayerEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.NewPlayerEventMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
+
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required .mixr.recorder.pb.PlayerId id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
+
+    // required .mixr.recorder.pb.PlayerState state = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
 
-void NewPlayerEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const NewPlayerEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const NewPlayerEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-    MergeFrom(*source);
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void NewPlayerEventMsg::MergeFrom(const NewPlayerEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData NewPlayerEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    NewPlayerEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*NewPlayerEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void NewPlayerEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<NewPlayerEventMsg*>(&to_msg);
+  auto& from = static_cast<const NewPlayerEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.NewPlayerEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void NewPlayerEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void NewPlayerEventMsg::CopyFrom(const NewPlayerEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.NewPlayerEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool NewPlayerEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void NewPlayerEventMsg::Swap(NewPlayerEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void NewPlayerEventMsg::InternalSwap(NewPlayerEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(NewPlayerEventMsg, _impl_.state_)
+      + sizeof(NewPlayerEventMsg::_impl_.state_)
+      - PROTOBUF_FIELD_OFFSET(NewPlayerEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata NewPlayerEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = NewPlayerEventMsg_descriptor_;
-  metadata.reflection = NewPlayerEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata NewPlayerEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[5]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerRemovedEventMsg::kIdFieldNumber;
-const int PlayerRemovedEventMsg::kStateFieldNumber;
-#endif  // !_MSC_VER
+class PlayerRemovedEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerRemovedEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerRemovedEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerRemovedEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-PlayerRemovedEventMsg::PlayerRemovedEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerRemovedEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerRemovedEventMsg::_Internal::id(const PlayerRemovedEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerRemovedEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerRemovedEventMsg::_Internal::state(const PlayerRemovedEventMsg* msg) {
+  return *msg->_impl_.state_;
+}
+PlayerRemovedEventMsg::PlayerRemovedEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerRemovedEventMsg)
 }
-
 PlayerRemovedEventMsg::PlayerRemovedEventMsg(const PlayerRemovedEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerRemovedEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerRemovedEventMsg)
 }
 
-void PlayerRemovedEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerRemovedEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+  };
 }
 
 PlayerRemovedEventMsg::~PlayerRemovedEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerRemovedEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerRemovedEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-  }
+inline void PlayerRemovedEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
 }
 
 void PlayerRemovedEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerRemovedEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerRemovedEventMsg_descriptor_;
-}
-
-const PlayerRemovedEventMsg& PlayerRemovedEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerRemovedEventMsg* PlayerRemovedEventMsg::default_instance_ = NULL;
-
-PlayerRemovedEventMsg* PlayerRemovedEventMsg::New() const {
-  return new PlayerRemovedEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerRemovedEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerRemovedEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerRemovedEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerRemovedEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerRemovedEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerRemovedEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerRemovedEventMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void PlayerRemovedEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerRemovedEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerRemovedEventMsg)
-}
-
-::google::protobuf::uint8* PlayerRemovedEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerRemovedEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerRemovedEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerRemovedEventMsg)
   return target;
 }
 
-int PlayerRemovedEventMsg::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+size_t PlayerRemovedEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerRemovedEventMsg)
+  size_t total_size = 0;
 
-    // optional .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
-    }
+  total_size += _impl_._extensions_.ByteSize();
 
+  // required .mixr.recorder.pb.PlayerId id = 1;
+  if (_internal_has_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
   }
-  total_size += _extensions_.ByteSize();
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // optional .mixr.recorder.pb.PlayerState state = 2;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void PlayerRemovedEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerRemovedEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerRemovedEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerRemovedEventMsg::MergeFrom(const PlayerRemovedEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerRemovedEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerRemovedEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerRemovedEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void PlayerRemovedEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerRemovedEventMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerRemovedEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerRemovedEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerRemovedEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerRemovedEventMsg::CopyFrom(const PlayerRemovedEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerRemovedEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerRemovedEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerRemovedEventMsg::Swap(PlayerRemovedEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerRemovedEventMsg::InternalSwap(PlayerRemovedEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerRemovedEventMsg, _impl_.state_)
+      + sizeof(PlayerRemovedEventMsg::_impl_.state_)
+      - PROTOBUF_FIELD_OFFSET(PlayerRemovedEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerRemovedEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerRemovedEventMsg_descriptor_;
-  metadata.reflection = PlayerRemovedEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerRemovedEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[6]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerDataMsg::kIdFieldNumber;
-const int PlayerDataMsg::kStateFieldNumber;
-const int PlayerDataMsg::kAlphaFieldNumber;
-const int PlayerDataMsg::kBetaFieldNumber;
-const int PlayerDataMsg::kCasFieldNumber;
-#endif  // !_MSC_VER
+class PlayerDataMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerDataMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerDataMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerDataMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_alpha(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_beta(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_cas(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-PlayerDataMsg::PlayerDataMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerDataMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerDataMsg::_Internal::id(const PlayerDataMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerDataMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerDataMsg::_Internal::state(const PlayerDataMsg* msg) {
+  return *msg->_impl_.state_;
+}
+PlayerDataMsg::PlayerDataMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerDataMsg)
 }
-
 PlayerDataMsg::PlayerDataMsg(const PlayerDataMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerDataMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.alpha_){}
+    , decltype(_impl_.beta_){}
+    , decltype(_impl_.cas_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
+  ::memcpy(&_impl_.alpha_, &from._impl_.alpha_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.cas_) -
+    reinterpret_cast<char*>(&_impl_.alpha_)) + sizeof(_impl_.cas_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerDataMsg)
 }
 
-void PlayerDataMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  alpha_ = 0;
-  beta_ = 0;
-  cas_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerDataMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.alpha_){0}
+    , decltype(_impl_.beta_){0}
+    , decltype(_impl_.cas_){0}
+  };
 }
 
 PlayerDataMsg::~PlayerDataMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerDataMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerDataMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-  }
+inline void PlayerDataMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
 }
 
 void PlayerDataMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerDataMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerDataMsg_descriptor_;
-}
-
-const PlayerDataMsg& PlayerDataMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerDataMsg* PlayerDataMsg::default_instance_ = NULL;
-
-PlayerDataMsg* PlayerDataMsg::New() const {
-  return new PlayerDataMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerDataMsg::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<PlayerDataMsg*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 31) {
-    ZR_(alpha_, cas_);
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerDataMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerDataMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerDataMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+  }
+  if (cached_has_bits & 0x0000001cu) {
+    ::memset(&_impl_.alpha_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.cas_) -
+        reinterpret_cast<char*>(&_impl_.alpha_)) + sizeof(_impl_.cas_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerDataMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // required .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(25)) goto parse_alpha;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double alpha = 3;
-      case 3: {
-        if (tag == 25) {
-         parse_alpha:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &alpha_)));
-          set_has_alpha();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(33)) goto parse_beta;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_alpha(&has_bits);
+          _impl_.alpha_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double beta = 4;
-      case 4: {
-        if (tag == 33) {
-         parse_beta:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &beta_)));
-          set_has_beta();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(41)) goto parse_cas;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_beta(&has_bits);
+          _impl_.beta_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double cas = 5;
-      case 5: {
-        if (tag == 41) {
-         parse_cas:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &cas_)));
-          set_has_cas();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerDataMsg)
-  return true;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _Internal::set_has_cas(&has_bits);
+          _impl_.cas_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerDataMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void PlayerDataMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerDataMsg)
+uint8_t* PlayerDataMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerDataMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // required .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
   // optional double alpha = 3;
-  if (has_alpha()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(3, this->alpha(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_alpha(), target);
   }
 
   // optional double beta = 4;
-  if (has_beta()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(4, this->beta(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_beta(), target);
   }
 
   // optional double cas = 5;
-  if (has_cas()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(5, this->cas(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(5, this->_internal_cas(), target);
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerDataMsg)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerDataMsg)
+  return target;
 }
 
-::google::protobuf::uint8* PlayerDataMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerDataMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
-  }
-
-  // required .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
-  }
-
-  // optional double alpha = 3;
-  if (has_alpha()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(3, this->alpha(), target);
-  }
+size_t PlayerDataMsg::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.PlayerDataMsg)
+  size_t total_size = 0;
 
-  // optional double beta = 4;
-  if (has_beta()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(4, this->beta(), target);
+  if (_internal_has_id()) {
+    // required .mixr.recorder.pb.PlayerId id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
   }
 
-  // optional double cas = 5;
-  if (has_cas()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(5, this->cas(), target);
+  if (_internal_has_state()) {
+    // required .mixr.recorder.pb.PlayerState state = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerDataMsg)
-  return target;
+  return total_size;
 }
+size_t PlayerDataMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerDataMsg)
+  size_t total_size = 0;
 
-int PlayerDataMsg::ByteSize() const {
-  int total_size = 0;
+  total_size += _impl_._extensions_.ByteSize();
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
     // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
 
     // required .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000001cu) {
     // optional double alpha = 3;
-    if (has_alpha()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 8;
     }
 
     // optional double beta = 4;
-    if (has_beta()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 + 8;
     }
 
     // optional double cas = 5;
-    if (has_cas()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 + 8;
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerDataMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerDataMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerDataMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerDataMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerDataMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerDataMsg::GetClassData() const { return &_class_data_; }
+
+
+void PlayerDataMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerDataMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerDataMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerDataMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void PlayerDataMsg::MergeFrom(const PlayerDataMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000001fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
-    if (from.has_alpha()) {
-      set_alpha(from.alpha());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.alpha_ = from._impl_.alpha_;
     }
-    if (from.has_beta()) {
-      set_beta(from.beta());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.beta_ = from._impl_.beta_;
     }
-    if (from.has_cas()) {
-      set_cas(from.cas());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.cas_ = from._impl_.cas_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerDataMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerDataMsg::CopyFrom(const PlayerDataMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerDataMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerDataMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerDataMsg::Swap(PlayerDataMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(alpha_, other->alpha_);
-    std::swap(beta_, other->beta_);
-    std::swap(cas_, other->cas_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerDataMsg::InternalSwap(PlayerDataMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerDataMsg, _impl_.cas_)
+      + sizeof(PlayerDataMsg::_impl_.cas_)
+      - PROTOBUF_FIELD_OFFSET(PlayerDataMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerDataMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerDataMsg_descriptor_;
-  metadata.reflection = PlayerDataMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerDataMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[7]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerDamagedEventMsg::kIdFieldNumber;
-const int PlayerDamagedEventMsg::kStateFieldNumber;
-#endif  // !_MSC_VER
+class PlayerDamagedEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerDamagedEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerDamagedEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerDamagedEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-PlayerDamagedEventMsg::PlayerDamagedEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerDamagedEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerDamagedEventMsg::_Internal::id(const PlayerDamagedEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerDamagedEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerDamagedEventMsg::_Internal::state(const PlayerDamagedEventMsg* msg) {
+  return *msg->_impl_.state_;
+}
+PlayerDamagedEventMsg::PlayerDamagedEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerDamagedEventMsg)
 }
-
 PlayerDamagedEventMsg::PlayerDamagedEventMsg(const PlayerDamagedEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerDamagedEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerDamagedEventMsg)
 }
 
-void PlayerDamagedEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerDamagedEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+  };
 }
 
 PlayerDamagedEventMsg::~PlayerDamagedEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerDamagedEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerDamagedEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-  }
+inline void PlayerDamagedEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
 }
 
 void PlayerDamagedEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerDamagedEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerDamagedEventMsg_descriptor_;
-}
-
-const PlayerDamagedEventMsg& PlayerDamagedEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerDamagedEventMsg* PlayerDamagedEventMsg::default_instance_ = NULL;
-
-PlayerDamagedEventMsg* PlayerDamagedEventMsg::New() const {
-  return new PlayerDamagedEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerDamagedEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerDamagedEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerDamagedEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerDamagedEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerDamagedEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerDamagedEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerDamagedEventMsg)
-  return false;
-#undef DO_
-}
-
-void PlayerDamagedEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerDamagedEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerDamagedEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* PlayerDamagedEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerDamagedEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerDamagedEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerDamagedEventMsg)
   return target;
 }
 
-int PlayerDamagedEventMsg::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+size_t PlayerDamagedEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerDamagedEventMsg)
+  size_t total_size = 0;
 
-    // optional .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
-    }
+  total_size += _impl_._extensions_.ByteSize();
 
+  // required .mixr.recorder.pb.PlayerId id = 1;
+  if (_internal_has_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
   }
-  total_size += _extensions_.ByteSize();
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // optional .mixr.recorder.pb.PlayerState state = 2;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void PlayerDamagedEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerDamagedEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerDamagedEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerDamagedEventMsg::MergeFrom(const PlayerDamagedEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerDamagedEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerDamagedEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerDamagedEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void PlayerDamagedEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerDamagedEventMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerDamagedEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerDamagedEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerDamagedEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerDamagedEventMsg::CopyFrom(const PlayerDamagedEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerDamagedEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerDamagedEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerDamagedEventMsg::Swap(PlayerDamagedEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerDamagedEventMsg::InternalSwap(PlayerDamagedEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerDamagedEventMsg, _impl_.state_)
+      + sizeof(PlayerDamagedEventMsg::_impl_.state_)
+      - PROTOBUF_FIELD_OFFSET(PlayerDamagedEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerDamagedEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerDamagedEventMsg_descriptor_;
-  metadata.reflection = PlayerDamagedEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerDamagedEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[8]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerCollisionEventMsg::kIdFieldNumber;
-const int PlayerCollisionEventMsg::kStateFieldNumber;
-const int PlayerCollisionEventMsg::kOtherPlayerIdFieldNumber;
-#endif  // !_MSC_VER
+class PlayerCollisionEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerCollisionEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerCollisionEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerCollisionEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& other_player_id(const PlayerCollisionEventMsg* msg);
+  static void set_has_other_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-PlayerCollisionEventMsg::PlayerCollisionEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerCollisionEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerCollisionEventMsg::_Internal::id(const PlayerCollisionEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerCollisionEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  other_player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerCollisionEventMsg::_Internal::state(const PlayerCollisionEventMsg* msg) {
+  return *msg->_impl_.state_;
 }
-
-PlayerCollisionEventMsg::PlayerCollisionEventMsg(const PlayerCollisionEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+const ::mixr::recorder::pb::PlayerId&
+PlayerCollisionEventMsg::_Internal::other_player_id(const PlayerCollisionEventMsg* msg) {
+  return *msg->_impl_.other_player_id_;
+}
+PlayerCollisionEventMsg::PlayerCollisionEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerCollisionEventMsg)
+}
+PlayerCollisionEventMsg::PlayerCollisionEventMsg(const PlayerCollisionEventMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerCollisionEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.other_player_id_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
+  if (from._internal_has_other_player_id()) {
+    _this->_impl_.other_player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.other_player_id_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerCollisionEventMsg)
 }
 
-void PlayerCollisionEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  other_player_id_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerCollisionEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.other_player_id_){nullptr}
+  };
 }
 
 PlayerCollisionEventMsg::~PlayerCollisionEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerCollisionEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerCollisionEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-    delete other_player_id_;
-  }
+inline void PlayerCollisionEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
+  if (this != internal_default_instance()) delete _impl_.other_player_id_;
 }
 
 void PlayerCollisionEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerCollisionEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerCollisionEventMsg_descriptor_;
-}
-
-const PlayerCollisionEventMsg& PlayerCollisionEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerCollisionEventMsg* PlayerCollisionEventMsg::default_instance_ = NULL;
-
-PlayerCollisionEventMsg* PlayerCollisionEventMsg::New() const {
-  return new PlayerCollisionEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerCollisionEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 7) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-    if (has_other_player_id()) {
-      if (other_player_id_ != NULL) other_player_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerCollisionEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerCollisionEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerCollisionEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.other_player_id_ != nullptr);
+      _impl_.other_player_id_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerCollisionEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_other_player_id;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId other_player_id = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_other_player_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_other_player_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerCollisionEventMsg)
-  return true;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_other_player_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerCollisionEventMsg)
-  return false;
-#undef DO_
-}
-
-void PlayerCollisionEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerCollisionEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId other_player_id = 3;
-  if (has_other_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->other_player_id(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerCollisionEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* PlayerCollisionEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerCollisionEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerCollisionEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId other_player_id = 3;
-  if (has_other_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->other_player_id(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::other_player_id(this),
+        _Internal::other_player_id(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerCollisionEventMsg)
   return target;
 }
 
-int PlayerCollisionEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t PlayerCollisionEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerCollisionEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required .mixr.recorder.pb.PlayerId id = 1;
+  if (_internal_has_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000006u) {
     // optional .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId other_player_id = 3;
-    if (has_other_player_id()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->other_player_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.other_player_id_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerCollisionEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerCollisionEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerCollisionEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerCollisionEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerCollisionEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerCollisionEventMsg::GetClassData() const { return &_class_data_; }
 
-void PlayerCollisionEventMsg::MergeFrom(const PlayerCollisionEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+
+void PlayerCollisionEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerCollisionEventMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerCollisionEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerCollisionEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
-    if (from.has_other_player_id()) {
-      mutable_other_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.other_player_id());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_other_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_other_player_id());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerCollisionEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerCollisionEventMsg::CopyFrom(const PlayerCollisionEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerCollisionEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerCollisionEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-  if (has_other_player_id()) {
-    if (!this->other_player_id().IsInitialized()) return false;
+  if (_internal_has_other_player_id()) {
+    if (!_impl_.other_player_id_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerCollisionEventMsg::Swap(PlayerCollisionEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(other_player_id_, other->other_player_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerCollisionEventMsg::InternalSwap(PlayerCollisionEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerCollisionEventMsg, _impl_.other_player_id_)
+      + sizeof(PlayerCollisionEventMsg::_impl_.other_player_id_)
+      - PROTOBUF_FIELD_OFFSET(PlayerCollisionEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerCollisionEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerCollisionEventMsg_descriptor_;
-  metadata.reflection = PlayerCollisionEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerCollisionEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[9]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerCrashEventMsg::kIdFieldNumber;
-const int PlayerCrashEventMsg::kStateFieldNumber;
-#endif  // !_MSC_VER
+class PlayerCrashEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerCrashEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerCrashEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerCrashEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-PlayerCrashEventMsg::PlayerCrashEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerCrashEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerCrashEventMsg::_Internal::id(const PlayerCrashEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerCrashEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerCrashEventMsg::_Internal::state(const PlayerCrashEventMsg* msg) {
+  return *msg->_impl_.state_;
+}
+PlayerCrashEventMsg::PlayerCrashEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerCrashEventMsg)
 }
-
 PlayerCrashEventMsg::PlayerCrashEventMsg(const PlayerCrashEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerCrashEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerCrashEventMsg)
 }
 
-void PlayerCrashEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerCrashEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+  };
 }
 
 PlayerCrashEventMsg::~PlayerCrashEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerCrashEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerCrashEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-  }
+inline void PlayerCrashEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
 }
 
 void PlayerCrashEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerCrashEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerCrashEventMsg_descriptor_;
-}
-
-const PlayerCrashEventMsg& PlayerCrashEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerCrashEventMsg* PlayerCrashEventMsg::default_instance_ = NULL;
-
-PlayerCrashEventMsg* PlayerCrashEventMsg::New() const {
-  return new PlayerCrashEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerCrashEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerCrashEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerCrashEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerCrashEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerCrashEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerCrashEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerCrashEventMsg)
-  return false;
-#undef DO_
-}
-
-void PlayerCrashEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerCrashEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerCrashEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* PlayerCrashEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerCrashEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerCrashEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerCrashEventMsg)
   return target;
 }
 
-int PlayerCrashEventMsg::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+size_t PlayerCrashEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerCrashEventMsg)
+  size_t total_size = 0;
 
-    // optional .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
-    }
+  total_size += _impl_._extensions_.ByteSize();
 
+  // required .mixr.recorder.pb.PlayerId id = 1;
+  if (_internal_has_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
   }
-  total_size += _extensions_.ByteSize();
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // optional .mixr.recorder.pb.PlayerState state = 2;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.state_);
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void PlayerCrashEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerCrashEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerCrashEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerCrashEventMsg::MergeFrom(const PlayerCrashEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerCrashEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerCrashEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerCrashEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void PlayerCrashEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerCrashEventMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerCrashEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerCrashEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerCrashEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerCrashEventMsg::CopyFrom(const PlayerCrashEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerCrashEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerCrashEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerCrashEventMsg::Swap(PlayerCrashEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerCrashEventMsg::InternalSwap(PlayerCrashEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerCrashEventMsg, _impl_.state_)
+      + sizeof(PlayerCrashEventMsg::_impl_.state_)
+      - PROTOBUF_FIELD_OFFSET(PlayerCrashEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerCrashEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerCrashEventMsg_descriptor_;
-  metadata.reflection = PlayerCrashEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerCrashEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[10]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerKilledEventMsg::kIdFieldNumber;
-const int PlayerKilledEventMsg::kStateFieldNumber;
-const int PlayerKilledEventMsg::kShooterIdFieldNumber;
-#endif  // !_MSC_VER
+class PlayerKilledEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerKilledEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& id(const PlayerKilledEventMsg* msg);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& state(const PlayerKilledEventMsg* msg);
+  static void set_has_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& shooter_id(const PlayerKilledEventMsg* msg);
+  static void set_has_shooter_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-PlayerKilledEventMsg::PlayerKilledEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerKilledEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+PlayerKilledEventMsg::_Internal::id(const PlayerKilledEventMsg* msg) {
+  return *msg->_impl_.id_;
 }
-
-void PlayerKilledEventMsg::InitAsDefaultInstance() {
-  id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  shooter_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+PlayerKilledEventMsg::_Internal::state(const PlayerKilledEventMsg* msg) {
+  return *msg->_impl_.state_;
+}
+const ::mixr::recorder::pb::PlayerId&
+PlayerKilledEventMsg::_Internal::shooter_id(const PlayerKilledEventMsg* msg) {
+  return *msg->_impl_.shooter_id_;
+}
+PlayerKilledEventMsg::PlayerKilledEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerKilledEventMsg)
 }
-
 PlayerKilledEventMsg::PlayerKilledEventMsg(const PlayerKilledEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerKilledEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_id()) {
+    _this->_impl_.id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.id_);
+  }
+  if (from._internal_has_state()) {
+    _this->_impl_.state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.state_);
+  }
+  if (from._internal_has_shooter_id()) {
+    _this->_impl_.shooter_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.shooter_id_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerKilledEventMsg)
 }
 
-void PlayerKilledEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  id_ = NULL;
-  state_ = NULL;
-  shooter_id_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerKilledEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){nullptr}
+    , decltype(_impl_.state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+  };
 }
 
 PlayerKilledEventMsg::~PlayerKilledEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerKilledEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerKilledEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete id_;
-    delete state_;
-    delete shooter_id_;
-  }
+inline void PlayerKilledEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.id_;
+  if (this != internal_default_instance()) delete _impl_.state_;
+  if (this != internal_default_instance()) delete _impl_.shooter_id_;
 }
 
 void PlayerKilledEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerKilledEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerKilledEventMsg_descriptor_;
-}
-
-const PlayerKilledEventMsg& PlayerKilledEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerKilledEventMsg* PlayerKilledEventMsg::default_instance_ = NULL;
-
-PlayerKilledEventMsg* PlayerKilledEventMsg::New() const {
-  return new PlayerKilledEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerKilledEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 7) {
-    if (has_id()) {
-      if (id_ != NULL) id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_state()) {
-      if (state_ != NULL) state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-    if (has_shooter_id()) {
-      if (shooter_id_ != NULL) shooter_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerKilledEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerKilledEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerKilledEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.id_ != nullptr);
+      _impl_.id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.state_ != nullptr);
+      _impl_.state_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.shooter_id_ != nullptr);
+      _impl_.shooter_id_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerKilledEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_shooter_id;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_shooter_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_shooter_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerKilledEventMsg)
-  return true;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_shooter_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerKilledEventMsg)
-  return false;
-#undef DO_
-}
-
-void PlayerKilledEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerKilledEventMsg)
-  // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->state(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->shooter_id(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerKilledEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* PlayerKilledEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerKilledEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerKilledEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::id(this),
+        _Internal::id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState state = 2;
-  if (has_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::state(this),
+        _Internal::state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->shooter_id(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::shooter_id(this),
+        _Internal::shooter_id(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerKilledEventMsg)
   return target;
 }
 
-int PlayerKilledEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t PlayerKilledEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerKilledEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required .mixr.recorder.pb.PlayerId id = 1;
+  if (_internal_has_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.id_);
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000006u) {
     // optional .mixr.recorder.pb.PlayerState state = 2;
-    if (has_state()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-    if (has_shooter_id()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->shooter_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.shooter_id_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerKilledEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerKilledEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerKilledEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerKilledEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerKilledEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerKilledEventMsg::GetClassData() const { return &_class_data_; }
 
-void PlayerKilledEventMsg::MergeFrom(const PlayerKilledEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.id());
+
+void PlayerKilledEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerKilledEventMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerKilledEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerKilledEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_id());
     }
-    if (from.has_state()) {
-      mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_state());
     }
-    if (from.has_shooter_id()) {
-      mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.shooter_id());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_shooter_id());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerKilledEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerKilledEventMsg::CopyFrom(const PlayerKilledEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerKilledEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerKilledEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_id()) {
-    if (!this->id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_id()) {
+    if (!_impl_.id_->IsInitialized()) return false;
   }
-  if (has_state()) {
-    if (!this->state().IsInitialized()) return false;
+  if (_internal_has_state()) {
+    if (!_impl_.state_->IsInitialized()) return false;
   }
-  if (has_shooter_id()) {
-    if (!this->shooter_id().IsInitialized()) return false;
+  if (_internal_has_shooter_id()) {
+    if (!_impl_.shooter_id_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerKilledEventMsg::Swap(PlayerKilledEventMsg* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(state_, other->state_);
-    std::swap(shooter_id_, other->shooter_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerKilledEventMsg::InternalSwap(PlayerKilledEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerKilledEventMsg, _impl_.shooter_id_)
+      + sizeof(PlayerKilledEventMsg::_impl_.shooter_id_)
+      - PROTOBUF_FIELD_OFFSET(PlayerKilledEventMsg, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
-::google::protobuf::Metadata PlayerKilledEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerKilledEventMsg_descriptor_;
-  metadata.reflection = PlayerKilledEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerKilledEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[11]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int WeaponReleaseEventMsg::kWpnIdFieldNumber;
-const int WeaponReleaseEventMsg::kWpnStateFieldNumber;
-const int WeaponReleaseEventMsg::kShooterIdFieldNumber;
-const int WeaponReleaseEventMsg::kTgtIdFieldNumber;
-#endif  // !_MSC_VER
-
-WeaponReleaseEventMsg::WeaponReleaseEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.WeaponReleaseEventMsg)
-}
-
-void WeaponReleaseEventMsg::InitAsDefaultInstance() {
-  wpn_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  wpn_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  shooter_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  tgt_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-}
-
-WeaponReleaseEventMsg::WeaponReleaseEventMsg(const WeaponReleaseEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.WeaponReleaseEventMsg)
-}
-
-void WeaponReleaseEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  wpn_id_ = NULL;
-  wpn_state_ = NULL;
-  shooter_id_ = NULL;
-  tgt_id_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-}
-
-WeaponReleaseEventMsg::~WeaponReleaseEventMsg() {
-  // @@protoc_insertion_point(destructor:mixr.recorder.pb.WeaponReleaseEventMsg)
-  SharedDtor();
+class PlayerFrameMsg::_Internal {
+ public:
+};
+
+PlayerFrameMsg::PlayerFrameMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerFrameMsg)
+}
+PlayerFrameMsg::PlayerFrameMsg(const PlayerFrameMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerFrameMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_.id_){from._impl_.id_}
+    , /*decltype(_impl_._id_cached_byte_size_)*/{0}
+    , decltype(_impl_.federate_){from._impl_.federate_}
+    , /*decltype(_impl_._federate_cached_byte_size_)*/{0}
+    , decltype(_impl_.pos_){from._impl_.pos_}
+    , decltype(_impl_.vel_){from._impl_.vel_}
+    , decltype(_impl_.angles_){from._impl_.angles_}
+    , decltype(_impl_.mode_){from._impl_.mode_}
+    , /*decltype(_impl_._mode_cached_byte_size_)*/{0}
+    , decltype(_impl_.federates_){from._impl_.federates_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerFrameMsg)
+}
+
+inline void PlayerFrameMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_.id_){arena}
+    , /*decltype(_impl_._id_cached_byte_size_)*/{0}
+    , decltype(_impl_.federate_){arena}
+    , /*decltype(_impl_._federate_cached_byte_size_)*/{0}
+    , decltype(_impl_.pos_){arena}
+    , decltype(_impl_.vel_){arena}
+    , decltype(_impl_.angles_){arena}
+    , decltype(_impl_.mode_){arena}
+    , /*decltype(_impl_._mode_cached_byte_size_)*/{0}
+    , decltype(_impl_.federates_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
 }
 
-void WeaponReleaseEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete wpn_id_;
-    delete wpn_state_;
-    delete shooter_id_;
-    delete tgt_id_;
+PlayerFrameMsg::~PlayerFrameMsg() {
+  // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerFrameMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
   }
+  SharedDtor();
 }
 
-void WeaponReleaseEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* WeaponReleaseEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return WeaponReleaseEventMsg_descriptor_;
-}
-
-const WeaponReleaseEventMsg& WeaponReleaseEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
+inline void PlayerFrameMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.id_.~RepeatedField();
+  _impl_.federate_.~RepeatedField();
+  _impl_.pos_.~RepeatedField();
+  _impl_.vel_.~RepeatedField();
+  _impl_.angles_.~RepeatedField();
+  _impl_.mode_.~RepeatedField();
+  _impl_.federates_.~RepeatedPtrField();
+}
+
+void PlayerFrameMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void PlayerFrameMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerFrameMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  _impl_.id_.Clear();
+  _impl_.federate_.Clear();
+  _impl_.pos_.Clear();
+  _impl_.vel_.Clear();
+  _impl_.angles_.Clear();
+  _impl_.mode_.Clear();
+  _impl_.federates_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerFrameMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated uint32 id = 1 [packed = true];
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_id(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_id(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint32 federate = 2 [packed = true];
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_federate(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 16) {
+          _internal_add_federate(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated double pos = 3 [packed = true];
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedDoubleParser(_internal_mutable_pos(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 25) {
+          _internal_add_pos(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr));
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated double vel = 4 [packed = true];
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedDoubleParser(_internal_mutable_vel(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 33) {
+          _internal_add_vel(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr));
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated double angles = 5 [packed = true];
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedDoubleParser(_internal_mutable_angles(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 41) {
+          _internal_add_angles(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr));
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint32 mode = 6 [packed = true];
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_mode(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 48) {
+          _internal_add_mode(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated string federates = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            auto str = _internal_add_federates();
+            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+            CHK_(ptr);
+            #ifndef NDEBUG
+            ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.PlayerFrameMsg.federates");
+            #endif  // !NDEBUG
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<58>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-WeaponReleaseEventMsg* WeaponReleaseEventMsg::default_instance_ = NULL;
-
-WeaponReleaseEventMsg* WeaponReleaseEventMsg::New() const {
-  return new WeaponReleaseEventMsg;
-}
+uint8_t* PlayerFrameMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerFrameMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void WeaponReleaseEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 15) {
-    if (has_wpn_id()) {
-      if (wpn_id_ != NULL) wpn_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_wpn_state()) {
-      if (wpn_state_ != NULL) wpn_state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-    if (has_shooter_id()) {
-      if (shooter_id_ != NULL) shooter_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_tgt_id()) {
-      if (tgt_id_ != NULL) tgt_id_->::mixr::recorder::pb::PlayerId::Clear();
+  // repeated uint32 id = 1 [packed = true];
+  {
+    int byte_size = _impl_._id_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          1, _internal_id(), byte_size, target);
     }
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool WeaponReleaseEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.WeaponReleaseEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_wpn_state;
-        break;
-      }
-
-      // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_wpn_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_shooter_id;
-        break;
-      }
-
-      // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_shooter_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_shooter_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(34)) goto parse_tgt_id;
-        break;
-      }
 
-      // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-      case 4: {
-        if (tag == 34) {
-         parse_tgt_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_tgt_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.WeaponReleaseEventMsg)
-  return true;
-failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.WeaponReleaseEventMsg)
-  return false;
-#undef DO_
-}
+  // repeated uint32 federate = 2 [packed = true];
+  {
+    int byte_size = _impl_._federate_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          2, _internal_federate(), byte_size, target);
+    }
+  }
 
-void WeaponReleaseEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.WeaponReleaseEventMsg)
-  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->wpn_id(), output);
+  // repeated double pos = 3 [packed = true];
+  if (this->_internal_pos_size() > 0) {
+    target = stream->WriteFixedPacked(3, _internal_pos(), target);
   }
 
-  // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->wpn_state(), output);
+  // repeated double vel = 4 [packed = true];
+  if (this->_internal_vel_size() > 0) {
+    target = stream->WriteFixedPacked(4, _internal_vel(), target);
   }
 
-  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->shooter_id(), output);
+  // repeated double angles = 5 [packed = true];
+  if (this->_internal_angles_size() > 0) {
+    target = stream->WriteFixedPacked(5, _internal_angles(), target);
   }
 
-  // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->tgt_id(), output);
+  // repeated uint32 mode = 6 [packed = true];
+  {
+    int byte_size = _impl_._mode_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          6, _internal_mode(), byte_size, target);
+    }
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
+  // repeated string federates = 7;
+  for (int i = 0, n = this->_internal_federates_size(); i < n; i++) {
+    const auto& s = this->_internal_federates(i);
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      s.data(), static_cast<int>(s.length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.PlayerFrameMsg.federates");
+    target = stream->WriteString(7, s, target);
+  }
 
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.WeaponReleaseEventMsg)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerFrameMsg)
+  return target;
 }
 
-::google::protobuf::uint8* WeaponReleaseEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.WeaponReleaseEventMsg)
-  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->wpn_id(), target);
-  }
+size_t PlayerFrameMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerFrameMsg)
+  size_t total_size = 0;
 
-  // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->wpn_state(), target);
-  }
+  total_size += _impl_._extensions_.ByteSize();
 
-  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->shooter_id(), target);
-  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->tgt_id(), target);
+  // repeated uint32 id = 1 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.id_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._id_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  // repeated uint32 federate = 2 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.federate_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._federate_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
   }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.WeaponReleaseEventMsg)
-  return target;
-}
 
-int WeaponReleaseEventMsg::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-    if (has_wpn_id()) {
+  // repeated double pos = 3 [packed = true];
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_pos_size());
+    size_t data_size = 8UL * count;
+    if (data_size > 0) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_id());
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
     }
+    total_size += data_size;
+  }
 
-    // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-    if (has_wpn_state()) {
+  // repeated double vel = 4 [packed = true];
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_vel_size());
+    size_t data_size = 8UL * count;
+    if (data_size > 0) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_state());
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
     }
+    total_size += data_size;
+  }
 
-    // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-    if (has_shooter_id()) {
+  // repeated double angles = 5 [packed = true];
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_angles_size());
+    size_t data_size = 8UL * count;
+    if (data_size > 0) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->shooter_id());
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
     }
+    total_size += data_size;
+  }
 
-    // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-    if (has_tgt_id()) {
+  // repeated uint32 mode = 6 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.mode_);
+    if (data_size > 0) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->tgt_id());
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
     }
-
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._mode_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
   }
-  total_size += _extensions_.ByteSize();
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // repeated string federates = 7;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.federates_.size());
+  for (int i = 0, n = _impl_.federates_.size(); i < n; i++) {
+    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      _impl_.federates_.Get(i));
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void WeaponReleaseEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const WeaponReleaseEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const WeaponReleaseEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void WeaponReleaseEventMsg::MergeFrom(const WeaponReleaseEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_wpn_id()) {
-      mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.wpn_id());
-    }
-    if (from.has_wpn_state()) {
-      mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.wpn_state());
-    }
-    if (from.has_shooter_id()) {
-      mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.shooter_id());
-    }
-    if (from.has_tgt_id()) {
-      mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.tgt_id());
-    }
-  }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerFrameMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerFrameMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerFrameMsg::GetClassData() const { return &_class_data_; }
 
-void WeaponReleaseEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+
+void PlayerFrameMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerFrameMsg*>(&to_msg);
+  auto& from = static_cast<const PlayerFrameMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerFrameMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.id_.MergeFrom(from._impl_.id_);
+  _this->_impl_.federate_.MergeFrom(from._impl_.federate_);
+  _this->_impl_.pos_.MergeFrom(from._impl_.pos_);
+  _this->_impl_.vel_.MergeFrom(from._impl_.vel_);
+  _this->_impl_.angles_.MergeFrom(from._impl_.angles_);
+  _this->_impl_.mode_.MergeFrom(from._impl_.mode_);
+  _this->_impl_.federates_.MergeFrom(from._impl_.federates_);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void WeaponReleaseEventMsg::CopyFrom(const WeaponReleaseEventMsg& from) {
+void PlayerFrameMsg::CopyFrom(const PlayerFrameMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerFrameMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool WeaponReleaseEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
-  if (has_wpn_id()) {
-    if (!this->wpn_id().IsInitialized()) return false;
-  }
-  if (has_wpn_state()) {
-    if (!this->wpn_state().IsInitialized()) return false;
-  }
-  if (has_shooter_id()) {
-    if (!this->shooter_id().IsInitialized()) return false;
-  }
-  if (has_tgt_id()) {
-    if (!this->tgt_id().IsInitialized()) return false;
+bool PlayerFrameMsg::IsInitialized() const {
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
   }
 
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void WeaponReleaseEventMsg::Swap(WeaponReleaseEventMsg* other) {
-  if (other != this) {
-    std::swap(wpn_id_, other->wpn_id_);
-    std::swap(wpn_state_, other->wpn_state_);
-    std::swap(shooter_id_, other->shooter_id_);
-    std::swap(tgt_id_, other->tgt_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerFrameMsg::InternalSwap(PlayerFrameMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.id_.InternalSwap(&other->_impl_.id_);
+  _impl_.federate_.InternalSwap(&other->_impl_.federate_);
+  _impl_.pos_.InternalSwap(&other->_impl_.pos_);
+  _impl_.vel_.InternalSwap(&other->_impl_.vel_);
+  _impl_.angles_.InternalSwap(&other->_impl_.angles_);
+  _impl_.mode_.InternalSwap(&other->_impl_.mode_);
+  _impl_.federates_.InternalSwap(&other->_impl_.federates_);
 }
 
-::google::protobuf::Metadata WeaponReleaseEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = WeaponReleaseEventMsg_descriptor_;
-  metadata.reflection = WeaponReleaseEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerFrameMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[12]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int WeaponHungEventMsg::kWpnIdFieldNumber;
-const int WeaponHungEventMsg::kWpnStateFieldNumber;
-const int WeaponHungEventMsg::kShooterIdFieldNumber;
-const int WeaponHungEventMsg::kTgtIdFieldNumber;
-#endif  // !_MSC_VER
+class WeaponReleaseEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<WeaponReleaseEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& wpn_id(const WeaponReleaseEventMsg* msg);
+  static void set_has_wpn_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& wpn_state(const WeaponReleaseEventMsg* msg);
+  static void set_has_wpn_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& shooter_id(const WeaponReleaseEventMsg* msg);
+  static void set_has_shooter_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& tgt_id(const WeaponReleaseEventMsg* msg);
+  static void set_has_tgt_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-WeaponHungEventMsg::WeaponHungEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.WeaponHungEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+WeaponReleaseEventMsg::_Internal::wpn_id(const WeaponReleaseEventMsg* msg) {
+  return *msg->_impl_.wpn_id_;
 }
-
-void WeaponHungEventMsg::InitAsDefaultInstance() {
-  wpn_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  wpn_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  shooter_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  tgt_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+const ::mixr::recorder::pb::PlayerState&
+WeaponReleaseEventMsg::_Internal::wpn_state(const WeaponReleaseEventMsg* msg) {
+  return *msg->_impl_.wpn_state_;
 }
-
-WeaponHungEventMsg::WeaponHungEventMsg(const WeaponHungEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.WeaponHungEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+WeaponReleaseEventMsg::_Internal::shooter_id(const WeaponReleaseEventMsg* msg) {
+  return *msg->_impl_.shooter_id_;
+}
+const ::mixr::recorder::pb::PlayerId&
+WeaponReleaseEventMsg::_Internal::tgt_id(const WeaponReleaseEventMsg* msg) {
+  return *msg->_impl_.tgt_id_;
+}
+WeaponReleaseEventMsg::WeaponReleaseEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.WeaponReleaseEventMsg)
+}
+WeaponReleaseEventMsg::WeaponReleaseEventMsg(const WeaponReleaseEventMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  WeaponReleaseEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_wpn_id()) {
+    _this->_impl_.wpn_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.wpn_id_);
+  }
+  if (from._internal_has_wpn_state()) {
+    _this->_impl_.wpn_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.wpn_state_);
+  }
+  if (from._internal_has_shooter_id()) {
+    _this->_impl_.shooter_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.shooter_id_);
+  }
+  if (from._internal_has_tgt_id()) {
+    _this->_impl_.tgt_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.tgt_id_);
+  }
+  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.WeaponReleaseEventMsg)
 }
 
-void WeaponHungEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  wpn_id_ = NULL;
-  wpn_state_ = NULL;
-  shooter_id_ = NULL;
-  tgt_id_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void WeaponReleaseEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}
+  };
 }
 
-WeaponHungEventMsg::~WeaponHungEventMsg() {
-  // @@protoc_insertion_point(destructor:mixr.recorder.pb.WeaponHungEventMsg)
+WeaponReleaseEventMsg::~WeaponReleaseEventMsg() {
+  // @@protoc_insertion_point(destructor:mixr.recorder.pb.WeaponReleaseEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void WeaponHungEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete wpn_id_;
-    delete wpn_state_;
-    delete shooter_id_;
-    delete tgt_id_;
-  }
+inline void WeaponReleaseEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.wpn_id_;
+  if (this != internal_default_instance()) delete _impl_.wpn_state_;
+  if (this != internal_default_instance()) delete _impl_.shooter_id_;
+  if (this != internal_default_instance()) delete _impl_.tgt_id_;
 }
 
-void WeaponHungEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+void WeaponReleaseEventMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
 }
-const ::google::protobuf::Descriptor* WeaponHungEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return WeaponHungEventMsg_descriptor_;
+
+void WeaponReleaseEventMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.WeaponReleaseEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.wpn_id_ != nullptr);
+      _impl_.wpn_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.wpn_state_ != nullptr);
+      _impl_.wpn_state_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.shooter_id_ != nullptr);
+      _impl_.shooter_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.tgt_id_ != nullptr);
+      _impl_.tgt_id_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* WeaponReleaseEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_shooter_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_tgt_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-const WeaponHungEventMsg& WeaponHungEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
+uint8_t* WeaponReleaseEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.WeaponReleaseEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::wpn_id(this),
+        _Internal::wpn_id(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::wpn_state(this),
+        _Internal::wpn_state(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::shooter_id(this),
+        _Internal::shooter_id(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::tgt_id(this),
+        _Internal::tgt_id(this).GetCachedSize(), target, stream);
+  }
+
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.WeaponReleaseEventMsg)
+  return target;
 }
 
-WeaponHungEventMsg* WeaponHungEventMsg::default_instance_ = NULL;
+size_t WeaponReleaseEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.WeaponReleaseEventMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+  if (_internal_has_wpn_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.wpn_id_);
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-WeaponHungEventMsg* WeaponHungEventMsg::New() const {
-  return new WeaponHungEventMsg;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000eu) {
+    // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.wpn_state_);
+    }
+
+    // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.shooter_id_);
+    }
+
+    // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.tgt_id_);
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void WeaponHungEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 15) {
-    if (has_wpn_id()) {
-      if (wpn_id_ != NULL) wpn_id_->::mixr::recorder::pb::PlayerId::Clear();
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData WeaponReleaseEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    WeaponReleaseEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*WeaponReleaseEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void WeaponReleaseEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<WeaponReleaseEventMsg*>(&to_msg);
+  auto& from = static_cast<const WeaponReleaseEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.WeaponReleaseEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_wpn_id());
     }
-    if (has_wpn_state()) {
-      if (wpn_state_ != NULL) wpn_state_->::mixr::recorder::pb::PlayerState::Clear();
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_wpn_state());
     }
-    if (has_shooter_id()) {
-      if (shooter_id_ != NULL) shooter_id_->::mixr::recorder::pb::PlayerId::Clear();
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_shooter_id());
     }
-    if (has_tgt_id()) {
-      if (tgt_id_ != NULL) tgt_id_->::mixr::recorder::pb::PlayerId::Clear();
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_tgt_id());
     }
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-bool WeaponHungEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.WeaponHungEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_wpn_state;
-        break;
-      }
-
-      // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_wpn_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_shooter_id;
-        break;
-      }
+void WeaponReleaseEventMsg::CopyFrom(const WeaponReleaseEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.WeaponReleaseEventMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
 
-      // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_shooter_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_shooter_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(34)) goto parse_tgt_id;
-        break;
-      }
+bool WeaponReleaseEventMsg::IsInitialized() const {
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-      // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-      case 4: {
-        if (tag == 34) {
-         parse_tgt_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_tgt_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.WeaponHungEventMsg)
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_wpn_id()) {
+    if (!_impl_.wpn_id_->IsInitialized()) return false;
+  }
+  if (_internal_has_wpn_state()) {
+    if (!_impl_.wpn_state_->IsInitialized()) return false;
+  }
+  if (_internal_has_shooter_id()) {
+    if (!_impl_.shooter_id_->IsInitialized()) return false;
+  }
+  if (_internal_has_tgt_id()) {
+    if (!_impl_.tgt_id_->IsInitialized()) return false;
+  }
   return true;
-failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.WeaponHungEventMsg)
-  return false;
-#undef DO_
 }
 
-void WeaponHungEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.WeaponHungEventMsg)
-  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->wpn_id(), output);
-  }
+void WeaponReleaseEventMsg::InternalSwap(WeaponReleaseEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(WeaponReleaseEventMsg, _impl_.tgt_id_)
+      + sizeof(WeaponReleaseEventMsg::_impl_.tgt_id_)
+      - PROTOBUF_FIELD_OFFSET(WeaponReleaseEventMsg, _impl_.wpn_id_)>(
+          reinterpret_cast<char*>(&_impl_.wpn_id_),
+          reinterpret_cast<char*>(&other->_impl_.wpn_id_));
+}
 
-  // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->wpn_state(), output);
+::PROTOBUF_NAMESPACE_ID::Metadata WeaponReleaseEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[13]);
+}
+
+// ===================================================================
+
+class WeaponHungEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<WeaponHungEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& wpn_id(const WeaponHungEventMsg* msg);
+  static void set_has_wpn_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& wpn_state(const WeaponHungEventMsg* msg);
+  static void set_has_wpn_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& shooter_id(const WeaponHungEventMsg* msg);
+  static void set_has_shooter_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& tgt_id(const WeaponHungEventMsg* msg);
+  static void set_has_tgt_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
   }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->shooter_id(), output);
+const ::mixr::recorder::pb::PlayerId&
+WeaponHungEventMsg::_Internal::wpn_id(const WeaponHungEventMsg* msg) {
+  return *msg->_impl_.wpn_id_;
+}
+const ::mixr::recorder::pb::PlayerState&
+WeaponHungEventMsg::_Internal::wpn_state(const WeaponHungEventMsg* msg) {
+  return *msg->_impl_.wpn_state_;
+}
+const ::mixr::recorder::pb::PlayerId&
+WeaponHungEventMsg::_Internal::shooter_id(const WeaponHungEventMsg* msg) {
+  return *msg->_impl_.shooter_id_;
+}
+const ::mixr::recorder::pb::PlayerId&
+WeaponHungEventMsg::_Internal::tgt_id(const WeaponHungEventMsg* msg) {
+  return *msg->_impl_.tgt_id_;
+}
+WeaponHungEventMsg::WeaponHungEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.WeaponHungEventMsg)
+}
+WeaponHungEventMsg::WeaponHungEventMsg(const WeaponHungEventMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  WeaponHungEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_wpn_id()) {
+    _this->_impl_.wpn_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.wpn_id_);
+  }
+  if (from._internal_has_wpn_state()) {
+    _this->_impl_.wpn_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.wpn_state_);
+  }
+  if (from._internal_has_shooter_id()) {
+    _this->_impl_.shooter_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.shooter_id_);
+  }
+  if (from._internal_has_tgt_id()) {
+    _this->_impl_.tgt_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.tgt_id_);
   }
+  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.WeaponHungEventMsg)
+}
 
-  // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->tgt_id(), output);
+inline void WeaponHungEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}
+  };
+}
+
+WeaponHungEventMsg::~WeaponHungEventMsg() {
+  // @@protoc_insertion_point(destructor:mixr.recorder.pb.WeaponHungEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
   }
+  SharedDtor();
+}
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
+inline void WeaponHungEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.wpn_id_;
+  if (this != internal_default_instance()) delete _impl_.wpn_state_;
+  if (this != internal_default_instance()) delete _impl_.shooter_id_;
+  if (this != internal_default_instance()) delete _impl_.tgt_id_;
+}
 
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+void WeaponHungEventMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.WeaponHungEventMsg)
+void WeaponHungEventMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.WeaponHungEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.wpn_id_ != nullptr);
+      _impl_.wpn_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.wpn_state_ != nullptr);
+      _impl_.wpn_state_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.shooter_id_ != nullptr);
+      _impl_.shooter_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.tgt_id_ != nullptr);
+      _impl_.tgt_id_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* WeaponHungEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_shooter_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_tgt_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* WeaponHungEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* WeaponHungEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.WeaponHungEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->wpn_id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::wpn_id(this),
+        _Internal::wpn_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->wpn_state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::wpn_state(this),
+        _Internal::wpn_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->shooter_id(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::shooter_id(this),
+        _Internal::shooter_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->tgt_id(), target);
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::tgt_id(this),
+        _Internal::tgt_id(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.WeaponHungEventMsg)
   return target;
 }
 
-int WeaponHungEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t WeaponHungEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.WeaponHungEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-    if (has_wpn_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+  if (_internal_has_wpn_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.wpn_id_);
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000eu) {
     // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-    if (has_wpn_state()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.wpn_state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-    if (has_shooter_id()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->shooter_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.shooter_id_);
     }
 
     // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-    if (has_tgt_id()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->tgt_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.tgt_id_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void WeaponHungEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const WeaponHungEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const WeaponHungEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData WeaponHungEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    WeaponHungEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*WeaponHungEventMsg::GetClassData() const { return &_class_data_; }
 
-void WeaponHungEventMsg::MergeFrom(const WeaponHungEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_wpn_id()) {
-      mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.wpn_id());
+
+void WeaponHungEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<WeaponHungEventMsg*>(&to_msg);
+  auto& from = static_cast<const WeaponHungEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.WeaponHungEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_wpn_id());
     }
-    if (from.has_wpn_state()) {
-      mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.wpn_state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_wpn_state());
     }
-    if (from.has_shooter_id()) {
-      mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.shooter_id());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_shooter_id());
     }
-    if (from.has_tgt_id()) {
-      mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.tgt_id());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_tgt_id());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void WeaponHungEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void WeaponHungEventMsg::CopyFrom(const WeaponHungEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.WeaponHungEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool WeaponHungEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_wpn_id()) {
-    if (!this->wpn_id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_wpn_id()) {
+    if (!_impl_.wpn_id_->IsInitialized()) return false;
   }
-  if (has_wpn_state()) {
-    if (!this->wpn_state().IsInitialized()) return false;
+  if (_internal_has_wpn_state()) {
+    if (!_impl_.wpn_state_->IsInitialized()) return false;
   }
-  if (has_shooter_id()) {
-    if (!this->shooter_id().IsInitialized()) return false;
+  if (_internal_has_shooter_id()) {
+    if (!_impl_.shooter_id_->IsInitialized()) return false;
   }
-  if (has_tgt_id()) {
-    if (!this->tgt_id().IsInitialized()) return false;
+  if (_internal_has_tgt_id()) {
+    if (!_impl_.tgt_id_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void WeaponHungEventMsg::Swap(WeaponHungEventMsg* other) {
-  if (other != this) {
-    std::swap(wpn_id_, other->wpn_id_);
-    std::swap(wpn_state_, other->wpn_state_);
-    std::swap(shooter_id_, other->shooter_id_);
-    std::swap(tgt_id_, other->tgt_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void WeaponHungEventMsg::InternalSwap(WeaponHungEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(WeaponHungEventMsg, _impl_.tgt_id_)
+      + sizeof(WeaponHungEventMsg::_impl_.tgt_id_)
+      - PROTOBUF_FIELD_OFFSET(WeaponHungEventMsg, _impl_.wpn_id_)>(
+          reinterpret_cast<char*>(&_impl_.wpn_id_),
+          reinterpret_cast<char*>(&other->_impl_.wpn_id_));
 }
 
-::google::protobuf::Metadata WeaponHungEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = WeaponHungEventMsg_descriptor_;
-  metadata.reflection = WeaponHungEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata WeaponHungEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[14]);
 }
 
-
 // ===================================================================
 
-const ::google::protobuf::EnumDescriptor* WeaponDetonationEventMsg_DetonationType_descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return WeaponDetonationEventMsg_DetonationType_descriptor_;
-}
-bool WeaponDetonationEventMsg_DetonationType_IsValid(int value) {
-  switch(value) {
-    case 0:
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-    case 5:
-    case 6:
-      return true;
-    default:
-      return false;
+class WeaponDetonationEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<WeaponDetonationEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& wpn_id(const WeaponDetonationEventMsg* msg);
+  static void set_has_wpn_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
   }
-}
+  static const ::mixr::recorder::pb::PlayerState& wpn_state(const WeaponDetonationEventMsg* msg);
+  static void set_has_wpn_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& shooter_id(const WeaponDetonationEventMsg* msg);
+  static void set_has_shooter_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& tgt_id(const WeaponDetonationEventMsg* msg);
+  static void set_has_tgt_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_det_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_miss_dist(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-#ifndef _MSC_VER
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_OTHER;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_ENTITY_IMPACT;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_ENTITY_PROXIMATE_DETONATION;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_GROUND_IMPACT;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_GROUND_PROXIMATE_DETONATION;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_DETONATION;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DETONATE_NONE;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DetonationType_MIN;
-const WeaponDetonationEventMsg_DetonationType WeaponDetonationEventMsg::DetonationType_MAX;
-const int WeaponDetonationEventMsg::DetonationType_ARRAYSIZE;
-#endif  // _MSC_VER
-#ifndef _MSC_VER
-const int WeaponDetonationEventMsg::kWpnIdFieldNumber;
-const int WeaponDetonationEventMsg::kWpnStateFieldNumber;
-const int WeaponDetonationEventMsg::kShooterIdFieldNumber;
-const int WeaponDetonationEventMsg::kTgtIdFieldNumber;
-const int WeaponDetonationEventMsg::kDetTypeFieldNumber;
-const int WeaponDetonationEventMsg::kMissDistFieldNumber;
-#endif  // !_MSC_VER
-
-WeaponDetonationEventMsg::WeaponDetonationEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.WeaponDetonationEventMsg)
-}
-
-void WeaponDetonationEventMsg::InitAsDefaultInstance() {
-  wpn_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  wpn_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  shooter_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  tgt_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+const ::mixr::recorder::pb::PlayerId&
+WeaponDetonationEventMsg::_Internal::wpn_id(const WeaponDetonationEventMsg* msg) {
+  return *msg->_impl_.wpn_id_;
+}
+const ::mixr::recorder::pb::PlayerState&
+WeaponDetonationEventMsg::_Internal::wpn_state(const WeaponDetonationEventMsg* msg) {
+  return *msg->_impl_.wpn_state_;
+}
+const ::mixr::recorder::pb::PlayerId&
+WeaponDetonationEventMsg::_Internal::shooter_id(const WeaponDetonationEventMsg* msg) {
+  return *msg->_impl_.shooter_id_;
+}
+const ::mixr::recorder::pb::PlayerId&
+WeaponDetonationEventMsg::_Internal::tgt_id(const WeaponDetonationEventMsg* msg) {
+  return *msg->_impl_.tgt_id_;
+}
+WeaponDetonationEventMsg::WeaponDetonationEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.WeaponDetonationEventMsg)
 }
-
 WeaponDetonationEventMsg::WeaponDetonationEventMsg(const WeaponDetonationEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  WeaponDetonationEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}
+    , decltype(_impl_.miss_dist_){}
+    , decltype(_impl_.det_type_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_wpn_id()) {
+    _this->_impl_.wpn_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.wpn_id_);
+  }
+  if (from._internal_has_wpn_state()) {
+    _this->_impl_.wpn_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.wpn_state_);
+  }
+  if (from._internal_has_shooter_id()) {
+    _this->_impl_.shooter_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.shooter_id_);
+  }
+  if (from._internal_has_tgt_id()) {
+    _this->_impl_.tgt_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.tgt_id_);
+  }
+  ::memcpy(&_impl_.miss_dist_, &from._impl_.miss_dist_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.det_type_) -
+    reinterpret_cast<char*>(&_impl_.miss_dist_)) + sizeof(_impl_.det_type_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.WeaponDetonationEventMsg)
 }
 
-void WeaponDetonationEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  wpn_id_ = NULL;
-  wpn_state_ = NULL;
-  shooter_id_ = NULL;
-  tgt_id_ = NULL;
-  det_type_ = 0;
-  miss_dist_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void WeaponDetonationEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.wpn_id_){nullptr}
+    , decltype(_impl_.wpn_state_){nullptr}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.tgt_id_){nullptr}
+    , decltype(_impl_.miss_dist_){0}
+    , decltype(_impl_.det_type_){0}
+  };
 }
 
 WeaponDetonationEventMsg::~WeaponDetonationEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.WeaponDetonationEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void WeaponDetonationEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete wpn_id_;
-    delete wpn_state_;
-    delete shooter_id_;
-    delete tgt_id_;
-  }
+inline void WeaponDetonationEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.wpn_id_;
+  if (this != internal_default_instance()) delete _impl_.wpn_state_;
+  if (this != internal_default_instance()) delete _impl_.shooter_id_;
+  if (this != internal_default_instance()) delete _impl_.tgt_id_;
 }
 
 void WeaponDetonationEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* WeaponDetonationEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return WeaponDetonationEventMsg_descriptor_;
-}
-
-const WeaponDetonationEventMsg& WeaponDetonationEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-WeaponDetonationEventMsg* WeaponDetonationEventMsg::default_instance_ = NULL;
-
-WeaponDetonationEventMsg* WeaponDetonationEventMsg::New() const {
-  return new WeaponDetonationEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void WeaponDetonationEventMsg::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<WeaponDetonationEventMsg*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 63) {
-    ZR_(miss_dist_, det_type_);
-    if (has_wpn_id()) {
-      if (wpn_id_ != NULL) wpn_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_wpn_state()) {
-      if (wpn_state_ != NULL) wpn_state_->::mixr::recorder::pb::PlayerState::Clear();
-    }
-    if (has_shooter_id()) {
-      if (shooter_id_ != NULL) shooter_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_tgt_id()) {
-      if (tgt_id_ != NULL) tgt_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool WeaponDetonationEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.WeaponDetonationEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.WeaponDetonationEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.wpn_id_ != nullptr);
+      _impl_.wpn_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.wpn_state_ != nullptr);
+      _impl_.wpn_state_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.shooter_id_ != nullptr);
+      _impl_.shooter_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.tgt_id_ != nullptr);
+      _impl_.tgt_id_->Clear();
+    }
+  }
+  if (cached_has_bits & 0x00000030u) {
+    ::memset(&_impl_.miss_dist_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.det_type_) -
+        reinterpret_cast<char*>(&_impl_.miss_dist_)) + sizeof(_impl_.det_type_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* WeaponDetonationEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_wpn_state;
-        break;
-      }
-
+        continue;
       // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_wpn_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_wpn_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_shooter_id;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_wpn_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_shooter_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_shooter_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(34)) goto parse_tgt_id;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_shooter_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-      case 4: {
-        if (tag == 34) {
-         parse_tgt_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_tgt_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(40)) goto parse_det_type;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_tgt_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.WeaponDetonationEventMsg.DetonationType det_type = 5;
-      case 5: {
-        if (tag == 40) {
-         parse_det_type:
-          int value;
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
-                 input, &value)));
-          if (::mixr::recorder::pb::WeaponDetonationEventMsg_DetonationType_IsValid(value)) {
-            set_det_type(static_cast< ::mixr::recorder::pb::WeaponDetonationEventMsg_DetonationType >(value));
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::mixr::recorder::pb::WeaponDetonationEventMsg_DetonationType_IsValid(val))) {
+            _internal_set_det_type(static_cast<::mixr::recorder::pb::WeaponDetonationEventMsg_DetonationType>(val));
           } else {
-            mutable_unknown_fields()->AddVarint(5, value);
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(5, val, mutable_unknown_fields());
           }
-        } else {
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(49)) goto parse_miss_dist;
-        break;
-      }
-
+        continue;
       // optional double miss_dist = 6;
-      case 6: {
-        if (tag == 49) {
-         parse_miss_dist:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &miss_dist_)));
-          set_has_miss_dist();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.WeaponDetonationEventMsg)
-  return true;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _Internal::set_has_miss_dist(&has_bits);
+          _impl_.miss_dist_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.WeaponDetonationEventMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void WeaponDetonationEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.WeaponDetonationEventMsg)
-  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->wpn_id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->wpn_state(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->shooter_id(), output);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->tgt_id(), output);
-  }
-
-  // optional .mixr.recorder.pb.WeaponDetonationEventMsg.DetonationType det_type = 5;
-  if (has_det_type()) {
-    ::google::protobuf::internal::WireFormatLite::WriteEnum(
-      5, this->det_type(), output);
-  }
-
-  // optional double miss_dist = 6;
-  if (has_miss_dist()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(6, this->miss_dist(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.WeaponDetonationEventMsg)
-}
-
-::google::protobuf::uint8* WeaponDetonationEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* WeaponDetonationEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.WeaponDetonationEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-  if (has_wpn_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->wpn_id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::wpn_id(this),
+        _Internal::wpn_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-  if (has_wpn_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->wpn_state(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::wpn_state(this),
+        _Internal::wpn_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-  if (has_shooter_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->shooter_id(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::shooter_id(this),
+        _Internal::shooter_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-  if (has_tgt_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->tgt_id(), target);
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::tgt_id(this),
+        _Internal::tgt_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.WeaponDetonationEventMsg.DetonationType det_type = 5;
-  if (has_det_type()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
-      5, this->det_type(), target);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      5, this->_internal_det_type(), target);
   }
 
   // optional double miss_dist = 6;
-  if (has_miss_dist()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(6, this->miss_dist(), target);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(6, this->_internal_miss_dist(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.WeaponDetonationEventMsg)
   return target;
 }
 
-int WeaponDetonationEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t WeaponDetonationEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.WeaponDetonationEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId wpn_id = 1;
-    if (has_wpn_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required .mixr.recorder.pb.PlayerId wpn_id = 1;
+  if (_internal_has_wpn_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.wpn_id_);
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003eu) {
     // optional .mixr.recorder.pb.PlayerState wpn_state = 2;
-    if (has_wpn_state()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->wpn_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.wpn_state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId shooter_id = 3;
-    if (has_shooter_id()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->shooter_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.shooter_id_);
     }
 
     // optional .mixr.recorder.pb.PlayerId tgt_id = 4;
-    if (has_tgt_id()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->tgt_id());
-    }
-
-    // optional .mixr.recorder.pb.WeaponDetonationEventMsg.DetonationType det_type = 5;
-    if (has_det_type()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::EnumSize(this->det_type());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.tgt_id_);
     }
 
     // optional double miss_dist = 6;
-    if (has_miss_dist()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 + 8;
     }
 
-  }
-  total_size += _extensions_.ByteSize();
+    // optional .mixr.recorder.pb.WeaponDetonationEventMsg.DetonationType det_type = 5;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::EnumSize(this->_internal_det_type());
+    }
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void WeaponDetonationEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const WeaponDetonationEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const WeaponDetonationEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData WeaponDetonationEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    WeaponDetonationEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*WeaponDetonationEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void WeaponDetonationEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<WeaponDetonationEventMsg*>(&to_msg);
+  auto& from = static_cast<const WeaponDetonationEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.WeaponDetonationEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void WeaponDetonationEventMsg::MergeFrom(const WeaponDetonationEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_wpn_id()) {
-      mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.wpn_id());
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_wpn_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_wpn_id());
     }
-    if (from.has_wpn_state()) {
-      mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.wpn_state());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_wpn_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_wpn_state());
     }
-    if (from.has_shooter_id()) {
-      mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.shooter_id());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_shooter_id());
     }
-    if (from.has_tgt_id()) {
-      mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.tgt_id());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_tgt_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_tgt_id());
     }
-    if (from.has_det_type()) {
-      set_det_type(from.det_type());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.miss_dist_ = from._impl_.miss_dist_;
     }
-    if (from.has_miss_dist()) {
-      set_miss_dist(from.miss_dist());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.det_type_ = from._impl_.det_type_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void WeaponDetonationEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void WeaponDetonationEventMsg::CopyFrom(const WeaponDetonationEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.WeaponDetonationEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool WeaponDetonationEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_wpn_id()) {
-    if (!this->wpn_id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_wpn_id()) {
+    if (!_impl_.wpn_id_->IsInitialized()) return false;
   }
-  if (has_wpn_state()) {
-    if (!this->wpn_state().IsInitialized()) return false;
+  if (_internal_has_wpn_state()) {
+    if (!_impl_.wpn_state_->IsInitialized()) return false;
   }
-  if (has_shooter_id()) {
-    if (!this->shooter_id().IsInitialized()) return false;
+  if (_internal_has_shooter_id()) {
+    if (!_impl_.shooter_id_->IsInitialized()) return false;
   }
-  if (has_tgt_id()) {
-    if (!this->tgt_id().IsInitialized()) return false;
+  if (_internal_has_tgt_id()) {
+    if (!_impl_.tgt_id_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void WeaponDetonationEventMsg::Swap(WeaponDetonationEventMsg* other) {
-  if (other != this) {
-    std::swap(wpn_id_, other->wpn_id_);
-    std::swap(wpn_state_, other->wpn_state_);
-    std::swap(shooter_id_, other->shooter_id_);
-    std::swap(tgt_id_, other->tgt_id_);
-    std::swap(det_type_, other->det_type_);
-    std::swap(miss_dist_, other->miss_dist_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void WeaponDetonationEventMsg::InternalSwap(WeaponDetonationEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(WeaponDetonationEventMsg, _impl_.det_type_)
+      + sizeof(WeaponDetonationEventMsg::_impl_.det_type_)
+      - PROTOBUF_FIELD_OFFSET(WeaponDetonationEventMsg, _impl_.wpn_id_)>(
+          reinterpret_cast<char*>(&_impl_.wpn_id_),
+          reinterpret_cast<char*>(&other->_impl_.wpn_id_));
 }
 
-::google::protobuf::Metadata WeaponDetonationEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = WeaponDetonationEventMsg_descriptor_;
-  metadata.reflection = WeaponDetonationEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata WeaponDetonationEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[15]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int GunFiredEventMsg::kShooterIdFieldNumber;
-const int GunFiredEventMsg::kRoundsFieldNumber;
-#endif  // !_MSC_VER
+class GunFiredEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<GunFiredEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& shooter_id(const GunFiredEventMsg* msg);
+  static void set_has_shooter_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_rounds(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-GunFiredEventMsg::GunFiredEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.GunFiredEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+GunFiredEventMsg::_Internal::shooter_id(const GunFiredEventMsg* msg) {
+  return *msg->_impl_.shooter_id_;
 }
-
-void GunFiredEventMsg::InitAsDefaultInstance() {
-  shooter_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+GunFiredEventMsg::GunFiredEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.GunFiredEventMsg)
 }
-
 GunFiredEventMsg::GunFiredEventMsg(const GunFiredEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  GunFiredEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.rounds_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_shooter_id()) {
+    _this->_impl_.shooter_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.shooter_id_);
+  }
+  _this->_impl_.rounds_ = from._impl_.rounds_;
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.GunFiredEventMsg)
 }
 
-void GunFiredEventMsg::SharedCtor() {
-  _cached_size_ = 0;
-  shooter_id_ = NULL;
-  rounds_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void GunFiredEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.shooter_id_){nullptr}
+    , decltype(_impl_.rounds_){0u}
+  };
 }
 
 GunFiredEventMsg::~GunFiredEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.GunFiredEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void GunFiredEventMsg::SharedDtor() {
-  if (this != default_instance_) {
-    delete shooter_id_;
-  }
+inline void GunFiredEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.shooter_id_;
 }
 
 void GunFiredEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* GunFiredEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return GunFiredEventMsg_descriptor_;
-}
-
-const GunFiredEventMsg& GunFiredEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-GunFiredEventMsg* GunFiredEventMsg::default_instance_ = NULL;
-
-GunFiredEventMsg* GunFiredEventMsg::New() const {
-  return new GunFiredEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void GunFiredEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_shooter_id()) {
-      if (shooter_id_ != NULL) shooter_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    rounds_ = 0u;
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool GunFiredEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.GunFiredEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.GunFiredEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    GOOGLE_DCHECK(_impl_.shooter_id_ != nullptr);
+    _impl_.shooter_id_->Clear();
+  }
+  _impl_.rounds_ = 0u;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* GunFiredEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId shooter_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_shooter_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_shooter_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(16)) goto parse_rounds;
-        break;
-      }
-
+        continue;
       // optional uint32 rounds = 2;
-      case 2: {
-        if (tag == 16) {
-         parse_rounds:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &rounds_)));
-          set_has_rounds();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.GunFiredEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_rounds(&has_bits);
+          _impl_.rounds_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.GunFiredEventMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void GunFiredEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.GunFiredEventMsg)
-  // required .mixr.recorder.pb.PlayerId shooter_id = 1;
-  if (has_shooter_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->shooter_id(), output);
-  }
-
-  // optional uint32 rounds = 2;
-  if (has_rounds()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->rounds(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.GunFiredEventMsg)
-}
-
-::google::protobuf::uint8* GunFiredEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* GunFiredEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.GunFiredEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId shooter_id = 1;
-  if (has_shooter_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->shooter_id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::shooter_id(this),
+        _Internal::shooter_id(this).GetCachedSize(), target, stream);
   }
 
   // optional uint32 rounds = 2;
-  if (has_rounds()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->rounds(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_rounds(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.GunFiredEventMsg)
   return target;
 }
 
-int GunFiredEventMsg::ByteSize() const {
-  int total_size = 0;
+size_t GunFiredEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.GunFiredEventMsg)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId shooter_id = 1;
-    if (has_shooter_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->shooter_id());
-    }
-
-    // optional uint32 rounds = 2;
-    if (has_rounds()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->rounds());
-    }
+  total_size += _impl_._extensions_.ByteSize();
 
+  // required .mixr.recorder.pb.PlayerId shooter_id = 1;
+  if (_internal_has_shooter_id()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.shooter_id_);
   }
-  total_size += _extensions_.ByteSize();
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  // optional uint32 rounds = 2;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_rounds());
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void GunFiredEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const GunFiredEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const GunFiredEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void GunFiredEventMsg::MergeFrom(const GunFiredEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_shooter_id()) {
-      mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.shooter_id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GunFiredEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    GunFiredEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GunFiredEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void GunFiredEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GunFiredEventMsg*>(&to_msg);
+  auto& from = static_cast<const GunFiredEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.GunFiredEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_shooter_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_shooter_id());
     }
-    if (from.has_rounds()) {
-      set_rounds(from.rounds());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.rounds_ = from._impl_.rounds_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void GunFiredEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void GunFiredEventMsg::CopyFrom(const GunFiredEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.GunFiredEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool GunFiredEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
-  if (has_shooter_id()) {
-    if (!this->shooter_id().IsInitialized()) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
   }
 
-  if (!_extensions_.IsInitialized()) return false;  return true;
-}
-
-void GunFiredEventMsg::Swap(GunFiredEventMsg* other) {
-  if (other != this) {
-    std::swap(shooter_id_, other->shooter_id_);
-    std::swap(rounds_, other->rounds_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_shooter_id()) {
+    if (!_impl_.shooter_id_->IsInitialized()) return false;
   }
+  return true;
 }
 
-::google::protobuf::Metadata GunFiredEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = GunFiredEventMsg_descriptor_;
-  metadata.reflection = GunFiredEventMsg_reflection_;
-  return metadata;
+void GunFiredEventMsg::InternalSwap(GunFiredEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(GunFiredEventMsg, _impl_.rounds_)
+      + sizeof(GunFiredEventMsg::_impl_.rounds_)
+      - PROTOBUF_FIELD_OFFSET(GunFiredEventMsg, _impl_.shooter_id_)>(
+          reinterpret_cast<char*>(&_impl_.shooter_id_),
+          reinterpret_cast<char*>(&other->_impl_.shooter_id_));
 }
 
+::PROTOBUF_NAMESPACE_ID::Metadata GunFiredEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[16]);
+}
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int NewTrackEventMsg::kPlayerIdFieldNumber;
-const int NewTrackEventMsg::kTrackIdFieldNumber;
-const int NewTrackEventMsg::kTrackDataFieldNumber;
-const int NewTrackEventMsg::kPlayerStateFieldNumber;
-const int NewTrackEventMsg::kTrkPlayerIdFieldNumber;
-const int NewTrackEventMsg::kTrkPlayerStateFieldNumber;
-const int NewTrackEventMsg::kEmissionDataFieldNumber;
-#endif  // !_MSC_VER
+class NewTrackEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<NewTrackEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& player_id(const NewTrackEventMsg* msg);
+  static void set_has_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_track_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::TrackData& track_data(const NewTrackEventMsg* msg);
+  static void set_has_track_data(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& player_state(const NewTrackEventMsg* msg);
+  static void set_has_player_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& trk_player_id(const NewTrackEventMsg* msg);
+  static void set_has_trk_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& trk_player_state(const NewTrackEventMsg* msg);
+  static void set_has_trk_player_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static const ::mixr::recorder::pb::EmissionData& emission_data(const NewTrackEventMsg* msg);
+  static void set_has_emission_data(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-NewTrackEventMsg::NewTrackEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.NewTrackEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+NewTrackEventMsg::_Internal::player_id(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.player_id_;
 }
-
-void NewTrackEventMsg::InitAsDefaultInstance() {
-  player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  track_data_ = const_cast< ::mixr::recorder::pb::TrackData*>(&::mixr::recorder::pb::TrackData::default_instance());
-  player_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  trk_player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  trk_player_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  emission_data_ = const_cast< ::mixr::recorder::pb::EmissionData*>(&::mixr::recorder::pb::EmissionData::default_instance());
+const ::mixr::recorder::pb::TrackData&
+NewTrackEventMsg::_Internal::track_data(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.track_data_;
+}
+const ::mixr::recorder::pb::PlayerState&
+NewTrackEventMsg::_Internal::player_state(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.player_state_;
+}
+const ::mixr::recorder::pb::PlayerId&
+NewTrackEventMsg::_Internal::trk_player_id(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.trk_player_id_;
+}
+const ::mixr::recorder::pb::PlayerState&
+NewTrackEventMsg::_Internal::trk_player_state(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.trk_player_state_;
+}
+const ::mixr::recorder::pb::EmissionData&
+NewTrackEventMsg::_Internal::emission_data(const NewTrackEventMsg* msg) {
+  return *msg->_impl_.emission_data_;
+}
+NewTrackEventMsg::NewTrackEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.NewTrackEventMsg)
 }
-
 NewTrackEventMsg::NewTrackEventMsg(const NewTrackEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  NewTrackEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}
+    , decltype(_impl_.track_data_){nullptr}
+    , decltype(_impl_.player_state_){nullptr}
+    , decltype(_impl_.trk_player_id_){nullptr}
+    , decltype(_impl_.trk_player_state_){nullptr}
+    , decltype(_impl_.emission_data_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_track_id()) {
+    _this->_impl_.track_id_.Set(from._internal_track_id(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_player_id()) {
+    _this->_impl_.player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.player_id_);
+  }
+  if (from._internal_has_track_data()) {
+    _this->_impl_.track_data_ = new ::mixr::recorder::pb::TrackData(*from._impl_.track_data_);
+  }
+  if (from._internal_has_player_state()) {
+    _this->_impl_.player_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.player_state_);
+  }
+  if (from._internal_has_trk_player_id()) {
+    _this->_impl_.trk_player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.trk_player_id_);
+  }
+  if (from._internal_has_trk_player_state()) {
+    _this->_impl_.trk_player_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.trk_player_state_);
+  }
+  if (from._internal_has_emission_data()) {
+    _this->_impl_.emission_data_ = new ::mixr::recorder::pb::EmissionData(*from._impl_.emission_data_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.NewTrackEventMsg)
 }
 
-void NewTrackEventMsg::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  player_id_ = NULL;
-  track_id_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  track_data_ = NULL;
-  player_state_ = NULL;
-  trk_player_id_ = NULL;
-  trk_player_state_ = NULL;
-  emission_data_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void NewTrackEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}
+    , decltype(_impl_.track_data_){nullptr}
+    , decltype(_impl_.player_state_){nullptr}
+    , decltype(_impl_.trk_player_id_){nullptr}
+    , decltype(_impl_.trk_player_state_){nullptr}
+    , decltype(_impl_.emission_data_){nullptr}
+  };
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 NewTrackEventMsg::~NewTrackEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.NewTrackEventMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void NewTrackEventMsg::SharedDtor() {
-  if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete track_id_;
-  }
-  if (this != default_instance_) {
-    delete player_id_;
-    delete track_data_;
-    delete player_state_;
-    delete trk_player_id_;
-    delete trk_player_state_;
-    delete emission_data_;
-  }
+inline void NewTrackEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.track_id_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.player_id_;
+  if (this != internal_default_instance()) delete _impl_.track_data_;
+  if (this != internal_default_instance()) delete _impl_.player_state_;
+  if (this != internal_default_instance()) delete _impl_.trk_player_id_;
+  if (this != internal_default_instance()) delete _impl_.trk_player_state_;
+  if (this != internal_default_instance()) delete _impl_.emission_data_;
 }
 
 void NewTrackEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* NewTrackEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return NewTrackEventMsg_descriptor_;
-}
-
-const NewTrackEventMsg& NewTrackEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-NewTrackEventMsg* NewTrackEventMsg::default_instance_ = NULL;
-
-NewTrackEventMsg* NewTrackEventMsg::New() const {
-  return new NewTrackEventMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void NewTrackEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 127) {
-    if (has_player_id()) {
-      if (player_id_ != NULL) player_id_->::mixr::recorder::pb::PlayerId::Clear();
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.NewTrackEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.track_id_.ClearNonDefaultToEmpty();
     }
-    if (has_track_id()) {
-      if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        track_id_->clear();
-      }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.player_id_ != nullptr);
+      _impl_.player_id_->Clear();
     }
-    if (has_track_data()) {
-      if (track_data_ != NULL) track_data_->::mixr::recorder::pb::TrackData::Clear();
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.track_data_ != nullptr);
+      _impl_.track_data_->Clear();
     }
-    if (has_player_state()) {
-      if (player_state_ != NULL) player_state_->::mixr::recorder::pb::PlayerState::Clear();
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.player_state_ != nullptr);
+      _impl_.player_state_->Clear();
     }
-    if (has_trk_player_id()) {
-      if (trk_player_id_ != NULL) trk_player_id_->::mixr::recorder::pb::PlayerId::Clear();
+    if (cached_has_bits & 0x00000010u) {
+      GOOGLE_DCHECK(_impl_.trk_player_id_ != nullptr);
+      _impl_.trk_player_id_->Clear();
     }
-    if (has_trk_player_state()) {
-      if (trk_player_state_ != NULL) trk_player_state_->::mixr::recorder::pb::PlayerState::Clear();
+    if (cached_has_bits & 0x00000020u) {
+      GOOGLE_DCHECK(_impl_.trk_player_state_ != nullptr);
+      _impl_.trk_player_state_->Clear();
     }
-    if (has_emission_data()) {
-      if (emission_data_ != NULL) emission_data_->::mixr::recorder::pb::EmissionData::Clear();
+    if (cached_has_bits & 0x00000040u) {
+      GOOGLE_DCHECK(_impl_.emission_data_ != nullptr);
+      _impl_.emission_data_->Clear();
     }
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-bool NewTrackEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.NewTrackEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* NewTrackEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId player_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_track_id;
-        break;
-      }
-
+        continue;
       // required string track_id = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_track_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_track_id()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->track_id().data(), this->track_id().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "track_id");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_track_data;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_track_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.NewTrackEventMsg.track_id");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.TrackData track_data = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_track_data:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_track_data()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(34)) goto parse_player_state;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_track_data(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerState player_state = 4;
-      case 4: {
-        if (tag == 34) {
-         parse_player_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(42)) goto parse_trk_player_id;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-      case 5: {
-        if (tag == 42) {
-         parse_trk_player_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_trk_player_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(50)) goto parse_trk_player_state;
-        break;
-      }
-
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ctx->ParseMessage(_internal_mutable_trk_player_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-      case 6: {
-        if (tag == 50) {
-         parse_trk_player_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_trk_player_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(58)) goto parse_emission_data;
-        break;
-      }
-
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ctx->ParseMessage(_internal_mutable_trk_player_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-      case 7: {
-        if (tag == 58) {
-         parse_emission_data:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_emission_data()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.NewTrackEventMsg)
-  return true;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr = ctx->ParseMessage(_internal_mutable_emission_data(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.NewTrackEventMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void NewTrackEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.NewTrackEventMsg)
+uint8_t* NewTrackEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.NewTrackEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->player_id(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::player_id(this),
+        _Internal::player_id(this).GetCachedSize(), target, stream);
   }
 
   // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      2, this->track_id(), output);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_track_id().data(), static_cast<int>(this->_internal_track_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.NewTrackEventMsg.track_id");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_track_id(), target);
   }
 
   // optional .mixr.recorder.pb.TrackData track_data = 3;
-  if (has_track_data()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->track_data(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::track_data(this),
+        _Internal::track_data(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState player_state = 4;
-  if (has_player_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->player_state(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::player_state(this),
+        _Internal::player_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-  if (has_trk_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      5, this->trk_player_id(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(5, _Internal::trk_player_id(this),
+        _Internal::trk_player_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-  if (has_trk_player_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      6, this->trk_player_state(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(6, _Internal::trk_player_state(this),
+        _Internal::trk_player_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-  if (has_emission_data()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      7, this->emission_data(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(7, _Internal::emission_data(this),
+        _Internal::emission_data(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.NewTrackEventMsg)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.NewTrackEventMsg)
+  return target;
 }
 
-::google::protobuf::uint8* NewTrackEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.NewTrackEventMsg)
-  // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->player_id(), target);
-  }
-
-  // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        2, this->track_id(), target);
-  }
+size_t NewTrackEventMsg::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.NewTrackEventMsg)
+  size_t total_size = 0;
 
-  // optional .mixr.recorder.pb.TrackData track_data = 3;
-  if (has_track_data()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->track_data(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState player_state = 4;
-  if (has_player_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->player_state(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-  if (has_trk_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        5, this->trk_player_id(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-  if (has_trk_player_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        6, this->trk_player_state(), target);
+  if (_internal_has_track_id()) {
+    // required string track_id = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
   }
 
-  // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-  if (has_emission_data()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        7, this->emission_data(), target);
+  if (_internal_has_player_id()) {
+    // required .mixr.recorder.pb.PlayerId player_id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.NewTrackEventMsg)
-  return target;
+  return total_size;
 }
+size_t NewTrackEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.NewTrackEventMsg)
+  size_t total_size = 0;
 
-int NewTrackEventMsg::ByteSize() const {
-  int total_size = 0;
+  total_size += _impl_._extensions_.ByteSize();
+
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required string track_id = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
     // required .mixr.recorder.pb.PlayerId player_id = 1;
-    if (has_player_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_id());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
 
-    // required string track_id = 2;
-    if (has_track_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->track_id());
-    }
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007cu) {
     // optional .mixr.recorder.pb.TrackData track_data = 3;
-    if (has_track_data()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->track_data());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.track_data_);
     }
 
     // optional .mixr.recorder.pb.PlayerState player_state = 4;
-    if (has_player_state()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-    if (has_trk_player_id()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->trk_player_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.trk_player_id_);
     }
 
     // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-    if (has_trk_player_state()) {
+    if (cached_has_bits & 0x00000020u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->trk_player_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.trk_player_state_);
     }
 
     // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-    if (has_emission_data()) {
+    if (cached_has_bits & 0x00000040u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->emission_data());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.emission_data_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void NewTrackEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const NewTrackEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const NewTrackEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData NewTrackEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    NewTrackEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*NewTrackEventMsg::GetClassData() const { return &_class_data_; }
+
 
-void NewTrackEventMsg::MergeFrom(const NewTrackEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_player_id()) {
-      mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.player_id());
+void NewTrackEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<NewTrackEventMsg*>(&to_msg);
+  auto& from = static_cast<const NewTrackEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.NewTrackEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_track_id(from._internal_track_id());
     }
-    if (from.has_track_id()) {
-      set_track_id(from.track_id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_player_id());
     }
-    if (from.has_track_data()) {
-      mutable_track_data()->::mixr::recorder::pb::TrackData::MergeFrom(from.track_data());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_track_data()->::mixr::recorder::pb::TrackData::MergeFrom(
+          from._internal_track_data());
     }
-    if (from.has_player_state()) {
-      mutable_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.player_state());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_player_state());
     }
-    if (from.has_trk_player_id()) {
-      mutable_trk_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.trk_player_id());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_internal_mutable_trk_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_trk_player_id());
     }
-    if (from.has_trk_player_state()) {
-      mutable_trk_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.trk_player_state());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_internal_mutable_trk_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_trk_player_state());
     }
-    if (from.has_emission_data()) {
-      mutable_emission_data()->::mixr::recorder::pb::EmissionData::MergeFrom(from.emission_data());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_internal_mutable_emission_data()->::mixr::recorder::pb::EmissionData::MergeFrom(
+          from._internal_emission_data());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void NewTrackEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void NewTrackEventMsg::CopyFrom(const NewTrackEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.NewTrackEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool NewTrackEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_player_id()) {
-    if (!this->player_id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_player_id()) {
+    if (!_impl_.player_id_->IsInitialized()) return false;
   }
-  if (has_track_data()) {
-    if (!this->track_data().IsInitialized()) return false;
+  if (_internal_has_track_data()) {
+    if (!_impl_.track_data_->IsInitialized()) return false;
   }
-  if (has_player_state()) {
-    if (!this->player_state().IsInitialized()) return false;
+  if (_internal_has_player_state()) {
+    if (!_impl_.player_state_->IsInitialized()) return false;
   }
-  if (has_trk_player_id()) {
-    if (!this->trk_player_id().IsInitialized()) return false;
+  if (_internal_has_trk_player_id()) {
+    if (!_impl_.trk_player_id_->IsInitialized()) return false;
   }
-  if (has_trk_player_state()) {
-    if (!this->trk_player_state().IsInitialized()) return false;
+  if (_internal_has_trk_player_state()) {
+    if (!_impl_.trk_player_state_->IsInitialized()) return false;
   }
-  if (has_emission_data()) {
-    if (!this->emission_data().IsInitialized()) return false;
+  if (_internal_has_emission_data()) {
+    if (!_impl_.emission_data_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void NewTrackEventMsg::Swap(NewTrackEventMsg* other) {
-  if (other != this) {
-    std::swap(player_id_, other->player_id_);
-    std::swap(track_id_, other->track_id_);
-    std::swap(track_data_, other->track_data_);
-    std::swap(player_state_, other->player_state_);
-    std::swap(trk_player_id_, other->trk_player_id_);
-    std::swap(trk_player_state_, other->trk_player_state_);
-    std::swap(emission_data_, other->emission_data_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void NewTrackEventMsg::InternalSwap(NewTrackEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.track_id_, lhs_arena,
+      &other->_impl_.track_id_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(NewTrackEventMsg, _impl_.emission_data_)
+      + sizeof(NewTrackEventMsg::_impl_.emission_data_)
+      - PROTOBUF_FIELD_OFFSET(NewTrackEventMsg, _impl_.player_id_)>(
+          reinterpret_cast<char*>(&_impl_.player_id_),
+          reinterpret_cast<char*>(&other->_impl_.player_id_));
 }
 
-::google::protobuf::Metadata NewTrackEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = NewTrackEventMsg_descriptor_;
-  metadata.reflection = NewTrackEventMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata NewTrackEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[17]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int TrackRemovedEventMsg::kPlayerIdFieldNumber;
-const int TrackRemovedEventMsg::kTrackIdFieldNumber;
-#endif  // !_MSC_VER
+class TrackRemovedEventMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<TrackRemovedEventMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& player_id(const TrackRemovedEventMsg* msg);
+  static void set_has_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_track_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-TrackRemovedEventMsg::TrackRemovedEventMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.TrackRemovedEventMsg)
+const ::mixr::recorder::pb::PlayerId&
+TrackRemovedEventMsg::_Internal::player_id(const TrackRemovedEventMsg* msg) {
+  return *msg->_impl_.player_id_;
 }
-
-void TrackRemovedEventMsg::InitAsDefaultInstance() {
-  player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+TrackRemovedEventMsg::TrackRemovedEventMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.TrackRemovedEventMsg)
 }
-
 TrackRemovedEventMsg::TrackRemovedEventMsg(const TrackRemovedEventMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  TrackRemovedEventMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_track_id()) {
+    _this->_impl_.track_id_.Set(from._internal_track_id(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_player_id()) {
+    _this->_impl_.player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.player_id_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.TrackRemovedEventMsg)
 }
 
-void TrackRemovedEventMsg::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  player_id_ = NULL;
-  track_id_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void TrackRemovedEventMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}
+  };
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 TrackRemovedEventMsg::~TrackRemovedEventMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.TrackRemovedEventMsg)
-  SharedDtor();
-}
-
-void TrackRemovedEventMsg::SharedDtor() {
-  if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete track_id_;
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
   }
-  if (this != default_instance_) {
-    delete player_id_;
-  }
-}
-
-void TrackRemovedEventMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  SharedDtor();
 }
-const ::google::protobuf::Descriptor* TrackRemovedEventMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return TrackRemovedEventMsg_descriptor_;
+
+inline void TrackRemovedEventMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.track_id_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.player_id_;
 }
 
-const TrackRemovedEventMsg& TrackRemovedEventMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
+void TrackRemovedEventMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
 }
 
-TrackRemovedEventMsg* TrackRemovedEventMsg::default_instance_ = NULL;
+void TrackRemovedEventMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.TrackRemovedEventMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-TrackRemovedEventMsg* TrackRemovedEventMsg::New() const {
-  return new TrackRemovedEventMsg;
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.track_id_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.player_id_ != nullptr);
+      _impl_.player_id_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-void TrackRemovedEventMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 3) {
-    if (has_player_id()) {
-      if (player_id_ != NULL) player_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_track_id()) {
-      if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        track_id_->clear();
-      }
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool TrackRemovedEventMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.TrackRemovedEventMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* TrackRemovedEventMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId player_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_track_id;
-        break;
-      }
-
+        continue;
       // required string track_id = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_track_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_track_id()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->track_id().data(), this->track_id().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "track_id");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.TrackRemovedEventMsg)
-  return true;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_track_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.TrackRemovedEventMsg.track_id");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.TrackRemovedEventMsg)
-  return false;
-#undef DO_
-}
-
-void TrackRemovedEventMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.TrackRemovedEventMsg)
-  // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->player_id(), output);
-  }
-
-  // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      2, this->track_id(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.TrackRemovedEventMsg)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* TrackRemovedEventMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* TrackRemovedEventMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.TrackRemovedEventMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->player_id(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::player_id(this),
+        _Internal::player_id(this).GetCachedSize(), target, stream);
   }
 
   // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        2, this->track_id(), target);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_track_id().data(), static_cast<int>(this->_internal_track_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.TrackRemovedEventMsg.track_id");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_track_id(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.TrackRemovedEventMsg)
   return target;
 }
 
-int TrackRemovedEventMsg::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .mixr.recorder.pb.PlayerId player_id = 1;
-    if (has_player_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_id());
-    }
+size_t TrackRemovedEventMsg::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.TrackRemovedEventMsg)
+  size_t total_size = 0;
 
+  if (_internal_has_track_id()) {
     // required string track_id = 2;
-    if (has_track_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->track_id());
-    }
-
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
   }
-  total_size += _extensions_.ByteSize();
 
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+  if (_internal_has_player_id()) {
+    // required .mixr.recorder.pb.PlayerId player_id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+
   return total_size;
 }
+size_t TrackRemovedEventMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.TrackRemovedEventMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
+
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required string track_id = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
+
+    // required .mixr.recorder.pb.PlayerId player_id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
 
-void TrackRemovedEventMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const TrackRemovedEventMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const TrackRemovedEventMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-    MergeFrom(*source);
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void TrackRemovedEventMsg::MergeFrom(const TrackRemovedEventMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_player_id()) {
-      mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.player_id());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData TrackRemovedEventMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    TrackRemovedEventMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*TrackRemovedEventMsg::GetClassData() const { return &_class_data_; }
+
+
+void TrackRemovedEventMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<TrackRemovedEventMsg*>(&to_msg);
+  auto& from = static_cast<const TrackRemovedEventMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.TrackRemovedEventMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_track_id(from._internal_track_id());
     }
-    if (from.has_track_id()) {
-      set_track_id(from.track_id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_player_id());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void TrackRemovedEventMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void TrackRemovedEventMsg::CopyFrom(const TrackRemovedEventMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.TrackRemovedEventMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool TrackRemovedEventMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
-
-  if (has_player_id()) {
-    if (!this->player_id().IsInitialized()) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
   }
 
-  if (!_extensions_.IsInitialized()) return false;  return true;
-}
-
-void TrackRemovedEventMsg::Swap(TrackRemovedEventMsg* other) {
-  if (other != this) {
-    std::swap(player_id_, other->player_id_);
-    std::swap(track_id_, other->track_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_player_id()) {
+    if (!_impl_.player_id_->IsInitialized()) return false;
   }
+  return true;
 }
 
-::google::protobuf::Metadata TrackRemovedEventMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = TrackRemovedEventMsg_descriptor_;
-  metadata.reflection = TrackRemovedEventMsg_reflection_;
-  return metadata;
+void TrackRemovedEventMsg::InternalSwap(TrackRemovedEventMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.track_id_, lhs_arena,
+      &other->_impl_.track_id_, rhs_arena
+  );
+  swap(_impl_.player_id_, other->_impl_.player_id_);
 }
 
+::PROTOBUF_NAMESPACE_ID::Metadata TrackRemovedEventMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[18]);
+}
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int TrackDataMsg::kPlayerIdFieldNumber;
-const int TrackDataMsg::kTrackIdFieldNumber;
-const int TrackDataMsg::kTrackDataFieldNumber;
-const int TrackDataMsg::kPlayerStateFieldNumber;
-const int TrackDataMsg::kTrkPlayerIdFieldNumber;
-const int TrackDataMsg::kTrkPlayerStateFieldNumber;
-const int TrackDataMsg::kEmissionDataFieldNumber;
-#endif  // !_MSC_VER
+class TrackDataMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<TrackDataMsg>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::PlayerId& player_id(const TrackDataMsg* msg);
+  static void set_has_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_track_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::TrackData& track_data(const TrackDataMsg* msg);
+  static void set_has_track_data(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& player_state(const TrackDataMsg* msg);
+  static void set_has_player_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& trk_player_id(const TrackDataMsg* msg);
+  static void set_has_trk_player_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static const ::mixr::recorder::pb::PlayerState& trk_player_state(const TrackDataMsg* msg);
+  static void set_has_trk_player_state(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static const ::mixr::recorder::pb::EmissionData& emission_data(const TrackDataMsg* msg);
+  static void set_has_emission_data(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-TrackDataMsg::TrackDataMsg()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.TrackDataMsg)
+const ::mixr::recorder::pb::PlayerId&
+TrackDataMsg::_Internal::player_id(const TrackDataMsg* msg) {
+  return *msg->_impl_.player_id_;
 }
-
-void TrackDataMsg::InitAsDefaultInstance() {
-  player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  track_data_ = const_cast< ::mixr::recorder::pb::TrackData*>(&::mixr::recorder::pb::TrackData::default_instance());
-  player_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  trk_player_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  trk_player_state_ = const_cast< ::mixr::recorder::pb::PlayerState*>(&::mixr::recorder::pb::PlayerState::default_instance());
-  emission_data_ = const_cast< ::mixr::recorder::pb::EmissionData*>(&::mixr::recorder::pb::EmissionData::default_instance());
+const ::mixr::recorder::pb::TrackData&
+TrackDataMsg::_Internal::track_data(const TrackDataMsg* msg) {
+  return *msg->_impl_.track_data_;
+}
+const ::mixr::recorder::pb::PlayerState&
+TrackDataMsg::_Internal::player_state(const TrackDataMsg* msg) {
+  return *msg->_impl_.player_state_;
+}
+const ::mixr::recorder::pb::PlayerId&
+TrackDataMsg::_Internal::trk_player_id(const TrackDataMsg* msg) {
+  return *msg->_impl_.trk_player_id_;
+}
+const ::mixr::recorder::pb::PlayerState&
+TrackDataMsg::_Internal::trk_player_state(const TrackDataMsg* msg) {
+  return *msg->_impl_.trk_player_state_;
+}
+const ::mixr::recorder::pb::EmissionData&
+TrackDataMsg::_Internal::emission_data(const TrackDataMsg* msg) {
+  return *msg->_impl_.emission_data_;
+}
+TrackDataMsg::TrackDataMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.TrackDataMsg)
 }
-
 TrackDataMsg::TrackDataMsg(const TrackDataMsg& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  TrackDataMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}
+    , decltype(_impl_.track_data_){nullptr}
+    , decltype(_impl_.player_state_){nullptr}
+    , decltype(_impl_.trk_player_id_){nullptr}
+    , decltype(_impl_.trk_player_state_){nullptr}
+    , decltype(_impl_.emission_data_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_track_id()) {
+    _this->_impl_.track_id_.Set(from._internal_track_id(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_player_id()) {
+    _this->_impl_.player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.player_id_);
+  }
+  if (from._internal_has_track_data()) {
+    _this->_impl_.track_data_ = new ::mixr::recorder::pb::TrackData(*from._impl_.track_data_);
+  }
+  if (from._internal_has_player_state()) {
+    _this->_impl_.player_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.player_state_);
+  }
+  if (from._internal_has_trk_player_id()) {
+    _this->_impl_.trk_player_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.trk_player_id_);
+  }
+  if (from._internal_has_trk_player_state()) {
+    _this->_impl_.trk_player_state_ = new ::mixr::recorder::pb::PlayerState(*from._impl_.trk_player_state_);
+  }
+  if (from._internal_has_emission_data()) {
+    _this->_impl_.emission_data_ = new ::mixr::recorder::pb::EmissionData(*from._impl_.emission_data_);
+  }
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.TrackDataMsg)
 }
 
-void TrackDataMsg::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  player_id_ = NULL;
-  track_id_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  track_data_ = NULL;
-  player_state_ = NULL;
-  trk_player_id_ = NULL;
-  trk_player_state_ = NULL;
-  emission_data_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void TrackDataMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.track_id_){}
+    , decltype(_impl_.player_id_){nullptr}
+    , decltype(_impl_.track_data_){nullptr}
+    , decltype(_impl_.player_state_){nullptr}
+    , decltype(_impl_.trk_player_id_){nullptr}
+    , decltype(_impl_.trk_player_state_){nullptr}
+    , decltype(_impl_.emission_data_){nullptr}
+  };
+  _impl_.track_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.track_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 TrackDataMsg::~TrackDataMsg() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.TrackDataMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void TrackDataMsg::SharedDtor() {
-  if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete track_id_;
-  }
-  if (this != default_instance_) {
-    delete player_id_;
-    delete track_data_;
-    delete player_state_;
-    delete trk_player_id_;
-    delete trk_player_state_;
-    delete emission_data_;
-  }
+inline void TrackDataMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.track_id_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.player_id_;
+  if (this != internal_default_instance()) delete _impl_.track_data_;
+  if (this != internal_default_instance()) delete _impl_.player_state_;
+  if (this != internal_default_instance()) delete _impl_.trk_player_id_;
+  if (this != internal_default_instance()) delete _impl_.trk_player_state_;
+  if (this != internal_default_instance()) delete _impl_.emission_data_;
 }
 
 void TrackDataMsg::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* TrackDataMsg::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return TrackDataMsg_descriptor_;
-}
-
-const TrackDataMsg& TrackDataMsg::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-TrackDataMsg* TrackDataMsg::default_instance_ = NULL;
-
-TrackDataMsg* TrackDataMsg::New() const {
-  return new TrackDataMsg;
+  _impl_._cached_size_.Set(size);
 }
 
 void TrackDataMsg::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 127) {
-    if (has_player_id()) {
-      if (player_id_ != NULL) player_id_->::mixr::recorder::pb::PlayerId::Clear();
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.TrackDataMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.track_id_.ClearNonDefaultToEmpty();
     }
-    if (has_track_id()) {
-      if (track_id_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        track_id_->clear();
-      }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.player_id_ != nullptr);
+      _impl_.player_id_->Clear();
     }
-    if (has_track_data()) {
-      if (track_data_ != NULL) track_data_->::mixr::recorder::pb::TrackData::Clear();
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.track_data_ != nullptr);
+      _impl_.track_data_->Clear();
     }
-    if (has_player_state()) {
-      if (player_state_ != NULL) player_state_->::mixr::recorder::pb::PlayerState::Clear();
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.player_state_ != nullptr);
+      _impl_.player_state_->Clear();
     }
-    if (has_trk_player_id()) {
-      if (trk_player_id_ != NULL) trk_player_id_->::mixr::recorder::pb::PlayerId::Clear();
+    if (cached_has_bits & 0x00000010u) {
+      GOOGLE_DCHECK(_impl_.trk_player_id_ != nullptr);
+      _impl_.trk_player_id_->Clear();
     }
-    if (has_trk_player_state()) {
-      if (trk_player_state_ != NULL) trk_player_state_->::mixr::recorder::pb::PlayerState::Clear();
+    if (cached_has_bits & 0x00000020u) {
+      GOOGLE_DCHECK(_impl_.trk_player_state_ != nullptr);
+      _impl_.trk_player_state_->Clear();
     }
-    if (has_emission_data()) {
-      if (emission_data_ != NULL) emission_data_->::mixr::recorder::pb::EmissionData::Clear();
+    if (cached_has_bits & 0x00000040u) {
+      GOOGLE_DCHECK(_impl_.emission_data_ != nullptr);
+      _impl_.emission_data_->Clear();
     }
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-bool TrackDataMsg::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.TrackDataMsg)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* TrackDataMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.PlayerId player_id = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_id()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_id(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_track_id;
-        break;
-      }
-
+        continue;
       // required string track_id = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_track_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_track_id()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->track_id().data(), this->track_id().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "track_id");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_track_data;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_track_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.TrackDataMsg.track_id");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.TrackData track_data = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_track_data:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_track_data()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(34)) goto parse_player_state;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_track_data(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerState player_state = 4;
-      case 4: {
-        if (tag == 34) {
-         parse_player_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_player_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(42)) goto parse_trk_player_id;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_player_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-      case 5: {
-        if (tag == 42) {
-         parse_trk_player_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_trk_player_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(50)) goto parse_trk_player_state;
-        break;
-      }
-
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ctx->ParseMessage(_internal_mutable_trk_player_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-      case 6: {
-        if (tag == 50) {
-         parse_trk_player_state:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_trk_player_state()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(58)) goto parse_emission_data;
-        break;
-      }
-
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ctx->ParseMessage(_internal_mutable_trk_player_state(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-      case 7: {
-        if (tag == 58) {
-         parse_emission_data:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_emission_data()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.TrackDataMsg)
-  return true;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr = ctx->ParseMessage(_internal_mutable_emission_data(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.TrackDataMsg)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void TrackDataMsg::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.TrackDataMsg)
+uint8_t* TrackDataMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.TrackDataMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->player_id(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::player_id(this),
+        _Internal::player_id(this).GetCachedSize(), target, stream);
   }
 
   // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      2, this->track_id(), output);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_track_id().data(), static_cast<int>(this->_internal_track_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.TrackDataMsg.track_id");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_track_id(), target);
   }
 
   // optional .mixr.recorder.pb.TrackData track_data = 3;
-  if (has_track_data()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->track_data(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::track_data(this),
+        _Internal::track_data(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState player_state = 4;
-  if (has_player_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->player_state(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::player_state(this),
+        _Internal::player_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-  if (has_trk_player_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      5, this->trk_player_id(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(5, _Internal::trk_player_id(this),
+        _Internal::trk_player_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-  if (has_trk_player_state()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      6, this->trk_player_state(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(6, _Internal::trk_player_state(this),
+        _Internal::trk_player_state(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-  if (has_emission_data()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      7, this->emission_data(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(7, _Internal::emission_data(this),
+        _Internal::emission_data(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.TrackDataMsg)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.TrackDataMsg)
+  return target;
 }
 
-::google::protobuf::uint8* TrackDataMsg::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.TrackDataMsg)
-  // required .mixr.recorder.pb.PlayerId player_id = 1;
-  if (has_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->player_id(), target);
-  }
-
-  // required string track_id = 2;
-  if (has_track_id()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->track_id().data(), this->track_id().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "track_id");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        2, this->track_id(), target);
-  }
-
-  // optional .mixr.recorder.pb.TrackData track_data = 3;
-  if (has_track_data()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->track_data(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerState player_state = 4;
-  if (has_player_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->player_state(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-  if (has_trk_player_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        5, this->trk_player_id(), target);
-  }
+size_t TrackDataMsg::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.TrackDataMsg)
+  size_t total_size = 0;
 
-  // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-  if (has_trk_player_state()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        6, this->trk_player_state(), target);
+  if (_internal_has_track_id()) {
+    // required string track_id = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
   }
 
-  // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-  if (has_emission_data()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        7, this->emission_data(), target);
+  if (_internal_has_player_id()) {
+    // required .mixr.recorder.pb.PlayerId player_id = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.TrackDataMsg)
-  return target;
+  return total_size;
 }
+size_t TrackDataMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.TrackDataMsg)
+  size_t total_size = 0;
+
+  total_size += _impl_._extensions_.ByteSize();
 
-int TrackDataMsg::ByteSize() const {
-  int total_size = 0;
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required string track_id = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_track_id());
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
     // required .mixr.recorder.pb.PlayerId player_id = 1;
-    if (has_player_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_id());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.player_id_);
 
-    // required string track_id = 2;
-    if (has_track_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->track_id());
-    }
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007cu) {
     // optional .mixr.recorder.pb.TrackData track_data = 3;
-    if (has_track_data()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->track_data());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.track_data_);
     }
 
     // optional .mixr.recorder.pb.PlayerState player_state = 4;
-    if (has_player_state()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->player_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.player_state_);
     }
 
     // optional .mixr.recorder.pb.PlayerId trk_player_id = 5;
-    if (has_trk_player_id()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->trk_player_id());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.trk_player_id_);
     }
 
     // optional .mixr.recorder.pb.PlayerState trk_player_state = 6;
-    if (has_trk_player_state()) {
+    if (cached_has_bits & 0x00000020u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->trk_player_state());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.trk_player_state_);
     }
 
     // optional .mixr.recorder.pb.EmissionData emission_data = 7;
-    if (has_emission_data()) {
+    if (cached_has_bits & 0x00000040u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->emission_data());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.emission_data_);
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void TrackDataMsg::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const TrackDataMsg* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const TrackDataMsg*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData TrackDataMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    TrackDataMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*TrackDataMsg::GetClassData() const { return &_class_data_; }
+
+
+void TrackDataMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<TrackDataMsg*>(&to_msg);
+  auto& from = static_cast<const TrackDataMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.TrackDataMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void TrackDataMsg::MergeFrom(const TrackDataMsg& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_player_id()) {
-      mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.player_id());
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_track_id(from._internal_track_id());
     }
-    if (from.has_track_id()) {
-      set_track_id(from.track_id());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_player_id());
     }
-    if (from.has_track_data()) {
-      mutable_track_data()->::mixr::recorder::pb::TrackData::MergeFrom(from.track_data());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_track_data()->::mixr::recorder::pb::TrackData::MergeFrom(
+          from._internal_track_data());
     }
-    if (from.has_player_state()) {
-      mutable_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.player_state());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_player_state());
     }
-    if (from.has_trk_player_id()) {
-      mutable_trk_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.trk_player_id());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_internal_mutable_trk_player_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_trk_player_id());
     }
-    if (from.has_trk_player_state()) {
-      mutable_trk_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(from.trk_player_state());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_internal_mutable_trk_player_state()->::mixr::recorder::pb::PlayerState::MergeFrom(
+          from._internal_trk_player_state());
     }
-    if (from.has_emission_data()) {
-      mutable_emission_data()->::mixr::recorder::pb::EmissionData::MergeFrom(from.emission_data());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_internal_mutable_emission_data()->::mixr::recorder::pb::EmissionData::MergeFrom(
+          from._internal_emission_data());
     }
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void TrackDataMsg::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void TrackDataMsg::CopyFrom(const TrackDataMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.TrackDataMsg)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool TrackDataMsg::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_player_id()) {
-    if (!this->player_id().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_player_id()) {
+    if (!_impl_.player_id_->IsInitialized()) return false;
   }
-  if (has_track_data()) {
-    if (!this->track_data().IsInitialized()) return false;
+  if (_internal_has_track_data()) {
+    if (!_impl_.track_data_->IsInitialized()) return false;
   }
-  if (has_player_state()) {
-    if (!this->player_state().IsInitialized()) return false;
+  if (_internal_has_player_state()) {
+    if (!_impl_.player_state_->IsInitialized()) return false;
   }
-  if (has_trk_player_id()) {
-    if (!this->trk_player_id().IsInitialized()) return false;
+  if (_internal_has_trk_player_id()) {
+    if (!_impl_.trk_player_id_->IsInitialized()) return false;
   }
-  if (has_trk_player_state()) {
-    if (!this->trk_player_state().IsInitialized()) return false;
+  if (_internal_has_trk_player_state()) {
+    if (!_impl_.trk_player_state_->IsInitialized()) return false;
   }
-  if (has_emission_data()) {
-    if (!this->emission_data().IsInitialized()) return false;
+  if (_internal_has_emission_data()) {
+    if (!_impl_.emission_data_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void TrackDataMsg::Swap(TrackDataMsg* other) {
-  if (other != this) {
-    std::swap(player_id_, other->player_id_);
-    std::swap(track_id_, other->track_id_);
-    std::swap(track_data_, other->track_data_);
-    std::swap(player_state_, other->player_state_);
-    std::swap(trk_player_id_, other->trk_player_id_);
-    std::swap(trk_player_state_, other->trk_player_state_);
-    std::swap(emission_data_, other->emission_data_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void TrackDataMsg::InternalSwap(TrackDataMsg* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.track_id_, lhs_arena,
+      &other->_impl_.track_id_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(TrackDataMsg, _impl_.emission_data_)
+      + sizeof(TrackDataMsg::_impl_.emission_data_)
+      - PROTOBUF_FIELD_OFFSET(TrackDataMsg, _impl_.player_id_)>(
+          reinterpret_cast<char*>(&_impl_.player_id_),
+          reinterpret_cast<char*>(&other->_impl_.player_id_));
 }
 
-::google::protobuf::Metadata TrackDataMsg::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = TrackDataMsg_descriptor_;
-  metadata.reflection = TrackDataMsg_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata TrackDataMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[19]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int Vector::kXFieldNumber;
-const int Vector::kYFieldNumber;
-const int Vector::kZFieldNumber;
-const int Vector::kWFieldNumber;
-#endif  // !_MSC_VER
-
-Vector::Vector()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.Vector)
-}
+class Vector::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Vector>()._impl_._has_bits_);
+  static void set_has_x(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_y(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_z(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_w(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-void Vector::InitAsDefaultInstance() {
+Vector::Vector(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.Vector)
 }
-
 Vector::Vector(const Vector& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Vector* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.x_){}
+    , decltype(_impl_.y_){}
+    , decltype(_impl_.z_){}
+    , decltype(_impl_.w_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.x_, &from._impl_.x_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.w_) -
+    reinterpret_cast<char*>(&_impl_.x_)) + sizeof(_impl_.w_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.Vector)
 }
 
-void Vector::SharedCtor() {
-  _cached_size_ = 0;
-  x_ = 0;
-  y_ = 0;
-  z_ = 0;
-  w_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void Vector::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.x_){0}
+    , decltype(_impl_.y_){0}
+    , decltype(_impl_.z_){0}
+    , decltype(_impl_.w_){0}
+  };
 }
 
 Vector::~Vector() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.Vector)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Vector::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void Vector::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
 }
 
 void Vector::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Vector::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Vector_descriptor_;
-}
-
-const Vector& Vector::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-Vector* Vector::default_instance_ = NULL;
-
-Vector* Vector::New() const {
-  return new Vector;
+  _impl_._cached_size_.Set(size);
 }
 
 void Vector::Clear() {
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<Vector*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  ZR_(x_, w_);
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Vector::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.Vector)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.Vector)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    ::memset(&_impl_.x_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.w_) -
+        reinterpret_cast<char*>(&_impl_.x_)) + sizeof(_impl_.w_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Vector::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required double x = 1;
-      case 1: {
-        if (tag == 9) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &x_)));
-          set_has_x();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(17)) goto parse_y;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_x(&has_bits);
+          _impl_.x_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // required double y = 2;
-      case 2: {
-        if (tag == 17) {
-         parse_y:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &y_)));
-          set_has_y();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(25)) goto parse_z;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_y(&has_bits);
+          _impl_.y_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double z = 3;
-      case 3: {
-        if (tag == 25) {
-         parse_z:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &z_)));
-          set_has_z();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(33)) goto parse_w;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_z(&has_bits);
+          _impl_.z_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double w = 4;
-      case 4: {
-        if (tag == 33) {
-         parse_w:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &w_)));
-          set_has_w();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.Vector)
-  return true;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_w(&has_bits);
+          _impl_.w_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.Vector)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void Vector::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.Vector)
+uint8_t* Vector::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.Vector)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required double x = 1;
-  if (has_x()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(1, this->x(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_x(), target);
   }
 
   // required double y = 2;
-  if (has_y()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(2, this->y(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_y(), target);
   }
 
   // optional double z = 3;
-  if (has_z()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(3, this->z(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_z(), target);
   }
 
   // optional double w = 4;
-  if (has_w()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(4, this->w(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_w(), target);
   }
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.Vector)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.Vector)
+  return target;
 }
 
-::google::protobuf::uint8* Vector::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.Vector)
-  // required double x = 1;
-  if (has_x()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(1, this->x(), target);
-  }
-
-  // required double y = 2;
-  if (has_y()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(2, this->y(), target);
-  }
+size_t Vector::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.Vector)
+  size_t total_size = 0;
 
-  // optional double z = 3;
-  if (has_z()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(3, this->z(), target);
+  if (_internal_has_x()) {
+    // required double x = 1;
+    total_size += 1 + 8;
   }
 
-  // optional double w = 4;
-  if (has_w()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(4, this->w(), target);
+  if (_internal_has_y()) {
+    // required double y = 2;
+    total_size += 1 + 8;
   }
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.Vector)
-  return target;
+  return total_size;
 }
+size_t Vector::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.Vector)
+  size_t total_size = 0;
 
-int Vector::ByteSize() const {
-  int total_size = 0;
-
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
     // required double x = 1;
-    if (has_x()) {
-      total_size += 1 + 8;
-    }
+    total_size += 1 + 8;
 
     // required double y = 2;
-    if (has_y()) {
-      total_size += 1 + 8;
-    }
+    total_size += 1 + 8;
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000cu) {
     // optional double z = 3;
-    if (has_z()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 8;
     }
 
     // optional double w = 4;
-    if (has_w()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 + 8;
     }
 
   }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Vector::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Vector* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Vector*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Vector::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Vector::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Vector::GetClassData() const { return &_class_data_; }
+
 
-void Vector::MergeFrom(const Vector& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_x()) {
-      set_x(from.x());
+void Vector::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Vector*>(&to_msg);
+  auto& from = static_cast<const Vector&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.Vector)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.x_ = from._impl_.x_;
     }
-    if (from.has_y()) {
-      set_y(from.y());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.y_ = from._impl_.y_;
     }
-    if (from.has_z()) {
-      set_z(from.z());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.z_ = from._impl_.z_;
     }
-    if (from.has_w()) {
-      set_w(from.w());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.w_ = from._impl_.w_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Vector::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Vector::CopyFrom(const Vector& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.Vector)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Vector::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
-
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void Vector::Swap(Vector* other) {
-  if (other != this) {
-    std::swap(x_, other->x_);
-    std::swap(y_, other->y_);
-    std::swap(z_, other->z_);
-    std::swap(w_, other->w_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void Vector::InternalSwap(Vector* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Vector, _impl_.w_)
+      + sizeof(Vector::_impl_.w_)
+      - PROTOBUF_FIELD_OFFSET(Vector, _impl_.x_)>(
+          reinterpret_cast<char*>(&_impl_.x_),
+          reinterpret_cast<char*>(&other->_impl_.x_));
 }
 
-::google::protobuf::Metadata Vector::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Vector_descriptor_;
-  metadata.reflection = Vector_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata Vector::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[20]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int Time::kSimTimeFieldNumber;
-const int Time::kExecTimeFieldNumber;
-const int Time::kUtcTimeFieldNumber;
-#endif  // !_MSC_VER
-
-Time::Time()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.Time)
-}
+class Time::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Time>()._impl_._has_bits_);
+  static void set_has_sim_time(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_exec_time(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_utc_time(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
 
-void Time::InitAsDefaultInstance() {
+Time::Time(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.Time)
 }
-
 Time::Time(const Time& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Time* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.sim_time_){}
+    , decltype(_impl_.exec_time_){}
+    , decltype(_impl_.utc_time_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  ::memcpy(&_impl_.sim_time_, &from._impl_.sim_time_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.utc_time_) -
+    reinterpret_cast<char*>(&_impl_.sim_time_)) + sizeof(_impl_.utc_time_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.Time)
 }
 
-void Time::SharedCtor() {
-  _cached_size_ = 0;
-  sim_time_ = 0;
-  exec_time_ = 0;
-  utc_time_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void Time::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.sim_time_){0}
+    , decltype(_impl_.exec_time_){0}
+    , decltype(_impl_.utc_time_){0}
+  };
 }
 
 Time::~Time() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.Time)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Time::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void Time::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
 }
 
 void Time::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Time::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Time_descriptor_;
-}
-
-const Time& Time::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-Time* Time::default_instance_ = NULL;
-
-Time* Time::New() const {
-  return new Time;
+  _impl_._cached_size_.Set(size);
 }
 
 void Time::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<Time*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  ZR_(sim_time_, utc_time_);
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Time::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.Time)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.Time)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.sim_time_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.utc_time_) -
+        reinterpret_cast<char*>(&_impl_.sim_time_)) + sizeof(_impl_.utc_time_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Time::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required double sim_time = 1;
-      case 1: {
-        if (tag == 9) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &sim_time_)));
-          set_has_sim_time();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(17)) goto parse_exec_time;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_sim_time(&has_bits);
+          _impl_.sim_time_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double exec_time = 2;
-      case 2: {
-        if (tag == 17) {
-         parse_exec_time:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &exec_time_)));
-          set_has_exec_time();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(25)) goto parse_utc_time;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_exec_time(&has_bits);
+          _impl_.exec_time_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double utc_time = 3;
-      case 3: {
-        if (tag == 25) {
-         parse_utc_time:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &utc_time_)));
-          set_has_utc_time();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.Time)
-  return true;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_utc_time(&has_bits);
+          _impl_.utc_time_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.Time)
-  return false;
-#undef DO_
-}
-
-void Time::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.Time)
-  // required double sim_time = 1;
-  if (has_sim_time()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(1, this->sim_time(), output);
-  }
-
-  // optional double exec_time = 2;
-  if (has_exec_time()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(2, this->exec_time(), output);
-  }
-
-  // optional double utc_time = 3;
-  if (has_utc_time()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(3, this->utc_time(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.Time)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* Time::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* Time::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.Time)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required double sim_time = 1;
-  if (has_sim_time()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(1, this->sim_time(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_sim_time(), target);
   }
 
   // optional double exec_time = 2;
-  if (has_exec_time()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(2, this->exec_time(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_exec_time(), target);
   }
 
   // optional double utc_time = 3;
-  if (has_utc_time()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(3, this->utc_time(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_utc_time(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.Time)
   return target;
 }
 
-int Time::ByteSize() const {
-  int total_size = 0;
+size_t Time::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.Time)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required double sim_time = 1;
-    if (has_sim_time()) {
-      total_size += 1 + 8;
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required double sim_time = 1;
+  if (_internal_has_sim_time()) {
+    total_size += 1 + 8;
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000006u) {
     // optional double exec_time = 2;
-    if (has_exec_time()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 + 8;
     }
 
     // optional double utc_time = 3;
-    if (has_utc_time()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 8;
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
-
-void Time::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Time* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Time*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Time::MergeFrom(const Time& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_sim_time()) {
-      set_sim_time(from.sim_time());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Time::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Time::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Time::GetClassData() const { return &_class_data_; }
+
+
+void Time::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Time*>(&to_msg);
+  auto& from = static_cast<const Time&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.Time)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.sim_time_ = from._impl_.sim_time_;
     }
-    if (from.has_exec_time()) {
-      set_exec_time(from.exec_time());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.exec_time_ = from._impl_.exec_time_;
     }
-    if (from.has_utc_time()) {
-      set_utc_time(from.utc_time());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.utc_time_ = from._impl_.utc_time_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Time::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Time::CopyFrom(const Time& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.Time)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Time::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
 }
 
-void Time::Swap(Time* other) {
-  if (other != this) {
-    std::swap(sim_time_, other->sim_time_);
-    std::swap(exec_time_, other->exec_time_);
-    std::swap(utc_time_, other->utc_time_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void Time::InternalSwap(Time* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Time, _impl_.utc_time_)
+      + sizeof(Time::_impl_.utc_time_)
+      - PROTOBUF_FIELD_OFFSET(Time, _impl_.sim_time_)>(
+          reinterpret_cast<char*>(&_impl_.sim_time_),
+          reinterpret_cast<char*>(&other->_impl_.sim_time_));
 }
 
-::google::protobuf::Metadata Time::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Time_descriptor_;
-  metadata.reflection = Time_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata Time::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[21]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerId::kIdFieldNumber;
-const int PlayerId::kNameFieldNumber;
-const int PlayerId::kFedNameFieldNumber;
-const int PlayerId::kSideFieldNumber;
-const int PlayerId::kMajorTypeFieldNumber;
-const int PlayerId::kAcTypeFieldNumber;
-#endif  // !_MSC_VER
-
-PlayerId::PlayerId()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerId)
-}
+class PlayerId::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerId>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_fed_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_side(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_major_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_ac_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000008) ^ 0x00000008) != 0;
+  }
+};
 
-void PlayerId::InitAsDefaultInstance() {
+PlayerId::PlayerId(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerId)
 }
-
 PlayerId::PlayerId(const PlayerId& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerId* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.fed_name_){}
+    , decltype(_impl_.ac_type_){}
+    , decltype(_impl_.id_){}
+    , decltype(_impl_.side_){}
+    , decltype(_impl_.major_type_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.fed_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.fed_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_fed_name()) {
+    _this->_impl_.fed_name_.Set(from._internal_fed_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.ac_type_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.ac_type_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_ac_type()) {
+    _this->_impl_.ac_type_.Set(from._internal_ac_type(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.major_type_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.major_type_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerId)
 }
 
-void PlayerId::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  id_ = 0u;
-  name_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  fed_name_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  side_ = 0u;
-  major_type_ = 0u;
-  ac_type_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerId::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.fed_name_){}
+    , decltype(_impl_.ac_type_){}
+    , decltype(_impl_.id_){0u}
+    , decltype(_impl_.side_){0u}
+    , decltype(_impl_.major_type_){0u}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.fed_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.fed_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.ac_type_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.ac_type_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 PlayerId::~PlayerId() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerId)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerId::SharedDtor() {
-  if (name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete name_;
-  }
-  if (fed_name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete fed_name_;
-  }
-  if (ac_type_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete ac_type_;
-  }
-  if (this != default_instance_) {
-  }
+inline void PlayerId::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  _impl_.name_.Destroy();
+  _impl_.fed_name_.Destroy();
+  _impl_.ac_type_.Destroy();
 }
 
 void PlayerId::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerId::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerId_descriptor_;
+  _impl_._cached_size_.Set(size);
 }
 
-const PlayerId& PlayerId::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerId* PlayerId::default_instance_ = NULL;
+void PlayerId::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerId)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-PlayerId* PlayerId::New() const {
-  return new PlayerId;
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.fed_name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _impl_.ac_type_.ClearNonDefaultToEmpty();
+    }
+  }
+  if (cached_has_bits & 0x00000038u) {
+    ::memset(&_impl_.id_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.major_type_) -
+        reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.major_type_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-void PlayerId::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<PlayerId*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 63) {
-    ZR_(id_, side_);
-    if (has_name()) {
-      if (name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        name_->clear();
-      }
-    }
-    if (has_fed_name()) {
-      if (fed_name_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        fed_name_->clear();
-      }
-    }
-    major_type_ = 0u;
-    if (has_ac_type()) {
-      if (ac_type_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        ac_type_->clear();
-      }
-    }
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerId::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerId)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* PlayerId::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint32 id = 1;
-      case 1: {
-        if (tag == 8) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &id_)));
-          set_has_id();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_name;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional string name = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_name:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_name()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->name().data(), this->name().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "name");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_fed_name;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.PlayerId.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional string fed_name = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_fed_name:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_fed_name()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->fed_name().data(), this->fed_name().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "fed_name");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(32)) goto parse_side;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          auto str = _internal_mutable_fed_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.PlayerId.fed_name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 side = 4;
-      case 4: {
-        if (tag == 32) {
-         parse_side:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &side_)));
-          set_has_side();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(40)) goto parse_major_type;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_side(&has_bits);
+          _impl_.side_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional uint32 major_type = 5;
-      case 5: {
-        if (tag == 40) {
-         parse_major_type:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &major_type_)));
-          set_has_major_type();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(50)) goto parse_ac_type;
-        break;
-      }
-
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_major_type(&has_bits);
+          _impl_.major_type_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional string ac_type = 6;
-      case 6: {
-        if (tag == 50) {
-         parse_ac_type:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_ac_type()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->ac_type().data(), this->ac_type().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "ac_type");
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerId)
-  return true;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          auto str = _internal_mutable_ac_type();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "mixr.recorder.pb.PlayerId.ac_type");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerId)
-  return false;
-#undef DO_
-}
-
-void PlayerId::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerId)
-  // required uint32 id = 1;
-  if (has_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->id(), output);
-  }
-
-  // optional string name = 2;
-  if (has_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->name().data(), this->name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "name");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      2, this->name(), output);
-  }
-
-  // optional string fed_name = 3;
-  if (has_fed_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->fed_name().data(), this->fed_name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "fed_name");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      3, this->fed_name(), output);
-  }
-
-  // optional uint32 side = 4;
-  if (has_side()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->side(), output);
-  }
-
-  // optional uint32 major_type = 5;
-  if (has_major_type()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->major_type(), output);
-  }
-
-  // optional string ac_type = 6;
-  if (has_ac_type()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->ac_type().data(), this->ac_type().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "ac_type");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      6, this->ac_type(), output);
-  }
-
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerId)
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* PlayerId::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* PlayerId::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerId)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 id = 1;
-  if (has_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->id(), target);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_id(), target);
   }
 
   // optional string name = 2;
-  if (has_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->name().data(), this->name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "name");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        2, this->name(), target);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.PlayerId.name");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_name(), target);
   }
 
   // optional string fed_name = 3;
-  if (has_fed_name()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->fed_name().data(), this->fed_name().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "fed_name");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        3, this->fed_name(), target);
+  if (cached_has_bits & 0x00000002u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_fed_name().data(), static_cast<int>(this->_internal_fed_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.PlayerId.fed_name");
+    target = stream->WriteStringMaybeAliased(
+        3, this->_internal_fed_name(), target);
   }
 
   // optional uint32 side = 4;
-  if (has_side()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->side(), target);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_side(), target);
   }
 
   // optional uint32 major_type = 5;
-  if (has_major_type()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->major_type(), target);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_major_type(), target);
   }
 
   // optional string ac_type = 6;
-  if (has_ac_type()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->ac_type().data(), this->ac_type().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "ac_type");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        6, this->ac_type(), target);
+  if (cached_has_bits & 0x00000004u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_ac_type().data(), static_cast<int>(this->_internal_ac_type().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "mixr.recorder.pb.PlayerId.ac_type");
+    target = stream->WriteStringMaybeAliased(
+        6, this->_internal_ac_type(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerId)
   return target;
 }
 
-int PlayerId::ByteSize() const {
-  int total_size = 0;
+size_t PlayerId::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerId)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required uint32 id = 1;
-    if (has_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->id());
-    }
+  total_size += _impl_._extensions_.ByteSize();
+
+  // required uint32 id = 1;
+  if (_internal_has_id()) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_id());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
     // optional string name = 2;
-    if (has_name()) {
+    if (cached_has_bits & 0x00000001u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->name());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_name());
     }
 
     // optional string fed_name = 3;
-    if (has_fed_name()) {
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->fed_name());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_fed_name());
     }
 
-    // optional uint32 side = 4;
-    if (has_side()) {
+    // optional string ac_type = 6;
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->side());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_ac_type());
     }
 
-    // optional uint32 major_type = 5;
-    if (has_major_type()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->major_type());
+  }
+  if (cached_has_bits & 0x00000030u) {
+    // optional uint32 side = 4;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_side());
     }
 
-    // optional string ac_type = 6;
-    if (has_ac_type()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->ac_type());
+    // optional uint32 major_type = 5;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_major_type());
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerId::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerId* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerId*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerId::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerId::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerId::GetClassData() const { return &_class_data_; }
 
-void PlayerId::MergeFrom(const PlayerId& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_id()) {
-      set_id(from.id());
+
+void PlayerId::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerId*>(&to_msg);
+  auto& from = static_cast<const PlayerId&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerId)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
     }
-    if (from.has_name()) {
-      set_name(from.name());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_fed_name(from._internal_fed_name());
     }
-    if (from.has_fed_name()) {
-      set_fed_name(from.fed_name());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_set_ac_type(from._internal_ac_type());
     }
-    if (from.has_side()) {
-      set_side(from.side());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.id_ = from._impl_.id_;
     }
-    if (from.has_major_type()) {
-      set_major_type(from.major_type());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.side_ = from._impl_.side_;
     }
-    if (from.has_ac_type()) {
-      set_ac_type(from.ac_type());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.major_type_ = from._impl_.major_type_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerId::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerId::CopyFrom(const PlayerId& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerId)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerId::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
-}
-
-void PlayerId::Swap(PlayerId* other) {
-  if (other != this) {
-    std::swap(id_, other->id_);
-    std::swap(name_, other->name_);
-    std::swap(fed_name_, other->fed_name_);
-    std::swap(side_, other->side_);
-    std::swap(major_type_, other->major_type_);
-    std::swap(ac_type_, other->ac_type_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
   }
-}
 
-::google::protobuf::Metadata PlayerId::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerId_descriptor_;
-  metadata.reflection = PlayerId_reflection_;
-  return metadata;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
 }
 
+void PlayerId::InternalSwap(PlayerId* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.fed_name_, lhs_arena,
+      &other->_impl_.fed_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.ac_type_, lhs_arena,
+      &other->_impl_.ac_type_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerId, _impl_.major_type_)
+      + sizeof(PlayerId::_impl_.major_type_)
+      - PROTOBUF_FIELD_OFFSET(PlayerId, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerId::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[22]);
+}
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int PlayerState::kPosFieldNumber;
-const int PlayerState::kAnglesFieldNumber;
-const int PlayerState::kVelFieldNumber;
-const int PlayerState::kDamageFieldNumber;
-#endif  // !_MSC_VER
+class PlayerState::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlayerState>()._impl_._has_bits_);
+  static const ::mixr::recorder::pb::Vector& pos(const PlayerState* msg);
+  static void set_has_pos(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::Vector& angles(const PlayerState* msg);
+  static void set_has_angles(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::mixr::recorder::pb::Vector& vel(const PlayerState* msg);
+  static void set_has_vel(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_damage(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-PlayerState::PlayerState()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.PlayerState)
+const ::mixr::recorder::pb::Vector&
+PlayerState::_Internal::pos(const PlayerState* msg) {
+  return *msg->_impl_.pos_;
 }
-
-void PlayerState::InitAsDefaultInstance() {
-  pos_ = const_cast< ::mixr::recorder::pb::Vector*>(&::mixr::recorder::pb::Vector::default_instance());
-  angles_ = const_cast< ::mixr::recorder::pb::Vector*>(&::mixr::recorder::pb::Vector::default_instance());
-  vel_ = const_cast< ::mixr::recorder::pb::Vector*>(&::mixr::recorder::pb::Vector::default_instance());
+const ::mixr::recorder::pb::Vector&
+PlayerState::_Internal::angles(const PlayerState* msg) {
+  return *msg->_impl_.angles_;
+}
+const ::mixr::recorder::pb::Vector&
+PlayerState::_Internal::vel(const PlayerState* msg) {
+  return *msg->_impl_.vel_;
+}
+PlayerState::PlayerState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.PlayerState)
 }
-
 PlayerState::PlayerState(const PlayerState& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlayerState* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.pos_){nullptr}
+    , decltype(_impl_.angles_){nullptr}
+    , decltype(_impl_.vel_){nullptr}
+    , decltype(_impl_.damage_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_pos()) {
+    _this->_impl_.pos_ = new ::mixr::recorder::pb::Vector(*from._impl_.pos_);
+  }
+  if (from._internal_has_angles()) {
+    _this->_impl_.angles_ = new ::mixr::recorder::pb::Vector(*from._impl_.angles_);
+  }
+  if (from._internal_has_vel()) {
+    _this->_impl_.vel_ = new ::mixr::recorder::pb::Vector(*from._impl_.vel_);
+  }
+  _this->_impl_.damage_ = from._impl_.damage_;
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.PlayerState)
 }
 
-void PlayerState::SharedCtor() {
-  _cached_size_ = 0;
-  pos_ = NULL;
-  angles_ = NULL;
-  vel_ = NULL;
-  damage_ = 0;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void PlayerState::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.pos_){nullptr}
+    , decltype(_impl_.angles_){nullptr}
+    , decltype(_impl_.vel_){nullptr}
+    , decltype(_impl_.damage_){0}
+  };
 }
 
 PlayerState::~PlayerState() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.PlayerState)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void PlayerState::SharedDtor() {
-  if (this != default_instance_) {
-    delete pos_;
-    delete angles_;
-    delete vel_;
-  }
+inline void PlayerState::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.pos_;
+  if (this != internal_default_instance()) delete _impl_.angles_;
+  if (this != internal_default_instance()) delete _impl_.vel_;
 }
 
 void PlayerState::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* PlayerState::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return PlayerState_descriptor_;
-}
-
-const PlayerState& PlayerState::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-PlayerState* PlayerState::default_instance_ = NULL;
-
-PlayerState* PlayerState::New() const {
-  return new PlayerState;
+  _impl_._cached_size_.Set(size);
 }
 
 void PlayerState::Clear() {
-  _extensions_.Clear();
-  if (_has_bits_[0 / 32] & 15) {
-    if (has_pos()) {
-      if (pos_ != NULL) pos_->::mixr::recorder::pb::Vector::Clear();
-    }
-    if (has_angles()) {
-      if (angles_ != NULL) angles_->::mixr::recorder::pb::Vector::Clear();
-    }
-    if (has_vel()) {
-      if (vel_ != NULL) vel_->::mixr::recorder::pb::Vector::Clear();
-    }
-    damage_ = 0;
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool PlayerState::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.PlayerState)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.PlayerState)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.pos_ != nullptr);
+      _impl_.pos_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.angles_ != nullptr);
+      _impl_.angles_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.vel_ != nullptr);
+      _impl_.vel_->Clear();
+    }
+  }
+  _impl_.damage_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlayerState::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .mixr.recorder.pb.Vector pos = 1;
-      case 1: {
-        if (tag == 10) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_pos()));
-        } else {
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_pos(), ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(18)) goto parse_angles;
-        break;
-      }
-
+        continue;
       // required .mixr.recorder.pb.Vector angles = 2;
-      case 2: {
-        if (tag == 18) {
-         parse_angles:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_angles()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(26)) goto parse_vel;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_angles(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.Vector vel = 3;
-      case 3: {
-        if (tag == 26) {
-         parse_vel:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_vel()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(33)) goto parse_damage;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_vel(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double damage = 4;
-      case 4: {
-        if (tag == 33) {
-         parse_damage:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &damage_)));
-          set_has_damage();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.PlayerState)
-  return true;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_damage(&has_bits);
+          _impl_.damage_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.PlayerState)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void PlayerState::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.PlayerState)
+uint8_t* PlayerState::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerState)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .mixr.recorder.pb.Vector pos = 1;
-  if (has_pos()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->pos(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::pos(this),
+        _Internal::pos(this).GetCachedSize(), target, stream);
   }
 
   // required .mixr.recorder.pb.Vector angles = 2;
-  if (has_angles()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, this->angles(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::angles(this),
+        _Internal::angles(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.Vector vel = 3;
-  if (has_vel()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->vel(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::vel(this),
+        _Internal::vel(this).GetCachedSize(), target, stream);
   }
 
   // optional double damage = 4;
-  if (has_damage()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(4, this->damage(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_damage(), target);
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.PlayerState)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerState)
+  return target;
 }
 
-::google::protobuf::uint8* PlayerState::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.PlayerState)
-  // required .mixr.recorder.pb.Vector pos = 1;
-  if (has_pos()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->pos(), target);
-  }
-
-  // required .mixr.recorder.pb.Vector angles = 2;
-  if (has_angles()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        2, this->angles(), target);
-  }
+size_t PlayerState::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:mixr.recorder.pb.PlayerState)
+  size_t total_size = 0;
 
-  // optional .mixr.recorder.pb.Vector vel = 3;
-  if (has_vel()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->vel(), target);
+  if (_internal_has_pos()) {
+    // required .mixr.recorder.pb.Vector pos = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.pos_);
   }
 
-  // optional double damage = 4;
-  if (has_damage()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(4, this->damage(), target);
+  if (_internal_has_angles()) {
+    // required .mixr.recorder.pb.Vector angles = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.angles_);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.PlayerState)
-  return target;
+  return total_size;
 }
+size_t PlayerState::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.PlayerState)
+  size_t total_size = 0;
 
-int PlayerState::ByteSize() const {
-  int total_size = 0;
+  total_size += _impl_._extensions_.ByteSize();
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
     // required .mixr.recorder.pb.Vector pos = 1;
-    if (has_pos()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->pos());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.pos_);
 
     // required .mixr.recorder.pb.Vector angles = 2;
-    if (has_angles()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->angles());
-    }
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.angles_);
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000cu) {
     // optional .mixr.recorder.pb.Vector vel = 3;
-    if (has_vel()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->vel());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.vel_);
     }
 
     // optional double damage = 4;
-    if (has_damage()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 + 8;
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void PlayerState::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const PlayerState* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const PlayerState*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlayerState::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlayerState::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlayerState::GetClassData() const { return &_class_data_; }
+
 
-void PlayerState::MergeFrom(const PlayerState& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_pos()) {
-      mutable_pos()->::mixr::recorder::pb::Vector::MergeFrom(from.pos());
+void PlayerState::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlayerState*>(&to_msg);
+  auto& from = static_cast<const PlayerState&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.PlayerState)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_pos()->::mixr::recorder::pb::Vector::MergeFrom(
+          from._internal_pos());
     }
-    if (from.has_angles()) {
-      mutable_angles()->::mixr::recorder::pb::Vector::MergeFrom(from.angles());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_angles()->::mixr::recorder::pb::Vector::MergeFrom(
+          from._internal_angles());
     }
-    if (from.has_vel()) {
-      mutable_vel()->::mixr::recorder::pb::Vector::MergeFrom(from.vel());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_vel()->::mixr::recorder::pb::Vector::MergeFrom(
+          from._internal_vel());
     }
-    if (from.has_damage()) {
-      set_damage(from.damage());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.damage_ = from._impl_.damage_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void PlayerState::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void PlayerState::CopyFrom(const PlayerState& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.PlayerState)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool PlayerState::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_pos()) {
-    if (!this->pos().IsInitialized()) return false;
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (_internal_has_pos()) {
+    if (!_impl_.pos_->IsInitialized()) return false;
   }
-  if (has_angles()) {
-    if (!this->angles().IsInitialized()) return false;
+  if (_internal_has_angles()) {
+    if (!_impl_.angles_->IsInitialized()) return false;
   }
-  if (has_vel()) {
-    if (!this->vel().IsInitialized()) return false;
+  if (_internal_has_vel()) {
+    if (!_impl_.vel_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void PlayerState::Swap(PlayerState* other) {
-  if (other != this) {
-    std::swap(pos_, other->pos_);
-    std::swap(angles_, other->angles_);
-    std::swap(vel_, other->vel_);
-    std::swap(damage_, other->damage_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void PlayerState::InternalSwap(PlayerState* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlayerState, _impl_.damage_)
+      + sizeof(PlayerState::_impl_.damage_)
+      - PROTOBUF_FIELD_OFFSET(PlayerState, _impl_.pos_)>(
+          reinterpret_cast<char*>(&_impl_.pos_),
+          reinterpret_cast<char*>(&other->_impl_.pos_));
 }
 
-::google::protobuf::Metadata PlayerState::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = PlayerState_descriptor_;
-  metadata.reflection = PlayerState_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata PlayerState::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[23]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int TrackData::kTypeFieldNumber;
-const int TrackData::kQualityFieldNumber;
-const int TrackData::kTrueAzFieldNumber;
-const int TrackData::kRelAzFieldNumber;
-const int TrackData::kElevationFieldNumber;
-const int TrackData::kRangeFieldNumber;
-const int TrackData::kLatitudeFieldNumber;
-const int TrackData::kLongitudeFieldNumber;
-const int TrackData::kAltitudeFieldNumber;
-const int TrackData::kPositionFieldNumber;
-const int TrackData::kVelocityFieldNumber;
-const int TrackData::kAvgSignalFieldNumber;
-const int TrackData::kSlIndexFieldNumber;
-const int TrackData::kWpnRelFieldNumber;
-#endif  // !_MSC_VER
-
-TrackData::TrackData()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.TrackData)
-}
-
-void TrackData::InitAsDefaultInstance() {
-  position_ = const_cast< ::mixr::recorder::pb::Vector*>(&::mixr::recorder::pb::Vector::default_instance());
-  velocity_ = const_cast< ::mixr::recorder::pb::Vector*>(&::mixr::recorder::pb::Vector::default_instance());
-}
-
-TrackData::TrackData(const TrackData& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.TrackData)
-}
-
-void TrackData::SharedCtor() {
-  _cached_size_ = 0;
-  type_ = 0u;
-  quality_ = 0;
-  true_az_ = 0;
-  rel_az_ = 0;
-  elevation_ = 0;
-  range_ = 0;
-  latitude_ = 0;
-  longitude_ = 0;
-  altitude_ = 0;
-  position_ = NULL;
-  velocity_ = NULL;
-  avg_signal_ = 0;
-  sl_index_ = 0u;
-  wpn_rel_ = false;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-}
-
-TrackData::~TrackData() {
-  // @@protoc_insertion_point(destructor:mixr.recorder.pb.TrackData)
-  SharedDtor();
-}
-
-void TrackData::SharedDtor() {
-  if (this != default_instance_) {
-    delete position_;
-    delete velocity_;
+class TrackData::_Internal {
+ public:
+  using HasBits = decltype(std::declval<TrackData>()._impl_._has_bits_);
+  static void set_has_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
   }
-}
-
-void TrackData::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* TrackData::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return TrackData_descriptor_;
-}
-
-const TrackData& TrackData::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-TrackData* TrackData::default_instance_ = NULL;
-
-TrackData* TrackData::New() const {
-  return new TrackData;
-}
-
-void TrackData::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<TrackData*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 255) {
-    ZR_(quality_, type_);
-    longitude_ = 0;
-  }
-  if (_has_bits_[8 / 32] & 16128) {
-    ZR_(avg_signal_, wpn_rel_);
-    altitude_ = 0;
-    if (has_position()) {
-      if (position_ != NULL) position_->::mixr::recorder::pb::Vector::Clear();
-    }
-    if (has_velocity()) {
-      if (velocity_ != NULL) velocity_->::mixr::recorder::pb::Vector::Clear();
-    }
-    sl_index_ = 0u;
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool TrackData::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.TrackData)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // optional uint32 type = 1;
-      case 1: {
-        if (tag == 8) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &type_)));
-          set_has_type();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(17)) goto parse_quality;
-        break;
-      }
-
-      // optional double quality = 2;
-      case 2: {
-        if (tag == 17) {
-         parse_quality:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &quality_)));
-          set_has_quality();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(25)) goto parse_true_az;
-        break;
-      }
-
-      // optional double true_az = 3;
-      case 3: {
-        if (tag == 25) {
-         parse_true_az:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &true_az_)));
-          set_has_true_az();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(33)) goto parse_rel_az;
-        break;
-      }
-
-      // optional double rel_az = 4;
-      case 4: {
-        if (tag == 33) {
-         parse_rel_az:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &rel_az_)));
-          set_has_rel_az();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(41)) goto parse_elevation;
-        break;
-      }
-
-      // optional double elevation = 5;
-      case 5: {
-        if (tag == 41) {
-         parse_elevation:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &elevation_)));
-          set_has_elevation();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(49)) goto parse_range;
-        break;
-      }
-
-      // optional double range = 6;
-      case 6: {
-        if (tag == 49) {
-         parse_range:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &range_)));
-          set_has_range();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(57)) goto parse_latitude;
-        break;
-      }
-
-      // optional double latitude = 7;
-      case 7: {
-        if (tag == 57) {
-         parse_latitude:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &latitude_)));
-          set_has_latitude();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(65)) goto parse_longitude;
-        break;
-      }
-
-      // optional double longitude = 8;
-      case 8: {
-        if (tag == 65) {
-         parse_longitude:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &longitude_)));
-          set_has_longitude();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(73)) goto parse_altitude;
-        break;
-      }
-
-      // optional double altitude = 9;
-      case 9: {
-        if (tag == 73) {
-         parse_altitude:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &altitude_)));
-          set_has_altitude();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(82)) goto parse_position;
-        break;
-      }
-
-      // optional .mixr.recorder.pb.Vector position = 10;
-      case 10: {
-        if (tag == 82) {
-         parse_position:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_position()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(90)) goto parse_velocity;
-        break;
-      }
-
-      // optional .mixr.recorder.pb.Vector velocity = 11;
-      case 11: {
-        if (tag == 90) {
-         parse_velocity:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_velocity()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(97)) goto parse_avg_signal;
-        break;
-      }
-
-      // optional double avg_signal = 12;
-      case 12: {
-        if (tag == 97) {
-         parse_avg_signal:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &avg_signal_)));
-          set_has_avg_signal();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(104)) goto parse_sl_index;
-        break;
-      }
-
-      // optional uint32 sl_index = 13;
-      case 13: {
-        if (tag == 104) {
-         parse_sl_index:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &sl_index_)));
-          set_has_sl_index();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(112)) goto parse_wpn_rel;
-        break;
-      }
-
-      // optional bool wpn_rel = 14;
-      case 14: {
-        if (tag == 112) {
-         parse_wpn_rel:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
-                 input, &wpn_rel_)));
-          set_has_wpn_rel();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.TrackData)
-  return true;
-failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.TrackData)
-  return false;
-#undef DO_
-}
-
-void TrackData::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.TrackData)
-  // optional uint32 type = 1;
-  if (has_type()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->type(), output);
+  static void set_has_quality(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
   }
-
-  // optional double quality = 2;
-  if (has_quality()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(2, this->quality(), output);
+  static void set_has_true_az(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
   }
-
-  // optional double true_az = 3;
-  if (has_true_az()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(3, this->true_az(), output);
+  static void set_has_rel_az(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
   }
-
-  // optional double rel_az = 4;
-  if (has_rel_az()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(4, this->rel_az(), output);
+  static void set_has_elevation(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
   }
-
-  // optional double elevation = 5;
-  if (has_elevation()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(5, this->elevation(), output);
+  static void set_has_range(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
   }
-
-  // optional double range = 6;
-  if (has_range()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(6, this->range(), output);
+  static void set_has_latitude(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
   }
-
-  // optional double latitude = 7;
-  if (has_latitude()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(7, this->latitude(), output);
+  static void set_has_longitude(HasBits* has_bits) {
+    (*has_bits)[0] |= 1024u;
   }
-
-  // optional double longitude = 8;
-  if (has_longitude()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(8, this->longitude(), output);
+  static void set_has_altitude(HasBits* has_bits) {
+    (*has_bits)[0] |= 2048u;
+  }
+  static const ::mixr::recorder::pb::Vector& position(const TrackData* msg);
+  static void set_has_position(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
   }
-
-  // optional double altitude = 9;
-  if (has_altitude()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(9, this->altitude(), output);
+  static const ::mixr::recorder::pb::Vector& velocity(const TrackData* msg);
+  static void set_has_velocity(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
   }
-
-  // optional .mixr.recorder.pb.Vector position = 10;
-  if (has_position()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      10, this->position(), output);
+  static void set_has_avg_signal(HasBits* has_bits) {
+    (*has_bits)[0] |= 4096u;
   }
-
-  // optional .mixr.recorder.pb.Vector velocity = 11;
-  if (has_velocity()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      11, this->velocity(), output);
+  static void set_has_sl_index(HasBits* has_bits) {
+    (*has_bits)[0] |= 512u;
   }
-
-  // optional double avg_signal = 12;
-  if (has_avg_signal()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(12, this->avg_signal(), output);
+  static void set_has_wpn_rel(HasBits* has_bits) {
+    (*has_bits)[0] |= 8192u;
   }
+};
 
-  // optional uint32 sl_index = 13;
-  if (has_sl_index()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(13, this->sl_index(), output);
-  }
+const ::mixr::recorder::pb::Vector&
+TrackData::_Internal::position(const TrackData* msg) {
+  return *msg->_impl_.position_;
+}
+const ::mixr::recorder::pb::Vector&
+TrackData::_Internal::velocity(const TrackData* msg) {
+  return *msg->_impl_.velocity_;
+}
+TrackData::TrackData(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.TrackData)
+}
+TrackData::TrackData(const TrackData& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  TrackData* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.position_){nullptr}
+    , decltype(_impl_.velocity_){nullptr}
+    , decltype(_impl_.quality_){}
+    , decltype(_impl_.true_az_){}
+    , decltype(_impl_.rel_az_){}
+    , decltype(_impl_.elevation_){}
+    , decltype(_impl_.range_){}
+    , decltype(_impl_.latitude_){}
+    , decltype(_impl_.type_){}
+    , decltype(_impl_.sl_index_){}
+    , decltype(_impl_.longitude_){}
+    , decltype(_impl_.altitude_){}
+    , decltype(_impl_.avg_signal_){}
+    , decltype(_impl_.wpn_rel_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_position()) {
+    _this->_impl_.position_ = new ::mixr::recorder::pb::Vector(*from._impl_.position_);
+  }
+  if (from._internal_has_velocity()) {
+    _this->_impl_.velocity_ = new ::mixr::recorder::pb::Vector(*from._impl_.velocity_);
+  }
+  ::memcpy(&_impl_.quality_, &from._impl_.quality_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.wpn_rel_) -
+    reinterpret_cast<char*>(&_impl_.quality_)) + sizeof(_impl_.wpn_rel_));
+  // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.TrackData)
+}
 
-  // optional bool wpn_rel = 14;
-  if (has_wpn_rel()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBool(14, this->wpn_rel(), output);
+inline void TrackData::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.position_){nullptr}
+    , decltype(_impl_.velocity_){nullptr}
+    , decltype(_impl_.quality_){0}
+    , decltype(_impl_.true_az_){0}
+    , decltype(_impl_.rel_az_){0}
+    , decltype(_impl_.elevation_){0}
+    , decltype(_impl_.range_){0}
+    , decltype(_impl_.latitude_){0}
+    , decltype(_impl_.type_){0u}
+    , decltype(_impl_.sl_index_){0u}
+    , decltype(_impl_.longitude_){0}
+    , decltype(_impl_.altitude_){0}
+    , decltype(_impl_.avg_signal_){0}
+    , decltype(_impl_.wpn_rel_){false}
+  };
+}
+
+TrackData::~TrackData() {
+  // @@protoc_insertion_point(destructor:mixr.recorder.pb.TrackData)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
   }
+  SharedDtor();
+}
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
+inline void TrackData::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.position_;
+  if (this != internal_default_instance()) delete _impl_.velocity_;
+}
 
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+void TrackData::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.TrackData)
+void TrackData::Clear() {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.TrackData)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.position_ != nullptr);
+      _impl_.position_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.velocity_ != nullptr);
+      _impl_.velocity_->Clear();
+    }
+  }
+  if (cached_has_bits & 0x000000fcu) {
+    ::memset(&_impl_.quality_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.latitude_) -
+        reinterpret_cast<char*>(&_impl_.quality_)) + sizeof(_impl_.latitude_));
+  }
+  if (cached_has_bits & 0x00003f00u) {
+    ::memset(&_impl_.type_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.wpn_rel_) -
+        reinterpret_cast<char*>(&_impl_.type_)) + sizeof(_impl_.wpn_rel_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* TrackData::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional uint32 type = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_type(&has_bits);
+          _impl_.type_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double quality = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_quality(&has_bits);
+          _impl_.quality_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double true_az = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_true_az(&has_bits);
+          _impl_.true_az_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double rel_az = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_rel_az(&has_bits);
+          _impl_.rel_az_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double elevation = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _Internal::set_has_elevation(&has_bits);
+          _impl_.elevation_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double range = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _Internal::set_has_range(&has_bits);
+          _impl_.range_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double latitude = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 57)) {
+          _Internal::set_has_latitude(&has_bits);
+          _impl_.latitude_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double longitude = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 65)) {
+          _Internal::set_has_longitude(&has_bits);
+          _impl_.longitude_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double altitude = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 73)) {
+          _Internal::set_has_altitude(&has_bits);
+          _impl_.altitude_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.Vector position = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 82)) {
+          ptr = ctx->ParseMessage(_internal_mutable_position(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .mixr.recorder.pb.Vector velocity = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 90)) {
+          ptr = ctx->ParseMessage(_internal_mutable_velocity(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double avg_signal = 12;
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 97)) {
+          _Internal::set_has_avg_signal(&has_bits);
+          _impl_.avg_signal_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint32 sl_index = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 104)) {
+          _Internal::set_has_sl_index(&has_bits);
+          _impl_.sl_index_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool wpn_rel = 14;
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 112)) {
+          _Internal::set_has_wpn_rel(&has_bits);
+          _impl_.wpn_rel_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-::google::protobuf::uint8* TrackData::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
+uint8_t* TrackData::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.TrackData)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // optional uint32 type = 1;
-  if (has_type()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->type(), target);
+  if (cached_has_bits & 0x00000100u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_type(), target);
   }
 
   // optional double quality = 2;
-  if (has_quality()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(2, this->quality(), target);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_quality(), target);
   }
 
   // optional double true_az = 3;
-  if (has_true_az()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(3, this->true_az(), target);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_true_az(), target);
   }
 
   // optional double rel_az = 4;
-  if (has_rel_az()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(4, this->rel_az(), target);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_rel_az(), target);
   }
 
   // optional double elevation = 5;
-  if (has_elevation()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(5, this->elevation(), target);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(5, this->_internal_elevation(), target);
   }
 
   // optional double range = 6;
-  if (has_range()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(6, this->range(), target);
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(6, this->_internal_range(), target);
   }
 
   // optional double latitude = 7;
-  if (has_latitude()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(7, this->latitude(), target);
+  if (cached_has_bits & 0x00000080u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(7, this->_internal_latitude(), target);
   }
 
   // optional double longitude = 8;
-  if (has_longitude()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(8, this->longitude(), target);
+  if (cached_has_bits & 0x00000400u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(8, this->_internal_longitude(), target);
   }
 
   // optional double altitude = 9;
-  if (has_altitude()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(9, this->altitude(), target);
+  if (cached_has_bits & 0x00000800u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(9, this->_internal_altitude(), target);
   }
 
   // optional .mixr.recorder.pb.Vector position = 10;
-  if (has_position()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        10, this->position(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(10, _Internal::position(this),
+        _Internal::position(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.Vector velocity = 11;
-  if (has_velocity()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        11, this->velocity(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(11, _Internal::velocity(this),
+        _Internal::velocity(this).GetCachedSize(), target, stream);
   }
 
   // optional double avg_signal = 12;
-  if (has_avg_signal()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(12, this->avg_signal(), target);
+  if (cached_has_bits & 0x00001000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(12, this->_internal_avg_signal(), target);
   }
 
   // optional uint32 sl_index = 13;
-  if (has_sl_index()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(13, this->sl_index(), target);
+  if (cached_has_bits & 0x00000200u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(13, this->_internal_sl_index(), target);
   }
 
   // optional bool wpn_rel = 14;
-  if (has_wpn_rel()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(14, this->wpn_rel(), target);
+  if (cached_has_bits & 0x00002000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(14, this->_internal_wpn_rel(), target);
   }
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
-
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.TrackData)
   return target;
 }
 
-int TrackData::ByteSize() const {
-  int total_size = 0;
+size_t TrackData::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.TrackData)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // optional uint32 type = 1;
-    if (has_type()) {
+  total_size += _impl_._extensions_.ByteSize();
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    // optional .mixr.recorder.pb.Vector position = 10;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.position_);
+    }
+
+    // optional .mixr.recorder.pb.Vector velocity = 11;
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->type());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.velocity_);
     }
 
     // optional double quality = 2;
-    if (has_quality()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 8;
     }
 
     // optional double true_az = 3;
-    if (has_true_az()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 + 8;
     }
 
     // optional double rel_az = 4;
-    if (has_rel_az()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 + 8;
     }
 
     // optional double elevation = 5;
-    if (has_elevation()) {
+    if (cached_has_bits & 0x00000020u) {
       total_size += 1 + 8;
     }
 
     // optional double range = 6;
-    if (has_range()) {
+    if (cached_has_bits & 0x00000040u) {
       total_size += 1 + 8;
     }
 
     // optional double latitude = 7;
-    if (has_latitude()) {
-      total_size += 1 + 8;
-    }
-
-    // optional double longitude = 8;
-    if (has_longitude()) {
+    if (cached_has_bits & 0x00000080u) {
       total_size += 1 + 8;
     }
 
   }
-  if (_has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    // optional double altitude = 9;
-    if (has_altitude()) {
-      total_size += 1 + 8;
+  if (cached_has_bits & 0x00003f00u) {
+    // optional uint32 type = 1;
+    if (cached_has_bits & 0x00000100u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_type());
     }
 
-    // optional .mixr.recorder.pb.Vector position = 10;
-    if (has_position()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->position());
+    // optional uint32 sl_index = 13;
+    if (cached_has_bits & 0x00000200u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_sl_index());
     }
 
-    // optional .mixr.recorder.pb.Vector velocity = 11;
-    if (has_velocity()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->velocity());
+    // optional double longitude = 8;
+    if (cached_has_bits & 0x00000400u) {
+      total_size += 1 + 8;
     }
 
-    // optional double avg_signal = 12;
-    if (has_avg_signal()) {
+    // optional double altitude = 9;
+    if (cached_has_bits & 0x00000800u) {
       total_size += 1 + 8;
     }
 
-    // optional uint32 sl_index = 13;
-    if (has_sl_index()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->sl_index());
+    // optional double avg_signal = 12;
+    if (cached_has_bits & 0x00001000u) {
+      total_size += 1 + 8;
     }
 
     // optional bool wpn_rel = 14;
-    if (has_wpn_rel()) {
+    if (cached_has_bits & 0x00002000u) {
       total_size += 1 + 1;
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void TrackData::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const TrackData* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const TrackData*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData TrackData::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    TrackData::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*TrackData::GetClassData() const { return &_class_data_; }
+
+
+void TrackData::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<TrackData*>(&to_msg);
+  auto& from = static_cast<const TrackData&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.TrackData)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void TrackData::MergeFrom(const TrackData& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_type()) {
-      set_type(from.type());
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_position()->::mixr::recorder::pb::Vector::MergeFrom(
+          from._internal_position());
     }
-    if (from.has_quality()) {
-      set_quality(from.quality());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_velocity()->::mixr::recorder::pb::Vector::MergeFrom(
+          from._internal_velocity());
     }
-    if (from.has_true_az()) {
-      set_true_az(from.true_az());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.quality_ = from._impl_.quality_;
     }
-    if (from.has_rel_az()) {
-      set_rel_az(from.rel_az());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.true_az_ = from._impl_.true_az_;
     }
-    if (from.has_elevation()) {
-      set_elevation(from.elevation());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.rel_az_ = from._impl_.rel_az_;
     }
-    if (from.has_range()) {
-      set_range(from.range());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.elevation_ = from._impl_.elevation_;
     }
-    if (from.has_latitude()) {
-      set_latitude(from.latitude());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.range_ = from._impl_.range_;
     }
-    if (from.has_longitude()) {
-      set_longitude(from.longitude());
+    if (cached_has_bits & 0x00000080u) {
+      _this->_impl_.latitude_ = from._impl_.latitude_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  if (from._has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    if (from.has_altitude()) {
-      set_altitude(from.altitude());
+  if (cached_has_bits & 0x00003f00u) {
+    if (cached_has_bits & 0x00000100u) {
+      _this->_impl_.type_ = from._impl_.type_;
     }
-    if (from.has_position()) {
-      mutable_position()->::mixr::recorder::pb::Vector::MergeFrom(from.position());
+    if (cached_has_bits & 0x00000200u) {
+      _this->_impl_.sl_index_ = from._impl_.sl_index_;
     }
-    if (from.has_velocity()) {
-      mutable_velocity()->::mixr::recorder::pb::Vector::MergeFrom(from.velocity());
+    if (cached_has_bits & 0x00000400u) {
+      _this->_impl_.longitude_ = from._impl_.longitude_;
     }
-    if (from.has_avg_signal()) {
-      set_avg_signal(from.avg_signal());
+    if (cached_has_bits & 0x00000800u) {
+      _this->_impl_.altitude_ = from._impl_.altitude_;
     }
-    if (from.has_sl_index()) {
-      set_sl_index(from.sl_index());
+    if (cached_has_bits & 0x00001000u) {
+      _this->_impl_.avg_signal_ = from._impl_.avg_signal_;
     }
-    if (from.has_wpn_rel()) {
-      set_wpn_rel(from.wpn_rel());
+    if (cached_has_bits & 0x00002000u) {
+      _this->_impl_.wpn_rel_ = from._impl_.wpn_rel_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void TrackData::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void TrackData::CopyFrom(const TrackData& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.TrackData)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool TrackData::IsInitialized() const {
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_position()) {
-    if (!this->position().IsInitialized()) return false;
+  if (_internal_has_position()) {
+    if (!_impl_.position_->IsInitialized()) return false;
   }
-  if (has_velocity()) {
-    if (!this->velocity().IsInitialized()) return false;
+  if (_internal_has_velocity()) {
+    if (!_impl_.velocity_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void TrackData::Swap(TrackData* other) {
-  if (other != this) {
-    std::swap(type_, other->type_);
-    std::swap(quality_, other->quality_);
-    std::swap(true_az_, other->true_az_);
-    std::swap(rel_az_, other->rel_az_);
-    std::swap(elevation_, other->elevation_);
-    std::swap(range_, other->range_);
-    std::swap(latitude_, other->latitude_);
-    std::swap(longitude_, other->longitude_);
-    std::swap(altitude_, other->altitude_);
-    std::swap(position_, other->position_);
-    std::swap(velocity_, other->velocity_);
-    std::swap(avg_signal_, other->avg_signal_);
-    std::swap(sl_index_, other->sl_index_);
-    std::swap(wpn_rel_, other->wpn_rel_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void TrackData::InternalSwap(TrackData* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(TrackData, _impl_.wpn_rel_)
+      + sizeof(TrackData::_impl_.wpn_rel_)
+      - PROTOBUF_FIELD_OFFSET(TrackData, _impl_.position_)>(
+          reinterpret_cast<char*>(&_impl_.position_),
+          reinterpret_cast<char*>(&other->_impl_.position_));
 }
 
-::google::protobuf::Metadata TrackData::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = TrackData_descriptor_;
-  metadata.reflection = TrackData_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata TrackData::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[24]);
 }
 
-
 // ===================================================================
 
-const ::google::protobuf::EnumDescriptor* EmissionData_Polarization_descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return EmissionData_Polarization_descriptor_;
-}
-bool EmissionData_Polarization_IsValid(int value) {
-  switch(value) {
-    case 0:
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-    case 5:
-      return true;
-    default:
-      return false;
+class EmissionData::_Internal {
+ public:
+  using HasBits = decltype(std::declval<EmissionData>()._impl_._has_bits_);
+  static void set_has_frequency(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
   }
-}
+  static void set_has_wave_length(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_pulse_width(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_bandwidth(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_prf(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static void set_has_power(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
+  }
+  static void set_has_polarization(HasBits* has_bits) {
+    (*has_bits)[0] |= 1024u;
+  }
+  static void set_has_azimuth_aoi(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
+  }
+  static void set_has_elevation_aoi(HasBits* has_bits) {
+    (*has_bits)[0] |= 512u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& origin_id(const EmissionData* msg);
+  static void set_has_origin_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::mixr::recorder::pb::PlayerId& target_id(const EmissionData* msg);
+  static void set_has_target_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
 
-#ifndef _MSC_VER
-const EmissionData_Polarization EmissionData::NONE;
-const EmissionData_Polarization EmissionData::VERTICAL;
-const EmissionData_Polarization EmissionData::HORIZONTAL;
-const EmissionData_Polarization EmissionData::SLANT;
-const EmissionData_Polarization EmissionData::RHC;
-const EmissionData_Polarization EmissionData::LHC;
-const EmissionData_Polarization EmissionData::Polarization_MIN;
-const EmissionData_Polarization EmissionData::Polarization_MAX;
-const int EmissionData::Polarization_ARRAYSIZE;
-#endif  // _MSC_VER
-#ifndef _MSC_VER
-const int EmissionData::kFrequencyFieldNumber;
-const int EmissionData::kWaveLengthFieldNumber;
-const int EmissionData::kPulseWidthFieldNumber;
-const int EmissionData::kBandwidthFieldNumber;
-const int EmissionData::kPrfFieldNumber;
-const int EmissionData::kPowerFieldNumber;
-const int EmissionData::kPolarizationFieldNumber;
-const int EmissionData::kAzimuthAoiFieldNumber;
-const int EmissionData::kElevationAoiFieldNumber;
-const int EmissionData::kOriginIdFieldNumber;
-const int EmissionData::kTargetIdFieldNumber;
-#endif  // !_MSC_VER
-
-EmissionData::EmissionData()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:mixr.recorder.pb.EmissionData)
-}
-
-void EmissionData::InitAsDefaultInstance() {
-  origin_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
-  target_id_ = const_cast< ::mixr::recorder::pb::PlayerId*>(&::mixr::recorder::pb::PlayerId::default_instance());
+const ::mixr::recorder::pb::PlayerId&
+EmissionData::_Internal::origin_id(const EmissionData* msg) {
+  return *msg->_impl_.origin_id_;
+}
+const ::mixr::recorder::pb::PlayerId&
+EmissionData::_Internal::target_id(const EmissionData* msg) {
+  return *msg->_impl_.target_id_;
+}
+EmissionData::EmissionData(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:mixr.recorder.pb.EmissionData)
 }
-
 EmissionData::EmissionData(const EmissionData& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  EmissionData* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{}
+    , decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.origin_id_){nullptr}
+    , decltype(_impl_.target_id_){nullptr}
+    , decltype(_impl_.frequency_){}
+    , decltype(_impl_.wave_length_){}
+    , decltype(_impl_.pulse_width_){}
+    , decltype(_impl_.bandwidth_){}
+    , decltype(_impl_.prf_){}
+    , decltype(_impl_.power_){}
+    , decltype(_impl_.azimuth_aoi_){}
+    , decltype(_impl_.elevation_aoi_){}
+    , decltype(_impl_.polarization_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  if (from._internal_has_origin_id()) {
+    _this->_impl_.origin_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.origin_id_);
+  }
+  if (from._internal_has_target_id()) {
+    _this->_impl_.target_id_ = new ::mixr::recorder::pb::PlayerId(*from._impl_.target_id_);
+  }
+  ::memcpy(&_impl_.frequency_, &from._impl_.frequency_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.polarization_) -
+    reinterpret_cast<char*>(&_impl_.frequency_)) + sizeof(_impl_.polarization_));
   // @@protoc_insertion_point(copy_constructor:mixr.recorder.pb.EmissionData)
 }
 
-void EmissionData::SharedCtor() {
-  _cached_size_ = 0;
-  frequency_ = 0;
-  wave_length_ = 0;
-  pulse_width_ = 0;
-  bandwidth_ = 0;
-  prf_ = 0;
-  power_ = 0;
-  polarization_ = 0;
-  azimuth_aoi_ = 0;
-  elevation_aoi_ = 0;
-  origin_id_ = NULL;
-  target_id_ = NULL;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void EmissionData::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      /*decltype(_impl_._extensions_)*/{::_pbi::ArenaInitialized(), arena}
+    , decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.origin_id_){nullptr}
+    , decltype(_impl_.target_id_){nullptr}
+    , decltype(_impl_.frequency_){0}
+    , decltype(_impl_.wave_length_){0}
+    , decltype(_impl_.pulse_width_){0}
+    , decltype(_impl_.bandwidth_){0}
+    , decltype(_impl_.prf_){0}
+    , decltype(_impl_.power_){0}
+    , decltype(_impl_.azimuth_aoi_){0}
+    , decltype(_impl_.elevation_aoi_){0}
+    , decltype(_impl_.polarization_){0}
+  };
 }
 
 EmissionData::~EmissionData() {
   // @@protoc_insertion_point(destructor:mixr.recorder.pb.EmissionData)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void EmissionData::SharedDtor() {
-  if (this != default_instance_) {
-    delete origin_id_;
-    delete target_id_;
-  }
+inline void EmissionData::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_._extensions_.~ExtensionSet();
+  if (this != internal_default_instance()) delete _impl_.origin_id_;
+  if (this != internal_default_instance()) delete _impl_.target_id_;
 }
 
 void EmissionData::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* EmissionData::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return EmissionData_descriptor_;
-}
-
-const EmissionData& EmissionData::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto();
-  return *default_instance_;
-}
-
-EmissionData* EmissionData::default_instance_ = NULL;
-
-EmissionData* EmissionData::New() const {
-  return new EmissionData;
+  _impl_._cached_size_.Set(size);
 }
 
 void EmissionData::Clear() {
-  _extensions_.Clear();
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<EmissionData*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 255) {
-    ZR_(frequency_, azimuth_aoi_);
-    polarization_ = 0;
-  }
-  if (_has_bits_[8 / 32] & 1792) {
-    elevation_aoi_ = 0;
-    if (has_origin_id()) {
-      if (origin_id_ != NULL) origin_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-    if (has_target_id()) {
-      if (target_id_ != NULL) target_id_->::mixr::recorder::pb::PlayerId::Clear();
-    }
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool EmissionData::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:mixr.recorder.pb.EmissionData)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:mixr.recorder.pb.EmissionData)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_._extensions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.origin_id_ != nullptr);
+      _impl_.origin_id_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.target_id_ != nullptr);
+      _impl_.target_id_->Clear();
+    }
+  }
+  if (cached_has_bits & 0x000000fcu) {
+    ::memset(&_impl_.frequency_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.power_) -
+        reinterpret_cast<char*>(&_impl_.frequency_)) + sizeof(_impl_.power_));
+  }
+  if (cached_has_bits & 0x00000700u) {
+    ::memset(&_impl_.azimuth_aoi_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.polarization_) -
+        reinterpret_cast<char*>(&_impl_.azimuth_aoi_)) + sizeof(_impl_.polarization_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* EmissionData::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // optional double frequency = 1;
-      case 1: {
-        if (tag == 9) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &frequency_)));
-          set_has_frequency();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(17)) goto parse_wave_length;
-        break;
-      }
-
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_frequency(&has_bits);
+          _impl_.frequency_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double wave_length = 2;
-      case 2: {
-        if (tag == 17) {
-         parse_wave_length:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &wave_length_)));
-          set_has_wave_length();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(25)) goto parse_pulse_width;
-        break;
-      }
-
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_wave_length(&has_bits);
+          _impl_.wave_length_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double pulse_width = 3;
-      case 3: {
-        if (tag == 25) {
-         parse_pulse_width:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &pulse_width_)));
-          set_has_pulse_width();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(33)) goto parse_bandwidth;
-        break;
-      }
-
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_pulse_width(&has_bits);
+          _impl_.pulse_width_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double bandwidth = 4;
-      case 4: {
-        if (tag == 33) {
-         parse_bandwidth:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &bandwidth_)));
-          set_has_bandwidth();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(41)) goto parse_prf;
-        break;
-      }
-
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_bandwidth(&has_bits);
+          _impl_.bandwidth_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double prf = 5;
-      case 5: {
-        if (tag == 41) {
-         parse_prf:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &prf_)));
-          set_has_prf();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(49)) goto parse_power;
-        break;
-      }
-
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _Internal::set_has_prf(&has_bits);
+          _impl_.prf_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double power = 6;
-      case 6: {
-        if (tag == 49) {
-         parse_power:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &power_)));
-          set_has_power();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(56)) goto parse_polarization;
-        break;
-      }
-
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _Internal::set_has_power(&has_bits);
+          _impl_.power_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.EmissionData.Polarization polarization = 7;
-      case 7: {
-        if (tag == 56) {
-         parse_polarization:
-          int value;
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
-                 input, &value)));
-          if (::mixr::recorder::pb::EmissionData_Polarization_IsValid(value)) {
-            set_polarization(static_cast< ::mixr::recorder::pb::EmissionData_Polarization >(value));
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::mixr::recorder::pb::EmissionData_Polarization_IsValid(val))) {
+            _internal_set_polarization(static_cast<::mixr::recorder::pb::EmissionData_Polarization>(val));
           } else {
-            mutable_unknown_fields()->AddVarint(7, value);
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(7, val, mutable_unknown_fields());
           }
-        } else {
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(65)) goto parse_azimuth_aoi;
-        break;
-      }
-
+        continue;
       // optional double azimuth_aoi = 8;
-      case 8: {
-        if (tag == 65) {
-         parse_azimuth_aoi:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &azimuth_aoi_)));
-          set_has_azimuth_aoi();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(73)) goto parse_elevation_aoi;
-        break;
-      }
-
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 65)) {
+          _Internal::set_has_azimuth_aoi(&has_bits);
+          _impl_.azimuth_aoi_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional double elevation_aoi = 9;
-      case 9: {
-        if (tag == 73) {
-         parse_elevation_aoi:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
-                 input, &elevation_aoi_)));
-          set_has_elevation_aoi();
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(82)) goto parse_origin_id;
-        break;
-      }
-
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 73)) {
+          _Internal::set_has_elevation_aoi(&has_bits);
+          _impl_.elevation_aoi_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId origin_id = 10;
-      case 10: {
-        if (tag == 82) {
-         parse_origin_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_origin_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectTag(90)) goto parse_target_id;
-        break;
-      }
-
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 82)) {
+          ptr = ctx->ParseMessage(_internal_mutable_origin_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // optional .mixr.recorder.pb.PlayerId target_id = 11;
-      case 11: {
-        if (tag == 90) {
-         parse_target_id:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_target_id()));
-        } else {
-          goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        if ((400u <= tag && tag < 800u) ||
-            (800u <= tag && tag < 8000u)) {
-          DO_(_extensions_.ParseField(tag, input, default_instance_,
-                                      mutable_unknown_fields()));
-          continue;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:mixr.recorder.pb.EmissionData)
-  return true;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 90)) {
+          ptr = ctx->ParseMessage(_internal_mutable_target_id(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    if ((400u <= tag && tag < 800u) ||
+        (800u <= tag && tag < 8000u)) {
+      ptr = _impl_._extensions_.ParseField(tag, ptr, internal_default_instance(), &_internal_metadata_, ctx);
+      CHK_(ptr != nullptr);
+      continue;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:mixr.recorder.pb.EmissionData)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void EmissionData::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:mixr.recorder.pb.EmissionData)
+uint8_t* EmissionData::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.EmissionData)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // optional double frequency = 1;
-  if (has_frequency()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(1, this->frequency(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_frequency(), target);
   }
 
   // optional double wave_length = 2;
-  if (has_wave_length()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(2, this->wave_length(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_wave_length(), target);
   }
 
   // optional double pulse_width = 3;
-  if (has_pulse_width()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(3, this->pulse_width(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_pulse_width(), target);
   }
 
   // optional double bandwidth = 4;
-  if (has_bandwidth()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(4, this->bandwidth(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_bandwidth(), target);
   }
 
   // optional double prf = 5;
-  if (has_prf()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(5, this->prf(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(5, this->_internal_prf(), target);
   }
 
   // optional double power = 6;
-  if (has_power()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(6, this->power(), output);
+  if (cached_has_bits & 0x00000080u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(6, this->_internal_power(), target);
   }
 
   // optional .mixr.recorder.pb.EmissionData.Polarization polarization = 7;
-  if (has_polarization()) {
-    ::google::protobuf::internal::WireFormatLite::WriteEnum(
-      7, this->polarization(), output);
+  if (cached_has_bits & 0x00000400u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      7, this->_internal_polarization(), target);
   }
 
   // optional double azimuth_aoi = 8;
-  if (has_azimuth_aoi()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(8, this->azimuth_aoi(), output);
+  if (cached_has_bits & 0x00000100u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(8, this->_internal_azimuth_aoi(), target);
   }
 
   // optional double elevation_aoi = 9;
-  if (has_elevation_aoi()) {
-    ::google::protobuf::internal::WireFormatLite::WriteDouble(9, this->elevation_aoi(), output);
+  if (cached_has_bits & 0x00000200u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(9, this->_internal_elevation_aoi(), target);
   }
 
   // optional .mixr.recorder.pb.PlayerId origin_id = 10;
-  if (has_origin_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      10, this->origin_id(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(10, _Internal::origin_id(this),
+        _Internal::origin_id(this).GetCachedSize(), target, stream);
   }
 
   // optional .mixr.recorder.pb.PlayerId target_id = 11;
-  if (has_target_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      11, this->target_id(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(11, _Internal::target_id(this),
+        _Internal::target_id(this).GetCachedSize(), target, stream);
   }
 
-  // Extension range [50, 100)
-  _extensions_.SerializeWithCachedSizes(
-      50, 100, output);
-
-  // Extension range [100, 1000)
-  _extensions_.SerializeWithCachedSizes(
-      100, 1000, output);
+  // Extension range [50, 1000)
+  target = _impl_._extensions_._InternalSerialize(
+  internal_default_instance(), 50, 1000, target, stream);
 
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_end:mixr.recorder.pb.EmissionData)
+  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.EmissionData)
+  return target;
 }
 
-::google::protobuf::uint8* EmissionData::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:mixr.recorder.pb.EmissionData)
-  // optional double frequency = 1;
-  if (has_frequency()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(1, this->frequency(), target);
-  }
-
-  // optional double wave_length = 2;
-  if (has_wave_length()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(2, this->wave_length(), target);
-  }
-
-  // optional double pulse_width = 3;
-  if (has_pulse_width()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(3, this->pulse_width(), target);
-  }
-
-  // optional double bandwidth = 4;
-  if (has_bandwidth()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(4, this->bandwidth(), target);
-  }
-
-  // optional double prf = 5;
-  if (has_prf()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(5, this->prf(), target);
-  }
-
-  // optional double power = 6;
-  if (has_power()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(6, this->power(), target);
-  }
-
-  // optional .mixr.recorder.pb.EmissionData.Polarization polarization = 7;
-  if (has_polarization()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
-      7, this->polarization(), target);
-  }
-
-  // optional double azimuth_aoi = 8;
-  if (has_azimuth_aoi()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(8, this->azimuth_aoi(), target);
-  }
-
-  // optional double elevation_aoi = 9;
-  if (has_elevation_aoi()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(9, this->elevation_aoi(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId origin_id = 10;
-  if (has_origin_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        10, this->origin_id(), target);
-  }
-
-  // optional .mixr.recorder.pb.PlayerId target_id = 11;
-  if (has_target_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        11, this->target_id(), target);
-  }
+size_t EmissionData::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mixr.recorder.pb.EmissionData)
+  size_t total_size = 0;
 
-  // Extension range [50, 100)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      50, 100, target);
+  total_size += _impl_._extensions_.ByteSize();
 
-  // Extension range [100, 1000)
-  target = _extensions_.SerializeWithCachedSizesToArray(
-      100, 1000, target);
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:mixr.recorder.pb.EmissionData)
-  return target;
-}
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    // optional .mixr.recorder.pb.PlayerId origin_id = 10;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.origin_id_);
+    }
 
-int EmissionData::ByteSize() const {
-  int total_size = 0;
+    // optional .mixr.recorder.pb.PlayerId target_id = 11;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.target_id_);
+    }
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
     // optional double frequency = 1;
-    if (has_frequency()) {
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 + 8;
     }
 
     // optional double wave_length = 2;
-    if (has_wave_length()) {
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 + 8;
     }
 
     // optional double pulse_width = 3;
-    if (has_pulse_width()) {
+    if (cached_has_bits & 0x00000010u) {
       total_size += 1 + 8;
     }
 
     // optional double bandwidth = 4;
-    if (has_bandwidth()) {
+    if (cached_has_bits & 0x00000020u) {
       total_size += 1 + 8;
     }
 
     // optional double prf = 5;
-    if (has_prf()) {
+    if (cached_has_bits & 0x00000040u) {
       total_size += 1 + 8;
     }
 
     // optional double power = 6;
-    if (has_power()) {
+    if (cached_has_bits & 0x00000080u) {
       total_size += 1 + 8;
     }
 
-    // optional .mixr.recorder.pb.EmissionData.Polarization polarization = 7;
-    if (has_polarization()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::EnumSize(this->polarization());
-    }
-
+  }
+  if (cached_has_bits & 0x00000700u) {
     // optional double azimuth_aoi = 8;
-    if (has_azimuth_aoi()) {
+    if (cached_has_bits & 0x00000100u) {
       total_size += 1 + 8;
     }
 
-  }
-  if (_has_bits_[8 / 32] & (0xffu << (8 % 32))) {
     // optional double elevation_aoi = 9;
-    if (has_elevation_aoi()) {
+    if (cached_has_bits & 0x00000200u) {
       total_size += 1 + 8;
     }
 
-    // optional .mixr.recorder.pb.PlayerId origin_id = 10;
-    if (has_origin_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->origin_id());
-    }
-
-    // optional .mixr.recorder.pb.PlayerId target_id = 11;
-    if (has_target_id()) {
+    // optional .mixr.recorder.pb.EmissionData.Polarization polarization = 7;
+    if (cached_has_bits & 0x00000400u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-          this->target_id());
+        ::_pbi::WireFormatLite::EnumSize(this->_internal_polarization());
     }
 
   }
-  total_size += _extensions_.ByteSize();
-
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void EmissionData::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const EmissionData* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const EmissionData*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
-}
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData EmissionData::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    EmissionData::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*EmissionData::GetClassData() const { return &_class_data_; }
+
 
-void EmissionData::MergeFrom(const EmissionData& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_frequency()) {
-      set_frequency(from.frequency());
+void EmissionData::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<EmissionData*>(&to_msg);
+  auto& from = static_cast<const EmissionData&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:mixr.recorder.pb.EmissionData)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_origin_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_origin_id());
     }
-    if (from.has_wave_length()) {
-      set_wave_length(from.wave_length());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_target_id()->::mixr::recorder::pb::PlayerId::MergeFrom(
+          from._internal_target_id());
     }
-    if (from.has_pulse_width()) {
-      set_pulse_width(from.pulse_width());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.frequency_ = from._impl_.frequency_;
     }
-    if (from.has_bandwidth()) {
-      set_bandwidth(from.bandwidth());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.wave_length_ = from._impl_.wave_length_;
     }
-    if (from.has_prf()) {
-      set_prf(from.prf());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.pulse_width_ = from._impl_.pulse_width_;
     }
-    if (from.has_power()) {
-      set_power(from.power());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.bandwidth_ = from._impl_.bandwidth_;
     }
-    if (from.has_polarization()) {
-      set_polarization(from.polarization());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.prf_ = from._impl_.prf_;
     }
-    if (from.has_azimuth_aoi()) {
-      set_azimuth_aoi(from.azimuth_aoi());
+    if (cached_has_bits & 0x00000080u) {
+      _this->_impl_.power_ = from._impl_.power_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  if (from._has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    if (from.has_elevation_aoi()) {
-      set_elevation_aoi(from.elevation_aoi());
+  if (cached_has_bits & 0x00000700u) {
+    if (cached_has_bits & 0x00000100u) {
+      _this->_impl_.azimuth_aoi_ = from._impl_.azimuth_aoi_;
     }
-    if (from.has_origin_id()) {
-      mutable_origin_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.origin_id());
+    if (cached_has_bits & 0x00000200u) {
+      _this->_impl_.elevation_aoi_ = from._impl_.elevation_aoi_;
     }
-    if (from.has_target_id()) {
-      mutable_target_id()->::mixr::recorder::pb::PlayerId::MergeFrom(from.target_id());
+    if (cached_has_bits & 0x00000400u) {
+      _this->_impl_.polarization_ = from._impl_.polarization_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  _extensions_.MergeFrom(from._extensions_);
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void EmissionData::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_impl_._extensions_.MergeFrom(internal_default_instance(), from._impl_._extensions_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void EmissionData::CopyFrom(const EmissionData& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mixr.recorder.pb.EmissionData)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool EmissionData::IsInitialized() const {
+  if (!_impl_._extensions_.IsInitialized()) {
+    return false;
+  }
 
-  if (has_origin_id()) {
-    if (!this->origin_id().IsInitialized()) return false;
+  if (_internal_has_origin_id()) {
+    if (!_impl_.origin_id_->IsInitialized()) return false;
   }
-  if (has_target_id()) {
-    if (!this->target_id().IsInitialized()) return false;
+  if (_internal_has_target_id()) {
+    if (!_impl_.target_id_->IsInitialized()) return false;
   }
-
-  if (!_extensions_.IsInitialized()) return false;  return true;
+  return true;
 }
 
-void EmissionData::Swap(EmissionData* other) {
-  if (other != this) {
-    std::swap(frequency_, other->frequency_);
-    std::swap(wave_length_, other->wave_length_);
-    std::swap(pulse_width_, other->pulse_width_);
-    std::swap(bandwidth_, other->bandwidth_);
-    std::swap(prf_, other->prf_);
-    std::swap(power_, other->power_);
-    std::swap(polarization_, other->polarization_);
-    std::swap(azimuth_aoi_, other->azimuth_aoi_);
-    std::swap(elevation_aoi_, other->elevation_aoi_);
-    std::swap(origin_id_, other->origin_id_);
-    std::swap(target_id_, other->target_id_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-    _extensions_.Swap(&other->_extensions_);
-  }
+void EmissionData::InternalSwap(EmissionData* other) {
+  using std::swap;
+  _impl_._extensions_.InternalSwap(&other->_impl_._extensions_);
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(EmissionData, _impl_.polarization_)
+      + sizeof(EmissionData::_impl_.polarization_)
+      - PROTOBUF_FIELD_OFFSET(EmissionData, _impl_.origin_id_)>(
+          reinterpret_cast<char*>(&_impl_.origin_id_),
+          reinterpret_cast<char*>(&other->_impl_.origin_id_));
 }
 
-::google::protobuf::Metadata EmissionData::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = EmissionData_descriptor_;
-  metadata.reflection = EmissionData_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata EmissionData::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_getter, &descriptor_table_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto_once,
+      file_level_metadata_mixr_2frecorder_2fprotobuf_2fDataRecord_2eproto[25]);
 }
 
-
 // @@protoc_insertion_point(namespace_scope)
-
 }  // namespace pb
 }  // namespace recorder
 }  // namespace mixr
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::DataRecord*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::DataRecord >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::DataRecord >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::FileIdMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::FileIdMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::FileIdMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::UnknownIdMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::UnknownIdMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::UnknownIdMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::MarkerMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::MarkerMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::MarkerMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::InputDeviceMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::InputDeviceMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::InputDeviceMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::NewPlayerEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::NewPlayerEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::NewPlayerEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerRemovedEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerRemovedEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerRemovedEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerDataMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerDataMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerDataMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerDamagedEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerDamagedEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerDamagedEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerCollisionEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerCollisionEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerCollisionEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerCrashEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerCrashEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerCrashEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerKilledEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerKilledEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerKilledEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerFrameMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerFrameMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerFrameMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::WeaponReleaseEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::WeaponReleaseEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::WeaponReleaseEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::WeaponHungEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::WeaponHungEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::WeaponHungEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::WeaponDetonationEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::WeaponDetonationEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::WeaponDetonationEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::GunFiredEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::GunFiredEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::GunFiredEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::NewTrackEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::NewTrackEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::NewTrackEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::TrackRemovedEventMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::TrackRemovedEventMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::TrackRemovedEventMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::TrackDataMsg*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::TrackDataMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::TrackDataMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::Vector*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::Vector >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::Vector >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::Time*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::Time >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::Time >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerId*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerId >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerId >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::PlayerState*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::PlayerState >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::PlayerState >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::TrackData*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::TrackData >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::TrackData >(arena);
+}
+template<> PROTOBUF_NOINLINE ::mixr::recorder::pb::EmissionData*
+Arena::CreateMaybeMessage< ::mixr::recorder::pb::EmissionData >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::mixr::recorder::pb::EmissionData >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -16,12 +16,15 @@ EMPTY_SLOTTABLE(AbstractDataRecorder)
 AbstractDataRecorder::AbstractDataRecorder()
 {
    STANDARD_CONSTRUCTOR()
+   consumedIds.set();
 }
 
 void AbstractDataRecorder::copyData(const AbstractDataRecorder& org, const bool)
 {
    BaseClass::copyData(org);
 
+   consumedIds = org.consumedIds;
+
    sta = nullptr;
    sim = nullptr;
 }
@@ -22,6 +22,7 @@ END_SLOT_MAP()
 AbstractRecorderComponent::AbstractRecorderComponent()
 {
    STANDARD_CONSTRUCTOR()
+   enabledIds.set();
 }
 
 void AbstractRecorderComponent::copyData(const AbstractRecorderComponent& org, const bool)
@@ -59,6 +60,7 @@ bool AbstractRecorderComponent::setEnabledList(const unsigned int* const list, c
       numEnabled = n;
    }
 
+   updateEnabledIds();
    return true;
 }
 
@@ -84,10 +86,34 @@ bool AbstractRecorderComponent::setDisabledList(const unsigned int* const list,
       numDisabled = n;
    }
 
+   updateEnabledIds();
    return true;
 }
 
 
+//------------------------------------------------------------------------------
+// Compile the enabled and disabled lists into the set of enabled IDs
+//------------------------------------------------------------------------------
+void AbstractRecorderComponent::updateEnabledIds()
+{
+   // Do we have an enabled list?
+   if (numEnabled > 0 && enabledList != nullptr) {
+      enabledIds.reset();
+      for (unsigned int i = 0; i < numEnabled; i++) {
+         if (enabledList[i] < MAX_RECORDER_IDS) enabledIds.set(enabledList[i]);
+      }
+   }
+
+   // Otherwise, all IDs except those in the disabled list
+   else {
+      enabledIds.set();
+      for (unsigned int i = 0; i < numDisabled && disabledList != nullptr; i++) {
+         if (disabledList[i] < MAX_RECORDER_IDS) enabledIds.reset(disabledList[i]);
+      }
+   }
+}
+
+
 //------------------------------------------------------------------------------
 // Slot functions
 //------------------------------------------------------------------------------
@@ -38,7 +38,8 @@ BEGIN_SLOTTABLE(Simulation)
    "numTcThreads",   // 7) Number of T/C threads to use with the player list
    "numBgThreads",   // 8) Number of background threads to use with the player list
    "enableFrameTiming",     // 9) Enable/disable the frame timing
-   "printFrameTimingStats"  //10) Enable/disable the printing of the frame timing statistics
+   "printFrameTimingStats", //10) Enable/disable the printing of the frame timing statistics
+   "frameSnapshotTime"      //11) Time between player frame snapshots
    END_SLOTTABLE(Simulation)
 
 BEGIN_SLOT_MAP(Simulation)
@@ -55,6 +56,7 @@ BEGIN_SLOT_MAP(Simulation)
     ON_SLOT( 8, setSlotNumBgThreads,    base::Integer)
     ON_SLOT( 9, setSlotEnableFrameTiming,     base::Boolean)
     ON_SLOT(10, setSlotPrintFrameTimingStats, base::Boolean)
+    ON_SLOT(11, setSlotFrameSnapshotTime,     base::Time)
 END_SLOT_MAP()
 
 Simulation::Simulation() : newPlayerQueue(MAX_NEW_PLAYERS)
@@ -165,6 +167,9 @@ void Simulation::copyData(const Simulation& org, const bool)
    }
    pfts = org.pfts;
    tcLastFrameTime = 0.0;
+
+   snapshotTime = org.snapshotTime;
+   snapshotTimer = 0.0;
 }
 
 void Simulation::deleteData()
@@ -632,6 +637,16 @@ void Simulation::updateTC(const double dt)
             std::cerr << std::endl;
          }
       }
+
+      // Player frame snapshot
+      if (snapshotTime > 0.0) {
+         snapshotTimer -= dt0;
+         if (snapshotTimer <= 0.0) {
+            recordFrameSnapshot(currentPlayerList);
+            snapshotTimer += snapshotTime;
+            if (snapshotTimer <= 0.0) snapshotTimer = snapshotTime;
+         }
+      }
    }
 
    // Update frame & cycle counts
@@ -644,6 +659,19 @@ void Simulation::updateTC(const double dt)
    setPhase(0);
 }
 
+//------------------------------------------------------------------------------
+// recordFrameSnapshot() -- Samples the state of all players to the data
+// recorder as a single player frame record
+//------------------------------------------------------------------------------
+void Simulation::recordFrameSnapshot(base::PairStream* const playerList)
+{
+   if (playerList != nullptr) {
+      BEGIN_RECORD_DATA_SAMPLE( getDataRecorder(), REID_PLAYER_FRAME )
+         SAMPLE_1_OBJECT( playerList )
+      END_RECORD_DATA_SAMPLE()
+   }
+}
+
 //------------------------------------------------------------------------------
 // Time critical thread processing for every n'th player starting
 // with the idx'th player
@@ -1360,6 +1388,17 @@ bool Simulation::setPrintFrameTimingStats(const bool b)
    return true;
 }
 
+bool Simulation::setFrameSnapshotTime(const double t)
+{
+   bool ok{};
+   if (t >= 0.0) {
+      snapshotTime = t;
+      snapshotTimer = 0.0;
+      ok = true;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Set Slot routines
 //------------------------------------------------------------------------------
@@ -1505,6 +1544,18 @@ bool Simulation::setSlotPrintFrameTimingStats(const base::Boolean* const num)
    return ok;
 }
 
+bool Simulation::setSlotFrameSnapshotTime(const base::Time* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setFrameSnapshotTime(msg->getValueInSeconds());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Simulation::setSlotFrameSnapshotTime(): invalid time: " << msg->getValueInSeconds() << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 
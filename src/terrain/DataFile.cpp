@@ -5,6 +5,9 @@
 #include "mixr/base/units/util/angle_utils.hpp"
 #include "mixr/base/units/util/length_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace mixr {
 namespace terrain {
 
@@ -28,6 +31,8 @@ void DataFile::copyData(const DataFile& org, const bool)
    latSpacing = org.latSpacing;
    lonSpacing = org.lonSpacing;
 
+   pyramid = org.pyramid;
+
    if (org.columns != nullptr && org.nptlat > 0 && org.nptlong > 0) {
 
       // Allocate memory space for the elevation data and copy the data
@@ -128,101 +133,34 @@ unsigned int DataFile::getElevations(
    unsigned int num{};
 
    // Early out tests
-   if ( elevations == nullptr ||       // The elevation array wasn't provided, or
+   if ( !isDataLoaded() ||             // Not loaded, or
+        elevations == nullptr ||       // the elevation array wasn't provided, or
         validFlags == nullptr ||       // the valid flag array wasn't provided, or
         n < 2 ||                       // there are too few points, or
         (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
         maxRng <= 0                    // the max range is less than or equal to zero
       ) return num;
 
-
-   // Upper limit points
-   double maxLatPoint {static_cast<double>(nptlat-1)};
-   double maxLonPoint {static_cast<double>(nptlong-1)};
-
-   // Starting points
-   double pointsLat {(lat - getLatitudeSW()) / latSpacing};
-   double pointsLon {(lon - getLongitudeSW()) / lonSpacing};
-
    // Spacing between points (in each direction)
-   double deltaPoint {maxRng / (n - 1)};
-   double dirR {direction * base::angle::D2RCC};
-   double deltaNorth {deltaPoint * std::cos(dirR) * base::length::M2NM};  // (NM)
-   double deltaEast {deltaPoint * std::sin(dirR) * base::length::M2NM};
-   double deltaLat {deltaNorth/60.0};
-   double deltaLon {deltaEast/(60.0 * std::cos(lat * base::angle::D2RCC))};
-   double deltaPointsLat {deltaLat / latSpacing};
-   double deltaPointsLon {deltaLon / lonSpacing};
+   double deltaLat{};
+   double deltaLon{};
+   computeProfileSteps(&deltaLat, &deltaLon, n, lat, direction, maxRng);
 
    // ---
-   // Loop for the number of points in the arrays;
+   // Loop for the number of points in the arrays; each point is located
+   // the same as getElevation() would locate it.
    // ---
    for (unsigned int i = 0; i < n; i++) {
-
-      if ( !validFlags[i] &&                                // Not already found and
-          (pointsLat >= 0 && pointsLat <= maxLatPoint) &&   // and within latitude range and
-          (pointsLon >= 0 && pointsLon <= maxLonPoint) ) {  // and within longitude range ...
-
-            // We're within our data limits
-            double value{};          // the elevation (meters)
-
-            // ---
-            // Interpolating between elevation posts?
-            // ---
-            if (interp) {
-               // Yes ---
-
-               // South-west corner post is [icol][irow]
-               unsigned int irow {static_cast<unsigned int>(pointsLat)};
-               unsigned int icol {static_cast<unsigned int>(pointsLon)};
-               if (irow > (nptlat-2)) irow = (nptlat-2);
-               if (icol > (nptlong-2)) icol = (nptlong-2);
-
-               // delta from s-w corner post
-               double deltaLat {static_cast<double>(pointsLat - static_cast<double>(irow))};
-               double deltaLon {static_cast<double>(pointsLon - static_cast<double>(icol))};
-
-               // Get the elevations at each corner
-               double elevSW {static_cast<double>(columns[icol][irow])};
-               double elevNW {static_cast<double>(columns[icol][irow+1])};
-               double elevSE {static_cast<double>(columns[icol+1][irow])};
-               double elevNE {static_cast<double>(columns[icol+1][irow+1])};
-
-               // Interpolate the west point
-               double westPoint {elevSW + (elevNW - elevSW) * deltaLat};
-
-               // Interpolate the east point
-               double eastPoint {elevSE + (elevNE - elevSE) * deltaLat};
-
-               // Interpolate between the west and east points
-               value = westPoint + (eastPoint - westPoint) * deltaLon;
-            }
-
-            else {
-               // No -- just use the nearest post
-
-               // Nearest post
-               unsigned int irow {static_cast<unsigned int>(pointsLat + 0.5)};
-               unsigned int icol {static_cast<unsigned int>(pointsLon + 0.5)};
-               if (irow >= nptlat) irow = (nptlat-1);
-               if (icol >= nptlong) icol = (nptlong-1);
-
-               // Get the elevation post at the current indices.
-               value = static_cast<double>(columns[icol][irow]);
-            }
-
+      if (!validFlags[i]) {
+         double value{};          // the elevation (meters)
+         if (locateElevation(&value, lat + deltaLat * i, lon + deltaLon * i, interp)) {
             // Pass the elevation value and valid flag to the user's arrays
             elevations[i] = value;
             validFlags[i] = true;
             num++;
-
-      } // end lat/lon point checks
-
-      // Update our location within our data array
-      pointsLat += deltaPointsLat;
-      pointsLon += deltaPointsLon;
-
-   } // end loop
+         }
+      }
+   }
 
    return num;
 }
@@ -238,11 +176,68 @@ bool DataFile::getElevation(
       const bool interp       // Interpolate between elevation posts (if true)
    ) const
 {
+   // Early out tests
+   if ( elev == nullptr || !isDataLoaded() ) return false;
+
    double value{};            // the elevation (meters)
+   const bool found {locateElevation(&value, lat, lon, interp)};
+   if (found) {
+      // Return the elevation value to the user
+      *elev = value;
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Bounds the elevations of the lat/lon region using the min/max elevation
+// pyramid; returns false if the pyramid hasn't been built.
+//------------------------------------------------------------------------------
+bool DataFile::getElevationBounds(
+      double* const minElev,        // Min elevation (meters)
+      double* const maxElev,        // Max elevation (meters)
+      const double minLat,          // Southern latitude of the region (degs)
+      const double minLon,          // Western longitude of the region (degs)
+      const double maxLat,          // Northern latitude of the region (degs)
+      const double maxLon           // Eastern longitude of the region (degs)
+   ) const
+{
+   if ( minElev == nullptr || maxElev == nullptr || !isDataLoaded() || pyramid.isEmpty() ) return false;
+
+   // Region outside of our data
+   if ( maxLat < getLatitudeSW() || minLat > getLatitudeNE() ||
+        maxLon < getLongitudeSW() || minLon > getLongitudeNE() ) {
+      *minElev = 1.0;
+      *maxElev = 0.0;
+      return true;
+   }
 
+   // Posts that are used to locate the elevations within the region
+   const double maxLatPoint {static_cast<double>(nptlat - 1)};
+   const double maxLonPoint {static_cast<double>(nptlong - 1)};
+   const double lat0 {std::min(std::max((minLat - getLatitudeSW()) / latSpacing, 0.0), maxLatPoint)};
+   const double lat1 {std::min(std::max((maxLat - getLatitudeSW()) / latSpacing, 0.0), maxLatPoint)};
+   const double lon0 {std::min(std::max((minLon - getLongitudeSW()) / lonSpacing, 0.0), maxLonPoint)};
+   const double lon1 {std::min(std::max((maxLon - getLongitudeSW()) / lonSpacing, 0.0), maxLonPoint)};
+
+   short mn{}, mx{};
+   const bool ok {pyramid.getBounds(&mn, &mx,
+                     static_cast<unsigned int>(std::floor(lat0)), static_cast<unsigned int>(std::ceil(lat1)),
+                     static_cast<unsigned int>(std::floor(lon0)), static_cast<unsigned int>(std::ceil(lon1)))};
+   if (ok) {
+      *minElev = static_cast<double>(mn);
+      *maxElev = static_cast<double>(mx);
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevation (meters) of a point; returns false if the point isn't
+// within our data.
+//------------------------------------------------------------------------------
+bool DataFile::locateElevation(double* const elev, const double lat, const double lon, const bool interp) const
+{
    // Early out tests
-   if ( !isDataLoaded() ||          // Not loaded or
-        (lat < getLatitudeSW()  ||
+   if ( (lat < getLatitudeSW()  ||
          lat > getLatitudeNE()) ||  // wrong latitude or
         (lon < getLongitudeSW() ||
          lon > getLongitudeNE())    // wrong longitude
@@ -287,30 +282,38 @@ bool DataFile::getElevation(
       double eastPoint {elevSE + (elevNE - elevSE) * deltaLat};
 
       // Interpolate between the west and east points
-      value = westPoint + (eastPoint - westPoint) * deltaLon;
+      *elev = westPoint + (eastPoint - westPoint) * deltaLon;
    }
 
    else {
       // No -- just use the nearest post
 
       // Nearest post
-      unsigned int irow {static_cast<unsigned int>(pointsLat + 0.5f)};
-      unsigned int icol {static_cast<unsigned int>(pointsLon + 0.5f)};
+      unsigned int irow {static_cast<unsigned int>(pointsLat + 0.5)};
+      unsigned int icol {static_cast<unsigned int>(pointsLon + 0.5)};
       if (irow >= nptlat) irow = (nptlat-1);
       if (icol >= nptlong) icol = (nptlong-1);
 
       // Get the elevation post at the current indices.
-      value = static_cast<double>(columns[icol][irow]);
+      *elev = static_cast<double>(columns[icol][irow]);
    }
 
-   // ---
-   // Return the elevation value to the user
-   // ---
-   *elev = value;
-
    return true;
 }
 
+//------------------------------------------------------------------------------
+// reset() -- build our min/max elevation pyramid once our data is loaded
+//------------------------------------------------------------------------------
+void DataFile::reset()
+{
+   // Resetting our base class will load our data
+   BaseClass::reset();
+
+   if (isDataLoaded() && pyramid.isEmpty()) {
+      pyramid.build(columns, nptlat, nptlong);
+   }
+}
+
 //------------------------------------------------------------------------------
 // Computes the nearest row index for the latitude (degs).
 // Returns true if the index is valid
@@ -417,6 +420,8 @@ void DataFile::clearData()
    nptlat = 0;
    nptlong = 0;
 
+   pyramid.clear();
+
    setLatitudeSW(0);
    setLongitudeSW(0);
    setLatitudeNE(0);
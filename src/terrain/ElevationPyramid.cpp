@@ -0,0 +1,112 @@
+
+#include "mixr/terrain/ElevationPyramid.hpp"
+
+#include <algorithm>
+
+namespace mixr {
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Builds the pyramid from the elevation posts
+//------------------------------------------------------------------------------
+void ElevationPyramid::build(const short* const* const columns, const unsigned int nlat, const unsigned int nlong)
+{
+   clear();
+   if (columns == nullptr || nlat == 0 || nlong == 0) return;
+
+   nptlat = nlat;
+   nptlong = nlong;
+
+   // Level zero: min/max of each block of posts
+   {
+      Level level;
+      level.rows = (nptlat + BLOCK - 1) >> BLOCK_SHIFT;
+      level.cols = (nptlong + BLOCK - 1) >> BLOCK_SHIFT;
+      level.minv.assign(level.rows * level.cols, 32767);
+      level.maxv.assign(level.rows * level.cols, -32768);
+      for (unsigned int icol = 0; icol < nptlong; icol++) {
+         const short* const column {columns[icol]};
+         if (column == nullptr) continue;
+         const unsigned int bcol {icol >> BLOCK_SHIFT};
+         for (unsigned int irow = 0; irow < nptlat; irow++) {
+            const unsigned int idx {bcol * level.rows + (irow >> BLOCK_SHIFT)};
+            if (column[irow] < level.minv[idx]) level.minv[idx] = column[irow];
+            if (column[irow] > level.maxv[idx]) level.maxv[idx] = column[irow];
+         }
+      }
+      levels.push_back(std::move(level));
+   }
+
+   // Higher levels: min/max of 2x2 blocks of the level below
+   while (levels.back().rows > 1 || levels.back().cols > 1) {
+      const Level& below {levels.back()};
+      Level level;
+      level.rows = (below.rows + 1) >> 1;
+      level.cols = (below.cols + 1) >> 1;
+      level.minv.assign(level.rows * level.cols, 32767);
+      level.maxv.assign(level.rows * level.cols, -32768);
+      for (unsigned int bcol = 0; bcol < below.cols; bcol++) {
+         for (unsigned int brow = 0; brow < below.rows; brow++) {
+            const unsigned int src {bcol * below.rows + brow};
+            const unsigned int idx {(bcol >> 1) * level.rows + (brow >> 1)};
+            level.minv[idx] = std::min(level.minv[idx], below.minv[src]);
+            level.maxv[idx] = std::max(level.maxv[idx], below.maxv[src]);
+         }
+      }
+      levels.push_back(std::move(level));
+   }
+}
+
+void ElevationPyramid::clear()
+{
+   levels.clear();
+   nptlat = 0;
+   nptlong = 0;
+}
+
+//------------------------------------------------------------------------------
+// Min/max elevations of a region of posts: the lowest level where the region
+// is covered by no more than 2x2 blocks is used.
+//------------------------------------------------------------------------------
+bool ElevationPyramid::getBounds(
+      short* const minElev,
+      short* const maxElev,
+      const unsigned int irow0,
+      const unsigned int irow1,
+      const unsigned int icol0,
+      const unsigned int icol1
+   ) const
+{
+   if (levels.empty() || minElev == nullptr || maxElev == nullptr) return false;
+
+   const unsigned int r0 {std::min(std::min(irow0, irow1), nptlat - 1)};
+   const unsigned int r1 {std::min(std::max(irow0, irow1), nptlat - 1)};
+   const unsigned int c0 {std::min(std::min(icol0, icol1), nptlong - 1)};
+   const unsigned int c1 {std::min(std::max(icol0, icol1), nptlong - 1)};
+
+   unsigned int k{};
+   unsigned int shift {BLOCK_SHIFT};
+   while ( (k + 1) < levels.size() &&
+           ( ((r1 >> shift) - (r0 >> shift)) > 1 || ((c1 >> shift) - (c0 >> shift)) > 1 ) ) {
+      k++;
+      shift++;
+   }
+
+   const Level& level {levels[k]};
+   short mn {32767};
+   short mx {-32768};
+   for (unsigned int bcol = (c0 >> shift); bcol <= (c1 >> shift); bcol++) {
+      for (unsigned int brow = (r0 >> shift); brow <= (r1 >> shift); brow++) {
+         const unsigned int idx {bcol * level.rows + brow};
+         if (level.minv[idx] < mn) mn = level.minv[idx];
+         if (level.maxv[idx] > mx) mx = level.maxv[idx];
+      }
+   }
+
+   *minElev = mn;
+   *maxElev = mx;
+   return true;
+}
+
+}
+}
@@ -0,0 +1,96 @@
+
+#include "mixr/terrain/ElevationRaster.hpp"
+
+namespace mixr {
+namespace terrain {
+
+bool ElevationRaster::setArea(
+      const double minLat0,
+      const double minLon0,
+      const double maxLat0,
+      const double maxLon0,
+      const unsigned int numRows0,
+      const unsigned int numCols0
+   )
+{
+   // Early out tests
+   if (  minLat0 >= maxLat0 || minLon0 >= maxLon0 ||     // empty area, or
+         minLat0 < -90.0 || maxLat0 > 90.0 ||            // bad latitudes, or
+         numRows0 < 1 || numCols0 < 1                    // no cells
+         ) return false;
+
+   minLat = minLat0;
+   minLon = minLon0;
+   maxLat = maxLat0;
+   maxLon = maxLon0;
+   numRows = numRows0;
+   numCols = numCols0;
+
+   elevations.clear();
+   valid.clear();
+   rowShade.clear();
+   colShade.clear();
+   shading.clear();
+   image.clear();
+   units.clear();
+   nextUnit = 0;
+   pass = 0;
+   processed = false;
+   return true;
+}
+
+double ElevationRaster::getLatitudeSpacing() const
+{
+   return (numRows > 0 ? (maxLat - minLat) / numRows : 0);
+}
+
+double ElevationRaster::getLongitudeSpacing() const
+{
+   return (numCols > 0 ? (maxLon - minLon) / numCols : 0);
+}
+
+double ElevationRaster::getLatitude(const unsigned int row) const
+{
+   return maxLat - (row + 0.5) * getLatitudeSpacing();
+}
+
+double ElevationRaster::getLongitude(const unsigned int col) const
+{
+   return minLon + (col + 0.5) * getLongitudeSpacing();
+}
+
+const float* ElevationRaster::getElevations() const
+{
+   return (elevations.empty() ? nullptr : elevations.data());
+}
+
+const std::uint8_t* ElevationRaster::getValidFlags() const
+{
+   return (valid.empty() ? nullptr : valid.data());
+}
+
+const float* ElevationRaster::getShading() const
+{
+   return (shading.empty() ? nullptr : shading.data());
+}
+
+const std::uint8_t* ElevationRaster::getImage() const
+{
+   return (image.empty() ? nullptr : image.data());
+}
+
+bool ElevationRaster::getElevation(double* const elev, const unsigned int row, const unsigned int col) const
+{
+   bool ok{};
+   if (elev != nullptr && row < numRows && col < numCols && !valid.empty()) {
+      const std::size_t idx{static_cast<std::size_t>(row) * numCols + col};
+      if (valid[idx] != 0) {
+         *elev = elevations[idx];
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+}
+}
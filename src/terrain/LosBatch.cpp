@@ -0,0 +1,124 @@
+
+#include "mixr/terrain/LosBatch.hpp"
+
+#include "mixr/base/util/nav_utils.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
+
+namespace mixr {
+namespace terrain {
+
+// Max number of profile points (same as Terrain::targetOcculting())
+static const unsigned int MAX_POINTS{1200};
+
+// Number of profile points; 100 meter data (same as Terrain::targetOcculting())
+static unsigned int computeNumPoints(const double dist)
+{
+   unsigned int numPts{static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+   if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+   return numPts;
+}
+
+void LosBatch::clear()
+{
+   queries.clear();
+   occulted.clear();
+   visibility.clear();
+   order.clear();
+   units.clear();
+   nextUnit = 0;
+   processed = false;
+}
+
+unsigned int LosBatch::addQuery(
+      const double refLat,
+      const double refLon,
+      const double refAlt,
+      const double truBrg,
+      const double dist,
+      const double tanLookAng
+   )
+{
+   Query q;
+   q.refLat = refLat;
+   q.refLon = refLon;
+   q.refAlt = refAlt;
+   q.truBrg = truBrg;
+   q.dist = dist;
+   q.tanLookAng = tanLookAng;
+   q.numPts = computeNumPoints(dist);
+   queries.push_back(q);
+   processed = false;
+   return static_cast<unsigned int>(queries.size() - 1);
+}
+
+unsigned int LosBatch::addTarget(
+      const double refLat,
+      const double refLon,
+      const double refAlt,
+      const double tgtLat,
+      const double tgtLon,
+      const double tgtAlt
+   )
+{
+   // Compute bearing and distance to target (flat earth)
+   double brgDeg{};
+   double distNM{};
+   base::nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   const double dist{distNM * base::length::NM2M};
+
+   Query q;
+   q.refLat = refLat;
+   q.refLon = refLon;
+   q.refAlt = refAlt;
+   q.truBrg = brgDeg;
+   q.dist = dist;
+   q.numPts = computeNumPoints(dist);
+   if (dist > 0) {
+      q.tanLookAng = (tgtAlt - refAlt) / dist;
+   } else {
+      q.numPts = 0;     // Nothing to check
+   }
+   queries.push_back(q);
+   processed = false;
+   return static_cast<unsigned int>(queries.size() - 1);
+}
+
+void LosBatch::setVisibility()
+{
+   const unsigned int nq{getNumQueries()};
+   visibility.assign((nq + 31) / 32, 0);
+   for (unsigned int i = 0; i < nq; i++) {
+      if (occulted[i] == 0) {
+         visibility[i / 32] |= (static_cast<std::uint32_t>(1) << (i % 32));
+      }
+   }
+   processed = true;
+}
+
+bool LosBatch::isVisible(const unsigned int i) const
+{
+   bool vis{};
+   if (processed && i < occulted.size()) vis = (occulted[i] == 0);
+   return vis;
+}
+
+const std::uint32_t* LosBatch::getVisibility() const
+{
+   const std::uint32_t* p{};
+   if (processed && !visibility.empty()) p = visibility.data();
+   return p;
+}
+
+unsigned int LosBatch::getNumVisible() const
+{
+   unsigned int n{};
+   if (processed) {
+      for (const unsigned char x : occulted) {
+         if (x == 0) n++;
+      }
+   }
+   return n;
+}
+
+}
+}
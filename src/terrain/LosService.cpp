@@ -0,0 +1,512 @@
+
+#include "mixr/terrain/LosService.hpp"
+
+#include "LosServiceThread.hpp"
+
+#include "mixr/terrain/LosBatch.hpp"
+#include "mixr/terrain/Terrain.hpp"
+
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/util/angle_utils.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(LosService, "LosService")
+
+BEGIN_SLOTTABLE(LosService)
+   "numThreads",     // 1) Number of threads (including the calling thread)
+   "priority",       // 2) Pool thread priority
+   "sectors",        // 3) Number of azimuth sectors
+END_SLOTTABLE(LosService)
+
+BEGIN_SLOT_MAP(LosService)
+   ON_SLOT(1, setSlotNumThreads,  base::Integer)
+   ON_SLOT(2, setSlotPriority,    base::Number)
+   ON_SLOT(3, setSlotNumSectors,  base::Integer)
+END_SLOT_MAP()
+
+// Max number of queries in a unit of work
+static const unsigned int UNIT_SIZE{64};
+
+// Width of the first range ring (meters); the rings double in width from there
+static const double FIRST_RING{500.0};
+
+// Margin on the sector/ring regions (degs)
+static const double REGION_MARGIN{1.0e-7};
+
+LosService::LosService()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void LosService::copyData(const LosService& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // Our copy creates its own pool threads at reset()
+   deleteThreads();
+
+   reqThreads = org.reqThreads;
+   priority = org.priority;
+   numSectors = org.numSectors;
+}
+
+void LosService::deleteData()
+{
+   deleteThreads();
+}
+
+//------------------------------------------------------------------------------
+// reset() -- create the pool threads
+//------------------------------------------------------------------------------
+void LosService::reset()
+{
+   BaseClass::reset();
+
+   if (reqThreads > 1 && numPoolThreads == 0 && !threadsFailed) {
+      createThreads();
+   }
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- shut down the pool threads
+//------------------------------------------------------------------------------
+bool LosService::shutdownNotification()
+{
+   const bool ok{BaseClass::shutdownNotification()};
+
+   for (unsigned int i = 0; i < numPoolThreads; i++) {
+      // We're just going to make sure the threads not suspended,
+      // and they'll check our shutdown flag.
+      threads[i]->signalStart();
+   }
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Pool threads
+//------------------------------------------------------------------------------
+void LosService::createThreads()
+{
+   for (unsigned int i = 0; i < (reqThreads-1); i++) {
+      threads[numPoolThreads] = new LosServiceThread(this);
+      const bool ok{threads[numPoolThreads]->start(priority)};
+      if (ok) {
+         numPoolThreads++;
+      } else {
+         threads[numPoolThreads]->unref();
+         threads[numPoolThreads] = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "LosService::createThreads(): ERROR, failed to create a pool thread!" << std::endl;
+         }
+      }
+   }
+
+   // If we still don't have any threads then something failed
+   threadsFailed = (numPoolThreads == 0);
+}
+
+void LosService::deleteThreads()
+{
+   for (unsigned int i = 0; i < numPoolThreads; i++) {
+      threads[i]->terminate();
+      threads[i]->unref();
+      threads[i] = nullptr;
+   }
+   numPoolThreads = 0;
+   threadsFailed = false;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool LosService::setNumThreads(const unsigned int v)
+{
+   bool ok{};
+   if (v >= 1 && v <= MAX_THREADS) {
+      reqThreads = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool LosService::setPriority(const double v)
+{
+   bool ok{};
+   if (v >= 0 && v <= 1.0) {
+      priority = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool LosService::setNumSectors(const unsigned int v)
+{
+   bool ok{};
+   if (v >= 1) {
+      numSectors = v;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// process() -- evaluates the batch's queries
+//------------------------------------------------------------------------------
+bool LosService::process(const Terrain* const terrain, LosBatch* const batch) const
+{
+   if (terrain == nullptr || batch == nullptr) return false;
+
+   const unsigned int nq{batch->getNumQueries()};
+   batch->occulted.assign(nq, 0);
+
+   // ---
+   // Sort the queries by observer and bearing
+   // ---
+   const std::vector<LosBatch::Query>& queries = batch->queries;
+   batch->order.resize(nq);
+   for (unsigned int i = 0; i < nq; i++) {
+      batch->order[i] = i;
+   }
+   std::sort(batch->order.begin(), batch->order.end(),
+      [&queries](const unsigned int a, const unsigned int b) {
+         const LosBatch::Query& qa = queries[a];
+         const LosBatch::Query& qb = queries[b];
+         if (qa.refLat != qb.refLat) return qa.refLat < qb.refLat;
+         if (qa.refLon != qb.refLon) return qa.refLon < qb.refLon;
+         if (qa.refAlt != qb.refAlt) return qa.refAlt < qb.refAlt;
+         if (qa.truBrg != qb.truBrg) return qa.truBrg < qb.truBrg;
+         return a < b;
+      });
+
+   // ---
+   // Units of work: one observer each, up to UNIT_SIZE queries
+   // ---
+   batch->units.clear();
+   unsigned int begin{};
+   for (unsigned int i = 1; i <= nq; i++) {
+      bool split{i == nq || (i - begin) >= UNIT_SIZE};
+      if (!split) {
+         const LosBatch::Query& q0 = queries[batch->order[begin]];
+         const LosBatch::Query& q1 = queries[batch->order[i]];
+         split = (q0.refLat != q1.refLat || q0.refLon != q1.refLon || q0.refAlt != q1.refAlt);
+      }
+      if (split) {
+         LosBatch::Unit unit;
+         unit.begin = begin;
+         unit.end = i;
+         batch->units.push_back(unit);
+         begin = i;
+      }
+   }
+   batch->nextUnit = 0;
+
+   // ---
+   // Evaluate the units, with the pool threads if they're free
+   // ---
+   bool usePool{};
+   if (numPoolThreads > 0 && batch->units.size() > 1) {
+      base::lock(poolSemaphore);
+      if (!poolBusy) {
+         poolBusy = true;
+         usePool = true;
+      }
+      base::unlock(poolSemaphore);
+   }
+
+   if (usePool) {
+      unsigned int n{numPoolThreads};
+      if (n > (batch->units.size() - 1)) n = static_cast<unsigned int>(batch->units.size() - 1);
+      for (unsigned int i = 0; i < n; i++) {
+         threads[i]->start0(terrain, batch);
+      }
+
+      // we're the last thread
+      processUnits(terrain, batch, &batch->workspace);
+
+      // Now wait for the other thread(s) to complete
+      base::SyncThread** pp{reinterpret_cast<base::SyncThread**>(const_cast<LosServiceThread**>(&threads[0]))};
+      base::SyncThread::waitForAllCompleted(pp, static_cast<int>(n));
+
+      base::lock(poolSemaphore);
+      poolBusy = false;
+      base::unlock(poolSemaphore);
+   } else {
+      processUnits(terrain, batch, &batch->workspace);
+   }
+
+   // ---
+   // Visibility bitmask
+   // ---
+   batch->setVisibility();
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// process() -- evaluates the queries of many batches as one batch
+//------------------------------------------------------------------------------
+bool LosService::process(
+      const Terrain* const terrain,
+      LosBatch* const* const batches,
+      const unsigned int n,
+      LosBatch* const frame
+   ) const
+{
+   if (terrain == nullptr || batches == nullptr || frame == nullptr) return false;
+
+   // Gather the queries, in order, into the frame's batch
+   frame->clear();
+   for (unsigned int i = 0; i < n; i++) {
+      const LosBatch* const b{batches[i]};
+      if (b != nullptr) frame->queries.insert(frame->queries.end(), b->queries.begin(), b->queries.end());
+   }
+
+   const bool ok{process(terrain, frame)};
+
+   // Hand back each batch's slice of the results
+   if (ok) {
+      unsigned int first{};
+      for (unsigned int i = 0; i < n; i++) {
+         LosBatch* const b{batches[i]};
+         if (b != nullptr) {
+            const unsigned int nq{b->getNumQueries()};
+            b->occulted.assign(frame->occulted.begin() + first, frame->occulted.begin() + first + nq);
+            b->setVisibility();
+            first += nq;
+         }
+      }
+   }
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Evaluates the batch's units until there are no more
+//------------------------------------------------------------------------------
+void LosService::processUnits(const Terrain* const terrain, LosBatch* const batch, LosBatch::Workspace* const ws) const
+{
+   const unsigned int numUnits{static_cast<unsigned int>(batch->units.size())};
+   for (;;) {
+      base::lock(batch->semaphore);
+      const unsigned int idx{batch->nextUnit};
+      if (idx < numUnits) batch->nextUnit++;
+      base::unlock(batch->semaphore);
+
+      if (idx >= numUnits) break;
+      processUnit(terrain, batch, idx, ws);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Evaluates the queries of one unit; all from the same observer
+//------------------------------------------------------------------------------
+void LosService::processUnit(
+      const Terrain* const terrain,
+      LosBatch* const batch,
+      const unsigned int idx,
+      LosBatch::Workspace* const ws
+   ) const
+{
+   std::vector<double>& rings = ws->rings;
+   std::vector<LosBatch::Bounds>& bounds = ws->bounds;
+   const LosBatch::Unit& unit = batch->units[idx];
+   const LosBatch::Query& q0 = batch->queries[batch->order[unit.begin]];
+   const double lat{q0.refLat};
+   const double lon{q0.refLon};
+   const double refAlt{q0.refAlt};
+
+   // Early out tests (same as Terrain::isProfileOcculted())
+   if (lat < -89.0 || lat > 89.0) return;
+
+   // The sectors are only used with terrain that has elevation bounds
+   double minElev{}, maxElev{};
+   const bool useSectors{terrain->getElevationBounds(&minElev, &maxElev, lat, lon, lat, lon)};
+
+   // Range rings out to the farthest query
+   unsigned int numRings{};
+   if (useSectors) {
+      double maxDist{};
+      for (unsigned int k = unit.begin; k < unit.end; k++) {
+         maxDist = std::max(maxDist, batch->queries[batch->order[k]].dist);
+      }
+      rings.clear();
+      rings.push_back(0);
+      double r{FIRST_RING};
+      for (;;) {
+         rings.push_back(r);
+         if (r >= maxDist) break;
+         r *= 2.0;
+      }
+      numRings = static_cast<unsigned int>(rings.size() - 1);
+      bounds.assign(numSectors * numRings, LosBatch::Bounds());
+   }
+
+   // Flat earth offsets (same as Terrain::computeProfileSteps())
+   const double kLat{base::length::M2NM / 60.0};
+   const double kLon{base::length::M2NM / (60.0 * std::cos(lat * base::angle::D2RCC))};
+   const double sectorWidth{360.0 / numSectors};
+
+   for (unsigned int k = unit.begin; k < unit.end; k++) {
+      const unsigned int iq{batch->order[k]};
+      const LosBatch::Query& q = batch->queries[iq];
+
+      // Same as Terrain::isProfileOcculted()
+      if (q.numPts < 3 || q.dist <= 0) continue;
+
+      // Using the bounds of the rings of the query's sector: the query is
+      // visible if its points [ 1 .. n-2 ] are below the line of sight within
+      // all of the rings, and it's occulted if any of its valid points is
+      // within a ring that's entirely above the line of sight.
+      bool decided{};
+      bool occulted{};
+      if (useSectors) {
+         const double deltaRng{q.dist / (q.numPts - 1)};
+         const double ra{deltaRng};
+         const double rb{deltaRng * (q.numPts - 2)};
+
+         double brg{std::fmod(q.truBrg, 360.0)};
+         if (brg < 0) brg += 360.0;
+         unsigned int s{static_cast<unsigned int>(brg / sectorWidth)};
+         if (s >= numSectors) s = numSectors - 1;
+
+         bool cleared{true};
+         for (unsigned int r = 0; !occulted && r < numRings && rings[r] <= rb; r++) {
+            if (rings[r+1] < ra) continue;
+
+            LosBatch::Bounds& b = bounds[s * numRings + r];
+            if (!b.valid) {
+               // Region of the sector within the ring
+               const double b0{s * sectorWidth};
+               const double b1{(s + 1) * sectorWidth};
+               double minN{std::numeric_limits<double>::max()};
+               double maxN{-std::numeric_limits<double>::max()};
+               double minE{std::numeric_limits<double>::max()};
+               double maxE{-std::numeric_limits<double>::max()};
+               auto add = [&](const double rng, const double angle) {
+                  const double angR{angle * base::angle::D2RCC};
+                  const double north{rng * std::cos(angR) * kLat};
+                  const double east{rng * std::sin(angR) * kLon};
+                  minN = std::min(minN, north);
+                  maxN = std::max(maxN, north);
+                  minE = std::min(minE, east);
+                  maxE = std::max(maxE, east);
+               };
+               add(rings[r], b0);
+               add(rings[r], b1);
+               add(rings[r+1], b0);
+               add(rings[r+1], b1);
+               for (double c = 0; c <= 360.0; c += 90.0) {
+                  if (c > b0 && c < b1) {
+                     add(rings[r], c);
+                     add(rings[r+1], c);
+                  }
+               }
+
+               double ringMin{}, ringMax{};
+               if (terrain->getElevationBounds(&ringMin, &ringMax,
+                                               lat + minN - REGION_MARGIN, lon + minE - REGION_MARGIN,
+                                               lat + maxN + REGION_MARGIN, lon + maxE + REGION_MARGIN)) {
+                  b.noData = (ringMin > ringMax);
+                  b.minElev = ringMin;
+                  b.maxElev = ringMax;
+               } else {
+                  b.minElev = -std::numeric_limits<double>::max();
+                  b.maxElev = std::numeric_limits<double>::max();
+               }
+               b.valid = true;
+            }
+
+            if (b.noData) continue;
+
+            // Line of sight altitudes over the query's part of the ring,
+            // with a margin for the round off of the point by point check
+            const double r0{std::max(rings[r], ra)};
+            const double r1{std::min(rings[r+1], rb)};
+            const double alt0{q.tanLookAng * r0};
+            const double alt1{q.tanLookAng * r1};
+            const double margin{1.0e-6 * (1.0 + std::fabs(refAlt) + std::fabs(alt0) + std::fabs(alt1))};
+
+            if (b.maxElev < (refAlt + std::min(alt0, alt1) - margin)) {
+               // Below the line of sight within this ring
+            }
+            else if (b.minElev > (refAlt + std::max(alt0, alt1) + margin)) {
+               // Above the line of sight within this ring; occulted if
+               // the query's first point within the ring is valid
+               unsigned int i{static_cast<unsigned int>(std::ceil(r0 / deltaRng))};
+               if (i < 1) i = 1;
+               if (i <= (q.numPts - 2) && (deltaRng * i) <= r1) {
+                  double deltaLat{}, deltaLon{};
+                  Terrain::computeProfileSteps(&deltaLat, &deltaLon, q.numPts, lat, q.truBrg, q.dist);
+                  double elev{};
+                  occulted = terrain->getElevation(&elev, lat + deltaLat * i, lon + deltaLon * i, false);
+               }
+               cleared = false;
+            }
+            else {
+               cleared = false;
+            }
+         }
+         decided = (cleared || occulted);
+      }
+
+      if (!decided) {
+         occulted = terrain->isProfileOcculted(q.numPts, q.refLat, q.refLon, q.truBrg, q.dist, q.refAlt, q.tanLookAng);
+      }
+      batch->occulted[iq] = (occulted ? 1 : 0);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool LosService::setSlotNumThreads(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 1) ok = setNumThreads(static_cast<unsigned int>(v));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "LosService::setSlotNumThreads(): invalid number of threads: " << v;
+         std::cerr << "; use [ 1 .. " << MAX_THREADS << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool LosService::setSlotPriority(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setPriority(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "LosService::setSlotPriority(): invalid priority; use [ 0 .. 1 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool LosService::setSlotNumSectors(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 1) ok = setNumSectors(static_cast<unsigned int>(v));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "LosService::setSlotNumSectors(): invalid number of sectors: " << v << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,36 @@
+
+#include "LosServiceThread.hpp"
+
+#include "mixr/terrain/LosService.hpp"
+
+#include "mixr/base/Component.hpp"
+
+namespace mixr {
+namespace terrain {
+
+LosServiceThread::LosServiceThread(base::Component* const parent): base::SyncThread(parent)
+{
+}
+
+void LosServiceThread::start0(const Terrain* const terrain0, LosBatch* const batch0)
+{
+   terrain = terrain0;
+   batch = batch0;
+
+   signalStart();
+}
+
+unsigned long LosServiceThread::userFunc()
+{
+   // Make sure we've a terrain and a batch ...
+   if (terrain != nullptr && batch != nullptr) {
+      // then help our service evaluate the batch
+      const LosService* svc{static_cast<const LosService*>(getParent())};
+      svc->processUnits(terrain, batch, &workspace);
+   }
+
+   return 0;
+}
+
+}
+}
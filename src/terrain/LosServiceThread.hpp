@@ -0,0 +1,39 @@
+
+#ifndef __mixr_terrain_LosServiceThread_HPP__
+#define __mixr_terrain_LosServiceThread_HPP__
+
+#include "mixr/base/threads/SyncThread.hpp"
+#include "mixr/terrain/LosBatch.hpp"
+
+namespace mixr {
+namespace base { class Component; }
+namespace terrain {
+class Terrain;
+
+//------------------------------------------------------------------------------
+// Class: LosServiceThread
+// Description: Line-of-sight service pool thread
+//------------------------------------------------------------------------------
+class LosServiceThread final : public base::SyncThread
+{
+public:
+   LosServiceThread(base::Component* const parent);
+
+   // Parent thread signals start to this child thread with these parameters.
+   void start0(const Terrain* const terrain0, LosBatch* const batch0);
+
+private:
+   // SyncTask class function -- our userFunc()
+   unsigned long userFunc() final;
+
+private:
+   const Terrain* terrain{};
+   LosBatch* batch{};
+
+   LosBatch::Workspace workspace;      // Our work space (kept between batches)
+};
+
+}
+}
+
+#endif
@@ -9,6 +9,8 @@
 #include "mixr/base/units/angles.hpp"
 #include "mixr/base/units/lengths.hpp"
 
+#include <algorithm>
+
 namespace mixr {
 namespace terrain {
 
@@ -136,6 +138,37 @@ bool QuadMap::getElevation(
 }
 
 
+//------------------------------------------------------------------------------
+// Bounds the elevations of a lat/lon region; available only if it's
+// available from all of our data files
+//------------------------------------------------------------------------------
+bool QuadMap::getElevationBounds(
+      double* const minElev,        // Min elevation (meters)
+      double* const maxElev,        // Max elevation (meters)
+      const double minLat,          // Southern latitude of the region (degs)
+      const double minLon,          // Western longitude of the region (degs)
+      const double maxLat,          // Northern latitude of the region (degs)
+      const double maxLon           // Eastern longitude of the region (degs)
+   ) const
+{
+   if ( minElev == nullptr || maxElev == nullptr || !isDataLoaded() ) return false;
+
+   double mn {1.0};
+   double mx {0.0};
+   for (unsigned int i = 0; i < numDataFiles; i++) {
+      double fmin{}, fmax{};
+      if (!dataFiles[i]->getElevationBounds(&fmin, &fmax, minLat, minLon, maxLat, maxLon)) return false;
+      if (fmin <= fmax) {
+         if (mn > mx) { mn = fmin; mx = fmax; }
+         else { mn = std::min(mn, fmin); mx = std::max(mx, fmax); }
+      }
+   }
+
+   *minElev = mn;
+   *maxElev = mx;
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Initializes the channel array
 //------------------------------------------------------------------------------
@@ -0,0 +1,622 @@
+
+#include "mixr/terrain/RasterService.hpp"
+
+#include "RasterServiceThread.hpp"
+
+#include "mixr/terrain/ElevationRaster.hpp"
+#include "mixr/terrain/Terrain.hpp"
+
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/colors/Hsva.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/angles.hpp"
+#include "mixr/base/units/lengths.hpp"
+#include "mixr/base/units/util/angle_utils.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <cmath>
+#include <memory>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(RasterService, "RasterService")
+
+BEGIN_SLOTTABLE(RasterService)
+   "numThreads",     //  1) Number of threads (including the calling thread)
+   "priority",       //  2) Pool thread priority
+   "tileSize",       //  3) Rows (or columns) per unit of work
+   "interpolate",    //  4) Interpolate between elevation posts
+   "hillshade",      //  5) Shade the relief
+   "sunAzimuth",     //  6) True direction to the light
+   "sunElevation",   //  7) Elevation angle of the light
+   "colors",         //  8) Elevation colors
+   "minElevation",   //  9) Elevation of the first color
+   "maxElevation",   // 10) Elevation of the last color
+END_SLOTTABLE(RasterService)
+
+BEGIN_SLOT_MAP(RasterService)
+   ON_SLOT( 1, setSlotNumThreads,    base::Integer)
+   ON_SLOT( 2, setSlotPriority,      base::Number)
+   ON_SLOT( 3, setSlotTileSize,      base::Integer)
+   ON_SLOT( 4, setSlotInterpolate,   base::Boolean)
+   ON_SLOT( 5, setSlotHillshade,     base::Boolean)
+   ON_SLOT( 6, setSlotSunAzimuth,    base::Angle)
+   ON_SLOT( 7, setSlotSunElevation,  base::Angle)
+   ON_SLOT( 8, setSlotColors,        base::PairStream)
+   ON_SLOT( 9, setSlotMinElevation,  base::Length)
+   ON_SLOT(10, setSlotMaxElevation,  base::Length)
+END_SLOT_MAP()
+
+// Light direction vectors in the vertical planes of the row (east) and
+// column (south) profiles; the vectors point the way the light travels,
+// which is what Terrain::cLight() expects.
+static void computeLightVectors(const double azimuth, const double elevation, base::Vec2d* const rowLv, base::Vec2d* const colLv)
+{
+   const double az{azimuth * base::angle::D2RCC};
+   const double el{elevation * base::angle::D2RCC};
+   const double down{-std::sin(el)};
+   rowLv->set(-std::sin(az) * std::cos(el), down);
+   rowLv->normalize();
+   colLv->set(std::cos(az) * std::cos(el), down);
+   colLv->normalize();
+}
+
+// Lighting factor of level terrain (i.e., Terrain::cLight() of a flat profile)
+static double flatLight(const base::Vec2d& lv)
+{
+   const double v{-lv.y()};
+   return (v > 0 ? v : 0);
+}
+
+// Color component [ 0 .. 1 ] to a byte
+static std::uint8_t toByte(const double v)
+{
+   if (v <= 0) return 0;
+   if (v >= 1.0) return 255;
+   return static_cast<std::uint8_t>(v * 255.0 + 0.5);
+}
+
+RasterService::RasterService()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void RasterService::copyData(const RasterService& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // Our copy creates its own pool threads at reset()
+   deleteThreads();
+
+   reqThreads = org.reqThreads;
+   priority = org.priority;
+   tileSize = org.tileSize;
+   interp = org.interp;
+   hillshade = org.hillshade;
+   sunAzimuth = org.sunAzimuth;
+   sunElevation = org.sunElevation;
+   minElevation = org.minElevation;
+   maxElevation = org.maxElevation;
+
+   clearColors();
+   for (const base::Hsva* p : org.colors) {
+      p->ref();
+      colors.push_back(p);
+   }
+}
+
+void RasterService::deleteData()
+{
+   deleteThreads();
+   clearColors();
+}
+
+void RasterService::clearColors()
+{
+   for (const base::Hsva* p : colors) {
+      p->unref();
+   }
+   colors.clear();
+}
+
+//------------------------------------------------------------------------------
+// reset() -- create the pool threads
+//------------------------------------------------------------------------------
+void RasterService::reset()
+{
+   BaseClass::reset();
+
+   if (reqThreads > 1 && numPoolThreads == 0 && !threadsFailed) {
+      createThreads();
+   }
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- shut down the pool threads
+//------------------------------------------------------------------------------
+bool RasterService::shutdownNotification()
+{
+   const bool ok{BaseClass::shutdownNotification()};
+
+   for (unsigned int i = 0; i < numPoolThreads; i++) {
+      // We're just going to make sure the threads not suspended,
+      // and they'll check our shutdown flag.
+      threads[i]->signalStart();
+   }
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Pool threads
+//------------------------------------------------------------------------------
+void RasterService::createThreads()
+{
+   for (unsigned int i = 0; i < (reqThreads-1); i++) {
+      threads[numPoolThreads] = new RasterServiceThread(this);
+      const bool ok{threads[numPoolThreads]->start(priority)};
+      if (ok) {
+         numPoolThreads++;
+      } else {
+         threads[numPoolThreads]->unref();
+         threads[numPoolThreads] = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "RasterService::createThreads(): ERROR, failed to create a pool thread!" << std::endl;
+         }
+      }
+   }
+
+   // If we still don't have any threads then something failed
+   threadsFailed = (numPoolThreads == 0);
+}
+
+void RasterService::deleteThreads()
+{
+   for (unsigned int i = 0; i < numPoolThreads; i++) {
+      threads[i]->terminate();
+      threads[i]->unref();
+      threads[i] = nullptr;
+   }
+   numPoolThreads = 0;
+   threadsFailed = false;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool RasterService::setNumThreads(const unsigned int v)
+{
+   bool ok{};
+   if (v >= 1 && v <= MAX_THREADS) {
+      reqThreads = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool RasterService::setPriority(const double v)
+{
+   bool ok{};
+   if (v >= 0 && v <= 1.0) {
+      priority = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool RasterService::setTileSize(const unsigned int v)
+{
+   bool ok{};
+   if (v >= 1) {
+      tileSize = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool RasterService::setInterpolate(const bool flg)
+{
+   interp = flg;
+   return true;
+}
+
+bool RasterService::setHillshade(const bool flg)
+{
+   hillshade = flg;
+   return true;
+}
+
+bool RasterService::setSunAzimuth(const double degs)
+{
+   sunAzimuth = degs;
+   return true;
+}
+
+bool RasterService::setSunElevation(const double degs)
+{
+   bool ok{};
+   if (degs >= 0 && degs <= 90.0) {
+      sunElevation = degs;
+      ok = true;
+   }
+   return ok;
+}
+
+bool RasterService::setMinElevation(const double meters)
+{
+   minElevation = meters;
+   return true;
+}
+
+bool RasterService::setMaxElevation(const double meters)
+{
+   maxElevation = meters;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// process() -- generates the raster
+//------------------------------------------------------------------------------
+bool RasterService::process(const Terrain* const terrain, ElevationRaster* const raster) const
+{
+   if (terrain == nullptr || raster == nullptr || raster->numRows == 0 || raster->numCols == 0) return false;
+
+   const std::size_t n{static_cast<std::size_t>(raster->numRows) * raster->numCols};
+   raster->elevations.assign(n, 0.0f);
+   raster->valid.assign(n, 0);
+   raster->rowShade.clear();
+   raster->colShade.clear();
+   raster->shading.clear();
+   raster->image.clear();
+   if (hillshade) {
+      raster->rowShade.assign(n, 0.0f);
+      raster->colShade.assign(n, 0.0f);
+      raster->shading.assign(n, 0.0f);
+   }
+   const bool makeImage{hillshade || !colors.empty()};
+   if (makeImage) raster->image.assign(n * 4, 0);
+
+   // Use the pool threads if they're free
+   bool usePool{};
+   if (numPoolThreads > 0) {
+      base::lock(poolSemaphore);
+      if (!poolBusy) {
+         poolBusy = true;
+         usePool = true;
+      }
+      base::unlock(poolSemaphore);
+   }
+
+   processPass(terrain, raster, ELEVATIONS, usePool);
+   if (hillshade) processPass(terrain, raster, SHADING, usePool);
+   if (makeImage) processPass(terrain, raster, IMAGE, usePool);
+
+   if (usePool) {
+      base::lock(poolSemaphore);
+      poolBusy = false;
+      base::unlock(poolSemaphore);
+   }
+
+   raster->units.clear();
+   raster->processed = true;
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Processes one pass of the raster
+//------------------------------------------------------------------------------
+void RasterService::processPass(const Terrain* const terrain, ElevationRaster* const raster, const unsigned int pass, const bool usePool) const
+{
+   // ---
+   // Units of work: tiles of rows (and, for the shading, tiles of columns)
+   // ---
+   raster->units.clear();
+   for (unsigned int i = 0; i < raster->numRows; i += tileSize) {
+      ElevationRaster::Unit unit;
+      unit.begin = i;
+      unit.end = (raster->numRows - i > tileSize ? i + tileSize : raster->numRows);
+      raster->units.push_back(unit);
+   }
+   if (pass == SHADING) {
+      for (unsigned int i = 0; i < raster->numCols; i += tileSize) {
+         ElevationRaster::Unit unit;
+         unit.begin = i;
+         unit.end = (raster->numCols - i > tileSize ? i + tileSize : raster->numCols);
+         unit.columns = true;
+         raster->units.push_back(unit);
+      }
+   }
+   raster->nextUnit = 0;
+   raster->pass = pass;
+
+   // ---
+   // Process the units, with the pool threads
+   // ---
+   if (usePool && raster->units.size() > 1) {
+      unsigned int n{numPoolThreads};
+      if (n > (raster->units.size() - 1)) n = static_cast<unsigned int>(raster->units.size() - 1);
+      for (unsigned int i = 0; i < n; i++) {
+         threads[i]->start0(terrain, raster);
+      }
+
+      // we're the last thread
+      processUnits(terrain, raster);
+
+      // Now wait for the other thread(s) to complete
+      base::SyncThread** pp{reinterpret_cast<base::SyncThread**>(const_cast<RasterServiceThread**>(&threads[0]))};
+      base::SyncThread::waitForAllCompleted(pp, static_cast<int>(n));
+   } else {
+      processUnits(terrain, raster);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Processes the raster's units until there are no more
+//------------------------------------------------------------------------------
+void RasterService::processUnits(const Terrain* const terrain, ElevationRaster* const raster) const
+{
+   const unsigned int numUnits{static_cast<unsigned int>(raster->units.size())};
+   for (;;) {
+      base::lock(raster->semaphore);
+      const unsigned int idx{raster->nextUnit};
+      if (idx < numUnits) raster->nextUnit++;
+      base::unlock(raster->semaphore);
+
+      if (idx >= numUnits) break;
+      processUnit(terrain, raster, idx);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Processes one unit of the current pass
+//------------------------------------------------------------------------------
+void RasterService::processUnit(const Terrain* const terrain, ElevationRaster* const raster, const unsigned int idx) const
+{
+   const ElevationRaster::Unit& unit = raster->units[idx];
+   const unsigned int numRows{raster->numRows};
+   const unsigned int numCols{raster->numCols};
+   const double dLat{raster->getLatitudeSpacing()};
+   const double dLon{raster->getLongitudeSpacing()};
+
+   if (raster->pass == ELEVATIONS) {
+      // ---
+      // Elevations along each row, west to east
+      // ---
+      const unsigned int np{numCols > 1 ? numCols : 2};
+      const std::unique_ptr<double[]> elevs(new double[np]);
+      const std::unique_ptr<bool[]> flags(new bool[np]);
+      const double lon0{raster->getLongitude(0)};
+      for (unsigned int r = unit.begin; r < unit.end; r++) {
+         const double lat{raster->getLatitude(r)};
+         for (unsigned int c = 0; c < np; c++) {
+            elevs[c] = 0;
+            flags[c] = false;
+         }
+         // Range to the last cell (same flat earth steps as Terrain::computeProfileSteps())
+         const double rng{(np - 1) * dLon * 60.0 * std::cos(lat * base::angle::D2RCC) * base::length::NM2M};
+         terrain->getElevations(elevs.get(), flags.get(), np, lat, lon0, 90.0, rng, interp);
+
+         const std::size_t k{static_cast<std::size_t>(r) * numCols};
+         for (unsigned int c = 0; c < numCols; c++) {
+            if (flags[c]) {
+               raster->elevations[k + c] = static_cast<float>(elevs[c]);
+               raster->valid[k + c] = 1;
+            }
+         }
+      }
+   }
+
+   else if (raster->pass == SHADING) {
+      // ---
+      // Lighting factors along each row (west to east) or column (north to south)
+      // ---
+      base::Vec2d rowLv, colLv;
+      computeLightVectors(sunAzimuth, sunElevation, &rowLv, &colLv);
+      const base::Vec2d& lv = (unit.columns ? colLv : rowLv);
+
+      const unsigned int np{unit.columns ? numRows : numCols};
+      const std::size_t step{unit.columns ? numCols : 1u};
+      std::vector<float>& out = (unit.columns ? raster->colShade : raster->rowShade);
+
+      const std::unique_ptr<double[]> elevs(new double[np]);
+      const std::unique_ptr<bool[]> masks(new bool[np]);
+      const std::unique_ptr<double[]> light(new double[np]);
+      for (unsigned int i = unit.begin; i < unit.end; i++) {
+         const std::size_t k0{unit.columns ? i : static_cast<std::size_t>(i) * numCols};
+         for (unsigned int j = 0; j < np; j++) {
+            const std::size_t k{k0 + j * step};
+            elevs[j] = raster->elevations[k];
+            masks[j] = (raster->valid[k] == 0);
+         }
+
+         // Range to the last cell
+         double rng{};
+         if (unit.columns) rng = (np - 1) * dLat * 60.0 * base::length::NM2M;
+         else rng = (np - 1) * dLon * 60.0 * std::cos(raster->getLatitude(i) * base::angle::D2RCC) * base::length::NM2M;
+
+         if (!Terrain::cLight(light.get(), elevs.get(), masks.get(), np, rng, lv)) {
+            // Too few cells; they're level
+            const double v{flatLight(lv)};
+            for (unsigned int j = 0; j < np; j++) {
+               light[j] = (masks[j] ? 0 : v);
+            }
+         }
+         for (unsigned int j = 0; j < np; j++) {
+            out[k0 + j * step] = static_cast<float>(light[j]);
+         }
+      }
+   }
+
+   else if (raster->pass == IMAGE) {
+      // ---
+      // Shading factors and the image
+      // ---
+      const unsigned int numColors{static_cast<unsigned int>(colors.size())};
+      const base::Hsva** colorTable{numColors > 0 ? const_cast<const base::Hsva**>(colors.data()) : nullptr};
+      double minz{minElevation};
+      double maxz{maxElevation};
+      if (maxz <= minz) {
+         minz = terrain->getMinElevation();
+         maxz = terrain->getMaxElevation();
+      }
+
+      for (unsigned int r = unit.begin; r < unit.end; r++) {
+         const std::size_t k0{static_cast<std::size_t>(r) * numCols};
+         for (unsigned int c = 0; c < numCols; c++) {
+            const std::size_t k{k0 + c};
+            if (raster->valid[k] == 0) continue;      // masked (transparent)
+
+            double shade{1.0};
+            if (hillshade) {
+               shade = 0.5 * (raster->rowShade[k] + raster->colShade[k]);
+               raster->shading[k] = static_cast<float>(shade);
+            }
+
+            base::Vec3d rgb(shade, shade, shade);
+            if (colorTable != nullptr) {
+               Terrain::getElevationColor(raster->elevations[k], minz, maxz, colorTable, numColors, rgb);
+               rgb *= shade;
+            }
+
+            std::uint8_t* const p{&raster->image[k * 4]};
+            p[0] = toByte(rgb[0]);
+            p[1] = toByte(rgb[1]);
+            p[2] = toByte(rgb[2]);
+            p[3] = 255;
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool RasterService::setSlotNumThreads(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 1) ok = setNumThreads(static_cast<unsigned int>(v));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RasterService::setSlotNumThreads(): invalid number of threads: " << v;
+         std::cerr << "; use [ 1 .. " << MAX_THREADS << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RasterService::setSlotPriority(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setPriority(msg->asDouble());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RasterService::setSlotPriority(): invalid priority; use [ 0 .. 1 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RasterService::setSlotTileSize(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 1) ok = setTileSize(static_cast<unsigned int>(v));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RasterService::setSlotTileSize(): invalid tile size: " << v << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RasterService::setSlotInterpolate(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setInterpolate(msg->asBool());
+   }
+   return ok;
+}
+
+bool RasterService::setSlotHillshade(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setHillshade(msg->asBool());
+   }
+   return ok;
+}
+
+bool RasterService::setSlotSunAzimuth(const base::Angle* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setSunAzimuth(msg->getValueInDegrees());
+   }
+   return ok;
+}
+
+bool RasterService::setSlotSunElevation(const base::Angle* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setSunElevation(msg->getValueInDegrees());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RasterService::setSlotSunElevation(): invalid elevation; use [ 0 .. 90 ] degrees" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RasterService::setSlotColors(const base::PairStream* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      clearColors();
+      ok = true;
+      const base::List::Item* item{msg->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto color = dynamic_cast<const base::Hsva*>(pair->object());
+         if (color != nullptr) {
+            color->ref();
+            colors.push_back(color);
+         } else {
+            ok = false;
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "RasterService::setSlotColors(): colors must be of type 'hsva'" << std::endl;
+            }
+         }
+         item = item->getNext();
+      }
+   }
+   return ok;
+}
+
+bool RasterService::setSlotMinElevation(const base::Length* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMinElevation(msg->getValueInMeters());
+   }
+   return ok;
+}
+
+bool RasterService::setSlotMaxElevation(const base::Length* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMaxElevation(msg->getValueInMeters());
+   }
+   return ok;
+}
+
+}
+}
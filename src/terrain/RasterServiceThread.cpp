@@ -0,0 +1,36 @@
+
+#include "RasterServiceThread.hpp"
+
+#include "mixr/terrain/RasterService.hpp"
+
+#include "mixr/base/Component.hpp"
+
+namespace mixr {
+namespace terrain {
+
+RasterServiceThread::RasterServiceThread(base::Component* const parent): base::SyncThread(parent)
+{
+}
+
+void RasterServiceThread::start0(const Terrain* const terrain0, ElevationRaster* const raster0)
+{
+   terrain = terrain0;
+   raster = raster0;
+
+   signalStart();
+}
+
+unsigned long RasterServiceThread::userFunc()
+{
+   // Make sure we've a terrain and a raster ...
+   if (terrain != nullptr && raster != nullptr) {
+      // then help our service generate the raster
+      const RasterService* svc{static_cast<const RasterService*>(getParent())};
+      svc->processUnits(terrain, raster);
+   }
+
+   return 0;
+}
+
+}
+}
@@ -0,0 +1,37 @@
+
+#ifndef __mixr_terrain_RasterServiceThread_HPP__
+#define __mixr_terrain_RasterServiceThread_HPP__
+
+#include "mixr/base/threads/SyncThread.hpp"
+
+namespace mixr {
+namespace base { class Component; }
+namespace terrain {
+class ElevationRaster;
+class Terrain;
+
+//------------------------------------------------------------------------------
+// Class: RasterServiceThread
+// Description: Elevation raster service pool thread
+//------------------------------------------------------------------------------
+class RasterServiceThread final : public base::SyncThread
+{
+public:
+   RasterServiceThread(base::Component* const parent);
+
+   // Parent thread signals start to this child thread with these parameters.
+   void start0(const Terrain* const terrain0, ElevationRaster* const raster0);
+
+private:
+   // SyncTask class function -- our userFunc()
+   unsigned long userFunc() final;
+
+private:
+   const Terrain* terrain{};
+   ElevationRaster* raster{};
+};
+
+}
+}
+
+#endif
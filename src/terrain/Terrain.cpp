@@ -9,12 +9,16 @@
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/String.hpp"
 
+#include "mixr/base/units/util/angle_utils.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
 #include "mixr/base/util/nav_utils.hpp"
 
 #include "mixr/base/osg/Vec2d"
 #include "mixr/base/osg/Vec3d"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 
 namespace mixr {
 namespace terrain {
@@ -222,25 +226,10 @@ bool Terrain::targetOcculting(
    unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
    if (numPts > MAX_POINTS) numPts = MAX_POINTS;
 
-   // Get the elevations and check for target occulting
-   if (numPts > 1) {
-
-      // Arrays for the elevations
-      double elevations[MAX_POINTS];
-
-      // Valid flags
-      bool validFlags[MAX_POINTS];
-      for (unsigned int i = 0; i < numPts; i++) { validFlags[i] = false; }
-
-      // Get the elevations
-      unsigned int num = getElevations(elevations, validFlags, numPts, refLat, refLon,
-                                       static_cast<double>(brgDeg), static_cast<double>(dist), false);
-
-      // And check occulting
-      if (num > 0) {
-         occulted = occultCheck(elevations, validFlags, numPts, static_cast<double>(dist),
-                                refAlt, tgtAlt);
-      }
+   // Check the elevations for target occulting
+   if (numPts > 1 && dist > 0) {
+      const double tgtTan = (tgtAlt - refAlt) / dist;
+      occulted = isProfileOcculted(numPts, refLat, refLon, brgDeg, dist, refAlt, tgtTan);
    }
 
    return occulted;
@@ -269,27 +258,143 @@ bool Terrain::targetOcculting2(
    unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
    if (numPts > MAX_POINTS) numPts = MAX_POINTS;
 
-   // Get the elevations and check for target occulting
+   // Check the elevations for target occulting
    if (numPts > 1) {
+      occulted = isProfileOcculted(numPts, refLat, refLon, truBrg, dist, refAlt, tanLookAng);
+   }
 
-      // Arrays for the elevations
-      double elevations[MAX_POINTS];
+   return occulted;
+}
 
-      // Valid flags
-      bool validFlags[MAX_POINTS];
-      for (unsigned int i = 0; i < numPts; i++) { validFlags[i] = false; }
+//------------------------------------------------------------------------------
+// Profile occulting: returns true if any of the elevation points along the
+// profile, other than its first and last points, is at or above the line of
+// sight (same answer as getElevations() and occultCheck2()).
+//------------------------------------------------------------------------------
+bool Terrain::isProfileOcculted(
+      const unsigned int n,         // Number of elevation points
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const double direction,       // True direction (heading) angle of the profile (degs)
+      const double maxRng,          // Range to last elevation point (meters)
+      const double refAlt,          // Ref altitude (meters)
+      const double tanLookAng       // Tangent of the look angle
+   ) const
+{
+   // Early out tests (same as getElevations())
+   if ( n < 3 ||                       // there are no points between the end points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0                    // the max range is less than or equal to zero
+      ) return false;
+
+   ProfileLos los;
+   los.lat = lat;
+   los.lon = lon;
+   los.deltaRng = maxRng / (n - 1);
+   los.refAlt = refAlt;
+   los.tanLookAng = tanLookAng;
+   computeProfileSteps(&los.deltaLat, &los.deltaLon, n, lat, direction, maxRng);
+
+   // Without elevation bounds, get all of the elevations and check them
+   double minElev{}, maxElev{};
+   if ( !getElevationBounds(&minElev, &maxElev, lat, lon, lat, lon) ) {
+      const std::unique_ptr<double[]> elevations(new double[n]);
+      const std::unique_ptr<bool[]> validFlags(new bool[n]());
+      const unsigned int num = getElevations(elevations.get(), validFlags.get(), n, lat, lon, direction, maxRng, false);
+      return (num > 0 && occultCheck2(elevations.get(), validFlags.get(), n, maxRng, refAlt, tanLookAng));
+   }
 
-      // Get the elevations
-      unsigned int num = getElevations(elevations, validFlags, numPts, refLat, refLon,
-                                       static_cast<double>(truBrg), static_cast<double>(dist), false);
+   return isSpanOcculted(los, 1, n - 2);
+}
 
-      // And check occulting
-      if (num > 0) {
-         occulted = occultCheck2(elevations, validFlags, numPts, dist, refAlt, tanLookAng);
+//------------------------------------------------------------------------------
+// Checks points [ i0 .. i1 ] of the profile: the span is rejected if its max
+// elevation is below the line of sight, it's accepted if its min elevation
+// is above the line of sight (and its first point is valid), otherwise it's
+// split in two, down to a few points that are checked one by one.
+//------------------------------------------------------------------------------
+bool Terrain::isSpanOcculted(const ProfileLos& los, const unsigned int i0, const unsigned int i1) const
+{
+   // Spans of this many points, or less, are checked point by point
+   static const unsigned int MIN_SPAN = 8;
+
+   const double lat0 = los.lat + los.deltaLat * i0;
+   const double lon0 = los.lon + los.deltaLon * i0;
+   const double lat1 = los.lat + los.deltaLat * i1;
+   const double lon1 = los.lon + los.deltaLon * i1;
+
+   double minElev = 0;
+   double maxElev = 0;
+   const bool bounded = getElevationBounds(&minElev, &maxElev,
+                                           std::min(lat0, lat1), std::min(lon0, lon1),
+                                           std::max(lat0, lat1), std::max(lon0, lon1));
+
+   if (bounded) {
+      // No data within the span
+      if (minElev > maxElev) return false;
+
+      // Line of sight altitudes at the ends of the span, with a margin for
+      // the round off of the point by point check
+      const double alt0 = los.tanLookAng * (los.deltaRng * i0);
+      const double alt1 = los.tanLookAng * (los.deltaRng * i1);
+      const double margin = 1.0e-6 * (1.0 + std::fabs(los.refAlt) + std::fabs(alt0) + std::fabs(alt1));
+
+      // Reject: all of the span is below the line of sight
+      if (maxElev < (los.refAlt + std::min(alt0, alt1) - margin)) return false;
+
+      // Accept: all of the span is above the line of sight; only the
+      // first point needs to be valid
+      if (minElev > (los.refAlt + std::max(alt0, alt1) + margin)) {
+         double elev = 0;
+         if (getElevation(&elev, lat0, lon0, false)) return true;
       }
    }
 
-   return occulted;
+   // Split the span
+   if (bounded && (i1 - i0 + 1) > MIN_SPAN) {
+      const unsigned int mid = i0 + (i1 - i0) / 2;
+      return isSpanOcculted(los, i0, mid) || isSpanOcculted(los, mid + 1, i1);
+   }
+
+   // Check the points (as occultCheck2())
+   for (unsigned int i = i0; i <= i1; i++) {
+      double elev = 0;
+      if (getElevation(&elev, los.lat + los.deltaLat * i, los.lon + los.deltaLon * i, false)) {
+         const double currentRange = los.deltaRng * i;
+         const double tstTan = (elev - los.refAlt) / currentRange;
+         if (tstTan >= los.tanLookAng) return true;
+      }
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// Elevation bounds of a lat/lon region; not available by default
+//------------------------------------------------------------------------------
+bool Terrain::getElevationBounds(double* const, double* const, const double, const double, const double, const double) const
+{
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// Computes the lat/lon steps (degs) between the points of a profile (flat earth)
+//------------------------------------------------------------------------------
+void Terrain::computeProfileSteps(
+      double* const deltaLat,       // Latitude step (degs)
+      double* const deltaLon,       // Longitude step (degs)
+      const unsigned int n,         // Number of points
+      const double lat,             // Starting latitude (degs)
+      const double direction,       // True direction (heading) angle of the profile (degs)
+      const double maxRng           // Range to last elevation point (meters)
+   )
+{
+   // Spacing between points (in each direction)
+   const double deltaPoint = (n > 1 ? maxRng / (n - 1) : 0.0);
+   const double dirR = direction * base::angle::D2RCC;
+   const double deltaNorth = deltaPoint * std::cos(dirR) * base::length::M2NM;  // (NM)
+   const double deltaEast = deltaPoint * std::sin(dirR) * base::length::M2NM;
+   *deltaLat = deltaNorth / 60.0;
+   *deltaLon = deltaEast / (60.0 * std::cos(lat * base::angle::D2RCC));
 }
 
 //------------------------------------------------------------------------------
@@ -321,11 +426,10 @@ bool Terrain::occultCheck(
    // Loop through all elevation points looking for an angle
    // that's greater than our ref angle
    const double deltaRng = (range / (n - 1));
-   double currentRange = 0;
    if (validFlags != nullptr) {
       // with valid flags
       for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
+         const double currentRange = deltaRng * i;
          if (validFlags[i]) {
             const double tstTan = (elevations[i] - refAlt) / currentRange;
             if (tstTan >= tgtTan) {
@@ -337,7 +441,7 @@ bool Terrain::occultCheck(
    else {
       // without valid flags
       for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
+         const double currentRange = deltaRng * i;
          const double tstTan = (elevations[i] - refAlt) / currentRange;
          if (tstTan >= tgtTan) {
             occulted = true;
@@ -372,11 +476,10 @@ bool Terrain::occultCheck2(
    // Loop through all elevation points looking for an angle
    // that's greater than our ref angle
    const double deltaRng = (range / (n - 1));
-   double currentRange = 0;
    if (validFlags != nullptr) {
       // with valid flags
       for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
+         const double currentRange = deltaRng * i;
          if (validFlags[i]) {
             const double tstTan = (elevations[i] - refAlt) / currentRange;
             if (tstTan >= tanLookAng) {
@@ -387,7 +490,7 @@ bool Terrain::occultCheck2(
    } else {
       // without valid flags
       for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
+         const double currentRange = deltaRng * i;
          const double tstTan = (elevations[i] - refAlt) / currentRange;
          if (tstTan >= tanLookAng) {
             occulted = true;
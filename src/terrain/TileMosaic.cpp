@@ -0,0 +1,680 @@
+
+#include "mixr/terrain/TileMosaic.hpp"
+
+#include "mixr/terrain/DataFile.hpp"
+#include "mixr/terrain/ded/DedFile.hpp"
+#include "mixr/terrain/dted/DtedFile.hpp"
+#include "mixr/terrain/srtm/SrtmHgtFile.hpp"
+
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+#if defined(WIN32)
+   #include <windows.h>
+#else
+   #include <dirent.h>
+   #include <sys/stat.h>
+#endif
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(TileMosaic, "TileMosaic")
+
+BEGIN_SLOTTABLE(TileMosaic)
+   "directory",      // 1) Directory that's scanned for tiles
+   "recursive",      // 2) Scan subdirectories
+   "overlap",        // 3) Overlap priority { finest, order }
+END_SLOTTABLE(TileMosaic)
+
+BEGIN_SLOT_MAP(TileMosaic)
+   ON_SLOT(1, setSlotDirectory, base::String)
+   ON_SLOT(2, setSlotRecursive, base::Boolean)
+   ON_SLOT(3, setSlotOverlap,   base::Identifier)
+END_SLOT_MAP()
+
+// Limit on the depth of the scanned subdirectories
+static const unsigned int MAX_SCAN_DEPTH{8};
+
+// Tolerance on the tile edges (degs)
+static const double EDGE_EPS{1.0e-9};
+
+TileMosaic::TileMosaic()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void TileMosaic::copyData(const TileMosaic& org, const bool)
+{
+   // Our base class(s) will copy our components, which include the
+   // original mosaic's component tiles.
+   BaseClass::copyData(org);
+
+   directory = org.directory;
+   recursive = org.recursive;
+   overlap = org.overlap;
+
+   // The directory is rescanned at reset()
+   clearScannedTiles();
+   scanDone = false;
+
+   buildIndex();
+}
+
+void TileMosaic::deleteData()
+{
+   clearData();
+   clearScannedTiles();
+}
+
+//------------------------------------------------------------------------------
+// reset() -- scan our directory, and index our tiles
+//------------------------------------------------------------------------------
+void TileMosaic::reset()
+{
+   if (!scanDone) {
+      scanDirectory();
+   }
+
+   // Resetting our base class will reset our components,
+   // which will load the component tiles
+   BaseClass::reset();
+
+   buildIndex();
+}
+
+//------------------------------------------------------------------------------
+// Access functions
+//------------------------------------------------------------------------------
+
+bool TileMosaic::isDataLoaded() const
+{
+   return !tiles.empty();
+}
+
+unsigned int TileMosaic::getNumTiles() const
+{
+   return static_cast<unsigned int>(tiles.size());
+}
+
+const DataFile* TileMosaic::getTile(const unsigned int i) const
+{
+   const DataFile* p{};
+   if (i < tiles.size()) p = tiles[i].file;
+   return p;
+}
+
+const char* TileMosaic::getDirectory() const
+{
+   const char* p{};
+   if (!directory.empty()) p = directory.c_str();
+   return p;
+}
+
+bool TileMosaic::isRecursive() const
+{
+   return recursive;
+}
+
+TileMosaic::Overlap TileMosaic::getOverlap() const
+{
+   return overlap;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool TileMosaic::setDirectory(const std::string& x)
+{
+   directory = x;
+   scanDone = false;
+   return true;
+}
+
+bool TileMosaic::setRecursive(const bool x)
+{
+   recursive = x;
+   scanDone = false;
+   return true;
+}
+
+bool TileMosaic::setOverlap(const Overlap x)
+{
+   overlap = x;
+   if (isDataLoaded()) buildIndex();
+   return true;
+}
+
+bool TileMosaic::rescan()
+{
+   scanDirectory();
+   buildIndex();
+   return isDataLoaded();
+}
+
+//------------------------------------------------------------------------------
+// Locates an array of (at least two) elevation points (and sets valid flags if found)
+// returns the number of points found within this TileMosaic
+//------------------------------------------------------------------------------
+unsigned int TileMosaic::getElevations(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of elevation and valdFlags arrays
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const double direction,       // True direction (heading) angle of the data (degs)
+      const double maxRng,          // Range to last elevation point (meters)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num{};
+
+   // Early out tests
+   if ( !isDataLoaded() ||             // Not loaded, or
+        elevations == nullptr ||       // the elevation array wasn't provided, or
+        validFlags == nullptr ||       // the valid flag array wasn't provided, or
+        n < 2 ||                       // there are too few points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0                    // the max range is less than or equal to zero
+      ) return num;
+
+   // Spacing between points (in each direction)
+   double deltaLat{};
+   double deltaLon{};
+   computeProfileSteps(&deltaLat, &deltaLon, n, lat, direction, maxRng);
+
+   // Each point is located in its own tile, so the profile crosses the seams
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i]) {
+         double value{};
+         if (lookup(&value, lat + deltaLat * i, lon + deltaLon * i, interp)) {
+            elevations[i] = value;
+            validFlags[i] = true;
+            num++;
+         }
+      }
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates an elevation value (meters) for a given reference point and returns
+// it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+//------------------------------------------------------------------------------
+bool TileMosaic::getElevation(
+      double* const elev,     // The elevation value (meters)
+      const double lat,       // Reference latitude (degs)
+      const double lon,       // Reference longitude (degs)
+      const bool interp       // Interpolate between elevation posts (if true)
+   ) const
+{
+   // Early out tests
+   if ( elev == nullptr || !isDataLoaded() ) return false;
+
+   double value{};
+   const bool found {lookup(&value, lat, lon, interp)};
+   if (found) {
+      *elev = value;
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Bounds the elevations of a lat/lon region using the bounds of the tiles that
+// are within two post spacings of the region (lookup() may use their posts).
+//------------------------------------------------------------------------------
+bool TileMosaic::getElevationBounds(
+      double* const minElev,        // Min elevation (meters)
+      double* const maxElev,        // Max elevation (meters)
+      const double minLat,          // Southern latitude of the region (degs)
+      const double minLon,          // Western longitude of the region (degs)
+      const double maxLat,          // Northern latitude of the region (degs)
+      const double maxLon           // Eastern longitude of the region (degs)
+   ) const
+{
+   if ( minElev == nullptr || maxElev == nullptr || !isDataLoaded() ) return false;
+
+   const double lat0 {minLat - 2.0 * maxSpacing};
+   const double lon0 {minLon - 2.0 * maxSpacing};
+   const double lat1 {maxLat + 2.0 * maxSpacing};
+   const double lon1 {maxLon + 2.0 * maxSpacing};
+
+   double mn {1.0};
+   double mx {0.0};
+   const int ilat1 {std::min(static_cast<int>(std::floor(lat1)), 89)};
+   const int ilon1 {std::min(static_cast<int>(std::floor(lon1)), 179)};
+   for (int ilat = std::max(static_cast<int>(std::floor(lat0)), -90); ilat <= ilat1; ilat++) {
+      for (int ilon = std::max(static_cast<int>(std::floor(lon0)), -180); ilon <= ilon1; ilon++) {
+         const auto it = cells.find(cellKey(ilat, ilon));
+         if (it == cells.end()) continue;
+         for (const unsigned int idx : it->second) {
+            double tmin{}, tmax{};
+            if (!tiles[idx].file->getElevationBounds(&tmin, &tmax, lat0, lon0, lat1, lon1)) return false;
+            if (tmin <= tmax) {
+               if (mn > mx) { mn = tmin; mx = tmax; }
+               else { mn = std::min(mn, tmin); mx = std::max(mx, tmax); }
+            }
+         }
+      }
+   }
+
+   *minElev = mn;
+   *maxElev = mx;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Tile index
+//------------------------------------------------------------------------------
+
+// Key of the one degree cell with its south-west corner at [ ilat ilon ]
+int TileMosaic::cellKey(const int ilat, const int ilon)
+{
+   return (ilat + 90) * 360 + (ilon + 180);
+}
+
+// Indices of the tiles that cover the point's cell, or zero if none
+const std::vector<unsigned int>* TileMosaic::findCell(const double lat, const double lon) const
+{
+   const std::vector<unsigned int>* p{};
+   const auto it = cells.find( cellKey(static_cast<int>(std::floor(lat)), static_cast<int>(std::floor(lon))) );
+   if (it != cells.end()) p = &it->second;
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevation at a point: the highest priority tile that contains
+// the point is used, unless its posts are void.  Points that are past the
+// last posts of a tile (i.e., in the gap between tiles) are interpolated with
+// the neighboring tiles' posts.
+//------------------------------------------------------------------------------
+bool TileMosaic::lookup(double* const elev, const double lat, const double lon, const bool interp) const
+{
+   const std::vector<unsigned int>* cell {findCell(lat, lon)};
+   if (cell == nullptr) return false;
+
+   // Tiles that contain the point
+   for (const unsigned int idx : *cell) {
+      const Tile& t {tiles[idx]};
+      if ( lat >= (t.swLat - EDGE_EPS) && lat <= (t.neLat + EDGE_EPS) &&
+           lon >= (t.swLon - EDGE_EPS) && lon <= (t.neLon + EDGE_EPS) ) {
+         if (sample(elev, t, lat, lon, interp)) return true;
+      }
+   }
+
+   // Tiles that the point is within one post spacing of
+   for (const unsigned int idx : *cell) {
+      const Tile& t {tiles[idx]};
+      if ( lat >= (t.swLat - EDGE_EPS) && lat < (t.neLat + t.latSpacing) &&
+           lon >= (t.swLon - EDGE_EPS) && lon < (t.neLon + t.lonSpacing) &&
+           (lat > (t.neLat + EDGE_EPS) || lon > (t.neLon + EDGE_EPS)) ) {
+         if (sample(elev, t, lat, lon, interp)) return true;
+      }
+   }
+
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// Samples the elevation of a point using tile 't'
+//------------------------------------------------------------------------------
+bool TileMosaic::sample(double* const elev, const Tile& t, const double lat, const double lon, const bool interp) const
+{
+   double pointsLat {(lat - t.swLat) / t.latSpacing};
+   if (pointsLat < 0) pointsLat = 0;
+
+   double pointsLon {(lon - t.swLon) / t.lonSpacing};
+   if (pointsLon < 0) pointsLon = 0;
+
+   const double maxLatPoint {static_cast<double>(t.nptlat - 1)};
+   const double maxLonPoint {static_cast<double>(t.nptlong - 1)};
+
+   // Returns the post [irow icol] of this tile, or, past its last posts,
+   // the neighboring tiles' post (or this tile's edge post if there's none)
+   auto post = [this, &t](double* const v, const unsigned int irow, const unsigned int icol) -> bool {
+      if (irow < t.nptlat && icol < t.nptlong) {
+         return getPost(v, t, irow, icol);
+      }
+      const double plat {t.swLat + static_cast<double>(irow) * t.latSpacing};
+      const double plon {t.swLon + static_cast<double>(icol) * t.lonSpacing};
+      if (findPost(v, plat, plon, &t)) return true;
+      return getPost(v, t, std::min(irow, t.nptlat - 1), std::min(icol, t.nptlong - 1));
+   };
+
+   // ---
+   // Interpolating between elevation posts?
+   // ---
+   if (interp) {
+      // Yes ---
+
+      // South-west corner post is [icol][irow]; within the tile, the
+      // corner posts are all from this tile.
+      unsigned int irow {static_cast<unsigned int>(pointsLat)};
+      unsigned int icol {static_cast<unsigned int>(pointsLon)};
+      if (pointsLat <= maxLatPoint && irow > (t.nptlat-2)) irow = (t.nptlat-2);
+      if (pointsLon <= maxLonPoint && icol > (t.nptlong-2)) icol = (t.nptlong-2);
+
+      // delta from s-w corner post
+      const double deltaLat {std::min(pointsLat - static_cast<double>(irow), 1.0)};
+      const double deltaLon {std::min(pointsLon - static_cast<double>(icol), 1.0)};
+
+      // Get the elevations at each corner
+      double elevSW{}, elevNW{}, elevSE{}, elevNE{};
+      if ( !post(&elevSW, irow,   icol)   ||
+           !post(&elevNW, irow+1, icol)   ||
+           !post(&elevSE, irow,   icol+1) ||
+           !post(&elevNE, irow+1, icol+1) ) return false;
+
+      // Interpolate the west point
+      const double westPoint {elevSW + (elevNW - elevSW) * deltaLat};
+
+      // Interpolate the east point
+      const double eastPoint {elevSE + (elevNE - elevSE) * deltaLat};
+
+      // Interpolate between the west and east points
+      *elev = westPoint + (eastPoint - westPoint) * deltaLon;
+      return true;
+   }
+
+   // No -- just use the nearest post
+   return post(elev, static_cast<unsigned int>(pointsLat + 0.5), static_cast<unsigned int>(pointsLon + 0.5));
+}
+
+//------------------------------------------------------------------------------
+// Finds the nearest (non-void) post to a point from the highest priority tile
+// that contains the point, other than tile 'skip'
+//------------------------------------------------------------------------------
+bool TileMosaic::findPost(double* const elev, const double lat, const double lon, const Tile* const skip) const
+{
+   const std::vector<unsigned int>* cell {findCell(lat + EDGE_EPS, lon + EDGE_EPS)};
+   if (cell == nullptr) return false;
+
+   for (const unsigned int idx : *cell) {
+      const Tile& t {tiles[idx]};
+      if ( &t != skip &&
+           lat >= (t.swLat - EDGE_EPS) && lat <= (t.neLat + EDGE_EPS) &&
+           lon >= (t.swLon - EDGE_EPS) && lon <= (t.neLon + EDGE_EPS) ) {
+         const double pointsLat {std::max((lat - t.swLat) / t.latSpacing, 0.0)};
+         const double pointsLon {std::max((lon - t.swLon) / t.lonSpacing, 0.0)};
+         const unsigned int irow {std::min(static_cast<unsigned int>(pointsLat + 0.5), t.nptlat - 1)};
+         const unsigned int icol {std::min(static_cast<unsigned int>(pointsLon + 0.5), t.nptlong - 1)};
+         if (getPost(elev, t, irow, icol)) return true;
+      }
+   }
+   return false;
+}
+
+// Tile post [irow icol]; returns false if the post is void
+bool TileMosaic::getPost(double* const elev, const Tile& t, const unsigned int irow, const unsigned int icol) const
+{
+   const short* const column {t.file->getColumn(icol)};
+   if (column == nullptr || irow >= t.nptlat || column[irow] == t.voidValue) return false;
+   *elev = static_cast<double>(column[irow]);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Orders and indexes the tiles
+//------------------------------------------------------------------------------
+void TileMosaic::buildIndex()
+{
+   // Clear out the old index
+   clearData();
+
+   // Our tiles: the component tiles, followed by the scanned tiles
+   std::vector<const DataFile*> files;
+   {
+      base::PairStream* subcomponents {getComponents()};
+      if (subcomponents != nullptr) {
+         base::List::Item* item {subcomponents->getFirstItem()};
+         while (item != nullptr) {
+            const auto pair = static_cast<base::Pair*>( item->getValue() );
+            const auto dataFile = dynamic_cast<const DataFile*>( pair->object() );
+            if (dataFile != nullptr && dataFile->isDataLoaded()) {
+               files.push_back(dataFile);
+            }
+            else if (isMessageEnabled(MSG_WARNING)) {
+               std::cerr << "TileMosaic::buildIndex(): component '" << pair->slot() << "' isn't a loaded DataFile; ignored." << std::endl;
+            }
+            item = item->getNext();
+         }
+         subcomponents->unref();
+         subcomponents = nullptr;
+      }
+   }
+   for (const DataFile* dataFile : scanned) {
+      if (dataFile->isDataLoaded()) files.push_back(dataFile);
+   }
+
+   // Priority order (the sort is stable, so equal spacings keep their order)
+   if (overlap == Overlap::FINEST) {
+      std::stable_sort(files.begin(), files.end(),
+         [](const DataFile* a, const DataFile* b) {
+            return (a->getLatSpacing() * a->getLonSpacing()) < (b->getLatSpacing() * b->getLonSpacing());
+         }
+      );
+   }
+
+   double elevMin {999999.0};
+   double elevMax {-999999.0};
+   double lowerLat {90.0};
+   double lowerLon {180.0};
+   double upperLat {-90.0};
+   double upperLon {-180.0};
+
+   maxSpacing = 0;
+   for (const DataFile* dataFile : files) {
+      Tile t;
+      t.file = dataFile;
+      t.nptlat = dataFile->getNumLatPoints();
+      t.nptlong = dataFile->getNumLonPoints();
+      t.latSpacing = dataFile->getLatSpacing();
+      t.lonSpacing = dataFile->getLonSpacing();
+      t.swLat = dataFile->getLatitudeSW();
+      t.swLon = dataFile->getLongitudeSW();
+      t.neLat = t.swLat + static_cast<double>(t.nptlat - 1) * t.latSpacing;
+      t.neLon = t.swLon + static_cast<double>(t.nptlong - 1) * t.lonSpacing;
+      t.voidValue = dataFile->getVoidValue();
+      if (t.nptlat < 2 || t.nptlong < 2 || t.latSpacing <= 0 || t.lonSpacing <= 0) continue;
+
+      maxSpacing = std::max(maxSpacing, std::max(t.latSpacing, t.lonSpacing));
+
+      dataFile->ref();
+      const auto idx = static_cast<unsigned int>(tiles.size());
+      tiles.push_back(t);
+
+      // Add the tile to each cell that it covers, including the cells within
+      // one post spacing of its last posts (see lookup())
+      const int lat0 {std::max(static_cast<int>(std::floor(t.swLat)), -90)};
+      const int lat1 {std::min(static_cast<int>(std::floor(t.neLat + t.latSpacing)), 89)};
+      const int lon0 {std::max(static_cast<int>(std::floor(t.swLon)), -180)};
+      const int lon1 {std::min(static_cast<int>(std::floor(t.neLon + t.lonSpacing)), 179)};
+      for (int ilat = lat0; ilat <= lat1; ilat++) {
+         for (int ilon = lon0; ilon <= lon1; ilon++) {
+            cells[cellKey(ilat, ilon)].push_back(idx);
+         }
+      }
+
+      if (dataFile->getMinElevation() < elevMin) elevMin = dataFile->getMinElevation();
+      if (dataFile->getMaxElevation() > elevMax) elevMax = dataFile->getMaxElevation();
+      if (t.swLat < lowerLat) lowerLat = t.swLat;
+      if (t.swLon < lowerLon) lowerLon = t.swLon;
+      if (t.neLat > upperLat) upperLat = t.neLat;
+      if (t.neLon > upperLon) upperLon = t.neLon;
+   }
+
+   if (!tiles.empty()) {
+      setMinElevation(elevMin);
+      setMaxElevation(elevMax);
+      setLatitudeSW(lowerLat);
+      setLongitudeSW(lowerLon);
+      setLatitudeNE(upperLat);
+      setLongitudeNE(upperLon);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Directory scan
+//------------------------------------------------------------------------------
+void TileMosaic::scanDirectory()
+{
+   clearScannedTiles();
+   scanDone = true;
+
+   if (!directory.empty()) {
+      scanPath(directory, 0);
+      if (scanned.empty() && isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TileMosaic::scanDirectory(): no tiles found in directory: " << directory << std::endl;
+      }
+   }
+}
+
+void TileMosaic::scanPath(const std::string& dir, const unsigned int depth)
+{
+   // Directory entries: file names and subdirectory names
+   std::vector<std::string> fileNames;
+   std::vector<std::string> dirNames;
+
+#if defined(WIN32)
+   WIN32_FIND_DATAA fd;
+   const std::string pattern {dir + "/*"};
+   HANDLE h {FindFirstFileA(pattern.c_str(), &fd)};
+   if (h != INVALID_HANDLE_VALUE) {
+      do {
+         const std::string name {fd.cFileName};
+         if (name == "." || name == "..") continue;
+         if ((fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) dirNames.push_back(name);
+         else fileNames.push_back(name);
+      } while (FindNextFileA(h, &fd));
+      FindClose(h);
+   }
+#else
+   DIR* d {opendir(dir.c_str())};
+   if (d != nullptr) {
+      struct dirent* entry {};
+      while ((entry = readdir(d)) != nullptr) {
+         const std::string name {entry->d_name};
+         if (name == "." || name == "..") continue;
+         struct stat st;
+         if (stat((dir + "/" + name).c_str(), &st) != 0) continue;
+         if (S_ISDIR(st.st_mode)) dirNames.push_back(name);
+         else if (S_ISREG(st.st_mode)) fileNames.push_back(name);
+      }
+      closedir(d);
+   }
+#endif
+   else if (isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "TileMosaic::scanPath(): ERROR, unable to open directory: " << dir << std::endl;
+   }
+
+   // Sorted, so the scan order (see 'overlap') doesn't depend on the file system
+   std::sort(fileNames.begin(), fileNames.end());
+   std::sort(dirNames.begin(), dirNames.end());
+
+   for (const std::string& name : fileNames) {
+      std::string ext;
+      const std::size_t dot {name.rfind('.')};
+      if (dot != std::string::npos) ext = name.substr(dot + 1);
+      std::transform(ext.begin(), ext.end(), ext.begin(), [](const char c) { return static_cast<char>(std::tolower(c)); });
+
+      DataFile* tile{};
+      if (ext == "dt0" || ext == "dt1" || ext == "dt2") tile = new DtedFile();
+      else if (ext == "hgt") tile = new SrtmHgtFile();
+      else if (ext == "ded") tile = new DedFile();
+
+      if (tile != nullptr) {
+         tile->container(this);
+         tile->setPathname(new base::String(dir.c_str()));
+         tile->setFilename(new base::String(name.c_str()));
+         tile->reset();
+         if (tile->isDataLoaded()) {
+            scanned.push_back(tile);
+         }
+         else {
+            tile->unref();
+         }
+      }
+   }
+
+   if (recursive && depth < MAX_SCAN_DEPTH) {
+      for (const std::string& name : dirNames) {
+         scanPath(dir + "/" + name, depth + 1);
+      }
+   }
+}
+
+void TileMosaic::clearScannedTiles()
+{
+   for (DataFile* tile : scanned) {
+      tile->container(nullptr);
+      tile->unref();
+   }
+   scanned.clear();
+}
+
+//------------------------------------------------------------------------------
+// Load data
+//------------------------------------------------------------------------------
+bool TileMosaic::loadData()
+{
+   // We're not loading data -- our tiles will (see reset())
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// clear our index
+//------------------------------------------------------------------------------
+void TileMosaic::clearData()
+{
+   for (const Tile& t : tiles) {
+      t.file->unref();
+   }
+   tiles.clear();
+   cells.clear();
+   maxSpacing = 0;
+
+   setMinElevation(0);
+   setMaxElevation(0);
+   setLatitudeSW(0);
+   setLongitudeSW(0);
+   setLatitudeNE(0);
+   setLongitudeNE(0);
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool TileMosaic::setSlotDirectory(const base::String* const x)
+{
+   return setDirectory(x->c_str());
+}
+
+bool TileMosaic::setSlotRecursive(const base::Boolean* const x)
+{
+   return setRecursive(x->asBool());
+}
+
+// overlap: Overlap priority { finest, order }
+bool TileMosaic::setSlotOverlap(const base::Identifier* const x)
+{
+   bool ok{};
+   if (*x == "finest" || *x == "FINEST")     { setOverlap(Overlap::FINEST); ok = true; }
+   else if (*x == "order" || *x == "ORDER")  { setOverlap(Overlap::ORDER); ok = true; }
+   if (!ok && isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "TileMosaic::setSlotOverlap(): ERROR, invalid overlap: " << *x << "; use finest or order" << std::endl;
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,505 @@
+
+#include "mixr/terrain/Viewshed.hpp"
+
+#include "ViewshedThread.hpp"
+
+#include "mixr/terrain/Terrain.hpp"
+
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/units/lengths.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/constants.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(Viewshed, "Viewshed")
+
+BEGIN_SLOTTABLE(Viewshed)
+   "azimuths",       // 1) Number of azimuth sectors
+   "maxRange",       // 2) Max range of the sectors
+   "rangeStep",      // 3) Range between the sector's cells
+   "tolerance",      // 4) Position tolerance
+   "background",     // 5) Generate with a background thread
+END_SLOTTABLE(Viewshed)
+
+BEGIN_SLOT_MAP(Viewshed)
+   ON_SLOT(1, setSlotNumAzimuths,  base::Integer)
+   ON_SLOT(2, setSlotMaxRange,     base::Length)
+   ON_SLOT(3, setSlotRangeStep,    base::Length)
+   ON_SLOT(4, setSlotTolerance,    base::Length)
+   ON_SLOT(5, setSlotBackground,   base::Boolean)
+END_SLOT_MAP()
+
+Viewshed::Viewshed()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void Viewshed::copyData(const Viewshed& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   numAzimuths = org.numAzimuths;
+   maxRange = org.maxRange;
+   rangeStep = org.rangeStep;
+   tolerance = org.tolerance;
+   background = org.background;
+
+   // Our copy generates its own viewshed
+   table = Table();
+   ready = false;
+   pending = Table();
+   pendingTerrain = nullptr;
+   pendingBusy = false;
+   pendingDone = false;
+   thread = nullptr;
+}
+
+void Viewshed::deleteData()
+{
+   thread = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- our thread checks our shutdown flag
+//------------------------------------------------------------------------------
+bool Viewshed::shutdownNotification()
+{
+   const bool ok{BaseClass::shutdownNotification()};
+   ready = false;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool Viewshed::setNumAzimuths(const unsigned int v)
+{
+   bool ok{};
+   if (v >= 4) {
+      numAzimuths = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool Viewshed::setMaxRange(const double v)
+{
+   bool ok{};
+   if (v > 0) {
+      maxRange = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool Viewshed::setRangeStep(const double v)
+{
+   bool ok{};
+   if (v > 0) {
+      rangeStep = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool Viewshed::setTolerance(const double v)
+{
+   bool ok{};
+   if (v >= 0) {
+      tolerance = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool Viewshed::setBackground(const bool flg)
+{
+   background = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Generating a viewshed in the background?
+//------------------------------------------------------------------------------
+bool Viewshed::isGenerating() const
+{
+   base::lock(semaphore);
+   const bool busy{pendingBusy};
+   base::unlock(semaphore);
+   return busy;
+}
+
+//------------------------------------------------------------------------------
+// update() -- updates the viewshed for the sensor's position
+//------------------------------------------------------------------------------
+bool Viewshed::update(const Terrain* const terrain, const double lat, const double lon, const double alt)
+{
+   if (terrain == nullptr || !terrain->isDataLoaded() || isShutdown()) {
+      ready = false;
+      return false;
+   }
+
+   // Swap in a completed viewshed
+   base::lock(semaphore);
+   if (pendingDone) {
+      std::swap(table, pending);
+      pendingDone = false;
+      pendingBusy = false;
+   }
+   const bool busy{pendingBusy};
+   base::unlock(semaphore);
+
+   ready = (table.numAzimuths > 0 && isAtTable(table, lat, lon, alt));
+
+   // Generate a new viewshed
+   if (!ready && !busy) {
+      pending.lat = lat;
+      pending.lon = lon;
+      pending.alt = alt;
+      pending.rangeStep = rangeStep;
+      pending.numAzimuths = numAzimuths;
+      pending.numCells = static_cast<unsigned int>(std::ceil(maxRange / rangeStep));
+      if (pending.numCells < 1) pending.numCells = 1;
+      pending.terrain = terrain;
+      pendingTerrain = terrain;
+
+      bool started{};
+      if (background) {
+         // Set busy before the start; the thread can finish before start() returns
+         pendingBusy = true;
+         thread = new ViewshedThread(this);
+         thread->unref(); // 'thread' is a safe_ptr<>
+         started = thread->start(0);
+         if (!started) {
+            pendingBusy = false;
+            thread = nullptr;
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "Viewshed::update(): ERROR, failed to create the thread; generating the viewshed now" << std::endl;
+            }
+         }
+      }
+
+      if (!started) {
+         generate(terrain, &pending);
+         std::swap(table, pending);
+         ready = true;
+      }
+   }
+
+   return ready;
+}
+
+//------------------------------------------------------------------------------
+// Generates the table from the terrain's elevation bounds (see Note 2)
+//------------------------------------------------------------------------------
+void Viewshed::generate(const Terrain* const terrain, Table* const tbl) const
+{
+   // Points of the profiles are more than 100 meters apart, and at most
+   // 175 meters apart, or 1/1199th of their range past 120 km (see
+   // Terrain::targetOcculting())
+   static const double MIN_SPACING = 100.0;
+   static const double MAX_SPACING = 175.0;
+   static const double MAX_POINTS = 1200.0;
+
+   const unsigned int nc{tbl->numCells};
+   const double step{tbl->rangeStep};
+   const double spacing{std::max(MAX_SPACING, (nc * step) / (MAX_POINTS - 1))};
+   tbl->window = static_cast<unsigned int>(std::ceil(spacing / step));
+
+   tbl->maxTan.clear();
+   tbl->minTan.clear();
+   tbl->minWindow.clear();
+   if (tbl->lat < -89.0 || tbl->lat > 89.0) return;
+
+   const std::size_t size{static_cast<std::size_t>(tbl->numAzimuths) * nc};
+   tbl->maxTan.resize(size);
+   tbl->minTan.resize(size);
+   tbl->minWindow.resize(size);
+
+   // Flat earth degrees per meter (same as Terrain::computeProfileSteps())
+   const double latPerM{base::length::M2NM / 60.0};
+   const double lonPerM{latPerM / std::cos(tbl->lat * base::angle::D2RCC)};
+
+   // A sector's arc bulges past the chord between its corners by this
+   // fraction of its range
+   const double dAz{(360.0 / tbl->numAzimuths) * base::angle::D2RCC};
+   const double sagitta{1.0 - std::cos(dAz / 2.0)};
+
+   const std::unique_ptr<double[]> cellMin(new double[nc]);
+   const std::unique_ptr<double[]> cellMax(new double[nc]);
+
+   for (unsigned int iaz = 0; iaz < tbl->numAzimuths && isNotShutdown(); iaz++) {
+      const double cos0{std::cos(dAz * iaz)};
+      const double sin0{std::sin(dAz * iaz)};
+      const double cos1{std::cos(dAz * (iaz + 1))};
+      const double sin1{std::sin(dAz * (iaz + 1))};
+
+      // Elevation bounds of each cell: the lat/lon box of its corners,
+      // plus its arc's bulge and a meter
+      for (unsigned int c = 0; c < nc; c++) {
+         const double r0{c * step};
+         const double r1{(c + 1) * step};
+         const double pad{r1 * sagitta + 1.0};
+         const double minN{std::min(std::min(r0 * cos0, r0 * cos1), std::min(r1 * cos0, r1 * cos1)) - pad};
+         const double maxN{std::max(std::max(r0 * cos0, r0 * cos1), std::max(r1 * cos0, r1 * cos1)) + pad};
+         const double minE{std::min(std::min(r0 * sin0, r0 * sin1), std::min(r1 * sin0, r1 * sin1)) - pad};
+         const double maxE{std::max(std::max(r0 * sin0, r0 * sin1), std::max(r1 * sin0, r1 * sin1)) + pad};
+         if (!terrain->getElevationBounds(&cellMin[c], &cellMax[c],
+                                          tbl->lat + minN * latPerM, tbl->lon + minE * lonPerM,
+                                          tbl->lat + maxN * latPerM, tbl->lon + maxE * lonPerM)) {
+            // No bounds; all of the checks are the terrain's
+            tbl->maxTan.clear();
+            tbl->minTan.clear();
+            tbl->minWindow.clear();
+            return;
+         }
+      }
+
+      const std::size_t idx0{static_cast<std::size_t>(iaz) * nc};
+
+      // Running max of the upper bounds of the tangents to the cells' points;
+      // the cells without data are skipped
+      double maxTan{std::numeric_limits<double>::lowest()};
+      for (unsigned int c = 0; c < nc; c++) {
+         if (cellMin[c] <= cellMax[c]) {
+            const double dz{cellMax[c] - tbl->alt};
+            const double rng{(dz >= 0) ? std::max(c * step, MIN_SPACING) : ((c + 1) * step)};
+            const double tstTan{dz / rng};
+            if (tstTan > maxTan) maxTan = tstTan;
+         }
+         tbl->maxTan[idx0 + c] = maxTan;
+      }
+
+      // Running max of the lower bounds of the tangents to the windows of
+      // cells [ c .. c+window-1 ]; the windows with a cell without data are
+      // skipped
+      float minTan{std::numeric_limits<float>::lowest()};
+      unsigned int minWindow{};
+      for (unsigned int c = 0; c < nc; c++) {
+         if (c >= 1 && (c + tbl->window) <= nc) {
+            double minW{std::numeric_limits<double>::max()};
+            bool valid{true};
+            for (unsigned int k = c; k < (c + tbl->window) && valid; k++) {
+               valid = (cellMin[k] <= cellMax[k]);
+               if (cellMin[k] < minW) minW = cellMin[k];
+            }
+            if (valid) {
+               const double dz{minW - tbl->alt};
+               const double rng{(dz >= 0) ? ((c + tbl->window) * step) : (c * step)};
+               const float tstTan{static_cast<float>(dz / rng)};
+               if (tstTan > minTan) {
+                  minTan = tstTan;
+                  minWindow = c;
+               }
+            }
+         }
+         tbl->minTan[idx0 + c] = minTan;
+         tbl->minWindow[idx0 + c] = minWindow;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Table helpers
+//------------------------------------------------------------------------------
+
+// Is the sensor position within tolerance of the table's position?
+bool Viewshed::isAtTable(const Table& tbl, const double lat, const double lon, const double alt) const
+{
+   double brg{}, distNM{};
+   base::nav::fll2bd(tbl.lat, tbl.lon, lat, lon, &brg, &distNM);
+   return (distNM * base::length::NM2M) <= tolerance && std::fabs(alt - tbl.alt) <= tolerance;
+}
+
+// Index of the table's cell at 'range' (meters)
+unsigned int Viewshed::cellIndex(const double range) const
+{
+   unsigned int idx{};
+   if (range > 0) {
+      const double c{range / table.rangeStep};
+      idx = (c < table.numCells) ? static_cast<unsigned int>(c) : (table.numCells - 1);
+   }
+   return idx;
+}
+
+// Index of the azimuth sector of 'truBrg' (degs)
+unsigned int Viewshed::sectorIndex(const double truBrg) const
+{
+   double brg{std::fmod(truBrg, 360.0)};
+   if (brg < 0) brg += 360.0;
+   unsigned int iaz{static_cast<unsigned int>(brg * table.numAzimuths / 360.0)};
+   if (iaz >= table.numAzimuths) iaz = table.numAzimuths - 1;
+   return iaz;
+}
+
+// Checks the look angle, over range 'dist' (meters) on the true bearing
+// 'truBrg' (degs), against the table (see Note 3); returns false if the
+// table doesn't decide it
+bool Viewshed::checkTable(const double truBrg, const double dist, const double tanLookAng, bool* const occulted) const
+{
+   static const unsigned int MAX_POINTS = 1200;
+
+   if (table.maxTan.empty() || dist > (table.numCells * table.rangeStep)) return false;
+
+   // The profile's points (same as Terrain::targetOcculting())
+   unsigned int n{static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+   if (n > MAX_POINTS) n = MAX_POINTS;
+   if (n < 3) {
+      // no points between the end points
+      *occulted = false;
+      return true;
+   }
+   const double spacing{dist / (n - 1)};
+   const double lastRng{spacing * (n - 2)};
+   const std::size_t idx0{static_cast<std::size_t>(sectorIndex(truBrg)) * table.numCells};
+
+   // Visible: above the terrain's max tangent out to the last point, with a
+   // margin for the round off of the point by point check
+   const double maxTan{table.maxTan[idx0 + cellIndex(lastRng)]};
+   if (tanLookAng > (maxTan + 1.0e-9 * (1.0 + std::fabs(maxTan)))) {
+      *occulted = false;
+      return true;
+   }
+
+   // Occulted: at or below the min tangent of a window that ends before the
+   // last point, and the profile's point within the window occults it
+   const double jmax{std::floor(lastRng / table.rangeStep) - table.window};
+   if (jmax >= 1.0) {
+      const std::size_t j{idx0 + static_cast<unsigned int>(jmax)};
+      if (tanLookAng <= table.minTan[j]) {
+         const unsigned int k{static_cast<unsigned int>(std::ceil(table.minWindow[j] * table.rangeStep / spacing))};
+         if (k >= 1 && k <= (n - 2)) {
+            double deltaLat{}, deltaLon{};
+            Terrain::computeProfileSteps(&deltaLat, &deltaLon, n, table.lat, truBrg, dist);
+            double elev{};
+            if (table.terrain->getElevation(&elev, table.lat + deltaLat * k, table.lon + deltaLon * k, false)) {
+               const double currentRange{spacing * k};
+               const double tstTan{(elev - table.alt) / currentRange};
+               if (tstTan >= tanLookAng) {
+                  *occulted = true;
+                  return true;
+               }
+            }
+         }
+      }
+   }
+
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// Table lookups
+//------------------------------------------------------------------------------
+double Viewshed::getMinVisibleElevation(const double truBrg, const double range) const
+{
+   double angle{-base::PI / 2.0};
+   if (ready && !table.maxTan.empty() && range > 0) {
+      const double maxTan{table.maxTan[static_cast<std::size_t>(sectorIndex(truBrg)) * table.numCells + cellIndex(range)]};
+      if (maxTan > std::numeric_limits<double>::lowest()) angle = std::atan(maxTan);
+   }
+   return angle;
+}
+
+bool Viewshed::isOcculted(const double truBrg, const double dist, const double tanLookAng) const
+{
+   bool occulted{};
+   if (ready && dist > 0) {
+      if (!checkTable(truBrg, dist, tanLookAng, &occulted)) {
+         occulted = table.terrain->targetOcculting2(table.lat, table.lon, table.alt, truBrg, dist, tanLookAng);
+      }
+   }
+   return occulted;
+}
+
+bool Viewshed::isTargetOcculted(const double tgtLat, const double tgtLon, const double tgtAlt) const
+{
+   bool occulted{};
+   if (ready) {
+      // Compute bearing and distance to target (flat earth; same as Terrain::targetOcculting())
+      double brgDeg{}, distNM{};
+      base::nav::fll2bd(table.lat, table.lon, tgtLat, tgtLon, &brgDeg, &distNM);
+      const double dist{distNM * base::length::NM2M};
+      if (dist > 0) {
+         const double tgtTan{(tgtAlt - table.alt) / dist};
+         if (!checkTable(brgDeg, dist, tgtTan, &occulted)) {
+            occulted = table.terrain->targetOcculting(table.lat, table.lon, table.alt, tgtLat, tgtLon, tgtAlt);
+         }
+      }
+   }
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool Viewshed::setSlotNumAzimuths(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v > 0) ok = setNumAzimuths(static_cast<unsigned int>(v));
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Viewshed::setSlotNumAzimuths(): invalid number of azimuths: " << v << "; use 4 or more" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Viewshed::setSlotMaxRange(const base::Length* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setMaxRange(msg->getValueInMeters());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Viewshed::setSlotMaxRange(): max range must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Viewshed::setSlotRangeStep(const base::Length* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setRangeStep(msg->getValueInMeters());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Viewshed::setSlotRangeStep(): range step must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Viewshed::setSlotTolerance(const base::Length* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setTolerance(msg->getValueInMeters());
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Viewshed::setSlotTolerance(): tolerance must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Viewshed::setSlotBackground(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setBackground(msg->asBool());
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,32 @@
+
+#include "ViewshedThread.hpp"
+
+#include "mixr/terrain/Viewshed.hpp"
+
+#include "mixr/base/Component.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+namespace mixr {
+namespace terrain {
+
+ViewshedThread::ViewshedThread(base::Component* const parent): base::OneShotThread(parent)
+{
+}
+
+unsigned long ViewshedThread::userFunc()
+{
+   Viewshed* viewshed{static_cast<Viewshed*>(getParent())};
+
+   // Generate the pending viewshed ...
+   viewshed->generate(viewshed->pendingTerrain, &viewshed->pending);
+
+   // ... and let our viewshed know that it's complete
+   base::lock(viewshed->semaphore);
+   viewshed->pendingDone = true;
+   base::unlock(viewshed->semaphore);
+
+   return 0;
+}
+
+}
+}
@@ -0,0 +1,27 @@
+
+#ifndef __mixr_terrain_ViewshedThread_HPP__
+#define __mixr_terrain_ViewshedThread_HPP__
+
+#include "mixr/base/threads/OneShotThread.hpp"
+
+namespace mixr {
+namespace base { class Component; }
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: ViewshedThread
+// Description: Generates a viewshed in the background
+//------------------------------------------------------------------------------
+class ViewshedThread final : public base::OneShotThread
+{
+public:
+   ViewshedThread(base::Component* const parent);
+
+private:
+   unsigned long userFunc() final;
+};
+
+}
+}
+
+#endif
@@ -3,7 +3,11 @@
 
 #include "mixr/base/Object.hpp"
 
+#include "mixr/terrain/LosService.hpp"
 #include "mixr/terrain/QuadMap.hpp"
+#include "mixr/terrain/RasterService.hpp"
+#include "mixr/terrain/TileMosaic.hpp"
+#include "mixr/terrain/Viewshed.hpp"
 #include "mixr/terrain/ded/DedFile.hpp"
 #include "mixr/terrain/dted/DtedFile.hpp"
 #include "mixr/terrain/srtm/SrtmHgtFile.hpp"
@@ -20,6 +24,18 @@ base::Object* factory(const std::string& name)
     if ( name == QuadMap::getFactoryName() ) {
         obj = new QuadMap();
     }
+    else if ( name == TileMosaic::getFactoryName() ) {
+        obj = new TileMosaic();
+    }
+    else if ( name == LosService::getFactoryName() ) {
+        obj = new LosService();
+    }
+    else if ( name == RasterService::getFactoryName() ) {
+        obj = new RasterService();
+    }
+    else if ( name == Viewshed::getFactoryName() ) {
+        obj = new Viewshed();
+    }
     else if ( name == DedFile::getFactoryName() ) {
         obj = new DedFile();
     }
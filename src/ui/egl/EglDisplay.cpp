@@ -0,0 +1,279 @@
+
+#include "mixr/ui/egl/EglDisplay.hpp"
+
+#include "mixr/graphics/Image.hpp"
+
+#include "mixr/base/numeric/Boolean.hpp"
+
+#include <cstring>
+#include <map>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace mixr {
+namespace egl {
+
+// Number of our instances using each initialized EGL display (see note #5)
+static std::map<EGLDisplay, int> eglDisplayRefs;
+
+IMPLEMENT_SUBCLASS(EglDisplay, "EglDisplay")
+
+BEGIN_SLOTTABLE(EglDisplay)
+   "stencilBuff",          // 1) Enable the stencil buffer (default: false)
+   "coreProfile",          // 2) Create a core profile context (default: false)
+END_SLOTTABLE(EglDisplay)
+
+BEGIN_SLOT_MAP(EglDisplay)
+   ON_SLOT(1, setSlotStencilBuff, base::Boolean)
+   ON_SLOT(2, setSlotCoreProfile, base::Boolean)
+END_SLOT_MAP()
+
+EglDisplay::EglDisplay()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void EglDisplay::copyData(const EglDisplay& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // Our copy creates its own surface
+   destroySurface();
+
+   stencilBuff = org.stencilBuff;
+   coreProfile = org.coreProfile;
+}
+
+void EglDisplay::deleteData()
+{
+   destroySurface();
+}
+
+//-----------------------------------------------------------------------------
+// shutdownNotification() -- release the surface and context
+//-----------------------------------------------------------------------------
+bool EglDisplay::shutdownNotification()
+{
+   destroySurface();
+   return BaseClass::shutdownNotification();
+}
+
+//-----------------------------------------------------------------------------
+// createWindow() -- create the offscreen surface and context
+//-----------------------------------------------------------------------------
+bool EglDisplay::createWindow()
+{
+   destroySurface();
+
+   if (isSubdisplay()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): subdisplays are not supported" << std::endl;
+      }
+      return false;
+   }
+
+   GLsizei vpWidth{}, vpHeight{};
+   getViewportSize(&vpWidth, &vpHeight);
+   if (vpWidth < 1 || vpHeight < 1) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): invalid viewport size: " << vpWidth << " x " << vpHeight << std::endl;
+      }
+      return false;
+   }
+
+   // ---
+   // EGL display: Mesa's surfaceless platform, if available (see note #2)
+   // ---
+   EGLDisplay dpy{EGL_NO_DISPLAY};
+   const char* const ext{eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS)};
+   if (ext != nullptr && std::strstr(ext, "EGL_MESA_platform_surfaceless") != nullptr) {
+      const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+      if (getPlatformDisplay != nullptr) {
+         dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+      }
+   }
+   if (dpy == EGL_NO_DISPLAY) dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+   EGLint major{}, minor{};
+   if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor)) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): unable to initialize EGL; error = 0x" << std::hex << eglGetError() << std::dec << std::endl;
+      }
+      return false;
+   }
+   eglDisplayRefs[dpy]++;
+   eglDpy = dpy;
+
+   // ---
+   // Frame buffer configuration
+   // ---
+   const EGLint depthSize{getClearDepth() >= 0.0 ? 24 : 0};
+   const EGLint stencilSize{stencilBuff ? 8 : 0};
+   const EGLint configAttribs[] = {
+      EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+      EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+      EGL_RED_SIZE,        8,
+      EGL_GREEN_SIZE,      8,
+      EGL_BLUE_SIZE,       8,
+      EGL_ALPHA_SIZE,      8,
+      EGL_DEPTH_SIZE,      depthSize,
+      EGL_STENCIL_SIZE,    stencilSize,
+      EGL_NONE
+   };
+   EGLConfig config{};
+   EGLint numConfigs{};
+   if (!eglChooseConfig(dpy, configAttribs, &config, 1, &numConfigs) || numConfigs < 1) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): no matching frame buffer configuration" << std::endl;
+      }
+      destroySurface();
+      return false;
+   }
+
+   // ---
+   // Surface (see note #1) and context
+   // ---
+   const EGLint w{((vpWidth + 3) / 4) * 4};
+   const EGLint h{vpHeight};
+   const EGLint surfaceAttribs[] = { EGL_WIDTH, w, EGL_HEIGHT, h, EGL_NONE };
+   const EGLSurface surf{eglCreatePbufferSurface(dpy, config, surfaceAttribs)};
+   if (surf == EGL_NO_SURFACE) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): unable to create the surface; error = 0x" << std::hex << eglGetError() << std::dec << std::endl;
+      }
+      destroySurface();
+      return false;
+   }
+
+   eglBindAPI(EGL_OPENGL_API);
+   const EGLint coreAttribs[] = {
+      EGL_CONTEXT_MAJOR_VERSION,          3,
+      EGL_CONTEXT_MINOR_VERSION,          3,
+      EGL_CONTEXT_OPENGL_PROFILE_MASK,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+      EGL_NONE
+   };
+   const EGLContext ctx{eglCreateContext(dpy, config, EGL_NO_CONTEXT, (coreProfile ? coreAttribs : nullptr))};
+   if (ctx == EGL_NO_CONTEXT || !eglMakeCurrent(dpy, surf, surf, ctx)) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "EglDisplay::createWindow(): unable to create the context; error = 0x" << std::hex << eglGetError() << std::dec << std::endl;
+      }
+      if (ctx != EGL_NO_CONTEXT) eglDestroyContext(dpy, ctx);
+      eglDestroySurface(dpy, surf);
+      destroySurface();
+      return false;
+   }
+
+   surface = surf;
+   context = ctx;
+   surfaceWidth = w;
+   surfaceHeight = h;
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "EglDisplay::createWindow() name = " << getName() << ", size = " << w << " x " << h;
+      std::cout << ", renderer = " << glGetString(GL_RENDERER) << std::endl;
+   }
+
+   configure();
+   loadTextures();
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// destroySurface() -- release the surface and context, and the EGL display
+//-----------------------------------------------------------------------------
+void EglDisplay::destroySurface()
+{
+   if (eglDpy != nullptr) {
+      const EGLDisplay dpy{static_cast<EGLDisplay>(eglDpy)};
+      if (eglGetCurrentContext() == static_cast<EGLContext>(context)) {
+         eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+      }
+      if (context != nullptr) eglDestroyContext(dpy, static_cast<EGLContext>(context));
+      if (surface != nullptr) eglDestroySurface(dpy, static_cast<EGLSurface>(surface));
+      if (--eglDisplayRefs[dpy] <= 0) {
+         eglDisplayRefs.erase(dpy);
+         eglTerminate(dpy);
+      }
+   }
+   eglDpy = nullptr;
+   surface = nullptr;
+   context = nullptr;
+   surfaceWidth = 0;
+   surfaceHeight = 0;
+}
+
+//------------------------------------------------------------------------------
+// select() -- select this display
+//------------------------------------------------------------------------------
+void EglDisplay::select()
+{
+   if (context != nullptr && eglGetCurrentContext() != static_cast<EGLContext>(context)) {
+      eglMakeCurrent(static_cast<EGLDisplay>(eglDpy), static_cast<EGLSurface>(surface), static_cast<EGLSurface>(surface), static_cast<EGLContext>(context));
+   }
+   BaseClass::select();
+}
+
+//------------------------------------------------------------------------------
+// swapBuffers() -- the pbuffer is single buffered; wait for the rendering
+//------------------------------------------------------------------------------
+void EglDisplay::swapBuffers()
+{
+   if (context != nullptr) glFinish();
+}
+
+//------------------------------------------------------------------------------
+// renderFrame() -- one frame of the display cycle
+//------------------------------------------------------------------------------
+void EglDisplay::renderFrame(const double dt)
+{
+   if (context == nullptr) return;
+
+   updateTC(dt);
+   updateData(dt);
+   drawIt();
+}
+
+//------------------------------------------------------------------------------
+// writeFrame() -- write the current frame to a bitmap file
+//------------------------------------------------------------------------------
+bool EglDisplay::writeFrame(const char* const filename, const char* const path)
+{
+   bool ok{};
+   if (context != nullptr) {
+      select();
+      graphics::Image* image{readFrameBuffer()};
+      if (image != nullptr) {
+         ok = image->writeFileBMP(filename, path);
+         image->unref();
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool EglDisplay::setSlotStencilBuff(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      stencilBuff = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
+bool EglDisplay::setSlotCoreProfile(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      coreProfile = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
+}
+}
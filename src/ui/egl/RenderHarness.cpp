@@ -0,0 +1,404 @@
+
+#include "mixr/ui/egl/RenderHarness.hpp"
+
+#include "mixr/ui/egl/EglDisplay.hpp"
+
+#include "mixr/graphics/Image.hpp"
+
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Number.hpp"
+
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+namespace mixr {
+namespace egl {
+
+IMPLEMENT_SUBCLASS(RenderHarness, "RenderHarness")
+
+BEGIN_SLOTTABLE(RenderHarness)
+   "display",              //  1) Offscreen display
+   "pages",                //  2) Names of the display's subpages
+   "frames",               //  3) Number of timed frames per page
+   "warmupFrames",         //  4) Number of frames before the timed frames
+   "frameRate",            //  5) Frame rate (Hz)
+   "goldenPath",           //  6) Directory of the golden images
+   "outputPath",           //  7) Directory of the rendered frames
+   "tolerance",            //  8) Max difference of a color component
+   "maxBadPixels",         //  9) Max ratio of bad pixels
+   "updateGolden",         // 10) Write the golden images
+END_SLOTTABLE(RenderHarness)
+
+BEGIN_SLOT_MAP(RenderHarness)
+   ON_SLOT( 1, setSlotDisplay,      EglDisplay)
+   ON_SLOT( 2, setSlotPages,        base::PairStream)
+   ON_SLOT( 3, setSlotFrames,       base::Integer)
+   ON_SLOT( 4, setSlotWarmupFrames, base::Integer)
+   ON_SLOT( 5, setSlotFrameRate,    base::Number)
+   ON_SLOT( 6, setSlotGoldenPath,   base::String)
+   ON_SLOT( 7, setSlotOutputPath,   base::String)
+   ON_SLOT( 8, setSlotTolerance,    base::Integer)
+   ON_SLOT( 9, setSlotMaxBadPixels, base::Number)
+   ON_SLOT(10, setSlotUpdateGolden, base::Boolean)
+END_SLOT_MAP()
+
+RenderHarness::RenderHarness()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void RenderHarness::copyData(const RenderHarness& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   if (display != nullptr) display->unref();
+   display = nullptr;
+   if (org.display != nullptr) {
+      display = org.display->clone();
+   }
+
+   pages = org.pages;
+   frames = org.frames;
+   warmupFrames = org.warmupFrames;
+   frameRate = org.frameRate;
+   goldenPath = org.goldenPath;
+   outputPath = org.outputPath;
+   tolerance = org.tolerance;
+   maxBadPixels = org.maxBadPixels;
+   updateGolden = org.updateGolden;
+
+   results.clear();
+}
+
+void RenderHarness::deleteData()
+{
+   if (display != nullptr) display->unref();
+   display = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// reset() -- reset the display (it's not one of our components)
+//------------------------------------------------------------------------------
+void RenderHarness::reset()
+{
+   if (display != nullptr) display->reset();
+   BaseClass::reset();
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- shut down the display
+//------------------------------------------------------------------------------
+bool RenderHarness::shutdownNotification()
+{
+   if (display != nullptr) display->event(SHUTDOWN_EVENT);
+   return BaseClass::shutdownNotification();
+}
+
+//------------------------------------------------------------------------------
+// run() -- renders the pages
+//------------------------------------------------------------------------------
+unsigned int RenderHarness::run()
+{
+   results.clear();
+
+   if (display == nullptr) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::run(): display is not set" << std::endl;
+      }
+      return 1;
+   }
+   if (!display->isCreated() && !display->createWindow()) {
+      return 1;
+   }
+
+   unsigned int numFailed{};
+   if (pages.empty()) {
+      Result result;
+      if (!runPage("display", false, &result)) numFailed++;
+      results.push_back(result);
+   } else {
+      for (const std::string& page : pages) {
+         Result result;
+         if (!runPage(page, true, &result)) numFailed++;
+         results.push_back(result);
+      }
+   }
+
+   // ---
+   // Report
+   // ---
+   std::cout << "RenderHarness: " << display->getSurfaceWidth() << " x " << display->getSurfaceHeight();
+   std::cout << ", " << frames << " frames per page (ms)" << std::endl;
+   std::cout << std::left << std::setw(24) << "page" << std::right;
+   std::cout << std::setw(10) << "avg" << std::setw(10) << "min" << std::setw(10) << "max";
+   std::cout << std::setw(12) << "bad pixels" << "  result" << std::endl;
+   for (const Result& r : results) {
+      std::cout << std::left << std::setw(24) << r.page << std::right << std::fixed << std::setprecision(3);
+      std::cout << std::setw(10) << r.avgTime * 1000.0 << std::setw(10) << r.minTime * 1000.0 << std::setw(10) << r.maxTime * 1000.0;
+      std::cout << std::setw(12) << r.badPixels << "  ";
+      if (updateGolden) std::cout << "updated";
+      else if (!r.passed) std::cout << "FAILED";
+      else if (r.compared) std::cout << "passed";
+      else std::cout << "no golden";
+      std::cout << std::endl;
+   }
+   std::cout.unsetf(std::ios::floatfield);
+
+   return numFailed;
+}
+
+//------------------------------------------------------------------------------
+// runPage() -- renders one page
+//------------------------------------------------------------------------------
+bool RenderHarness::runPage(const std::string& page, const bool select, Result* const result)
+{
+   result->page = page;
+   result->passed = false;
+
+   if (select && !display->newSubpage(page, nullptr)) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::runPage(): page not found: " << page << std::endl;
+      }
+      return false;
+   }
+
+   const double dt{frameRate > 0 ? 1.0 / frameRate : 0};
+
+   // Warm up (the page change is made by the first frame's updateData())
+   const unsigned int numWarmup{warmupFrames > 0 ? warmupFrames : 1};
+   for (unsigned int i = 0; i < numWarmup; i++) {
+      display->renderFrame(dt);
+   }
+
+   // Timed frames
+   double sum{};
+   for (unsigned int i = 0; i < frames; i++) {
+      const double t0{base::getComputerTime()};
+      display->renderFrame(dt);
+      const double t{base::getComputerTime() - t0};
+      sum += t;
+      if (i == 0 || t < result->minTime) result->minTime = t;
+      if (i == 0 || t > result->maxTime) result->maxTime = t;
+   }
+   if (frames > 0) result->avgTime = sum / frames;
+
+   // ---
+   // The frame
+   // ---
+   display->select();
+   graphics::Image* const frame{display->readFrameBuffer()};
+   if (frame == nullptr) return false;
+   result->numPixels = frame->getWidth() * frame->getHeight();
+
+   const std::string filename{page + ".bmp"};
+   bool ok{true};
+
+   if (!outputPath.empty()) {
+      ok = frame->writeFileBMP(filename.c_str(), outputPath.c_str());
+   }
+
+   if (updateGolden) {
+      if (!frame->writeFileBMP(filename.c_str(), goldenPath.c_str())) ok = false;
+   } else if (!goldenPath.empty()) {
+      // A page without a golden image isn't compared
+      const std::ifstream test(goldenPath + "/" + filename);
+      if (test.good()) {
+         const auto golden = new graphics::Image();
+         if (golden->readFileBMP(filename.c_str(), goldenPath.c_str())) {
+            result->compared = true;
+            result->badPixels = compareImages(frame, golden);
+            if (result->badPixels > maxBadPixels * result->numPixels) ok = false;
+         } else {
+            ok = false;
+         }
+         golden->unref();
+      }
+   }
+
+   frame->unref();
+   result->passed = ok;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// compareImages() -- returns the number of bad pixels
+//------------------------------------------------------------------------------
+unsigned int RenderHarness::compareImages(const graphics::Image* const frame, const graphics::Image* const golden) const
+{
+   const unsigned int width{frame->getWidth()};
+   const unsigned int height{frame->getHeight()};
+   const unsigned int nc{frame->getNumComponents()};
+
+   // All pixels are bad when the images don't match
+   if (golden->getWidth() != width || golden->getHeight() != height || golden->getNumComponents() != nc ||
+       frame->getPixels() == nullptr || golden->getPixels() == nullptr) {
+      return width * height;
+   }
+
+   const GLubyte* p1{frame->getPixels()};
+   const GLubyte* p2{golden->getPixels()};
+   const int tol{static_cast<int>(tolerance)};
+   unsigned int bad{};
+   for (unsigned int i = 0; i < width * height; i++) {
+      bool same{true};
+      for (unsigned int j = 0; j < nc; j++) {
+         if (std::abs(static_cast<int>(p1[j]) - static_cast<int>(p2[j])) > tol) same = false;
+      }
+      if (!same) bad++;
+      p1 += nc;
+      p2 += nc;
+   }
+   return bad;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool RenderHarness::setSlotDisplay(EglDisplay* const msg)
+{
+   if (display != nullptr) display->unref();
+   display = msg;
+   if (display != nullptr) display->ref();
+   return true;
+}
+
+bool RenderHarness::setSlotPages(const base::PairStream* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      pages.clear();
+      ok = true;
+      const base::List::Item* item{msg->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto id = dynamic_cast<const base::Identifier*>(pair->object());
+         const auto str = dynamic_cast<const base::String*>(pair->object());
+         if (id != nullptr) pages.push_back(id->asString());
+         else if (str != nullptr) pages.push_back(str->c_str());
+         else {
+            ok = false;
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "RenderHarness::setSlotPages(): page names must be identifiers or strings" << std::endl;
+            }
+         }
+         item = item->getNext();
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotFrames(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 1) {
+         frames = static_cast<unsigned int>(v);
+         ok = true;
+      } else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::setSlotFrames(): frames must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotWarmupFrames(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 0) {
+         warmupFrames = static_cast<unsigned int>(v);
+         ok = true;
+      } else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::setSlotWarmupFrames(): warm up frames must not be negative" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotFrameRate(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const double v{msg->asDouble()};
+      if (v > 0) {
+         frameRate = v;
+         ok = true;
+      } else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::setSlotFrameRate(): frame rate must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotGoldenPath(const base::String* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      goldenPath = msg->c_str();
+      ok = true;
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotOutputPath(const base::String* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      outputPath = msg->c_str();
+      ok = true;
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotTolerance(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int v{msg->asInt()};
+      if (v >= 0 && v <= 255) {
+         tolerance = static_cast<unsigned int>(v);
+         ok = true;
+      } else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::setSlotTolerance(): tolerance must be [ 0 .. 255 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotMaxBadPixels(const base::Number* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const double v{msg->asDouble()};
+      if (v >= 0 && v <= 1.0) {
+         maxBadPixels = v;
+         ok = true;
+      } else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RenderHarness::setSlotMaxBadPixels(): ratio must be [ 0 .. 1 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RenderHarness::setSlotUpdateGolden(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      updateGolden = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
+}
+}
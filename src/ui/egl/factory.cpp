@@ -0,0 +1,29 @@
+
+#include "mixr/ui/egl/factory.hpp"
+
+#include "mixr/base/Object.hpp"
+
+#include "mixr/ui/egl/EglDisplay.hpp"
+#include "mixr/ui/egl/RenderHarness.hpp"
+
+#include <string>
+
+namespace mixr {
+namespace egl {
+
+base::Object* factory(const std::string& name)
+{
+    base::Object* obj {};
+
+    if ( name == EglDisplay::getFactoryName() ) {
+      obj = new EglDisplay();
+    }
+    else if ( name == RenderHarness::getFactoryName() ) {
+      obj = new RenderHarness();
+    }
+
+    return obj;
+}
+
+}
+}
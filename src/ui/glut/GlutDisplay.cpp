@@ -1,6 +1,9 @@
 
 #include "mixr/ui/glut/GlutDisplay.hpp"
 
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Renderer.hpp"
+
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/numeric/Number.hpp"
@@ -42,6 +45,7 @@ BEGIN_SLOTTABLE(GlutDisplay)
    "pickHeight",           // 5) Height of the pick area (default: 10)
    "accumBuff",            // 6) Enable the accumulation buffer (default: false)
    "stencilBuff",          // 7) Enable the stencil buffer (default: false)
+   "selectBufferPick",     // 8) Always pick by drawing the whole display in GL_SELECT mode (default: false)
 END_SLOTTABLE(GlutDisplay)
 
 BEGIN_SLOT_MAP(GlutDisplay)
@@ -52,6 +56,7 @@ BEGIN_SLOT_MAP(GlutDisplay)
    ON_SLOT(5,setSlotPickHeight,    base::Number)
    ON_SLOT(6,setSlotAccumBuff,     base::Boolean)
    ON_SLOT(7,setSlotStencilBuff,   base::Boolean)
+   ON_SLOT(8,setSlotSelectBufferPick, base::Boolean)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(GlutDisplay)
@@ -79,6 +84,7 @@ void GlutDisplay::copyData(const GlutDisplay& org, const bool cc)
    winId = org.winId;
    pickWidth = org.pickWidth;
    pickHeight = org.pickHeight;
+   selectBufferPick = org.selectBufferPick;
    accumBuff = org.accumBuff;
    stencilBuff = org.stencilBuff;
 
@@ -414,6 +420,9 @@ void GlutDisplay::reshapeSubWindow()
 //    there are less than 'item' entries
 // 4) Returns zero(0) when there are no entries in the select buffer or if the
 //    Graphic for the select ID is not found.
+//
+// Unless 'selectBufferPick' is true, only the selectable graphics that are
+// near the pick box are drawn; see note #5.
 //-----------------------------------------------------------------------------
 graphics::Graphic* GlutDisplay::pick(const int item)
 {
@@ -427,6 +436,17 @@ graphics::Graphic* GlutDisplay::pick(const int item)
    int x = xm;
    int y = viewport[3] - ym;
 
+   static const unsigned int MAX_BUFF_SIZE = 1024;
+   GLuint sbuff[MAX_BUFF_SIZE];
+   clearSelectBuffer(sbuff,MAX_BUFF_SIZE);
+
+   // Draw the selectable graphics, from the last frame, that are near the pick box
+   const graphics::PickIndex* pi = getPickIndex();
+   if (!selectBufferPick && pi->isIndexed() && !getRenderer()->isBuffered()) {
+      GLint hits = pi->select(x, y, getPickWidth(), getPickHeight(), viewport, sbuff, MAX_BUFF_SIZE);
+      return findSelected(hits, sbuff, item);
+   }
+
    glMatrixMode(GL_PROJECTION);
    glPushMatrix();
    glLoadIdentity();
@@ -449,9 +469,6 @@ graphics::Graphic* GlutDisplay::pick(const int item)
          glRotated(180.0, 0.0, 0.0, 1.0);
    }
 
-   static const unsigned int MAX_BUFF_SIZE = 1024;
-   GLuint sbuff[MAX_BUFF_SIZE];
-   clearSelectBuffer(sbuff,MAX_BUFF_SIZE);
    glSelectBuffer(MAX_BUFF_SIZE, sbuff);
    glRenderMode(GL_SELECT);
 
@@ -1003,5 +1020,15 @@ bool GlutDisplay::setSlotStencilBuff(const base::Boolean* const msg)
    return ok;
 }
 
+bool GlutDisplay::setSlotSelectBufferPick(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      selectBufferPick = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
 }
 }
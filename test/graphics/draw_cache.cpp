@@ -0,0 +1,301 @@
+//------------------------------------------------------------------------------
+// Draw caching test and benchmark
+//
+//    Two copies of an offscreen display (see draw_cache.edl), one with draw
+//    caching and culling off and the other with both on, render the same
+//    large MFD pages: groups of ten lines and circles, 40% of them outside
+//    of the viewport, with 10% of the groups moving on the 'dynamic' page.
+//
+//    First, each display renders each page by itself for a number of timed
+//    frames, which gives the average frame time (CPU and software
+//    rendering), with and without caching.  Then the two displays render
+//    the page frame by frame, and every few frames, the same random edits
+//    (color, line width, visibility and position) are made to both copies.
+//    Checks that:
+//       -- every frame of the cached display is the same, pixel for pixel,
+//          as the uncached display's frame.
+//
+//    The frames are timed before the edits, so both displays time the same
+//    page, and before the comparisons, so the read backs of the frames
+//    aren't timed.
+//
+//    Usage: draw_cache [ <display file> [ <number of groups> [ <seed> ] ] ]
+//    Returns zero when all of the frames match.
+//------------------------------------------------------------------------------
+
+#include "mixr/ui/egl/EglDisplay.hpp"
+#include "mixr/ui/egl/factory.hpp"
+
+#include "mixr/graphics/Graphic.hpp"
+#include "mixr/graphics/Image.hpp"
+#include "mixr/graphics/MfdPage.hpp"
+#include "mixr/graphics/Page.hpp"
+#include "mixr/graphics/Shapes.hpp"
+
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/colors/Rgb.hpp"
+#include "mixr/base/edl_parser.hpp"
+#include "mixr/base/factory.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+static const unsigned int WARMUP_FRAMES {5};     // Frames before the timed frames (batches are recorded)
+static const unsigned int TIMED_FRAMES {30};     // Timed frames per page and display
+static const unsigned int NUM_FRAMES {60};       // Compared frames per page
+static const unsigned int EDIT_FRAMES {7};       // Frames between the edits
+static const double DT {0.05};                   // Frame time (seconds)
+
+//------------------------------------------------------------------------------
+// Mover: a group that moves every frame (it's not a static draw, so its
+// parent's draw batches are split around it)
+//------------------------------------------------------------------------------
+class Mover : public graphics::Graphic
+{
+   DECLARE_SUBCLASS(Mover, graphics::Graphic)
+public:
+   Mover() { STANDARD_CONSTRUCTOR() }
+   void updateData(const double dt) override
+   {
+      BaseClass::updateData(dt);
+      t += dt;
+      if (!saved) {
+         lcSaveMatrix();
+         saved = true;
+      }
+      lcRestoreMatrix();
+      lcTranslate(20.0 * std::sin(t), 10.0 * std::cos(t));
+   }
+private:
+   double t {};
+   bool saved {};
+};
+IMPLEMENT_SUBCLASS(Mover, "DrawCacheTestMover")
+EMPTY_SLOTTABLE(Mover)
+EMPTY_DELETEDATA(Mover)
+void Mover::copyData(const Mover& org, const bool)
+{
+   BaseClass::copyData(org);
+   t = org.t;
+   saved = false;
+}
+
+// our class factory
+static base::Object* factory(const std::string& name)
+{
+   base::Object* obj {egl::factory(name)};
+   if (obj == nullptr && name == graphics::MfdPage::getFactoryName()) obj = new graphics::MfdPage();
+   if (obj == nullptr && name == graphics::Page::getFactoryName()) obj = new graphics::Page();
+   if (obj == nullptr) obj = base::factory(name);
+   return obj;
+}
+
+//------------------------------------------------------------------------------
+// Scene
+//------------------------------------------------------------------------------
+static void add(graphics::Graphic* const parent, graphics::Graphic* const g)
+{
+   const auto pair = new base::Pair("g", g);
+   parent->addComponent(pair);
+   pair->unref();
+   g->unref();
+}
+
+// Adds the groups to the page, and returns their shapes (ten per group)
+static std::vector<graphics::Graphic*> buildScene(graphics::Graphic* const page, const unsigned int n,
+                                                  const unsigned int seed, const bool moving,
+                                                  const double width, const double height)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+   std::vector<graphics::Graphic*> shapes;
+   for (unsigned int i = 0; i < n; i++) {
+      // 40% of the groups are outside of the viewport
+      double x {width * uniform(gen)};
+      double y {height * uniform(gen)};
+      if (i % 5 < 2) {
+         x += (i % 2) ? (width + 50.0) : -(width + 50.0);
+         y += (i % 3) ? 0.0 : (height + 50.0);
+      }
+
+      graphics::Graphic* const g {(moving && i % 10 == 0) ? new Mover() : new graphics::Graphic()};
+      g->lcTranslate(x, y);
+      for (unsigned int k = 0; k < 8; k++) {
+         const auto line = new graphics::Line();
+         const base::Vec3d v[2] {
+            base::Vec3d(30.0 * uniform(gen) - 15.0, 30.0 * uniform(gen) - 15.0, 0),
+            base::Vec3d(30.0 * uniform(gen) - 15.0, 30.0 * uniform(gen) - 15.0, 0)
+         };
+         line->setVertices(v, 2);
+         const base::Rgb color(uniform(gen), uniform(gen), uniform(gen));
+         line->setColor(&color);
+         shapes.push_back(line);
+         add(g, line);
+      }
+      const auto circle = new graphics::Circle();
+      circle->setRadius(5.0 + 5.0 * uniform(gen));
+      const base::Rgb green(0.0, 1.0, 0.0);
+      circle->setColor(&green);
+      shapes.push_back(circle);
+      add(g, circle);
+
+      const auto disk = new graphics::Circle();
+      disk->setRadius(4.0);
+      disk->setFilled(true);
+      disk->setLineWidth(2.0f);
+      const base::Rgb blue(0.2, 0.4, 1.0);
+      disk->setColor(&blue);
+      shapes.push_back(disk);
+      add(g, disk);
+
+      add(page, g);
+   }
+   return shapes;
+}
+
+// Random edits of the shapes (and their groups)
+static void edit(std::vector<graphics::Graphic*>& shapes, std::mt19937& gen)
+{
+   std::uniform_real_distribution<double> uniform(0.0, 1.0);
+   for (unsigned int i = 0; i < 20; i++) {
+      graphics::Graphic* const g {shapes[gen() % shapes.size()]};
+      switch (gen() % 4) {
+         case 0: {
+            const base::Rgb color(uniform(gen), uniform(gen), uniform(gen));
+            g->setColor(&color);
+            break;
+         }
+         case 1: g->setLineWidth(static_cast<GLfloat>(1 + gen() % 3)); break;
+         case 2: g->setVisibility(!g->isVisible()); break;
+         default: {
+            const auto group = dynamic_cast<graphics::Graphic*>(g->container());
+            if (group != nullptr && dynamic_cast<Mover*>(group) == nullptr) {
+               group->lcTranslate(10.0 * uniform(gen) - 5.0, 10.0 * uniform(gen) - 5.0);
+            }
+            break;
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Displays
+//------------------------------------------------------------------------------
+static egl::EglDisplay* newDisplay(const std::string& file, const bool caching)
+{
+   int errors {};
+   base::Object* obj {base::edl_parser(file, factory, &errors)};
+   const auto d = dynamic_cast<egl::EglDisplay*>(obj);
+   if (errors > 0 || d == nullptr) {
+      std::cerr << "draw_cache: invalid display file: " << file << std::endl;
+      if (obj != nullptr) obj->unref();
+      return nullptr;
+   }
+   d->setDrawCaching(caching);
+   d->setCulling(caching);
+   d->reset();
+   if (!d->createWindow()) {
+      std::cerr << "draw_cache: unable to create the display's surface" << std::endl;
+      d->unref();
+      return nullptr;
+   }
+   return d;
+}
+
+// Number of pixels that differ
+static unsigned int compareFrames(egl::EglDisplay* const a, egl::EglDisplay* const b)
+{
+   a->select();
+   graphics::Image* const ia {a->readFrameBuffer()};
+   b->select();
+   graphics::Image* const ib {b->readFrameBuffer()};
+   unsigned int bad {};
+   if (ia == nullptr || ib == nullptr || ia->getWidth() != ib->getWidth() || ia->getHeight() != ib->getHeight()) {
+      bad = 1;
+   }
+   else {
+      const unsigned int nc {ia->getNumComponents()};
+      const unsigned int n {ia->getWidth() * ia->getHeight()};
+      for (unsigned int i = 0; i < n; i++) {
+         if (std::memcmp(ia->getPixels() + i * nc, ib->getPixels() + i * nc, nc) != 0) bad++;
+      }
+   }
+   if (ia != nullptr) ia->unref();
+   if (ib != nullptr) ib->unref();
+   return bad;
+}
+
+int main(int argc, char* argv[])
+{
+   const std::string file {(argc > 1) ? argv[1] : "draw_cache.edl"};
+   const unsigned int n {(argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 400};
+   const unsigned int seed {(argc > 3) ? static_cast<unsigned int>(std::atoi(argv[3])) : 72};
+
+   // (0) uncached, (1) cached
+   egl::EglDisplay* const d[2] {newDisplay(file, false), newDisplay(file, true)};
+   if (d[0] == nullptr || d[1] == nullptr) return EXIT_FAILURE;
+
+   const char* const pages[2] {"static", "dynamic"};
+   unsigned int failed {};
+   for (unsigned int p = 0; p < 2; p++) {
+      std::vector<graphics::Graphic*> shapes[2];
+      for (unsigned int k = 0; k < 2; k++) {
+         // (the display selects its page on its next frame)
+         d[k]->newSubpage(pages[p], nullptr);
+         d[k]->renderFrame(DT);
+         if (d[k]->subpage() == nullptr) {
+            std::cerr << "draw_cache: the display has no page: " << pages[p] << std::endl;
+            return EXIT_FAILURE;
+         }
+         GLint vp[4] {};
+         d[k]->getViewport(&vp[0], &vp[1], &vp[2], &vp[3]);
+         shapes[k] = buildScene(d[k]->subpage(), n, seed + p, (p == 1), vp[2], vp[3]);
+      }
+
+      // Timed frames, each display by itself
+      double time[2] {};
+      for (unsigned int k = 0; k < 2; k++) {
+         d[k]->select();
+         for (unsigned int f = 0; f < WARMUP_FRAMES; f++) d[k]->renderFrame(DT);
+         const double t0 {base::getComputerTime()};
+         for (unsigned int f = 0; f < TIMED_FRAMES; f++) d[k]->renderFrame(DT);
+         time[k] = (base::getComputerTime() - t0) / TIMED_FRAMES;
+      }
+
+      // Compared frames, with edits
+      std::mt19937 gen[2] {std::mt19937(seed), std::mt19937(seed)};
+      unsigned int badFrames {};
+      for (unsigned int f = 0; f < NUM_FRAMES; f++) {
+         for (unsigned int k = 0; k < 2; k++) {
+            if (f > 0 && (f % EDIT_FRAMES) == 0) edit(shapes[k], gen[k]);
+            d[k]->renderFrame(DT);
+         }
+         const unsigned int bad {compareFrames(d[0], d[1])};
+         if (bad > 0) {
+            if (badFrames++ < 10) {
+               std::cout << "  page " << pages[p] << ", frame " << f << ": " << bad << " pixels differ" << std::endl;
+            }
+         }
+      }
+      failed += badFrames;
+
+      std::cout << "page " << pages[p] << ": " << n << " groups; avg frame uncached " << (time[0] * 1000.0)
+                << " ms, cached and culled " << (time[1] * 1000.0) << " ms; " << NUM_FRAMES << " frames compared, "
+                << badFrames << " differ" << std::endl;
+   }
+
+   for (unsigned int k = 0; k < 2; k++) {
+      d[k]->event(base::Component::SHUTDOWN_EVENT);
+      d[k]->unref();
+   }
+   return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
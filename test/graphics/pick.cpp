@@ -0,0 +1,353 @@
+//------------------------------------------------------------------------------
+// Pick test
+//
+//    Compares the pick index's select (graphics::PickIndex::select(), which
+//    redraws only the selectable graphics near the pick box) with drawing the
+//    whole display in GL_SELECT mode (the select buffer path of
+//    glut::GlutDisplay::pick()), for a grid of pick boxes over a random scene
+//    of rectangles, nested select names, circles, slanted lines, moving and
+//    scaled groups, and custom drawing with unknown bounds.  Each pick box is
+//    tested with items -1, 0, 1 and 2 (see GlutDisplay::findSelected()), with
+//    draw caching off and on.
+//
+//    Usage: pick [ <display file> [ <number of graphics> [ <seed> ] ] ]
+//    Returns zero when every pick selects the same graphic.
+//------------------------------------------------------------------------------
+
+#include "mixr/ui/egl/EglDisplay.hpp"
+#include "mixr/ui/egl/factory.hpp"
+
+#include "mixr/graphics/Graphic.hpp"
+#include "mixr/graphics/Page.hpp"
+#include "mixr/graphics/PickIndex.hpp"
+#include "mixr/graphics/Polygon.hpp"
+#include "mixr/graphics/Shapes.hpp"
+
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/edl_parser.hpp"
+#include "mixr/base/factory.hpp"
+
+#include <GL/glu.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace mixr;
+
+//------------------------------------------------------------------------------
+// Mover: a group that moves every frame
+//------------------------------------------------------------------------------
+class Mover : public graphics::Graphic
+{
+   DECLARE_SUBCLASS(Mover, graphics::Graphic)
+public:
+   Mover() { STANDARD_CONSTRUCTOR() }
+   Mover(const double x, const double y, const double s) : x0(x), y0(y), scale(s) { STANDARD_CONSTRUCTOR() }
+   void updateData(const double dt) override
+   {
+      BaseClass::updateData(dt);
+      t += dt;
+      if (!saved) {
+         lcSaveMatrix();
+         saved = true;
+      }
+      lcRestoreMatrix();
+      lcTranslate(x0 + 20.0 * std::sin(t), y0 + 10.0 * std::cos(t));
+      lcScale(scale);
+   }
+   bool isStaticDraw() const override { return true; }
+private:
+   double x0 {}, y0 {}, scale {1.0}, t {};
+   bool saved {};
+};
+IMPLEMENT_SUBCLASS(Mover, "PickTestMover")
+EMPTY_SLOTTABLE(Mover)
+EMPTY_DELETEDATA(Mover)
+void Mover::copyData(const Mover& org, const bool)
+{
+   BaseClass::copyData(org);
+   x0 = org.x0;
+   y0 = org.y0;
+   scale = org.scale;
+   t = org.t;
+   saved = false;
+}
+
+//------------------------------------------------------------------------------
+// Custom: drawing with unknown bounds
+//------------------------------------------------------------------------------
+class Custom : public graphics::Graphic
+{
+   DECLARE_SUBCLASS(Custom, graphics::Graphic)
+public:
+   Custom() { STANDARD_CONSTRUCTOR() }
+   void drawFunc() override
+   {
+      glBegin(GL_LINES);
+      glVertex2d(0.0, 0.0);
+      glVertex2d(12.0, 9.0);
+      glEnd();
+   }
+};
+IMPLEMENT_SUBCLASS(Custom, "PickTestCustom")
+EMPTY_SLOTTABLE(Custom)
+EMPTY_COPYDATA(Custom)
+EMPTY_DELETEDATA(Custom)
+
+// our class factory
+static base::Object* factory(const std::string& name)
+{
+   base::Object* obj {egl::factory(name)};
+   if (obj == nullptr && name == graphics::Page::getFactoryName()) obj = new graphics::Page();
+   if (obj == nullptr) obj = base::factory(name);
+   return obj;
+}
+
+//------------------------------------------------------------------------------
+// Scene
+//------------------------------------------------------------------------------
+static graphics::Polygon* rectangle(const double w, const double h)
+{
+   const base::Vec3d v[4] { base::Vec3d(0, 0, 0), base::Vec3d(w, 0, 0), base::Vec3d(w, h, 0), base::Vec3d(0, h, 0) };
+   const auto p = new graphics::Polygon();
+   p->setVertices(v, 4);
+   return p;
+}
+
+static void add(graphics::Graphic* const parent, graphics::Graphic* const g)
+{
+   const auto pair = new base::Pair("g", g);
+   parent->addComponent(pair);
+   pair->unref();
+   g->unref();
+}
+
+static void buildScene(graphics::Graphic* const page, const unsigned int n, const unsigned int seed,
+                       const double width, const double height)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> rx(10.0, width - 10.0);
+   std::uniform_real_distribution<double> ry(10.0, height - 10.0);
+   std::uniform_real_distribution<double> rs(4.0, 30.0);
+   std::uniform_real_distribution<double> rd(-20.0, 20.0);
+
+   for (unsigned int i = 0; i < n; i++) {
+      const GLuint name {i + 1};
+      const double x {rx(gen)};
+      const double y {ry(gen)};
+      switch ((i % 40 == 39) ? 5 : (i % 5)) {
+         case 0: {      // rectangle
+            const auto g = new graphics::Graphic();
+            g->setSelectName(name);
+            g->lcTranslate(x, y);
+            add(g, rectangle(rs(gen), rs(gen)));
+            add(page, g);
+            break;
+         }
+         case 1: {      // nested select names, and an unnamed line
+            const auto g = new graphics::Graphic();
+            g->setSelectName(name);
+            g->lcTranslate(x, y);
+            graphics::Polygon* const p {rectangle(rs(gen) * 0.6, rs(gen) * 0.6)};
+            p->setSelectName(name + 10000);
+            add(g, p);
+            const auto line = new graphics::Line();
+            const base::Vec3d v[2] { base::Vec3d(-5, -5, 0), base::Vec3d(5, -5, 0) };
+            line->setVertices(v, 2);
+            add(g, line);
+            add(page, g);
+            break;
+         }
+         case 2: {      // circle
+            const auto c = new graphics::Circle();
+            c->setSelectName(name);
+            c->setRadius(rs(gen) * 0.4);
+            c->setFilled(true);
+            c->lcTranslate(x, y);
+            add(page, c);
+            break;
+         }
+         case 3: {      // slanted line
+            const auto line = new graphics::Line();
+            line->setSelectName(name);
+            const base::Vec3d v[2] { base::Vec3d(x, y, 0), base::Vec3d(x + rd(gen), y + rd(gen), 0) };
+            line->setVertices(v, 2);
+            add(page, line);
+            break;
+         }
+         case 4: {      // moving, scaled group
+            const auto g = new Mover(x, y, rs(gen) / 15.0);
+            g->setSelectName(name);
+            add(g, rectangle(8.0, 8.0));
+            add(page, g);
+            break;
+         }
+         default: {     // custom drawing (a few)
+            const auto g = new graphics::Graphic();
+            g->setSelectName(name);
+            g->lcTranslate(x, y);
+            add(g, new Custom());
+            add(g, rectangle(rs(gen) * 0.5, rs(gen) * 0.5));
+            add(page, g);
+            break;
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Picks
+//------------------------------------------------------------------------------
+
+// select name of the hit record that's selected by GlutDisplay::findSelected()
+static GLuint findSelected(const GLint hits, const GLuint sbuff[], const int item)
+{
+   static const unsigned int MAX_HITS {64};
+   GLuint hitList[MAX_HITS] {};
+   GLuint zminList[MAX_HITS] {};
+   GLuint zmaxList[MAX_HITS] {};
+   unsigned int hitCnt {};
+   unsigned int idx {};
+   for (GLint hit = 1; hit <= hits && hitCnt < MAX_HITS; hit++) {
+      const GLuint n {sbuff[idx++]};
+      const GLuint zmin {sbuff[idx++]};
+      const GLuint zmax {sbuff[idx++]};
+      if (n > 0) {
+         hitList[hitCnt] = sbuff[idx];
+         zminList[hitCnt] = zmin;
+         zmaxList[hitCnt] = zmax;
+         hitCnt++;
+      }
+      idx += n;
+   }
+   if (hitCnt == 0) return 0;
+   if (item > 0) return (item <= static_cast<int>(hitCnt)) ? hitList[item - 1] : 0;
+   unsigned int h {};
+   for (unsigned int i = 1; i < hitCnt; i++) {
+      if (item == 0 ? (zminList[i] < zminList[h]) : (zmaxList[i] > zmaxList[h])) h = i;
+   }
+   return hitList[h];
+}
+
+static const GLsizei MAX_BUFF_SIZE {1024};
+
+// draw the whole display in GL_SELECT mode
+static GLuint selectPick(graphics::Display* const d, const double x, const double y,
+                         const double w, const double h, const int item)
+{
+   GLint viewport[4] {};
+   glGetIntegerv(GL_VIEWPORT, viewport);
+
+   glMatrixMode(GL_PROJECTION);
+   glPushMatrix();
+   glLoadIdentity();
+   gluPickMatrix(x, y, w, h, viewport);
+   GLdouble l {}, r {}, b {}, t {}, n {}, f {};
+   d->getOrtho(l, r, b, t, n, f);
+   glOrtho(l, r, b, t, n, f);
+   glMatrixMode(GL_MODELVIEW);
+
+   GLuint sbuff[MAX_BUFF_SIZE] {};
+   glSelectBuffer(MAX_BUFF_SIZE, sbuff);
+   glRenderMode(GL_SELECT);
+   glInitNames();
+   d->draw();
+   const GLint hits {glRenderMode(GL_RENDER)};
+
+   glMatrixMode(GL_PROJECTION);
+   glPopMatrix();
+   glMatrixMode(GL_MODELVIEW);
+   return findSelected(hits, sbuff, item);
+}
+
+// draw the graphics near the pick box in GL_SELECT mode
+static GLuint indexPick(graphics::Display* const d, const double x, const double y,
+                        const double w, const double h, const int item)
+{
+   GLint viewport[4] {};
+   glGetIntegerv(GL_VIEWPORT, viewport);
+   GLuint sbuff[MAX_BUFF_SIZE] {};
+   const GLint hits {d->getPickIndex()->select(x, y, w, h, viewport, sbuff, MAX_BUFF_SIZE)};
+   return findSelected(hits, sbuff, item);
+}
+
+static unsigned int testPicks(egl::EglDisplay* const d, const bool caching)
+{
+   d->setDrawCaching(caching);
+   for (unsigned int i = 0; i < 5; i++) d->renderFrame(0.05);
+
+   GLint vp[4] {};
+   glGetIntegerv(GL_VIEWPORT, vp);
+   const double pw {10.0}, ph {10.0};
+   const int items[] { -1, 0, 1, 2 };
+
+   unsigned int picks {}, hits {}, failed {};
+   double indexTime {}, selectTime {};
+   for (const int item : items) {
+      for (int y = 2; y < vp[3]; y += 8) {
+         for (int x = 2; x < vp[2]; x += 8) {
+            const auto t0 = std::chrono::steady_clock::now();
+            const GLuint a {indexPick(d, x, y, pw, ph, item)};
+            const auto t1 = std::chrono::steady_clock::now();
+            const GLuint b {selectPick(d, x, y, pw, ph, item)};
+            const auto t2 = std::chrono::steady_clock::now();
+            indexTime += std::chrono::duration<double>(t1 - t0).count();
+            selectTime += std::chrono::duration<double>(t2 - t1).count();
+            picks++;
+            if (b != 0) hits++;
+            if (a != b) {
+               if (failed++ < 10) {
+                  std::cout << "  pick (" << x << ", " << y << ") item " << item
+                            << ": index " << a << ", select buffer " << b << std::endl;
+               }
+            }
+         }
+      }
+   }
+
+   std::cout << "draw caching " << (caching ? "on " : "off") << ": " << picks << " picks, "
+             << hits << " hits, " << failed << " differ; avg index pick "
+             << (indexTime / picks * 1.0e6) << " us, select buffer pick "
+             << (selectTime / picks * 1.0e6) << " us" << std::endl;
+   return failed;
+}
+
+int main(int argc, char* argv[])
+{
+   const std::string file {(argc > 1) ? argv[1] : "pick.edl"};
+   const unsigned int n {(argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 400};
+   const unsigned int seed {(argc > 3) ? static_cast<unsigned int>(std::atoi(argv[3])) : 74};
+
+   int errors {};
+   base::Object* obj {base::edl_parser(file, factory, &errors)};
+   const auto d = dynamic_cast<egl::EglDisplay*>(obj);
+   if (errors > 0 || d == nullptr) {
+      std::cerr << "pick: invalid display file: " << file << std::endl;
+      return EXIT_FAILURE;
+   }
+   if (!d->createWindow()) {
+      std::cerr << "pick: unable to create the display's surface" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   // (the display selects its page on its first frame)
+   d->renderFrame(0.05);
+   if (d->subpage() == nullptr) {
+      std::cerr << "pick: the display has no page: " << file << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   GLint vp[4] {};
+   d->getViewport(&vp[0], &vp[1], &vp[2], &vp[3]);
+   buildScene(d->subpage(), n, seed, vp[2], vp[3]);
+
+   unsigned int failed {testPicks(d, false)};
+   failed += testPicks(d, true);
+
+   d->unref();
+   return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+// Render test
+//
+//    Runs the render harness (egl::RenderHarness) of a harness file: its
+//    offscreen display renders each page, reports the page's draw time, and
+//    compares the last frame against the page's golden image.  Checks that
+//    every page was rendered, had a golden image, and matched it.
+//
+//    The 'relief' page draws the shaded relief image of a terrain raster
+//    service (terrain::RasterService) over a synthetic data file, so the
+//    service's output is compared against a golden image as well.
+//
+//    With 'update', the frames are written as the new golden images instead
+//    (e.g., after an intended change of the pages or of the drawing code).
+//
+//    Usage: render [ <harness file> [ update ] ]
+//    Returns zero when all of the pages match their golden images.
+//------------------------------------------------------------------------------
+
+#include "mixr/ui/egl/RenderHarness.hpp"
+#include "mixr/ui/egl/factory.hpp"
+
+#include "mixr/graphics/Graphic.hpp"
+#include "mixr/graphics/Page.hpp"
+#include "mixr/graphics/Polygon.hpp"
+#include "mixr/graphics/Shapes.hpp"
+
+#include "mixr/terrain/DataFile.hpp"
+#include "mixr/terrain/ElevationRaster.hpp"
+#include "mixr/terrain/RasterService.hpp"
+#include "mixr/terrain/factory.hpp"
+
+#include "mixr/base/edl_parser.hpp"
+#include "mixr/base/factory.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+//------------------------------------------------------------------------------
+// HillsFile: a one degree data file of 241 by 241 posts of smooth hills,
+// starting at [ 40N 118W ]
+//------------------------------------------------------------------------------
+class HillsFile : public terrain::DataFile
+{
+   DECLARE_SUBCLASS(HillsFile, terrain::DataFile)
+
+public:
+   HillsFile()                                        { STANDARD_CONSTRUCTOR() }
+
+private:
+   bool loadData() override
+   {
+      const unsigned int n {241};
+      nptlat = n;
+      nptlong = n;
+      latSpacing = 1.0 / (n - 1);
+      lonSpacing = 1.0 / (n - 1);
+      columns = new short*[n];
+      for (unsigned int c = 0; c < n; c++) {
+         columns[c] = new short[n];
+         for (unsigned int r = 0; r < n; r++) {
+            const double x {static_cast<double>(c) / (n - 1)};
+            const double y {static_cast<double>(r) / (n - 1)};
+            const double h {1200.0 + 700.0 * std::sin(7.0 * x + 2.0 * y) * std::cos(5.0 * y - 1.5 * x) +
+                            300.0 * std::sin(19.0 * x) * std::sin(23.0 * y)};
+            columns[c][r] = static_cast<short>(h);
+         }
+      }
+      setLatitudeSW(40.0);
+      setLongitudeSW(-118.0);
+      setLatitudeNE(41.0);
+      setLongitudeNE(-117.0);
+      setMinElevation(0.0);
+      setMaxElevation(2200.0);
+      return true;
+   }
+};
+
+IMPLEMENT_SUBCLASS(HillsFile, "RenderTestHillsFile")
+EMPTY_SLOTTABLE(HillsFile)
+EMPTY_COPYDATA(HillsFile)
+EMPTY_DELETEDATA(HillsFile)
+
+//------------------------------------------------------------------------------
+// Relief: draws the image of the raster service's raster of the hills file,
+// 224 by 160 cells, with its lower left corner at the display's [ -3.5 -2.5 ];
+// the raster's eastern columns are past the file, so they're transparent
+//
+// Factory name: RenderTestRelief
+// Slots:
+//    service  <RasterService>   ! Raster service (required)
+//------------------------------------------------------------------------------
+class Relief : public graphics::Graphic
+{
+   DECLARE_SUBCLASS(Relief, graphics::Graphic)
+
+public:
+   Relief()                                           { STANDARD_CONSTRUCTOR() }
+
+   void reset() override
+   {
+      BaseClass::reset();
+      if (service != nullptr) service->reset();
+      if (file == nullptr) {
+         file = new HillsFile();
+         file->reset();
+      }
+      raster.setArea(40.05, -117.95, 40.95, -116.8, 160, 224);
+      if (service != nullptr && service->process(file, &raster)) {
+         // (the raster's first row is its northern row)
+         const unsigned int rowSize {raster.getNumCols() * 4};
+         image.resize(raster.getNumRows() * rowSize);
+         for (unsigned int r = 0; r < raster.getNumRows(); r++) {
+            const std::uint8_t* const p {raster.getImage() + r * rowSize};
+            std::copy(p, p + rowSize, image.begin() + (raster.getNumRows() - 1 - r) * rowSize);
+         }
+      }
+   }
+
+   void drawFunc() override
+   {
+      if (image.empty()) return;
+      glPushAttrib(GL_COLOR_BUFFER_BIT);
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glRasterPos2d(-3.5, -2.5);
+      glDrawPixels(raster.getNumCols(), raster.getNumRows(), GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+      glPopAttrib();
+   }
+
+   bool shutdownNotification() override
+   {
+      if (service != nullptr) service->event(SHUTDOWN_EVENT);
+      return BaseClass::shutdownNotification();
+   }
+
+private:
+   bool setSlotService(terrain::RasterService* const x)
+   {
+      if (service != nullptr) service->unref();
+      service = x;
+      if (service != nullptr) service->ref();
+      return true;
+   }
+
+   terrain::RasterService* service {};
+   HillsFile* file {};
+   terrain::ElevationRaster raster;
+   std::vector<std::uint8_t> image;      // RGBA image, south to north
+};
+
+IMPLEMENT_SUBCLASS(Relief, "RenderTestRelief")
+
+BEGIN_SLOTTABLE(Relief)
+   "service",
+END_SLOTTABLE(Relief)
+
+BEGIN_SLOT_MAP(Relief)
+   ON_SLOT(1, setSlotService, terrain::RasterService)
+END_SLOT_MAP()
+
+void Relief::copyData(const Relief& org, const bool)
+{
+   BaseClass::copyData(org);
+   setSlotService(org.service);
+   image = org.image;
+}
+
+void Relief::deleteData()
+{
+   setSlotService(nullptr);
+   if (file != nullptr) file->unref();
+   file = nullptr;
+}
+
+// our class factory: the harness, the display and the graphics of the pages
+static base::Object* factory(const std::string& name)
+{
+   base::Object* obj {egl::factory(name)};
+
+   if (obj == nullptr) {
+      if (name == graphics::Page::getFactoryName())                  obj = new graphics::Page();
+      else if (name == graphics::Graphic::getFactoryName())          obj = new graphics::Graphic();
+      else if (name == graphics::Polygon::getFactoryName())          obj = new graphics::Polygon();
+      else if (name == graphics::Line::getFactoryName())             obj = new graphics::Line();
+      else if (name == graphics::LineLoop::getFactoryName())         obj = new graphics::LineLoop();
+      else if (name == graphics::Point::getFactoryName())            obj = new graphics::Point();
+      else if (name == graphics::Quad::getFactoryName())             obj = new graphics::Quad();
+      else if (name == graphics::Triangle::getFactoryName())         obj = new graphics::Triangle();
+      else if (name == graphics::Circle::getFactoryName())           obj = new graphics::Circle();
+      else if (name == graphics::OcclusionCircle::getFactoryName())  obj = new graphics::OcclusionCircle();
+      else if (name == graphics::Arc::getFactoryName())              obj = new graphics::Arc();
+      else if (name == Relief::getFactoryName())                     obj = new Relief();
+   }
+
+   if (obj == nullptr) obj = terrain::factory(name);
+
+   if (obj == nullptr) obj = base::factory(name);
+   return obj;
+}
+
+int main(int argc, char* argv[])
+{
+   const std::string file {(argc > 1) ? argv[1] : "render.edl"};
+   const bool update {(argc > 2) && std::string(argv[2]) == "update"};
+
+   int errors {};
+   base::Object* obj {base::edl_parser(file, factory, &errors)};
+   const auto harness = dynamic_cast<egl::RenderHarness*>(obj);
+   if (errors > 0 || harness == nullptr) {
+      std::cerr << "render: invalid harness file: " << file << std::endl;
+      if (obj != nullptr) obj->unref();
+      return EXIT_FAILURE;
+   }
+   if (update) {
+      base::Boolean on(true);
+      harness->setSlotByName("updateGolden", &on);
+   }
+
+   harness->reset();
+   unsigned int failed {harness->run()};
+
+   // A page without a golden image isn't compared by the harness, but here
+   // it's a failure
+   unsigned int numCompared {};
+   for (const egl::RenderHarness::Result& r : harness->getResults()) {
+      if (r.compared) numCompared++;
+      else if (!update && r.passed) failed++;
+   }
+
+   std::cout << harness->getResults().size() << " pages, " << numCompared << " compared, " << failed << " failed" << std::endl;
+
+   harness->event(base::Component::SHUTDOWN_EVENT);
+   harness->unref();
+   return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
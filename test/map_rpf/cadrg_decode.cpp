@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------
+// CADRG subframe decoding test and benchmark
+//
+//    Writes a CADRG frame file with random VQ lookup tables, subframes and
+//    216 color table, with two of its subframes masked, and loads it with
+//    CadrgFrame::load() and CadrgFrameEntry::loadClut().  Then:
+//       -- checks that CadrgFrame::decodeSubframe(), in RGB and RGBA, and
+//          SubframeCache::decode() and get(), give the same texels, pixel for
+//          pixel, as decompressSubframe() followed by
+//          CadrgMap::subframeToTexels(), for all 36 subframes; the masked
+//          subframes are black (with a zero alpha) instead, since the current
+//          decoder looks up the color of index 255, which is past the end of
+//          the color table;
+//       -- reports the subframes per second of the two decoders, and of the
+//          cache's hits.
+//
+//    Usage: cadrg_decode [ <number of subframes to decode> ]
+//    Returns zero when all of the subframes match.
+//------------------------------------------------------------------------------
+
+#include "mixr/map/rpf/CadrgClut.hpp"
+#include "mixr/map/rpf/CadrgFrame.hpp"
+#include "mixr/map/rpf/CadrgFrameEntry.hpp"
+#include "mixr/map/rpf/CadrgMap.hpp"
+#include "mixr/map/rpf/SubframeCache.hpp"
+#include "mixr/map/rpf/map_utils.hpp"
+
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+static const char* const FILE_NAME {"cadrg.i21"};   // (15 characters at most)
+static const int MASKED_ROW[] {1, 4};      // Masked subframes (row, column)
+static const int MASKED_COL[] {2, 0};
+
+// Big endian (i.e., the file's byte order) values
+static void put16(std::string* const b, const unsigned int v)
+{
+   b->push_back(static_cast<char>((v >> 8) & 0xff));
+   b->push_back(static_cast<char>(v & 0xff));
+}
+
+static void put32(std::string* const b, const unsigned int v)
+{
+   put16(b, (v >> 16) & 0xffff);
+   put16(b, v & 0xffff);
+}
+
+static bool isMasked(const int row, const int col)
+{
+   return (row == MASKED_ROW[0] && col == MASKED_COL[0]) || (row == MASKED_ROW[1] && col == MASKED_COL[1]);
+}
+
+// Writes the frame file: header, location section and then the components
+// that CadrgFrame::load() and CadrgClut::load() read
+static bool writeFrame(const unsigned int seed)
+{
+   std::mt19937 gen(seed);
+
+   // Components: id and contents
+   struct Component { unsigned int id; std::string data; };
+   std::vector<Component> comps;
+
+   // Compression section: algorithm, offset records, parameter offset records
+   {
+      std::string b;
+      put16(&b, 1);
+      put16(&b, 4);
+      put16(&b, 0);
+      comps.push_back({rpf::LOC_COMPRESSION_SECTION, b});
+   }
+
+   // Compression lookup subsection: four tables (one per pixel row) of 4096
+   // records of four color indexes
+   {
+      std::string b;
+      put32(&b, 6);              // offset table offset
+      put16(&b, 14);             // offset record length
+      const unsigned int tables {6 + 4 * 14};
+      for (unsigned int i = 0; i < 4; i++) {
+         put16(&b, i);           // id
+         put32(&b, 4096);        // records
+         put16(&b, 4);           // values
+         put16(&b, 8);           // bit length
+         put32(&b, tables + i * 4096 * 4);
+      }
+      for (unsigned int i = 0; i < 4 * 4096 * 4; i++) b.push_back(static_cast<char>(gen() % 216));
+      comps.push_back({rpf::LOC_COMPRESSION_LOOKUP_SUBSECTION, b});
+   }
+
+   // Image description subheader, with the offset of the mask table
+   {
+      std::string b;
+      put16(&b, 1);              // spectral groups
+      put16(&b, 36);             // subframe tables
+      put16(&b, 1);              // spectral tables
+      put16(&b, 1536);           // spectral lines
+      put16(&b, 6);              // horizontal subframes
+      put16(&b, 6);              // vertical subframes
+      put32(&b, 1536);           // output columns
+      put32(&b, 1536);           // output rows
+      put32(&b, 6);              // subframe mask table offset
+      comps.push_back({rpf::LOC_IMAGE_DESCR_SUBHEADER, b});
+   }
+
+   // Mask subsection: the offsets of the subframes (0xFFFFFFFF if masked)
+   {
+      std::string b;
+      put32(&b, 0);
+      put16(&b, 0);
+      for (int i = 0; i < 6; i++) {
+         for (int j = 0; j < 6; j++) put32(&b, isMasked(i, j) ? 0xFFFFFFFF : (i * 6 + j) * 6144);
+      }
+      comps.push_back({rpf::LOC_MASK_SUBSECTION, b});
+   }
+
+   comps.push_back({rpf::LOC_IMAGE_DISPLAY_PARAM_SUBHEADER, std::string(14, '\0')});
+
+   // Spatial data subsection: the subframes that aren't masked, row-wise
+   {
+      std::string b;
+      for (int i = 0; i < 6; i++) {
+         for (int j = 0; j < 6; j++) {
+            if (isMasked(i, j)) continue;
+            for (int k = 0; k < 6144; k++) b.push_back(static_cast<char>(gen() & 0xff));
+         }
+      }
+      comps.push_back({rpf::LOC_SPATIAL_DATA_SUBSECTION, b});
+   }
+
+   // Color/gray section subheader: one offset record, no color converters
+   {
+      std::string b;
+      b.push_back(1);
+      b.push_back(0);
+      comps.push_back({rpf::LOC_COLORGRAY_SECTION_SUBHEADER, b});
+   }
+
+   // Colormap subsection: one 216 color table (RGBA)
+   {
+      std::string b;
+      put32(&b, 6);              // offset table offset
+      put16(&b, 17);             // offset record length
+      put16(&b, 2);              // table id
+      put32(&b, 216);            // color records
+      b.push_back(4);            // color element length
+      put16(&b, 0);              // histogram record length
+      put32(&b, 6 + 17);         // color table offset
+      put32(&b, 0);              // histogram table offset
+      for (int i = 0; i < 216 * 4; i++) b.push_back(static_cast<char>(gen() & 0xff));
+      comps.push_back({rpf::LOC_COLORMAP_SUBSECTION, b});
+   }
+
+   // Header: big endian, with the location section just past it
+   const unsigned int hdrSize {48};
+   std::string file;
+   file.push_back(0);
+   put16(&file, hdrSize);
+   file.append(12, ' ');
+   file.push_back(0);
+   file.append(15, ' ');
+   file.append(8, ' ');
+   file.push_back('U');
+   file.append(4, ' ');
+   put32(&file, hdrSize);
+
+   // Location section
+   const unsigned int n {static_cast<unsigned int>(comps.size())};
+   const unsigned int locSize {14 + n * 10};
+   put16(&file, locSize);
+   put32(&file, 14);
+   put16(&file, n);
+   put16(&file, 10);
+   put32(&file, n * 10);
+   unsigned int offset {hdrSize + locSize};
+   for (const Component& c : comps) {
+      put16(&file, c.id);
+      put32(&file, static_cast<unsigned int>(c.data.size()));
+      put32(&file, offset);
+      offset += static_cast<unsigned int>(c.data.size());
+   }
+   for (const Component& c : comps) file.append(c.data);
+
+   std::ofstream out(FILE_NAME, std::ios::binary | std::ios::trunc);
+   out.write(file.data(), static_cast<std::streamsize>(file.size()));
+   return out.good();
+}
+
+// Do the RGB or RGBA texels match the reference texels?
+static bool isSame(const rpf::CadrgMap::ColorArray& ref, const unsigned char* const texels, const int nc, const bool masked)
+{
+   if (masked) {
+      for (int i = 0; i < 256 * 256 * nc; i++) {
+         if (texels[i] != 0) return false;
+      }
+      return true;
+   }
+   for (int i = 0; i < 256; i++) {
+      for (int j = 0; j < 256; j++) {
+         const unsigned char* const p {&texels[(i * 256 + j) * nc]};
+         const rpf::CadrgMap::RGBColor& c {ref.texel[i][j]};
+         if (p[0] != c.red || p[1] != c.green || p[2] != c.blue || (nc == 4 && p[3] != 255)) return false;
+      }
+   }
+   return true;
+}
+
+int main(int argc, char* argv[])
+{
+   const int numDecodes {(argc > 1) ? std::atoi(argv[1]) : 2000};
+
+   if (!writeFrame(69)) {
+      std::cerr << "cadrg_decode: unable to write " << FILE_NAME << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   const auto entry = new rpf::CadrgFrameEntry();
+   entry->setPathName("./", FILE_NAME);
+   entry->loadClut();
+   const rpf::CadrgClut& clut {entry->getClut()};
+   const auto frame = new rpf::CadrgFrame();
+   frame->load(entry);
+
+   // Reference: the decompressed subframe and its color lookup
+   static rpf::Subframe subframe;
+   static rpf::CadrgMap::ColorArray ref[6][6];
+   bool colored {};
+   for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+         frame->decompressSubframe(i, j, subframe);
+         rpf::CadrgMap::subframeToTexels(subframe, clut, ref[i][j]);
+         if (!isMasked(i, j)) colored = colored || (ref[i][j].texel[0][0].red != 0 || ref[i][j].texel[0][0].green != 0);
+      }
+   }
+
+   // Decoded subframes, directly and through the cache
+   int failures {};
+   std::vector<unsigned char> texels(256 * 256 * 4);
+   for (int nc = 3; nc <= 4; nc++) {
+      rpf::SubframeCache::clear();
+      for (int i = 0; i < 6; i++) {
+         for (int j = 0; j < 6; j++) {
+            frame->decodeSubframe(i, j, clut, texels.data(), nc);
+            bool ok {isSame(ref[i][j], texels.data(), nc, isMasked(i, j))};
+
+            std::memset(texels.data(), 0, texels.size());
+            ok = ok && rpf::SubframeCache::decode(entry, frame, i, j, nc, texels.data()) &&
+                 isSame(ref[i][j], texels.data(), nc, isMasked(i, j));
+
+            std::memset(texels.data(), 0, texels.size());
+            ok = ok && rpf::SubframeCache::get(entry, i, j, nc, texels.data()) &&
+                 isSame(ref[i][j], texels.data(), nc, isMasked(i, j));
+
+            if (!ok) {
+               if (failures++ < 10) {
+                  std::cout << "subframe (" << i << ", " << j << ")" << (isMasked(i, j) ? ", masked" : "")
+                            << ", " << nc << " components: texels don't match" << std::endl;
+               }
+            }
+         }
+      }
+   }
+   if (!colored) {
+      std::cout << "the color table wasn't loaded" << std::endl;
+      failures++;
+   }
+
+   // Subframes per second
+   double t0 {base::getComputerTime()};
+   for (int n = 0; n < numDecodes; n++) {
+      frame->decompressSubframe(n % 6, (n / 6) % 6, subframe);
+      rpf::CadrgMap::subframeToTexels(subframe, clut, ref[0][0]);
+   }
+   double t1 {base::getComputerTime()};
+   const double current {numDecodes / (t1 - t0)};
+
+   double rate[2] {};
+   for (int nc = 3; nc <= 4; nc++) {
+      t0 = base::getComputerTime();
+      for (int n = 0; n < numDecodes; n++) frame->decodeSubframe(n % 6, (n / 6) % 6, clut, texels.data(), nc);
+      t1 = base::getComputerTime();
+      rate[nc - 3] = numDecodes / (t1 - t0);
+   }
+
+   t0 = base::getComputerTime();
+   for (int n = 0; n < numDecodes; n++) rpf::SubframeCache::get(entry, n % 6, (n / 6) % 6, 4, texels.data());
+   t1 = base::getComputerTime();
+   const double hits {numDecodes / (t1 - t0)};
+
+   std::printf("subframes per second: decompressSubframe() + subframeToTexels() %.0f; "
+               "decodeSubframe() RGB %.0f, RGBA %.0f; SubframeCache hits %.0f\n",
+               current, rate[0], rate[1], hits);
+
+   frame->unref();
+   entry->unref();
+   rpf::SubframeCache::clear();
+   std::remove(FILE_NAME);
+
+   std::cout << "36 subframes, " << failures << " failed" << std::endl;
+   return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
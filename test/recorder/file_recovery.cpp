@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+// Recorder file recovery test
+//
+//    Writes a block compressed data file, and then damages copies of it at
+//    random: 'corrupt' flips the bits of 1 to 4 runs of 1 to 64 bytes,
+//    'truncate' cuts the file, and 'both' does both.  For each copy:
+//       -- the FileReader (with 'resync') returns exactly the records of the
+//          blocks that weren't damaged, in order, with the END_OF_DATA record
+//          only if its block wasn't damaged; the trials alternate between
+//          reading on the caller's thread and the playback pipeline;
+//       -- checkRecorderFile() counts the same good blocks and records;
+//       -- truncated only: recoverRecorderFile() truncates the file at the
+//          sync marker of the first lost block.
+//
+//    Usage: file_recovery [ <number of trials> [ <seed> ] ]
+//    Returns zero when all of the trials pass.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/FileReader.hpp"
+#include "mixr/recorder/FileWriter.hpp"
+#include "mixr/recorder/file_recovery.hpp"
+#include "mixr/recorder/protobuf/DataRecord.pb.h"
+
+#include "mixr/base/String.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+static const char* const FILE_NAME {"file_recovery.dat"};
+static const char* const DAMAGED_FILE_NAME {"file_recovery_damaged.dat"};
+static const int NUM_RECORDS {5000};
+static const int BLOCK_SIZE {50};         // records per block
+
+// Writes the data file; record 'i' is player data with position x == i
+static void writeFile()
+{
+   std::remove(FILE_NAME);
+   const auto writer = new recorder::FileWriter();
+   const base::String name(FILE_NAME);
+   writer->setFilename(&name);
+   writer->setBlockSize(BLOCK_SIZE);
+   for (int i = 0; i < NUM_RECORDS; i++) {
+      const auto record = new recorder::pb::DataRecord();
+      record->set_id(REID_PLAYER_DATA);
+      record->mutable_time()->set_sim_time(i * 0.1);
+      recorder::pb::PlayerDataMsg* const msg {record->mutable_player_data_msg()};
+      msg->mutable_id()->set_id(i % 100);
+      msg->mutable_id()->set_name("player");
+      recorder::pb::PlayerState* const state {msg->mutable_state()};
+      state->mutable_pos()->set_x(i);
+      state->mutable_pos()->set_y(2.0);
+      state->mutable_pos()->set_z(3.0);
+      state->mutable_angles()->set_x(0.1);
+      state->mutable_angles()->set_y(0.2);
+      state->mutable_angles()->set_z(0.3);
+      const auto handle = new recorder::DataRecordHandle(record);
+      writer->processRecord(handle);
+      handle->unref();
+   }
+   writer->event(base::Component::SHUTDOWN_EVENT);
+   writer->unref();
+}
+
+int main(int argc, char* argv[])
+{
+   const int numTrials {(argc > 1) ? std::atoi(argv[1]) : 600};
+   const unsigned int seed {(argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 59};
+
+   writeFile();
+   std::ifstream in(FILE_NAME, std::ios::binary);
+   const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+   // Start of each block (its sync marker); the block counts are checked
+   // against the records that are read
+   std::vector<std::size_t> starts;
+   for (std::size_t p = bytes.find("MXBK"); p != std::string::npos; p = bytes.find("MXBK", p + 1)) {
+      starts.push_back(p);
+   }
+   const int numBlocks {static_cast<int>(starts.size())};
+   if (numBlocks != (NUM_RECORDS / BLOCK_SIZE + 1)) {
+      std::cerr << "file_recovery: expected " << (NUM_RECORDS / BLOCK_SIZE + 1) << " blocks, found "
+                << numBlocks << " sync markers" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::mt19937 gen(seed);
+   int failures {};
+   unsigned long numSkipped {};
+   for (int t = 0; t < numTrials; t++) {
+      std::string b {bytes};
+      std::vector<bool> damaged(numBlocks, false);
+      const int mode {t % 3};      // 0: corrupt, 1: truncate, 2: both
+      if (mode != 1) {
+         const unsigned int n {static_cast<unsigned int>(1 + gen() % 4)};
+         for (unsigned int c = 0; c < n; c++) {
+            const std::size_t offset {starts[0] + gen() % (b.size() - starts[0])};
+            const std::size_t len {1 + gen() % 64};
+            for (std::size_t k = offset; k < offset + len && k < b.size(); k++) {
+               b[k] = static_cast<char>(b[k] ^ (1 + gen() % 255));
+               for (int i = numBlocks - 1; i >= 0; i--) {
+                  if (k >= starts[i]) {
+                     damaged[i] = true;
+                     break;
+                  }
+               }
+            }
+         }
+      }
+      if (mode != 0) {
+         const std::size_t cut {starts[0] + gen() % (b.size() - starts[0])};
+         b.resize(cut);
+         for (int i = 0; i < numBlocks; i++) {
+            const std::size_t end {(i + 1 < numBlocks) ? starts[i + 1] : bytes.size()};
+            if (end > cut) damaged[i] = true;
+         }
+      }
+      {
+         std::ofstream out(DAMAGED_FILE_NAME, std::ios::binary | std::ios::trunc);
+         out.write(b.data(), static_cast<std::streamsize>(b.size()));
+      }
+
+      // Expected: the records of the blocks that weren't damaged (the last
+      // block holds the END_OF_DATA record)
+      std::set<int> expected;
+      unsigned int goodBlocks {};
+      for (int i = 0; i < numBlocks; i++) {
+         if (damaged[i]) continue;
+         goodBlocks++;
+         for (int r = i * BLOCK_SIZE; r < (i + 1) * BLOCK_SIZE && r < NUM_RECORDS; r++) expected.insert(r);
+      }
+      const int expectedEod {damaged[numBlocks - 1] ? 0 : 1};
+
+      recorder::FileCheck check;
+      const bool checked {recorder::checkRecorderFile(DAMAGED_FILE_NAME, &check)};
+
+      // Read the damaged file
+      const auto reader = new recorder::FileReader();
+      const base::String name(DAMAGED_FILE_NAME);
+      reader->setFilename(&name);
+      reader->setNumWorkers((t % 2) ? 2 : 0);
+      reader->disableMessageTypes(base::Object::MSG_INFO | base::Object::MSG_WARNING);
+      std::set<int> records;
+      int prev {-1};
+      bool inOrder {true};
+      int eod {};
+      unsigned long numRead {};
+      const recorder::DataRecordHandle* handle {};
+      while ((handle = reader->readRecord()) != nullptr) {
+         numRead++;
+         const recorder::pb::DataRecord* const record {handle->getRecord()};
+         if (record->id() == REID_PLAYER_DATA) {
+            const int x {static_cast<int>(record->player_data_msg().state().pos().x())};
+            if (x <= prev) inOrder = false;
+            prev = x;
+            records.insert(x);
+         }
+         else if (record->id() == REID_END_OF_DATA) eod++;
+         handle->unref();
+      }
+      numSkipped += reader->getNumDamagedBlocks();
+      reader->unref();
+
+      const bool readOk {records == expected && inOrder && eod == expectedEod};
+      const bool checkOk {checked && check.blockFile && check.numBlocks == goodBlocks &&
+                          check.numRecords == numRead && check.fileSize == b.size() &&
+                          check.goodSize <= b.size()};
+
+      // Truncated only: the file is truncated at the start of the first lost block
+      bool recoverOk {true};
+      std::size_t expectedSize {};
+      if (mode == 1) {
+         std::size_t firstLost {bytes.size()};
+         for (int i = 0; i < numBlocks; i++) {
+            if (damaged[i]) {
+               firstLost = starts[i];
+               break;
+            }
+         }
+         expectedSize = (firstLost < b.size()) ? firstLost : b.size();
+         recorder::FileCheck rc;
+         recoverOk = recorder::recoverRecorderFile(DAMAGED_FILE_NAME, &rc) && rc.goodSize == expectedSize;
+         std::ifstream chk(DAMAGED_FILE_NAME, std::ios::binary | std::ios::ate);
+         recoverOk = recoverOk && static_cast<std::size_t>(chk.tellg()) == expectedSize;
+      }
+
+      if (!readOk || !checkOk || !recoverOk) {
+         if (failures++ < 10) {
+            std::cout << "trial " << t << " (mode " << mode << "): read " << records.size() << " of "
+                      << expected.size() << " records, in order " << inOrder << ", end of data " << eod
+                      << "/" << expectedEod << "; check: " << check.numBlocks << "/" << goodBlocks
+                      << " blocks, " << check.numRecords << "/" << numRead << " records";
+            if (!recoverOk) std::cout << "; recovery: expected size " << expectedSize;
+            std::cout << std::endl;
+         }
+      }
+   }
+
+   std::remove(FILE_NAME);
+   std::remove(DAMAGED_FILE_NAME);
+
+   std::cout << numTrials << " trials, " << failures << " failed; the reader skipped "
+             << numSkipped << " damaged regions" << std::endl;
+   return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+// Recorder filter allocation test
+//
+//    A DataRecorder with an output handler whose TabPrinter is enabled for
+//    the marker and analog input records only.  Checks that:
+//       -- the recorder's consumed IDs (see
+//          AbstractDataRecorder::getConsumedIds()) are the printer's
+//          enabled IDs, plus the end of data ID;
+//       -- recordData() of the filtered IDs doesn't allocate any memory (all
+//          operator new() calls are counted), and neither does a recorder
+//          without an output handler;
+//       -- recordData() of an accepted ID does (i.e., the count works).
+//
+//    Usage: filter_alloc [ <number of records> ]
+//    Returns zero when all of the checks pass.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/DataRecorder.hpp"
+#include "mixr/recorder/OutputHandler.hpp"
+#include "mixr/recorder/TabPrinter.hpp"
+
+#include "mixr/base/List.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace mixr;
+
+// Number of operator new() calls
+static long numAllocs {};
+
+void* operator new(std::size_t n)
+{
+   numAllocs++;
+   void* const p {std::malloc(n > 0 ? n : 1)};
+   if (p == nullptr) throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) noexcept                   { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept      { std::free(p); }
+
+int main(int argc, char* argv[])
+{
+   const int numRecords {(argc > 1) ? std::atoi(argv[1]) : 100000};
+
+   // Output handler: a tab printer of the marker and analog input records
+   const auto printer = new recorder::TabPrinter();
+   {
+      const auto list = new base::List();
+      const auto id0 = new base::Integer(REID_MARKER);
+      const auto id1 = new base::Integer(REID_AI_EVENT);
+      list->put(id0);
+      list->put(id1);
+      id0->unref();
+      id1->unref();
+      printer->setSlotByName("enabledList", list);
+      list->unref();
+   }
+   const auto handler = new recorder::OutputHandler();
+   {
+      const auto components = new base::PairStream();
+      const auto pair = new base::Pair("printer", printer);
+      components->put(pair);
+      pair->unref();
+      handler->setSlotByName("components", components);
+      components->unref();
+   }
+   printer->unref();
+
+   const auto recorder0 = new recorder::DataRecorder();
+   recorder0->setSlotByName("outputHandler", handler);
+   handler->unref();
+
+   int failures {};
+
+   // Consumed IDs
+   const auto& ids = recorder0->getConsumedIds();
+   if (ids.count() != 3 || !ids[REID_MARKER] || !ids[REID_AI_EVENT] || !ids[REID_END_OF_DATA]) {
+      std::cout << "consumed IDs: " << ids.count() << ", expected the marker, analog input and end of data IDs" << std::endl;
+      failures++;
+   }
+
+   // Filtered records
+   const base::Object* objs[4] {};
+   const double values[4] {1.0, 2.0, 3.0, 4.0};
+   long n0 {numAllocs};
+   for (int i = 0; i < numRecords; i++) {
+      recorder0->recordData(REID_DI_EVENT, objs, values);
+      recorder0->recordData(REID_PLAYER_DATA, objs, values);
+      recorder0->recordData(REID_TRACK_DATA, objs, values);
+   }
+   const long filtered {numAllocs - n0};
+
+   // No output handler
+   const auto recorder1 = new recorder::DataRecorder();
+   n0 = numAllocs;
+   for (int i = 0; i < numRecords; i++) {
+      recorder1->recordData(REID_MARKER, objs, values);
+   }
+   const long noHandler {numAllocs - n0};
+
+   // Accepted record (there's no station, so the recorder reports that it
+   // can't time stamp it)
+   n0 = numAllocs;
+   recorder0->recordData(REID_MARKER, objs, values);
+   const long accepted {numAllocs - n0};
+
+   if (filtered != 0 || noHandler != 0 || accepted == 0) failures++;
+   std::cout << "allocations: " << (3 * numRecords) << " filtered records " << filtered << "; "
+             << numRecords << " records without a handler " << noHandler << "; one accepted record "
+             << accepted << std::endl;
+
+   recorder0->unref();
+   recorder1->unref();
+
+   std::cout << failures << " failed" << std::endl;
+   return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
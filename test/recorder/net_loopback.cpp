@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+// Recorder network loopback test
+//
+//    A NetOutput sends framed records (see frame_utils.hpp) through a
+//    loopback network handler, and the datagrams are impaired at random
+//    before a NetInput reads them: frames are lost, duplicated and swapped
+//    with one of the next three frames.  For each trial:
+//       -- with a zero 'reorderWindow', the records of every frame that
+//          arrived are read exactly once, and the lost, duplicate and
+//          reordered (i.e., late) frame counts match the impairments;
+//       -- with a 'reorderWindow' of 4 or 8 frames, the records are read in
+//          sequence, the duplicate counts match, the frames that arrived
+//          after their gap was skipped are counted as dropped, and the
+//          frames whose records weren't read are counted as lost.
+//
+//    Usage: net_loopback [ <number of trials> [ <seed> ] ]
+//    Returns zero when all of the trials pass.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/NetInput.hpp"
+#include "mixr/recorder/NetOutput.hpp"
+#include "mixr/recorder/frame_utils.hpp"
+#include "mixr/recorder/protobuf/DataRecord.pb.h"
+
+#include "mixr/base/network/NetHandler.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mixr;
+
+static const int NUM_RECORDS {3000};
+
+// Datagrams in flight
+static std::deque<std::string> wire;
+
+//------------------------------------------------------------------------------
+// Loopback network handler: sent datagrams are queued on the wire, and
+// received in order
+//------------------------------------------------------------------------------
+class Loopback : public base::NetHandler
+{
+   DECLARE_SUBCLASS(Loopback, base::NetHandler)
+
+public:
+   Loopback()                                         { STANDARD_CONSTRUCTOR() }
+
+   bool initNetwork(const bool) override              { return true; }
+   bool isConnected() const override                  { return true; }
+   bool closeConnection() override                    { return true; }
+   bool setBlocked() override                         { return true; }
+   bool setNoWait() override                          { return true; }
+
+   bool sendData(const char* const packet, const int size) override
+   {
+      wire.emplace_back(packet, size);
+      return true;
+   }
+
+   unsigned int recvData(char* const packet, const int maxSize) override
+   {
+      unsigned int n {};
+      if (!wire.empty() && static_cast<int>(wire.front().size()) <= maxSize) {
+         n = static_cast<unsigned int>(wire.front().size());
+         std::memcpy(packet, wire.front().data(), n);
+      }
+      if (!wire.empty()) wire.pop_front();
+      return n;
+   }
+};
+
+IMPLEMENT_SUBCLASS(Loopback, "Loopback")
+EMPTY_SLOTTABLE(Loopback)
+EMPTY_COPYDATA(Loopback)
+EMPTY_DELETEDATA(Loopback)
+
+// Frame sent by the NetOutput
+struct Frame {
+   std::string datagram;
+   int firstRecord {};                 // Id of its first record
+   int numRecords {};
+};
+
+// Sends the records; record 'i' is a player removed event with id 'i'
+static std::vector<Frame> send()
+{
+   wire.clear();
+   const auto out = new recorder::NetOutput();
+   const auto net = new Loopback();
+   out->setSlotByName("netHandler", net);
+   net->unref();
+   out->setFraming(true);
+   out->setMaxFrameDelay(100.0);
+   for (int i = 0; i < NUM_RECORDS; i++) {
+      const auto record = new recorder::pb::DataRecord();
+      record->set_id(REID_PLAYER_REMOVED);
+      record->mutable_time()->set_sim_time(i * 0.01);
+      record->mutable_player_removed_event_msg()->mutable_id()->set_id(i);
+      record->mutable_player_removed_event_msg()->mutable_id()->set_name("player");
+      const auto handle = new recorder::DataRecordHandle(record);
+      out->processRecord(handle);
+      handle->unref();
+   }
+   out->flushFrame();
+   out->unref();
+
+   std::vector<Frame> frames;
+   int next {};
+   for (const std::string& d : wire) {
+      recorder::FrameHeader hdr;
+      recorder::decodeFrame(d.data(), d.size(), &hdr);
+      Frame f;
+      f.datagram = d;
+      f.firstRecord = next;
+      f.numRecords = static_cast<int>(hdr.numRecords);
+      next += f.numRecords;
+      frames.push_back(f);
+   }
+   wire.clear();
+   return frames;
+}
+
+int main(int argc, char* argv[])
+{
+   const int numTrials {(argc > 1) ? std::atoi(argv[1]) : 40};
+   const unsigned int seed {(argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 56};
+
+   const std::vector<Frame> frames {send()};
+   const int numFrames {static_cast<int>(frames.size())};
+   if (numFrames < 2 || (frames.back().firstRecord + frames.back().numRecords) != NUM_RECORDS) {
+      std::cerr << "net_loopback: expected the " << NUM_RECORDS << " records in frames" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> uniform(0.0, 1.0);
+   int failures {};
+   for (int t = 0; t < numTrials; t++) {
+      const unsigned int window {(t % 3) * 4u};     // 0, 4 or 8 frames
+      const double loss {0.1 * uniform(gen)};
+      const double dup {0.1 * uniform(gen)};
+      const double reorder {0.3 * uniform(gen)};
+
+      // Impair the frames (by index); the last frame always arrives, so
+      // all of the lost frames are detected
+      std::vector<int> order;
+      int numDups {};
+      for (int i = 0; i < numFrames; i++) {
+         if (i != (numFrames - 1) && uniform(gen) < loss) continue;
+         order.push_back(i);
+         if (uniform(gen) < dup) {
+            order.push_back(i);
+            numDups++;
+         }
+      }
+      for (std::size_t i = 0; (i + 1) < order.size(); i++) {
+         if (uniform(gen) < reorder) {
+            const std::size_t j {i + 1 + gen() % 3};
+            if (j < order.size()) std::swap(order[i], order[j]);
+         }
+      }
+
+      // Expected: frames that arrived, and those that arrived after a later frame
+      std::set<int> arrived;
+      unsigned int numLate {};
+      int highest {-1};
+      for (const int i : order) {
+         if (arrived.count(i) != 0) continue;
+         arrived.insert(i);
+         if (i < highest) numLate++;
+         if (i > highest) highest = i;
+      }
+
+      for (const int i : order) wire.push_back(frames[i].datagram);
+
+      // Read them
+      const auto in = new recorder::NetInput();
+      const auto net = new Loopback();
+      in->setSlotByName("netHandler", net);
+      net->unref();
+      in->setReorderWindow(window);
+      in->setReorderTimeout(100.0);
+      in->disableMessageTypes(base::Object::MSG_INFO | base::Object::MSG_WARNING);
+      std::vector<int> records;
+      int idle {};
+      while (idle < 3) {
+         // (after the last datagram, the held frames are released)
+         if (wire.empty()) in->setReorderTimeout(0.0);
+         const recorder::DataRecordHandle* handle {in->readRecord()};
+         if (handle != nullptr) {
+            records.push_back(static_cast<int>(handle->getRecord()->player_removed_event_msg().id().id()));
+            handle->unref();
+            idle = 0;
+         }
+         else if (wire.empty()) {
+            idle++;
+            base::msleep(10);
+         }
+      }
+
+      // Frames whose records were read (all of them, or none)
+      std::multiset<int> read(records.begin(), records.end());
+      std::set<int> used;
+      bool whole {true};
+      for (int i = 0; i < numFrames; i++) {
+         int n {};
+         for (int r = frames[i].firstRecord; r < frames[i].firstRecord + frames[i].numRecords; r++) {
+            n += static_cast<int>(read.count(r));
+         }
+         if (n == frames[i].numRecords) used.insert(i);
+         else if (n != 0) whole = false;
+      }
+      bool inSequence {true};
+      for (std::size_t i = 1; i < records.size(); i++) {
+         if (records[i] <= records[i - 1]) inSequence = false;
+      }
+      const unsigned int numUsed {static_cast<unsigned int>(used.size())};
+      const unsigned int numArrived {static_cast<unsigned int>(arrived.size())};
+
+      bool ok {whole && read.size() == records.size() && in->getNumFramesReceived() == order.size() &&
+               in->getNumDuplicateFrames() == static_cast<unsigned int>(numDups)};
+      if (window == 0) {
+         ok = ok && used == arrived && records.size() == std::set<int>(records.begin(), records.end()).size() &&
+              in->getNumFramesLost() == (numFrames - numArrived) && in->getNumReorderedFrames() == numLate &&
+              in->getNumDroppedFrames() == 0;
+      }
+      else {
+         ok = ok && inSequence && in->getNumFramesLost() == (numFrames - numUsed) &&
+              in->getNumDroppedFrames() == (numArrived - numUsed);
+      }
+
+      if (!ok) {
+         if (failures++ < 10) {
+            std::cout << "trial " << t << " (window " << window << "): " << numUsed << " of " << numArrived
+                      << " arrived frames read, in sequence " << inSequence << "; lost "
+                      << in->getNumFramesLost() << "/" << (numFrames - numArrived) << ", duplicates "
+                      << in->getNumDuplicateFrames() << "/" << numDups << ", reordered "
+                      << in->getNumReorderedFrames() << "/" << numLate << ", dropped "
+                      << in->getNumDroppedFrames() << std::endl;
+         }
+      }
+      in->unref();
+   }
+
+   std::cout << numFrames << " frames, " << numTrials << " trials, " << failures << " failed" << std::endl;
+   return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+// Terrain line of sight equivalence test
+//
+//    Builds synthetic elevation data files (random hills, with void posts)
+//    and three terrains from them: a single data file, a QuadMap of four
+//    files, and a TileMosaic of four files with gaps between them and a
+//    finer, overlapping fifth file.  For random observers and rays over each
+//    terrain, checks that:
+//       -- targetOcculting2() and isProfileOcculted() (i.e., the elevation
+//          bounds and isSpanOcculted()) give the same answer as the per
+//          sample check, getElevations() followed by occultCheck2();
+//       -- targetOcculting() gives the same answer as getElevations()
+//          followed by occultCheck(), with the same number of points.
+//
+//    Usage: los_equivalence [ <number of rays per terrain> [ <seed> ] ]
+//    Returns zero when all of the answers match.
+//------------------------------------------------------------------------------
+
+#include "mixr/terrain/DataFile.hpp"
+#include "mixr/terrain/QuadMap.hpp"
+#include "mixr/terrain/TileMosaic.hpp"
+
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/units/util/length_utils.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+// Same as Terrain::targetOcculting()
+static const unsigned int MAX_POINTS {1200};
+
+//------------------------------------------------------------------------------
+// Synthetic data file: 'n' by 'n' posts, 'spacing' degrees apart, of random
+// hills and some void posts
+//------------------------------------------------------------------------------
+class SynthFile : public terrain::DataFile
+{
+   DECLARE_SUBCLASS(SynthFile, terrain::DataFile)
+
+public:
+   SynthFile()                                        { STANDARD_CONSTRUCTOR() }
+
+   void make(const double lat, const double lon, const unsigned int n, const double spacing,
+             const unsigned int seed, const double voids)
+   {
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> uniform(0.0, 1.0);
+      double fx[6] {}, fy[6] {}, phase[6] {};
+      for (int k = 0; k < 6; k++) {
+         fx[k] = 2.0 + 40.0 * uniform(gen);
+         fy[k] = 2.0 + 40.0 * uniform(gen);
+         phase[k] = 6.0 * uniform(gen);
+      }
+
+      nptlat = n;
+      nptlong = n;
+      latSpacing = spacing;
+      lonSpacing = spacing;
+      columns = new short*[n];
+      double minElev {1.0e9}, maxElev {-1.0e9};
+      for (unsigned int c = 0; c < n; c++) {
+         columns[c] = new short[n];
+         for (unsigned int r = 0; r < n; r++) {
+            const double x {static_cast<double>(c) / n};
+            const double y {static_cast<double>(r) / n};
+            double h {600.0 + 80.0 * uniform(gen)};
+            for (int k = 0; k < 6; k++) h += 350.0 / (k + 1) * std::sin(fx[k] * x * (k + 1) + fy[k] * y + phase[k]);
+            columns[c][r] = static_cast<short>(h);
+            if (uniform(gen) < voids) columns[c][r] = voidValue;
+            minElev = std::min(minElev, h);
+            maxElev = std::max(maxElev, h);
+         }
+      }
+      setLatitudeSW(lat);
+      setLongitudeSW(lon);
+      setLatitudeNE(lat + (n - 1) * spacing);
+      setLongitudeNE(lon + (n - 1) * spacing);
+      setMinElevation(minElev);
+      setMaxElevation(maxElev);
+   }
+
+private:
+   bool loadData() override                           { return true; }
+};
+
+IMPLEMENT_SUBCLASS(SynthFile, "SynthFile")
+EMPTY_SLOTTABLE(SynthFile)
+EMPTY_COPYDATA(SynthFile)
+EMPTY_DELETEDATA(SynthFile)
+
+static SynthFile* newFile(const double lat, const double lon, const unsigned int n, const double spacing,
+                          const unsigned int seed, const double voids)
+{
+   const auto file = new SynthFile();
+   file->make(lat, lon, n, spacing, seed, voids);
+   file->reset();
+   return file;
+}
+
+// Four files of 600 by 600 posts, one degree apart (so there's a gap
+// between their edge posts), plus an optional overlapping file, as the
+// terrain's components
+static void setComponents(terrain::Terrain* const terrain, const unsigned int seed, const bool overlap)
+{
+   const auto components = new base::PairStream();
+   for (unsigned int i = 0; i < 5; i++) {
+      if (i == 4 && !overlap) break;
+      SynthFile* file {};
+      if (i < 4) file = newFile(40.0 + (i % 2), -118.0 + (i / 2), 600, 1.0 / 600, seed + i, 0.001);
+      else file = newFile(40.6, -117.4, 601, 0.8 / 600, seed + i, 0.01);
+      const auto pair = new base::Pair("file", file);
+      components->put(pair);
+      pair->unref();
+      file->unref();
+   }
+   terrain->setSlotByName("components", components);
+   components->unref();
+   terrain->reset();
+}
+
+// Per sample check of targetOcculting2()
+static bool occulting2(const terrain::Terrain* const terrain, const double lat, const double lon, const double alt,
+                       const double brg, const double dist, const double tanLookAng)
+{
+   unsigned int n {static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+   if (n > MAX_POINTS) n = MAX_POINTS;
+   if (n < 2) return false;
+   std::vector<double> elevations(n);
+   std::unique_ptr<bool[]> validFlags(new bool[n]());
+   const unsigned int num {terrain->getElevations(elevations.data(), validFlags.get(), n, lat, lon, brg, dist, false)};
+   return (num > 0 && terrain::Terrain::occultCheck2(elevations.data(), validFlags.get(), n, dist, alt, tanLookAng));
+}
+
+// Per sample check of targetOcculting()
+static bool occulting(const terrain::Terrain* const terrain, const double lat, const double lon, const double alt,
+                      const double tgtLat, const double tgtLon, const double tgtAlt)
+{
+   double brg {}, distNM {};
+   base::nav::fll2bd(lat, lon, tgtLat, tgtLon, &brg, &distNM);
+   const double dist {distNM * base::length::NM2M};
+   unsigned int n {static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+   if (n > MAX_POINTS) n = MAX_POINTS;
+   if (n < 2 || dist <= 0) return false;
+   std::vector<double> elevations(n);
+   std::unique_ptr<bool[]> validFlags(new bool[n]());
+   const unsigned int num {terrain->getElevations(elevations.data(), validFlags.get(), n, lat, lon, brg, dist, false)};
+   return (num > 0 && terrain::Terrain::occultCheck(elevations.data(), validFlags.get(), n, dist, alt, tgtAlt));
+}
+
+int main(int argc, char* argv[])
+{
+   const int numRays {(argc > 1) ? std::atoi(argv[1]) : 20000};
+   const unsigned int seed {(argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 62};
+
+   const auto single = newFile(40.0, -118.0, 1201, 1.0 / 600, seed, 0.001);
+   const auto quad = new terrain::QuadMap();
+   setComponents(quad, seed + 10, false);
+   const auto mosaic = new terrain::TileMosaic();
+   setComponents(mosaic, seed + 20, true);
+
+   struct Case { const char* name; const terrain::Terrain* terrain; };
+   const Case cases[] {{"single file", single}, {"QuadMap", quad}, {"TileMosaic", mosaic}};
+
+   int failures {};
+   for (const Case& c : cases) {
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> uniform(0.0, 1.0);
+      int mismatches {};
+      unsigned int numOcculted {};
+      for (int i = 0; i < numRays; i++) {
+         // Observers over (and some just off) the terrain, mostly low,
+         // and rays of up to 60 NM
+         const double lat {39.9 + 2.2 * uniform(gen)};
+         const double lon {-118.1 + 2.2 * uniform(gen)};
+         const double alt {(i % 4 == 0) ? (2000.0 + 8000.0 * uniform(gen)) : (300.0 + 1300.0 * uniform(gen))};
+
+         bool occulted {};
+         bool expected {};
+         if (i % 3 == 0) {
+            const double brg {360.0 * uniform(gen) - 180.0};
+            const double dist {60.0 * base::length::NM2M * uniform(gen)};
+            const double tanLookAng {0.2 * (uniform(gen) - 0.3)};
+            occulted = c.terrain->targetOcculting2(lat, lon, alt, brg, dist, tanLookAng);
+            expected = occulting2(c.terrain, lat, lon, alt, brg, dist, tanLookAng);
+
+            unsigned int n {static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+            if (n > MAX_POINTS) n = MAX_POINTS;
+            if (n > 1 && occulted != c.terrain->isProfileOcculted(n, lat, lon, brg, dist, alt, tanLookAng)) {
+               mismatches++;
+            }
+         }
+         else {
+            const double tgtLat {lat + 0.6 * (uniform(gen) - 0.5)};
+            const double tgtLon {lon + 0.6 * (uniform(gen) - 0.5)};
+            const double tgtAlt {300.0 + 1500.0 * uniform(gen)};
+            occulted = c.terrain->targetOcculting(lat, lon, alt, tgtLat, tgtLon, tgtAlt);
+            expected = occulting(c.terrain, lat, lon, alt, tgtLat, tgtLon, tgtAlt);
+         }
+         if (occulted != expected) mismatches++;
+         if (occulted) numOcculted++;
+      }
+      std::cout << c.name << ": " << numRays << " rays, " << numOcculted << " occulted, "
+                << mismatches << " mismatches" << std::endl;
+      if (mismatches != 0 || numOcculted == 0 || numOcculted == static_cast<unsigned int>(numRays)) failures++;
+   }
+
+   single->unref();
+   quad->unref();
+   mosaic->unref();
+
+   std::cout << failures << " failed" << std::endl;
+   return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}